@@ -66,25 +66,40 @@ static const StreamFileFormat STREAM_FILEFORMATS[] = {
 
 SeekableAudioStream *SeekableAudioStream::openStreamFile(const Common::String &basename) {
 	SeekableAudioStream *stream = NULL;
-	Common::File *fileHandle = new Common::File();
+	Common::String filename = findStreamFile(basename);
+
+	if (!filename.empty()) {
+		Common::File *fileHandle = new Common::File();
+		if (fileHandle->open(filename))
+			stream = openStreamFile(fileHandle, filename);
+		else
+			delete fileHandle;
+	}
+
+	if (stream == NULL)
+		debug(1, "SeekableAudioStream::openStreamFile: Could not open compressed AudioFile %s", basename.c_str());
 
+	return stream;
+}
+
+Common::String SeekableAudioStream::findStreamFile(const Common::String &basename) {
 	for (int i = 0; i < ARRAYSIZE(STREAM_FILEFORMATS); ++i) {
 		Common::String filename = basename + STREAM_FILEFORMATS[i].fileExtension;
-		fileHandle->open(filename);
-		if (fileHandle->isOpen()) {
-			// Create the stream object
-			stream = STREAM_FILEFORMATS[i].openStreamFile(fileHandle, DisposeAfterUse::YES);
-			fileHandle = 0;
-			break;
-		}
+		if (Common::File::exists(filename))
+			return filename;
 	}
 
-	delete fileHandle;
+	return Common::String();
+}
 
-	if (stream == NULL)
-		debug(1, "SeekableAudioStream::openStreamFile: Could not open compressed AudioFile %s", basename.c_str());
+SeekableAudioStream *SeekableAudioStream::openStreamFile(Common::SeekableReadStream *stream, const Common::String &filename) {
+	for (int i = 0; i < ARRAYSIZE(STREAM_FILEFORMATS); ++i) {
+		if (filename.hasSuffixIgnoreCase(STREAM_FILEFORMATS[i].fileExtension))
+			return STREAM_FILEFORMATS[i].openStreamFile(stream, DisposeAfterUse::YES);
+	}
 
-	return stream;
+	delete stream;
+	return NULL;
 }
 
 #pragma mark -
@@ -194,6 +194,27 @@ public:
 	 */
 	static SeekableAudioStream *openStreamFile(const Common::String &basename);
 
+	/**
+	 * Find the file openStreamFile() would load for @p basename.
+	 *
+	 * @return  The name of the file, with its extension, or an empty string
+	 *          if there is no file in any of the available formats.
+	 */
+	static Common::String findStreamFile(const Common::String &basename);
+
+	/**
+	 * Load an opened file found by findStreamFile(). The format is chosen by
+	 * the extension of @p filename. This only reads from @p stream, so it can
+	 * be done on another thread if the stream has a file handle of its own.
+	 *
+	 * @param stream    The opened file. It is deleted in case of an error.
+	 * @param filename  The name of the file, with its extension.
+	 *
+	 * @return  A SeekableAudioStream ready to use in case of success.
+	 *          NULL in case of an error.
+	 */
+	static SeekableAudioStream *openStreamFile(Common::SeekableReadStream *stream, const Common::String &filename);
+
 	/**
 	 * Seek to a given offset in the stream.
 	 *
@@ -0,0 +1,336 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "audio/decodeahead.h"
+#include "audio/audiostream.h"
+
+#include "common/list.h"
+#include "common/mutex.h"
+#include "common/ptr.h"
+#include "common/singleton.h"
+#include "common/spscqueue.h"
+#include "common/system.h"
+#include "common/threadpool.h"
+#include "common/timer.h"
+#include "common/util.h"
+
+namespace Audio {
+
+enum {
+	/** Ring buffer room beyond the lookahead, so that a mixer callback never exceeds it */
+	DECODE_AHEAD_MIN_SAMPLES = 8192,
+	/** How often the timer callback decodes, without a worker thread, in microseconds */
+	DECODE_AHEAD_INTERVAL = 10000,
+	/** How many samples are decoded at most while holding the decoding lock */
+	DECODE_AHEAD_CHUNK = 2048
+};
+
+class DecodeAheadStream : public SeekableAudioStream {
+public:
+	/**
+	 * The wrapped stream is only seekable if 'seekable' is set, which then
+	 * is the same stream as 'stream'.
+	 */
+	DecodeAheadStream(AudioStream *stream, SeekableAudioStream *seekable, uint32 lookahead, DisposeAfterUse::Flag disposeAfterUse);
+	~DecodeAheadStream();
+
+	int readBuffer(int16 *buffer, const int numSamples);
+	bool isStereo() const { return _stereo; }
+	int getRate() const { return _rate; }
+	bool endOfData() const;
+
+	bool seek(const Timestamp &where);
+	Timestamp getLength() const { return _length; }
+
+	/**
+	 * Decode into the ring buffer until it holds at least 'fill' samples,
+	 * as far as there is room in it. Called by the decoding thread, and by
+	 * the mixer when the decoding thread fell behind. The samples are
+	 * decoded in chunks of at most DECODE_AHEAD_CHUNK samples.
+	 */
+	void decode(uint32 fill);
+
+	/** Top up the ring buffer to the lookahead. */
+	void decodeAhead() { decode(_lookahead); }
+
+private:
+	Common::DisposablePtr<AudioStream> _stream;
+	SeekableAudioStream *_seekable;
+	const bool _stereo;
+	const int _rate;
+	const Timestamp _length;
+
+	/** Serialises the chunks of decode() and seek(), i.e. everything accessing _stream. */
+	Common::Mutex _decodeMutex;
+
+	int16 *_ring;
+	uint32 _ringMask;
+	/** How many samples the decoding thread keeps in the ring buffer. */
+	uint32 _lookahead;
+
+	/** Free running write position, only changed by decode() and seek(). */
+	volatile uint32 _head;
+	/** Free running read position, only changed by readBuffer() and seek(). */
+	volatile uint32 _tail;
+	/** Whether everything left in _stream has been decoded into the ring buffer. */
+	volatile uint32 _endOfStream;
+};
+
+/**
+ * Runs decode() for all decode-ahead streams on a worker thread of its own.
+ * The streams start a job on that thread whenever the mixer took samples
+ * from them and none is running, so decoding never waits for a timer and
+ * never holds up the other timer procs.
+ *
+ * Backends without worker threads decode from a single timer callback
+ * instead, since timer procs can only be removed by their function
+ * pointer. That callback runs in its own thread on most of them.
+ */
+class DecodeAheadScheduler : public Common::Singleton<DecodeAheadScheduler> {
+public:
+	void add(DecodeAheadStream *stream);
+	void remove(DecodeAheadStream *stream);
+
+	/** Start a decoding job, unless one is queued or running. */
+	void wakeUp();
+
+private:
+	friend class Common::Singleton<SingletonBaseType>;
+	DecodeAheadScheduler() : _pool(nullptr), _timerInstalled(false), _jobRunning(0) {}
+
+	static void timerProc(void *refCon);
+	static void jobProc(void *refCon);
+	void decodeAll();
+
+	/** Serialises add() and remove(), and with it creating the pool and (un)installing the timer. */
+	Common::Mutex _registryMutex;
+	/** Protects _streams, held by the decoding job or timer callback while decoding. */
+	Common::Mutex _streamsMutex;
+
+	Common::List<DecodeAheadStream *> _streams;
+	/** The pool providing the worker thread, while there are streams and it has one. */
+	Common::ThreadPool *_pool;
+	bool _timerInstalled;
+	/** Whether a decoding job is queued or running. */
+	volatile uint32 _jobRunning;
+};
+
+#pragma mark -
+
+DecodeAheadStream::DecodeAheadStream(AudioStream *stream, SeekableAudioStream *seekable, uint32 lookahead, DisposeAfterUse::Flag disposeAfterUse)
+	: _stream(stream, disposeAfterUse), _seekable(seekable), _stereo(stream->isStereo()), _rate(stream->getRate()),
+	  _length(seekable ? seekable->getLength() : Timestamp(0, stream->getRate())),
+	  _head(0), _tail(0), _endOfStream(stream->endOfData()) {
+
+	const uint64 samples = MIN<uint64>((uint64)lookahead * _rate * (_stereo ? 2 : 1) / 1000, 0x08000000);
+	uint32 capacity = DECODE_AHEAD_MIN_SAMPLES;
+	while (capacity < samples + DECODE_AHEAD_MIN_SAMPLES)
+		capacity <<= 1;
+
+	_ring = new int16[capacity];
+	_ringMask = capacity - 1;
+	_lookahead = (uint32)samples;
+
+	DecodeAheadScheduler::instance().add(this);
+}
+
+DecodeAheadStream::~DecodeAheadStream() {
+	DecodeAheadScheduler::instance().remove(this);
+	delete[] _ring;
+}
+
+void DecodeAheadStream::decode(uint32 fill) {
+	const uint32 capacity = _ringMask + 1;
+
+	// The lock is released after each chunk, so that the mixer never waits
+	// for the decoding thread to decode more than one chunk
+	for (;;) {
+		Common::StackLock lock(_decodeMutex);
+
+		const uint32 head = _head;
+		const uint32 used = head - Common::loadAcquire(_tail);
+		if (used >= fill || _endOfStream)
+			return;
+
+		uint32 space = MIN<uint32>(MIN<uint32>(capacity - used, fill - used), DECODE_AHEAD_CHUNK);
+		if (_stereo)
+			space = (space + 1) & ~1;
+
+		const uint32 pos = head & _ringMask;
+		const int len = _stream->readBuffer(_ring + pos, MIN<uint32>(space, capacity - pos));
+
+		// Publish the samples before possibly flagging the end of the stream
+		if (len > 0)
+			Common::storeRelease(_head, head + len);
+
+		if (_stream->endOfData())
+			Common::storeRelease(_endOfStream, (uint32)1);
+		else if (len <= 0)
+			return;
+	}
+}
+
+int DecodeAheadStream::readBuffer(int16 *buffer, const int numSamples) {
+	const uint32 tail = _tail;
+	uint32 available = Common::loadAcquire(_head) - tail;
+
+	if (available < (uint32)numSamples && !Common::loadAcquire(_endOfStream)) {
+		// The decoding thread fell behind, so decode the rest right here
+		decode(numSamples);
+		available = Common::loadAcquire(_head) - tail;
+	}
+
+	const uint32 total = MIN<uint32>(available, numSamples);
+	const uint32 pos = tail & _ringMask;
+	const uint32 first = MIN<uint32>(total, _ringMask + 1 - pos);
+	memcpy(buffer, _ring + pos, first * sizeof(int16));
+	memcpy(buffer + first, _ring, (total - first) * sizeof(int16));
+
+	Common::storeRelease(_tail, tail + total);
+
+	// Top up what was just taken out
+	if (total > 0 && !Common::loadAcquire(_endOfStream))
+		DecodeAheadScheduler::instance().wakeUp();
+
+	return total;
+}
+
+bool DecodeAheadStream::endOfData() const {
+	return Common::loadAcquire(_endOfStream) && Common::loadAcquire(_head) == _tail;
+}
+
+bool DecodeAheadStream::seek(const Timestamp &where) {
+	Common::StackLock lock(_decodeMutex);
+
+	if (!_seekable)
+		return false;
+
+	const bool result = _seekable->seek(where);
+
+	// Drop everything decoded so far
+	Common::storeRelease(_tail, (uint32)0);
+	Common::storeRelease(_head, (uint32)0);
+	Common::storeRelease(_endOfStream, (uint32)_seekable->endOfData());
+
+	DecodeAheadScheduler::instance().wakeUp();
+	return result;
+}
+
+#pragma mark -
+
+void DecodeAheadScheduler::add(DecodeAheadStream *stream) {
+	Common::StackLock registryLock(_registryMutex);
+
+	{
+		Common::StackLock lock(_streamsMutex);
+		_streams.push_back(stream);
+	}
+
+	if (!_pool && !_timerInstalled) {
+		// One worker thread, and the calling thread which is not used
+		_pool = g_system->createThreadPool(2);
+		if (_pool->getThreadCount() < 2) {
+			delete _pool;
+			_pool = nullptr;
+
+			Common::TimerManager *timer = g_system->getTimerManager();
+			if (timer)
+				_timerInstalled = timer->installTimerProc(&timerProc, DECODE_AHEAD_INTERVAL, this, "decodeAhead");
+		}
+	}
+
+	wakeUp();
+}
+
+void DecodeAheadScheduler::remove(DecodeAheadStream *stream) {
+	Common::StackLock registryLock(_registryMutex);
+
+	bool empty;
+	{
+		Common::StackLock lock(_streamsMutex);
+		_streams.remove(stream);
+		empty = _streams.empty();
+	}
+
+	if (!empty)
+		return;
+
+	// These wait for a running job or callback to finish, which needs
+	// _streamsMutex, so this must not be held here.
+	if (_timerInstalled) {
+		g_system->getTimerManager()->removeTimerProc(&timerProc);
+		_timerInstalled = false;
+	}
+
+	delete _pool;
+	_pool = nullptr;
+	Common::storeRelease(_jobRunning, (uint32)0);
+}
+
+void DecodeAheadScheduler::wakeUp() {
+	// Only streams call this, so the pool is not deleted meanwhile
+	if (!_pool || Common::loadAcquire(_jobRunning))
+		return;
+
+	Common::storeRelease(_jobRunning, (uint32)1);
+	if (!_pool->startBackgroundJob(&jobProc, this))
+		Common::storeRelease(_jobRunning, (uint32)0);
+}
+
+void DecodeAheadScheduler::timerProc(void *refCon) {
+	((DecodeAheadScheduler *)refCon)->decodeAll();
+}
+
+void DecodeAheadScheduler::jobProc(void *refCon) {
+	DecodeAheadScheduler *scheduler = (DecodeAheadScheduler *)refCon;
+	scheduler->decodeAll();
+	Common::storeRelease(scheduler->_jobRunning, (uint32)0);
+}
+
+void DecodeAheadScheduler::decodeAll() {
+	Common::StackLock lock(_streamsMutex);
+
+	for (Common::List<DecodeAheadStream *>::iterator it = _streams.begin(); it != _streams.end(); ++it)
+		(*it)->decodeAhead();
+}
+
+#pragma mark -
+
+SeekableAudioStream *makeDecodeAheadStream(SeekableAudioStream *stream, uint32 lookahead, DisposeAfterUse::Flag disposeAfterUse) {
+	if (!stream || lookahead == 0)
+		return stream;
+
+	return new DecodeAheadStream(stream, stream, lookahead, disposeAfterUse);
+}
+
+AudioStream *makeDecodeAheadStream(AudioStream *stream, uint32 lookahead, DisposeAfterUse::Flag disposeAfterUse) {
+	if (!stream || lookahead == 0)
+		return stream;
+
+	return new DecodeAheadStream(stream, nullptr, lookahead, disposeAfterUse);
+}
+
+} // End of namespace Audio
+
+namespace Common {
+DECLARE_SINGLETON(Audio::DecodeAheadScheduler);
+}
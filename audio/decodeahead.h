@@ -0,0 +1,81 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef AUDIO_DECODEAHEAD_H
+#define AUDIO_DECODEAHEAD_H
+
+#include "common/types.h"
+
+namespace Audio {
+
+/**
+ * @defgroup audio_decodeahead Decode-ahead streams
+ * @ingroup audio
+ *
+ * @brief Decoding compressed audio outside of the mixer thread.
+ * @{
+ */
+
+class AudioStream;
+class SeekableAudioStream;
+
+/**
+ * Wrap a stream so that it is decoded ahead of time in the background,
+ * instead of in the mixer callback when its samples are needed.
+ *
+ * The decoding is done on a worker thread of a Common::ThreadPool, or by a
+ * timer callback on backends without worker threads. It fills a lock-free
+ * ring buffer holding 'lookahead' milliseconds of samples. The mixer then only copies samples out of the
+ * ring buffer. Should the ring buffer ever run empty, the missing samples
+ * are decoded directly, just as without the wrapper.
+ *
+ * This is meant for long compressed streams like MP3, Ogg Vorbis or FLAC
+ * music, where a slow read or a big packet would otherwise stall the mix.
+ *
+ * Seeking and rewinding are supported, and drop the samples decoded so
+ * far. Like with any other stream, they must not be called while the
+ * mixer could be reading from the stream at the same time.
+ *
+ * @param stream           The stream to decode ahead.
+ * @param lookahead        How many milliseconds to decode ahead.
+ * @param disposeAfterUse  Whether to delete the wrapped stream along with the wrapper.
+ *
+ * @return A new stream playing the same samples, or the stream itself if
+ *         lookahead is 0.
+ */
+SeekableAudioStream *makeDecodeAheadStream(SeekableAudioStream *stream, uint32 lookahead = 500,
+                                           DisposeAfterUse::Flag disposeAfterUse = DisposeAfterUse::YES);
+
+/**
+ * Wrap a stream that cannot seek, e.g. a software synthesizer, so that it
+ * is rendered ahead of time in the background. See above for details.
+ *
+ * Anything influencing the output of the stream, like MIDI events, is
+ * heard 'lookahead' milliseconds later than without the wrapper.
+ */
+AudioStream *makeDecodeAheadStream(AudioStream *stream, uint32 lookahead = 500,
+                                   DisposeAfterUse::Flag disposeAfterUse = DisposeAfterUse::YES);
+
+/** @} */
+} // End of namespace Audio
+
+#endif
@@ -24,6 +24,7 @@
 
 #ifdef USE_MAD
 
+#include "common/array.h"
 #include "common/debug.h"
 #include "common/mutex.h"
 #include "common/ptr.h"
@@ -108,6 +109,26 @@ protected:
 	Timestamp _length;
 
 private:
+	/** A frame of the stream, from which decoding may restart. */
+	struct SeekPoint {
+		int32 pos;
+		mad_timer_t time;
+	};
+
+	enum {
+		/** The interval between two seek points, in milliseconds. */
+		SEEK_POINT_INTERVAL = 1000
+	};
+
+	/**
+	 * The seek points found when computing the length of the stream, one
+	 * per second or so, in order. They let seek() skip the frames before
+	 * the destination without reading their headers.
+	 */
+	Common::Array<SeekPoint> _seekPoints;
+
+	void addSeekPoint();
+
 	static Common::SeekableReadStream *skipID3(Common::SeekableReadStream *stream, DisposeAfterUse::Flag dispose);
 };
 
@@ -337,9 +358,11 @@ MP3Stream::MP3Stream(Common::SeekableReadStream *inStream, DisposeAfterUse::Flag
 	_channels = MAD_NCHANNELS(&_frame.header);
 	_rate = _frame.header.samplerate;
 
-	// Calculate the length of the stream
-	while (_state != MP3_STATE_EOS)
+	// Calculate the length of the stream, and note where the frames are
+	while (_state != MP3_STATE_EOS) {
 		readHeader(*_inStream);
+		addSeekPoint();
+	}
 
 	// To rule out any invalid sample rate to be encountered here, say in case the
 	// MP3 stream is invalid, we just check the MAD error code here.
@@ -377,9 +400,21 @@ bool MP3Stream::seek(const Timestamp &where) {
 	mad_timer_t destination;
 	mad_timer_set(&destination, time / 1000, time % 1000, 1000);
 
-	if (_state != MP3_STATE_READY || mad_timer_compare(destination, _curTime) < 0) {
-		_inStream->seek(0);
-		initStream(*_inStream);
+	// Find the last seek point before the destination
+	int point = (int)_seekPoints.size() - 1;
+	while (point >= 0 && mad_timer_compare(_seekPoints[point].time, destination) > 0)
+		--point;
+
+	if (_state != MP3_STATE_READY || mad_timer_compare(destination, _curTime) < 0 ||
+	        (point >= 0 && mad_timer_compare(_seekPoints[point].time, _curTime) > 0)) {
+		if (point >= 0) {
+			_inStream->seek(_seekPoints[point].pos);
+			initStream(*_inStream);
+			_curTime = _seekPoints[point].time;
+		} else {
+			_inStream->seek(0);
+			initStream(*_inStream);
+		}
 	}
 
 	while (mad_timer_compare(destination, _curTime) > 0 && _state != MP3_STATE_EOS)
@@ -390,6 +425,25 @@ bool MP3Stream::seek(const Timestamp &where) {
 	return (_state != MP3_STATE_EOS);
 }
 
+void MP3Stream::addSeekPoint() {
+	if (_state != MP3_STATE_READY || !_stream.next_frame)
+		return;
+
+	if (!_seekPoints.empty()) {
+		mad_timer_t elapsed = _seekPoints.back().time;
+		mad_timer_negate(&elapsed);
+		mad_timer_add(&elapsed, _curTime);
+		if (mad_timer_count(elapsed, MAD_UNITS_MILLISECONDS) < SEEK_POINT_INTERVAL)
+			return;
+	}
+
+	// The next frame starts where MAD stopped reading the buffer
+	SeekPoint point;
+	point.pos = _inStream->pos() - (int32)(_stream.bufend - _stream.next_frame);
+	point.time = _curTime;
+	_seekPoints.push_back(point);
+}
+
 Common::SeekableReadStream *MP3Stream::skipID3(Common::SeekableReadStream *stream, DisposeAfterUse::Flag dispose) {
 	// Skip ID3 TAG if any
 	// ID3v1 (beginning with with 'TAG') is located at the end of files. So we can ignore those.
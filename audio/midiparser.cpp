@@ -50,7 +50,10 @@ _activeTrack(255),
 _abortParse(false),
 _jumpingToTick(false),
 _doParse(true),
-_pause(false) {
+_pause(false),
+_useCheckpoints(false),
+_checkpointTempo(0),
+_checkpointsNeedTempo(false) {
 	memset(_activeNotes, 0, sizeof(_activeNotes));
 	memset(_tracks, 0, sizeof(_tracks));
 	_nextEvent.start = NULL;
@@ -380,6 +383,9 @@ bool MidiParser::setTrack(int track) {
 	if (_disableAutoStartPlayback)
 		_doParse = false;
 
+	if (track != _activeTrack)
+		clearCheckpoints();
+
 	onTrackStart(track);
 
 	_activeTrack = track;
@@ -464,8 +470,45 @@ bool MidiParser::jumpToTick(uint32 tick, bool fireEvents, bool stopNotes, bool d
 	EventInfo currentEvent(_nextEvent);
 
 	resetTracking();
-	_position._playPos = _tracks[_activeTrack];
-	parseNextEvent(_nextEvent);
+
+	const uint32 startTempo = _tempo;
+
+	// The checkpoints are only valid if the track starts with the same tempo
+	if (_checkpointsNeedTempo && _tempo != _checkpointTempo)
+		clearCheckpoints();
+
+	// Find the last checkpoint before the target tick. When replaying the
+	// events, all that is skipped is sending them, so this can only be used
+	// if they should not be sent anyway.
+	int checkpoint = -1;
+	if (!fireEvents) {
+		int high = _checkpoints.size();
+		while (checkpoint + 1 < high) {
+			const int middle = (checkpoint + 1 + high) / 2;
+			if (_checkpoints[middle].getTick() < tick)
+				checkpoint = middle;
+			else
+				high = middle;
+		}
+	}
+
+	if (checkpoint >= 0) {
+		_position = _checkpoints[checkpoint].position;
+		_nextEvent = _checkpoints[checkpoint].nextEvent;
+		setTempo(_checkpoints[checkpoint].tempo);
+		restoreCheckpointState(checkpoint);
+	} else {
+		_position._playPos = _tracks[_activeTrack];
+		parseNextEvent(_nextEvent);
+	}
+
+	// New checkpoints are recorded when parsing beyond the last one
+	const bool recordCheckpoints = _useCheckpoints && checkpoint + 1 == (int)_checkpoints.size();
+	bool tempoKnown = !_checkpoints.empty();
+	bool needTempo = _checkpointsNeedTempo;
+	uint32 lastCheckpointTick = _checkpoints.empty() ? 0 : _checkpoints.back().getTick();
+	uint events = 0;
+
 	if (tick > 0) {
 		while (true) {
 			EventInfo &info = _nextEvent;
@@ -475,6 +518,17 @@ bool MidiParser::jumpToTick(uint32 tick, bool fireEvents, bool stopNotes, bool d
 				break;
 			}
 
+			if (!tempoKnown) {
+				// Ticks passing before the first tempo event depend on the
+				// initial tempo
+				if (info.delta > 0) {
+					needTempo = true;
+					tempoKnown = true;
+				} else if (info.event == 0xFF && info.ext.type == 0x51) {
+					tempoKnown = true;
+				}
+			}
+
 			_position._lastEventTick += info.delta;
 			_position._lastEventTime += info.delta * _psecPerTick;
 			_position._playTick = _position._lastEventTick;
@@ -496,6 +550,21 @@ bool MidiParser::jumpToTick(uint32 tick, bool fireEvents, bool stopNotes, bool d
 			}
 
 			parseNextEvent(_nextEvent);
+
+			if (recordCheckpoints && ++events >= CHECKPOINT_INTERVAL && tempoKnown &&
+			    _position._lastEventTick + _nextEvent.delta > lastCheckpointTick) {
+				Checkpoint newCheckpoint;
+				newCheckpoint.position = _position;
+				newCheckpoint.nextEvent = _nextEvent;
+				newCheckpoint.tempo = _tempo;
+				_checkpoints.push_back(newCheckpoint);
+				saveCheckpointState(_checkpoints.size() - 1);
+
+				_checkpointTempo = startTempo;
+				_checkpointsNeedTempo = needTempo;
+				lastCheckpointTick = newCheckpoint.getTick();
+				events = 0;
+			}
 		}
 	}
 
@@ -520,12 +589,18 @@ bool MidiParser::jumpToTick(uint32 tick, bool fireEvents, bool stopNotes, bool d
 	return true;
 }
 
+void MidiParser::clearCheckpoints() {
+	_checkpoints.clear();
+	_checkpointsNeedTempo = false;
+}
+
 void MidiParser::unloadMusic() {
 	if (_numTracks == 0)
 		// No music data loaded
 		return;
 
 	stopPlaying();
+	clearCheckpoints();
 	_numTracks = 0;
 	_activeTrack = 255;
 	_abortParse = true;
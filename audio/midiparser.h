@@ -26,6 +26,7 @@
 #define AUDIO_MIDIPARSER_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
 #include "common/endian.h"
 
 class MidiDriver_BASE;
@@ -287,6 +288,7 @@ struct NoteTimer {
 class MidiParser {
 protected:
 	static const uint8 MAXIMUM_TRACKS = 120;
+	static const uint16 CHECKPOINT_INTERVAL = 256; ///< Number of events parsed between checkpoints.
 
 	uint16    _activeNotes[128];   ///< Each uint16 is a bit mask for channels that have that note on.
 	NoteTimer _hangingNotes[32];   ///< Maintains expiration info for up to 32 notes.
@@ -318,6 +320,27 @@ protected:
 	bool   _doParse;       ///< True if the parser should be parsing; false if it should not be active
 	bool   _pause;		   ///< True if the parser has paused parsing
 
+	/**
+	 * A snapshot of the parser state at some event in the active track.
+	 * jumpToTick() resumes parsing at the closest one before the target,
+	 * instead of parsing the whole track from the start.
+	 */
+	struct Checkpoint {
+		Tracker   position;  ///< The position after parsing nextEvent.
+		EventInfo nextEvent; ///< The next event from that position.
+		uint32    tempo;     ///< The tempo at that position.
+
+		/** The tick at which nextEvent occurs. */
+		uint32 getTick() const { return position._lastEventTick + nextEvent.delta; }
+	};
+
+	bool   _useCheckpoints; ///< True if jumpToTick() may record and use checkpoints. Set by parsers
+	                        ///< whose parsing state is fully stored by them.
+	Common::Array<Checkpoint> _checkpoints; ///< Checkpoints in the active track, in order of their tick.
+	uint32 _checkpointTempo; ///< The tempo the checkpoints were recorded with at the start of the track.
+	bool   _checkpointsNeedTempo; ///< True if the track has ticks before its first tempo event, so that
+	                              ///< the checkpoints are only valid with _checkpointTempo.
+
 protected:
 	static uint32 readVLQ(byte * &data);
 	virtual void resetTracking();
@@ -325,6 +348,15 @@ protected:
 	virtual void parseNextEvent(EventInfo &info) = 0;
 	virtual bool processEvent(const EventInfo &info, bool fireEvents = true);
 
+	void clearCheckpoints();
+	/**
+	 * Called when jumpToTick() recorded or resumes from the checkpoint with
+	 * the specified index. Parsers keeping state outside of the Tracker
+	 * must save and restore it here.
+	 */
+	virtual void saveCheckpointState(uint index) { }
+	virtual void restoreCheckpointState(uint index) { }
+
 	void activeNote(byte channel, byte note, bool active);
 	void hangingNote(byte channel, byte note, uint32 ticksLeft, bool recycle = true);
 	void hangAllActiveNotes();
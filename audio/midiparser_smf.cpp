@@ -49,7 +49,7 @@ protected:
 	void sendMetaEventToDriver(byte type, byte *data, uint16 length) override;
 
 public:
-	MidiParser_SMF(int8 source = -1) : _buffer(0), _malformedPitchBends(false), _source(source) { }
+	MidiParser_SMF(int8 source = -1) : _buffer(0), _malformedPitchBends(false), _source(source) { _useCheckpoints = true; }
 	~MidiParser_SMF();
 
 	bool loadMusic(byte *data, uint32 size) override;
@@ -68,6 +68,7 @@ void MidiParser_SMF::property(int prop, int value) {
 	switch (prop) {
 	case mpMalformedPitchBends:
 		_malformedPitchBends = (value > 0);
+		clearCheckpoints();
 		break;
 	default:
 		MidiParser::property(prop, value);
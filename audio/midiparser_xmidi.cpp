@@ -44,6 +44,13 @@ protected:
 	Loop _loop[4];
 	int _loopCount;
 
+	/** The loop state at each checkpoint. */
+	struct LoopState {
+		Loop loop[4];
+		int loopCount;
+	};
+	Common::Array<LoopState> _checkpointLoops;
+
 	/**
 	 * The source number to use when sending MIDI messages to the driver.
 	 * When using multiple sources, use source 0 and higher. This must be
@@ -89,6 +96,9 @@ protected:
 	}
 	void onTrackStart(uint8 track) override;
 
+	void saveCheckpointState(uint index) override;
+	void restoreCheckpointState(uint index) override;
+
 	void sendToDriver(uint32 b) override;
 	void sendMetaEventToDriver(byte type, byte *data, uint16 length) override;
 public:
@@ -102,6 +112,10 @@ public:
 		memset(_trackBranches, 0, sizeof(_trackBranches));
 		memset(_tracksTimbreList, 0, sizeof(_tracksTimbreList));
 		memset(_tracksTimbreListSize, 0, sizeof(_tracksTimbreListSize));
+
+		// Jumping to a checkpoint skips the callback triggers before it,
+		// so checkpoints are only used without a callback
+		_useCheckpoints = (!proc || proc == defaultXMidiCallback);
 	}
 	~MidiParser_XMIDI() { stopPlaying(); }
 
@@ -533,6 +547,17 @@ void MidiParser_XMIDI::onTrackStart(uint8 track) {
 		_newTimbreListDriver->processXMIDITimbreChunk(_tracksTimbreList[track], _tracksTimbreListSize[track]);
 }
 
+void MidiParser_XMIDI::saveCheckpointState(uint index) {
+	_checkpointLoops.resize(index + 1);
+	memcpy(_checkpointLoops[index].loop, _loop, sizeof(_loop));
+	_checkpointLoops[index].loopCount = _loopCount;
+}
+
+void MidiParser_XMIDI::restoreCheckpointState(uint index) {
+	memcpy(_loop, _checkpointLoops[index].loop, sizeof(_loop));
+	_loopCount = _checkpointLoops[index].loopCount;
+}
+
 void MidiParser_XMIDI::sendToDriver(uint32 b) {
 	if (_source < 0) {
 		MidiParser::sendToDriver(b);
@@ -22,6 +22,7 @@
 
 #include "gui/EventRecorder.h"
 
+#include "common/config-manager.h"
 #include "common/util.h"
 #include "common/textconsole.h"
 
@@ -55,7 +56,7 @@ public:
 	 *             16 bits, for a total of 40 bytes.
 	 * @return number of sample pairs processed (which can still be silence!)
 	 */
-	int mix(int16 *data, uint len);
+	int mix(int32 *data, uint len);
 
 	/**
 	 * Queries whether the channel is still playing or not.
@@ -143,6 +144,24 @@ public:
 	 */
 	SoundHandle getHandle() const { return _handle; }
 
+	/**
+	 * Adds the cost of a mix() call to the channel's statistics.
+	 *
+	 * @param micros  time spent in mix()
+	 * @param samples number of sample pairs mix() produced
+	 */
+	void addStatistics(uint32 micros, int samples);
+
+	/**
+	 * Fills in the channel's performance statistics.
+	 */
+	void getStatistics(Mixer::ChannelStatistics &stats) const;
+
+	/**
+	 * Resets the channel's performance statistics to zero.
+	 */
+	void resetStatistics();
+
 private:
 	const Mixer::SoundType _type;
 	SoundHandle _handle;
@@ -166,6 +185,10 @@ private:
 
 	RateConverter *_converter;
 	Common::DisposablePtr<AudioStream> _stream;
+
+	uint64 _statsSamples;
+	uint64 _statsMixMicros;
+	uint32 _statsMaxMixMicros;
 };
 
 #pragma mark -
@@ -173,17 +196,25 @@ private:
 #pragma mark -
 
 MixerImpl::MixerImpl(uint sampleRate)
-	: _mutex(), _sampleRate(sampleRate), _mixerReady(false), _handleSeed(0), _soundTypeSettings() {
+	: _mutex("mixer"), _sampleRate(sampleRate), _mixerReady(false), _handleSeed(0), _soundTypeSettings(),
+	  _commandMutex("mixer commands"), _mixBus(0), _mixBusSize(0), _statsEnabled(false) {
 
 	assert(sampleRate > 0);
 
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		_channels[i] = 0;
+
+	resetStatistics();
 }
 
 MixerImpl::~MixerImpl() {
+	// Channels may still wait to be inserted
+	processCommands();
+
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		delete _channels[i];
+
+	free(_mixBus);
 }
 
 void MixerImpl::setReady(bool ready) {
@@ -196,29 +227,14 @@ uint MixerImpl::getOutputRate() const {
 	return _sampleRate;
 }
 
-void MixerImpl::insertChannel(SoundHandle *handle, Channel *chan) {
-	int index = -1;
-	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] == 0) {
-			index = i;
-			break;
-		}
-	}
-	if (index == -1) {
-		warning("MixerImpl::out of mixer slots");
-		delete chan;
-		return;
-	}
-
-	_channels[index] = chan;
-
-	SoundHandle chanHandle;
-	chanHandle._val = index + (_handleSeed * NUM_CHANNELS);
+bool MixerImpl::isSlotActive(int index) const {
+	const uint32 handle = Common::loadAcquire(_slots[index].handle);
+	return handle != FREE_SLOT && Common::loadAcquire(_slots[index].finishedHandle) != handle;
+}
 
-	chan->setHandle(chanHandle);
-	_handleSeed++;
-	if (handle)
-		*handle = chanHandle;
+bool MixerImpl::isActive(SoundHandle handle) const {
+	const int index = handle._val % NUM_CHANNELS;
+	return Common::loadAcquire(_slots[index].handle) == handle._val && isSlotActive(index);
 }
 
 void MixerImpl::playStream(
@@ -229,8 +245,6 @@ void MixerImpl::playStream(
 			DisposeAfterUse::Flag autofreeStream,
 			bool permanent,
 			bool reverseStereo) {
-	Common::StackLock lock(_mutex);
-
 	if (stream == 0) {
 		warning("stream is 0");
 		return;
@@ -239,10 +253,14 @@ void MixerImpl::playStream(
 
 	assert(_mixerReady);
 
+	lockCommands(1);
+
 	// Prevent duplicate sounds
 	if (id != -1) {
 		for (int i = 0; i != NUM_CHANNELS; i++)
-			if (_channels[i] != 0 && _channels[i]->getId() == id) {
+			if (isSlotActive(i) && _slots[i].id == id) {
+				_commandMutex.unlock();
+
 				// Delete the stream if were asked to auto-dispose it.
 				// Note: This could cause trouble if the client code does not
 				// yet expect the stream to be gone. The primary example to
@@ -255,6 +273,21 @@ void MixerImpl::playStream(
 			}
 	}
 
+	int index = -1;
+	for (int i = 0; i != NUM_CHANNELS; i++) {
+		if (!isSlotActive(i)) {
+			index = i;
+			break;
+		}
+	}
+	if (index == -1) {
+		_commandMutex.unlock();
+		warning("MixerImpl::out of mixer slots");
+		if (autofreeStream == DisposeAfterUse::YES)
+			delete stream;
+		return;
+	}
+
 #ifdef AUDIO_REVERSE_STEREO
 	reverseStereo = !reverseStereo;
 #endif
@@ -263,13 +296,32 @@ void MixerImpl::playStream(
 	Channel *chan = new Channel(this, type, stream, autofreeStream, reverseStereo, id, permanent);
 	chan->setVolume(volume);
 	chan->setBalance(balance);
-	insertChannel(handle, chan);
+
+	SoundHandle chanHandle;
+	chanHandle._val = index + (_handleSeed * NUM_CHANNELS);
+	_handleSeed++;
+	chan->setHandle(chanHandle);
+
+	Slot &slot = _slots[index];
+	slot.id = id;
+	slot.type = type;
+	slot.permanent = permanent;
+	slot.volume = volume;
+	slot.balance = balance;
+	Common::storeRelease(slot.handle, chanHandle._val);
+
+	queueCommand(Command::kInsert, chanHandle, 0, chan);
+	_commandMutex.unlock();
+
+	if (handle)
+		*handle = chanHandle;
 }
 
 int MixerImpl::mixCallback(byte *samples, uint len) {
 	assert(samples);
 
 	Common::StackLock lock(_mutex);
+	processCommands();
 
 	int16 *buf = (int16 *)samples;
 	// we store stereo, 16-bit samples
@@ -279,57 +331,97 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 	// Since the mixer callback has been called, the mixer must be ready...
 	_mixerReady = true;
 
-	//  zero the buf
-	memset(buf, 0, 2 * len * sizeof(int16));
+	// The channels are summed up in a 32-bit bus, which is only clamped
+	// to 16 bits once all channels have been mixed.
+	if (len > _mixBusSize) {
+		free(_mixBus);
+		_mixBus = (int32 *)malloc(2 * len * sizeof(int32));
+		if (!_mixBus)
+			error("[MixerImpl::mixCallback] Cannot allocate memory for mix bus");
+		_mixBusSize = len;
+	}
+
+	//  zero the bus
+	memset(_mixBus, 0, 2 * len * sizeof(int32));
+
+	const uint64 start = _statsEnabled ? g_system->getMicros() : 0;
 
 	// mix all channels
 	int res = 0, tmp;
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		if (_channels[i]) {
 			if (_channels[i]->isFinished()) {
-				delete _channels[i];
-				_channels[i] = 0;
+				delete removeChannel(i);
 			} else if (!_channels[i]->isPaused()) {
-				tmp = _channels[i]->mix(buf, len);
+				if (_statsEnabled) {
+					const uint64 channelStart = g_system->getMicros();
+					tmp = _channels[i]->mix(_mixBus, len);
+					_channels[i]->addStatistics((uint32)(g_system->getMicros() - channelStart), tmp);
+				} else {
+					tmp = _channels[i]->mix(_mixBus, len);
+				}
 
 				if (tmp > res)
 					res = tmp;
 			}
 		}
 
+	clampMixBus(buf, _mixBus, 2 * len);
+
+	if (_statsEnabled) {
+		const uint32 elapsed = (uint32)(g_system->getMicros() - start);
+		const uint64 duration = (uint64)len * 1000000 / _sampleRate;
+
+		_stats.callbacks++;
+		_stats.mixMicros += elapsed;
+		_stats.audioMicros += duration;
+		if (elapsed > _stats.maxMixMicros)
+			_stats.maxMixMicros = elapsed;
+		// The backend would have needed the data already
+		if (elapsed > duration)
+			_stats.overruns++;
+	}
+
 	return res;
 }
 
 void MixerImpl::stopAll() {
-	Common::StackLock lock(_mutex);
+	lockCommands(NUM_CHANNELS);
 	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != 0 && !_channels[i]->isPermanent()) {
-			delete _channels[i];
-			_channels[i] = 0;
-		}
+		if (isSlotActive(i) && !_slots[i].permanent)
+			queueStop(i);
 	}
+	_commandMutex.unlock();
+
+	flushCommands();
 }
 
 void MixerImpl::stopID(int id) {
-	Common::StackLock lock(_mutex);
+	lockCommands(NUM_CHANNELS);
 	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != 0 && _channels[i]->getId() == id) {
-			delete _channels[i];
-			_channels[i] = 0;
-		}
+		if (isSlotActive(i) && _slots[i].id == id)
+			queueStop(i);
 	}
+	_commandMutex.unlock();
+
+	flushCommands();
 }
 
 void MixerImpl::stopHandle(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
-
+	lockCommands(1);
 	// Simply ignore stop requests for handles of sounds that already terminated
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
+	if (isActive(handle))
+		queueStop(handle._val % NUM_CHANNELS);
+	_commandMutex.unlock();
 
-	delete _channels[index];
-	_channels[index] = 0;
+	flushCommands();
+}
+
+void MixerImpl::queueStop(int index) {
+	SoundHandle handle;
+	handle._val = _slots[index].handle;
+	Common::storeRelease(_slots[index].handle, (uint32)FREE_SLOT);
+	queueCommand(Command::kStop, handle);
 }
 
 void MixerImpl::muteSoundType(SoundType type, bool mute) {
@@ -348,39 +440,124 @@ bool MixerImpl::isSoundTypeMuted(SoundType type) const {
 }
 
 void MixerImpl::setChannelVolume(SoundHandle handle, byte volume) {
-	Common::StackLock lock(_mutex);
-
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
-
-	_channels[index]->setVolume(volume);
+	lockCommands(1);
+	if (isActive(handle)) {
+		_slots[handle._val % NUM_CHANNELS].volume = volume;
+		queueCommand(Command::kSetVolume, handle, volume);
+	}
+	_commandMutex.unlock();
 }
 
 byte MixerImpl::getChannelVolume(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	if (!isActive(handle))
 		return 0;
 
-	return _channels[index]->getVolume();
+	return _slots[handle._val % NUM_CHANNELS].volume;
 }
 
 void MixerImpl::setChannelBalance(SoundHandle handle, int8 balance) {
-	Common::StackLock lock(_mutex);
-
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
-
-	_channels[index]->setBalance(balance);
+	lockCommands(1);
+	if (isActive(handle)) {
+		_slots[handle._val % NUM_CHANNELS].balance = balance;
+		queueCommand(Command::kSetBalance, handle, balance);
+	}
+	_commandMutex.unlock();
 }
 
 int8 MixerImpl::getChannelBalance(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	if (!isActive(handle))
 		return 0;
 
-	return _channels[index]->getBalance();
+	return _slots[handle._val % NUM_CHANNELS].balance;
+}
+
+void MixerImpl::lockCommands(uint count) {
+	for (;;) {
+		_commandMutex.lock();
+		if (_commands.capacity() - _commands.size() >= count)
+			return;
+		_commandMutex.unlock();
+
+		// The queue is full, which means the mixer callback is not running.
+		// Execute the queued commands here, then try again.
+		Common::StackLock lock(_mutex);
+		processCommands();
+	}
+}
+
+void MixerImpl::queueCommand(Command::Type type, SoundHandle handle, int value, Channel *channel) {
+	Command cmd;
+	cmd.type = type;
+	cmd.handle = handle;
+	cmd.value = value;
+	cmd.channel = channel;
+
+	// lockCommands() made room for the command
+	const bool queued = _commands.push(cmd);
+	assert(queued);
+	(void)queued;
+}
+
+void MixerImpl::flushCommands() {
+	Common::Array<Channel *> stopped;
+	{
+		Common::StackLock lock(_mutex);
+		processCommands(&stopped);
+	}
+
+	for (uint i = 0; i < stopped.size(); i++)
+		delete stopped[i];
+}
+
+void MixerImpl::processCommands(Common::Array<Channel *> *stopped) {
+	Command cmd;
+	while (_commands.pop(cmd))
+		executeCommand(cmd, stopped);
+}
+
+void MixerImpl::executeCommand(const Command &cmd, Common::Array<Channel *> *stopped) {
+	const int index = cmd.handle._val % NUM_CHANNELS;
+
+	if (cmd.type == Command::kInsert) {
+		// A slot is only reused once its previous channel was removed
+		assert(!_channels[index]);
+		_channels[index] = cmd.channel;
+		return;
+	}
+
+	// Simply ignore commands for sounds that already terminated
+	if (!_channels[index] || _channels[index]->getHandle()._val != cmd.handle._val)
+		return;
+
+	switch (cmd.type) {
+	case Command::kStop: {
+		Channel *chan = removeChannel(index);
+		if (stopped)
+			stopped->push_back(chan);
+		else
+			delete chan;
+		break;
+	}
+	case Command::kPause:
+		_channels[index]->pause(cmd.value != 0);
+		break;
+	case Command::kSetVolume:
+		_channels[index]->setVolume(cmd.value);
+		break;
+	case Command::kSetBalance:
+		_channels[index]->setBalance(cmd.value);
+		break;
+	default:
+		break;
+	}
+}
+
+Channel *MixerImpl::removeChannel(int index) {
+	Channel *chan = _channels[index];
+	_channels[index] = 0;
+	// Tell the engine side that the slot can be reused
+	Common::storeRelease(_slots[index].finishedHandle, chan->getHandle()._val);
+	return chan;
 }
 
 uint32 MixerImpl::getSoundElapsedTime(SoundHandle handle) {
@@ -389,6 +566,7 @@ uint32 MixerImpl::getSoundElapsedTime(SoundHandle handle) {
 
 Timestamp MixerImpl::getElapsedTime(SoundHandle handle) {
 	Common::StackLock lock(_mutex);
+	processCommands();
 
 	const int index = handle._val % NUM_CHANNELS;
 	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
@@ -398,71 +576,66 @@ Timestamp MixerImpl::getElapsedTime(SoundHandle handle) {
 }
 
 void MixerImpl::pauseAll(bool paused) {
-	Common::StackLock lock(_mutex);
+	lockCommands(NUM_CHANNELS);
 	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != 0) {
-			_channels[i]->pause(paused);
+		if (isSlotActive(i)) {
+			SoundHandle handle;
+			handle._val = _slots[i].handle;
+			queueCommand(Command::kPause, handle, paused);
 		}
 	}
+	_commandMutex.unlock();
 }
 
 void MixerImpl::pauseID(int id, bool paused) {
-	Common::StackLock lock(_mutex);
+	lockCommands(1);
 	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != 0 && _channels[i]->getId() == id) {
-			_channels[i]->pause(paused);
-			return;
+		if (isSlotActive(i) && _slots[i].id == id) {
+			SoundHandle handle;
+			handle._val = _slots[i].handle;
+			queueCommand(Command::kPause, handle, paused);
+			break;
 		}
 	}
+	_commandMutex.unlock();
 }
 
 void MixerImpl::pauseHandle(SoundHandle handle, bool paused) {
-	Common::StackLock lock(_mutex);
-
+	lockCommands(1);
 	// Simply ignore (un)pause requests for sounds that already terminated
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
-
-	_channels[index]->pause(paused);
+	if (isActive(handle))
+		queueCommand(Command::kPause, handle, paused);
+	_commandMutex.unlock();
 }
 
 bool MixerImpl::isSoundIDActive(int id) {
-	Common::StackLock lock(_mutex);
-
 #ifdef ENABLE_EVENTRECORDER
 	g_eventRec.updateSubsystems();
 #endif
 
 	for (int i = 0; i != NUM_CHANNELS; i++)
-		if (_channels[i] && _channels[i]->getId() == id)
+		if (isSlotActive(i) && _slots[i].id == id)
 			return true;
 	return false;
 }
 
 int MixerImpl::getSoundID(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
-	const int index = handle._val % NUM_CHANNELS;
-	if (_channels[index] && _channels[index]->getHandle()._val == handle._val)
-		return _channels[index]->getId();
+	if (isActive(handle))
+		return _slots[handle._val % NUM_CHANNELS].id;
 	return 0;
 }
 
 bool MixerImpl::isSoundHandleActive(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
-
 #ifdef ENABLE_EVENTRECORDER
 	g_eventRec.updateSubsystems();
 #endif
 
-	const int index = handle._val % NUM_CHANNELS;
-	return _channels[index] && _channels[index]->getHandle()._val == handle._val;
+	return isActive(handle);
 }
 
 bool MixerImpl::hasActiveChannelOfType(SoundType type) {
-	Common::StackLock lock(_mutex);
 	for (int i = 0; i != NUM_CHANNELS; i++)
-		if (_channels[i] && _channels[i]->getType() == type)
+		if (isSlotActive(i) && _slots[i].type == type)
 			return true;
 	return false;
 }
@@ -477,6 +650,7 @@ void MixerImpl::setVolumeForSoundType(SoundType type, int volume) {
 	// scaling? See also Player_V2::setMasterVolume
 
 	Common::StackLock lock(_mutex);
+	processCommands();
 	_soundTypeSettings[type].volume = volume;
 
 	for (int i = 0; i != NUM_CHANNELS; ++i) {
@@ -491,6 +665,44 @@ int MixerImpl::getVolumeForSoundType(SoundType type) const {
 	return _soundTypeSettings[type].volume;
 }
 
+void MixerImpl::enableStatistics(bool enable) {
+	Common::StackLock lock(_mutex);
+
+	if (enable && !_statsEnabled)
+		resetStatistics();
+	_statsEnabled = enable;
+}
+
+bool MixerImpl::getStatistics(Statistics &stats) {
+	Common::StackLock lock(_mutex);
+	processCommands();
+
+	stats = _stats;
+	for (int i = 0; i != NUM_CHANNELS; i++) {
+		if (_channels[i]) {
+			ChannelStatistics channelStats;
+			_channels[i]->getStatistics(channelStats);
+			stats.channels.push_back(channelStats);
+		}
+	}
+	return true;
+}
+
+void MixerImpl::resetStatistics() {
+	Common::StackLock lock(_mutex);
+
+	_stats.callbacks = 0;
+	_stats.overruns = 0;
+	_stats.mixMicros = 0;
+	_stats.audioMicros = 0;
+	_stats.maxMixMicros = 0;
+
+	for (int i = 0; i != NUM_CHANNELS; i++) {
+		if (_channels[i])
+			_channels[i]->resetStatistics();
+	}
+}
+
 
 #pragma mark -
 #pragma mark --- Channel implementations ---
@@ -501,12 +713,13 @@ Channel::Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream,
 	: _type(type), _mixer(mixer), _id(id), _permanent(permanent), _volume(Mixer::kMaxChannelVolume),
 	  _balance(0), _pauseLevel(0), _samplesConsumed(0), _samplesDecoded(0), _mixerTimeStamp(0),
 	  _pauseStartTime(0), _pauseTime(0), _converter(0), _volL(0), _volR(0),
-	  _stream(stream, autofreeStream) {
+	  _stream(stream, autofreeStream), _statsSamples(0), _statsMixMicros(0), _statsMaxMixMicros(0) {
 	assert(mixer);
 	assert(stream);
 
 	// Get a rate converter instance
-	_converter = makeRateConverter(_stream->getRate(), mixer->getOutputRate(), _stream->isStereo(), reverseStereo);
+	const RateConverterQuality quality = (RateConverterQuality)CLIP<int>(ConfMan.getInt("resampling_quality"), kRateConverterLinear, kRateConverterSincHigh);
+	_converter = makeRateConverter(_stream->getRate(), mixer->getOutputRate(), _stream->isStereo(), reverseStereo, quality);
 }
 
 Channel::~Channel() {
@@ -604,7 +817,7 @@ Timestamp Channel::getElapsedTime() {
 	return ts;
 }
 
-int Channel::mix(int16 *data, uint len) {
+int Channel::mix(int32 *data, uint len) {
 	assert(_stream);
 
 	int res = 0;
@@ -615,11 +828,36 @@ int Channel::mix(int16 *data, uint len) {
 		_samplesConsumed = _samplesDecoded;
 		_mixerTimeStamp = g_system->getMillis(true);
 		_pauseTime = 0;
-		res = _converter->flow(*_stream, data, len, _volL, _volR);
+		res = _converter->flowMix(*_stream, data, len, _volL, _volR);
 		_samplesDecoded += res;
 	}
 
 	return res;
 }
 
+void Channel::addStatistics(uint32 micros, int samples) {
+	_statsSamples += samples;
+	_statsMixMicros += micros;
+	if (micros > _statsMaxMixMicros)
+		_statsMaxMixMicros = micros;
+}
+
+void Channel::getStatistics(Mixer::ChannelStatistics &stats) const {
+	stats.handle = _handle;
+	stats.id = _id;
+	stats.type = _type;
+	stats.inputRate = _stream->getRate();
+	stats.stereo = _stream->isStereo();
+	stats.converter = _converter->getName();
+	stats.samples = _statsSamples;
+	stats.mixMicros = _statsMixMicros;
+	stats.maxMixMicros = _statsMaxMixMicros;
+}
+
+void Channel::resetStatistics() {
+	_statsSamples = 0;
+	_statsMixMicros = 0;
+	_statsMaxMixMicros = 0;
+}
+
 } // End of namespace Audio
@@ -23,6 +23,7 @@
 #ifndef AUDIO_MIXER_H
 #define AUDIO_MIXER_H
 
+#include "common/array.h"
 #include "common/mutex.h"
 #include "common/types.h"
 #include "common/noncopyable.h"
@@ -300,6 +301,64 @@ public:
 	 * @return The output sample rate in Hz.
 	 */
 	virtual uint getOutputRate() const = 0;
+
+	/**
+	 * Performance statistics of a playing channel.
+	 *
+	 * @see getStatistics()
+	 */
+	struct ChannelStatistics {
+		SoundHandle handle;
+		int id;
+		SoundType type;
+		uint inputRate;         /*!< Sample rate of the channel's stream. */
+		bool stereo;
+		const char *converter;  /*!< Name of the rate converter used for the channel. */
+		uint64 samples;         /*!< Number of sample pairs produced. */
+		uint64 mixMicros;       /*!< Total time spent mixing the channel. */
+		uint32 maxMixMicros;    /*!< Longest time spent mixing the channel in a single callback. */
+	};
+
+	/**
+	 * Performance statistics of the mixer callback.
+	 *
+	 * @see getStatistics()
+	 */
+	struct Statistics {
+		uint32 callbacks;       /*!< Number of mixer callbacks. */
+		uint32 overruns;        /*!< Number of callbacks that took longer than the audio they produced. */
+		uint64 mixMicros;       /*!< Total time spent in the mixer callback. */
+		uint64 audioMicros;     /*!< Total duration of the audio produced by the mixer callback. */
+		uint32 maxMixMicros;    /*!< Longest mixer callback. */
+
+		Common::Array<ChannelStatistics> channels; /*!< Statistics of all currently playing channels. */
+	};
+
+	/**
+	 * Enable or disable the collection of performance statistics. They are
+	 * disabled by default, as measuring costs some time in each callback.
+	 * Enabling resets all statistics.
+	 */
+	virtual void enableStatistics(bool enable) {}
+
+	/**
+	 * Check whether performance statistics are being collected.
+	 */
+	virtual bool isStatisticsEnabled() const { return false; }
+
+	/**
+	 * Retrieve the collected performance statistics.
+	 *
+	 * @param stats  Receives the statistics.
+	 *
+	 * @return False if the mixer does not support collecting statistics.
+	 */
+	virtual bool getStatistics(Statistics &stats) { return false; }
+
+	/**
+	 * Reset all collected performance statistics to zero.
+	 */
+	virtual void resetStatistics() {}
 };
 
 /** @} */
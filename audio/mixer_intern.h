@@ -24,7 +24,9 @@
 #define AUDIO_MIXER_INTERN_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
 #include "common/mutex.h"
+#include "common/spscqueue.h"
 #include "audio/mixer.h"
 
 namespace Audio {
@@ -76,8 +78,73 @@ private:
 	};
 
 	SoundTypeSettings _soundTypeSettings[4];
+
+	/** The playing channels, only accessed with _mutex held. */
 	Channel *_channels[NUM_CHANNELS];
 
+	enum {
+		/** Handle value of a slot that holds no channel. */
+		FREE_SLOT = 0xFFFFFFFF
+	};
+
+	/**
+	 * The state of a channel slot as the engine sees it. All fields but
+	 * finishedHandle are written by the producers of _commands, with
+	 * _commandMutex held. finishedHandle is written by the consumer when
+	 * it frees a channel. The getters read them without taking any lock.
+	 */
+	struct Slot {
+		Slot() : handle(FREE_SLOT), finishedHandle(FREE_SLOT), id(-1), type(kPlainSoundType),
+			permanent(false), volume(kMaxChannelVolume), balance(0) {}
+
+		volatile uint32 handle;
+		volatile uint32 finishedHandle;
+		int id;
+		SoundType type;
+		bool permanent;
+		volatile byte volume;
+		volatile int8 balance;
+	};
+
+	Slot _slots[NUM_CHANNELS];
+
+	/**
+	 * A change of the playing channels requested by the engine, which is
+	 * applied by whoever next holds _mutex (usually the mixer callback).
+	 * This way the engine never holds _mutex while a channel is created,
+	 * and the mixer callback only ever waits for the queue to be drained.
+	 */
+	struct Command {
+		enum Type {
+			kInsert,
+			kStop,
+			kPause,
+			kSetVolume,
+			kSetBalance
+		};
+
+		Type type;
+		SoundHandle handle;
+		int value;
+		Channel *channel;
+	};
+
+	enum {
+		COMMAND_QUEUE_SIZE = 256
+	};
+
+	/** Serialises the producers of _commands; the consumer never takes it. */
+	Common::Mutex _commandMutex;
+	Common::SPSCQueue<Command, COMMAND_QUEUE_SIZE> _commands;
+
+	/** 32-bit accumulation buffer for mixCallback(), holding _mixBusSize sample pairs */
+	int32 *_mixBus;
+	uint _mixBusSize;
+
+	bool _statsEnabled;
+	/** Callback statistics; the channel list is only filled in getStatistics(). */
+	Statistics _stats;
+
 
 public:
 
@@ -128,8 +195,43 @@ public:
 
 	virtual uint getOutputRate() const;
 
+	virtual void enableStatistics(bool enable);
+	virtual bool isStatisticsEnabled() const { return _statsEnabled; }
+	virtual bool getStatistics(Statistics &stats);
+	virtual void resetStatistics();
+
 protected:
-	void insertChannel(SoundHandle *handle, Channel *chan);
+	/** Return whether the slot of the handle holds its channel, as seen by the engine. */
+	bool isActive(SoundHandle handle) const;
+	bool isSlotActive(int index) const;
+
+	/**
+	 * Lock _commandMutex once the queue has room for @p count commands,
+	 * draining the queue first if the mixer callback does not run.
+	 */
+	void lockCommands(uint count);
+	void queueCommand(Command::Type type, SoundHandle handle, int value = 0, Channel *channel = nullptr);
+
+	/** Queue stopping the channel of a slot. Must be called with _commandMutex held. */
+	void queueStop(int index);
+
+	/**
+	 * Execute the queued commands from the engine thread, so that stopped
+	 * channels are not used anymore once this returns. The channels are
+	 * deleted once _mutex is released again.
+	 */
+	void flushCommands();
+
+	/**
+	 * Execute all queued commands. Must be called with _mutex held.
+	 *
+	 * @param stopped  If set, stopped channels are appended there instead of being deleted.
+	 */
+	void processCommands(Common::Array<Channel *> *stopped = nullptr);
+	void executeCommand(const Command &cmd, Common::Array<Channel *> *stopped);
+
+	/** Remove the channel of a slot. Must be called with _mutex held. */
+	Channel *removeChannel(int index);
 
 public:
 	/**
@@ -4,6 +4,7 @@ MODULE_OBJS := \
 	adlib.o \
 	adlib_ms.o \
 	audiostream.o \
+	decodeahead.o \
 	fmopl.o \
 	mididrv.o \
 	mididrv_ms.o \
@@ -19,6 +20,7 @@ MODULE_OBJS := \
 	mt32gm.o \
 	musicplugin.o \
 	null.o \
+	pcmcache.o \
 	rate.o \
 	timestamp.o \
 	decoders/3do.o \
@@ -0,0 +1,244 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "audio/pcmcache.h"
+#include "audio/audiostream.h"
+
+#include "common/config-manager.h"
+#include "common/util.h"
+
+namespace Audio {
+
+/**
+ * The decoded samples of a cached sound. They are shared between the cache
+ * and all streams playing the sound, which may live in different threads,
+ * hence the locked reference counting.
+ */
+class PCMCacheBuffer {
+public:
+	PCMCacheBuffer(int16 *samples, uint32 numSamples, int rate, bool stereo)
+		: _samples(samples), _numSamples(numSamples), _rate(rate), _stereo(stereo), _refCount(1) {}
+
+	void incRef() {
+		Common::StackLock lock(_mutex);
+		_refCount++;
+	}
+
+	void decRef() {
+		bool last;
+		{
+			Common::StackLock lock(_mutex);
+			last = (--_refCount == 0);
+		}
+		if (last)
+			delete this;
+	}
+
+	uint32 getSize() const { return _numSamples * sizeof(int16); }
+
+	int16 *const _samples;
+	const uint32 _numSamples;
+	const int _rate;
+	const bool _stereo;
+
+private:
+	~PCMCacheBuffer() {
+		free(_samples);
+	}
+
+	Common::Mutex _mutex;
+	int _refCount;
+};
+
+/**
+ * A stream playing a cached sound directly from the shared buffer.
+ */
+class PCMCacheStream : public SeekableAudioStream {
+public:
+	PCMCacheStream(PCMCacheBuffer *buffer) : _buffer(buffer), _pos(0) {
+		_buffer->incRef();
+	}
+
+	~PCMCacheStream() {
+		_buffer->decRef();
+	}
+
+	int readBuffer(int16 *buffer, const int numSamples) {
+		const int len = MIN<int>(numSamples, _buffer->_numSamples - _pos);
+		memcpy(buffer, _buffer->_samples + _pos, len * sizeof(int16));
+		_pos += len;
+		return len;
+	}
+
+	bool isStereo() const { return _buffer->_stereo; }
+	int getRate() const { return _buffer->_rate; }
+	bool endOfData() const { return _pos >= _buffer->_numSamples; }
+
+	bool seek(const Timestamp &where) {
+		const uint32 pos = convertTimeToStreamPos(where, getRate(), isStereo()).totalNumberOfFrames();
+		_pos = MIN(pos, _buffer->_numSamples);
+		return pos <= _buffer->_numSamples;
+	}
+
+	Timestamp getLength() const {
+		return Timestamp(0, _buffer->_numSamples / (isStereo() ? 2 : 1), getRate());
+	}
+
+private:
+	PCMCacheBuffer *_buffer;
+	uint32 _pos;
+};
+
+PCMCache::PCMCache()
+	: _size(0), _maxSize(MAX(ConfMan.getInt("sfx_cache_size"), 0) * 1024),
+	  _maxLength(MAX(ConfMan.getInt("sfx_cache_max_length"), 0)) {
+}
+
+PCMCache::PCMCache(uint32 maxSize, uint32 maxLength)
+	: _size(0), _maxSize(maxSize), _maxLength(maxLength) {
+}
+
+PCMCache::~PCMCache() {
+	clear();
+}
+
+Common::String PCMCache::makeKey(const Common::String &filename, uint32 offset) {
+	return Common::String::format("%s:%u", filename.c_str(), offset);
+}
+
+SeekableAudioStream *PCMCache::find(const Common::String &filename, uint32 offset) {
+	Common::StackLock lock(_mutex);
+
+	EntryMap::iterator it = _index.find(makeKey(filename, offset));
+	if (it == _index.end())
+		return 0;
+
+	// Mark the sound as the most recently used
+	const Entry entry = *it->_value;
+	_entries.erase(it->_value);
+	_entries.push_front(entry);
+	it->_value = _entries.begin();
+
+	return new PCMCacheStream(entry.buffer);
+}
+
+RewindableAudioStream *PCMCache::add(const Common::String &filename, uint32 offset, RewindableAudioStream *stream,
+                                     DisposeAfterUse::Flag disposeAfterUse) {
+	if (!stream || _maxSize == 0)
+		return stream;
+
+	// Do not bother decoding sounds which are known to be too long
+	const SeekableAudioStream *seekable = dynamic_cast<const SeekableAudioStream *>(stream);
+	if (seekable && (uint32)seekable->getLength().msecs() > _maxLength)
+		return stream;
+
+	const int rate = stream->getRate();
+	const bool stereo = stream->isStereo();
+	const uint channels = stereo ? 2 : 1;
+
+	const uint64 maxFrames = MIN<uint64>((uint64)_maxLength * rate / 1000, _maxSize / (channels * sizeof(int16)));
+	const uint32 maxSamples = (uint32)maxFrames * channels;
+	// Try to decode one more frame than allowed, to notice longer sounds
+	const uint32 capacity = maxSamples + channels;
+
+	int16 *samples = (int16 *)malloc(capacity * sizeof(int16));
+	if (!samples) {
+		warning("PCMCache::add: Cannot allocate memory for %s", filename.c_str());
+		return stream;
+	}
+
+	uint32 numSamples = 0;
+	while (numSamples < capacity && !stream->endOfData()) {
+		const int len = stream->readBuffer(samples + numSamples, capacity - numSamples);
+		if (len <= 0)
+			break;
+		numSamples += len;
+	}
+
+	if (numSamples == 0 || numSamples > maxSamples) {
+		free(samples);
+		stream->rewind();
+		return stream;
+	}
+
+	if (numSamples < capacity) {
+		int16 *shrunk = (int16 *)realloc(samples, numSamples * sizeof(int16));
+		if (shrunk)
+			samples = shrunk;
+	}
+
+	if (disposeAfterUse == DisposeAfterUse::YES)
+		delete stream;
+
+	PCMCacheBuffer *buffer = new PCMCacheBuffer(samples, numSamples, rate, stereo);
+	const Common::String key = makeKey(filename, offset);
+
+	Common::StackLock lock(_mutex);
+
+	// Another caller may have added the same sound in the meantime
+	EntryMap::iterator it = _index.find(key);
+	if (it != _index.end())
+		remove(it);
+
+	makeRoom(buffer->getSize());
+
+	Entry entry;
+	entry.key = key;
+	entry.buffer = buffer;
+	_entries.push_front(entry);
+	_index[key] = _entries.begin();
+	_size += buffer->getSize();
+
+	return new PCMCacheStream(buffer);
+}
+
+void PCMCache::clear() {
+	Common::StackLock lock(_mutex);
+
+	for (EntryList::iterator it = _entries.begin(); it != _entries.end(); ++it)
+		it->buffer->decRef();
+
+	_entries.clear();
+	_index.clear();
+	_size = 0;
+}
+
+void PCMCache::makeRoom(uint32 size) {
+	while (!_entries.empty() && _size + size > _maxSize)
+		remove(_index.find(_entries.back().key));
+}
+
+void PCMCache::remove(EntryMap::iterator it) {
+	PCMCacheBuffer *buffer = it->_value->buffer;
+
+	_size -= buffer->getSize();
+	_entries.erase(it->_value);
+	_index.erase(it);
+
+	buffer->decRef();
+}
+
+} // End of namespace Audio
+
+namespace Common {
+DECLARE_SINGLETON(Audio::PCMCache);
+}
@@ -0,0 +1,155 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef AUDIO_PCMCACHE_H
+#define AUDIO_PCMCACHE_H
+
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/list.h"
+#include "common/mutex.h"
+#include "common/singleton.h"
+#include "common/str.h"
+#include "common/types.h"
+
+namespace Audio {
+
+/**
+ * @defgroup audio_pcmcache Decoded sound cache
+ * @ingroup audio
+ *
+ * @brief Cache for fully decoded short sounds.
+ * @{
+ */
+
+class PCMCacheBuffer;
+class RewindableAudioStream;
+class SeekableAudioStream;
+
+/**
+ * A size-bounded cache of fully decoded sounds.
+ *
+ * Engines which play the same short compressed sound effects over and over
+ * again can store the decoded samples here the first time a sound is
+ * played, and afterwards play it without decoding it again. Sounds are
+ * identified by the file they come from and their offset in that file.
+ *
+ * The streams handed out by the cache all play from the same decoded
+ * buffer, which stays alive until the last of them is deleted, even if the
+ * sound is evicted from the cache in the meantime. When the cache is full,
+ * the least recently used sounds are evicted first.
+ *
+ * Typical usage:
+ * @code
+ * Audio::SeekableAudioStream *stream = PCMCacheMan.find(filename, offset);
+ * if (!stream)
+ *     stream = PCMCacheMan.add(filename, offset, Audio::makeVorbisStream(...));
+ * @endcode
+ *
+ * The global instance is reset whenever an engine exits.
+ */
+class PCMCache : public Common::Singleton<PCMCache> {
+public:
+	/**
+	 * Create a cache using the "sfx_cache_size" (in KB) and
+	 * "sfx_cache_max_length" (in milliseconds) settings.
+	 */
+	PCMCache();
+
+	/**
+	 * @param maxSize    Maximum size in bytes of all cached sounds together.
+	 *                   0 disables the cache.
+	 * @param maxLength  Maximum length in milliseconds of a sound to be cached.
+	 */
+	PCMCache(uint32 maxSize, uint32 maxLength);
+	~PCMCache();
+
+	/**
+	 * Look up a sound in the cache.
+	 *
+	 * @return A new stream playing the decoded sound, or 0 if the sound is
+	 *         not cached.
+	 */
+	SeekableAudioStream *find(const Common::String &filename, uint32 offset);
+
+	/**
+	 * Decode a sound completely and add it to the cache.
+	 *
+	 * If the sound is too long to be cached, or the cache is disabled, the
+	 * stream is rewound and returned as is, regardless of disposeAfterUse.
+	 * Seekable streams which report a length above the limit are returned
+	 * without decoding anything. Otherwise the stream is deleted if
+	 * disposeAfterUse is set, and a stream playing the decoded samples is
+	 * returned instead.
+	 *
+	 * @param filename         File the sound is read from.
+	 * @param offset           Offset of the sound in that file.
+	 * @param stream           Stream decoding the sound.
+	 * @param disposeAfterUse  Whether to delete the stream once it has been decoded.
+	 */
+	RewindableAudioStream *add(const Common::String &filename, uint32 offset, RewindableAudioStream *stream,
+	                           DisposeAfterUse::Flag disposeAfterUse = DisposeAfterUse::YES);
+
+	/**
+	 * Remove all sounds from the cache.
+	 */
+	void clear();
+
+	/** Return the size in bytes of all cached sounds together. */
+	uint32 getSize() const { return _size; }
+
+	/** Return the number of cached sounds. */
+	uint getCount() const { return _index.size(); }
+
+private:
+	struct Entry {
+		Common::String key;
+		PCMCacheBuffer *buffer;
+	};
+
+	typedef Common::List<Entry> EntryList;
+	typedef Common::HashMap<Common::String, EntryList::iterator> EntryMap;
+
+	static Common::String makeKey(const Common::String &filename, uint32 offset);
+
+	/** Evict the least recently used sounds until 'size' more bytes fit. */
+	void makeRoom(uint32 size);
+	void remove(EntryMap::iterator it);
+
+	Common::Mutex _mutex;
+
+	/** All cached sounds, the most recently used first. */
+	EntryList _entries;
+	EntryMap _index;
+
+	uint32 _size;
+	const uint32 _maxSize;
+	const uint32 _maxLength;
+};
+
+/** @} */
+} // End of namespace Audio
+
+/** Shortcut for accessing the decoded sound cache. */
+#define PCMCacheMan Audio::PCMCache::instance()
+
+#endif
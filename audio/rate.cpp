@@ -31,10 +31,29 @@
 #include "audio/audiostream.h"
 #include "audio/rate.h"
 #include "audio/mixer.h"
+#include "common/array.h"
 #include "common/frac.h"
+#include "common/math.h"
+#include "common/mutex.h"
+#include "common/singleton.h"
 #include "common/textconsole.h"
 #include "common/util.h"
 
+#if !defined(OUTPUT_UNSIGNED_AUDIO) && defined(SCUMM_LITTLE_ENDIAN)
+#if defined(__SSE2__)
+#define USE_RATE_SSE2
+#include <emmintrin.h>
+#if (defined(__GNUC__) && __GNUC__ >= 5) || defined(__clang__)
+#define USE_RATE_AVX2
+#include <immintrin.h>
+#endif
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define USE_RATE_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
 namespace Audio {
 
 
@@ -57,6 +76,385 @@ enum {
 	FRAC_HALF_LOW = (1L << (FRAC_BITS_LOW-1))
 };
 
+#pragma mark -
+#pragma mark --- Mixing kernels ---
+#pragma mark -
+
+/**
+ * Scale a block of samples by the channel volume and add it, clamped, to
+ * the interleaved stereo output buffer. For stereo input, vol0 is applied
+ * to the even and vol1 to the odd output samples; mono input is duplicated
+ * to both sides.
+ *
+ * The SIMD kernels produce exactly the same results as the scalar ones.
+ */
+typedef void (*MixProc)(st_sample_t *obuf, const st_sample_t *src, st_size_t frames, st_volume_t vol0, st_volume_t vol1);
+
+/**
+ * Like MixProc, but accumulates into the 32-bit mix bus without clamping.
+ */
+typedef void (*MixBusProc)(int32 *obuf, const st_sample_t *src, st_size_t frames, st_volume_t vol0, st_volume_t vol1);
+
+static inline int scaleSample(int sample, st_volume_t vol) {
+	return (sample * (int)vol) / Audio::Mixer::kMaxMixerVolume;
+}
+
+static void mixStereoScalar(st_sample_t *obuf, const st_sample_t *src, st_size_t frames, st_volume_t vol0, st_volume_t vol1) {
+	for (; frames > 0; --frames) {
+		clampedAdd(obuf[0], scaleSample(src[0], vol0));
+		clampedAdd(obuf[1], scaleSample(src[1], vol1));
+		src += 2;
+		obuf += 2;
+	}
+}
+
+static void mixMonoScalar(st_sample_t *obuf, const st_sample_t *src, st_size_t frames, st_volume_t vol0, st_volume_t vol1) {
+	for (; frames > 0; --frames) {
+		clampedAdd(obuf[0], scaleSample(*src, vol0));
+		clampedAdd(obuf[1], scaleSample(*src, vol1));
+		src++;
+		obuf += 2;
+	}
+}
+
+static void mixBusStereoScalar(int32 *obuf, const st_sample_t *src, st_size_t frames, st_volume_t vol0, st_volume_t vol1) {
+	for (; frames > 0; --frames) {
+		obuf[0] += scaleSample(src[0], vol0);
+		obuf[1] += scaleSample(src[1], vol1);
+		src += 2;
+		obuf += 2;
+	}
+}
+
+static void mixBusMonoScalar(int32 *obuf, const st_sample_t *src, st_size_t frames, st_volume_t vol0, st_volume_t vol1) {
+	for (; frames > 0; --frames) {
+		obuf[0] += scaleSample(*src, vol0);
+		obuf[1] += scaleSample(*src, vol1);
+		src++;
+		obuf += 2;
+	}
+}
+
+static void clampSamplesScalar(st_sample_t *obuf, const int32 *src, st_size_t samples) {
+	for (; samples > 0; --samples)
+		*obuf++ = (int16)CLIP<int32>(*src++, ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+}
+
+// The vector kernels replace the division by kMaxMixerVolume (256) with a
+// shift, rounding towards zero like the division does.
+#define RATE_VOLUME_SHIFT 8
+
+#ifdef USE_RATE_SSE2
+
+static inline void scaleSSE2(__m128i in, __m128i vol, __m128i &p0, __m128i &p1) {
+	const __m128i lo = _mm_mullo_epi16(in, vol);
+	const __m128i hi = _mm_mulhi_epi16(in, vol);
+	p0 = _mm_unpacklo_epi16(lo, hi);
+	p1 = _mm_unpackhi_epi16(lo, hi);
+	p0 = _mm_add_epi32(p0, _mm_srli_epi32(_mm_srai_epi32(p0, 31), 32 - RATE_VOLUME_SHIFT));
+	p1 = _mm_add_epi32(p1, _mm_srli_epi32(_mm_srai_epi32(p1, 31), 32 - RATE_VOLUME_SHIFT));
+	p0 = _mm_srai_epi32(p0, RATE_VOLUME_SHIFT);
+	p1 = _mm_srai_epi32(p1, RATE_VOLUME_SHIFT);
+}
+
+static inline __m128i scaleAddSSE2(__m128i out, __m128i in, __m128i vol) {
+	__m128i p0, p1;
+	scaleSSE2(in, vol, p0, p1);
+	return _mm_adds_epi16(out, _mm_packs_epi32(p0, p1));
+}
+
+static inline void scaleAccumulateSSE2(int32 *obuf, __m128i in, __m128i vol) {
+	__m128i p0, p1;
+	scaleSSE2(in, vol, p0, p1);
+	_mm_storeu_si128((__m128i *)obuf, _mm_add_epi32(_mm_loadu_si128((const __m128i *)obuf), p0));
+	_mm_storeu_si128((__m128i *)(obuf + 4), _mm_add_epi32(_mm_loadu_si128((const __m128i *)(obuf + 4)), p1));
+}
+
+static void mixStereoSSE2(st_sample_t *obuf, const st_sample_t *src, st_size_t frames, st_volume_t vol0, st_volume_t vol1) {
+	const __m128i vol = _mm_set1_epi32((int)(((uint32)vol1 << 16) | vol0));
+	for (; frames >= 4; frames -= 4) {
+		const __m128i in = _mm_loadu_si128((const __m128i *)src);
+		const __m128i out = _mm_loadu_si128((const __m128i *)obuf);
+		_mm_storeu_si128((__m128i *)obuf, scaleAddSSE2(out, in, vol));
+		src += 8;
+		obuf += 8;
+	}
+	mixStereoScalar(obuf, src, frames, vol0, vol1);
+}
+
+static void mixMonoSSE2(st_sample_t *obuf, const st_sample_t *src, st_size_t frames, st_volume_t vol0, st_volume_t vol1) {
+	const __m128i vol = _mm_set1_epi32((int)(((uint32)vol1 << 16) | vol0));
+	for (; frames >= 8; frames -= 8) {
+		const __m128i in = _mm_loadu_si128((const __m128i *)src);
+		const __m128i out0 = _mm_loadu_si128((const __m128i *)obuf);
+		const __m128i out1 = _mm_loadu_si128((const __m128i *)(obuf + 8));
+		_mm_storeu_si128((__m128i *)obuf, scaleAddSSE2(out0, _mm_unpacklo_epi16(in, in), vol));
+		_mm_storeu_si128((__m128i *)(obuf + 8), scaleAddSSE2(out1, _mm_unpackhi_epi16(in, in), vol));
+		src += 8;
+		obuf += 16;
+	}
+	mixMonoScalar(obuf, src, frames, vol0, vol1);
+}
+
+static void mixBusStereoSSE2(int32 *obuf, const st_sample_t *src, st_size_t frames, st_volume_t vol0, st_volume_t vol1) {
+	const __m128i vol = _mm_set1_epi32((int)(((uint32)vol1 << 16) | vol0));
+	for (; frames >= 4; frames -= 4) {
+		scaleAccumulateSSE2(obuf, _mm_loadu_si128((const __m128i *)src), vol);
+		src += 8;
+		obuf += 8;
+	}
+	mixBusStereoScalar(obuf, src, frames, vol0, vol1);
+}
+
+static void mixBusMonoSSE2(int32 *obuf, const st_sample_t *src, st_size_t frames, st_volume_t vol0, st_volume_t vol1) {
+	const __m128i vol = _mm_set1_epi32((int)(((uint32)vol1 << 16) | vol0));
+	for (; frames >= 8; frames -= 8) {
+		const __m128i in = _mm_loadu_si128((const __m128i *)src);
+		scaleAccumulateSSE2(obuf, _mm_unpacklo_epi16(in, in), vol);
+		scaleAccumulateSSE2(obuf + 8, _mm_unpackhi_epi16(in, in), vol);
+		src += 8;
+		obuf += 16;
+	}
+	mixBusMonoScalar(obuf, src, frames, vol0, vol1);
+}
+
+static void clampSamplesSSE2(st_sample_t *obuf, const int32 *src, st_size_t samples) {
+	for (; samples >= 8; samples -= 8) {
+		const __m128i in0 = _mm_loadu_si128((const __m128i *)src);
+		const __m128i in1 = _mm_loadu_si128((const __m128i *)(src + 4));
+		_mm_storeu_si128((__m128i *)obuf, _mm_packs_epi32(in0, in1));
+		src += 8;
+		obuf += 8;
+	}
+	clampSamplesScalar(obuf, src, samples);
+}
+
+#endif // USE_RATE_SSE2
+
+#ifdef USE_RATE_AVX2
+
+#define RATE_AVX2_TARGET __attribute__((target("avx2")))
+
+RATE_AVX2_TARGET
+static inline void scaleAVX2(__m256i in, __m256i vol, __m256i &p0, __m256i &p1) {
+	const __m256i lo = _mm256_mullo_epi16(in, vol);
+	const __m256i hi = _mm256_mulhi_epi16(in, vol);
+	p0 = _mm256_unpacklo_epi16(lo, hi);
+	p1 = _mm256_unpackhi_epi16(lo, hi);
+	p0 = _mm256_add_epi32(p0, _mm256_srli_epi32(_mm256_srai_epi32(p0, 31), 32 - RATE_VOLUME_SHIFT));
+	p1 = _mm256_add_epi32(p1, _mm256_srli_epi32(_mm256_srai_epi32(p1, 31), 32 - RATE_VOLUME_SHIFT));
+	p0 = _mm256_srai_epi32(p0, RATE_VOLUME_SHIFT);
+	p1 = _mm256_srai_epi32(p1, RATE_VOLUME_SHIFT);
+}
+
+RATE_AVX2_TARGET
+static inline __m256i scaleAddAVX2(__m256i out, __m256i in, __m256i vol) {
+	__m256i p0, p1;
+	scaleAVX2(in, vol, p0, p1);
+	// The unpack and pack operations both work per 128-bit lane, so the
+	// sample order is preserved.
+	return _mm256_adds_epi16(out, _mm256_packs_epi32(p0, p1));
+}
+
+RATE_AVX2_TARGET
+static inline void scaleAccumulateAVX2(int32 *obuf, __m256i in, __m256i vol) {
+	__m256i p0, p1;
+	scaleAVX2(in, vol, p0, p1);
+	// p0 holds samples 0-3 and 8-11, p1 holds samples 4-7 and 12-15
+	const __m256i q0 = _mm256_permute2x128_si256(p0, p1, 0x20);
+	const __m256i q1 = _mm256_permute2x128_si256(p0, p1, 0x31);
+	_mm256_storeu_si256((__m256i *)obuf, _mm256_add_epi32(_mm256_loadu_si256((const __m256i *)obuf), q0));
+	_mm256_storeu_si256((__m256i *)(obuf + 8), _mm256_add_epi32(_mm256_loadu_si256((const __m256i *)(obuf + 8)), q1));
+}
+
+RATE_AVX2_TARGET
+static void mixStereoAVX2(st_sample_t *obuf, const st_sample_t *src, st_size_t frames, st_volume_t vol0, st_volume_t vol1) {
+	const __m256i vol = _mm256_set1_epi32((int)(((uint32)vol1 << 16) | vol0));
+	for (; frames >= 8; frames -= 8) {
+		const __m256i in = _mm256_loadu_si256((const __m256i *)src);
+		const __m256i out = _mm256_loadu_si256((const __m256i *)obuf);
+		_mm256_storeu_si256((__m256i *)obuf, scaleAddAVX2(out, in, vol));
+		src += 16;
+		obuf += 16;
+	}
+	mixStereoSSE2(obuf, src, frames, vol0, vol1);
+}
+
+RATE_AVX2_TARGET
+static void mixMonoAVX2(st_sample_t *obuf, const st_sample_t *src, st_size_t frames, st_volume_t vol0, st_volume_t vol1) {
+	const __m256i vol = _mm256_set1_epi32((int)(((uint32)vol1 << 16) | vol0));
+	for (; frames >= 16; frames -= 16) {
+		// Reorder the 64-bit quarters so the per-lane unpacks below yield
+		// frames 0-7 and 8-15 respectively.
+		const __m256i in = _mm256_permute4x64_epi64(_mm256_loadu_si256((const __m256i *)src), 0xD8);
+		const __m256i out0 = _mm256_loadu_si256((const __m256i *)obuf);
+		const __m256i out1 = _mm256_loadu_si256((const __m256i *)(obuf + 16));
+		_mm256_storeu_si256((__m256i *)obuf, scaleAddAVX2(out0, _mm256_unpacklo_epi16(in, in), vol));
+		_mm256_storeu_si256((__m256i *)(obuf + 16), scaleAddAVX2(out1, _mm256_unpackhi_epi16(in, in), vol));
+		src += 16;
+		obuf += 32;
+	}
+	mixMonoSSE2(obuf, src, frames, vol0, vol1);
+}
+
+RATE_AVX2_TARGET
+static void mixBusStereoAVX2(int32 *obuf, const st_sample_t *src, st_size_t frames, st_volume_t vol0, st_volume_t vol1) {
+	const __m256i vol = _mm256_set1_epi32((int)(((uint32)vol1 << 16) | vol0));
+	for (; frames >= 8; frames -= 8) {
+		scaleAccumulateAVX2(obuf, _mm256_loadu_si256((const __m256i *)src), vol);
+		src += 16;
+		obuf += 16;
+	}
+	mixBusStereoSSE2(obuf, src, frames, vol0, vol1);
+}
+
+RATE_AVX2_TARGET
+static void mixBusMonoAVX2(int32 *obuf, const st_sample_t *src, st_size_t frames, st_volume_t vol0, st_volume_t vol1) {
+	const __m256i vol = _mm256_set1_epi32((int)(((uint32)vol1 << 16) | vol0));
+	for (; frames >= 16; frames -= 16) {
+		const __m256i in = _mm256_permute4x64_epi64(_mm256_loadu_si256((const __m256i *)src), 0xD8);
+		scaleAccumulateAVX2(obuf, _mm256_unpacklo_epi16(in, in), vol);
+		scaleAccumulateAVX2(obuf + 16, _mm256_unpackhi_epi16(in, in), vol);
+		src += 16;
+		obuf += 32;
+	}
+	mixBusMonoSSE2(obuf, src, frames, vol0, vol1);
+}
+
+#endif // USE_RATE_AVX2
+
+#ifdef USE_RATE_NEON
+
+static inline int32x4_t scaleNEON(int32x4_t p) {
+	const uint32x4_t bias = vshrq_n_u32(vreinterpretq_u32_s32(vshrq_n_s32(p, 31)), 32 - RATE_VOLUME_SHIFT);
+	return vshrq_n_s32(vaddq_s32(p, vreinterpretq_s32_u32(bias)), RATE_VOLUME_SHIFT);
+}
+
+static inline int16x8_t scaleAddNEON(int16x8_t out, int16x8_t in, int16x8_t vol) {
+	const int32x4_t p0 = scaleNEON(vmull_s16(vget_low_s16(in), vget_low_s16(vol)));
+	const int32x4_t p1 = scaleNEON(vmull_s16(vget_high_s16(in), vget_high_s16(vol)));
+	return vqaddq_s16(out, vcombine_s16(vqmovn_s32(p0), vqmovn_s32(p1)));
+}
+
+static inline void scaleAccumulateNEON(int32 *obuf, int16x8_t in, int16x8_t vol) {
+	const int32x4_t p0 = scaleNEON(vmull_s16(vget_low_s16(in), vget_low_s16(vol)));
+	const int32x4_t p1 = scaleNEON(vmull_s16(vget_high_s16(in), vget_high_s16(vol)));
+	vst1q_s32(obuf, vaddq_s32(vld1q_s32(obuf), p0));
+	vst1q_s32(obuf + 4, vaddq_s32(vld1q_s32(obuf + 4), p1));
+}
+
+static void mixStereoNEON(st_sample_t *obuf, const st_sample_t *src, st_size_t frames, st_volume_t vol0, st_volume_t vol1) {
+	const int16x8_t vol = vreinterpretq_s16_u32(vdupq_n_u32(((uint32)vol1 << 16) | vol0));
+	for (; frames >= 4; frames -= 4) {
+		vst1q_s16(obuf, scaleAddNEON(vld1q_s16(obuf), vld1q_s16(src), vol));
+		src += 8;
+		obuf += 8;
+	}
+	mixStereoScalar(obuf, src, frames, vol0, vol1);
+}
+
+static void mixMonoNEON(st_sample_t *obuf, const st_sample_t *src, st_size_t frames, st_volume_t vol0, st_volume_t vol1) {
+	const int16x8_t vol = vreinterpretq_s16_u32(vdupq_n_u32(((uint32)vol1 << 16) | vol0));
+	for (; frames >= 8; frames -= 8) {
+		const int16x8_t in = vld1q_s16(src);
+		const int16x8x2_t dup = vzipq_s16(in, in);
+		vst1q_s16(obuf, scaleAddNEON(vld1q_s16(obuf), dup.val[0], vol));
+		vst1q_s16(obuf + 8, scaleAddNEON(vld1q_s16(obuf + 8), dup.val[1], vol));
+		src += 8;
+		obuf += 16;
+	}
+	mixMonoScalar(obuf, src, frames, vol0, vol1);
+}
+
+static void mixBusStereoNEON(int32 *obuf, const st_sample_t *src, st_size_t frames, st_volume_t vol0, st_volume_t vol1) {
+	const int16x8_t vol = vreinterpretq_s16_u32(vdupq_n_u32(((uint32)vol1 << 16) | vol0));
+	for (; frames >= 4; frames -= 4) {
+		scaleAccumulateNEON(obuf, vld1q_s16(src), vol);
+		src += 8;
+		obuf += 8;
+	}
+	mixBusStereoScalar(obuf, src, frames, vol0, vol1);
+}
+
+static void mixBusMonoNEON(int32 *obuf, const st_sample_t *src, st_size_t frames, st_volume_t vol0, st_volume_t vol1) {
+	const int16x8_t vol = vreinterpretq_s16_u32(vdupq_n_u32(((uint32)vol1 << 16) | vol0));
+	for (; frames >= 8; frames -= 8) {
+		const int16x8_t in = vld1q_s16(src);
+		const int16x8x2_t dup = vzipq_s16(in, in);
+		scaleAccumulateNEON(obuf, dup.val[0], vol);
+		scaleAccumulateNEON(obuf + 8, dup.val[1], vol);
+		src += 8;
+		obuf += 16;
+	}
+	mixBusMonoScalar(obuf, src, frames, vol0, vol1);
+}
+
+static void clampSamplesNEON(st_sample_t *obuf, const int32 *src, st_size_t samples) {
+	for (; samples >= 8; samples -= 8) {
+		vst1q_s16(obuf, vcombine_s16(vqmovn_s32(vld1q_s32(src)), vqmovn_s32(vld1q_s32(src + 4))));
+		src += 8;
+		obuf += 8;
+	}
+	clampSamplesScalar(obuf, src, samples);
+}
+
+#endif // USE_RATE_NEON
+
+/**
+ * Pick the fastest mixing kernel supported by the CPU we are running on.
+ */
+static MixProc getMixProc(bool stereo) {
+#ifdef USE_RATE_AVX2
+	if (__builtin_cpu_supports("avx2"))
+		return stereo ? mixStereoAVX2 : mixMonoAVX2;
+#endif
+#if defined(USE_RATE_SSE2)
+	return stereo ? mixStereoSSE2 : mixMonoSSE2;
+#elif defined(USE_RATE_NEON)
+	return stereo ? mixStereoNEON : mixMonoNEON;
+#else
+	return stereo ? mixStereoScalar : mixMonoScalar;
+#endif
+}
+
+static MixBusProc getMixBusProc(bool stereo) {
+#ifdef USE_RATE_AVX2
+	if (__builtin_cpu_supports("avx2"))
+		return stereo ? mixBusStereoAVX2 : mixBusMonoAVX2;
+#endif
+#if defined(USE_RATE_SSE2)
+	return stereo ? mixBusStereoSSE2 : mixBusMonoSSE2;
+#elif defined(USE_RATE_NEON)
+	return stereo ? mixBusStereoNEON : mixBusMonoNEON;
+#else
+	return stereo ? mixBusStereoScalar : mixBusMonoScalar;
+#endif
+}
+
+void clampSamples(st_sample_t *obuf, const int32 *src, st_size_t samples) {
+#if defined(USE_RATE_SSE2)
+	clampSamplesSSE2(obuf, src, samples);
+#elif defined(USE_RATE_NEON)
+	clampSamplesNEON(obuf, src, samples);
+#else
+	clampSamplesScalar(obuf, src, samples);
+#endif
+}
+
+void clampMixBus(st_sample_t *obuf, const int32 *bus, st_size_t samples) {
+#ifdef OUTPUT_UNSIGNED_AUDIO
+	for (; samples > 0; --samples)
+		*obuf++ = ((int16)CLIP<int32>(*bus++, ST_SAMPLE_MIN, ST_SAMPLE_MAX)) ^ 0x8000;
+#else
+	clampSamples(obuf, bus, samples);
+#endif
+}
+
+
+#pragma mark -
+#pragma mark --- Rate converters ---
+#pragma mark -
+
 /**
  * Audio rate converter based on simple resampling. Used when no
  * interpolation is required.
@@ -70,6 +468,9 @@ protected:
 	const st_sample_t *inPtr;
 	int inLen;
 
+	/** resampled output, in output channel order, waiting to be mixed */
+	st_sample_t outBuf[INTERMEDIATE_BUFFER_SIZE];
+
 	/** position of how far output is ahead of input */
 	/** Holds what would have been opos-ipos */
 	long opos;
@@ -77,12 +478,27 @@ protected:
 	/** fractional position increment in the output stream */
 	long opos_inc;
 
+	MixProc _mixProc;
+	MixBusProc _mixBusProc;
+
+	template<typename T, typename Proc>
+	int convert(AudioStream &input, T *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r, Proc mixProc);
+
 public:
 	SimpleRateConverter(st_rate_t inrate, st_rate_t outrate);
-	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r);
+	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+		return convert(input, obuf, osamp, vol_l, vol_r, _mixProc);
+	}
+	int flowMix(AudioStream &input, int32 *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+		return convert(input, obuf, osamp, vol_l, vol_r, _mixBusProc);
+	}
 	int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) {
 		return ST_SUCCESS;
 	}
+
+	const char *getName() const {
+		return "simple";
+	}
 };
 
 
@@ -105,6 +521,9 @@ SimpleRateConverter<stereo, reverseStereo>::SimpleRateConverter(st_rate_t inrate
 	opos_inc = inrate / outrate;
 
 	inLen = 0;
+
+	_mixProc = getMixProc(stereo);
+	_mixBusProc = getMixBusProc(stereo);
 }
 
 /*
@@ -112,44 +531,59 @@ SimpleRateConverter<stereo, reverseStereo>::SimpleRateConverter(st_rate_t inrate
  * Return number of sample pairs processed.
  */
 template<bool stereo, bool reverseStereo>
-int SimpleRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
-	st_sample_t *ostart, *oend;
+template<typename T, typename Proc>
+int SimpleRateConverter<stereo, reverseStereo>::convert(AudioStream &input, T *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r, Proc mixProc) {
+	T *ostart, *oend;
 
 	ostart = obuf;
 	oend = obuf + osamp * 2;
 
-	while (obuf < oend) {
+	bool eos = false;
+	while (obuf < oend && !eos) {
+		// Resample as much as fits into the intermediate output buffer...
+		const st_size_t frames = MIN<st_size_t>((oend - obuf) / 2, INTERMEDIATE_BUFFER_SIZE / 2);
+		st_sample_t *outPtr = outBuf;
+		st_sample_t *const outEnd = outBuf + frames * (stereo ? 2 : 1);
+
+		while (outPtr < outEnd) {
+
+			// read enough input samples so that opos >= 0
+			do {
+				// Check if we have to refill the buffer
+				if (inLen == 0) {
+					inPtr = inBuf;
+					inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
+					if (inLen <= 0) {
+						eos = true;
+						break;
+					}
+				}
+				inLen -= (stereo ? 2 : 1);
+				opos--;
+				if (opos >= 0) {
+					inPtr += (stereo ? 2 : 1);
+				}
+			} while (opos >= 0);
+
+			if (eos)
+				break;
 
-		// read enough input samples so that opos >= 0
-		do {
-			// Check if we have to refill the buffer
-			if (inLen == 0) {
-				inPtr = inBuf;
-				inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
-				if (inLen <= 0)
-					return (obuf - ostart) / 2;
-			}
-			inLen -= (stereo ? 2 : 1);
-			opos--;
-			if (opos >= 0) {
-				inPtr += (stereo ? 2 : 1);
+			if (stereo) {
+				outPtr[reverseStereo    ] = *inPtr++;
+				outPtr[reverseStereo ^ 1] = *inPtr++;
+				outPtr += 2;
+			} else {
+				*outPtr++ = *inPtr++;
 			}
-		} while (opos >= 0);
-
-		st_sample_t out0, out1;
-		out0 = *inPtr++;
-		out1 = (stereo ? *inPtr++ : out0);
 
-		// Increment output position
-		opos += opos_inc;
-
-		// output left channel
-		clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
-
-		// output right channel
-		clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+			// Increment output position
+			opos += opos_inc;
+		}
 
-		obuf += 2;
+		// ...and mix it into the output buffer in one go
+		const st_size_t produced = (outPtr - outBuf) / (stereo ? 2 : 1);
+		mixProc(obuf, outBuf, produced, reverseStereo ? vol_r : vol_l, reverseStereo ? vol_l : vol_r);
+		obuf += produced * 2;
 	}
 	return (obuf - ostart) / 2;
 }
@@ -172,6 +606,9 @@ protected:
 	const st_sample_t *inPtr;
 	int inLen;
 
+	/** interpolated output, in output channel order, waiting to be mixed */
+	st_sample_t outBuf[INTERMEDIATE_BUFFER_SIZE];
+
 	/** fractional position of the output stream in input stream unit */
 	frac_t opos;
 
@@ -183,12 +620,27 @@ protected:
 	/** current sample(s) in the input stream (left/right channel) */
 	st_sample_t icur0, icur1;
 
+	MixProc _mixProc;
+	MixBusProc _mixBusProc;
+
+	template<typename T, typename Proc>
+	int convert(AudioStream &input, T *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r, Proc mixProc);
+
 public:
 	LinearRateConverter(st_rate_t inrate, st_rate_t outrate);
-	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r);
+	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+		return convert(input, obuf, osamp, vol_l, vol_r, _mixProc);
+	}
+	int flowMix(AudioStream &input, int32 *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+		return convert(input, obuf, osamp, vol_l, vol_r, _mixBusProc);
+	}
 	int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) {
 		return ST_SUCCESS;
 	}
+
+	const char *getName() const {
+		return "linear";
+	}
 };
 
 
@@ -214,6 +666,9 @@ LinearRateConverter<stereo, reverseStereo>::LinearRateConverter(st_rate_t inrate
 	icur0 = icur1 = 0;
 
 	inLen = 0;
+
+	_mixProc = getMixProc(stereo);
+	_mixBusProc = getMixBusProc(stereo);
 }
 
 /*
@@ -221,54 +676,68 @@ LinearRateConverter<stereo, reverseStereo>::LinearRateConverter(st_rate_t inrate
  * Return number of sample pairs processed.
  */
 template<bool stereo, bool reverseStereo>
-int LinearRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
-	st_sample_t *ostart, *oend;
+template<typename T, typename Proc>
+int LinearRateConverter<stereo, reverseStereo>::convert(AudioStream &input, T *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r, Proc mixProc) {
+	T *ostart, *oend;
 
 	ostart = obuf;
 	oend = obuf + osamp * 2;
 
-	while (obuf < oend) {
-
-		// read enough input samples so that opos < 0
-		while ((frac_t)FRAC_ONE_LOW <= opos) {
-			// Check if we have to refill the buffer
-			if (inLen == 0) {
-				inPtr = inBuf;
-				inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
-				if (inLen <= 0)
-					return (obuf - ostart) / 2;
+	bool eos = false;
+	while (obuf < oend && !eos) {
+		// Interpolate as much as fits into the intermediate output buffer...
+		const st_size_t frames = MIN<st_size_t>((oend - obuf) / 2, INTERMEDIATE_BUFFER_SIZE / 2);
+		st_sample_t *outPtr = outBuf;
+		st_sample_t *const outEnd = outBuf + frames * (stereo ? 2 : 1);
+
+		while (outPtr < outEnd) {
+
+			// read enough input samples so that opos < 0
+			while ((frac_t)FRAC_ONE_LOW <= opos) {
+				// Check if we have to refill the buffer
+				if (inLen == 0) {
+					inPtr = inBuf;
+					inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
+					if (inLen <= 0) {
+						eos = true;
+						break;
+					}
+				}
+				inLen -= (stereo ? 2 : 1);
+				ilast0 = icur0;
+				icur0 = *inPtr++;
+				if (stereo) {
+					ilast1 = icur1;
+					icur1 = *inPtr++;
+				}
+				opos -= FRAC_ONE_LOW;
 			}
-			inLen -= (stereo ? 2 : 1);
-			ilast0 = icur0;
-			icur0 = *inPtr++;
-			if (stereo) {
-				ilast1 = icur1;
-				icur1 = *inPtr++;
+
+			if (eos)
+				break;
+
+			// Loop as long as the outpos trails behind, and as long as there is
+			// still space in the output buffer.
+			while (opos < (frac_t)FRAC_ONE_LOW && outPtr < outEnd) {
+				// interpolate
+				const st_sample_t out0 = (st_sample_t)(ilast0 + (((icur0 - ilast0) * opos + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
+				if (stereo) {
+					outPtr[reverseStereo    ] = out0;
+					outPtr[reverseStereo ^ 1] = (st_sample_t)(ilast1 + (((icur1 - ilast1) * opos + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
+					outPtr += 2;
+				} else {
+					*outPtr++ = out0;
+				}
+
+				// Increment output position
+				opos += opos_inc;
 			}
-			opos -= FRAC_ONE_LOW;
 		}
 
-		// Loop as long as the outpos trails behind, and as long as there is
-		// still space in the output buffer.
-		while (opos < (frac_t)FRAC_ONE_LOW && obuf < oend) {
-			// interpolate
-			st_sample_t out0, out1;
-			out0 = (st_sample_t)(ilast0 + (((icur0 - ilast0) * opos + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
-			out1 = (stereo ?
-						  (st_sample_t)(ilast1 + (((icur1 - ilast1) * opos + FRAC_HALF_LOW) >> FRAC_BITS_LOW)) :
-						  out0);
-
-			// output left channel
-			clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
-
-			// output right channel
-			clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
-
-			obuf += 2;
-
-			// Increment output position
-			opos += opos_inc;
-		}
+		// ...and mix it into the output buffer in one go
+		const st_size_t produced = (outPtr - outBuf) / (stereo ? 2 : 1);
+		mixProc(obuf, outBuf, produced, reverseStereo ? vol_r : vol_l, reverseStereo ? vol_l : vol_r);
+		obuf += produced * 2;
 	}
 	return (obuf - ostart) / 2;
 }
@@ -284,20 +753,13 @@ template<bool stereo, bool reverseStereo>
 class CopyRateConverter : public RateConverter {
 	st_sample_t *_buffer;
 	st_size_t _bufferSize;
-public:
-	CopyRateConverter() : _buffer(0), _bufferSize(0) {}
-	~CopyRateConverter() {
-		free(_buffer);
-	}
+	MixProc _mixProc;
+	MixBusProc _mixBusProc;
 
-	virtual int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+	template<typename T, typename Proc>
+	int convert(AudioStream &input, T *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r, Proc mixProc) {
 		assert(input.isStereo() == stereo);
 
-		st_sample_t *ptr;
-		st_size_t len;
-
-		st_sample_t *ostart = obuf;
-
 		if (stereo)
 			osamp *= 2;
 
@@ -312,38 +774,369 @@ public:
 			error("[CopyRateConverter::flow] Cannot allocate memory for temp buffer");
 
 		// Read up to 'osamp' samples into our temporary buffer
-		len = input.readBuffer(_buffer, osamp);
+		const int len = input.readBuffer(_buffer, osamp);
+		if (len <= 0)
+			return 0;
+
+		const st_size_t frames = len / (stereo ? 2 : 1);
+
+		// Bring the samples into output channel order
+		if (stereo && reverseStereo) {
+			st_sample_t *ptr = _buffer;
+			for (st_size_t i = 0; i < frames; i++, ptr += 2)
+				SWAP(ptr[0], ptr[1]);
+		}
 
 		// Mix the data into the output buffer
-		ptr = _buffer;
-		for (; len > 0; len -= (stereo ? 2 : 1)) {
-			st_sample_t out0, out1;
-			out0 = *ptr++;
-			out1 = (stereo ? *ptr++ : out0);
+		mixProc(obuf, _buffer, frames, reverseStereo ? vol_r : vol_l, reverseStereo ? vol_l : vol_r);
+		return frames;
+	}
 
-			// output left channel
-			clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+public:
+	CopyRateConverter() : _buffer(0), _bufferSize(0), _mixProc(getMixProc(stereo)), _mixBusProc(getMixBusProc(stereo)) {}
+	~CopyRateConverter() {
+		free(_buffer);
+	}
 
-			// output right channel
-			clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+	virtual int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+		return convert(input, obuf, osamp, vol_l, vol_r, _mixProc);
+	}
 
-			obuf += 2;
-		}
-		return (obuf - ostart) / 2;
+	virtual int flowMix(AudioStream &input, int32 *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+		return convert(input, obuf, osamp, vol_l, vol_r, _mixBusProc);
 	}
 
 	virtual int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) {
 		return ST_SUCCESS;
 	}
+
+	virtual const char *getName() const {
+		return "copy";
+	}
+};
+
+
+#pragma mark -
+
+/**
+ * Number of fractional bits of the windowed-sinc filter coefficients. This
+ * leaves enough headroom to accumulate 32 taps of full scale input in 32 bits.
+ */
+#define SINC_COEF_BITS 14
+
+/**
+ * Filter parameters for each of the windowed-sinc qualities.
+ */
+static const struct {
+	int taps;
+	int phaseBits;
+	double cutoff;
+	double beta;
+} sincQualityParams[] = {
+	{  8,  8, 0.85, 5.0 }, // kRateConverterSincLow
+	{ 16,  9, 0.90, 7.0 }, // kRateConverterSincMedium
+	{ 32, 10, 0.94, 9.0 }  // kRateConverterSincHigh
+};
+
+/**
+ * A bank of windowed-sinc filters, one for each fractional phase of the
+ * output position, for a given input/output rate pair and quality.
+ */
+struct SincFilterBank {
+	st_rate_t inrate, outrate;
+	RateConverterQuality quality;
+
+	int taps;
+	int phaseBits;
+	/** the coefficients, 'taps' entries for each of the 2^phaseBits phases */
+	int16 *coefs;
+
+	SincFilterBank(st_rate_t in, st_rate_t out, RateConverterQuality q);
+	~SincFilterBank() { delete[] coefs; }
+};
+
+/** Modified Bessel function of the first kind, as used by the Kaiser window. */
+static double besselI0(double x) {
+	double sum = 1.0, term = 1.0;
+	for (int k = 1; k < 64 && term > sum * 1e-12; ++k) {
+		const double t = x / (2 * k);
+		term *= t * t;
+		sum += term;
+	}
+	return sum;
+}
+
+SincFilterBank::SincFilterBank(st_rate_t in, st_rate_t out, RateConverterQuality q)
+	: inrate(in), outrate(out), quality(q) {
+	assert(q != kRateConverterLinear && q <= kRateConverterSincHigh);
+
+	taps = sincQualityParams[q - 1].taps;
+	phaseBits = sincQualityParams[q - 1].phaseBits;
+	const double beta = sincQualityParams[q - 1].beta;
+
+	// When downsampling, the cutoff has to move below the output's Nyquist
+	// frequency to avoid aliasing.
+	double cutoff = sincQualityParams[q - 1].cutoff;
+	if (outrate < inrate)
+		cutoff = cutoff * outrate / inrate;
+
+	const int phases = 1 << phaseBits;
+	const double halfTaps = taps / 2;
+	const double windowNorm = besselI0(beta);
+	double weights[32];
+	assert(taps <= ARRAYSIZE(weights));
+
+	coefs = new int16[phases * taps];
+	for (int p = 0; p < phases; ++p) {
+		const double phase = (double)p / phases;
+		int16 *dst = coefs + p * taps;
+
+		double sum = 0.0;
+		for (int j = 0; j < taps; ++j) {
+			// Distance of the input sample from the output position; the
+			// output lies between history samples taps/2 - 1 and taps/2.
+			const double d = j - halfTaps + 1 - phase;
+			const double x = d / halfTaps;
+			const double window = (x * x < 1.0) ? besselI0(beta * sqrt(1.0 - x * x)) / windowNorm : 0.0;
+			const double sinc = (d == 0.0) ? 1.0 : sin(M_PI * cutoff * d) / (M_PI * cutoff * d);
+			weights[j] = sinc * window;
+			sum += weights[j];
+		}
+
+		// Normalise to unity gain and put the rounding error on the centre
+		// tap, so that a constant signal passes through unchanged.
+		int total = 0;
+		for (int j = 0; j < taps; ++j) {
+			dst[j] = (int16)floor(weights[j] / sum * (1 << SINC_COEF_BITS) + 0.5);
+			total += dst[j];
+		}
+		dst[taps / 2 - 1 + (phase >= 0.5 ? 1 : 0)] += (1 << SINC_COEF_BITS) - total;
+	}
+}
+
+/**
+ * Cache of the filter banks in use, so that all channels converting between
+ * the same rates share their coefficients, and so that the (expensive) bank
+ * setup is only done once.
+ *
+ * Rate converters are not only created by the mixer, but also by engines
+ * such as SCI and Sword1, both from the engine thread and from their audio
+ * streams, so the banks are looked up and added with a mutex held. Banks
+ * are never removed before shutdown, so the returned pointers stay valid
+ * without it.
+ */
+class SincFilterCache : public Common::Singleton<SincFilterCache> {
+public:
+	~SincFilterCache() {
+		for (uint i = 0; i < _banks.size(); ++i)
+			delete _banks[i];
+	}
+
+	const SincFilterBank *getBank(st_rate_t inrate, st_rate_t outrate, RateConverterQuality quality) {
+		Common::StackLock lock(_mutex);
+		for (uint i = 0; i < _banks.size(); ++i) {
+			if (_banks[i]->inrate == inrate && _banks[i]->outrate == outrate && _banks[i]->quality == quality)
+				return _banks[i];
+		}
+
+		SincFilterBank *bank = new SincFilterBank(inrate, outrate, quality);
+		_banks.push_back(bank);
+		return bank;
+	}
+
+private:
+	Common::Mutex _mutex;
+	Common::Array<SincFilterBank *> _banks;
+};
+
+/**
+ * Apply one phase of the filter to the input history.
+ */
+static inline st_sample_t sincFilter(const st_sample_t *history, const int16 *coefs, int taps) {
+	int sum;
+#if defined(USE_RATE_SSE2)
+	__m128i acc = _mm_setzero_si128();
+	for (int i = 0; i < taps; i += 8)
+		acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(history + i)), _mm_loadu_si128((const __m128i *)(coefs + i))));
+	acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, 0x4E));
+	acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, 0xB1));
+	sum = _mm_cvtsi128_si32(acc);
+#elif defined(USE_RATE_NEON)
+	int32x4_t acc = vdupq_n_s32(0);
+	for (int i = 0; i < taps; i += 8) {
+		const int16x8_t h = vld1q_s16(history + i);
+		const int16x8_t c = vld1q_s16(coefs + i);
+		acc = vmlal_s16(acc, vget_low_s16(h), vget_low_s16(c));
+		acc = vmlal_s16(acc, vget_high_s16(h), vget_high_s16(c));
+	}
+	const int32x2_t acc2 = vadd_s32(vget_low_s32(acc), vget_high_s32(acc));
+	sum = vget_lane_s32(vpadd_s32(acc2, acc2), 0);
+#else
+	sum = 0;
+	for (int i = 0; i < taps; ++i)
+		sum += history[i] * coefs[i];
+#endif
+	return (st_sample_t)CLIP<int>((sum + (1 << (SINC_COEF_BITS - 1))) >> SINC_COEF_BITS, ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+}
+
+/**
+ * Audio rate converter based on table-driven polyphase windowed-sinc
+ * interpolation. Much better quality than LinearRateConverter, especially
+ * when upsampling low rate assets, at a higher CPU cost.
+ *
+ * Limited to sampling frequency <= 131071 Hz.
+ */
+template<bool stereo, bool reverseStereo>
+class SincRateConverter : public RateConverter {
+protected:
+	st_sample_t inBuf[INTERMEDIATE_BUFFER_SIZE];
+	const st_sample_t *inPtr;
+	int inLen;
+
+	/** filtered output, in output channel order, waiting to be mixed */
+	st_sample_t outBuf[INTERMEDIATE_BUFFER_SIZE];
+
+	/** fractional position of the output stream in input stream unit */
+	frac_t opos;
+
+	/** fractional position increment in the output stream */
+	frac_t opos_inc;
+
+	const SincFilterBank *_bank;
+
+	/**
+	 * The last 'taps' input samples of each channel. Every sample is stored
+	 * twice, so that the history is always contiguous from _histPos on.
+	 */
+	st_sample_t *_history;
+	int _histPos;
+
+	MixProc _mixProc;
+	MixBusProc _mixBusProc;
+
+	template<typename T, typename Proc>
+	int convert(AudioStream &input, T *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r, Proc mixProc);
+
+public:
+	SincRateConverter(st_rate_t inrate, st_rate_t outrate, RateConverterQuality quality);
+	~SincRateConverter() { delete[] _history; }
+	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+		return convert(input, obuf, osamp, vol_l, vol_r, _mixProc);
+	}
+	int flowMix(AudioStream &input, int32 *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+		return convert(input, obuf, osamp, vol_l, vol_r, _mixBusProc);
+	}
+	int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) {
+		return ST_SUCCESS;
+	}
+
+	const char *getName() const {
+		return "sinc";
+	}
 };
 
+template<bool stereo, bool reverseStereo>
+SincRateConverter<stereo, reverseStereo>::SincRateConverter(st_rate_t inrate, st_rate_t outrate, RateConverterQuality quality) {
+	if (inrate >= 131072 || outrate >= 131072) {
+		error("rate effect can only handle rates < 131072");
+	}
+
+	opos = FRAC_ONE_LOW;
+	opos_inc = (inrate << FRAC_BITS_LOW) / outrate;
+
+	_bank = SincFilterCache::instance().getBank(inrate, outrate, quality);
+
+	const int histSize = _bank->taps * 2 * (stereo ? 2 : 1);
+	_history = new st_sample_t[histSize];
+	memset(_history, 0, histSize * sizeof(st_sample_t));
+	_histPos = 0;
+
+	inLen = 0;
+
+	_mixProc = getMixProc(stereo);
+	_mixBusProc = getMixBusProc(stereo);
+}
+
+template<bool stereo, bool reverseStereo>
+template<typename T, typename Proc>
+int SincRateConverter<stereo, reverseStereo>::convert(AudioStream &input, T *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r, Proc mixProc) {
+	T *ostart, *oend;
+
+	ostart = obuf;
+	oend = obuf + osamp * 2;
+
+	const int taps = _bank->taps;
+	const int phaseShift = FRAC_BITS_LOW - _bank->phaseBits;
+	st_sample_t *const history0 = _history;
+	st_sample_t *const history1 = _history + taps * 2;
+
+	bool eos = false;
+	while (obuf < oend && !eos) {
+		// Filter as much as fits into the intermediate output buffer...
+		const st_size_t frames = MIN<st_size_t>((oend - obuf) / 2, INTERMEDIATE_BUFFER_SIZE / 2);
+		st_sample_t *outPtr = outBuf;
+		st_sample_t *const outEnd = outBuf + frames * (stereo ? 2 : 1);
+
+		while (outPtr < outEnd) {
+
+			// read enough input samples so that opos < 0
+			while ((frac_t)FRAC_ONE_LOW <= opos) {
+				// Check if we have to refill the buffer
+				if (inLen == 0) {
+					inPtr = inBuf;
+					inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
+					if (inLen <= 0) {
+						eos = true;
+						break;
+					}
+				}
+				inLen -= (stereo ? 2 : 1);
+				history0[_histPos] = history0[_histPos + taps] = *inPtr++;
+				if (stereo)
+					history1[_histPos] = history1[_histPos + taps] = *inPtr++;
+				if (++_histPos == taps)
+					_histPos = 0;
+				opos -= FRAC_ONE_LOW;
+			}
+
+			if (eos)
+				break;
+
+			// Loop as long as the outpos trails behind, and as long as there is
+			// still space in the output buffer.
+			while (opos < (frac_t)FRAC_ONE_LOW && outPtr < outEnd) {
+				const int16 *coefs = _bank->coefs + (opos >> phaseShift) * taps;
+				const st_sample_t out0 = sincFilter(history0 + _histPos, coefs, taps);
+				if (stereo) {
+					outPtr[reverseStereo    ] = out0;
+					outPtr[reverseStereo ^ 1] = sincFilter(history1 + _histPos, coefs, taps);
+					outPtr += 2;
+				} else {
+					*outPtr++ = out0;
+				}
+
+				// Increment output position
+				opos += opos_inc;
+			}
+		}
+
+		// ...and mix it into the output buffer in one go
+		const st_size_t produced = (outPtr - outBuf) / (stereo ? 2 : 1);
+		mixProc(obuf, outBuf, produced, reverseStereo ? vol_r : vol_l, reverseStereo ? vol_l : vol_r);
+		obuf += produced * 2;
+	}
+	return (obuf - ostart) / 2;
+}
+
 
 #pragma mark -
 
 template<bool stereo, bool reverseStereo>
-RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate) {
+RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, RateConverterQuality quality) {
 	if (inrate != outrate) {
-		if ((inrate % outrate) == 0 && (inrate < 65536)) {
+		if (quality != kRateConverterLinear) {
+			return new SincRateConverter<stereo, reverseStereo>(inrate, outrate, quality);
+		} else if ((inrate % outrate) == 0 && (inrate < 65536)) {
 			return new SimpleRateConverter<stereo, reverseStereo>(inrate, outrate);
 		} else {
 			return new LinearRateConverter<stereo, reverseStereo>(inrate, outrate);
@@ -356,14 +1149,18 @@ RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate) {
 /**
  * Create and return a RateConverter object for the specified input and output rates.
  */
-RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo) {
+RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo, RateConverterQuality quality) {
 	if (stereo) {
 		if (reverseStereo)
-			return makeRateConverter<true, true>(inrate, outrate);
+			return makeRateConverter<true, true>(inrate, outrate, quality);
 		else
-			return makeRateConverter<true, false>(inrate, outrate);
+			return makeRateConverter<true, false>(inrate, outrate, quality);
 	} else
-		return makeRateConverter<false, false>(inrate, outrate);
+		return makeRateConverter<false, false>(inrate, outrate, quality);
 }
 
 } // End of namespace Audio
+
+namespace Common {
+DECLARE_SINGLETON(Audio::SincFilterCache);
+}
@@ -82,10 +82,47 @@ public:
 	 */
 	virtual int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) = 0;
 
+	/**
+	 * Like flow(), but adds the samples to a 32-bit mix bus without
+	 * clamping them. Use clampMixBus() to turn the final mix into 16-bit
+	 * output.
+	 *
+	 * @return Number of sample pairs written into the buffer.
+	 */
+	virtual int flowMix(AudioStream &input, int32 *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) = 0;
+
 	virtual int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) = 0;
+
+	/**
+	 * @return Short name of the conversion method, for statistics and debugging.
+	 */
+	virtual const char *getName() const = 0;
 };
 
-RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo = false);
+/**
+ * Quality of the resampling done by a RateConverter.
+ */
+enum RateConverterQuality {
+	kRateConverterLinear = 0,     /*!< Nearest or linear interpolation, cheapest. */
+	kRateConverterSincLow = 1,    /*!< 8 tap windowed-sinc interpolation. */
+	kRateConverterSincMedium = 2, /*!< 16 tap windowed-sinc interpolation. */
+	kRateConverterSincHigh = 3    /*!< 32 tap windowed-sinc interpolation, best quality. */
+};
+
+RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo = false, RateConverterQuality quality = kRateConverterLinear);
+
+/**
+ * Clamp 32-bit samples, e.g. the output of a synthesizer, to signed 16-bit
+ * samples. Out of range samples saturate at the 16-bit limits rather than
+ * wrapping around. This uses SSE2 or NEON where available.
+ */
+void clampSamples(st_sample_t *obuf, const int32 *src, st_size_t samples);
+
+/**
+ * Clamp the samples of a 32-bit mix bus, as filled by RateConverter::flowMix(),
+ * to 16-bit output samples.
+ */
+void clampMixBus(st_sample_t *obuf, const int32 *bus, st_size_t samples);
 /** @} */
 } // End of namespace Audio
 
@@ -38,10 +38,14 @@
 #include "common/scummsys.h"
 #include "common/config-manager.h"
 #include "common/error.h"
+#include "common/fs.h"
+#include "common/list.h"
+#include "common/mutex.h"
 #include "common/stream.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
+#include "audio/decodeahead.h"
 #include "audio/musicplugin.h"
 #include "audio/mpu401.h"
 #include "audio/softsynth/emumidi.h"
@@ -86,6 +90,95 @@ static void logHandler(int level, char *message, void *data)
 	}
 }
 
+/**
+ * Keeps the synths of closed drivers along with their loaded SoundFont, so
+ * that reopening the driver, e.g. when switching games, does not load the
+ * SoundFont again.
+ *
+ * A loaded fluid_sfont_t cannot be moved to another synth: it keeps using
+ * the file callbacks of the loader that created it, and that loader is
+ * owned and deleted by the synth. Hence the whole synth is kept, and it is
+ * only used by one driver at a time.
+ */
+class FluidSynthCache {
+public:
+	struct Entry {
+		Entry() : settings(nullptr), synth(nullptr), soundFont(-1), outputRate(0), size(0) {}
+
+		Common::String path;
+		fluid_settings_t *settings;
+		fluid_synth_t *synth;
+		int soundFont;
+		int outputRate;
+		/** The size of the SoundFont file, an upper bound of its memory use. */
+		uint32 size;
+	};
+
+	~FluidSynthCache();
+
+	/**
+	 * Take a synth which has the given SoundFont file loaded and renders at
+	 * the given rate out of the cache.
+	 */
+	bool take(const Common::String &path, int outputRate, Entry &entry);
+
+	/**
+	 * Keep the synth of a closed driver, deleting the least recently used
+	 * ones that exceed the "fluidsynth_soundfont_cache" budget.
+	 */
+	void put(const Entry &entry);
+
+private:
+	static void deleteEntry(const Entry &entry);
+
+	Common::Mutex _mutex;
+	/** The cached synths, the most recently used first. */
+	Common::List<Entry> _entries;
+};
+
+FluidSynthCache::~FluidSynthCache() {
+	for (Common::List<Entry>::const_iterator it = _entries.begin(); it != _entries.end(); ++it)
+		deleteEntry(*it);
+}
+
+bool FluidSynthCache::take(const Common::String &path, int outputRate, Entry &entry) {
+	Common::StackLock lock(_mutex);
+
+	for (Common::List<Entry>::iterator it = _entries.begin(); it != _entries.end(); ++it) {
+		if (it->path == path && it->outputRate == outputRate) {
+			entry = *it;
+			_entries.erase(it);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void FluidSynthCache::put(const Entry &entry) {
+	Common::StackLock lock(_mutex);
+
+	_entries.push_front(entry);
+
+	const uint64 budget = (uint64)MAX(ConfMan.getInt("fluidsynth_soundfont_cache"), 0) * 1024 * 1024;
+	uint64 used = 0;
+	for (Common::List<Entry>::iterator it = _entries.begin(); it != _entries.end(); ) {
+		used += it->size;
+		if (!budget || used > budget) {
+			deleteEntry(*it);
+			it = _entries.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+void FluidSynthCache::deleteEntry(const Entry &entry) {
+	fluid_synth_sfunload(entry.synth, entry.soundFont, 1);
+	delete_fluid_synth(entry.synth);
+	delete_fluid_settings(entry.settings);
+}
+
 class MidiDriver_FluidSynth : public MidiDriver_Emulated {
 private:
 	MidiChannel_MPU401 _midiChannels[16];
@@ -95,16 +188,26 @@ private:
 	int _outputRate;
 	Common::SeekableReadStream *_engineSoundFontData;
 
+	FluidSynthCache *_cache;
+	/** The path of the loaded SoundFont file, empty for in-memory SoundFont data. */
+	Common::String _soundFontPath;
+	uint32 _soundFontSize;
+
+	/** Serialises the use of the synth by send() and the rendering, which may run on a worker thread. */
+	Common::Mutex _mutex;
+	/** The stream played by the mixer, either this or a render-ahead wrapper of it. */
+	Audio::AudioStream *_mixerStream;
+
 protected:
 	// Because GCC complains about casting from const to non-const...
-	void setInt(const char *name, int val);
+	bool setInt(const char *name, int val);
 	void setNum(const char *name, double num);
 	void setStr(const char *name, const char *str);
 
 	void generateSamples(int16 *buf, int len) override;
 
 public:
-	MidiDriver_FluidSynth(Audio::Mixer *mixer);
+	MidiDriver_FluidSynth(Audio::Mixer *mixer, FluidSynthCache *cache);
 
 	int open() override;
 	void close() override;
@@ -129,8 +232,9 @@ public:
 
 // MidiDriver method implementations
 
-MidiDriver_FluidSynth::MidiDriver_FluidSynth(Audio::Mixer *mixer)
-	: MidiDriver_Emulated(mixer), _engineSoundFontData(nullptr) {
+MidiDriver_FluidSynth::MidiDriver_FluidSynth(Audio::Mixer *mixer, FluidSynthCache *cache)
+	: MidiDriver_Emulated(mixer), _settings(nullptr), _synth(nullptr), _soundFont(-1),
+	  _engineSoundFontData(nullptr), _cache(cache), _soundFontSize(0), _mixerStream(nullptr) {
 
 	for (int i = 0; i < ARRAYSIZE(_midiChannels); i++) {
 		_midiChannels[i].init(this, i);
@@ -149,11 +253,17 @@ MidiDriver_FluidSynth::MidiDriver_FluidSynth(Audio::Mixer *mixer)
 // The string duplication below is there only because older versions (1.1.6
 // and earlier?) of FluidSynth expected the string parameters to be non-const.
 
-void MidiDriver_FluidSynth::setInt(const char *name, int val) {
+bool MidiDriver_FluidSynth::setInt(const char *name, int val) {
 	char *name2 = scumm_strdup(name);
 
-	fluid_settings_setint(_settings, name2, val);
+#if FS_API_VERSION >= 0x0200
+	const bool success = fluid_settings_setint(_settings, name2, val) == FLUID_OK;
+#else
+	// FluidSynth 1.x returns 1 on success
+	const bool success = fluid_settings_setint(_settings, name2, val) != 0;
+#endif
 	free(name2);
+	return success;
 }
 
 void MidiDriver_FluidSynth::setNum(const char *name, double val) {
@@ -238,7 +348,23 @@ int MidiDriver_FluidSynth::open() {
 		return MERR_DEVICE_NOT_AVAILABLE;
 	}
 
-	_settings = new_fluid_settings();
+	// The SoundFont file, or the address of the in-memory SoundFont data
+	// for the memory loader below
+	Common::String soundFontPath;
+	if (isUsingInMemorySoundFontData) {
+		soundFontPath = Common::String::format("&%p", (void *)_engineSoundFontData);
+	} else {
+#if defined(IPHONE_IOS7) && defined(IPHONE_SANDBOXED)
+		// HACK: Due to the sandbox on non-jailbroken iOS devices, we need to deal
+		// with the chroot filesystem. All the path selected by the user are
+		// relative to the Document directory. So, we need to adjust the path to
+		// reflect that.
+		soundFontPath = iOS7_getDocumentsDir();
+		soundFontPath += ConfMan.get("soundfont");
+#else
+		soundFontPath = ConfMan.get("soundfont");
+#endif
+	}
 
 	// The default gain setting is ridiculously low - at least for me. This
 	// cannot be fixed by ScummVM's volume settings because they can only
@@ -247,10 +373,35 @@ int MidiDriver_FluidSynth::open() {
 
 	double gain = (double)ConfMan.getInt("midi_gain") / 100.0;
 
-	setNum("synth.gain", gain);
-	setNum("synth.sample-rate", _outputRate);
+	// Reuse the synth of a closed driver, which has the SoundFont loaded
+	FluidSynthCache::Entry cached;
+	if (!isUsingInMemorySoundFontData && _cache->take(soundFontPath, _outputRate, cached)) {
+		_settings = cached.settings;
+		_synth = cached.synth;
+		_soundFont = cached.soundFont;
+		_soundFontSize = cached.size;
 
-	_synth = new_fluid_synth(_settings);
+		fluid_synth_set_gain(_synth, gain);
+	} else {
+		_settings = new_fluid_settings();
+
+		setNum("synth.gain", gain);
+		setNum("synth.sample-rate", _outputRate);
+
+#if FS_API_VERSION >= 0x0201
+		// Only load the samples of the presets that are actually used, which
+		// makes opening large General MIDI SoundFonts a lot faster and keeps
+		// them from taking up all that memory. This needs to reopen the file
+		// later on, so it is left off for in-memory SoundFont data, whose
+		// stream is gone after loading. The setting is not available in
+		// older FluidSynth versions.
+		if (!isUsingInMemorySoundFontData && !setInt("synth.dynamic-sample-loading", 1))
+			debug(1, "MidiDriver_FluidSynth: Dynamic sample loading is not supported");
+#endif
+
+		_synth = new_fluid_synth(_settings);
+		_soundFont = -1;
+	}
 
 	if (ConfMan.getBool("fluidsynth_chorus_activate")) {
 #if FS_API_VERSION >= 0x0202
@@ -332,47 +483,54 @@ int MidiDriver_FluidSynth::open() {
 
 	fluid_synth_set_interp_method(_synth, -1, interpMethod);
 
-	const char *soundfont = !isUsingInMemorySoundFontData ?
-			ConfMan.get("soundfont").c_str() : Common::String::format("&%p", (void *)_engineSoundFontData).c_str();
-
+	if (_soundFont == -1) {
 #if FS_API_VERSION >= 0x0200
-	if (isUsingInMemorySoundFontData) {
-		fluid_sfloader_t *soundFontMemoryLoader = new_fluid_defsfloader(_settings);
-		fluid_sfloader_set_callbacks(soundFontMemoryLoader,
-									 SoundFontMemLoader_open,
-									 SoundFontMemLoader_read,
-									 SoundFontMemLoader_seek,
-									 SoundFontMemLoader_tell,
-									 SoundFontMemLoader_close);
-		fluid_synth_add_sfloader(_synth, soundFontMemoryLoader);
-	}
+		if (isUsingInMemorySoundFontData) {
+			fluid_sfloader_t *soundFontMemoryLoader = new_fluid_defsfloader(_settings);
+			fluid_sfloader_set_callbacks(soundFontMemoryLoader,
+										 SoundFontMemLoader_open,
+										 SoundFontMemLoader_read,
+										 SoundFontMemLoader_seek,
+										 SoundFontMemLoader_tell,
+										 SoundFontMemLoader_close);
+			fluid_synth_add_sfloader(_synth, soundFontMemoryLoader);
+		}
 #endif
 
-#if defined(IPHONE_IOS7) && defined(IPHONE_SANDBOXED)
-	if (!isUsingInMemorySoundFontData) {
-		// HACK: Due to the sandbox on non-jailbroken iOS devices, we need to deal
-		// with the chroot filesystem. All the path selected by the user are
-		// relative to the Document directory. So, we need to adjust the path to
-		// reflect that.
-		Common::String soundfont_fullpath = iOS7_getDocumentsDir();
-		soundfont_fullpath += soundfont;
-		_soundFont = fluid_synth_sfload(_synth, soundfont_fullpath.c_str(), 1);
-	} else {
-		_soundFont = fluid_synth_sfload(_synth, soundfont, 1);
-	}
-#else
-	_soundFont = fluid_synth_sfload(_synth, soundfont, 1);
-#endif
+		_soundFont = fluid_synth_sfload(_synth, soundFontPath.c_str(), 1);
 
-	if (_soundFont == -1) {
-		GUI::MessageDialog dialog(_("FluidSynth: Failed loading custom SoundFont '%s'. Music is off."), soundfont);
-		dialog.runModal();
-		return MERR_DEVICE_NOT_AVAILABLE;
+		if (_soundFont == -1) {
+			delete_fluid_synth(_synth);
+			delete_fluid_settings(_settings);
+			_synth = nullptr;
+			_settings = nullptr;
+
+			GUI::MessageDialog dialog(_("FluidSynth: Failed loading custom SoundFont '%s'. Music is off."), soundFontPath.c_str());
+			dialog.runModal();
+			return MERR_DEVICE_NOT_AVAILABLE;
+		}
+
+		_soundFontSize = 0;
+		if (!isUsingInMemorySoundFontData) {
+			Common::SeekableReadStream *file = Common::FSNode(soundFontPath).createReadStream();
+			if (file)
+				_soundFontSize = file->size();
+			delete file;
+		}
 	}
 
+	// Only SoundFont files are cached, in-memory data has no name to look it up by
+	_soundFontPath = isUsingInMemorySoundFontData ? Common::String() : soundFontPath;
+
 	MidiDriver_Emulated::open();
 
-	_mixer->playStream(Audio::Mixer::kPlainSoundType, &_mixerSoundHandle, this, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
+	// Optionally render ahead on a worker thread, so that the mixer only
+	// copies samples. Like with the MT-32 emulator, the music player's timer
+	// callback is driven by the rendering and runs on that thread as well,
+	// so only the events sent directly by the engine are delayed.
+	_mixerStream = Audio::makeDecodeAheadStream(this, MAX(ConfMan.getInt("fluidsynth_render_ahead"), 0), DisposeAfterUse::NO);
+
+	_mixer->playStream(Audio::Mixer::kPlainSoundType, &_mixerSoundHandle, _mixerStream, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
 
 	return 0;
 }
@@ -384,11 +542,34 @@ void MidiDriver_FluidSynth::close() {
 
 	_mixer->stopHandle(_mixerSoundHandle);
 
-	if (_soundFont != -1)
-		fluid_synth_sfunload(_synth, _soundFont, 1);
+	// Stop rendering ahead
+	if (_mixerStream != this)
+		delete _mixerStream;
+	_mixerStream = nullptr;
+
+	if (!_soundFontPath.empty()) {
+		// Keep the synth with its SoundFont for the next driver
+		fluid_synth_system_reset(_synth);
+
+		FluidSynthCache::Entry entry;
+		entry.path = _soundFontPath;
+		entry.settings = _settings;
+		entry.synth = _synth;
+		entry.soundFont = _soundFont;
+		entry.outputRate = _outputRate;
+		entry.size = _soundFontSize;
+		_cache->put(entry);
+	} else {
+		if (_soundFont != -1)
+			fluid_synth_sfunload(_synth, _soundFont, 1);
 
-	delete_fluid_synth(_synth);
-	delete_fluid_settings(_settings);
+		delete_fluid_synth(_synth);
+		delete_fluid_settings(_settings);
+	}
+
+	_settings = nullptr;
+	_synth = nullptr;
+	_soundFont = -1;
 }
 
 void MidiDriver_FluidSynth::send(uint32 b) {
@@ -397,6 +578,8 @@ void MidiDriver_FluidSynth::send(uint32 b) {
 
 	midiDriverCommonSend(b);
 
+	Common::StackLock lock(_mutex);
+
 	//byte param3 = (byte) ((b >> 24) & 0xFF);
 	uint param2 = (byte) ((b >> 16) & 0xFF);
 	uint param1 = (byte) ((b >>  8) & 0xFF);
@@ -447,6 +630,7 @@ MidiChannel *MidiDriver_FluidSynth::getPercussionChannel() {
 }
 
 void MidiDriver_FluidSynth::generateSamples(int16 *data, int len) {
+	Common::StackLock lock(_mutex);
 	fluid_synth_write_s16(_synth, len, data, 0, 2, data, 1, 2);
 }
 
@@ -469,6 +653,10 @@ public:
 
 	MusicDevices getDevices() const;
 	Common::Error createInstance(MidiDriver **mididriver, MidiDriver::DeviceHandle = 0) const;
+
+private:
+	/** Shared by all the drivers created by this plugin. */
+	mutable FluidSynthCache _cache;
 };
 
 MusicDevices FluidSynthMusicPlugin::getDevices() const {
@@ -478,7 +666,7 @@ MusicDevices FluidSynthMusicPlugin::getDevices() const {
 }
 
 Common::Error FluidSynthMusicPlugin::createInstance(MidiDriver **mididriver, MidiDriver::DeviceHandle) const {
-	*mididriver = new MidiDriver_FluidSynth(g_system->getMixer());
+	*mididriver = new MidiDriver_FluidSynth(g_system->getMixer(), &_cache);
 
 	return Common::kNoError;
 }
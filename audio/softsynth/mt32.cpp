@@ -26,6 +26,7 @@
 #ifdef USE_MT32EMU
 
 #include "audio/softsynth/emumidi.h"
+#include "audio/decodeahead.h"
 #include "audio/musicplugin.h"
 #include "audio/mpu401.h"
 
@@ -120,6 +121,9 @@ private:
 
 	int _outputRate;
 
+	/** The stream played by the mixer, either this or a render-ahead wrapper of it. */
+	Audio::AudioStream *_mixerStream;
+
 protected:
 	void generateSamples(int16 *buf, int len) override;
 
@@ -157,6 +161,7 @@ MidiDriver_MT32::MidiDriver_MT32(Audio::Mixer *mixer) : MidiDriver_Emulated(mixe
 	_outputRate = 0;
 	_controlData = nullptr;
 	_pcmData = nullptr;
+	_mixerStream = nullptr;
 }
 
 MidiDriver_MT32::~MidiDriver_MT32() {
@@ -216,7 +221,14 @@ int MidiDriver_MT32::open() {
 
 	MidiDriver_Emulated::open();
 
-	_mixer->playStream(Audio::Mixer::kPlainSoundType, &_mixerSoundHandle, this, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
+	// Optionally render ahead on a worker thread, so that the mixer only
+	// copies samples. The music player's timer callback is driven by the
+	// rendering, so it runs on that thread too. The music's MIDI events
+	// still hit the same samples, and only events sent directly by the
+	// engine are delayed.
+	_mixerStream = Audio::makeDecodeAheadStream(this, MAX(ConfMan.getInt("mt32_render_ahead"), 0), DisposeAfterUse::NO);
+
+	_mixer->playStream(Audio::Mixer::kPlainSoundType, &_mixerSoundHandle, _mixerStream, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
 
 	return 0;
 }
@@ -269,6 +281,11 @@ void MidiDriver_MT32::close() {
 	// Detach the mixer callback handler
 	_mixer->stopHandle(_mixerSoundHandle);
 
+	// Stop rendering ahead
+	if (_mixerStream != this)
+		delete _mixerStream;
+	_mixerStream = nullptr;
+
 	Common::StackLock lock(_mutex);
 	_service.closeSynth();
 	_service.freeContext();
@@ -33,6 +33,7 @@
 #include "dbopl.h"
 
 #include "audio/mixer.h"
+#include "audio/rate.h"
 #include "common/system.h"
 #include "common/scummsys.h"
 #include "common/util.h"
@@ -327,6 +328,8 @@ void OPL::generateSamples(int16 *buffer, int length) {
 	if (_type != Config::kOpl2)
 		length >>= 1;
 
+	// DBOPL renders 32-bit samples. Loud passages used to wrap around when
+	// those were narrowed to 16 bits; they are now saturated instead.
 	const uint bufferLength = 512;
 	int32 tempBuffer[bufferLength * 2];
 
@@ -335,9 +338,7 @@ void OPL::generateSamples(int16 *buffer, int length) {
 			const uint readSamples = MIN<uint>(length, bufferLength);
 
 			_emulator->GenerateBlock3(readSamples, tempBuffer);
-
-			for (uint i = 0; i < (readSamples << 1); ++i)
-				buffer[i] = tempBuffer[i];
+			Audio::clampSamples(buffer, tempBuffer, readSamples << 1);
 
 			buffer += (readSamples << 1);
 			length -= readSamples;
@@ -347,9 +348,7 @@ void OPL::generateSamples(int16 *buffer, int length) {
 			const uint readSamples = MIN<uint>(length, bufferLength << 1);
 
 			_emulator->GenerateBlock2(readSamples, tempBuffer);
-
-			for (uint i = 0; i < readSamples; ++i)
-				buffer[i] = tempBuffer[i];
+			Audio::clampSamples(buffer, tempBuffer, readSamples);
 
 			buffer += readSamples;
 			length -= readSamples;
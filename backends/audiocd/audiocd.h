@@ -99,6 +99,14 @@ public:
 	 */
 	virtual void update() = 0;
 
+	/**
+	 * Hint that the specified track is likely to be played soon. Managers
+	 * which emulate audio CD playback may use it to open and seek the
+	 * track ahead of time, so that play() starts it without delay.
+	 * @param track          the track which may be played next.
+	 */
+	virtual void prefetch(int track) {}
+
 	/**
 	 * Get the playback status.
 	 * @return a Status struct with playback data.
@@ -22,8 +22,13 @@
 
 #include "backends/audiocd/default/default-audiocd.h"
 #include "audio/audiostream.h"
+#include "common/algorithm.h"
+#include "common/archive.h"
 #include "common/config-manager.h"
+#include "common/fs.h"
+#include "common/stream.h"
 #include "common/system.h"
+#include "common/threadpool.h"
 #include "common/util.h"
 
 DefaultAudioCDManager::DefaultAudioCDManager() {
@@ -37,11 +42,25 @@ DefaultAudioCDManager::DefaultAudioCDManager() {
 	_mixer = g_system->getMixer();
 	_emulating = false;
 	assert(_mixer);
+
+	_decodingTrack = 0;
+	_prefetchRunning = false;
+
+	// One worker thread, and the calling thread which is not used
+	_prefetchPool = g_system->createThreadPool(2);
+	if (_prefetchPool->getThreadCount() < 2) {
+		delete _prefetchPool;
+		_prefetchPool = nullptr;
+	}
 }
 
 DefaultAudioCDManager::~DefaultAudioCDManager() {
 	// Subclasses should call close as well
 	close();
+
+	// This waits for a running job, which clearPrefetched() told to stop
+	delete _prefetchPool;
+	clearPrefetched();
 }
 
 bool DefaultAudioCDManager::open() {
@@ -53,6 +72,8 @@ bool DefaultAudioCDManager::open() {
 void DefaultAudioCDManager::close() {
 	// Only need to stop for emulation
 	stop();
+	clearPrefetched();
+	_missingTracks.clear();
 }
 
 bool DefaultAudioCDManager::play(int track, int numLoops, int startFrame, int duration, bool onlyEmulate,
@@ -68,15 +89,7 @@ bool DefaultAudioCDManager::play(int track, int numLoops, int startFrame, int du
 		// Try to load the track from a compressed data file, and if found, use
 		// that. If not found, attempt to start regular Audio CD playback of
 		// the requested track.
-		Common::String trackName[4];
-		trackName[0] = Common::String::format("track%d", track);
-		trackName[1] = Common::String::format("track%02d", track);
-		trackName[2] = Common::String::format("track_%d", track);
-		trackName[3] = Common::String::format("track_%02d", track);
-		Audio::SeekableAudioStream *stream = 0;
-
-		for (int i = 0; !stream && i < ARRAYSIZE(trackName); ++i)
-			stream = Audio::SeekableAudioStream::openStreamFile(trackName[i]);
+		Audio::SeekableAudioStream *stream = takeTrack(track);
 
 		if (stream != 0) {
 			Audio::Timestamp start = Audio::Timestamp(0, startFrame, 75);
@@ -90,6 +103,11 @@ bool DefaultAudioCDManager::play(int track, int numLoops, int startFrame, int du
 			_emulating = true;
 			_mixer->playStream(soundType, &_handle,
 			                        Audio::makeLoopingAudioStream(stream, start, end, (numLoops < 1) ? numLoops + 1 : numLoops), -1, _cd.volume, _cd.balance);
+
+			// Engines either play the tracks in order, or start the same track
+			// again at another offset, as Loom does. Get both ready.
+			prefetch(track);
+			prefetch(track + 1);
 			return true;
 		}
 	}
@@ -142,6 +160,195 @@ void DefaultAudioCDManager::update() {
 			_emulating = false;
 		}
 	}
+
+	prefetchNext();
+}
+
+void DefaultAudioCDManager::prefetchNext() {
+	if (_pendingPrefetches.empty())
+		return;
+
+	int track = _pendingPrefetches.front();
+	_pendingPrefetches.remove_at(0);
+
+	// Opening a track may need a scan of the whole file. With a worker
+	// thread, that is done by the prefetch job, for the files which have a
+	// handle of their own. Archive members share the handle of their archive.
+	if (_prefetchPool) {
+		Common::String trackName[4];
+		trackName[0] = Common::String::format("track%d", track);
+		trackName[1] = Common::String::format("track%02d", track);
+		trackName[2] = Common::String::format("track_%d", track);
+		trackName[3] = Common::String::format("track_%02d", track);
+
+		Common::String filename;
+		for (int i = 0; filename.empty() && i < ARRAYSIZE(trackName); ++i)
+			filename = Audio::SeekableAudioStream::findStreamFile(trackName[i]);
+
+		if (filename.empty()) {
+			_missingTracks.push_back(track);
+			return;
+		}
+
+		Common::ArchiveMemberPtr member = SearchMan.getMember(filename);
+		const Common::FSNode *node = dynamic_cast<const Common::FSNode *>(member.get());
+		Common::SeekableReadStream *file = node ? node->createReadStream() : nullptr;
+		if (file) {
+			Common::StackLock lock(_prefetchMutex);
+
+			DecodingTrack decoding;
+			decoding.track = track;
+			decoding.filename = filename;
+			decoding.file = file;
+			_decodeQueue.push_back(decoding);
+
+			if (!_prefetchRunning) {
+				_prefetchRunning = true;
+				if (!_prefetchPool->startBackgroundJob(&prefetchProc, this))
+					prefetchProc(this);
+			}
+			return;
+		}
+	}
+
+	// Without a worker thread, they are opened one per update
+	Audio::SeekableAudioStream *stream = openTrack(track);
+	if (stream)
+		addPrefetched(track, stream);
+}
+
+void DefaultAudioCDManager::prefetchProc(void *data) {
+	DefaultAudioCDManager *manager = (DefaultAudioCDManager *)data;
+
+	for (;;) {
+		DecodingTrack decoding;
+		{
+			Common::StackLock lock(manager->_prefetchMutex);
+			if (manager->_decodeQueue.empty()) {
+				manager->_prefetchRunning = false;
+				return;
+			}
+
+			decoding = manager->_decodeQueue.remove_at(0);
+			manager->_decodingTrack = decoding.track;
+		}
+
+		// The lock is not held while loading, so that the engine can
+		// play the tracks which are ready meanwhile
+		Audio::SeekableAudioStream *stream = Audio::SeekableAudioStream::openStreamFile(decoding.file, decoding.filename);
+
+		Common::StackLock lock(manager->_prefetchMutex);
+		manager->_decodingTrack = 0;
+		if (stream)
+			manager->addPrefetched(decoding.track, stream);
+	}
+}
+
+void DefaultAudioCDManager::addPrefetched(int track, Audio::SeekableAudioStream *stream) {
+	Common::StackLock lock(_prefetchMutex);
+
+	if (_prefetched.size() >= kMaxPrefetchedTracks) {
+		delete _prefetched.front().stream;
+		_prefetched.remove_at(0);
+	}
+
+	PrefetchedTrack prefetched;
+	prefetched.track = track;
+	prefetched.stream = stream;
+	_prefetched.push_back(prefetched);
+}
+
+void DefaultAudioCDManager::prefetch(int track) {
+	if (track <= 0 || Common::find(_missingTracks.begin(), _missingTracks.end(), track) != _missingTracks.end())
+		return;
+
+	Common::StackLock lock(_prefetchMutex);
+
+	if (_decodingTrack == track)
+		return;
+
+	for (uint i = 0; i < _prefetched.size(); ++i) {
+		if (_prefetched[i].track == track)
+			return;
+	}
+
+	for (uint i = 0; i < _decodeQueue.size(); ++i) {
+		if (_decodeQueue[i].track == track)
+			return;
+	}
+
+	if (Common::find(_pendingPrefetches.begin(), _pendingPrefetches.end(), track) == _pendingPrefetches.end())
+		_pendingPrefetches.push_back(track);
+}
+
+Audio::SeekableAudioStream *DefaultAudioCDManager::openTrack(int track) {
+	Common::String trackName[4];
+	trackName[0] = Common::String::format("track%d", track);
+	trackName[1] = Common::String::format("track%02d", track);
+	trackName[2] = Common::String::format("track_%d", track);
+	trackName[3] = Common::String::format("track_%02d", track);
+	Audio::SeekableAudioStream *stream = 0;
+
+	for (int i = 0; !stream && i < ARRAYSIZE(trackName); ++i)
+		stream = Audio::SeekableAudioStream::openStreamFile(trackName[i]);
+
+	if (!stream)
+		_missingTracks.push_back(track);
+
+	return stream;
+}
+
+Audio::SeekableAudioStream *DefaultAudioCDManager::takeTrack(int track) {
+	_prefetchMutex.lock();
+
+	// The prefetch job is already loading the track, so wait for it
+	while (_decodingTrack == track) {
+		_prefetchMutex.unlock();
+		g_system->delayMillis(1);
+		_prefetchMutex.lock();
+	}
+
+	for (uint i = 0; i < _prefetched.size(); ++i) {
+		if (_prefetched[i].track == track) {
+			Audio::SeekableAudioStream *stream = _prefetched[i].stream;
+			_prefetched.remove_at(i);
+			_prefetchMutex.unlock();
+			return stream;
+		}
+	}
+
+	for (uint i = 0; i < _decodeQueue.size(); ++i) {
+		if (_decodeQueue[i].track == track) {
+			DecodingTrack decoding = _decodeQueue.remove_at(i);
+			_prefetchMutex.unlock();
+			return Audio::SeekableAudioStream::openStreamFile(decoding.file, decoding.filename);
+		}
+	}
+
+	_prefetchMutex.unlock();
+
+	// Drop a pending prefetch of the track, which would only open it twice
+	Common::Array<int>::iterator pending = Common::find(_pendingPrefetches.begin(), _pendingPrefetches.end(), track);
+	if (pending != _pendingPrefetches.end())
+		_pendingPrefetches.erase(pending);
+
+	return openTrack(track);
+}
+
+void DefaultAudioCDManager::clearPrefetched() {
+	Common::StackLock lock(_prefetchMutex);
+
+	for (uint i = 0; i < _prefetched.size(); ++i)
+		delete _prefetched[i].stream;
+	_prefetched.clear();
+
+	// A running prefetch job stops after the track it is loading, which
+	// it adds to _prefetched as usual
+	for (uint i = 0; i < _decodeQueue.size(); ++i)
+		delete _decodeQueue[i].file;
+	_decodeQueue.clear();
+
+	_pendingPrefetches.clear();
 }
 
 DefaultAudioCDManager::Status DefaultAudioCDManager::getStatus() const {
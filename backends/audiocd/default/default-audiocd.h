@@ -25,9 +25,17 @@
 
 #include "backends/audiocd/audiocd.h"
 #include "audio/mixer.h"
+#include "common/array.h"
+#include "common/mutex.h"
+#include "common/str.h"
+
+namespace Audio {
+class SeekableAudioStream;
+} // End of namespace Audio
 
 namespace Common {
-class String;
+class SeekableReadStream;
+class ThreadPool;
 } // End of namespace Common
 
 /**
@@ -47,9 +55,25 @@ public:
 	virtual void setVolume(byte volume);
 	virtual void setBalance(int8 balance);
 	virtual void update();
+	virtual void prefetch(int track);
 	virtual Status getStatus() const; // Subclasses should override for better status results
 
 protected:
+	/**
+	 * Open the compressed file emulating the specified track.
+	 * @return the stream of the track, or 0 if there is no such file
+	 */
+	Audio::SeekableAudioStream *openTrack(int track);
+
+	/**
+	 * Return the prefetched stream of the specified track, and forget it,
+	 * or open the track if it was not prefetched.
+	 */
+	Audio::SeekableAudioStream *takeTrack(int track);
+
+	/** Drop all the prefetched streams and the pending prefetches. */
+	void clearPrefetched();
+
 	/**
 	 * Open a CD using the cdrom config variable
 	 */
@@ -74,6 +98,60 @@ protected:
 
 	Status _cd;
 	Audio::Mixer *_mixer;
+
+private:
+	enum {
+		/** The maximum number of the tracks kept opened ahead of playback. */
+		kMaxPrefetchedTracks = 2
+	};
+
+	struct PrefetchedTrack {
+		int track;
+		Audio::SeekableAudioStream *stream;
+	};
+
+	struct DecodingTrack {
+		int track;
+		Common::String filename;
+		Common::SeekableReadStream *file;
+	};
+
+	/** The tracks opened ahead of time, the oldest first. */
+	Common::Array<PrefetchedTrack> _prefetched;
+
+	/** The tracks to open during the next updates. */
+	Common::Array<int> _pendingPrefetches;
+
+	/**
+	 * The tracks whose file has been opened by update(), for the prefetch
+	 * job to load on a worker thread. Only the decoders are created there,
+	 * since the archives in SearchMan must not be used by another thread.
+	 */
+	Common::Array<DecodingTrack> _decodeQueue;
+
+	/** The track the prefetch job is loading, or 0. */
+	int _decodingTrack;
+
+	/** Whether a prefetch job is queued or running. */
+	bool _prefetchRunning;
+
+	/** Protects _prefetched, _decodeQueue, _decodingTrack and _prefetchRunning. */
+	Common::Mutex _prefetchMutex;
+
+	/** Runs the prefetch job, or null if there is no worker thread. */
+	Common::ThreadPool *_prefetchPool;
+
+	/** Load the tracks of _decodeQueue, on a worker thread. */
+	static void prefetchProc(void *data);
+
+	/** Keep the stream of a track opened ahead of time. */
+	void addPrefetched(int track, Audio::SeekableAudioStream *stream);
+
+	/** Open the next pending track, or queue it for the prefetch job. */
+	void prefetchNext();
+
+	/** The tracks with no emulating file, which are not probed again. */
+	Common::Array<int> _missingTracks;
 };
 
 #endif
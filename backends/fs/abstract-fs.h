@@ -173,6 +173,18 @@ public:
 	 */
 	virtual bool isWritable() const = 0;
 
+	/**
+	 * Returns the size and the time of the last modification of the file
+	 * referred by this node. The time uses a backend specific unit and
+	 * epoch, and is only meant to be compared with other values returned
+	 * by the same backend.
+	 *
+	 * The default implementation does not know either value.
+	 *
+	 * @return bool true if both values could be retrieved, false otherwise.
+	 */
+	virtual bool getFileStats(int64 &size, int64 &modificationTime) const { return false; }
+
 
 	/**
 	 * Creates a SeekableReadStream instance corresponding to the file
@@ -198,6 +210,22 @@ public:
 	* @return true if the directory is created successfully
 	*/
 	virtual bool createDirectory() = 0;
+
+	/**
+	 * Returns whether renameTo() is implemented for this node.
+	 *
+	 * The default implementation cannot rename.
+	 */
+	virtual bool canRename() const { return false; }
+
+	/**
+	 * Renames the file referred by this node to the target node, which
+	 * belongs to the same backend. An existing target file is replaced in
+	 * a single step, so that it is never missing.
+	 *
+	 * @return true if the file was renamed, false otherwise
+	 */
+	virtual bool renameTo(const AbstractFSNode &target) { return false; }
 };
 
 
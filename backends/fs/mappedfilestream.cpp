@@ -0,0 +1,125 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// Disable symbol overrides so that we can use system headers.
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "backends/fs/mappedfilestream.h"
+
+#if defined(WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#if defined(UNICODE)
+#include "backends/platform/sdl/win32/win32_wrapper.h"
+#endif
+#elif defined(HAS_MMAP)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+bool MappedFileStream::_enabled = false;
+
+MappedFileStream::MappedFileStream(const byte *data, uint32 size)
+	: Common::MemoryReadStream(data, size, DisposeAfterUse::NO), _data(data) {
+}
+
+#if defined(WIN32)
+
+MappedFileStream::~MappedFileStream() {
+	UnmapViewOfFile(_data);
+}
+
+MappedFileStream *MappedFileStream::makeFromPath(const Common::String &path, int64 minSize) {
+	if (!_enabled)
+		return nullptr;
+
+#if defined(UNICODE)
+	wchar_t *wPath = Win32::stringToTchar(path);
+	HANDLE file = CreateFileW(wPath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	free(wPath);
+#else
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+#endif
+	if (file == INVALID_HANDLE_VALUE)
+		return nullptr;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart < minSize || size.QuadPart > kMaxMappedSize) {
+		CloseHandle(file);
+		return nullptr;
+	}
+
+	// The view keeps the mapping alive, and the mapping keeps the file open
+	HANDLE mapping = CreateFileMapping(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (!mapping)
+		return nullptr;
+
+	void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (!data)
+		return nullptr;
+
+	return new MappedFileStream((const byte *)data, (uint32)size.QuadPart);
+}
+
+#elif defined(HAS_MMAP)
+
+MappedFileStream::~MappedFileStream() {
+	munmap(const_cast<byte *>(_data), size());
+}
+
+MappedFileStream *MappedFileStream::makeFromPath(const Common::String &path, int64 minSize) {
+	if (!_enabled)
+		return nullptr;
+
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return nullptr;
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size < minSize || st.st_size > kMaxMappedSize) {
+		close(fd);
+		return nullptr;
+	}
+
+	// The mapping stays valid once the file is closed
+	void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED)
+		return nullptr;
+
+	return new MappedFileStream((const byte *)data, (uint32)st.st_size);
+}
+
+#else
+
+MappedFileStream::~MappedFileStream() {
+}
+
+MappedFileStream *MappedFileStream::makeFromPath(const Common::String &path, int64 minSize) {
+	return nullptr;
+}
+
+#endif
@@ -0,0 +1,87 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef BACKENDS_FS_MAPPEDFILESTREAM_H
+#define BACKENDS_FS_MAPPEDFILESTREAM_H
+
+#include "common/scummsys.h"
+#include "common/memstream.h"
+#include "common/noncopyable.h"
+#include "common/str.h"
+
+/**
+ * A read stream on a file mapped in memory, with mmap() on POSIX systems and
+ * a file mapping on Windows.
+ *
+ * The stream reads from the mapping like a MemoryReadStream does, so that
+ * readInPlace() returns pointers into the file contents and the span API
+ * (Common::readSpan) does not copy anything. The pages are only read from
+ * the disk when they are first accessed.
+ *
+ * The file must not be truncated while it is mapped, and the medium holding
+ * it must not be removed: reading the lost pages then crashes the process
+ * with SIGBUS on POSIX systems, instead of failing like a read. Mappings also
+ * take address space, which is scarce in 32-bit processes. Files are
+ * therefore only mapped once setEnabled() has been called, which is done for
+ * the "mmap_files" setting.
+ */
+class MappedFileStream : public Common::MemoryReadStream, public Common::NonCopyable {
+public:
+	/**
+	 * Files smaller than this are not worth a mapping: reading them with a
+	 * buffered stdio stream costs less than setting up and faulting in the
+	 * pages of the mapping.
+	 */
+	static const int64 kMinMappedSize = 256 * 1024;
+
+	/**
+	 * Files larger than this are not mapped. In 32-bit processes, this keeps
+	 * a few large files from using up the address space.
+	 */
+	static const int64 kMaxMappedSize = sizeof(void *) >= 8 ? 0xFFFFFFFF : 64 * 1024 * 1024;
+
+	/**
+	 * Map the file at @p path in memory and wrap it in a MappedFileStream.
+	 *
+	 * Return nullptr when mapping files is not enabled, when the file is
+	 * smaller than @p minSize or larger than kMaxMappedSize, when it cannot be
+	 * mapped, or when the platform has no support for file mappings. The
+	 * caller then falls back to a StdioStream.
+	 */
+	static MappedFileStream *makeFromPath(const Common::String &path, int64 minSize = kMinMappedSize);
+
+	/** Allow or forbid makeFromPath() to map files. This is off by default. */
+	static void setEnabled(bool enabled) { _enabled = enabled; }
+	static bool isEnabled() { return _enabled; }
+
+	~MappedFileStream() override;
+
+private:
+	MappedFileStream(const byte *data, uint32 size);
+
+	static bool _enabled;
+
+	/** Start of the mapping. */
+	const byte *_data;
+};
+
+#endif
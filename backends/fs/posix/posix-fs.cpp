@@ -34,6 +34,7 @@
 
 #include "backends/fs/posix/posix-fs.h"
 #include "backends/fs/posix/posix-iostream.h"
+#include "backends/fs/mappedfilestream.h"
 #include "common/algorithm.h"
 
 #include <sys/param.h>
@@ -71,6 +72,17 @@ bool POSIXFilesystemNode::isWritable() const {
 	return access(_path.c_str(), W_OK) == 0;
 }
 
+bool POSIXFilesystemNode::getFileStats(int64 &size, int64 &modificationTime) const {
+	struct stat st;
+
+	if (stat(_path.c_str(), &st) != 0 || S_ISDIR(st.st_mode))
+		return false;
+
+	size = st.st_size;
+	modificationTime = st.st_mtime;
+	return true;
+}
+
 void POSIXFilesystemNode::setFlags() {
 	struct stat st;
 
@@ -287,6 +299,9 @@ AbstractFSNode *POSIXFilesystemNode::getParent() const {
 }
 
 Common::SeekableReadStream *POSIXFilesystemNode::createReadStream() {
+	Common::SeekableReadStream *stream = MappedFileStream::makeFromPath(getPath());
+	if (stream)
+		return stream;
 	return PosixIoStream::makeFromPath(getPath(), false);
 }
 
@@ -312,6 +327,15 @@ bool POSIXFilesystemNode::createDirectory() {
 	return _isValid && _isDirectory;
 }
 
+bool POSIXFilesystemNode::renameTo(const AbstractFSNode &target) {
+	// rename() replaces an existing target atomically
+	if (::rename(_path.c_str(), target.getPath().c_str()) != 0)
+		return false;
+
+	setFlags();
+	return true;
+}
+
 namespace Posix {
 
 bool assureDirectoryExists(const Common::String &dir, const char *prefix) {
@@ -26,6 +26,7 @@
 #define FORBIDDEN_SYMBOL_ALLOW_ALL
 
 #include "backends/fs/windows/windows-fs.h"
+#include "backends/fs/mappedfilestream.h"
 #include "backends/fs/stdiostream.h"
 
 // F_OK, R_OK and W_OK are not defined under MSVC, so we define them here
@@ -55,6 +56,18 @@ bool WindowsFilesystemNode::isWritable() const {
 	return _taccess(charToTchar(_path.c_str()), W_OK) == 0;
 }
 
+bool WindowsFilesystemNode::getFileStats(int64 &size, int64 &modificationTime) const {
+	WIN32_FILE_ATTRIBUTE_DATA data;
+
+	if (!GetFileAttributesEx(charToTchar(_path.c_str()), GetFileExInfoStandard, &data) ||
+		(data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+		return false;
+
+	size = ((int64)data.nFileSizeHigh << 32) | data.nFileSizeLow;
+	modificationTime = ((int64)data.ftLastWriteTime.dwHighDateTime << 32) | data.ftLastWriteTime.dwLowDateTime;
+	return true;
+}
+
 void WindowsFilesystemNode::addFile(AbstractFSList &list, ListMode mode, const char *base, bool hidden, WIN32_FIND_DATA* find_data) {
 	// Skip local directory (.) and parent (..)
 	if (!_tcscmp(find_data->cFileName, TEXT(".")) ||
@@ -231,6 +244,9 @@ AbstractFSNode *WindowsFilesystemNode::getParent() const {
 }
 
 Common::SeekableReadStream *WindowsFilesystemNode::createReadStream() {
+	Common::SeekableReadStream *stream = MappedFileStream::makeFromPath(getPath());
+	if (stream)
+		return stream;
 	return StdioStream::makeFromPath(getPath(), false);
 }
 
@@ -245,4 +261,18 @@ bool WindowsFilesystemNode::createDirectory() {
 	return _isValid && _isDirectory;
 }
 
+bool WindowsFilesystemNode::renameTo(const AbstractFSNode &target) {
+	// charToTchar() returns a static buffer in Unicode builds
+	TCHAR source[MAX_PATH];
+	_tcsncpy(source, charToTchar(_path.c_str()), MAX_PATH - 1);
+	source[MAX_PATH - 1] = 0;
+
+	// Unlike rename(), MoveFileEx() can replace an existing file
+	if (!MoveFileEx(source, charToTchar(target.getPath().c_str()), MOVEFILE_REPLACE_EXISTING))
+		return false;
+
+	setFlags();
+	return true;
+}
+
 #endif //#ifdef WIN32
@@ -73,6 +73,7 @@ public:
 	virtual bool isDirectory() const override { return _isDirectory; }
 	virtual bool isReadable() const override;
 	virtual bool isWritable() const override;
+	virtual bool getFileStats(int64 &size, int64 &modificationTime) const override;
 
 	virtual AbstractFSNode *getChild(const Common::String &n) const override;
 	virtual bool getChildren(AbstractFSList &list, ListMode mode, bool hidden) const override;
@@ -81,6 +82,8 @@ public:
 	virtual Common::SeekableReadStream *createReadStream() override;
 	virtual Common::WriteStream *createWriteStream() override;
 	virtual bool createDirectory() override;
+	virtual bool canRename() const override { return true; }
+	virtual bool renameTo(const AbstractFSNode &target) override;
 
 private:
 	/**
@@ -27,6 +27,8 @@
 
 class NullGraphicsManager : public GraphicsManager {
 public:
+	NullGraphicsManager() : _width(0), _height(0), _format(Graphics::PixelFormat::createFormatCLUT8()),
+		_overlayVisible(false), _copyRectToScreenBytes(0), _updateScreenCalls(0) {}
 	virtual ~NullGraphicsManager() {}
 
 	bool hasFeature(OSystem::Feature f) const override { return false; }
@@ -63,11 +65,13 @@ public:
 	int16 getWidth() const override { return _width; }
 	void setPalette(const byte *colors, uint start, uint num) override {}
 	void grabPalette(byte *colors, uint start, uint num) const override {}
-	void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) override {}
+	void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) override {
+		_copyRectToScreenBytes += (uint64)w * h * _format.bytesPerPixel;
+	}
 	Graphics::Surface *lockScreen() override { return NULL; }
 	void unlockScreen() override {}
 	void fillScreen(uint32 col) override {}
-	void updateScreen() override {}
+	void updateScreen() override { _updateScreenCalls++; }
 	void setShakePos(int shakeXOffset, int shakeYOffset) override {}
 	void setFocusRectangle(const Common::Rect& rect) override {}
 	void clearFocusRectangle() override {}
@@ -87,10 +91,17 @@ public:
 	void setMouseCursor(const void *buf, uint w, uint h, int hotspotX, int hotspotY, uint32 keycolor, bool dontScale = false, const Graphics::PixelFormat *format = NULL) override {}
 	void setCursorPalette(const byte *colors, uint start, uint num) override {}
 
+	/** The amount of pixel data passed to copyRectToScreen so far. */
+	uint64 getCopyRectToScreenBytes() const { return _copyRectToScreenBytes; }
+	/** The number of updateScreen calls so far. */
+	uint32 getUpdateScreenCalls() const { return _updateScreenCalls; }
+
 private:
 	uint _width, _height;
 	Graphics::PixelFormat _format;
 	bool _overlayVisible;
+	uint64 _copyRectToScreenBytes;
+	uint32 _updateScreenCalls;
 };
 
 #endif
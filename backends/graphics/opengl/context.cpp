@@ -43,6 +43,8 @@ void Context::reset() {
 	framebufferObjectSupported = false;
 	packedPixelsSupported = false;
 	textureEdgeClampSupported = false;
+	pixelBufferObjectSupported = false;
+	unpackSubImageSupported = false;
 
 #define GL_FUNC_DEF(ret, name, param) name = nullptr;
 #include "backends/graphics/opengl/opengl-func.h"
@@ -162,6 +164,10 @@ void OpenGLGraphicsManager::initializeGLContext() {
 			g_context.packedPixelsSupported = true;
 		} else if (token == "GL_SGIS_texture_edge_clamp") {
 			g_context.textureEdgeClampSupported = true;
+		} else if (token == "GL_ARB_pixel_buffer_object" || token == "GL_EXT_pixel_buffer_object" || token == "GL_NV_pixel_buffer_object") {
+			g_context.pixelBufferObjectSupported = true;
+		} else if (token == "GL_EXT_unpack_subimage") {
+			g_context.unpackSubImageSupported = true;
 		}
 	}
 
@@ -187,6 +193,22 @@ void OpenGLGraphicsManager::initializeGLContext() {
 		g_context.textureEdgeClampSupported = true;
 	}
 
+	// OpenGL 2.1 and OpenGL ES 3.0 always have pixel buffer objects. They
+	// are of no use for GLES1, and would need the buffer functions anyway.
+	if ((g_context.type == kContextGL && g_context.isGLVersionOrHigher(2, 1)) ||
+	    (g_context.type == kContextGLES2 && g_context.isGLVersionOrHigher(3, 0))) {
+		g_context.pixelBufferObjectSupported = true;
+	} else if (g_context.type == kContextGLES) {
+		g_context.pixelBufferObjectSupported = false;
+	}
+
+	// OpenGL always has GL_UNPACK_ROW_LENGTH, OpenGL ES since 3.0
+	if (g_context.type == kContextGL || (g_context.type == kContextGLES2 && g_context.isGLVersionOrHigher(3, 0))) {
+		g_context.unpackSubImageSupported = true;
+	} else if (g_context.type == kContextGLES) {
+		g_context.unpackSubImageSupported = false;
+	}
+
 	// Log context type.
 	switch (g_context.type) {
 	case kContextGL:
@@ -213,6 +235,8 @@ void OpenGLGraphicsManager::initializeGLContext() {
 	debug(5, "OpenGL: FBO support: %d", g_context.framebufferObjectSupported);
 	debug(5, "OpenGL: Packed pixels support: %d", g_context.packedPixelsSupported);
 	debug(5, "OpenGL: Texture edge clamping support: %d", g_context.textureEdgeClampSupported);
+	debug(5, "OpenGL: Pixel buffer object support: %d", g_context.pixelBufferObjectSupported);
+	debug(5, "OpenGL: Unpack sub image support: %d", g_context.unpackSubImageSupported);
 }
 
 } // End of namespace OpenGL
@@ -23,6 +23,7 @@
 #include "backends/graphics/opengl/debug.h"
 #include "backends/graphics/opengl/opengl-sys.h"
 
+#include "common/debug.h"
 #include "common/str.h"
 #include "common/textconsole.h"
 
@@ -51,6 +52,7 @@ Common::String getGLErrStr(GLenum error) {
 
 	return Common::String::format("(Unknown GL error code 0x%X)", error);
 }
+
 } // End of anonymous namespace
 
 void checkGLError(const char *expr, const char *file, int line) {
@@ -62,6 +64,33 @@ void checkGLError(const char *expr, const char *file, int line) {
 		warning("GL ERROR: %s on %s (%s:%d)", getGLErrStr(error).c_str(), expr, file, line);
 	}
 }
+
 } // End of namespace OpenGL
 
 #endif
+
+namespace OpenGL {
+
+namespace {
+uint g_frameUploadBytes = 0;
+uint g_frameUploads = 0;
+} // End of anonymous namespace
+
+void countUpload(uint bytes) {
+	g_frameUploadBytes += bytes;
+	++g_frameUploads;
+}
+
+uint finishFrameUploads() {
+#ifdef OPENGL_DEBUG
+	if (g_frameUploads) {
+		debug(6, "OpenGL: Uploaded %u bytes of texture data in %u calls", g_frameUploadBytes, g_frameUploads);
+	}
+#endif
+
+	const uint bytes = g_frameUploadBytes;
+	g_frameUploadBytes = 0;
+	g_frameUploads = 0;
+	return bytes;
+}
+} // End of namespace OpenGL
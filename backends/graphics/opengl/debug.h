@@ -23,8 +23,28 @@
 #ifndef BACKENDS_GRAPHICS_OPENGL_DEBUG_H
 #define BACKENDS_GRAPHICS_OPENGL_DEBUG_H
 
+#include "common/scummsys.h"
+
 #define OPENGL_DEBUG
 
+namespace OpenGL {
+/**
+ * Count the bytes of a texture upload in the current frame.
+ */
+void countUpload(uint bytes);
+
+/**
+ * Start counting the texture uploads of a new frame. When debugging, the
+ * uploads of the finished frame are logged.
+ *
+ * @return The bytes uploaded in the finished frame.
+ */
+uint finishFrameUploads();
+} // End of namespace OpenGL
+
+#define GL_COUNT_UPLOAD(bytes) OpenGL::countUpload(bytes)
+#define GL_FINISH_FRAME_UPLOADS() OpenGL::finishFrameUploads()
+
 #ifdef OPENGL_DEBUG
 
 namespace OpenGL {
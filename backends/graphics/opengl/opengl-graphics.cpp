@@ -25,6 +25,7 @@
 #include "backends/graphics/opengl/texture.h"
 #include "backends/graphics/opengl/pipelines/pipeline.h"
 #include "backends/graphics/opengl/pipelines/fixed.h"
+#include "backends/graphics/opengl/pipelines/scaler.h"
 #include "backends/graphics/opengl/pipelines/shader.h"
 #include "backends/graphics/opengl/shader.h"
 
@@ -41,6 +42,7 @@
 #endif
 
 #include "graphics/conversion.h"
+#include "graphics/scalerplugin.h"
 #ifdef USE_OSD
 #include "graphics/fontman.h"
 #include "graphics/font.h"
@@ -58,7 +60,7 @@ namespace OpenGL {
 
 OpenGLGraphicsManager::OpenGLGraphicsManager()
 	: _currentState(), _oldState(), _transactionMode(kTransactionNone), _screenChangeID(1 << (sizeof(int) * 8 - 2)),
-	  _pipeline(nullptr), _stretchMode(STRETCH_FIT),
+	  _pipeline(nullptr), _scalerPipeline(nullptr), _stretchMode(STRETCH_FIT),
 	  _defaultFormat(), _defaultFormatAlpha(),
 	  _gameScreen(nullptr), _overlay(nullptr),
 	  _cursor(nullptr),
@@ -67,11 +69,12 @@ OpenGLGraphicsManager::OpenGLGraphicsManager()
 	  _cursorKeyColor(0), _cursorDontScale(false), _cursorPaletteEnabled(false)
 #ifdef USE_OSD
 	  , _osdMessageChangeRequest(false), _osdMessageAlpha(0), _osdMessageFadeStartTime(0), _osdMessageSurface(nullptr),
-	  _osdIconSurface(nullptr)
+	  _osdIconSurface(nullptr), _performanceHudSurface(nullptr)
 #endif
 	{
 	memset(_gamePalette, 0, sizeof(_gamePalette));
 	g_context.reset();
+	_currentState.scalerIndex = getDefaultScaler();
 }
 
 OpenGLGraphicsManager::~OpenGLGraphicsManager() {
@@ -81,6 +84,7 @@ OpenGLGraphicsManager::~OpenGLGraphicsManager() {
 #ifdef USE_OSD
 	delete _osdMessageSurface;
 	delete _osdIconSurface;
+	delete _performanceHudSurface;
 #endif
 #if !USE_FORCED_GLES
 	ShaderManager::destroy();
@@ -98,6 +102,11 @@ bool OpenGLGraphicsManager::hasFeature(OSystem::Feature f) const {
 	case OSystem::kFeatureOverlaySupportsAlpha:
 		return _defaultFormatAlpha.aBits() > 3;
 
+#if !USE_FORCED_GLES
+	case OSystem::kFeatureScalers:
+		return g_context.shadersSupported;
+#endif
+
 	default:
 		return false;
 	}
@@ -287,6 +296,102 @@ int OpenGLGraphicsManager::getStretchMode() const {
 	return _stretchMode;
 }
 
+namespace {
+
+const char *getScalerName(uint mode) {
+	const PluginList &scalerPlugins = ScalerMan.getPlugins();
+	if (mode >= scalerPlugins.size()) {
+		return nullptr;
+	}
+	return scalerPlugins[mode]->get<ScalerPluginObject>().getName();
+}
+
+#if !USE_FORCED_GLES
+/**
+ * Return the shader implementing the given scaler, or kMaxUsages when there
+ * is none.
+ */
+ShaderManager::ShaderUsage getScalerShader(const char *name) {
+	if (!strcmp(name, "advmame")) {
+		return ShaderManager::kAdvMame;
+	} else if (!strcmp(name, "hq")) {
+		return ShaderManager::kHQ;
+	}
+	return ShaderManager::kMaxUsages;
+}
+#endif
+
+bool isScalerSupported(const char *name) {
+	if (!strcmp(name, "normal")) {
+		return true;
+	}
+#if !USE_FORCED_GLES
+	return getScalerShader(name) != ShaderManager::kMaxUsages;
+#else
+	return false;
+#endif
+}
+
+} // End of anonymous namespace
+
+uint OpenGLGraphicsManager::getDefaultScaler() const {
+	return ScalerMan.findScalerPluginIndex("normal");
+}
+
+uint OpenGLGraphicsManager::getDefaultScaleFactor() const {
+	return 2;
+}
+
+bool OpenGLGraphicsManager::setScaler(uint mode, int factor) {
+	assert(_transactionMode != kTransactionNone);
+
+	const char *name = getScalerName(mode);
+	if (!name || !isScalerSupported(name)) {
+		warning("OpenGLGraphicsManager::setScaler(%u): Scaler not supported", mode);
+		return false;
+	}
+
+	ScalerPluginObject &scaler = ScalerMan.getPlugins()[mode]->get<ScalerPluginObject>();
+	int newFactor;
+	if (factor == -1)
+		newFactor = getDefaultScaleFactor();
+	else if (scaler.hasFactor(factor))
+		newFactor = factor;
+	else if (scaler.hasFactor(_currentState.scaleFactor))
+		newFactor = _currentState.scaleFactor;
+	else
+		newFactor = scaler.getFactor();
+
+	_currentState.scalerIndex = mode;
+	_currentState.scaleFactor = newFactor;
+	return true;
+}
+
+uint OpenGLGraphicsManager::getScaler() const {
+	return _currentState.scalerIndex;
+}
+
+void OpenGLGraphicsManager::updateScalerPipeline() {
+	delete _scalerPipeline;
+	_scalerPipeline = nullptr;
+
+#if !USE_FORCED_GLES
+	if (!g_context.shadersSupported) {
+		return;
+	}
+
+	const char *name = getScalerName(_currentState.scalerIndex);
+	const ShaderManager::ShaderUsage shader = name ? getScalerShader(name) : ShaderManager::kMaxUsages;
+	if (shader == ShaderManager::kMaxUsages) {
+		return;
+	}
+
+	_scalerPipeline = new ScalerPipeline(ShaderMan.query(shader), _currentState.scaleFactor);
+	_scalerPipeline->setColor(1.0f, 1.0f, 1.0f, 1.0f);
+	_scalerPipeline->setFramebuffer(&_backBuffer);
+#endif
+}
+
 void OpenGLGraphicsManager::beginGFXTransaction() {
 	assert(_transactionMode == kTransactionNone);
 
@@ -419,6 +524,7 @@ OSystem::TransactionError OpenGLGraphicsManager::endGFXTransaction() {
 	// aspect ratio correction and game screen changes correctly.
 	recalculateDisplayAreas();
 	recalculateCursorScaling();
+	updateScalerPipeline();
 
 	// Something changed, so update the screen change ID.
 	++_screenChangeID;
@@ -478,6 +584,8 @@ void OpenGLGraphicsManager::updateScreen() {
 	if (_osdIconSurface) {
 		_osdIconSurface->updateGLTexture();
 	}
+
+	updatePerformanceHudSurface();
 #endif
 
 	// If there's an active debugger, update it
@@ -518,8 +626,15 @@ void OpenGLGraphicsManager::updateScreen() {
 	// Alpha blending is disabled when drawing the screen
 	_backBuffer.enableBlend(Framebuffer::kBlendModeDisabled);
 
-	// First step: Draw the (virtual) game screen.
-	g_context.getActivePipeline()->drawTexture(_gameScreen->getGLTexture(), _gameDrawRect.left, _gameDrawRect.top, _gameDrawRect.width(), _gameDrawRect.height());
+	// First step: Draw the (virtual) game screen, through the scaler shader
+	// if one is selected.
+	if (_scalerPipeline) {
+		Pipeline *oldPipeline = g_context.setPipeline(_scalerPipeline);
+		_scalerPipeline->drawTexture(_gameScreen->getGLTexture(), _gameDrawRect.left, _gameDrawRect.top, _gameDrawRect.width(), _gameDrawRect.height());
+		g_context.setPipeline(oldPipeline);
+	} else {
+		g_context.getActivePipeline()->drawTexture(_gameScreen->getGLTexture(), _gameDrawRect.left, _gameDrawRect.top, _gameDrawRect.width(), _gameDrawRect.height());
+	}
 
 	// Second step: Draw the overlay if visible.
 	if (_overlayVisible) {
@@ -545,7 +660,7 @@ void OpenGLGraphicsManager::updateScreen() {
 
 #ifdef USE_OSD
 	// Fourth step: Draw the OSD.
-	if (_osdMessageSurface || _osdIconSurface) {
+	if (_osdMessageSurface || _osdIconSurface || _performanceHudSurface) {
 		_backBuffer.enableBlend(Framebuffer::kBlendModeTraditionalTransparency);
 	}
 
@@ -589,11 +704,20 @@ void OpenGLGraphicsManager::updateScreen() {
 		g_context.getActivePipeline()->drawTexture(_osdIconSurface->getGLTexture(),
 		                                           dstX, dstY, _osdIconSurface->getWidth(), _osdIconSurface->getHeight());
 	}
+
+	if (_performanceHudSurface) {
+		// Draw the performance statistics texture.
+		g_context.getActivePipeline()->drawTexture(_performanceHudSurface->getGLTexture(),
+		                                           PerformanceHud::kLeftMargin, PerformanceHud::kTopMargin,
+		                                           _performanceHudSurface->getWidth(), _performanceHudSurface->getHeight());
+	}
 #endif
 
 	_cursorNeedsRedraw = false;
 	_forceRedraw = false;
+	const uint uploadedBytes = GL_FINISH_FRAME_UPLOADS();
 	refreshScreen();
+	_performanceHud.framePresented(uploadedBytes);
 }
 
 Graphics::Surface *OpenGLGraphicsManager::lockScreen() {
@@ -870,6 +994,37 @@ void OpenGLGraphicsManager::osdMessageUpdateSurface() {
 }
 #endif
 
+void OpenGLGraphicsManager::updatePerformanceHudSurface() {
+	if (!_performanceHud.isVisible()) {
+		if (_performanceHudSurface) {
+			delete _performanceHudSurface;
+			_performanceHudSurface = nullptr;
+		}
+		return;
+	}
+
+	if (!_performanceHud.update(getFontOSD(), _defaultFormatAlpha)) {
+		return;
+	}
+
+	const Graphics::Surface &hud = _performanceHud.getSurface();
+	if (!_performanceHudSurface) {
+		_performanceHudSurface = createSurface(_defaultFormatAlpha);
+		assert(_performanceHudSurface);
+		_performanceHudSurface->enableLinearFiltering(true);
+	}
+
+	if (_performanceHudSurface->getWidth() != (uint)hud.w || _performanceHudSurface->getHeight() != (uint)hud.h) {
+		_performanceHudSurface->allocate(hud.w, hud.h);
+	}
+
+	_performanceHudSurface->copyRectToTexture(0, 0, hud.w, hud.h, hud.getPixels(), hud.pitch);
+	_performanceHudSurface->updateGLTexture();
+
+	// Show the new statistics even if nothing else changed
+	_forceRedraw = true;
+}
+
 void OpenGLGraphicsManager::displayActivityIconOnOSD(const Graphics::Surface *icon) {
 #ifdef USE_OSD
 	if (_osdIconSurface) {
@@ -1014,6 +1169,7 @@ void OpenGLGraphicsManager::notifyContextCreate(const Graphics::PixelFormat &def
 	_backBuffer.setClearColor(0.0f, 0.0f, 0.0f, 0.0f);
 
 	g_context.getActivePipeline()->setFramebuffer(&_backBuffer);
+	updateScalerPipeline();
 
 	// We use a "pack" alignment (when reading from textures) to 4 here,
 	// since the only place where we really use it is the BMP screenshot
@@ -1051,6 +1207,10 @@ void OpenGLGraphicsManager::notifyContextCreate(const Graphics::PixelFormat &def
 	if (_osdIconSurface) {
 		_osdIconSurface->recreate();
 	}
+
+	if (_performanceHudSurface) {
+		_performanceHudSurface->recreate();
+	}
 #endif
 }
 
@@ -1075,8 +1235,15 @@ void OpenGLGraphicsManager::notifyContextDestroy() {
 	if (_osdIconSurface) {
 		_osdIconSurface->destroy();
 	}
+
+	if (_performanceHudSurface) {
+		_performanceHudSurface->destroy();
+	}
 #endif
 
+	delete _scalerPipeline;
+	_scalerPipeline = nullptr;
+
 #if !USE_FORCED_GLES
 	if (g_context.shadersSupported) {
 		ShaderMan.notifyDestroy();
@@ -79,6 +79,11 @@ public:
 	virtual bool setStretchMode(int mode) override;
 	virtual int getStretchMode() const override;
 
+	virtual uint getDefaultScaler() const override;
+	virtual uint getDefaultScaleFactor() const override;
+	virtual bool setScaler(uint mode, int factor) override;
+	virtual uint getScaler() const override;
+
 	virtual void beginGFXTransaction() override;
 	virtual OSystem::TransactionError endGFXTransaction() override;
 
@@ -173,7 +178,8 @@ protected:
 #ifdef USE_RGB_COLOR
 		    gameFormat(),
 #endif
-		    aspectRatioCorrection(false), graphicsMode(GFX_OPENGL), filtering(true) {
+		    aspectRatioCorrection(false), graphicsMode(GFX_OPENGL), filtering(true),
+		    scalerIndex(0), scaleFactor(1) {
 		}
 
 		bool valid;
@@ -186,6 +192,9 @@ protected:
 		int graphicsMode;
 		bool filtering;
 
+		uint scalerIndex;
+		int scaleFactor;
+
 		bool operator==(const VideoState &right) {
 			return gameWidth == right.gameWidth && gameHeight == right.gameHeight
 #ifdef USE_RGB_COLOR
@@ -193,7 +202,9 @@ protected:
 #endif
 			    && aspectRatioCorrection == right.aspectRatioCorrection
 			    && graphicsMode == right.graphicsMode
-				&& filtering == right.filtering;
+				&& filtering == right.filtering
+			    && scalerIndex == right.scalerIndex
+			    && scaleFactor == right.scaleFactor;
 		}
 
 		bool operator!=(const VideoState &right) {
@@ -288,6 +299,17 @@ private:
 	 */
 	Pipeline *_pipeline;
 
+	/**
+	 * Pipeline drawing the game screen through the selected scaler's shader,
+	 * or nullptr when the game screen is drawn by _pipeline.
+	 */
+	Pipeline *_scalerPipeline;
+
+	/**
+	 * Set up _scalerPipeline for the current scaler.
+	 */
+	void updateScalerPipeline();
+
 protected:
 	/**
 	 * Query the address of an OpenGL function by name.
@@ -473,6 +495,16 @@ private:
 		kOSDIconTopMargin = 10,
 		kOSDIconRightMargin = 10
 	};
+
+	/**
+	 * The performance statistics' contents.
+	 */
+	Surface *_performanceHudSurface;
+
+	/**
+	 * Update the performance statistics surface when the statistics changed.
+	 */
+	void updatePerformanceHudSurface();
 #endif
 };
 
@@ -0,0 +1,44 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "backends/graphics/opengl/pipelines/scaler.h"
+#include "backends/graphics/opengl/shader.h"
+
+namespace OpenGL {
+
+#if !USE_FORCED_GLES
+ScalerPipeline::ScalerPipeline(Shader *shader, uint scaleFactor)
+	: ShaderPipeline(shader) {
+	shader->setUniform("scaleFactor", new ShaderUniformFloat(scaleFactor));
+}
+
+void ScalerPipeline::drawTexture(const GLTexture &texture, const GLfloat *coordinates) {
+	// The shader works on whole texels, so it needs to know the size of the
+	// texture and of the area actually in use.
+	_activeShader->setUniform("textureSize", new ShaderUniformVec2(texture.getWidth(), texture.getHeight()));
+	_activeShader->setUniform("logicalSize", new ShaderUniformVec2(texture.getLogicalWidth(), texture.getLogicalHeight()));
+
+	ShaderPipeline::drawTexture(texture, coordinates);
+}
+#endif // !USE_FORCED_GLES
+
+} // End of namespace OpenGL
@@ -77,6 +77,162 @@ const char *const g_lookUpFragmentShader =
 	"\tgl_FragColor = blendColor * texture2D(palette, vec2(index.a * adjustFactor, 0.0));\n"
 	"}\n";
 
+// Common part of the scaler shaders. The output pixel is split into a grid of
+// scaleFactor x scaleFactor cells per source texel, like the CPU scalers do.
+const char *const g_scalerFragmentShader =
+	"varying vec2 texCoord;\n"
+	"varying vec4 blendColor;\n"
+	"\n"
+	"uniform sampler2D shaderTexture;\n"
+	"uniform vec2 textureSize;\n"
+	"uniform vec2 logicalSize;\n"
+	"uniform float scaleFactor;\n"
+	"\n"
+	"vec4 texel(vec2 pos) {\n"
+	"\tpos = clamp(pos, vec2(0.0), logicalSize - 1.0);\n"
+	"\treturn texture2D(shaderTexture, (pos + 0.5) / textureSize);\n"
+	"}\n"
+	"\n"
+	"vec4 scale(vec2 pos, vec2 cell);\n"
+	"\n"
+	"void main(void) {\n"
+	"\tvec2 pos = texCoord * textureSize;\n"
+	"\tvec2 center = floor(pos);\n"
+	"\tvec2 cell = min(floor((pos - center) * scaleFactor), scaleFactor - 1.0);\n"
+	"\tgl_FragColor = blendColor * scale(center, cell);\n"
+	"}\n";
+
+// Port of graphics/scaler/scale2x.cpp and scale3x.cpp. AdvMame4x applies
+// Scale2x twice, like scalebit.cpp does.
+const char *const g_advMameFragmentShader =
+	"vec4 scale2xRule(vec4 e, vec4 p, vec4 q, vec4 pOpposite, vec4 qOpposite) {\n"
+	"\treturn (p == q && p != pOpposite && q != qOpposite) ? p : e;\n"
+	"}\n"
+	"\n"
+	"vec4 scale2x(vec2 pos, vec2 dir) {\n"
+	"\treturn scale2xRule(texel(pos),\n"
+	"\t                   texel(pos + vec2(dir.x, 0.0)), texel(pos + vec2(0.0, dir.y)),\n"
+	"\t                   texel(pos - vec2(dir.x, 0.0)), texel(pos - vec2(0.0, dir.y)));\n"
+	"}\n"
+	"\n"
+	"vec4 scale2xAt(vec2 pos2) {\n"
+	"\tvec2 pos = floor(pos2 * 0.5);\n"
+	"\treturn scale2x(pos, (pos2 - pos * 2.0) * 2.0 - 1.0);\n"
+	"}\n"
+	"\n"
+	"vec4 scale3x(vec2 pos, vec2 cell) {\n"
+	"\tvec4 e = texel(pos);\n"
+	"\tif (texel(pos - vec2(0.0, 1.0)) == texel(pos + vec2(0.0, 1.0))\n"
+	"\t    || texel(pos - vec2(1.0, 0.0)) == texel(pos + vec2(1.0, 0.0))) {\n"
+	"\t\treturn e;\n"
+	"\t}\n"
+	"\n"
+	"\tvec2 dir = cell - 1.0;\n"
+	"\tif (dir.x != 0.0 && dir.y != 0.0) {\n"
+	"\t\tvec4 p = texel(pos + vec2(dir.x, 0.0));\n"
+	"\t\treturn p == texel(pos + vec2(0.0, dir.y)) ? p : e;\n"
+	"\t} else if (dir.x == 0.0 && dir.y == 0.0) {\n"
+	"\t\treturn e;\n"
+	"\t}\n"
+	"\n"
+	"\t// Edge cells look at the neighbour they face, the two neighbours\n"
+	"\t// beside it and the two corners next to it.\n"
+	"\tvec2 side = abs(dir.yx);\n"
+	"\tvec4 n = texel(pos + dir);\n"
+	"\tif ((texel(pos - side) == n && e != texel(pos + dir + side))\n"
+	"\t    || (texel(pos + side) == n && e != texel(pos + dir - side))) {\n"
+	"\t\treturn n;\n"
+	"\t}\n"
+	"\treturn e;\n"
+	"}\n"
+	"\n"
+	"vec4 scale(vec2 pos, vec2 cell) {\n"
+	"\tif (scaleFactor == 3.0) {\n"
+	"\t\treturn scale3x(pos, cell);\n"
+	"\t} else if (scaleFactor == 4.0) {\n"
+	"\t\tvec2 pos2 = pos * 2.0 + floor(cell * 0.5);\n"
+	"\t\tvec2 dir = mod(cell, 2.0) * 2.0 - 1.0;\n"
+	"\t\treturn scale2xRule(scale2xAt(pos2),\n"
+	"\t\t                   scale2xAt(pos2 + vec2(dir.x, 0.0)), scale2xAt(pos2 + vec2(0.0, dir.y)),\n"
+	"\t\t                   scale2xAt(pos2 - vec2(dir.x, 0.0)), scale2xAt(pos2 - vec2(0.0, dir.y)));\n"
+	"\t}\n"
+	"\treturn scale2x(pos, cell * 2.0 - 1.0);\n"
+	"}\n";
+
+// Follows graphics/scaler/hq.cpp: neighbours are compared in YUV with the
+// same thresholds, and cells are blended with the same weights. Instead of
+// the full table of 256 neighbourhood patterns, each cell only looks at the
+// neighbours next to it.
+const char *const g_hqFragmentShader =
+	"vec3 yuv(vec4 color) {\n"
+	"\tvec3 rgb = color.rgb * 255.0;\n"
+	"\treturn vec3((rgb.r + rgb.g + rgb.b) * 0.25, (rgb.r - rgb.b) * 0.25, (2.0 * rgb.g - rgb.r - rgb.b) * 0.125);\n"
+	"}\n"
+	"\n"
+	"bool diff(vec4 a, vec4 b) {\n"
+	"\treturn any(greaterThan(abs(yuv(a) - yuv(b)), vec3(48.0, 7.0, 6.0)));\n"
+	"}\n"
+	"\n"
+	"vec4 interpolate(vec4 a, vec4 b, vec4 c, vec3 weights) {\n"
+	"\treturn (a * weights.x + b * weights.y + c * weights.z) / (weights.x + weights.y + weights.z);\n"
+	"}\n"
+	"\n"
+	"vec4 corner(vec2 pos, vec4 e, vec2 dir) {\n"
+	"\tvec4 p = texel(pos + vec2(dir.x, 0.0));\n"
+	"\tvec4 q = texel(pos + vec2(0.0, dir.y));\n"
+	"\tvec4 c = texel(pos + dir);\n"
+	"\tbool diffP = diff(e, p);\n"
+	"\tbool diffQ = diff(e, q);\n"
+	"\n"
+	"\tif (!diffP && !diffQ) {\n"
+	"\t\treturn interpolate(e, p, q, vec3(2.0, 1.0, 1.0));\n"
+	"\t} else if (diffP != diffQ) {\n"
+	"\t\tif (scaleFactor == 2.0) {\n"
+	"\t\t\treturn interpolate(e, c, diffP ? q : p, vec3(2.0, 1.0, 1.0));\n"
+	"\t\t}\n"
+	"\t\treturn mix(e, c, 0.25);\n"
+	"\t} else if (diff(p, q)) {\n"
+	"\t\treturn diff(e, c) ? e : mix(e, c, 0.25);\n"
+	"\t}\n"
+	"\n"
+	"\t// The neighbours on both sides continue an edge across this corner.\n"
+	"\tbool isolated = diff(e, texel(pos - vec2(dir.x, 0.0))) && diff(e, texel(pos - vec2(0.0, dir.y)));\n"
+	"\tif (scaleFactor == 2.0) {\n"
+	"\t\treturn interpolate(e, p, q, isolated ? vec3(14.0, 1.0, 1.0) : vec3(2.0, 1.0, 1.0));\n"
+	"\t}\n"
+	"\treturn interpolate(e, p, q, isolated ? vec3(2.0, 1.0, 1.0) : vec3(2.0, 7.0, 7.0));\n"
+	"}\n"
+	"\n"
+	"vec4 edge(vec2 pos, vec4 e, vec2 dir) {\n"
+	"\tvec4 n = texel(pos + dir);\n"
+	"\tif (!diff(e, n)) {\n"
+	"\t\treturn mix(e, n, 0.25);\n"
+	"\t}\n"
+	"\n"
+	"\tvec2 side = abs(dir.yx);\n"
+	"\tvec4 l = texel(pos - side);\n"
+	"\tvec4 r = texel(pos + side);\n"
+	"\tif ((diff(e, l) && !diff(n, l)) || (diff(e, r) && !diff(n, r))) {\n"
+	"\t\treturn mix(e, n, 0.125);\n"
+	"\t}\n"
+	"\treturn e;\n"
+	"}\n"
+	"\n"
+	"vec4 scale(vec2 pos, vec2 cell) {\n"
+	"\tvec4 e = texel(pos);\n"
+	"\tif (scaleFactor == 2.0) {\n"
+	"\t\treturn corner(pos, e, cell * 2.0 - 1.0);\n"
+	"\t}\n"
+	"\n"
+	"\tvec2 dir = cell - 1.0;\n"
+	"\tif (dir.x != 0.0 && dir.y != 0.0) {\n"
+	"\t\treturn corner(pos, e, dir);\n"
+	"\t} else if (dir.x != 0.0 || dir.y != 0.0) {\n"
+	"\t\treturn edge(pos, e, dir);\n"
+	"\t}\n"
+	"\treturn e;\n"
+	"}\n";
+
 
 // Taken from: https://en.wikibooks.org/wiki/OpenGL_Programming/Modern_OpenGL_Tutorial_03#OpenGL_ES_2_portability
 const char *const g_precisionDefines =
@@ -104,6 +260,10 @@ void ShaderUniformFloat::set(GLint location) const {
 	GL_CALL(glUniform1f(location, _value));
 }
 
+void ShaderUniformVec2::set(GLint location) const {
+	GL_CALL(glUniform2f(location, _x, _y));
+}
+
 void ShaderUniformMatrix44::set(GLint location) const {
 	GL_CALL(glUniformMatrix4fv(location, 1, GL_FALSE, _matrix));
 }
@@ -312,6 +472,8 @@ void ShaderManager::notifyCreate() {
 		_builtIn[kDefault] = new Shader(g_defaultVertexShader, g_defaultFragmentShader);
 		_builtIn[kCLUT8LookUp] = new Shader(g_defaultVertexShader, g_lookUpFragmentShader);
 		_builtIn[kCLUT8LookUp]->setUniform1I("palette", 1);
+		_builtIn[kAdvMame] = new Shader(g_defaultVertexShader, Common::String(g_scalerFragmentShader) + g_advMameFragmentShader);
+		_builtIn[kHQ] = new Shader(g_defaultVertexShader, Common::String(g_scalerFragmentShader) + g_hqFragmentShader);
 
 		for (uint i = 0; i < kMaxUsages; ++i) {
 			_builtIn[i]->setUniform1I("shaderTexture", 0);
@@ -77,6 +77,16 @@ private:
 /**
  * 4x4 Matrix value for a shader uniform.
  */
+class ShaderUniformVec2 : public ShaderUniformValue {
+public:
+	ShaderUniformVec2(GLfloat x, GLfloat y) : _x(x), _y(y) {}
+
+	virtual void set(GLint location) const override;
+
+private:
+	const GLfloat _x, _y;
+};
+
 class ShaderUniformMatrix44 : public ShaderUniformValue {
 public:
 	ShaderUniformMatrix44(const GLfloat *mat44) {
@@ -249,6 +259,12 @@ public:
 		/** CLUT8 look up shader. */
 		kCLUT8LookUp,
 
+		/** AdvMame (Scale2x, Scale3x and Scale4x) scaler shader. */
+		kAdvMame,
+
+		/** HQ (HQ2x and HQ3x) scaler shader. */
+		kHQ,
+
 		/** Number of built-in shaders. Should not be used for query. */
 		kMaxUsages
 	};
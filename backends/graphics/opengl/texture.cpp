@@ -39,12 +39,17 @@ GLTexture::GLTexture(GLenum glIntFormat, GLenum glFormat, GLenum glType)
 	: _glIntFormat(glIntFormat), _glFormat(glFormat), _glType(glType),
 	  _width(0), _height(0), _logicalWidth(0), _logicalHeight(0),
 	  _texCoords(), _glFilter(GL_NEAREST),
-	  _glTexture(0) {
+	  _glTexture(0), _pixelBuffers(), _nextPixelBuffer(0) {
 	create();
 }
 
 GLTexture::~GLTexture() {
 	GL_CALL_SAFE(glDeleteTextures, (1, &_glTexture));
+#if !USE_FORCED_GLES
+	if (_pixelBuffers[0]) {
+		GL_CALL_SAFE(glDeleteBuffers, (kPixelBufferCount, _pixelBuffers));
+	}
+#endif
 }
 
 void GLTexture::enableLinearFiltering(bool enable) {
@@ -63,6 +68,13 @@ void GLTexture::enableLinearFiltering(bool enable) {
 void GLTexture::destroy() {
 	GL_CALL(glDeleteTextures(1, &_glTexture));
 	_glTexture = 0;
+
+#if !USE_FORCED_GLES
+	if (_pixelBuffers[0]) {
+		GL_CALL(glDeleteBuffers(kPixelBufferCount, _pixelBuffers));
+		memset(_pixelBuffers, 0, sizeof(_pixelBuffers));
+	}
+#endif
 }
 
 void GLTexture::create() {
@@ -72,6 +84,13 @@ void GLTexture::create() {
 	// Get a new texture name.
 	GL_CALL(glGenTextures(1, &_glTexture));
 
+#if !USE_FORCED_GLES
+	// Get buffer names to stream the texture data through, if possible.
+	if (g_context.pixelBufferObjectSupported) {
+		GL_CALL(glGenBuffers(kPixelBufferCount, _pixelBuffers));
+	}
+#endif
+
 	// Set up all texture parameters.
 	bind();
 	GL_CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
@@ -145,12 +164,10 @@ void GLTexture::updateArea(const Common::Rect &area, const Graphics::Surface &sr
 	bind();
 
 	// Update the actual texture.
-	// Although we have the area of the texture buffer we want to update we
-	// cannot take advantage of the left/right boundries here because it is
-	// not possible to specify a pitch to glTexSubImage2D. To be precise, with
-	// plain OpenGL we could set GL_UNPACK_ROW_LENGTH to achieve this. However,
-	// OpenGL ES 1.0 does not support GL_UNPACK_ROW_LENGTH. Thus, we are left
-	// with the following options:
+	// With GL_UNPACK_ROW_LENGTH we can tell glTexSubImage2D about the pitch
+	// of the source and upload only the area itself. However, OpenGL ES 1.0
+	// and 2.0 without GL_EXT_unpack_subimage do not support it. Thus, there
+	// we are left with the following options:
 	//
 	// 1) (As we do right now) Simply always update the whole texture lines of
 	//    rect changed. This is simplest to implement. In case performance is
@@ -162,8 +179,47 @@ void GLTexture::updateArea(const Common::Rect &area, const Graphics::Surface &sr
 	//
 	// 3) Use glTexSubImage2D per line changed. This is what the old OpenGL
 	//    graphics manager did but it is much slower! Thus, we do not use it.
-	GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, area.top, src.w, area.height(),
-	                       _glFormat, _glType, src.getBasePtr(0, area.top)));
+	//
+	// A single line, like a palette, needs no pitch and is always uploaded
+	// as is.
+	Common::Rect uploadArea(0, area.top, src.w, area.bottom);
+	if (g_context.unpackSubImageSupported) {
+		uploadArea = area;
+		GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, src.pitch / src.format.bytesPerPixel));
+	} else if (area.height() == 1) {
+		uploadArea = area;
+	}
+
+	const void *data = src.getBasePtr(uploadArea.left, uploadArea.top);
+	const uint size = (uploadArea.height() - 1) * src.pitch + uploadArea.width() * src.format.bytesPerPixel;
+	GL_COUNT_UPLOAD(size);
+
+	if (_pixelBuffers[0]) {
+		uploadThroughPixelBuffer(uploadArea, data, size);
+	} else {
+		GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, uploadArea.left, uploadArea.top, uploadArea.width(), uploadArea.height(),
+		                       _glFormat, _glType, data));
+	}
+
+	if (g_context.unpackSubImageSupported) {
+		GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+	}
+}
+
+void GLTexture::uploadThroughPixelBuffer(const Common::Rect &area, const void *data, uint size) {
+#if !USE_FORCED_GLES
+	// Orphan the old storage of the buffer, so that writing to it does not
+	// wait for an upload which is still pending. Then glTexSubImage2D only
+	// schedules the copy from the buffer and returns.
+	GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pixelBuffers[_nextPixelBuffer]));
+	GL_CALL(glBufferData(GL_PIXEL_UNPACK_BUFFER, size, NULL, GL_STREAM_DRAW));
+	GL_CALL(glBufferSubData(GL_PIXEL_UNPACK_BUFFER, 0, size, data));
+	GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, area.left, area.top, area.width(), area.height(),
+	                       _glFormat, _glType, NULL));
+	GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+
+	_nextPixelBuffer = (_nextPixelBuffer + 1) % kPixelBufferCount;
+#endif
 }
 
 //
@@ -171,7 +227,7 @@ void GLTexture::updateArea(const Common::Rect &area, const Graphics::Surface &sr
 //
 
 Surface::Surface()
-	: _allDirty(false), _dirtyArea() {
+	: _allDirty(false), _dirtyAreas() {
 }
 
 void Surface::copyRectToTexture(uint x, uint y, uint w, uint h, const void *srcPtr, uint srcPitch) {
@@ -179,15 +235,7 @@ void Surface::copyRectToTexture(uint x, uint y, uint w, uint h, const void *srcP
 	assert(x + w <= (uint)dstSurf->w);
 	assert(y + h <= (uint)dstSurf->h);
 
-	// *sigh* Common::Rect::extend behaves unexpected whenever one of the two
-	// parameters is an empty rect. Thus, we check whether the current dirty
-	// area is valid. In case it is not we simply use the parameters as new
-	// dirty area. Otherwise, we simply call extend.
-	if (_dirtyArea.isEmpty()) {
-		_dirtyArea = Common::Rect(x, y, x + w, y + h);
-	} else {
-		_dirtyArea.extend(Common::Rect(x, y, x + w, y + h));
-	}
+	addDirtyArea(Common::Rect(x, y, x + w, y + h));
 
 	const byte *src = (const byte *)srcPtr;
 	byte *dst = (byte *)dstSurf->getBasePtr(x, y);
@@ -215,9 +263,70 @@ void Surface::fill(uint32 color) {
 Common::Rect Surface::getDirtyArea() const {
 	if (_allDirty) {
 		return Common::Rect(getWidth(), getHeight());
-	} else {
-		return _dirtyArea;
+	} else if (_dirtyAreas.empty()) {
+		return Common::Rect();
+	}
+
+	// *sigh* Common::Rect::extend behaves unexpected whenever one of the two
+	// parameters is an empty rect. The dirty areas are never empty though.
+	Common::Rect bounds = _dirtyAreas[0];
+	for (uint i = 1; i < _dirtyAreas.size(); ++i) {
+		bounds.extend(_dirtyAreas[i]);
+	}
+	return bounds;
+}
+
+const Common::Array<Common::Rect> &Surface::getDirtyAreas() {
+	if (_allDirty) {
+		_dirtyAreas.resize(1);
+		_dirtyAreas[0] = Common::Rect(getWidth(), getHeight());
 	}
+	return _dirtyAreas;
+}
+
+namespace {
+// The cost of an extra upload call, in pixels. Areas closer than this are
+// uploaded together.
+const uint kUploadCallCost = 4096;
+
+// More areas than this are not worth tracking separately.
+const uint kMaxDirtyAreas = 16;
+} // End of anonymous namespace
+
+uint Surface::getUploadCost(const Common::Rect &area) const {
+	// Without a row length for uploads, whole lines are uploaded.
+	const uint width = g_context.unpackSubImageSupported ? area.width() : getWidth();
+	return width * area.height() + kUploadCallCost;
+}
+
+void Surface::addDirtyArea(const Common::Rect &area) {
+	if (_allDirty || area.isEmpty()) {
+		return;
+	}
+
+	// Merge the new area with every area it overlaps or is cheaper to
+	// upload with. The merged area can reach further areas, so start over
+	// after each merge.
+	Common::Rect merged = area;
+	for (uint i = 0; i < _dirtyAreas.size();) {
+		Common::Rect bounds = merged;
+		bounds.extend(_dirtyAreas[i]);
+
+		if (merged.intersects(_dirtyAreas[i]) ||
+		    getUploadCost(bounds) <= getUploadCost(merged) + getUploadCost(_dirtyAreas[i])) {
+			merged = bounds;
+			_dirtyAreas.remove_at(i);
+			i = 0;
+		} else {
+			++i;
+		}
+	}
+
+	if (_dirtyAreas.size() >= kMaxDirtyAreas) {
+		merged.extend(getDirtyArea());
+		_dirtyAreas.resize(0);
+	}
+	_dirtyAreas.push_back(merged);
 }
 
 //
@@ -277,46 +386,51 @@ void Texture::updateGLTexture() {
 		return;
 	}
 
-	Common::Rect dirtyArea = getDirtyArea();
+	const Common::Array<Common::Rect> &dirtyAreas = getDirtyAreas();
+	for (uint i = 0; i < dirtyAreas.size(); ++i) {
+		Common::Rect dirtyArea = dirtyAreas[i];
 
-	// In case we use linear filtering we might need to duplicate the last
-	// pixel row/column to avoid glitches with filtering.
-	if (_glTexture.isLinearFilteringEnabled()) {
-		if (dirtyArea.right == _userPixelData.w && _userPixelData.w != _textureData.w) {
-			uint height = dirtyArea.height();
+		// In case we use linear filtering we might need to duplicate the last
+		// pixel row/column to avoid glitches with filtering.
+		if (_glTexture.isLinearFilteringEnabled()) {
+			if (dirtyArea.right == _userPixelData.w && _userPixelData.w != _textureData.w) {
+				uint height = dirtyArea.height();
 
-			const byte *src = (const byte *)_textureData.getBasePtr(_userPixelData.w - 1, dirtyArea.top);
-			byte *dst = (byte *)_textureData.getBasePtr(_userPixelData.w, dirtyArea.top);
+				const byte *src = (const byte *)_textureData.getBasePtr(_userPixelData.w - 1, dirtyArea.top);
+				byte *dst = (byte *)_textureData.getBasePtr(_userPixelData.w, dirtyArea.top);
 
-			while (height-- > 0) {
-				memcpy(dst, src, _textureData.format.bytesPerPixel);
-				dst += _textureData.pitch;
-				src += _textureData.pitch;
-			}
+				while (height-- > 0) {
+					memcpy(dst, src, _textureData.format.bytesPerPixel);
+					dst += _textureData.pitch;
+					src += _textureData.pitch;
+				}
 
-			// Extend the dirty area.
-			++dirtyArea.right;
-		}
+				// Extend the dirty area.
+				++dirtyArea.right;
+			}
 
-		if (dirtyArea.bottom == _userPixelData.h && _userPixelData.h != _textureData.h) {
-			const byte *src = (const byte *)_textureData.getBasePtr(dirtyArea.left, _userPixelData.h - 1);
-			byte *dst = (byte *)_textureData.getBasePtr(dirtyArea.left, _userPixelData.h);
-			memcpy(dst, src, dirtyArea.width() * _textureData.format.bytesPerPixel);
+			if (dirtyArea.bottom == _userPixelData.h && _userPixelData.h != _textureData.h) {
+				const byte *src = (const byte *)_textureData.getBasePtr(dirtyArea.left, _userPixelData.h - 1);
+				byte *dst = (byte *)_textureData.getBasePtr(dirtyArea.left, _userPixelData.h);
+				memcpy(dst, src, dirtyArea.width() * _textureData.format.bytesPerPixel);
 
-			// Extend the dirty area.
-			++dirtyArea.bottom;
+				// Extend the dirty area.
+				++dirtyArea.bottom;
+			}
 		}
-	}
 
-	_glTexture.updateArea(dirtyArea, _textureData);
+		_glTexture.updateArea(dirtyArea, _textureData);
+	}
 
 	// We should have handled everything, thus not dirty anymore.
 	clearDirty();
 }
 
 TextureCLUT8::TextureCLUT8(GLenum glIntFormat, GLenum glFormat, GLenum glType, const Graphics::PixelFormat &format)
-	: Texture(glIntFormat, glFormat, glType, format), _clut8Data(), _palette(new byte[256 * format.bytesPerPixel]) {
-	memset(_palette, 0, sizeof(byte) * format.bytesPerPixel);
+	: Texture(glIntFormat, glFormat, glType, format), _clut8Data(), _palette(new byte[256 * format.bytesPerPixel]),
+	  _paletteChanged(false) {
+	memset(_palette, 0, sizeof(byte) * 256 * format.bytesPerPixel);
+	memset(_changedColors, 0, sizeof(_changedColors));
 }
 
 TextureCLUT8::~TextureCLUT8() {
@@ -346,41 +460,99 @@ void TextureCLUT8::setColorKey(uint colorKey) {
 	// to avoid color fringes due to filtering.
 	// Erasing the color data is not a problem as the palette is always fully re-initialized
 	// before setting the key color.
+	bool changed = false;
 	if (_format.bytesPerPixel == 2) {
 		uint16 *palette = (uint16 *)_palette + colorKey;
+		changed = *palette != 0;
 		*palette = 0;
 	} else if (_format.bytesPerPixel == 4) {
 		uint32 *palette = (uint32 *)_palette + colorKey;
+		changed = *palette != 0;
 		*palette = 0;
 	} else {
 		warning("TextureCLUT8::setColorKey: Unsupported pixel depth %d", _format.bytesPerPixel);
 	}
 
-	// A palette changes means we need to refresh the whole surface.
-	flagDirty();
+	if (changed) {
+		_changedColors[colorKey] = 1;
+		_paletteChanged = true;
+	}
 }
 
 namespace {
 template<typename ColorType>
-inline void convertPalette(ColorType *dst, const byte *src, uint colors, const Graphics::PixelFormat &format) {
+inline bool convertPalette(ColorType *dst, const byte *src, uint colors, const Graphics::PixelFormat &format, byte *changedColors) {
+	bool changed = false;
 	while (colors-- > 0) {
-		*dst++ = format.RGBToColor(src[0], src[1], src[2]);
+		const ColorType color = format.RGBToColor(src[0], src[1], src[2]);
+		if (*dst != color) {
+			*dst = color;
+			*changedColors = 1;
+			changed = true;
+		}
+
+		++dst;
+		++changedColors;
 		src += 3;
 	}
+	return changed;
 }
 } // End of anonymous namespace
 
 void TextureCLUT8::setPalette(uint start, uint colors, const byte *palData) {
+	// Only remember which colors actually changed. Games often set the same
+	// palette again, and palette cycling only changes a few colors.
 	if (_format.bytesPerPixel == 2) {
-		convertPalette<uint16>((uint16 *)_palette + start, palData, colors, _format);
+		_paletteChanged |= convertPalette<uint16>((uint16 *)_palette + start, palData, colors, _format, _changedColors + start);
 	} else if (_format.bytesPerPixel == 4) {
-		convertPalette<uint32>((uint32 *)_palette + start, palData, colors, _format);
+		_paletteChanged |= convertPalette<uint32>((uint32 *)_palette + start, palData, colors, _format, _changedColors + start);
 	} else {
 		warning("TextureCLUT8::setPalette: Unsupported pixel depth: %d", _format.bytesPerPixel);
 	}
+}
 
-	// A palette changes means we need to refresh the whole surface.
-	flagDirty();
+void TextureCLUT8::flagChangedColors() {
+	_paletteChanged = false;
+
+	// Everything gets converted anyway.
+	if (isAllDirty()) {
+		memset(_changedColors, 0, sizeof(_changedColors));
+		return;
+	}
+
+	// Collect the bands of lines using any of the changed colors.
+	Common::Rect band;
+	for (int y = 0; y < _clut8Data.h; ++y) {
+		const byte *src = (const byte *)_clut8Data.getBasePtr(0, y);
+		int left = -1, right = -1;
+		for (int x = 0; x < _clut8Data.w; ++x) {
+			if (_changedColors[src[x]]) {
+				if (left < 0) {
+					left = x;
+				}
+				right = x;
+			}
+		}
+
+		if (left >= 0) {
+			if (band.isEmpty()) {
+				band = Common::Rect(left, y, right + 1, y + 1);
+			} else {
+				band.left = MIN<int16>(band.left, left);
+				band.right = MAX<int16>(band.right, right + 1);
+				band.bottom = y + 1;
+			}
+		} else if (!band.isEmpty()) {
+			addDirtyArea(band);
+			band = Common::Rect();
+		}
+	}
+
+	if (!band.isEmpty()) {
+		addDirtyArea(band);
+	}
+
+	memset(_changedColors, 0, sizeof(_changedColors));
 }
 
 namespace {
@@ -401,6 +573,10 @@ inline void doPaletteLookUp(PixelType *dst, const byte *src, uint width, uint he
 } // End of anonymous namespace
 
 void TextureCLUT8::updateGLTexture() {
+	if (_paletteChanged) {
+		flagChangedColors();
+	}
+
 	if (!isDirty()) {
 		return;
 	}
@@ -408,20 +584,23 @@ void TextureCLUT8::updateGLTexture() {
 	// Do the palette look up
 	Graphics::Surface *outSurf = Texture::getSurface();
 
-	Common::Rect dirtyArea = getDirtyArea();
-
-	if (outSurf->format.bytesPerPixel == 2) {
-		doPaletteLookUp<uint16>((uint16 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top),
-		                        (const byte *)_clut8Data.getBasePtr(dirtyArea.left, dirtyArea.top),
-		                        dirtyArea.width(), dirtyArea.height(),
-		                        outSurf->pitch, _clut8Data.pitch, (const uint16 *)_palette);
-	} else if (outSurf->format.bytesPerPixel == 4) {
-		doPaletteLookUp<uint32>((uint32 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top),
-		                        (const byte *)_clut8Data.getBasePtr(dirtyArea.left, dirtyArea.top),
-		                        dirtyArea.width(), dirtyArea.height(),
-		                        outSurf->pitch, _clut8Data.pitch, (const uint32 *)_palette);
-	} else {
-		warning("TextureCLUT8::updateGLTexture: Unsupported pixel depth: %d", outSurf->format.bytesPerPixel);
+	const Common::Array<Common::Rect> &dirtyAreas = getDirtyAreas();
+	for (uint i = 0; i < dirtyAreas.size(); ++i) {
+		const Common::Rect &dirtyArea = dirtyAreas[i];
+
+		if (outSurf->format.bytesPerPixel == 2) {
+			doPaletteLookUp<uint16>((uint16 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top),
+			                        (const byte *)_clut8Data.getBasePtr(dirtyArea.left, dirtyArea.top),
+			                        dirtyArea.width(), dirtyArea.height(),
+			                        outSurf->pitch, _clut8Data.pitch, (const uint16 *)_palette);
+		} else if (outSurf->format.bytesPerPixel == 4) {
+			doPaletteLookUp<uint32>((uint32 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top),
+			                        (const byte *)_clut8Data.getBasePtr(dirtyArea.left, dirtyArea.top),
+			                        dirtyArea.width(), dirtyArea.height(),
+			                        outSurf->pitch, _clut8Data.pitch, (const uint32 *)_palette);
+		} else {
+			warning("TextureCLUT8::updateGLTexture: Unsupported pixel depth: %d", outSurf->format.bytesPerPixel);
+		}
 	}
 
 	// Do generic handling of updating the texture.
@@ -459,11 +638,14 @@ void FakeTexture::updateGLTexture() {
 	// Convert color space.
 	Graphics::Surface *outSurf = Texture::getSurface();
 
-	const Common::Rect dirtyArea = getDirtyArea();
+	const Common::Array<Common::Rect> &dirtyAreas = getDirtyAreas();
+	for (uint i = 0; i < dirtyAreas.size(); ++i) {
+		const Common::Rect &dirtyArea = dirtyAreas[i];
 
-	byte *dst = (byte *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
-	const byte *src = (const byte *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
-	Graphics::crossBlit(dst, src, outSurf->pitch, _rgbData.pitch, dirtyArea.width(), dirtyArea.height(), outSurf->format, _rgbData.format);
+		byte *dst = (byte *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
+		const byte *src = (const byte *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
+		Graphics::crossBlit(dst, src, outSurf->pitch, _rgbData.pitch, dirtyArea.width(), dirtyArea.height(), outSurf->format, _rgbData.format);
+	}
 
 	// Do generic handling of updating the texture.
 	Texture::updateGLTexture();
@@ -481,25 +663,28 @@ void TextureRGB555::updateGLTexture() {
 	// Convert color space.
 	Graphics::Surface *outSurf = Texture::getSurface();
 
-	const Common::Rect dirtyArea = getDirtyArea();
+	const Common::Array<Common::Rect> &dirtyAreas = getDirtyAreas();
+	for (uint i = 0; i < dirtyAreas.size(); ++i) {
+		const Common::Rect &dirtyArea = dirtyAreas[i];
 
-	uint16 *dst = (uint16 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
-	const uint dstAdd = outSurf->pitch - 2 * dirtyArea.width();
+		uint16 *dst = (uint16 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
+		const uint dstAdd = outSurf->pitch - 2 * dirtyArea.width();
 
-	const uint16 *src = (const uint16 *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
-	const uint srcAdd = _rgbData.pitch - 2 * dirtyArea.width();
+		const uint16 *src = (const uint16 *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
+		const uint srcAdd = _rgbData.pitch - 2 * dirtyArea.width();
 
-	for (int height = dirtyArea.height(); height > 0; --height) {
-		for (int width = dirtyArea.width(); width > 0; --width) {
-			const uint16 color = *src++;
+		for (int height = dirtyArea.height(); height > 0; --height) {
+			for (int width = dirtyArea.width(); width > 0; --width) {
+				const uint16 color = *src++;
 
-			*dst++ =   ((color & 0x7C00) << 1)                             // R
-			         | (((color & 0x03E0) << 1) | ((color & 0x0200) >> 4)) // G
-			         | (color & 0x001F);                                   // B
-		}
+				*dst++ =   ((color & 0x7C00) << 1)                             // R
+				         | (((color & 0x03E0) << 1) | ((color & 0x0200) >> 4)) // G
+				         | (color & 0x001F);                                   // B
+			}
 
-		src = (const uint16 *)((const byte *)src + srcAdd);
-		dst = (uint16 *)((byte *)dst + dstAdd);
+			src = (const uint16 *)((const byte *)src + srcAdd);
+			dst = (uint16 *)((byte *)dst + dstAdd);
+		}
 	}
 
 	// Do generic handling of updating the texture.
@@ -523,23 +708,26 @@ void TextureRGBA8888Swap::updateGLTexture() {
 	// Convert color space.
 	Graphics::Surface *outSurf = Texture::getSurface();
 
-	const Common::Rect dirtyArea = getDirtyArea();
+	const Common::Array<Common::Rect> &dirtyAreas = getDirtyAreas();
+	for (uint i = 0; i < dirtyAreas.size(); ++i) {
+		const Common::Rect &dirtyArea = dirtyAreas[i];
 
-	uint32 *dst = (uint32 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
-	const uint dstAdd = outSurf->pitch - 4 * dirtyArea.width();
+		uint32 *dst = (uint32 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
+		const uint dstAdd = outSurf->pitch - 4 * dirtyArea.width();
 
-	const uint32 *src = (const uint32 *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
-	const uint srcAdd = _rgbData.pitch - 4 * dirtyArea.width();
+		const uint32 *src = (const uint32 *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
+		const uint srcAdd = _rgbData.pitch - 4 * dirtyArea.width();
 
-	for (int height = dirtyArea.height(); height > 0; --height) {
-		for (int width = dirtyArea.width(); width > 0; --width) {
-			const uint32 color = *src++;
+		for (int height = dirtyArea.height(); height > 0; --height) {
+			for (int width = dirtyArea.width(); width > 0; --width) {
+				const uint32 color = *src++;
 
-			*dst++ = SWAP_BYTES_32(color);
-		}
+				*dst++ = SWAP_BYTES_32(color);
+			}
 
-		src = (const uint32 *)((const byte *)src + srcAdd);
-		dst = (uint32 *)((byte *)dst + dstAdd);
+			src = (const uint32 *)((const byte *)src + srcAdd);
+			dst = (uint32 *)((byte *)dst + dstAdd);
+		}
 	}
 
 	// Do generic handling of updating the texture.
@@ -558,7 +746,7 @@ TextureCLUT8GPU::TextureCLUT8GPU()
 	  _paletteTexture(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE),
 	  _target(new TextureTarget()), _clut8Pipeline(new CLUT8LookUpPipeline()),
 	  _clut8Vertices(), _clut8Data(), _userPixelData(), _palette(),
-	  _paletteDirty(false) {
+	  _paletteDirtyStart(256), _paletteDirtyEnd(0) {
 	// Allocate space for 256 colors.
 	_paletteTexture.setSize(256, 1);
 
@@ -589,7 +777,7 @@ void TextureCLUT8GPU::recreate() {
 	// time.
 	if (_clut8Data.getPixels()) {
 		flagDirty();
-		_paletteDirty = true;
+		flagPaletteDirty(0, 256);
 	}
 }
 
@@ -641,26 +829,29 @@ void TextureCLUT8GPU::setColorKey(uint colorKey) {
 	// to avoid color fringes due to filtering.
 	// Erasing the color data is not a problem as the palette is always fully re-initialized
 	// before setting the key color.
-	_palette[colorKey * 4    ] = 0x00;
-	_palette[colorKey * 4 + 1] = 0x00;
-	_palette[colorKey * 4 + 2] = 0x00;
-	_palette[colorKey * 4 + 3] = 0x00;
-
-	_paletteDirty = true;
+	static const byte transparent[4] = { 0x00, 0x00, 0x00, 0x00 };
+	byte *dst = _palette + colorKey * 4;
+	if (memcmp(dst, transparent, 4)) {
+		memcpy(dst, transparent, 4);
+		flagPaletteDirty(colorKey, colorKey + 1);
+	}
 }
 
 void TextureCLUT8GPU::setPalette(uint start, uint colors, const byte *palData) {
 	byte *dst = _palette + start * 4;
 
-	while (colors-- > 0) {
-		memcpy(dst, palData, 3);
-		dst[3] = 0xFF;
+	// Only the changed entries are uploaded, and nothing at all when the
+	// palette is set to the same colors again.
+	for (uint i = start; i < start + colors; ++i) {
+		if (dst[0] != palData[0] || dst[1] != palData[1] || dst[2] != palData[2] || dst[3] != 0xFF) {
+			memcpy(dst, palData, 3);
+			dst[3] = 0xFF;
+			flagPaletteDirty(i, i + 1);
+		}
 
 		dst += 4;
 		palData += 3;
 	}
-
-	_paletteDirty = true;
 }
 
 const GLTexture &TextureCLUT8GPU::getGLTexture() const {
@@ -668,16 +859,20 @@ const GLTexture &TextureCLUT8GPU::getGLTexture() const {
 }
 
 void TextureCLUT8GPU::updateGLTexture() {
-	const bool needLookUp = Surface::isDirty() || _paletteDirty;
+	const bool paletteDirty = _paletteDirtyStart < _paletteDirtyEnd;
+	const bool needLookUp = Surface::isDirty() || paletteDirty;
 
 	// Update CLUT8 texture if necessary.
 	if (Surface::isDirty()) {
-		_clut8Texture.updateArea(getDirtyArea(), _clut8Data);
+		const Common::Array<Common::Rect> &dirtyAreas = getDirtyAreas();
+		for (uint i = 0; i < dirtyAreas.size(); ++i) {
+			_clut8Texture.updateArea(dirtyAreas[i], _clut8Data);
+		}
 		clearDirty();
 	}
 
 	// Update palette if necessary.
-	if (_paletteDirty) {
+	if (paletteDirty) {
 		Graphics::Surface palSurface;
 		palSurface.init(256, 1, 256, _palette,
 #ifdef SCUMM_LITTLE_ENDIAN
@@ -687,8 +882,9 @@ void TextureCLUT8GPU::updateGLTexture() {
 #endif
 		               );
 
-		_paletteTexture.updateArea(Common::Rect(256, 1), palSurface);
-		_paletteDirty = false;
+		_paletteTexture.updateArea(Common::Rect(_paletteDirtyStart, 0, _paletteDirtyEnd, 1), palSurface);
+		_paletteDirtyStart = 256;
+		_paletteDirtyEnd = 0;
 	}
 
 	// In case any data changed, do color look up and store result in _target.
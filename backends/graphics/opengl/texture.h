@@ -28,6 +28,7 @@
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 
+#include "common/array.h"
 #include "common/rect.h"
 
 namespace OpenGL {
@@ -143,6 +144,27 @@ private:
 	GLint _glFilter;
 
 	GLuint _glTexture;
+
+	/**
+	 * Upload the data through the next pixel buffer object.
+	 *
+	 * This lets the driver copy the data to the texture while the previous
+	 * frames are still drawn, instead of waiting for them.
+	 *
+	 * @param area The area of the texture to update.
+	 * @param data The pixel data for the area.
+	 * @param size The number of bytes from data to upload.
+	 */
+	void uploadThroughPixelBuffer(const Common::Rect &area, const void *data, uint size);
+
+	/**
+	 * The number of pixel buffer objects to cycle through, so that the
+	 * one written to is not in use by a pending upload.
+	 */
+	static const uint kPixelBufferCount = 3;
+
+	GLuint _pixelBuffers[kPixelBufferCount];
+	uint _nextPixelBuffer;
 };
 
 /**
@@ -201,7 +223,7 @@ public:
 	void fill(uint32 color);
 
 	void flagDirty() { _allDirty = true; }
-	virtual bool isDirty() const { return _allDirty || !_dirtyArea.isEmpty(); }
+	virtual bool isDirty() const { return _allDirty || !_dirtyAreas.empty(); }
 
 	virtual uint getWidth() const = 0;
 	virtual uint getHeight() const = 0;
@@ -239,12 +261,33 @@ public:
 	 */
 	virtual const GLTexture &getGLTexture() const = 0;
 protected:
-	void clearDirty() { _allDirty = false; _dirtyArea = Common::Rect(); }
+	void clearDirty() { _allDirty = false; _dirtyAreas.resize(0); }
+	bool isAllDirty() const { return _allDirty; }
 
+	/**
+	 * Add an area to the dirty areas. It is merged with the areas which it
+	 * overlaps, or with those which are cheaper to update together with it.
+	 */
+	void addDirtyArea(const Common::Rect &area);
+
+	/**
+	 * @return The bounding rectangle of all dirty areas.
+	 */
 	Common::Rect getDirtyArea() const;
+
+	/**
+	 * @return The dirty areas, which do not overlap each other.
+	 */
+	const Common::Array<Common::Rect> &getDirtyAreas();
 private:
+
+	/**
+	 * @return An estimate of the cost of uploading an area, in pixels.
+	 */
+	uint getUploadCost(const Common::Rect &area) const;
+
 	bool _allDirty;
-	Common::Rect _dirtyArea;
+	Common::Array<Common::Rect> _dirtyAreas;
 };
 
 /**
@@ -312,10 +355,21 @@ public:
 	virtual Graphics::Surface *getSurface() { return &_clut8Data; }
 	virtual const Graphics::Surface *getSurface() const { return &_clut8Data; }
 
+	virtual bool isDirty() const { return _paletteChanged || Texture::isDirty(); }
+
 	virtual void updateGLTexture();
 private:
+	/**
+	 * Mark the areas using any of the changed colors dirty, so that only
+	 * they are converted and uploaded again.
+	 */
+	void flagChangedColors();
+
 	Graphics::Surface _clut8Data;
 	byte *_palette;
+	/** Non-zero for each color changed since the last update. */
+	byte _changedColors[256];
+	bool _paletteChanged;
 };
 
 class FakeTexture : public Texture {
@@ -369,7 +423,7 @@ public:
 
 	virtual void allocate(uint width, uint height);
 
-	virtual bool isDirty() const { return _paletteDirty || Surface::isDirty(); }
+	virtual bool isDirty() const { return _paletteDirtyStart < _paletteDirtyEnd || Surface::isDirty(); }
 
 	virtual uint getWidth() const { return _userPixelData.w; }
 	virtual uint getHeight() const { return _userPixelData.h; }
@@ -407,7 +461,13 @@ private:
 	Graphics::Surface _userPixelData;
 
 	byte _palette[4 * 256];
-	bool _paletteDirty;
+	/** The range of palette entries changed since the last update. */
+	uint _paletteDirtyStart, _paletteDirtyEnd;
+
+	void flagPaletteDirty(uint start, uint end) {
+		_paletteDirtyStart = MIN(_paletteDirtyStart, start);
+		_paletteDirtyEnd = MAX(_paletteDirtyEnd, end);
+	}
 };
 #endif // !USE_FORCED_GLES
 
@@ -0,0 +1,158 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "backends/graphics/performance-hud.h"
+#include "backends/mixer/mixer.h"
+#include "backends/modular-backend.h"
+
+#include "common/array.h"
+#include "common/memtrack.h"
+#include "common/str.h"
+#include "common/system.h"
+#include "graphics/font.h"
+
+PerformanceHud::PerformanceHud()
+	: _visible(false), _lastPresentTime(0), _lastUpdateTime(0),
+	  _uploadedBytes(0), _uploadedFrames(0), _uploadedBytesPerFrame(0) {
+}
+
+PerformanceHud::~PerformanceHud() {
+	_surface.free();
+}
+
+void PerformanceHud::setVisible(bool visible) {
+	if (_visible == visible)
+		return;
+
+	_visible = visible;
+
+	// Start over, so that the time spent hidden does not show up as a frame
+	_frameTimes.clear();
+	_lastPresentTime = 0;
+	_lastUpdateTime = 0;
+	_uploadedBytes = 0;
+	_uploadedFrames = 0;
+	_uploadedBytesPerFrame = 0;
+}
+
+void PerformanceHud::framePresented(uint uploadedBytes) {
+	if (!_visible)
+		return;
+
+	const uint32 currentTime = g_system->getMillis();
+	if (_lastPresentTime != 0)
+		_frameTimes.add(currentTime - _lastPresentTime);
+	_lastPresentTime = currentTime;
+
+	_uploadedBytes += uploadedBytes;
+	_uploadedFrames++;
+}
+
+bool PerformanceHud::update(const Graphics::Font *font, const Graphics::PixelFormat &format) {
+	if (!_visible)
+		return false;
+
+	const uint32 currentTime = g_system->getMillis();
+	if (_surface.getPixels() && _surface.format == format && currentTime - _lastUpdateTime < kUpdateInterval)
+		return false;
+
+	_lastUpdateTime = currentTime;
+
+	if (_uploadedFrames) {
+		_uploadedBytesPerFrame = _uploadedBytes / _uploadedFrames;
+		_uploadedBytes = 0;
+		_uploadedFrames = 0;
+	}
+
+	draw(font, format);
+	return true;
+}
+
+void PerformanceHud::draw(const Graphics::Font *font, const Graphics::PixelFormat &format) {
+	Common::Array<Common::String> lines;
+
+	uint32 totalTime = 0;
+	for (uint i = 0; i < _frameTimes.size(); ++i)
+		totalTime += _frameTimes.getRecent(i);
+
+	if (totalTime) {
+		const uint fps10 = _frameTimes.size() * 10000 / totalTime;
+		lines.push_back(Common::String::format("FPS: %u.%u", fps10 / 10, fps10 % 10));
+	} else {
+		lines.push_back("FPS: -");
+	}
+
+	lines.push_back(Common::String::format("Frame: %u ms, 95%%: %u ms, max: %u ms",
+	                                       _frameTimes.getPercentile(50),
+	                                       _frameTimes.getPercentile(95),
+	                                       _frameTimes.getPercentile(100)));
+
+	ModularMixerBackend *mixerBackend = dynamic_cast<ModularMixerBackend *>(g_system);
+	if (mixerBackend && mixerBackend->getMixerManager()) {
+		lines.push_back(Common::String::format("Audio callback: %u%%", mixerBackend->getMixerManager()->getCallbackLoad()));
+	}
+
+	lines.push_back(Common::String::format("Upload: %u KB per frame", (_uploadedBytesPerFrame + 1023) / 1024));
+
+#ifdef ENABLE_PROFILER
+	const Common::MemoryTracker &tracker = Common::MemoryTracker::instance();
+	lines.push_back(Common::String::format("Tracked memory: %u KB, peak: %u KB",
+	                                       (uint)((tracker.getTotal() + 1023) / 1024),
+	                                       (uint)((tracker.getPeakTotal() + 1023) / 1024)));
+#endif
+
+	const int lineHeight = font->getFontHeight() + 2;
+	int width = Graphics::FrameHistory::kSize;
+	for (uint i = 0; i < lines.size(); ++i)
+		width = MAX(width, font->getStringWidth(lines[i]));
+	width += 2 * kPadding;
+	const int height = lines.size() * lineHeight + kGraphHeight + 3 * kPadding;
+
+	if (_surface.w != width || _surface.h != height || _surface.format != format) {
+		_surface.free();
+		_surface.create(width, height, format);
+	}
+
+	_surface.fillRect(Common::Rect(width, height), format.RGBToColor(40, 40, 40));
+
+	const uint32 white = format.RGBToColor(255, 255, 255);
+	for (uint i = 0; i < lines.size(); ++i)
+		font->drawString(&_surface, lines[i], kPadding, kPadding + i * lineHeight, width - 2 * kPadding, white);
+
+	// The frame time graph, with the oldest frame on the left and a line at
+	// the duration of a frame at 60 Hz
+	const int graphBottom = height - kPadding - 1;
+	const int graphRight = kPadding + Graphics::FrameHistory::kSize - 1;
+	const uint32 green = format.RGBToColor(0, 200, 0);
+	const uint32 yellow = format.RGBToColor(220, 200, 0);
+	const uint32 red = format.RGBToColor(220, 0, 0);
+
+	for (uint i = 0; i < _frameTimes.size(); ++i) {
+		const uint32 frameTime = _frameTimes.getRecent(i);
+		const int barHeight = MAX<int>(1, MIN<uint32>(frameTime, kGraphMaxTime) * kGraphHeight / kGraphMaxTime);
+		const uint32 color = frameTime <= 17 ? green : (frameTime <= 34 ? yellow : red);
+		_surface.vLine(graphRight - i, graphBottom - barHeight + 1, graphBottom, color);
+	}
+
+	const int refreshLine = graphBottom - 16 * kGraphHeight / kGraphMaxTime;
+	_surface.hLine(kPadding, refreshLine, graphRight, format.RGBToColor(128, 128, 128));
+}
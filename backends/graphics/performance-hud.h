@@ -0,0 +1,98 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef BACKENDS_GRAPHICS_PERFORMANCE_HUD_H
+#define BACKENDS_GRAPHICS_PERFORMANCE_HUD_H
+
+#include "common/scummsys.h"
+#include "graphics/framelimiter.h"
+#include "graphics/surface.h"
+
+namespace Graphics {
+class Font;
+}
+
+/**
+ * Performance statistics shown on top of the screen.
+ *
+ * The graphics managers report every presented frame, and draw the surface
+ * of the HUD after the OSD. It shows the frame rate, a graph of the recent
+ * frame times, the load of the audio callback and the amount of pixel data
+ * uploaded per frame. With the profiler, it also shows the memory counted by
+ * Common::MemoryTracker.
+ */
+class PerformanceHud {
+public:
+	PerformanceHud();
+	~PerformanceHud();
+
+	void setVisible(bool visible);
+	bool isVisible() const { return _visible; }
+
+	/**
+	 * Record the presentation of a frame.
+	 *
+	 * @param uploadedBytes The amount of pixel data sent to the screen or
+	 *                      the GPU for the frame.
+	 */
+	void framePresented(uint uploadedBytes);
+
+	/**
+	 * Redraw the HUD surface if the statistics shown are out of date.
+	 *
+	 * @param font   The font to draw the text with.
+	 * @param format The pixel format of the surface.
+	 * @return Whether the surface was redrawn.
+	 */
+	bool update(const Graphics::Font *font, const Graphics::PixelFormat &format);
+
+	/**
+	 * @return The HUD surface. It is empty until update() was called once.
+	 */
+	const Graphics::Surface &getSurface() const { return _surface; }
+
+	enum {
+		kTopMargin = 10,
+		kLeftMargin = 10
+	};
+
+private:
+	void draw(const Graphics::Font *font, const Graphics::PixelFormat &format);
+
+	enum {
+		kUpdateInterval = 500, /** < Delay between two redraws of the HUD (in milliseconds) */
+		kPadding = 4,
+		kGraphHeight = 32,
+		kGraphMaxTime = 50     /** < Frame time shown at the top of the graph (in milliseconds) */
+	};
+
+	bool _visible;
+	Graphics::FrameHistory _frameTimes;
+	uint32 _lastPresentTime;
+	uint32 _lastUpdateTime;
+	uint32 _uploadedBytes;
+	uint _uploadedFrames;
+	uint _uploadedBytesPerFrame;
+	Graphics::Surface _surface;
+};
+
+#endif
@@ -38,7 +38,7 @@
 SdlGraphicsManager::SdlGraphicsManager(SdlEventSource *source, SdlWindow *window)
 	: _eventSource(source), _window(window), _hwScreen(nullptr)
 #if SDL_VERSION_ATLEAST(2, 0, 0)
-	, _allowWindowSizeReset(false), _hintedWidth(0), _hintedHeight(0), _lastFlags(0)
+	, _hardwareCursor(nullptr), _allowWindowSizeReset(false), _hintedWidth(0), _hintedHeight(0), _lastFlags(0)
 #endif
 {
 	ConfMan.registerDefault("fullscreen_res", "desktop");
@@ -46,6 +46,15 @@ SdlGraphicsManager::SdlGraphicsManager(SdlEventSource *source, SdlWindow *window
 	SDL_GetMouseState(&_cursorX, &_cursorY);
 }
 
+SdlGraphicsManager::~SdlGraphicsManager() {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	if (_hardwareCursor) {
+		SDL_SetCursor(SDL_GetDefaultCursor());
+		SDL_FreeCursor(_hardwareCursor);
+	}
+#endif
+}
+
 void SdlGraphicsManager::activateManager() {
 	_eventSource->setGraphicsManager(this);
 
@@ -54,6 +63,11 @@ void SdlGraphicsManager::activateManager() {
 }
 
 void SdlGraphicsManager::deactivateManager() {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	// The next graphics manager draws its own cursor
+	setHardwareCursor(nullptr, 0, 0);
+#endif
+
 	// Unregister the event observer
 	if (g_system->getEventManager()->getEventDispatcher()) {
 		g_system->getEventManager()->getEventDispatcher()->unregisterObserver(this);
@@ -202,22 +216,59 @@ bool SdlGraphicsManager::showMouse(bool visible) {
 		return visible;
 	}
 
-	int showCursor = SDL_DISABLE;
-	if (visible) {
-		// _cursorX and _cursorY are currently always clipped to the active
-		// area, so we need to ask SDL where the system's mouse cursor is
-		// instead
-		int x, y;
-		SDL_GetMouseState(&x, &y);
-		if (!_activeArea.drawRect.contains(Common::Point(x, y))) {
-			showCursor = SDL_ENABLE;
+	// _cursorX and _cursorY are currently always clipped to the active
+	// area, so we need to ask SDL where the system's mouse cursor is
+	// instead
+	int x, y;
+	SDL_GetMouseState(&x, &y);
+	updateSystemCursor(visible, _activeArea.drawRect.contains(Common::Point(x, y)));
+
+	return WindowedGraphicsManager::showMouse(visible);
+}
+
+void SdlGraphicsManager::updateSystemCursor(bool visible, bool inActiveArea) {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	if (_hardwareCursor) {
+		if (visible && inActiveArea) {
+			if (SDL_GetCursor() != _hardwareCursor)
+				SDL_SetCursor(_hardwareCursor);
+			SDL_ShowCursor(SDL_ENABLE);
+			return;
 		}
+
+		if (SDL_GetCursor() == _hardwareCursor)
+			SDL_SetCursor(SDL_GetDefaultCursor());
 	}
-	SDL_ShowCursor(showCursor);
+#endif
 
-	return WindowedGraphicsManager::showMouse(visible);
+	SDL_ShowCursor(visible && !inActiveArea ? SDL_ENABLE : SDL_DISABLE);
 }
 
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+void SdlGraphicsManager::setHardwareCursor(SDL_Surface *surface, int hotspotX, int hotspotY) {
+	SDL_Cursor *oldCursor = _hardwareCursor;
+	if (!surface && !oldCursor)
+		return;
+
+	_hardwareCursor = nullptr;
+	if (surface) {
+		_hardwareCursor = SDL_CreateColorCursor(surface, hotspotX, hotspotY);
+		if (!_hardwareCursor)
+			warning("Could not create hardware cursor: %s", SDL_GetError());
+	}
+
+	if (oldCursor && SDL_GetCursor() == oldCursor)
+		SDL_SetCursor(SDL_GetDefaultCursor());
+
+	int x, y;
+	SDL_GetMouseState(&x, &y);
+	updateSystemCursor(_cursorVisible, _activeArea.drawRect.contains(Common::Point(x, y)));
+
+	if (oldCursor)
+		SDL_FreeCursor(oldCursor);
+}
+#endif
+
 bool SdlGraphicsManager::lockMouse(bool lock) {
 	return _window->lockMouse(lock);
 }
@@ -226,7 +277,7 @@ bool SdlGraphicsManager::notifyMousePosition(Common::Point &mouse) {
 	mouse.x = CLIP<int16>(mouse.x, 0, _windowWidth - 1);
 	mouse.y = CLIP<int16>(mouse.y, 0, _windowHeight - 1);
 
-	int showCursor = SDL_DISABLE;
+	bool inActiveArea = true;
 	// DPI aware scaling to mouse position
 	uint scale = getFeatureState(BaseBackend::kFeatureHiDPI) ? 2 : 1;
 	mouse.x *= scale;
@@ -258,13 +309,11 @@ bool SdlGraphicsManager::notifyMousePosition(Common::Point &mouse) {
 				valid = false;
 			}
 
-			if (_cursorVisible) {
-				showCursor = SDL_ENABLE;
-			}
+			inActiveArea = false;
 		}
 	}
 
-	SDL_ShowCursor(showCursor);
+	updateSystemCursor(_cursorVisible, inActiveArea);
 	if (valid) {
 		setMousePosition(mouse.x, mouse.y);
 		mouse = convertWindowToVirtual(mouse.x, mouse.y);
@@ -380,6 +429,10 @@ bool SdlGraphicsManager::notifyEvent(const Common::Event &event) {
 		saveScreenshot();
 		return true;
 
+	case kActionTogglePerformanceHud:
+		togglePerformanceHud();
+		return true;
+
 	default:
 		return false;
 	}
@@ -469,5 +522,12 @@ Common::Keymap *SdlGraphicsManager::getKeymap() {
 	act->setCustomBackendActionEvent(kActionPreviousScaleFilter);
 	keymap->addAction(act);
 
+#ifdef USE_OSD
+	act = new Action("PHUD", _("Toggle performance statistics"));
+	act->addDefaultInputMapping("C+A+p");
+	act->setCustomBackendActionEvent(kActionTogglePerformanceHud);
+	keymap->addAction(act);
+#endif
+
 	return keymap;
 }
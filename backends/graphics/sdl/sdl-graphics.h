@@ -41,7 +41,7 @@ class SdlEventSource;
 class SdlGraphicsManager : virtual public WindowedGraphicsManager, public Common::EventObserver {
 public:
 	SdlGraphicsManager(SdlEventSource *source, SdlWindow *window);
-	virtual ~SdlGraphicsManager() {}
+	virtual ~SdlGraphicsManager();
 
 	/**
 	 * Makes this graphics manager active. That means it should be ready to
@@ -148,7 +148,8 @@ protected:
 		kActionIncreaseScaleFactor,
 		kActionDecreaseScaleFactor,
 		kActionNextScaleFilter,
-		kActionPreviousScaleFilter
+		kActionPreviousScaleFilter,
+		kActionTogglePerformanceHud
 	};
 
 	/** Obtain the user configured fullscreen resolution, or default to the desktop resolution */
@@ -223,6 +224,36 @@ protected:
 
 	virtual void handleResizeImpl(const int width, const int height) override;
 
+	/**
+	 * Shows or hides the system mouse cursor. Inside the active area this is
+	 * the hardware cursor if one is set, otherwise the system cursor is only
+	 * shown outside of it.
+	 *
+	 * @param visible Whether the game's mouse cursor should be visible.
+	 * @param inActiveArea Whether the mouse is inside the active area.
+	 */
+	void updateSystemCursor(bool visible, bool inActiveArea);
+
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	/**
+	 * Lets the system draw the mouse cursor inside the active area. Since the
+	 * hardware cursor is composited by the window system, moving it does not
+	 * require presenting a new frame.
+	 *
+	 * @param surface The cursor image, or nullptr to remove the hardware
+	 * cursor again.
+	 * @param hotspotX The hotspot X coordinate inside the image.
+	 * @param hotspotY The hotspot Y coordinate inside the image.
+	 */
+	void setHardwareCursor(SDL_Surface *surface, int hotspotX, int hotspotY);
+
+	bool hasHardwareCursor() const { return _hardwareCursor != nullptr; }
+
+	SDL_Cursor *_hardwareCursor;
+#else
+	bool hasHardwareCursor() const { return false; }
+#endif
+
 #if SDL_VERSION_ATLEAST(2, 0, 0)
 public:
 	void unlockWindowSize() {
@@ -106,7 +106,7 @@ SurfaceSdlGraphicsManager::SurfaceSdlGraphicsManager(SdlEventSource *sdlEventSou
 	SdlGraphicsManager(sdlEventSource, window),
 #ifdef USE_OSD
 	_osdMessageSurface(nullptr), _osdMessageAlpha(SDL_ALPHA_TRANSPARENT), _osdMessageFadeStartTime(0),
-	_osdIconSurface(nullptr),
+	_osdIconSurface(nullptr), _performanceHudSurface(nullptr),
 #endif
 #if SDL_VERSION_ATLEAST(2, 0, 0)
 	_renderer(nullptr), _screenTexture(nullptr),
@@ -122,6 +122,7 @@ SurfaceSdlGraphicsManager::SurfaceSdlGraphicsManager(SdlEventSource *sdlEventSou
 	_screenChangeCount(0),
 	_mouseData(nullptr), _mouseSurface(nullptr),
 	_mouseOrigSurface(nullptr), _cursorDontScale(false), _cursorPaletteDisabled(true),
+	_hardwareCursorDirty(true),
 	_currentShakeXOffset(0), _currentShakeYOffset(0),
 	_paletteDirtyStart(0), _paletteDirtyEnd(0),
 	_screenIsLocked(false),
@@ -131,6 +132,8 @@ SurfaceSdlGraphicsManager::SurfaceSdlGraphicsManager(SdlEventSource *sdlEventSou
 #endif
 	_transactionMode(kTransactionNone),
 	_scalerPlugins(ScalerMan.getPlugins()),
+	_scalerThread(nullptr), _scalerMutex(nullptr), _scalerStart(nullptr), _scalerDone(nullptr),
+	_scalerBusy(false), _scalerQuit(false), _pipelinedFramePending(false),
 	_needRestoreAfterOverlay(false) {
 
 	// allocate palette storage
@@ -153,6 +156,20 @@ SurfaceSdlGraphicsManager::SurfaceSdlGraphicsManager(SdlEventSource *sdlEventSou
 
 	_scalerPlugin = NULL;
 	_maxExtraPixels = ScalerMan.getMaxExtraPixels();
+	_scalerThreadPool = g_system->createThreadPool(MAX(ConfMan.getInt("scaler_threads"), 0));
+
+	if (ConfMan.getBool("scaler_pipeline")) {
+		_scalerMutex = SDL_CreateMutex();
+		_scalerStart = SDL_CreateCond();
+		_scalerDone = SDL_CreateCond();
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+		_scalerThread = SDL_CreateThread(scalerThreadProc, "ScummVM Screen", this);
+#else
+		_scalerThread = SDL_CreateThread(scalerThreadProc, this);
+#endif
+		if (!_scalerThread)
+			warning("Could not create screen scaling thread: %s", SDL_GetError());
+	}
 
 	_videoMode.fullscreen = ConfMan.getBool("fullscreen");
 	_videoMode.filtering = ConfMan.getBool("filtering");
@@ -166,6 +183,22 @@ SurfaceSdlGraphicsManager::SurfaceSdlGraphicsManager(SdlEventSource *sdlEventSou
 
 SurfaceSdlGraphicsManager::~SurfaceSdlGraphicsManager() {
 	unloadGFXMode();
+	if (_scalerThread) {
+		SDL_LockMutex(_scalerMutex);
+		_scalerQuit = true;
+		SDL_CondSignal(_scalerStart);
+		SDL_UnlockMutex(_scalerMutex);
+		SDL_WaitThread(_scalerThread, nullptr);
+	}
+	if (_scalerMutex) {
+		SDL_DestroyCond(_scalerDone);
+		SDL_DestroyCond(_scalerStart);
+		SDL_DestroyMutex(_scalerMutex);
+	}
+	// The scaler plugins outlive the graphics manager
+	if (_scalerPlugin)
+		_scalerPlugin->setThreadPool(nullptr);
+	delete _scalerThreadPool;
 	if (_mouseOrigSurface) {
 		SDL_FreeSurface(_mouseOrigSurface);
 		if (_mouseOrigSurface == _mouseSurface) {
@@ -265,6 +298,9 @@ int SurfaceSdlGraphicsManager::getGraphicsMode() const {
 void SurfaceSdlGraphicsManager::beginGFXTransaction() {
 	assert(_transactionMode == kTransactionNone);
 
+	// The transaction might change what the scaler thread works with
+	finishPipelinedFrame();
+
 	_transactionMode = kTransactionActive;
 
 	_transactionDetails.sizeChanged = false;
@@ -608,11 +644,14 @@ void SurfaceSdlGraphicsManager::setGraphicsModeIntern() {
 #endif
 		) {
 		Graphics::PixelFormat format = convertSDLPixelFormat(_hwScreen->format);
-		if (_scalerPlugin)
+		if (_scalerPlugin) {
+			_scalerPlugin->setThreadPool(nullptr);
 			_scalerPlugin->deinitialize();
+		}
 
 		_scalerPlugin = &_scalerPlugins[_videoMode.scalerIndex]->get<ScalerPluginObject>();
 		_scalerPlugin->initialize(format);
+		_scalerPlugin->setThreadPool(_scalerThreadPool);
 	}
 
 	_scalerPlugin->setFactor(_videoMode.scaleFactor);
@@ -935,6 +974,8 @@ bool SurfaceSdlGraphicsManager::loadGFXMode() {
 }
 
 void SurfaceSdlGraphicsManager::unloadGFXMode() {
+	cancelPipelinedFrame();
+
 	if (_screen) {
 		SDL_FreeSurface(_screen);
 		_screen = NULL;
@@ -974,6 +1015,11 @@ void SurfaceSdlGraphicsManager::unloadGFXMode() {
 		SDL_FreeSurface(_osdIconSurface);
 		_osdIconSurface = NULL;
 	}
+
+	if (_performanceHudSurface) {
+		SDL_FreeSurface(_performanceHudSurface);
+		_performanceHudSurface = NULL;
+	}
 #endif
 
 #if defined(WIN32) && !SDL_VERSION_ATLEAST(2, 0, 0)
@@ -989,6 +1035,8 @@ bool SurfaceSdlGraphicsManager::hotswapGFXMode() {
 	if (!_screen)
 		return false;
 
+	cancelPipelinedFrame();
+
 	// Keep around the old _screen & _overlayscreen so we can restore the screen data
 	// after the mode switch.
 	SDL_Surface *old_screen = _screen;
@@ -1134,9 +1182,15 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 	// Add the area covered by the mouse cursor to the list of dirty rects if
 	// we have to redraw the mouse, or if the cursor is alpha-blended since
 	// alpha-blended cursors will happily blend into themselves if the surface
-	// under the cursor is not reset first
-	if (_cursorNeedsRedraw || _cursorFormat.bytesPerPixel == 4)
+	// under the cursor is not reset first. The hardware cursor is not part of
+	// the frame, so moving it does not need a redraw; we only remove the
+	// software cursor which may still be on the screen.
+	if (updateHardwareCursor()) {
+		undrawMouse();
+		_cursorNeedsRedraw = false;
+	} else if (_cursorNeedsRedraw || _cursorFormat.bytesPerPixel == 4) {
 		undrawMouse();
+	}
 
 #ifdef USE_OSD
 	updateOSD();
@@ -1156,7 +1210,6 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 	if (_numDirtyRects > 0 || _cursorNeedsRedraw) {
 		SDL_Rect *r;
 		SDL_Rect dst;
-		uint32 srcPitch, dstPitch;
 		SDL_Rect *lastRect = _dirtyRectList + _numDirtyRects;
 
 		for (r = _dirtyRectList; r != lastRect; ++r) {
@@ -1168,160 +1221,281 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 				error("SDL_BlitSurface failed: %s", SDL_GetError());
 		}
 
-		SDL_LockSurface(srcSurf);
-		SDL_LockSurface(_hwScreen);
+		ScaledFrame frame;
+		frame.srcSurf = srcSurf;
+		frame.width = width;
+		frame.height = height;
+		frame.scaleFactor = scale1;
+		frame.oldScaleFactor = oldScaleFactor;
+		frame.shakeXOffset = _currentShakeXOffset;
+		frame.shakeYOffset = _currentShakeYOffset;
+		frame.aspectRatioCorrection = _videoMode.aspectRatioCorrection && !_overlayVisible;
+		frame.forceRedraw = _forceRedraw;
+
+		if (_scalerThread) {
+			// Hand the frame to the scaler thread. The next one can start
+			// with a clean dirty rect list, and the scale factor is set back
+			// once this frame is presented.
+			_pipelinedFrame = frame;
+			memcpy(_pipelinedDirtyRects, _dirtyRectList, _numDirtyRects * sizeof(SDL_Rect));
+			_numPipelinedDirtyRects = _numDirtyRects;
+			_pipelinedFramePending = true;
+
+			SDL_LockMutex(_scalerMutex);
+			_scalerBusy = true;
+			SDL_CondSignal(_scalerStart);
+			SDL_UnlockMutex(_scalerMutex);
+
+			_numDirtyRects = 0;
+			_forceRedraw = false;
+			_cursorNeedsRedraw = false;
+			return;
+		}
 
-		srcPitch = srcSurf->pitch;
-		dstPitch = _hwScreen->pitch;
+		scaleFrame(frame, _dirtyRectList, _numDirtyRects);
+		presentFrame(frame);
+	}
 
-		for (r = _dirtyRectList; r != lastRect; ++r) {
-			int dst_x = r->x + _currentShakeXOffset;
-			int dst_y = r->y + _currentShakeYOffset;
-			int dst_w = 0;
-			int dst_h = 0;
+	// Set up the old scale factor
+	_scalerPlugin->setFactor(oldScaleFactor);
+
+	_numDirtyRects = 0;
+	_forceRedraw = false;
+	_cursorNeedsRedraw = false;
+}
+
+void SurfaceSdlGraphicsManager::scaleFrame(const ScaledFrame &frame, SDL_Rect *dirtyRects, int numDirtyRects) {
+	SDL_Surface *srcSurf = frame.srcSurf;
+	const int width = frame.width;
+	const int height = frame.height;
+	const int scale1 = frame.scaleFactor;
+
+	SDL_LockSurface(srcSurf);
+	SDL_LockSurface(_hwScreen);
+
+	const uint32 srcPitch = srcSurf->pitch;
+	const uint32 dstPitch = _hwScreen->pitch;
+
+	SDL_Rect *lastRect = dirtyRects + numDirtyRects;
+	for (SDL_Rect *r = dirtyRects; r != lastRect; ++r) {
+		int dst_x = r->x + frame.shakeXOffset;
+		int dst_y = r->y + frame.shakeYOffset;
+		int dst_w = 0;
+		int dst_h = 0;
 #ifdef USE_ASPECT
-			int orig_dst_y = 0;
+		int orig_dst_y = 0;
 #endif
 
-			if (dst_x < width && dst_y < height) {
-				dst_w = r->w;
-				if (dst_w > width - dst_x)
-					dst_w = width - dst_x;
+		if (dst_x < width && dst_y < height) {
+			dst_w = r->w;
+			if (dst_w > width - dst_x)
+				dst_w = width - dst_x;
 
-				dst_h = r->h;
-				if (dst_h > height - dst_y)
-					dst_h = height - dst_y;
+			dst_h = r->h;
+			if (dst_h > height - dst_y)
+				dst_h = height - dst_y;
 
 #ifdef USE_ASPECT
-				orig_dst_y = dst_y;
+			orig_dst_y = dst_y;
 #endif
-				dst_x *= scale1;
-				dst_y *= scale1;
+			dst_x *= scale1;
+			dst_y *= scale1;
 
-				if (_videoMode.aspectRatioCorrection && !_overlayVisible)
-					dst_y = real2Aspect(dst_y);
+			if (frame.aspectRatioCorrection)
+				dst_y = real2Aspect(dst_y);
 
-				_scalerPlugin->scale((byte *)srcSurf->pixels + (r->x + _maxExtraPixels) * 2 + (r->y + _maxExtraPixels) * srcPitch, srcPitch,
-					(byte *)_hwScreen->pixels + dst_x * 2 + dst_y * dstPitch, dstPitch, r->w, dst_h, r->x, r->y);
-			}
+			_scalerPlugin->scale((byte *)srcSurf->pixels + (r->x + _maxExtraPixels) * 2 + (r->y + _maxExtraPixels) * srcPitch, srcPitch,
+				(byte *)_hwScreen->pixels + dst_x * 2 + dst_y * dstPitch, dstPitch, r->w, dst_h, r->x, r->y);
+		}
 
-			r->x = dst_x;
-			r->y = dst_y;
-			r->w = dst_w * scale1;
-			r->h = dst_h * scale1;
+		r->x = dst_x;
+		r->y = dst_y;
+		r->w = dst_w * scale1;
+		r->h = dst_h * scale1;
 
 #ifdef USE_ASPECT
-			if (_videoMode.aspectRatioCorrection && orig_dst_y < height && !_overlayVisible)
-				r->h = stretch200To240((uint8 *) _hwScreen->pixels, dstPitch, r->w, r->h, r->x, r->y, orig_dst_y * scale1, _videoMode.filtering, convertSDLPixelFormat(_hwScreen->format));
+		if (frame.aspectRatioCorrection && orig_dst_y < height)
+			r->h = stretch200To240((uint8 *) _hwScreen->pixels, dstPitch, r->w, r->h, r->x, r->y, orig_dst_y * scale1, _videoMode.filtering, convertSDLPixelFormat(_hwScreen->format));
 #endif
-		}
-		SDL_UnlockSurface(srcSurf);
-		SDL_UnlockSurface(_hwScreen);
-
-		// Readjust the dirty rect list in case we are doing a full update.
-		// This is necessary if shaking is active.
-		if (_forceRedraw) {
-			_dirtyRectList[0].x = 0;
-			_dirtyRectList[0].y = 0;
-			_dirtyRectList[0].w = _videoMode.hardwareWidth;
-			_dirtyRectList[0].h = _videoMode.hardwareHeight;
-		}
+	}
+	SDL_UnlockSurface(srcSurf);
+	SDL_UnlockSurface(_hwScreen);
+
+	// Readjust the dirty rect list in case we are doing a full update.
+	// This is necessary if shaking is active.
+	if (frame.forceRedraw) {
+		dirtyRects[0].x = 0;
+		dirtyRects[0].y = 0;
+		dirtyRects[0].w = _videoMode.hardwareWidth;
+		dirtyRects[0].h = _videoMode.hardwareHeight;
+	}
+}
 
-		drawMouse();
+void SurfaceSdlGraphicsManager::presentFrame(const ScaledFrame &frame) {
+	drawMouse();
 
 #ifdef USE_OSD
-		drawOSD();
+	drawOSD();
 #endif
 
 #ifdef USE_SDL_DEBUG_FOCUSRECT
-		// We draw the focus rectangle on top of everything, to assure it's easily visible.
-		// Of course when the overlay is visible we do not show it, since it is only for game
-		// specific focus.
-		if (_enableFocusRect && !_overlayVisible) {
-			int x = _focusRect.left + _currentShakeXOffset;
-			int y = _focusRect.top + _currentShakeYOffset;
-
-			if (x < width && y < height) {
-				int w = _focusRect.width();
-				if (w > width - x)
-					w = width - x;
-
-				int h = _focusRect.height();
-				if (h > height - y)
-					h = height - y;
-
-				x *= scale1;
-				y *= scale1;
-				w *= scale1;
-				h *= scale1;
-
-				if (_videoMode.aspectRatioCorrection && !_overlayVisible)
-					y = real2Aspect(y);
-
-				if (h > 0 && w > 0) {
-					SDL_LockSurface(_hwScreen);
-
-					// Use white as color for now.
-					Uint32 rectColor = SDL_MapRGB(_hwScreen->format, 0xFF, 0xFF, 0xFF);
-
-					// First draw the top and bottom lines
-					// then draw the left and right lines
-					if (_hwScreen->format->BytesPerPixel == 2) {
-						uint16 *top = (uint16 *)((byte *)_hwScreen->pixels + y * _hwScreen->pitch + x * 2);
-						uint16 *bottom = (uint16 *)((byte *)_hwScreen->pixels + (y + h) * _hwScreen->pitch + x * 2);
-						byte *left = ((byte *)_hwScreen->pixels + y * _hwScreen->pitch + x * 2);
-						byte *right = ((byte *)_hwScreen->pixels + y * _hwScreen->pitch + (x + w - 1) * 2);
-
-						while (w--) {
-							*top++ = rectColor;
-							*bottom++ = rectColor;
-						}
-
-						while (h--) {
-							*(uint16 *)left = rectColor;
-							*(uint16 *)right = rectColor;
-
-							left += _hwScreen->pitch;
-							right += _hwScreen->pitch;
-						}
-					} else if (_hwScreen->format->BytesPerPixel == 4) {
-						uint32 *top = (uint32 *)((byte *)_hwScreen->pixels + y * _hwScreen->pitch + x * 4);
-						uint32 *bottom = (uint32 *)((byte *)_hwScreen->pixels + (y + h) * _hwScreen->pitch + x * 4);
-						byte *left = ((byte *)_hwScreen->pixels + y * _hwScreen->pitch + x * 4);
-						byte *right = ((byte *)_hwScreen->pixels + y * _hwScreen->pitch + (x + w - 1) * 4);
-
-						while (w--) {
-							*top++ = rectColor;
-							*bottom++ = rectColor;
-						}
-
-						while (h--) {
-							*(uint32 *)left = rectColor;
-							*(uint32 *)right = rectColor;
-
-							left += _hwScreen->pitch;
-							right += _hwScreen->pitch;
-						}
+	// We draw the focus rectangle on top of everything, to assure it's easily visible.
+	// Of course when the overlay is visible we do not show it, since it is only for game
+	// specific focus.
+	if (_enableFocusRect && !_overlayVisible) {
+		int x = _focusRect.left + frame.shakeXOffset;
+		int y = _focusRect.top + frame.shakeYOffset;
+
+		if (x < frame.width && y < frame.height) {
+			int w = _focusRect.width();
+			if (w > frame.width - x)
+				w = frame.width - x;
+
+			int h = _focusRect.height();
+			if (h > frame.height - y)
+				h = frame.height - y;
+
+			x *= frame.scaleFactor;
+			y *= frame.scaleFactor;
+			w *= frame.scaleFactor;
+			h *= frame.scaleFactor;
+
+			if (frame.aspectRatioCorrection)
+				y = real2Aspect(y);
+
+			if (h > 0 && w > 0) {
+				SDL_LockSurface(_hwScreen);
+
+				// Use white as color for now.
+				Uint32 rectColor = SDL_MapRGB(_hwScreen->format, 0xFF, 0xFF, 0xFF);
+
+				// First draw the top and bottom lines
+				// then draw the left and right lines
+				if (_hwScreen->format->BytesPerPixel == 2) {
+					uint16 *top = (uint16 *)((byte *)_hwScreen->pixels + y * _hwScreen->pitch + x * 2);
+					uint16 *bottom = (uint16 *)((byte *)_hwScreen->pixels + (y + h) * _hwScreen->pitch + x * 2);
+					byte *left = ((byte *)_hwScreen->pixels + y * _hwScreen->pitch + x * 2);
+					byte *right = ((byte *)_hwScreen->pixels + y * _hwScreen->pitch + (x + w - 1) * 2);
+
+					while (w--) {
+						*top++ = rectColor;
+						*bottom++ = rectColor;
+					}
+
+					while (h--) {
+						*(uint16 *)left = rectColor;
+						*(uint16 *)right = rectColor;
+
+						left += _hwScreen->pitch;
+						right += _hwScreen->pitch;
+					}
+				} else if (_hwScreen->format->BytesPerPixel == 4) {
+					uint32 *top = (uint32 *)((byte *)_hwScreen->pixels + y * _hwScreen->pitch + x * 4);
+					uint32 *bottom = (uint32 *)((byte *)_hwScreen->pixels + (y + h) * _hwScreen->pitch + x * 4);
+					byte *left = ((byte *)_hwScreen->pixels + y * _hwScreen->pitch + x * 4);
+					byte *right = ((byte *)_hwScreen->pixels + y * _hwScreen->pitch + (x + w - 1) * 4);
+
+					while (w--) {
+						*top++ = rectColor;
+						*bottom++ = rectColor;
 					}
 
-					SDL_UnlockSurface(_hwScreen);
+					while (h--) {
+						*(uint32 *)left = rectColor;
+						*(uint32 *)right = rectColor;
+
+						left += _hwScreen->pitch;
+						right += _hwScreen->pitch;
+					}
 				}
+
+				SDL_UnlockSurface(_hwScreen);
 			}
 		}
+	}
 #endif
 
-		// Finally, blit all our changes to the screen
-		if (!_displayDisabled) {
-			SDL_UpdateRects(_hwScreen, _numDirtyRects, _dirtyRectList);
+	// Finally, blit all our changes to the screen
+	if (!_displayDisabled) {
+		SDL_UpdateRects(_hwScreen, _numDirtyRects, _dirtyRectList);
+
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+		// The whole screen is uploaded to the screen texture
+		uint uploadedBytes = _hwScreen->h * _hwScreen->pitch;
+#else
+		uint uploadedBytes = 0;
+		for (int i = 0; i < _numDirtyRects; ++i)
+			uploadedBytes += _dirtyRectList[i].w * _dirtyRectList[i].h * _hwScreen->format->BytesPerPixel;
+#endif
+		_performanceHud.framePresented(uploadedBytes);
+	}
+}
+}
+
+int SDLCALL SurfaceSdlGraphicsManager::scalerThreadProc(void *manager) {
+	SurfaceSdlGraphicsManager *self = (SurfaceSdlGraphicsManager *)manager;
+
+	SDL_LockMutex(self->_scalerMutex);
+	while (!self->_scalerQuit) {
+		if (self->_scalerBusy) {
+			SDL_UnlockMutex(self->_scalerMutex);
+			self->scaleFrame(self->_pipelinedFrame, self->_pipelinedDirtyRects, self->_numPipelinedDirtyRects);
+			SDL_LockMutex(self->_scalerMutex);
+
+			self->_scalerBusy = false;
+			SDL_CondSignal(self->_scalerDone);
+		} else {
+			SDL_CondWait(self->_scalerStart, self->_scalerMutex);
 		}
 	}
+	SDL_UnlockMutex(self->_scalerMutex);
 
-	// Set up the old scale factor
-	_scalerPlugin->setFactor(oldScaleFactor);
+	return 0;
+}
 
-	_numDirtyRects = 0;
-	_forceRedraw = false;
-	_cursorNeedsRedraw = false;
+void SurfaceSdlGraphicsManager::waitForScalerThread() const {
+	if (!_scalerThread)
+		return;
+
+	SDL_LockMutex(_scalerMutex);
+	while (_scalerBusy)
+		SDL_CondWait(_scalerDone, _scalerMutex);
+	SDL_UnlockMutex(_scalerMutex);
+}
+
+void SurfaceSdlGraphicsManager::finishPipelinedFrame() {
+	if (!_pipelinedFramePending)
+		return;
+
+	waitForScalerThread();
+	_pipelinedFramePending = false;
+
+	// The cursor is drawn onto the frame and added to its areas to update,
+	// so put its dirty rects in place of the ones of the next frame.
+	SDL_Rect nextDirtyRects[NUM_DIRTY_RECT];
+	const int numNextDirtyRects = _numDirtyRects;
+	const bool nextForceRedraw = _forceRedraw;
+	memcpy(nextDirtyRects, _dirtyRectList, numNextDirtyRects * sizeof(SDL_Rect));
+
+	memcpy(_dirtyRectList, _pipelinedDirtyRects, _numPipelinedDirtyRects * sizeof(SDL_Rect));
+	_numDirtyRects = _numPipelinedDirtyRects;
+	_forceRedraw = _pipelinedFrame.forceRedraw;
+
+	presentFrame(_pipelinedFrame);
+	_scalerPlugin->setFactor(_pipelinedFrame.oldScaleFactor);
+
+	memcpy(_dirtyRectList, nextDirtyRects, numNextDirtyRects * sizeof(SDL_Rect));
+	_numDirtyRects = numNextDirtyRects;
+	_forceRedraw = nextForceRedraw;
+}
+
+void SurfaceSdlGraphicsManager::cancelPipelinedFrame() {
+	if (!_pipelinedFramePending)
+		return;
+
+	waitForScalerThread();
+	_pipelinedFramePending = false;
+	_scalerPlugin->setFactor(_pipelinedFrame.oldScaleFactor);
 }
 
 bool SurfaceSdlGraphicsManager::saveScreenshot(const Common::String &filename) const {
@@ -1329,6 +1503,9 @@ bool SurfaceSdlGraphicsManager::saveScreenshot(const Common::String &filename) c
 
 	Common::StackLock lock(_graphicsMutex);
 
+	// The scaler thread might still be drawing to the screen
+	waitForScalerThread();
+
 	Common::DumpFile out;
 	if (!out.open(filename)) {
 		return false;
@@ -1664,6 +1841,9 @@ void SurfaceSdlGraphicsManager::clearOverlay() {
 	if (!_overlayVisible)
 		return;
 
+	// The scaler and _tmpscreen might still be in use by the scaler thread
+	finishPipelinedFrame();
+
 	// Clear the overlay by making the game screen "look through" everywhere.
 	SDL_Rect src, dst;
 	src.x = src.y = 0;
@@ -1873,6 +2053,7 @@ void SurfaceSdlGraphicsManager::blitCursor() {
 	}
 
 	_cursorNeedsRedraw = true;
+	_hardwareCursorDirty = true;
 
 	int cursorScale;
 	if (_cursorDontScale) {
@@ -2071,6 +2252,77 @@ void SurfaceSdlGraphicsManager::blitCursor() {
 	SDL_UnlockSurface(_mouseOrigSurface);
 }
 
+bool SurfaceSdlGraphicsManager::updateHardwareCursor() {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	const bool usable = _mouseSurface && _hwScreen && _mouseCurState.rW && _mouseCurState.rH &&
+		(_overlayVisible || (_videoMode.scaleFactor == 1 && !_videoMode.aspectRatioCorrection &&
+		                     !_gameScreenShakeXOffset && !_gameScreenShakeYOffset)) &&
+		_activeArea.drawRect.width() == _hwScreen->w && _activeArea.drawRect.height() == _hwScreen->h;
+
+	if (!usable) {
+		if (hasHardwareCursor()) {
+			setHardwareCursor(nullptr, 0, 0);
+			_cursorNeedsRedraw = true;
+		}
+		_hardwareCursorDirty = true;
+		return false;
+	}
+
+	if (!_hardwareCursorDirty)
+		return hasHardwareCursor();
+	_hardwareCursorDirty = false;
+
+	// SDL does not reliably turn color keys into transparency when creating
+	// a cursor, so convert the pre-scaled cursor to ARGB ourselves
+	const int w = _mouseCurState.rW;
+	const int h = _mouseCurState.rH;
+	SDL_Surface *cursor = SDL_CreateRGBSurface(0, w, h, 32, 0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000);
+	if (!cursor) {
+		warning("Could not create hardware cursor surface: %s", SDL_GetError());
+		setHardwareCursor(nullptr, 0, 0);
+		_cursorNeedsRedraw = true;
+		return false;
+	}
+
+	SDL_LockSurface(_mouseSurface);
+	SDL_LockSurface(cursor);
+
+	const SDL_PixelFormat *format = _mouseSurface->format;
+	for (int y = 0; y < h; ++y) {
+		const byte *src = (const byte *)_mouseSurface->pixels + y * _mouseSurface->pitch;
+		uint32 *dst = (uint32 *)((byte *)cursor->pixels + y * cursor->pitch);
+		for (int x = 0; x < w; ++x) {
+			uint8 r, g, b, a;
+			if (format->BytesPerPixel == 4) {
+				const uint32 color = *(const uint32 *)src;
+				SDL_GetRGBA(color, format, &r, &g, &b, &a);
+				if (color == _mouseKeyColor)
+					a = 0;
+			} else {
+				const uint16 color = *(const uint16 *)src;
+				SDL_GetRGB(color, format, &r, &g, &b);
+				a = (color == kMouseColorKey) ? 0 : 0xFF;
+			}
+			*dst++ = a ? ((uint32)a << 24) | (r << 16) | (g << 8) | b : 0;
+			src += format->BytesPerPixel;
+		}
+	}
+
+	SDL_UnlockSurface(cursor);
+	SDL_UnlockSurface(_mouseSurface);
+
+	const bool wasHardwareCursor = hasHardwareCursor();
+	setHardwareCursor(cursor, CLIP<int>(_mouseCurState.rHotX, 0, w - 1), CLIP<int>(_mouseCurState.rHotY, 0, h - 1));
+	SDL_FreeSurface(cursor);
+
+	if (wasHardwareCursor && !hasHardwareCursor())
+		_cursorNeedsRedraw = true;
+	return hasHardwareCursor();
+#else
+	return false;
+#endif
+}
+
 void SurfaceSdlGraphicsManager::undrawMouse() {
 	const int x = _mouseBackup.x;
 	const int y = _mouseBackup.y;
@@ -2085,7 +2337,7 @@ void SurfaceSdlGraphicsManager::undrawMouse() {
 }
 
 void SurfaceSdlGraphicsManager::drawMouse() {
-	if (!_cursorVisible || !_mouseSurface || !_mouseCurState.w || !_mouseCurState.h) {
+	if (!_cursorVisible || !_mouseSurface || !_mouseCurState.w || !_mouseCurState.h || hasHardwareCursor()) {
 		_mouseBackup.x = _mouseBackup.y = _mouseBackup.w = _mouseBackup.h = 0;
 		return;
 	}
@@ -2338,6 +2590,51 @@ void SurfaceSdlGraphicsManager::updateOSD() {
 		// Redraw the area below the icon and message for the transparent blit to give correct results.
 		_forceRedraw = true;
 	}
+
+	updatePerformanceHudSurface();
+}
+
+void SurfaceSdlGraphicsManager::updatePerformanceHudSurface() {
+	if (!_performanceHud.isVisible()) {
+		if (_performanceHudSurface) {
+			SDL_FreeSurface(_performanceHudSurface);
+			_performanceHudSurface = nullptr;
+		}
+		return;
+	}
+
+	const Graphics::Font *font = FontMan.getFontByUsage(Graphics::FontManager::kLocalizedFont);
+	if (!_performanceHud.update(font, convertSDLPixelFormat(_hwScreen->format)) && _performanceHudSurface)
+		return;
+
+	const Graphics::Surface &hud = _performanceHud.getSurface();
+	if (!hud.getPixels())
+		return;
+
+	if (_performanceHudSurface && (_performanceHudSurface->w != hud.w || _performanceHudSurface->h != hud.h ||
+	                               _performanceHudSurface->format->BytesPerPixel != hud.format.bytesPerPixel)) {
+		SDL_FreeSurface(_performanceHudSurface);
+		_performanceHudSurface = nullptr;
+	}
+
+	if (!_performanceHudSurface) {
+		_performanceHudSurface = SDL_CreateRGBSurface(SDL_SWSURFACE,
+			hud.w, hud.h, _hwScreen->format->BitsPerPixel,
+			_hwScreen->format->Rmask, _hwScreen->format->Gmask, _hwScreen->format->Bmask, _hwScreen->format->Amask);
+		if (!_performanceHudSurface)
+			error("updatePerformanceHudSurface: SDL_CreateRGBSurface failed: %s", SDL_GetError());
+	}
+
+	if (SDL_LockSurface(_performanceHudSurface))
+		error("updatePerformanceHudSurface: SDL_LockSurface failed: %s", SDL_GetError());
+
+	Graphics::copyBlit((byte *)_performanceHudSurface->pixels, (const byte *)hud.getPixels(),
+	                   _performanceHudSurface->pitch, hud.pitch, hud.w, hud.h, hud.format.bytesPerPixel);
+
+	SDL_UnlockSurface(_performanceHudSurface);
+
+	// Show the new statistics even if nothing else changed
+	_forceRedraw = true;
 }
 
 void SurfaceSdlGraphicsManager::drawOSD() {
@@ -2350,6 +2647,15 @@ void SurfaceSdlGraphicsManager::drawOSD() {
 		SDL_Rect dstRect = getOSDIconRect();
 		SDL_BlitSurface(_osdIconSurface, 0, _hwScreen, &dstRect);
 	}
+
+	if (_performanceHudSurface) {
+		SDL_Rect dstRect;
+		dstRect.x = PerformanceHud::kLeftMargin;
+		dstRect.y = PerformanceHud::kTopMargin;
+		dstRect.w = _performanceHudSurface->w;
+		dstRect.h = _performanceHudSurface->h;
+		SDL_BlitSurface(_performanceHudSurface, 0, _hwScreen, &dstRect);
+	}
 }
 
 #endif
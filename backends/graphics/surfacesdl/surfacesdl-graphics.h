@@ -160,6 +160,10 @@ protected:
 	SDL_Surface *_osdIconSurface;
 	/** Screen rectangle where the OSD background activity icon is drawn */
 	SDL_Rect getOSDIconRect() const;
+	/** Surface containing the performance statistics */
+	SDL_Surface *_performanceHudSurface;
+	/** Update the performance statistics surface when the statistics changed */
+	void updatePerformanceHudSurface();
 
 	void updateOSD();
 	void drawOSD();
@@ -325,6 +329,7 @@ protected:
 
 	const PluginList &_scalerPlugins;
 	ScalerPluginObject *_scalerPlugin;
+	Common::ThreadPool *_scalerThreadPool;
 	uint _maxExtraPixels;
 	uint _extraPixels;
 
@@ -379,6 +384,9 @@ protected:
 		kMouseColorKey = 1
 	};
 
+	/** Whether the hardware cursor must be recreated from _mouseSurface. */
+	bool _hardwareCursorDirty;
+
 	// Shake mode
 	// This is always set to 0 when building with SDL2.
 	int _currentShakeXOffset;
@@ -409,8 +417,41 @@ protected:
 	virtual void undrawMouse();
 	virtual void blitCursor();
 
+	/**
+	 * Let the system draw the mouse cursor when it would look exactly like
+	 * the one we draw ourselves, i.e. when the screen is shown unscaled and
+	 * the cursor position maps 1:1 to window pixels.
+	 *
+	 * @return whether the hardware cursor is in use.
+	 */
+	bool updateHardwareCursor();
+
 	virtual void internUpdateScreen();
 
+	/**
+	 * How to scale the dirty areas of a frame to the hardware screen.
+	 */
+	struct ScaledFrame {
+		SDL_Surface *srcSurf;
+		int width, height;
+		int scaleFactor, oldScaleFactor;
+		int shakeXOffset, shakeYOffset;
+		bool aspectRatioCorrection;
+		bool forceRedraw;
+	};
+
+	/**
+	 * Scale the dirty areas of a frame to _hwScreen. The dirty rects are
+	 * changed to the areas of _hwScreen to update.
+	 */
+	void scaleFrame(const ScaledFrame &frame, SDL_Rect *dirtyRects, int numDirtyRects);
+
+	/**
+	 * Draw the mouse cursor and the OSD onto the scaled frame, and update
+	 * the areas of the screen in _dirtyRectList.
+	 */
+	void presentFrame(const ScaledFrame &frame);
+
 	virtual bool loadGFXMode();
 	virtual void unloadGFXMode();
 	virtual bool hotswapGFXMode();
@@ -425,6 +466,39 @@ private:
 	void setFullscreenMode(bool enable);
 	void handleScalerHotkeys(uint mode, int factor);
 
+	/**
+	 * Pipelined scaling. updateScreen hands the dirty areas of the frame to
+	 * the scaler thread and returns, and the next updateScreen presents it.
+	 * This lets the engine go on while the frame is scaled, at the cost of
+	 * one frame of latency.
+	 */
+	static int SDLCALL scalerThreadProc(void *manager);
+
+	/** Wait until the scaler thread is done with the pending frame. */
+	void waitForScalerThread() const;
+
+	/** Present the frame scaled by the scaler thread, if any. */
+	void finishPipelinedFrame();
+
+	/** Drop the frame scaled by the scaler thread, if any. */
+	void cancelPipelinedFrame();
+
+	SDL_Thread *_scalerThread;
+	SDL_mutex *_scalerMutex;
+	/** Signalled when a frame is handed to the scaler thread, and when quitting. */
+	SDL_cond *_scalerStart;
+	/** Signalled when the scaler thread is done with a frame. */
+	SDL_cond *_scalerDone;
+	// Protected by _scalerMutex
+	bool _scalerBusy;
+	bool _scalerQuit;
+
+	/** Whether _pipelinedFrame is scaled or being scaled, but not presented. */
+	bool _pipelinedFramePending;
+	ScaledFrame _pipelinedFrame;
+	SDL_Rect _pipelinedDirtyRects[NUM_DIRTY_RECT];
+	int _numPipelinedDirtyRects;
+
 	/**
 	 * Converts the given point from the overlay's coordinate space to the
 	 * game's coordinate space.
@@ -24,6 +24,7 @@
 #define BACKENDS_GRAPHICS_WINDOWED_H
 
 #include "backends/graphics/graphics.h"
+#include "backends/graphics/performance-hud.h"
 #include "common/frac.h"
 #include "common/rect.h"
 #include "common/config-manager.h"
@@ -363,6 +364,20 @@ protected:
 	 */
 	int _cursorX, _cursorY;
 
+	/**
+	 * The performance statistics, which are drawn on top of the screen when
+	 * they are visible.
+	 */
+	PerformanceHud _performanceHud;
+
+	/**
+	 * Show or hide the performance statistics.
+	 */
+	void togglePerformanceHud() {
+		_performanceHud.setVisible(!_performanceHud.isVisible());
+		_forceRedraw = true;
+	}
+
 private:
 	void populateDisplayAreaDrawRect(const frac_t displayAspect, int originalWidth, int originalHeight, Common::Rect &drawRect) const {
 		int mode = getStretchMode();
@@ -527,12 +527,17 @@ bool OpenGLSdlGraphics3dManager::isVSyncEnabled() const {
 
 void OpenGLSdlGraphics3dManager::drawOverlay() {
 	glViewport(0, 0, _overlayScreen->getWidth(), _overlayScreen->getHeight());
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+
+	// When the game renders to a frame buffer, it has already been drawn
+	// below the overlay by updateScreen
+	if (!_frameBuffer) {
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+	}
 
 	_surfaceRenderer->prepareState();
 
 	if (_overlayBackground) {
-		_overlayBackground->draw(_surfaceRenderer);
+		_surfaceRenderer->render(_overlayBackground, Math::Rect2d(Math::Vector2d(0, 0), Math::Vector2d(1, 1)));
 	}
 
 	_surfaceRenderer->enableAlphaBlending(true);
@@ -567,11 +572,6 @@ void OpenGLSdlGraphics3dManager::updateScreen() {
 
 	if (_overlayVisible) {
 		_overlayScreen->update();
-
-		if (_overlayBackground) {
-			_overlayBackground->update();
-		}
-
 		drawOverlay();
 	}
 
@@ -613,15 +613,16 @@ void OpenGLSdlGraphics3dManager::showOverlay() {
 	delete _overlayBackground;
 	_overlayBackground = nullptr;
 
-	if (g_engine) {
-		if (_frameBuffer)
-			_frameBuffer->detach();
-		// If there is a game running capture the screen, so that it can be shown "below" the overlay.
-		_overlayBackground = new OpenGL::TiledSurface(_overlayScreen->getWidth(), _overlayScreen->getHeight(), _overlayFormat);
-		Graphics::Surface *background = _overlayBackground->getBackingSurface();
-		glReadPixels(0, 0, background->w, background->h, GL_RGBA, GL_UNSIGNED_BYTE, background->getPixels());
-		if (_frameBuffer)
-			_frameBuffer->attach();
+	// If there is a game running capture the screen, so that it can be shown
+	// "below" the overlay. Games rendering to a frame buffer keep it around,
+	// so it is simply drawn below the overlay. Otherwise the screen is copied
+	// to a texture without leaving the GPU, since reading it back would stall
+	// until the last frame is finished.
+	if (g_engine && !_frameBuffer) {
+		_overlayBackground = new OpenGL::TextureGL(_overlayScreen->getWidth(), _overlayScreen->getHeight());
+		glBindTexture(GL_TEXTURE_2D, _overlayBackground->getTextureName());
+		glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, _overlayBackground->getWidth(), _overlayBackground->getHeight());
+		glBindTexture(GL_TEXTURE_2D, 0);
 	}
 }
 
@@ -662,6 +663,9 @@ void OpenGLSdlGraphics3dManager::closeOverlay() {
 		_overlayScreen = nullptr;
 	}
 
+	delete _overlayBackground;
+	_overlayBackground = nullptr;
+
 	delete _surfaceRenderer;
 	_surfaceRenderer = nullptr;
 
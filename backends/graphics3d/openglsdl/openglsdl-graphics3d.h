@@ -165,7 +165,7 @@ protected:
 	bool _overlayVisible;
 
 	OpenGL::TiledSurface *_overlayScreen;
-	OpenGL::TiledSurface *_overlayBackground;
+	OpenGL::TextureGL *_overlayBackground;
 	OpenGL::SurfaceRenderer *_surfaceRenderer;
 
 	Graphics::PixelFormat _overlayFormat;
@@ -239,6 +239,33 @@ Keymap::KeymapMatch Keymap::getMappedActions(const Event &event, ActionArray &ac
 	return actions.empty() ? kKeymapMatchNone : kKeymapMatchExact;
 }
 
+bool Keymap::isMappableEventType(EventType type) {
+	// Keep in sync with the event types handled by getMappedActions
+	switch (type) {
+	case EVENT_KEYDOWN:
+	case EVENT_KEYUP:
+	case EVENT_LBUTTONDOWN:
+	case EVENT_LBUTTONUP:
+	case EVENT_RBUTTONDOWN:
+	case EVENT_RBUTTONUP:
+	case EVENT_MBUTTONDOWN:
+	case EVENT_MBUTTONUP:
+	case EVENT_WHEELUP:
+	case EVENT_WHEELDOWN:
+	case EVENT_X1BUTTONDOWN:
+	case EVENT_X1BUTTONUP:
+	case EVENT_X2BUTTONDOWN:
+	case EVENT_X2BUTTONUP:
+	case EVENT_JOYBUTTON_DOWN:
+	case EVENT_JOYBUTTON_UP:
+	case EVENT_JOYAXIS_MOTION:
+	case EVENT_CUSTOM_BACKEND_HARDWARE:
+		return true;
+	default:
+		return false;
+	}
+}
+
 void Keymap::setConfigDomain(ConfigManager::Domain *configDomain) {
 	_configDomain = configDomain;
 }
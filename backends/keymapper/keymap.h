@@ -121,6 +121,13 @@ public:
 	 */
 	KeymapMatch getMappedActions(const Event &event, ActionArray &actions) const;
 
+	/**
+	 * Check whether events of the given type can be mapped to actions at all
+	 *
+	 * Events of other types never match, whatever the keymap contents.
+	 */
+	static bool isMappableEventType(EventType type);
+
 	/**
 	 * Adds a new Action to this Map
 	 *
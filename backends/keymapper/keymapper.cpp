@@ -162,7 +162,10 @@ void Keymapper::setEnabledKeymapType(Keymap::KeymapType type) {
 }
 
 List<Event> Keymapper::mapEvent(const Event &ev) {
-	if (!_enabled) {
+	// Mouse motion is by far the most frequent event, and is never mapped.
+	// Pass it and the other unmappable events through without looking at
+	// the keymaps.
+	if (!_enabled || !Keymap::isMappableEventType(ev.type)) {
 		List<Event> originalEvent;
 		originalEvent.push_back(ev);
 		return originalEvent;
@@ -31,7 +31,7 @@
  */
 class MixerManager {
 public:
-	MixerManager() : _mixer(0), _audioSuspended(false) {}
+	MixerManager() : _mixer(0), _audioSuspended(false), _callbackLoad(0) {}
 	virtual ~MixerManager() { delete _mixer; }
 
 	/**
@@ -56,12 +56,22 @@ public:
 	 */
 	virtual int resumeAudio() = 0;
 
+	/**
+	 * Get how long the last audio callback took to mix its samples, in
+	 * percent of the time they last for when played back. Returns 0 when
+	 * the backend does not measure it.
+	 */
+	uint getCallbackLoad() const { return _callbackLoad; }
+
 protected:
 	/** The mixer implementation */
 	Audio::MixerImpl *_mixer;
 
 	/** State of the audio system */
 	bool _audioSuspended;
+
+	/** Audio callback load in percent, updated by the audio thread */
+	volatile uint _callbackLoad;
 };
 
 #endif
@@ -26,6 +26,7 @@
 NullMixerManager::NullMixerManager() : MixerManager() {
 	_outputRate = 22050;
 	_callsCounter = 0;
+	_mixedSamples = 0;
 	_samples = 8192;
 	while (_samples * 16 > _outputRate * 2)
 		_samples >>= 1;
@@ -62,5 +63,20 @@ void NullMixerManager::update(uint8 callbackPeriod) {
 	if ((_callsCounter % callbackPeriod) == 0) {
 		assert(_mixer);
 		_mixer->mixCallback(_samplesBuf, _samples);
+		// The buffer holds 16-bit stereo samples
+		_mixedSamples += _samples / 4;
+	}
+}
+
+void NullMixerManager::mixUntil(uint32 millis) {
+	if (_audioSuspended) {
+		return;
+	}
+
+	assert(_mixer);
+	const uint64 samplesPlayed = (uint64)millis * _outputRate / 1000;
+	while (_mixedSamples + _samples / 4 <= samplesPlayed) {
+		_mixer->mixCallback(_samplesBuf, _samples);
+		_mixedSamples += _samples / 4;
 	}
 }
@@ -42,6 +42,15 @@ public:
 	virtual void init();
 	void update(uint8 callbackPeriod = 10);
 
+	/**
+	 * Mix all the samples which would have been played back by the given
+	 * time, counted from the start of the mixer.
+	 */
+	void mixUntil(uint32 millis);
+
+	/** The number of samples per channel mixed so far. */
+	uint64 getMixedSamples() const { return _mixedSamples; }
+
 	virtual void suspendAudio();
 	virtual int resumeAudio();
 
@@ -50,6 +59,7 @@ private:
 	uint32 _callsCounter;
 	uint32 _samples;
 	uint8 *_samplesBuf;
+	uint64 _mixedSamples;
 };
 
 #endif
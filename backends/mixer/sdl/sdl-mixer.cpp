@@ -186,7 +186,19 @@ void SdlMixerManager::startAudio() {
 
 void SdlMixerManager::callbackHandler(byte *samples, int len) {
 	assert(_mixer);
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	const Uint64 start = SDL_GetPerformanceCounter();
+	_mixer->mixCallback(samples, len);
+	const Uint64 elapsed = SDL_GetPerformanceCounter() - start;
+
+	// The buffer holds 16-bit samples for each channel
+	if (len > 0 && _obtained.channels && _obtained.freq) {
+		const double playbackTime = (double)len / (2 * _obtained.channels * _obtained.freq);
+		_callbackLoad = (uint)(elapsed * 100.0 / (playbackTime * SDL_GetPerformanceFrequency()));
+	}
+#else
 	_mixer->mixCallback(samples, len);
+#endif
 }
 
 void SdlMixerManager::sdlCallback(void *this_, byte *samples, int len) {
@@ -28,6 +28,7 @@
 #include "backends/mutex/mutex.h"
 #include "gui/EventRecorder.h"
 
+#include "common/savefile.h"
 #include "common/timer.h"
 #include "graphics/pixelformat.h"
 #include "graphics/pixelbuffer.h"
@@ -309,6 +310,10 @@ ModularMutexBackend::ModularMutexBackend()
 }
 
 ModularMutexBackend::~ModularMutexBackend() {
+	// _savefileManager needs to be deleted before _timerManager, which runs
+	// its background writer, and before _mutexManager to avoid a crash.
+	delete _savefileManager;
+	_savefileManager = 0;
 	// _timerManager needs to be deleted before _mutexManager to avoid a crash.
 	delete _timerManager;
 	_timerManager = 0;
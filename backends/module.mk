@@ -7,7 +7,9 @@ MODULE_OBJS := \
 	audiocd/default/default-audiocd.o \
 	events/default/default-events.o \
 	fs/abstract-fs.o \
+	fs/mappedfilestream.o \
 	fs/stdiostream.o \
+	graphics/performance-hud.o \
 	keymapper/action.o \
 	keymapper/hardware-input.o \
 	keymapper/input-watcher.o \
@@ -131,6 +133,7 @@ MODULE_OBJS += \
 	graphics/opengl/pipelines/clut8.o \
 	graphics/opengl/pipelines/fixed.o \
 	graphics/opengl/pipelines/pipeline.o \
+	graphics/opengl/pipelines/scaler.o \
 	graphics/opengl/pipelines/shader.o
 endif
 
@@ -147,6 +150,7 @@ MODULE_OBJS += \
 	mixer/sdl/sdl-mixer.o \
 	mutex/sdl/sdl-mutex.o \
 	plugins/sdl/sdl-provider.o \
+	threadpool/sdl/sdl-threadpool.o \
 	timer/sdl/sdl-timer.o
 
 # SDL 2 removed audio CD support
@@ -38,9 +38,16 @@ DECLARE_SINGLETON(Networking::ConnectionManager);
 
 namespace Networking {
 
-ConnectionManager::ConnectionManager(): _multi(0), _timerStarted(false), _frame(0) {
+ConnectionManager::ConnectionManager(): _multi(0), _timerStarted(false),
+	_handleMutex("connection manager handle"), _addedRequestsMutex("connection manager requests"), _frame(0) {
 	curl_global_init(CURL_GLOBAL_ALL);
 	_multi = curl_multi_init();
+
+#if LIBCURL_VERSION_NUM >= 0x072B00
+	// Added in libcurl 7.43.0
+	// Let transfers to the same host share one HTTP/2 connection
+	curl_multi_setopt(_multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+#endif
 }
 
 ConnectionManager::~ConnectionManager() {
@@ -205,6 +212,19 @@ void ConnectionManager::processTransfers() {
 	int transfersRunning;
 	curl_multi_perform(_multi, &transfersRunning);
 
+#if LIBCURL_VERSION_NUM >= 0x071C00
+	// Added in libcurl 7.28.0
+	// Keep reading while sockets have data, instead of leaving it for the
+	// next frame, which would cap the throughput of fast connections.
+	// Don't wait for anything though, this runs on the timer thread.
+	for (uint32 i = 0; transfersRunning && i < MAX_PERFORMS_PER_FRAME; ++i) {
+		int readyFds = 0;
+		if (curl_multi_wait(_multi, nullptr, 0, 0, &readyFds) != CURLM_OK || readyFds == 0)
+			break;
+		curl_multi_perform(_multi, &transfersRunning);
+	}
+#endif
+
 	int messagesInQueue;
 	CURLMsg *curlMsg;
 	while ((curlMsg = curl_multi_info_read(_multi, &messagesInQueue))) {
@@ -108,6 +108,12 @@ void NetworkReadStream::initCurl(const char *url, curl_slist *headersList) {
 	curl_easy_setopt(_easy, CURLOPT_XFERINFODATA, this);
 #endif
 
+#if LIBCURL_VERSION_NUM >= 0x072B00
+	// Added in libcurl 7.43.0
+	// Prefer waiting for a connection that can be multiplexed over opening a new one
+	curl_easy_setopt(_easy, CURLOPT_PIPEWAIT, 1L);
+#endif
+
 #if LIBCURL_VERSION_NUM >= 0x071900
 	// Added in libcurl 7.25.0
 	if (_keepAlive) {
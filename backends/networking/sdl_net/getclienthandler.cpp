@@ -21,6 +21,7 @@
  */
 
 #include "backends/networking/sdl_net/getclienthandler.h"
+#include "common/system.h"
 #include "common/textconsole.h"
 
 namespace Networking {
@@ -126,34 +127,41 @@ void GetClientHandler::handle(Client *client) {
 	if (!_headersPrepared)
 		prepareHeaders();
 
-	uint32 readBytes;
-
-	// send headers first
-	if (_headers.size() > 0) {
-		readBytes = _headers.size();
-		if (readBytes > CLIENT_HANDLER_BUFFER_SIZE)
-			readBytes = CLIENT_HANDLER_BUFFER_SIZE;
-		memcpy(_buffer, _headers.c_str(), readBytes);
-		_headers.erase(0, readBytes);
-	} else {
-		if (!_stream) {
-			client->close();
-			return;
+	// Keep sending while the client takes the data quickly, so that fast
+	// connections aren't limited to one buffer per server frame
+	uint32 start = g_system->getMillis();
+	do {
+		uint32 readBytes;
+
+		// send headers first
+		if (_headers.size() > 0) {
+			readBytes = _headers.size();
+			if (readBytes > CLIENT_HANDLER_BUFFER_SIZE)
+				readBytes = CLIENT_HANDLER_BUFFER_SIZE;
+			memcpy(_buffer, _headers.c_str(), readBytes);
+			_headers.erase(0, readBytes);
+		} else {
+			if (!_stream) {
+				client->close();
+				return;
+			}
+
+			readBytes = _stream->read(_buffer, CLIENT_HANDLER_BUFFER_SIZE);
 		}
 
-		readBytes = _stream->read(_buffer, CLIENT_HANDLER_BUFFER_SIZE);
-	}
+		if (readBytes != 0)
+			if (client->send(_buffer, readBytes) != (int)readBytes) {
+				warning("GetClientHandler: unable to send all bytes to the client");
+				client->close();
+				return;
+			}
 
-	if (readBytes != 0)
-		if (client->send(_buffer, readBytes) != (int)readBytes) {
-			warning("GetClientHandler: unable to send all bytes to the client");
+		// we're done here!
+		if (_stream->eos()) {
 			client->close();
 			return;
 		}
-
-	// we're done here!
-	if (_stream->eos())
-		client->close();
+	} while (g_system->getMillis() - start < CLIENT_HANDLER_TIME_BUDGET);
 }
 
 void GetClientHandler::setHeader(Common::String name, Common::String value) { _specialHeaders[name] = value; }
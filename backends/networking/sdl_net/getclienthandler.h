@@ -31,6 +31,7 @@
 namespace Networking {
 
 #define CLIENT_HANDLER_BUFFER_SIZE 1 * 1024 * 1024
+#define CLIENT_HANDLER_TIME_BUDGET 20 // ms per server frame
 
 class GetClientHandler: public ClientHandler {
 	Common::HashMap<Common::String, Common::String> _specialHeaders;
@@ -34,6 +34,7 @@ Reader::Reader() {
 	_bytesLeft = 0;
 
 	_window = nullptr;
+	_windowStart = 0;
 	_windowUsed = 0;
 	_windowSize = 0;
 
@@ -61,6 +62,7 @@ Reader &Reader::operator=(Reader &r) {
 	r._state = RS_NONE;
 
 	_window = r._window;
+	_windowStart = r._windowStart;
 	_windowUsed = r._windowUsed;
 	_windowSize = r._windowSize;
 	r._window = nullptr;
@@ -306,6 +308,7 @@ void Reader::makeWindow(uint32 size) {
 	freeWindow();
 
 	_window = new byte[size];
+	_windowStart = 0;
 	_windowUsed = 0;
 	_windowSize = size;
 }
@@ -313,17 +316,19 @@ void Reader::makeWindow(uint32 size) {
 void Reader::freeWindow() {
 	delete[] _window;
 	_window = nullptr;
-	_windowUsed = _windowSize = 0;
+	_windowStart = _windowUsed = _windowSize = 0;
 }
 
 namespace {
-bool windowEqualsString(const byte *window, uint32 windowSize, const Common::String &boundary) {
+bool windowEqualsString(const byte *window, uint32 windowStart, uint32 windowSize, const Common::String &boundary) {
 	if (boundary.size() != windowSize)
 		return false;
 
-	for (uint32 i = 0; i < windowSize; ++i) {
-		if (window[i] != boundary[i])
+	for (uint32 i = 0, j = windowStart; i < windowSize; ++i) {
+		if (window[j] != boundary[i])
 			return false;
+		if (++j == windowSize)
+			j = 0;
 	}
 
 	return true;
@@ -332,19 +337,23 @@ bool windowEqualsString(const byte *window, uint32 windowSize, const Common::Str
 
 bool Reader::readOneByteInStream(Common::WriteStream *stream, const Common::String &boundary) {
 	byte b = readOne();
-	_window[_windowUsed++] = b;
-	if (_windowUsed < _windowSize)
+	uint32 end = _windowStart + _windowUsed;
+	if (end >= _windowSize)
+		end -= _windowSize;
+	_window[end] = b;
+	if (++_windowUsed < _windowSize)
 		return true;
 
 	//when window is filled, check whether that's the boundary
-	if (windowEqualsString(_window, _windowSize, boundary))
+	if (windowEqualsString(_window, _windowStart, _windowSize, boundary))
 		return false;
 
 	//if not, add the first byte of the window to the string
+	//and drop it from the window without moving the rest around
 	if (stream)
-		stream->writeByte(_window[0]);
-	for (uint32 i = 1; i < _windowSize; ++i)
-		_window[i - 1] = _window[i];
+		stream->writeByte(_window[_windowStart]);
+	if (++_windowStart == _windowSize)
+		_windowStart = 0;
 	--_windowUsed;
 	return true;
 }
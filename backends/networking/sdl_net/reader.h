@@ -77,8 +77,9 @@ class Reader {
 	Common::MemoryReadWriteStream *_content;
 	uint32 _bytesLeft;
 
+	// Ring buffer with the last bytes read, to look for the boundary
 	byte *_window;
-	uint32 _windowUsed, _windowSize;
+	uint32 _windowStart, _windowUsed, _windowSize;
 
 	Common::MemoryReadWriteStream *_headersStream;
 
@@ -43,6 +43,7 @@ typedef void (*sighandler_t)(int);
 #define FORBIDDEN_SYMBOL_EXCEPTION_stderr
 #define FORBIDDEN_SYMBOL_EXCEPTION_fputs
 #define FORBIDDEN_SYMBOL_EXCEPTION_exit
+#define FORBIDDEN_SYMBOL_EXCEPTION_getenv
 #define FORBIDDEN_SYMBOL_EXCEPTION_time_h
 
 #include "common/scummsys.h"
@@ -50,14 +51,15 @@ typedef void (*sighandler_t)(int);
 #if defined(USE_NULL_DRIVER)
 #include "backends/modular-backend.h"
 #include "base/main.h"
+#include "backends/mixer/null/null-mixer.h"
+#include "backends/mutex/null/null-mutex.h"
 
 #ifndef NULL_DRIVER_USE_FOR_TEST
 #include "backends/saves/default/default-saves.h"
 #include "backends/timer/default/default-timer.h"
 #include "backends/events/default/default-events.h"
-#include "backends/mixer/null/null-mixer.h"
-#include "backends/mutex/null/null-mutex.h"
 #include "backends/graphics/null/null-graphics.h"
+#include "common/file.h"
 #include "gui/debugger.h"
 #endif
 
@@ -86,6 +88,7 @@ public:
 	virtual bool pollEvent(Common::Event &event);
 
 	virtual uint32 getMillis(bool skipRecord = false);
+	virtual uint64 getMicros();
 	virtual void delayMillis(uint msecs);
 	virtual void getTimeAndDate(TimeDate &td, bool skipRecord = false) const;
 
@@ -95,15 +98,41 @@ public:
 
 	virtual void addSysArchivesToSearchSet(Common::SearchSet &s, int priority);
 
+#ifdef NULL_DRIVER_USE_FOR_TEST
+	/**
+	 * The tests never call initBackend(). This sets up the managers they
+	 * need instead, once g_system points to this backend.
+	 */
+	void initTestBackend();
+#endif
+
 private:
+	uint32 getRealMillis() const;
+
+#ifndef NULL_DRIVER_USE_FOR_TEST
+	/**
+	 * Write the counters gathered in benchmark mode as JSON to the file
+	 * named by the SCUMMVM_BENCHMARK environment variable.
+	 */
+	void writeBenchmarkSummary();
+#endif
+
 #ifdef POSIX
 	timeval _startTime;
 #elif defined(WIN32)
 	DWORD _startTime;
 #endif
+
+	/**
+	 * In benchmark mode time is virtual: delays return at once and every
+	 * poll advances the clock, so that a recorded session runs as fast as
+	 * the engine allows while it still sees the usual timing.
+	 */
+	Common::String _benchmarkOutput;
+	uint32 _virtualMillis;
 };
 
-OSystem_NULL::OSystem_NULL() {
+OSystem_NULL::OSystem_NULL() : _virtualMillis(0) {
 	#if defined(__amigaos4__)
 		_fsFactory = new AmigaOSFilesystemFactory();
 	#elif defined(__MORPHOS__)
@@ -120,6 +149,9 @@ OSystem_NULL::OSystem_NULL() {
 }
 
 OSystem_NULL::~OSystem_NULL() {
+#ifndef NULL_DRIVER_USE_FOR_TEST
+	writeBenchmarkSummary();
+#endif
 }
 
 #if defined(POSIX) && !defined(NULL_DRIVER_USE_FOR_TEST)
@@ -145,6 +177,10 @@ void OSystem_NULL::initBackend() {
 	last_handler = signal(SIGINT, intHandler);
 #endif
 
+	const char *benchmarkOutput = getenv("SCUMMVM_BENCHMARK");
+	if (benchmarkOutput && *benchmarkOutput)
+		_benchmarkOutput = benchmarkOutput;
+
 	_mutexManager = new NullMutexManager();
 	_timerManager = new DefaultTimerManager();
 	_eventManager = new DefaultEventManager(this);
@@ -158,10 +194,25 @@ void OSystem_NULL::initBackend() {
 	BaseBackend::initBackend();
 }
 
+#ifdef NULL_DRIVER_USE_FOR_TEST
+void OSystem_NULL::initTestBackend() {
+	_mutexManager = new NullMutexManager();
+	_mixerManager = new NullMixerManager();
+	_mixerManager->init();
+}
+#endif
+
 bool OSystem_NULL::pollEvent(Common::Event &event) {
 #ifndef NULL_DRIVER_USE_FOR_TEST
-	((DefaultTimerManager *)getTimerManager())->checkTimers();
-	((NullMixerManager *)_mixerManager)->update(1);
+	if (!_benchmarkOutput.empty()) {
+		// Let time pass for the loops waiting on the clock
+		_virtualMillis++;
+		((DefaultTimerManager *)getTimerManager())->checkTimers();
+		((NullMixerManager *)_mixerManager)->mixUntil(_virtualMillis);
+	} else {
+		((DefaultTimerManager *)getTimerManager())->checkTimers();
+		((NullMixerManager *)_mixerManager)->update(1);
+	}
 
 #ifdef POSIX
 	if (intReceived) {
@@ -186,6 +237,13 @@ bool OSystem_NULL::pollEvent(Common::Event &event) {
 }
 
 uint32 OSystem_NULL::getMillis(bool skipRecord) {
+	if (!_benchmarkOutput.empty())
+		return _virtualMillis;
+
+	return getRealMillis();
+}
+
+uint32 OSystem_NULL::getRealMillis() const {
 #ifdef POSIX
 	timeval curTime;
 
@@ -200,7 +258,27 @@ uint32 OSystem_NULL::getMillis(bool skipRecord) {
 #endif
 }
 
+uint64 OSystem_NULL::getMicros() {
+	if (!_benchmarkOutput.empty())
+		return (uint64)_virtualMillis * 1000;
+
+#ifdef POSIX
+	timeval curTime;
+
+	gettimeofday(&curTime, 0);
+
+	return (uint64)curTime.tv_sec * 1000000 + curTime.tv_usec;
+#else
+	return OSystem::getMicros();
+#endif
+}
+
 void OSystem_NULL::delayMillis(uint msecs) {
+	if (!_benchmarkOutput.empty()) {
+		_virtualMillis += msecs;
+		return;
+	}
+
 #ifdef POSIX
 	usleep(msecs * 1000);
 #elif defined(WIN32)
@@ -221,9 +299,44 @@ void OSystem_NULL::getTimeAndDate(TimeDate &td, bool skipRecord) const {
 }
 
 void OSystem_NULL::quit() {
+#ifndef NULL_DRIVER_USE_FOR_TEST
+	writeBenchmarkSummary();
+#endif
 	exit(0);
 }
 
+#ifndef NULL_DRIVER_USE_FOR_TEST
+void OSystem_NULL::writeBenchmarkSummary() {
+	if (_benchmarkOutput.empty() || !_graphicsManager || !_mixerManager)
+		return;
+
+	Common::DumpFile out;
+	if (!out.open(_benchmarkOutput, true)) {
+		warning("Could not write the benchmark summary to '%s'", _benchmarkOutput.c_str());
+		return;
+	}
+
+	const NullGraphicsManager *graphics = (const NullGraphicsManager *)_graphicsManager;
+	const NullMixerManager *mixer = (const NullMixerManager *)_mixerManager;
+
+	out.writeString(Common::String::format(
+		"{\n"
+		"\t\"virtual_time_ms\": %u,\n"
+		"\t\"real_time_ms\": %u,\n"
+		"\t\"update_screen_calls\": %u,\n"
+		"\t\"copy_rect_to_screen_bytes\": %llu,\n"
+		"\t\"mixer_samples\": %llu\n"
+		"}\n",
+		_virtualMillis, getRealMillis(), graphics->getUpdateScreenCalls(),
+		(unsigned long long)graphics->getCopyRectToScreenBytes(),
+		(unsigned long long)mixer->getMixedSamples()));
+	out.finalize();
+
+	// Only write the summary once, when quitting from the engine
+	_benchmarkOutput.clear();
+}
+#endif
+
 void OSystem_NULL::logMessage(LogMessageType::Type type, const char *message) {
 	FILE *output = 0;
 
@@ -357,6 +357,16 @@ bool OSystem_POSIX::displayLogFile() {
 	return WIFEXITED(status) && WEXITSTATUS(status) == 0;
 }
 
+uint64 OSystem_POSIX::getPhysicalMemorySize() const {
+#if defined(_SC_PHYS_PAGES) && defined(_SC_PAGE_SIZE)
+	long pages = sysconf(_SC_PHYS_PAGES);
+	long pageSize = sysconf(_SC_PAGE_SIZE);
+	if (pages > 0 && pageSize > 0)
+		return (uint64)pages * pageSize;
+#endif
+	return 0;
+}
+
 #ifdef HAS_POSIX_SPAWN
 bool OSystem_POSIX::openUrl(const Common::String &url) {
 	// inspired by Qt's "qdesktopservices_x11.cpp"
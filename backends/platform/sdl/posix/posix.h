@@ -38,6 +38,8 @@ public:
 
 	Common::String getScreenshotsPath() override;
 
+	uint64 getPhysicalMemorySize() const override;
+
 protected:
 	virtual Common::String getDefaultConfigFileName() override;
 	virtual Common::String getDefaultLogFileName() override;
@@ -45,6 +45,7 @@
 #include "backends/events/sdl/legacy-sdl-events.h"
 #include "backends/keymapper/hardware-input.h"
 #include "backends/mutex/sdl/sdl-mutex.h"
+#include "backends/threadpool/sdl/sdl-threadpool.h"
 #include "backends/timer/sdl/sdl-timer.h"
 #include "backends/graphics/surfacesdl/surfacesdl-graphics.h"
 #ifdef USE_OPENGL
@@ -631,6 +632,16 @@ uint32 OSystem_SDL::getMillis(bool skipRecord) {
 	return millis;
 }
 
+uint64 OSystem_SDL::getMicros() {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	const uint64 counter = SDL_GetPerformanceCounter();
+	const uint64 frequency = SDL_GetPerformanceFrequency();
+	return (counter / frequency) * 1000000 + ((counter % frequency) * 1000000) / frequency;
+#else
+	return (uint64)SDL_GetTicks() * 1000;
+#endif
+}
+
 void OSystem_SDL::delayMillis(uint msecs) {
 #ifdef ENABLE_EVENTRECORDER
 	if (!g_eventRec.processDelayMillis())
@@ -672,6 +683,10 @@ Common::TimerManager *OSystem_SDL::getTimerManager() {
 #endif
 }
 
+Common::ThreadPool *OSystem_SDL::createThreadPool(uint threadCount) {
+	return new SdlThreadPool(threadCount);
+}
+
 AudioCDManager *OSystem_SDL::createAudioCDManager() {
 	// Audio CD support was removed with SDL 2.0
 #if SDL_VERSION_ATLEAST(2, 0, 0)
@@ -229,6 +229,15 @@ Common::String OSystem_Win32::getSystemLanguage() const {
 	return OSystem_SDL::getSystemLanguage();
 }
 
+uint64 OSystem_Win32::getPhysicalMemorySize() const {
+	MEMORYSTATUSEX status;
+	status.dwLength = sizeof(status);
+	if (GlobalMemoryStatusEx(&status))
+		return status.ullTotalPhys;
+
+	return 0;
+}
+
 Common::String OSystem_Win32::getScreenshotsPath() {
 	Common::String screenshotsPath = ConfMan.get("screenshotpath");
 	if (!screenshotsPath.empty()) {
@@ -43,6 +43,8 @@ public:
 
 	virtual Common::String getSystemLanguage() const override;
 
+	virtual uint64 getPhysicalMemorySize() const override;
+
 	virtual Common::String getScreenshotsPath() override;
 
 protected:
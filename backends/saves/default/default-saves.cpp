@@ -42,6 +42,8 @@
 #include "common/fs.h"
 #include "common/archive.h"
 #include "common/config-manager.h"
+#include "common/memstream.h"
+#include "common/timer.h"
 #include "common/zlib.h"
 
 #include <errno.h>	// for removeSavefile()
@@ -50,13 +52,77 @@
 const char *DefaultSaveFileManager::TIMESTAMPS_FILENAME = "timestamps";
 #endif
 
-DefaultSaveFileManager::DefaultSaveFileManager() {
+/**
+ * Suffix of the temporary files written by the background writer. They are
+ * renamed to the name of the save file once completely written, so that a
+ * crash never leaves a truncated save file behind.
+ */
+static const char *const kTempFileSuffix = ".~tmp";
+
+/** Interval, in microseconds, at which the background writer wakes up. */
+static const int32 kWriterInterval = 50 * 1000;
+
+/**
+ * A save file which the engine serialises into memory. Once finalized (or
+ * deleted without being finalized), it is handed over to the background
+ * writer of the DefaultSaveFileManager, which compresses it and writes it
+ * to disk.
+ *
+ * A failure to write the save file cannot be reported through err(). It is
+ * reported to the procedures registered with addWriteCallback() instead.
+ */
+class BackgroundOutSaveFile : public Common::OutSaveFile {
+public:
+	BackgroundOutSaveFile(DefaultSaveFileManager *manager, const Common::String &name, const Common::FSNode &node, bool compress)
+		: Common::OutSaveFile(new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO)),
+		  _manager(manager), _name(name), _node(node), _compress(compress), _queued(false) {
+	}
+
+	~BackgroundOutSaveFile() override {
+		queue();
+	}
+
+	void finalize() override {
+		queue();
+	}
+
+private:
+	DefaultSaveFileManager *_manager;
+	Common::String _name;
+	Common::FSNode _node;
+	bool _compress;
+	bool _queued;
+
+	void queue() {
+		if (_queued)
+			return;
+		_queued = true;
+
+		Common::MemoryWriteStreamDynamic *stream = static_cast<Common::MemoryWriteStreamDynamic *>(_wrapped);
+		DefaultSaveFileManager::PendingWrite *write = new DefaultSaveFileManager::PendingWrite();
+		write->name = _name;
+		write->node = _node;
+		write->data = stream->getData();
+		write->size = stream->size();
+		write->compress = _compress;
+		_manager->queueWrite(write);
+	}
+};
+
+DefaultSaveFileManager::DefaultSaveFileManager() : _writerInstalled(false) {
 }
 
-DefaultSaveFileManager::DefaultSaveFileManager(const Common::String &defaultSavepath) {
+DefaultSaveFileManager::DefaultSaveFileManager(const Common::String &defaultSavepath) : _writerInstalled(false) {
 	ConfMan.registerDefault("savepath", defaultSavepath);
 }
 
+DefaultSaveFileManager::~DefaultSaveFileManager() {
+	if (_writerInstalled)
+		g_system->getTimerManager()->removeTimerProc(&writerProc);
+
+	flushPendingWrites();
+}
+
 
 void DefaultSaveFileManager::checkPath(const Common::FSNode &dir) {
 	clearError();
@@ -98,6 +164,9 @@ Common::StringArray DefaultSaveFileManager::listSavefiles(const Common::String &
 }
 
 Common::InSaveFile *DefaultSaveFileManager::openRawFile(const Common::String &filename) {
+	// The raw file is only complete once it was written.
+	flushPendingWrites();
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -125,6 +194,11 @@ Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String
 		}
 	}
 
+	// A save file which was not written yet is read from memory.
+	Common::SeekableReadStream *pending = openPendingWrite(filename);
+	if (pending)
+		return pending;
+
 	SaveFileCache::const_iterator file = _saveFileCache.find(filename);
 	if (file == _saveFileCache.end()) {
 		return nullptr;
@@ -168,10 +242,15 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 	}
 
 	// Open the file for saving.
-	Common::WriteStream *const sf = fileNode.createWriteStream();
-	if (!sf)
-		return nullptr;
-	Common::OutSaveFile *const result = new Common::OutSaveFile(compress ? Common::wrapCompressedWriteStream(sf) : sf);
+	Common::OutSaveFile *result;
+	if (useBackgroundWriter() && fileNode.canRename()) {
+		result = new BackgroundOutSaveFile(this, filename, fileNode, compress);
+	} else {
+		Common::WriteStream *const sf = fileNode.createWriteStream();
+		if (!sf)
+			return nullptr;
+		result = new Common::OutSaveFile(compress ? Common::wrapCompressedWriteStream(sf) : sf);
+	}
 
 	// Add file to cache now that it exists.
 	_saveFileCache[filename] = Common::FSNode(fileNode.getPath());
@@ -180,6 +259,9 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 }
 
 bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
+	// Otherwise the writer could create the file again once removed.
+	flushPendingWrites();
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -273,6 +355,11 @@ void DefaultSaveFileManager::assureCached(const Common::String &savePathName) {
 
 	// Build the savefile name cache.
 	for (Common::FSList::const_iterator file = children.begin(), end = children.end(); file != end; ++file) {
+		if (file->getName().hasSuffix(kTempFileSuffix)) {
+			// Left behind by an interrupted background write
+			continue;
+		}
+
 		if (_saveFileCache.contains(file->getName())) {
 			warning("DefaultSaveFileManager::assureCached: Name clash when building cache, ignoring file '%s'", file->getName().c_str());
 		} else {
@@ -285,6 +372,131 @@ void DefaultSaveFileManager::assureCached(const Common::String &savePathName) {
 	_cachedDirectory = savePathName;
 }
 
+bool DefaultSaveFileManager::useBackgroundWriter() const {
+#if defined(USE_CLOUD) && defined(USE_LIBCURL)
+	// The cloud sync started by OutSaveFile::finalize() must see the
+	// complete save file.
+	return false;
+#else
+	return g_system->getTimerManager() != nullptr;
+#endif
+}
+
+void DefaultSaveFileManager::queueWrite(PendingWrite *write) {
+	{
+		Common::StackLock lock(_pendingWritesMutex);
+		_pendingWrites.push_back(write);
+	}
+
+	if (!_writerInstalled)
+		_writerInstalled = g_system->getTimerManager()->installTimerProc(&writerProc, kWriterInterval, this, "DefaultSaveFileManager");
+
+	// Without a writer, the save file is written right away
+	if (!_writerInstalled)
+		flushPendingWrites();
+}
+
+bool DefaultSaveFileManager::flushPendingWrites() {
+	bool allWritten = true;
+	bool success;
+	while (writeNextPending(success))
+		allWritten = allWritten && success;
+	return allWritten;
+}
+
+void DefaultSaveFileManager::addWriteCallback(WriteCallback proc, void *refCon) {
+	Common::StackLock lock(_pendingWritesMutex);
+	WriteCallbackEntry entry;
+	entry.proc = proc;
+	entry.refCon = refCon;
+	_writeCallbacks.push_back(entry);
+}
+
+void DefaultSaveFileManager::removeWriteCallback(WriteCallback proc, void *refCon) {
+	Common::StackLock lock(_pendingWritesMutex);
+	for (uint i = 0; i < _writeCallbacks.size(); ++i) {
+		if (_writeCallbacks[i].proc == proc && _writeCallbacks[i].refCon == refCon) {
+			_writeCallbacks.remove_at(i);
+			return;
+		}
+	}
+}
+
+bool DefaultSaveFileManager::writeNextPending(bool &success) {
+	Common::StackLock writerLock(_writerMutex);
+
+	PendingWrite *write;
+	{
+		Common::StackLock lock(_pendingWritesMutex);
+		if (_pendingWrites.empty())
+			return false;
+		write = _pendingWrites.front();
+	}
+
+	// The save file is written without holding _pendingWritesMutex, so that
+	// the engine may keep on saving and loading meanwhile.
+	success = writeToDisk(*write);
+	if (!success)
+		warning("DefaultSaveFileManager: Failed to write '%s'", write->name.c_str());
+
+	Common::Array<WriteCallbackEntry> callbacks;
+	{
+		Common::StackLock lock(_pendingWritesMutex);
+		_pendingWrites.pop_front();
+		callbacks = _writeCallbacks;
+	}
+
+	for (uint i = 0; i < callbacks.size(); ++i)
+		callbacks[i].proc(write->name, success, callbacks[i].refCon);
+
+	free(write->data);
+	delete write;
+	return true;
+}
+
+bool DefaultSaveFileManager::writeToDisk(const PendingWrite &write) {
+	const Common::FSNode tempNode = write.node.getParent().getChild(write.node.getName() + kTempFileSuffix);
+
+	Common::WriteStream *stream = tempNode.createWriteStream();
+	if (!stream)
+		return false;
+	if (write.compress)
+		stream = Common::wrapCompressedWriteStream(stream);
+
+	stream->write(write.data, write.size);
+	stream->finalize();
+	const bool error = stream->err();
+	delete stream;
+
+	// The save file is only replaced once the new one is complete. If that
+	// fails, the temporary file is left behind rather than losing the save.
+	return !error && tempNode.renameTo(write.node);
+}
+
+Common::SeekableReadStream *DefaultSaveFileManager::openPendingWrite(const Common::String &filename) {
+	Common::StackLock lock(_pendingWritesMutex);
+
+	PendingWrite *latest = nullptr;
+	for (Common::List<PendingWrite *>::const_iterator i = _pendingWrites.begin(); i != _pendingWrites.end(); ++i) {
+		if ((*i)->name.equalsIgnoreCase(filename))
+			latest = *i;
+	}
+	if (!latest)
+		return nullptr;
+
+	byte *data = (byte *)malloc(latest->size);
+	if (!data)
+		return nullptr;
+	memcpy(data, latest->data, latest->size);
+	return new Common::MemoryReadStream(data, latest->size, DisposeAfterUse::YES);
+}
+
+void DefaultSaveFileManager::writerProc(void *refCon) {
+	DefaultSaveFileManager *manager = (DefaultSaveFileManager *)refCon;
+	bool success;
+	manager->writeNextPending(success);
+}
+
 #if defined(USE_CLOUD) && defined(USE_LIBCURL)
 
 Common::HashMap<Common::String, uint32> DefaultSaveFileManager::loadTimestamps() {
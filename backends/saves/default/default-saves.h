@@ -28,6 +28,8 @@
 #include "common/str.h"
 #include "common/fs.h"
 #include "common/hash-str.h"
+#include "common/list.h"
+#include "common/mutex.h"
 #include <limits.h>
 
 /**
@@ -37,6 +39,7 @@ class DefaultSaveFileManager : public Common::SaveFileManager {
 public:
 	DefaultSaveFileManager();
 	DefaultSaveFileManager(const Common::String &defaultSavepath);
+	virtual ~DefaultSaveFileManager();
 
 	virtual void updateSavefilesList(Common::StringArray &lockedFiles);
 	virtual Common::StringArray listSavefiles(const Common::String &pattern);
@@ -45,6 +48,10 @@ public:
 	virtual Common::OutSaveFile *openForSaving(const Common::String &filename, bool compress = true);
 	virtual bool removeSavefile(const Common::String &filename);
 
+	virtual bool flushPendingWrites();
+	virtual void addWriteCallback(WriteCallback proc, void *refCon);
+	virtual void removeWriteCallback(WriteCallback proc, void *refCon);
+
 #ifdef USE_LIBCURL
 
 	static const uint32 INVALID_TIMESTAMP = UINT_MAX;
@@ -94,11 +101,71 @@ protected:
 	 */
 	Common::StringArray _lockedFiles;
 
+	/**
+	 * Whether openForSaving should return save files which are written by
+	 * the background writer once finalized. Otherwise, the save files are
+	 * written directly, as the engine writes them. The background writer is
+	 * also only used where the file system node can rename, see
+	 * Common::FSNode::canRename().
+	 */
+	virtual bool useBackgroundWriter() const;
+
 private:
+	friend class BackgroundOutSaveFile;
+
 	/**
 	 * The currently cached directory.
 	 */
 	Common::String _cachedDirectory;
+
+	/** A save file serialised in memory, waiting for the background writer. */
+	struct PendingWrite {
+		Common::String name;
+		Common::FSNode node;
+		byte *data;
+		uint32 size;
+		bool compress;
+	};
+
+	struct WriteCallbackEntry {
+		WriteCallback proc;
+		void *refCon;
+	};
+
+	/**
+	 * Save files waiting to be written, oldest first. A save file stays in
+	 * the list while it is being written, so that it can still be loaded.
+	 */
+	Common::List<PendingWrite *> _pendingWrites;
+	Common::Array<WriteCallbackEntry> _writeCallbacks;
+
+	/** Protects _pendingWrites and _writeCallbacks. */
+	Common::Mutex _pendingWritesMutex;
+
+	/** Held while a save file is written, so that only one is written at a time. */
+	Common::Mutex _writerMutex;
+
+	bool _writerInstalled;
+
+	/** Hand a save file serialised in memory over to the background writer. */
+	void queueWrite(PendingWrite *write);
+
+	/**
+	 * Write the oldest pending save file to disk.
+	 *
+	 * @return False if there was no save file to write.
+	 */
+	bool writeNextPending(bool &success);
+
+	/** Return a copy of the most recent pending save file named @p filename, if any. */
+	Common::SeekableReadStream *openPendingWrite(const Common::String &filename);
+
+	/**
+	 * Write a save file to a temporary file next to it, then rename that
+	 * over the save file.
+	 */
+	static bool writeToDisk(const PendingWrite &write);
+	static void writerProc(void *refCon);
 };
 
 #endif
@@ -0,0 +1,159 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#if defined(SDL_BACKEND)
+
+#include "backends/threadpool/sdl/sdl-threadpool.h"
+
+#include "common/textconsole.h"
+#include "common/util.h"
+
+SdlThreadPool::SdlThreadPool(uint threadCount)
+	: _proc(nullptr), _data(nullptr), _nextJob(0), _jobCount(0), _pending(0), _quit(false) {
+	_mutex = SDL_CreateMutex();
+	_start = SDL_CreateCond();
+	_done = SDL_CreateCond();
+
+	if (threadCount == 0)
+		threadCount = getCPUCount();
+
+	for (uint i = 1; i < threadCount; ++i) {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+		SDL_Thread *thread = SDL_CreateThread(workerProc, "ScummVM Worker", this);
+#else
+		SDL_Thread *thread = SDL_CreateThread(workerProc, this);
+#endif
+		if (!thread) {
+			warning("Could not create worker thread: %s", SDL_GetError());
+			break;
+		}
+		_workers.push_back(thread);
+	}
+}
+
+SdlThreadPool::~SdlThreadPool() {
+	SDL_LockMutex(_mutex);
+	_quit = true;
+	SDL_CondBroadcast(_start);
+	SDL_UnlockMutex(_mutex);
+
+	for (uint i = 0; i < _workers.size(); ++i)
+		SDL_WaitThread(_workers[i], nullptr);
+
+	SDL_DestroyCond(_done);
+	SDL_DestroyCond(_start);
+	SDL_DestroyMutex(_mutex);
+}
+
+uint SdlThreadPool::getCPUCount() {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	return MAX(SDL_GetCPUCount(), 1);
+#else
+	return 1;
+#endif
+}
+
+void SdlThreadPool::run(void (*proc)(void *data, uint job), void *data, uint count) {
+	if (_workers.empty() || count <= 1) {
+		for (uint job = 0; job < count; ++job)
+			proc(data, job);
+		return;
+	}
+
+	SDL_LockMutex(_mutex);
+	_proc = proc;
+	_data = data;
+	_nextJob = 0;
+	_jobCount = count;
+	_pending = count;
+	SDL_CondBroadcast(_start);
+
+	runJobs();
+	while (_pending > 0)
+		SDL_CondWait(_done, _mutex);
+
+	_proc = nullptr;
+	_data = nullptr;
+	SDL_UnlockMutex(_mutex);
+}
+
+bool SdlThreadPool::startBackgroundJob(void (*proc)(void *data), void *data) {
+	if (_workers.empty())
+		return false;
+
+	BackgroundJob job;
+	job.proc = proc;
+	job.data = data;
+
+	SDL_LockMutex(_mutex);
+	_backgroundJobs.push_back(job);
+	SDL_CondBroadcast(_start);
+	SDL_UnlockMutex(_mutex);
+	return true;
+}
+
+void SdlThreadPool::runJobs() {
+	// Called and returns with _mutex locked
+	while (_nextJob < _jobCount) {
+		const uint job = _nextJob++;
+		void (*proc)(void *data, uint job) = _proc;
+		void *data = _data;
+
+		SDL_UnlockMutex(_mutex);
+		proc(data, job);
+		SDL_LockMutex(_mutex);
+
+		if (--_pending == 0)
+			SDL_CondSignal(_done);
+	}
+}
+
+void SdlThreadPool::runBackgroundJob() {
+	// Called and returns with _mutex locked
+	const BackgroundJob job = _backgroundJobs.front();
+	_backgroundJobs.remove_at(0);
+
+	SDL_UnlockMutex(_mutex);
+	job.proc(job.data);
+	SDL_LockMutex(_mutex);
+}
+
+int SDLCALL SdlThreadPool::workerProc(void *pool) {
+	SdlThreadPool *self = (SdlThreadPool *)pool;
+
+	SDL_LockMutex(self->_mutex);
+	while (!self->_quit) {
+		if (self->_nextJob < self->_jobCount)
+			self->runJobs();
+		else if (!self->_backgroundJobs.empty())
+			self->runBackgroundJob();
+		else
+			SDL_CondWait(self->_start, self->_mutex);
+	}
+	SDL_UnlockMutex(self->_mutex);
+
+	return 0;
+}
+
+#endif
@@ -0,0 +1,81 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef BACKENDS_THREADPOOL_SDL_H
+#define BACKENDS_THREADPOOL_SDL_H
+
+#include "common/array.h"
+#include "common/threadpool.h"
+
+#include "backends/platform/sdl/sdl-sys.h"
+
+/**
+ * Thread pool using SDL threads. The calling thread takes jobs as
+ * well, so that only threadCount - 1 worker threads are started.
+ */
+class SdlThreadPool : public Common::ThreadPool {
+public:
+	/**
+	 * Start the worker threads. A threadCount of 0 picks one thread
+	 * per CPU core.
+	 */
+	SdlThreadPool(uint threadCount);
+	virtual ~SdlThreadPool();
+
+	virtual uint getThreadCount() const override { return _workers.size() + 1; }
+	virtual void run(void (*proc)(void *data, uint job), void *data, uint count) override;
+	virtual bool startBackgroundJob(void (*proc)(void *data), void *data) override;
+
+private:
+	static uint getCPUCount();
+
+	static int SDLCALL workerProc(void *pool);
+
+	/** Run jobs of the current batch until none are left. */
+	void runJobs();
+
+	/** Run the oldest background job. */
+	void runBackgroundJob();
+
+	struct BackgroundJob {
+		void (*proc)(void *data);
+		void *data;
+	};
+
+	Common::Array<SDL_Thread *> _workers;
+	SDL_mutex *_mutex;
+	/** Signalled when a new batch is started, and when quitting. */
+	SDL_cond *_start;
+	/** Signalled when the last job of a batch is done. */
+	SDL_cond *_done;
+
+	// All of these are protected by _mutex
+	void (*_proc)(void *data, uint job);
+	void *_data;
+	uint _nextJob;
+	uint _jobCount;
+	uint _pending;
+	Common::Array<BackgroundJob> _backgroundJobs;
+	bool _quit;
+};
+
+#endif
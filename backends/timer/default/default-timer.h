@@ -23,6 +23,7 @@
 #ifndef BACKENDS_TIMER_DEFAULT_H
 #define BACKENDS_TIMER_DEFAULT_H
 
+#include "common/array.h"
 #include "common/str.h"
 #include "common/hash-str.h"
 #include "common/timer.h"
@@ -35,11 +36,21 @@ private:
 	typedef Common::HashMap<Common::String, TimerProc, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> TimerSlotMap;
 
 	Common::Mutex _mutex;
-	TimerSlot *_head;
+	Common::Array<TimerSlot *> _slots; ///< Binary min-heap ordered by the next fire time
 	TimerSlotMap _callbacks;
 
 	uint32 _timerCallbackNext;
 
+	void siftUp(uint index);
+	void siftDown(uint index);
+
+protected:
+	/**
+	 * Return the time the timer procs are scheduled on, in microseconds.
+	 * This is OSystem::getMicros() by default.
+	 */
+	virtual uint64 getMicros();
+
 public:
 	DefaultTimerManager();
 	virtual ~DefaultTimerManager();
@@ -51,6 +62,15 @@ public:
 	 */
 	void handler();
 
+	/**
+	 * Return the number of microseconds until the next timer callback is
+	 * due, or @p maxDelay if there is none or it is due later.
+	 *
+	 * Backends with a timer thread use this to wake up when the next
+	 * callback is due, rather than at a fixed rate.
+	 */
+	uint32 getTimeToNextTimer(uint32 maxDelay);
+
 	/*
 	 * Ensure that the callback is called at regular time intervals.
 	 * Should be called from pollEvents() on backends without threads.
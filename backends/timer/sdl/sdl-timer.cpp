@@ -28,14 +28,24 @@
 #include "backends/timer/sdl/sdl-timer.h"
 
 #include "common/textconsole.h"
+#include "common/util.h"
 
 OSystem::MutexRef timerMutex;
 
+// Longest time in milliseconds the timer thread sleeps between two checks
+static const Uint32 kMaxTimerDelay = 10;
+
 static Uint32 timer_handler(Uint32 interval, void *param) {
 	Common::StackLock lock(timerMutex);
 
-	((DefaultTimerManager *)param)->handler();
-	return interval;
+	DefaultTimerManager *timerManager = (DefaultTimerManager *)param;
+	timerManager->handler();
+
+	// Wake up when the next timer callback is due, so that procs installed
+	// with short intervals are not rounded up to kMaxTimerDelay. Returning
+	// 0 would cancel the SDL timer.
+	Uint32 delay = (timerManager->getTimeToNextTimer(kMaxTimerDelay * 1000) + 999) / 1000;
+	return MAX<Uint32>(delay, 1);
 }
 
 SdlTimerManager::SdlTimerManager() {
@@ -45,7 +55,7 @@ SdlTimerManager::SdlTimerManager() {
 	}
 
 	// Creates the timer callback
-	_timerID = SDL_AddTimer(10, &timer_handler, this);
+	_timerID = SDL_AddTimer(kMaxTimerDelay, &timer_handler, this);
 }
 
 SdlTimerManager::~SdlTimerManager() {
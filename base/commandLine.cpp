@@ -132,6 +132,8 @@ static const char HELP_STRING[] =
 	"  --debugflags=FLAGS       Enable engine specific debug flags\n"
 	"                           (separated by commas)\n"
 	"  --debug-channels-only    Show only the specified debug channels\n"
+	"  --trace-file=FILE        Write the time spent in the startup steps to FILE,\n"
+	"                           in Chrome trace format (for about:tracing)\n"
 	"  -u, --dump-scripts       Enable script dumping if a directory called 'dumps'\n"
 	"                           exists in the current directory\n"
 	"\n"
@@ -173,6 +175,8 @@ static const char HELP_STRING[] =
 	"  --record-mode=MODE       Specify record mode for event recorder (record, playback,\n"
 	"                           passthrough [default])\n"
 	"  --record-file-name=FILE  Specify record file name\n"
+	"  --benchmark=FILE         Play back the recording FILE as fast as possible,\n"
+	"                           and report the time spent when it ends\n"
 	"  --disable-display        Disable any gfx output. Used for headless events\n"
 	"                           playback by Event Recorder\n"
 #endif
@@ -251,10 +255,14 @@ void registerDefaults() {
 	ConfMan.registerDefault("stretch_mode", "default");
 	ConfMan.registerDefault("scaler", "default");
 	ConfMan.registerDefault("scale_factor", -1);
+	ConfMan.registerDefault("scaler_threads", 0);
+	ConfMan.registerDefault("mmap_files", false);
+	ConfMan.registerDefault("scaler_pipeline", false);
 	ConfMan.registerDefault("shader", "default");
 	ConfMan.registerDefault("show_fps", false);
 	ConfMan.registerDefault("dirtyrects", true);
 	ConfMan.registerDefault("vsync", true);
+	ConfMan.registerDefault("ttf_glyph_cache_size", 1024);
 
 	// Sound & Music
 	ConfMan.registerDefault("music_volume", 192);
@@ -271,9 +279,13 @@ void registerDefaults() {
 	ConfMan.registerDefault("dump_midi", false);
 	ConfMan.registerDefault("enable_gs", false);
 	ConfMan.registerDefault("midi_gain", 100);
+	ConfMan.registerDefault("resampling_quality", 0);
+	ConfMan.registerDefault("sfx_cache_size", 4096);
+	ConfMan.registerDefault("sfx_cache_max_length", 5000);
 
 	ConfMan.registerDefault("music_driver", "auto");
 	ConfMan.registerDefault("mt32_device", "null");
+	ConfMan.registerDefault("mt32_render_ahead", 0);
 	ConfMan.registerDefault("gm_device", "null");
 	ConfMan.registerDefault("opl2lpt_parport", "null");
 
@@ -351,6 +363,9 @@ void registerDefaults() {
 	ConfMan.registerDefault("fluidsynth_reverb_level", 90);
 
 	ConfMan.registerDefault("fluidsynth_misc_interpolation", "4th");
+
+	ConfMan.registerDefault("fluidsynth_render_ahead", 0);
+	ConfMan.registerDefault("fluidsynth_soundfont_cache", 256);
 #endif
 }
 
@@ -612,6 +627,9 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 			DO_LONG_OPTION_BOOL("debug-channels-only")
 			END_OPTION
 
+			DO_LONG_OPTION("trace-file")
+			END_OPTION
+
 			DO_OPTION('e', "music-driver")
 			END_OPTION
 
@@ -655,6 +673,9 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 
 			DO_LONG_OPTION("record-file-name")
 			END_OPTION
+
+			DO_LONG_OPTION("benchmark")
+			END_OPTION
 #endif
 
 			DO_LONG_OPTION("opl-driver")
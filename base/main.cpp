@@ -44,12 +44,14 @@
 #include "common/events.h"
 #include "gui/EventRecorder.h"
 #include "common/fs.h"
+#include "common/mutex.h"
 #ifdef ENABLE_EVENTRECORDER
 #include "common/recorderfile.h"
 #endif
 #include "common/system.h"
 #include "common/textconsole.h"
 #include "common/tokenizer.h"
+#include "common/trace.h"
 #include "common/translation.h"
 #include "common/text-to-speech.h"
 #include "common/osd_message_queue.h"
@@ -59,6 +61,7 @@
 
 #include "audio/mididrv.h"
 #include "audio/musicplugin.h"  /* for music manager */
+#include "audio/pcmcache.h"
 
 #include "graphics/cursorman.h"
 #include "graphics/fontman.h"
@@ -67,6 +70,7 @@
 #include "graphics/fonts/ttf.h"
 #endif
 
+#include "backends/fs/mappedfilestream.h"
 #include "backends/keymapper/action.h"
 #include "backends/keymapper/keymap.h"
 #include "backends/keymapper/keymapper.h"
@@ -92,6 +96,7 @@
 #endif
 
 static bool launcherDialog() {
+	Common::TraceScope trace("launcherDialog");
 
 	// Discard any command line options. Those that affect the graphics
 	// mode and the others (like bootparam etc.) should not
@@ -107,6 +112,8 @@ static bool launcherDialog() {
 }
 
 static const Plugin *detectPlugin() {
+	Common::TraceScope trace("detectPlugin");
+
 	// Figure out the engine ID and game ID
 	Common::String engineId = ConfMan.get("engineid");
 	Common::String gameId = ConfMan.get("gameid");
@@ -198,7 +205,10 @@ static Common::Error runGame(const Plugin *plugin, const Plugin *enginePlugin, O
 
 	// Create the game's MetaEngine.
 	MetaEngine &metaEngine = enginePlugin->get<MetaEngine>();
-	err = metaEngine.createInstance(&system, &engine);
+	{
+		Common::TraceScope trace("createInstance", target);
+		err = metaEngine.createInstance(&system, &engine);
+	}
 
 	// Check for errors
 	if (!engine || err.getCode() != Common::kNoError) {
@@ -247,7 +257,10 @@ static Common::Error runGame(const Plugin *plugin, const Plugin *enginePlugin, O
 	//
 
 	// Add the game path to the directory search list
-	engine->initializePath(dir);
+	{
+		Common::TraceScope trace("initializePath", dir.getPath());
+		engine->initializePath(dir);
+	}
 
 	// Add extrapath (if any) to the directory search list
 	if (ConfMan.hasKey("extrapath")) {
@@ -303,8 +316,17 @@ static Common::Error runGame(const Plugin *plugin, const Plugin *enginePlugin, O
 	// Inform backend that the engine is about to be run
 	system.engineInit();
 
+	// Write the startup trace now, as the game may run for a long time
+	// and it may not quit cleanly
+	if (Common::Tracer::hasInstance())
+		Common::Tracer::instance().flush();
+
 	// Run the engine
-	Common::Error result = engine->run();
+	Common::Error result;
+	{
+		Common::TraceScope trace("Engine::run", target);
+		result = engine->run();
+	}
 
 	// Make sure we do not return to the launcher if this is not possible.
 	if (!engine->hasFeature(Engine::kSupportsReturnToLauncher))
@@ -324,6 +346,9 @@ static Common::Error runGame(const Plugin *plugin, const Plugin *enginePlugin, O
 	// Reset the file/directory mappings
 	SearchMan.clear();
 
+	// Drop the sounds cached by the engine
+	Audio::PCMCache::destroy();
+
 #ifdef USE_TRANSLATION
 	TransMan.setLanguage(previousLanguage);
 	Common::TextToSpeechManager *ttsMan;
@@ -337,6 +362,7 @@ static Common::Error runGame(const Plugin *plugin, const Plugin *enginePlugin, O
 }
 
 static void setupGraphics(OSystem &system) {
+	Common::TraceScope trace("setupGraphics");
 
 	system.beginGFXTransaction();
 		// Set the user specified graphics mode (if any).
@@ -440,11 +466,21 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	if (settings.contains("debug-channels-only"))
 		gDebugChannelsOnly = true;
 
+	MappedFileStream::setEnabled(ConfMan.getBool("mmap_files"));
+
+	// Start tracing as soon as possible too, so that plugin loading is traced
+	if (settings.contains("trace-file")) {
+		Common::Tracer::instance().start(settings["trace-file"]);
+		settings.erase("trace-file"); // This option should not be passed to ConfMan.
+	}
 
 	ConfMan.registerDefault("always_run_fallback_detection_extern", true);
-	PluginManager::instance().init();
- 	PluginManager::instance().loadAllPlugins(); // load plugins for cached plugin manager
-	PluginManager::instance().loadDetectionPlugin(); // load detection plugin for uncached plugin manager
+	{
+		Common::TraceScope trace("loadPlugins");
+		PluginManager::instance().init();
+		PluginManager::instance().loadAllPlugins(); // load plugins for cached plugin manager
+		PluginManager::instance().loadDetectionPlugin(); // load detection plugin for uncached plugin manager
+	}
 
 	// If we received an invalid music parameter via command line we check this here.
 	// We can't check this before loading the music plugins.
@@ -465,6 +501,11 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 		if (res.getCode() != Common::kNoError)
 			warning("%s", res.getDesc().c_str());
 
+		if (Common::Tracer::hasInstance()) {
+			Common::Tracer::instance().stop();
+			Common::Tracer::destroy();
+		}
+
 		PluginManager::instance().unloadDetectionPlugin();
 		PluginManager::instance().unloadAllPlugins();
 		PluginManager::destroy();
@@ -486,7 +527,10 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 
 	// Init the backend. Must take place after all config data (including
 	// the command line params) was read.
-	system.initBackend();
+	{
+		Common::TraceScope trace("initBackend");
+		system.initBackend();
+	}
 
 	// If we received an invalid graphics mode parameter via command line
 	// we check this here. We can't do it until after the backend is inited,
@@ -584,6 +628,14 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 #ifdef ENABLE_EVENTRECORDER
 			Common::String recordMode = ConfMan.get("record_mode");
 			Common::String recordFileName = ConfMan.get("record_file_name");
+			const bool benchmark = ConfMan.hasKey("benchmark");
+
+			if (benchmark) {
+				// A benchmark is the playback of a recording, as fast as possible
+				recordMode = "playback";
+				recordFileName = ConfMan.get("benchmark");
+				g_eventRec.setBenchmark(true);
+			}
 
 			if (recordMode == "record") {
 				g_eventRec.init(g_eventRec.generateRecordFileName(ConfMan.getActiveDomainName()), GUI::EventRecorder::kRecorderRecord);
@@ -609,7 +661,15 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 #ifdef ENABLE_EVENTRECORDER
 			// Flush Event recorder file. The recorder does not get reinitialized for next game
 			// which is intentional. Only single game per session is allowed.
+			const bool benchmarkPassed = g_eventRec.finishBenchmark();
 			g_eventRec.deinit();
+
+			// Report a diverging benchmark with the exit status, and do not
+			// return to the launcher after one
+			if (!benchmarkPassed)
+				g_system->fatalError();
+			if (benchmark)
+				break;
 #endif
 
 #if defined(UNCACHED_PLUGINS) && defined(DYNAMIC_MODULES)
@@ -697,6 +757,17 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	PluginManager::instance().unloadDetectionPlugin();
 	PluginManager::instance().unloadAllPlugins();
 	PluginManager::destroy();
+
+#ifdef ENABLE_PROFILER
+	// Report the most contended locks, while the debug manager still exists
+	Common::Array<Common::MutexStats> mutexStats;
+	Common::getMutexStats(mutexStats);
+	for (uint i = 0; i < mutexStats.size(); ++i) {
+		const Common::MutexStats &stats = mutexStats[i];
+		debug(1, "Mutex %s: %u locks, %u contended, %u us waited, %u us longest hold", stats.name,
+		      (uint)stats.acquisitions, (uint)stats.contended, (uint)stats.waitMicros, (uint)stats.maxHoldMicros);
+	}
+#endif
 	GUI::GuiManager::destroy();
 	Common::ConfigManager::destroy();
 	Common::DebugManager::destroy();
@@ -717,5 +788,10 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	EngineManager::destroy();
 	Graphics::YUVToRGBManager::destroy();
 
+	if (Common::Tracer::hasInstance()) {
+		Common::Tracer::instance().stop();
+		Common::Tracer::destroy();
+	}
+
 	return 0;
 }
@@ -26,14 +26,18 @@
 #include "common/debug.h"
 #include "common/debug-channels.h"
 #include "common/config-manager.h"
+#include "common/hash-str.h"
+#include "common/trace.h"
 
 #ifdef DYNAMIC_MODULES
 #include "common/fs.h"
 #endif
 
 #include "base/detection/detection.h"
+#include "base/version.h"
 
 #include "engines/advancedDetector.h"
+#include "engines/detectioncache.h"
 
 // Plugin versioning
 
@@ -289,30 +293,42 @@ void PluginManager::addPluginProvider(PluginProvider *pp) {
 	_providers.push_back(pp);
 }
 
+static Plugin *findLoadedEnginePlugin(const Common::String &engineId) {
+	PluginList pl = PluginMan.getPlugins(PLUGIN_TYPE_ENGINE);
+	// Iterate over all engine plugins.
+	for (PluginList::const_iterator itr = pl.begin(); itr != pl.end(); itr++) {
+		// The getName() provides a name which is similiar to getEngineId.
+		// Because engines are engines themselves, this function is simply named getName.
+		Common::String enginePluginName((*itr)->getName());
+
+		if (engineId.equalsIgnoreCase(enginePluginName))
+			return *itr;
+	}
+	return nullptr;
+}
+
 Plugin *PluginManager::getEngineFromMetaEngine(const Plugin *plugin) {
 	assert(plugin->getType() == PLUGIN_TYPE_ENGINE_DETECTION);
 
 	Plugin *enginePlugin = nullptr;
-	bool found = false;
 
 	// Use the engineID from MetaEngine for comparasion.
 	Common::String metaEnginePluginName = plugin->getEngineId();
-	PluginMan.loadFirstPlugin();
-	do {
-		PluginList pl = PluginMan.getPlugins(PLUGIN_TYPE_ENGINE);
-		// Iterate over all engine plugins.
-		for (PluginList::const_iterator itr = pl.begin(); itr != pl.end(); itr++) {
-			// The getName() provides a name which is similiar to getEngineId.
-			// Because engines are engines themselves, this function is simply named getName.
-			Common::String enginePluginName((*itr)->getName());
-
-			if (metaEnginePluginName.equalsIgnoreCase(enginePluginName)) {
-				enginePlugin = (*itr);
-				found = true;
-				break;
-			}
-		}
-	} while (!found && PluginMan.loadNextPlugin());
+
+	// With uncached plugins, try the plugin file recorded for this engine
+	// first, instead of loading the plugin files one after the other
+	if (PluginMan.loadPluginFromEngineId(metaEnginePluginName))
+		enginePlugin = findLoadedEnginePlugin(metaEnginePluginName);
+
+	if (!enginePlugin) {
+		PluginMan.loadFirstPlugin();
+		do {
+			enginePlugin = findLoadedEnginePlugin(metaEnginePluginName);
+		} while (!enginePlugin && PluginMan.loadNextPlugin());
+
+		if (enginePlugin)
+			PluginMan.updateConfigWithFileName(metaEnginePluginName);
+	}
 
 	if (enginePlugin) {
 		debug(9, "MetaEngine: %s \t matched to \t Engine: %s", plugin->getName(), enginePlugin->getFileName());
@@ -406,6 +422,43 @@ void PluginManagerUncached::init() {
 			}
  		}
  	}
+
+	checkPluginManifest();
+}
+
+/**
+ * The 'engine_plugin_files' domain records which plugin file holds each
+ * engine. Its 'manifest' entry identifies the ScummVM build and the plugin
+ * files the records were made with, so that they are all dropped and found
+ * again when either changes. A record which is outdated in spite of that
+ * is still corrected when loading the recorded file does not give the
+ * expected engine.
+ **/
+void PluginManagerUncached::checkPluginManifest() {
+	uint namesHash = 0;
+	for (PluginList::const_iterator p = _allEnginePlugins.begin(); p != _allEnginePlugins.end(); ++p) {
+		if ((*p)->getFileName())
+			namesHash += Common::hashit((*p)->getFileName());
+	}
+	if (_detectionPlugin && _detectionPlugin->getFileName())
+		namesHash += Common::hashit(_detectionPlugin->getFileName());
+
+	Common::String manifest = Common::String::format("%s;%d;%u;%08x", gScummVMFullVersion,
+		PLUGIN_TYPE_ENGINE_VERSION, _allEnginePlugins.size(), namesHash);
+
+	Common::ConfigManager::Domain *domain = ConfMan.getDomain("engine_plugin_files");
+	if (domain && domain->getValOrDefault("manifest") == manifest)
+		return;
+
+	debug(1, "Plugin files changed, forgetting which plugin holds each engine");
+	if (!domain) {
+		ConfMan.addMiscDomain("engine_plugin_files");
+		domain = ConfMan.getDomain("engine_plugin_files");
+		assert(domain);
+	}
+	domain->clear();
+	domain->setVal("manifest", manifest);
+	ConfMan.flushToDisk();
 }
 
 /**
@@ -413,6 +466,7 @@ void PluginManagerUncached::init() {
  * engine ID under the domain 'engine_plugin_files'.
  **/
 bool PluginManagerUncached::loadPluginFromEngineId(const Common::String &engineId) {
+	Common::TraceScope trace("loadPluginFromEngineId", engineId);
 	Common::ConfigManager::Domain *domain = ConfMan.getDomain("engine_plugin_files");
 
 	if (domain) {
@@ -467,6 +521,7 @@ void PluginManagerUncached::updateConfigWithFileName(const Common::String &engin
 
 #ifndef DETECTION_STATIC
 void PluginManagerUncached::loadDetectionPlugin() {
+	Common::TraceScope trace("loadDetectionPlugin");
 	bool linkMetaEngines = false;
 
 	if (_isDetectionLoaded) {
@@ -541,6 +596,7 @@ bool PluginManagerUncached::loadNextPlugin() {
  * one plugin in memory at a time.
  **/
 void PluginManager::loadAllPlugins() {
+	Common::TraceScope trace("loadAllPlugins");
 	for (ProviderList::iterator pp = _providers.begin();
 	                            pp != _providers.end();
 	                            ++pp) {
@@ -566,6 +622,7 @@ void PluginManager::loadAllPlugins() {
 }
 
 void PluginManager::loadAllPluginsOfType(PluginType type) {
+	Common::TraceScope trace("loadAllPluginsOfType");
 	for (ProviderList::iterator pp = _providers.begin();
 	                            pp != _providers.end();
 	                            ++pp) {
@@ -720,6 +777,7 @@ QualifiedGameList EngineManager::findGameInLoadedPlugins(const Common::String &g
 }
 
 DetectionResults EngineManager::detectGames(const Common::FSList &fslist) const {
+	Common::TraceScope trace("detectGames");
 	DetectedGames candidates;
 	PluginList plugins;
 	PluginList::const_iterator iter;
@@ -737,6 +795,7 @@ DetectionResults EngineManager::detectGames(const Common::FSList &fslist) const
 		const MetaEngineDetection &metaEngine = (*iter)->get<MetaEngineDetection>();
 		// set the debug flags
 		DebugMan.addAllDebugChannels(metaEngine.getDebugChannels());
+		Common::TraceScope engineTrace("MetaEngineDetection::detectGames", metaEngine.getEngineId());
 		DetectedGames engineCandidates = metaEngine.detectGames(fslist);
 
 		for (uint i = 0; i < engineCandidates.size(); i++) {
@@ -746,6 +805,9 @@ DetectionResults EngineManager::detectGames(const Common::FSList &fslist) const
 		}
 	}
 
+	// Keep the properties computed by this detection for the next one
+	DetectionCacheMan.flush();
+
 	return DetectionResults(candidates);
 }
 
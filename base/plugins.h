@@ -375,6 +375,7 @@ protected:
 
 	PluginManagerUncached() : _isDetectionLoaded(false), _detectionPlugin(nullptr) {}
 	bool loadPluginByFileName(const Common::String &filename);
+	void checkPluginManifest();
 
 public:
 	virtual void init() override;
@@ -22,6 +22,7 @@
 
 #include "common/archive.h"
 #include "common/fs.h"
+#include "common/mutex.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 
@@ -62,6 +63,8 @@ int Archive::listMatchingMembers(ArchiveMemberList &list, const String &pattern)
 
 
 
+uint32 SearchSet::_revision = 0;
+
 SearchSet::ArchiveNodeList::iterator SearchSet::find(const String &name) {
 	ArchiveNodeList::iterator it = _list.begin();
 	for (; it != _list.end(); ++it) {
@@ -92,6 +95,7 @@ void SearchSet::insert(const Node &node) {
 			break;
 	}
 	_list.insert(it, node);
+	invalidateLookupCache();
 }
 
 void SearchSet::add(const String &name, Archive *archive, int priority, bool autoFree) {
@@ -173,6 +177,7 @@ void SearchSet::remove(const String &name) {
 		if (it->_autoFree)
 			delete it->_arc;
 		_list.erase(it);
+		invalidateLookupCache();
 	}
 }
 
@@ -187,6 +192,7 @@ void SearchSet::clear() {
 	}
 
 	_list.clear();
+	invalidateLookupCache();
 }
 
 void SearchSet::setPriority(const String &name, int priority) {
@@ -205,17 +211,70 @@ void SearchSet::setPriority(const String &name, int priority) {
 	insert(node);
 }
 
-bool SearchSet::hasFile(const String &name) const {
-	if (name.empty())
-		return false;
+SearchSet::~SearchSet() {
+	clear();
+	delete _lookupCacheMutex;
+}
+
+void SearchSet::setLookupCache(bool enable) {
+	if (enable && !_lookupCacheMutex)
+		_lookupCacheMutex = new Mutex();
+	else if (!enable) {
+		delete _lookupCacheMutex;
+		_lookupCacheMutex = nullptr;
+	}
+
+	_lookupCache.clear(true);
+}
 
+Archive *SearchSet::lookupUncached(const String &name) const {
 	ArchiveNodeList::const_iterator it = _list.begin();
 	for (; it != _list.end(); ++it) {
 		if (it->_arc->hasFile(name))
-			return true;
+			return it->_arc;
 	}
 
-	return false;
+	return nullptr;
+}
+
+Archive *SearchSet::lookup(const String &name) const {
+	if (!_lookupCacheMutex)
+		return lookupUncached(name);
+
+	// The archives are not asked with the lock held, so that threads
+	// looking up different names do not wait for each other
+	bool cached = false;
+	Archive *arc = nullptr;
+	{
+		StackLock lock(*_lookupCacheMutex);
+		if (_lookupCacheRevision != _revision) {
+			_lookupCache.clear();
+			_lookupCacheRevision = _revision;
+		}
+
+		LookupCache::const_iterator it = _lookupCache.find(name);
+		if (it != _lookupCache.end()) {
+			cached = true;
+			arc = it->_value;
+		}
+	}
+
+	// Files may still disappear from a directory, check the hit again
+	if (cached && (!arc || arc->hasFile(name)))
+		return arc;
+
+	arc = lookupUncached(name);
+
+	StackLock lock(*_lookupCacheMutex);
+	_lookupCache[name] = arc;
+	return arc;
+}
+
+bool SearchSet::hasFile(const String &name) const {
+	if (name.empty())
+		return false;
+
+	return lookup(name) != nullptr;
 }
 
 int SearchSet::listMatchingMembers(ArchiveMemberList &list, const String &pattern) const {
@@ -242,11 +301,9 @@ const ArchiveMemberPtr SearchSet::getMember(const String &name) const {
 	if (name.empty())
 		return ArchiveMemberPtr();
 
-	ArchiveNodeList::const_iterator it = _list.begin();
-	for (; it != _list.end(); ++it) {
-		if (it->_arc->hasFile(name))
-			return it->_arc->getMember(name);
-	}
+	Archive *arc = lookup(name);
+	if (arc)
+		return arc->getMember(name);
 
 	return ArchiveMemberPtr();
 }
@@ -255,6 +312,11 @@ SeekableReadStream *SearchSet::createReadStreamForMember(const String &name) con
 	if (name.empty())
 		return nullptr;
 
+	if (_lookupCacheMutex) {
+		Archive *arc = lookup(name);
+		return arc ? arc->createReadStreamForMember(name) : nullptr;
+	}
+
 	ArchiveNodeList::const_iterator it = _list.begin();
 	for (; it != _list.end(); ++it) {
 		SeekableReadStream *stream = it->_arc->createReadStreamForMember(name);
@@ -267,6 +329,7 @@ SeekableReadStream *SearchSet::createReadStreamForMember(const String &name) con
 
 
 SearchManager::SearchManager() {
+	setLookupCache(true);
 	clear(); // Force a reset
 }
 
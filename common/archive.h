@@ -24,6 +24,7 @@
 #define COMMON_ARCHIVE_H
 
 #include "common/str.h"
+#include "common/hash-str.h"
 #include "common/list.h"
 #include "common/ptr.h"
 #include "common/singleton.h"
@@ -41,6 +42,7 @@ namespace Common {
  */
 
 class FSNode;
+class Mutex;
 class SeekableReadStream;
 
 
@@ -147,6 +149,9 @@ public:
  * contained Archives, hence the simplistic policy of always looking for the first
  * match. SearchSet does guarantee that searches are performed in DESCENDING
  * priority order. In case of conflicting priorities, insertion order prevails.
+ *
+ * A SearchSet may remember which archive holds each name it has been asked
+ * for, and which names are in none of them, see setLookupCache().
  */
 class SearchSet : public Archive {
 	struct Node {
@@ -168,9 +173,25 @@ class SearchSet : public Archive {
 
 	bool _ignoreClashes;
 
+	typedef HashMap<String, Archive *> LookupCache;
+	mutable LookupCache _lookupCache; //!< Names already looked up, mapped to their archive or to nullptr.
+	mutable uint32 _lookupCacheRevision; //!< Value of _revision when _lookupCache was last valid.
+	/** Protects _lookupCache and _lookupCacheRevision, only created while the cache is used. */
+	Mutex *_lookupCacheMutex;
+
+	/**
+	 * Counter of the changes made to all the search sets. Nested sets do not
+	 * tell their parents when they change, so any change invalidates the
+	 * lookup caches of all the sets.
+	 */
+	static uint32 _revision;
+
+	Archive *lookup(const String &name) const; //!< Return the first archive holding @p name, or nullptr.
+	Archive *lookupUncached(const String &name) const;
+
 public:
-	SearchSet() : _ignoreClashes(false) { }
-	virtual ~SearchSet() { clear(); }
+	SearchSet() : _ignoreClashes(false), _lookupCacheRevision(0), _lookupCacheMutex(nullptr) { }
+	virtual ~SearchSet();
 
 	/**
 	 * Add a new archive to the searchable set.
@@ -268,6 +289,24 @@ public:
 	 * in @ref FSDirectory documentation.
 	 */
 	void setIgnoreClashes(bool ignoreClashes) { _ignoreClashes = ignoreClashes; }
+
+	/**
+	 * Remember the result of the lookups of hasFile(), getMember() and
+	 * createReadStreamForMember(). The archive found for a name is then asked
+	 * directly the next time, and a name found in no archive is rejected
+	 * without asking any of them.
+	 *
+	 * The cache is dropped whenever an archive is added to, removed from or
+	 * moved in any SearchSet. Call invalidateLookupCache() after changing the
+	 * set of files of an archive in any other way.
+	 *
+	 * Lookups may then be made from several threads at once. The cache must
+	 * not be switched on or off while any thread uses the set.
+	 */
+	void setLookupCache(bool enable);
+
+	/** Forget the lookups remembered by all the search sets. */
+	static void invalidateLookupCache() { ++_revision; }
 };
 
 
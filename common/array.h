@@ -43,18 +43,48 @@ namespace Common {
  */
 
 /**
- * This class implements a dynamically sized container, which
- * can be accessed similarly to a regular C++ array. Accessing
- * elements is performed in constant time (like with plain arrays).
- * In addition, you can append, insert, and remove entries (this
- * is the 'dynamic' part). In general, doing that takes time
- * proportional to the number of elements in the array.
- *
- * The container class closest to this in the C++ standard library is
- * std::vector. However, there are some differences.
+ * Storage for the first @p N elements of an array, kept inside the array
+ * object itself.
+ */
+template<class T, uint N>
+class ArrayInlineStorage {
+protected:
+	T *inlineStorage() {
+		return (T *)_inlineStorage._bytes;
+	}
+
+	const T *inlineStorage() const {
+		return (const T *)_inlineStorage._bytes;
+	}
+
+private:
+	/** Aligned for any standard type. */
+	union {
+		byte _bytes[N * sizeof(T)];
+		uint64 _alignInt;
+		double _alignDouble;
+		void *_alignPtr;
+	} _inlineStorage;
+};
+
+/**
+ * Arrays without inline storage keep all their elements on the heap. This
+ * takes no space in the array object.
  */
 template<class T>
-class Array {
+class ArrayInlineStorage<T, 0> {
+protected:
+	T *inlineStorage() const {
+		return nullptr;
+	}
+};
+
+/**
+ * Implementation shared by Array and SmallArray. The first @p N elements
+ * are stored inside the object, any more are allocated on the heap.
+ */
+template<class T, uint N>
+class ArrayBase : protected ArrayInlineStorage<T, N> {
 public:
 	typedef T *iterator; /*!< Array iterator. */
 	typedef const T *const_iterator; /*!< Const-qualified array iterator. */
@@ -66,16 +96,16 @@ public:
 protected:
 	size_type _capacity; /*!< Maximum number of elements the array can hold. */
 	size_type _size; /*!< How many elements the array holds. */
-	T *_storage;  /*!< Memory used for element storage. */
+	T *_storage;  /*!< Memory used for element storage, either the inline storage or the heap. */
 
 public:
-	Array() : _capacity(0), _size(0), _storage(nullptr) {}
+	ArrayBase() : _capacity(N), _size(0), _storage(this->inlineStorage()) {}
 
 	/**
 	 * Construct an array with @p count default-inserted instances of @p T. No
 	 * copies are made.
 	 */
-	explicit Array(size_type count) : _size(count) {
+	explicit ArrayBase(size_type count) : _size(count) {
 		allocCapacity(count);
 		for (size_type i = 0; i < count; ++i)
 			new ((void *)&_storage[i]) T();
@@ -84,7 +114,7 @@ public:
 	/**
 	 * Construct an array with @p count copies of elements with value @p value.
 	 */
-	Array(size_type count, const T &value) : _size(count) {
+	ArrayBase(size_type count, const T &value) : _size(count) {
 		allocCapacity(count);
 		uninitialized_fill_n(_storage, count, value);
 	}
@@ -92,21 +122,18 @@ public:
 	/**
 	 * Construct an array as a copy of the given @p array.
 	 */
-	Array(const Array<T> &array) : _capacity(array._size), _size(array._size), _storage(nullptr) {
-		if (array._storage) {
-			allocCapacity(_size);
-			uninitialized_copy(array._storage, array._storage + _size, _storage);
-		}
+	ArrayBase(const ArrayBase &array) : _size(array._size) {
+		allocCapacity(_size);
+		uninitialized_copy(array._storage, array._storage + _size, _storage);
 	}
 
 #ifdef USE_CXX11
 	/**
 	 * Construct an array as a copy of the given array using the C++11 move semantic.
+	 * Elements stored inline are moved one by one.
 	 */
-	Array(Array<T> &&old) : _capacity(old._capacity), _size(old._size), _storage(old._storage) {
-		old._storage = nullptr;
-		old._capacity = 0;
-		old._size = 0;
+	ArrayBase(ArrayBase &&old) : _capacity(N), _size(0), _storage(this->inlineStorage()) {
+		takeFrom(old);
 	}
 
 	/**
@@ -119,7 +146,7 @@ public:
 	 * @note
 	 * This constructor is only available when C++11 support is enabled.
 	 */
-	Array(std::initializer_list<T> list) : _size(list.size()) {
+	ArrayBase(std::initializer_list<T> list) : _size(list.size()) {
 		allocCapacity(list.size());
 		if (_storage)
 			Common::uninitialized_copy(list.begin(), list.end(), _storage);
@@ -130,13 +157,12 @@ public:
 	 * Construct an array by copying data from a regular array.
 	 */
 	template<class T2>
-	Array(const T2 *array, size_type n) {
-		_size = n;
+	ArrayBase(const T2 *array, size_type n) : _size(n) {
 		allocCapacity(n);
 		uninitialized_copy(array, array + _size, _storage);
 	}
 
-	~Array() {
+	~ArrayBase() {
 		freeStorage(_storage, _size);
 		_storage = nullptr;
 		_capacity = _size = 0;
@@ -150,8 +176,58 @@ public:
 			insert_aux(end(), &element, &element + 1);
 	}
 
+#ifdef USE_CXX11
+	/** Append an element to the end of the array, moving it into place. */
+	void push_back(T &&element) {
+		emplace_back(Common::move(element));
+	}
+
+	/** Construct an element at the end of the array from the given arguments. */
+	template<class... TArgs>
+	void emplace_back(TArgs &&...args) {
+		emplace(end(), Common::forward<TArgs>(args)...);
+	}
+
+	/**
+	 * Construct an element before @p pos from the given arguments, and
+	 * return an iterator pointing to it.
+	 */
+	template<class... TArgs>
+	iterator emplace(const_iterator pos, TArgs &&...args) {
+		assert(_storage <= pos && pos <= _storage + _size);
+		const size_type idx = pos - _storage;
+
+		if (_size + 1 > _capacity) {
+			T *const oldStorage = _storage;
+			allocCapacity(roundUpCapacity(_size + 1));
+
+			// Construct the new element first, as the arguments may refer
+			// to elements of the old storage
+			new ((void *)&_storage[idx]) T(Common::forward<TArgs>(args)...);
+			uninitialized_move(oldStorage, oldStorage + idx, _storage);
+			uninitialized_move(oldStorage + idx, oldStorage + _size, _storage + idx + 1);
+
+			freeStorage(oldStorage, _size);
+		} else if (idx == _size) {
+			new ((void *)&_storage[idx]) T(Common::forward<TArgs>(args)...);
+		} else {
+			T tmp(Common::forward<TArgs>(args)...);
+
+			// Make room for the new element by shifting back the
+			// existing ones.
+			new ((void *)&_storage[_size]) T(Common::move(_storage[_size - 1]));
+			for (size_type i = _size - 1; i > idx; --i)
+				_storage[i] = Common::move(_storage[i - 1]);
+			_storage[idx] = Common::move(tmp);
+		}
+
+		_size++;
+		return _storage + idx;
+	}
+#endif
+
 	/** Append an element to the end of the array. */
-	void push_back(const Array<T> &array) {
+	void push_back(const ArrayBase &array) {
 		if (_size + array.size() <= _capacity) {
 			uninitialized_copy(array.begin(), array.end(), end());
 			_size += array.size();
@@ -208,7 +284,7 @@ public:
 	}
 
 	/** Insert copies of all the elements from the given array into this array at the given position. */
-	void insert_at(size_type idx, const Array<T> &array) {
+	void insert_at(size_type idx, const ArrayBase &array) {
 		assert(idx <= _size);
 		insert_aux(_storage + idx, array.begin(), array.end());
 	}
@@ -246,7 +322,7 @@ public:
 	}
 
 	/** Assign the given @p array to this array. */
-	Array<T> &operator=(const Array<T> &array) {
+	ArrayBase &operator=(const ArrayBase &array) {
 		if (this == &array)
 			return *this;
 
@@ -260,18 +336,12 @@ public:
 
 #ifdef USE_CXX11
 	/** Assign the given array to this array using the C++11 move semantic. */
-	Array &operator=(Array<T> &&old) {
+	ArrayBase &operator=(ArrayBase &&old) {
 		if (this == &old)
 			return *this;
 
-		freeStorage(_storage, _size);
-		_capacity = old._capacity;
-		_size = old._size;
-		_storage = old._storage;
-
-		old._storage = nullptr;
-		old._capacity = 0;
-		old._size = 0;
+		clear();
+		takeFrom(old);
 
 		return *this;
 	}
@@ -282,12 +352,17 @@ public:
 		return _size;
 	}
 
+	/** Return the number of elements the array can hold without reallocating. */
+	size_type capacity() const {
+		return _capacity;
+	}
+
 	/** Clear the array of all its elements. */
 	void clear() {
 		freeStorage(_storage, _size);
-		_storage = nullptr;
+		_storage = this->inlineStorage();
 		_size = 0;
-		_capacity = 0;
+		_capacity = N;
 	}
 
 	/** Erase the element at @p pos position and return an iterator pointing to the next element in the array. */
@@ -305,7 +380,7 @@ public:
 	}
 
 	/** Check whether two arrays are identical. */
-	bool operator==(const Array<T> &other) const {
+	bool operator==(const ArrayBase &other) const {
 		if (this == &other)
 			return true;
 		if (_size != other._size)
@@ -318,7 +393,7 @@ public:
 	}
 
 	/** Check if two arrays are different. */
-	bool operator!=(const Array<T> &other) const {
+	bool operator!=(const ArrayBase &other) const {
 		return !(*this == other);
 	}
 
@@ -352,11 +427,9 @@ public:
 		T *oldStorage = _storage;
 		allocCapacity(newCapacity);
 
-		if (oldStorage) {
-			// Copy old data
-			uninitialized_copy(oldStorage, oldStorage + _size, _storage);
-			freeStorage(oldStorage, _size);
-		}
+		// Move old data
+		uninitialized_move(oldStorage, oldStorage + _size, _storage);
+		freeStorage(oldStorage, _size);
 	}
 
 	/** Change the size of the array. */
@@ -390,15 +463,19 @@ protected:
 		return capa;
 	}
 
-	/** Allocate a specific capacity for the array. */
+	/**
+	 * Allocate a specific capacity for the array. Capacities the inline
+	 * storage can hold use it instead of the heap.
+	 */
 	void allocCapacity(size_type capacity) {
-		_capacity = capacity;
-		if (capacity) {
+		if (capacity <= N) {
+			_capacity = N;
+			_storage = this->inlineStorage();
+		} else {
+			_capacity = capacity;
 			_storage = (T *)malloc(sizeof(T) * capacity);
 			if (!_storage)
 				::error("Common::Array: failure to allocate %u bytes", capacity * (size_type)sizeof(T));
-		} else {
-			_storage = nullptr;
 		}
 	}
 
@@ -406,8 +483,31 @@ protected:
 	void freeStorage(T *storage, const size_type elements) {
 		for (size_type i = 0; i < elements; ++i)
 			storage[i].~T();
-		free(storage);
+		if (storage != this->inlineStorage())
+			free(storage);
+	}
+
+#ifdef USE_CXX11
+	/**
+	 * Take the elements of @p old, which is left empty. This array must be
+	 * empty and use its inline storage.
+	 */
+	void takeFrom(ArrayBase &old) {
+		if (old._storage == old.inlineStorage()) {
+			uninitialized_move(old._storage, old._storage + old._size, _storage);
+			_size = old._size;
+			old.clear();
+		} else {
+			_capacity = old._capacity;
+			_size = old._size;
+			_storage = old._storage;
+
+			old._storage = old.inlineStorage();
+			old._capacity = N;
+			old._size = 0;
+		}
 	}
+#endif
 
 	/**
 	 * Insert a range of elements coming from this or another array.
@@ -433,33 +533,35 @@ protected:
 
 				// If there is not enough space, allocate more.
 				// Likewise, if this is a self-insert, we allocate new
-				// storage to avoid conflicts.
-				allocCapacity(roundUpCapacity(_size + n));
+				// storage to avoid conflicts. That storage is always on
+				// the heap, as the inline storage is the old one.
+				allocCapacity(roundUpCapacity(MAX(_size + n, N + 1)));
 
-				// Copy the data from the old storage till the position where
-				// we insert new data
-				uninitialized_copy(oldStorage, oldStorage + idx, _storage);
-				// Copy the data we insert
+				// Copy the data we insert. This has to happen first, as
+				// the data may come from the old storage.
 				uninitialized_copy(first, last, _storage + idx);
-				// Afterwards, copy the old data from the position where we
+				// Move the data from the old storage till the position
+				// where we insert new data
+				uninitialized_move(oldStorage, oldStorage + idx, _storage);
+				// Afterwards, move the old data from the position where we
 				// insert.
-				uninitialized_copy(oldStorage + idx, oldStorage + _size, _storage + idx + n);
+				uninitialized_move(oldStorage + idx, oldStorage + _size, _storage + idx + n);
 
 				freeStorage(oldStorage, _size);
 			} else if (idx + n <= _size) {
 				// Make room for the new elements by shifting back
 				// existing ones.
 				// 1. Move a part of the data to the uninitialized area
-				uninitialized_copy(_storage + _size - n, _storage + _size, _storage + _size);
+				uninitialized_move(_storage + _size - n, _storage + _size, _storage + _size);
 				// 2. Move a part of the data to the initialized area
 				copy_backward(pos, _storage + _size - n, _storage + _size);
 
 				// Insert the new elements.
 				copy(first, last, pos);
 			} else {
-				// Copy the old data from the position till the end to the new
+				// Move the old data from the position till the end to the new
 				// place.
-				uninitialized_copy(pos, _storage + _size, _storage + idx + n);
+				uninitialized_move(pos, _storage + _size, _storage + idx + n);
 
 				// Copy a part of the new data to the position inside the
 				// initialized space.
@@ -472,12 +574,63 @@ protected:
 
 			// Finally, update the internal state
 			_size += n;
+			pos = _storage + idx;
 		}
 		return pos;
 	}
 
 };
 
+/**
+ * This class implements a dynamically sized container, which
+ * can be accessed similarly to a regular C++ array. Accessing
+ * elements is performed in constant time (like with plain arrays).
+ * In addition, you can append, insert, and remove entries (this
+ * is the 'dynamic' part). In general, doing that takes time
+ * proportional to the number of elements in the array.
+ *
+ * The container class closest to this in the C++ standard library is
+ * std::vector. However, there are some differences.
+ */
+template<class T>
+class Array : public ArrayBase<T, 0> {
+public:
+	typedef typename ArrayBase<T, 0>::size_type size_type; /*!< Size type of the array. */
+
+	Array() {}
+
+	/**
+	 * Construct an array with @p count default-inserted instances of @p T. No
+	 * copies are made.
+	 */
+	explicit Array(size_type count) : ArrayBase<T, 0>(count) {}
+
+	/**
+	 * Construct an array with @p count copies of elements with value @p value.
+	 */
+	Array(size_type count, const T &value) : ArrayBase<T, 0>(count, value) {}
+
+#ifdef USE_CXX11
+	/**
+	 * Construct an array using list initialization.
+	 * For example:
+	 * @code
+	 * Common::Array<int> myArray = {1, 7, 42};
+	 * @endcode
+	 * constructs an array with 3 elements whose values are 1, 7, and 42 respectively.
+	 * @note
+	 * This constructor is only available when C++11 support is enabled.
+	 */
+	Array(std::initializer_list<T> list) : ArrayBase<T, 0>(list) {}
+#endif
+
+	/**
+	 * Construct an array by copying data from a regular array.
+	 */
+	template<class T2>
+	Array(const T2 *array, size_type n) : ArrayBase<T, 0>(array, n) {}
+};
+
 /**
  * Array with sorted nodes.
  */
@@ -23,45 +23,39 @@
 #include "common/base-str.h"
 #include "common/hash-str.h"
 #include "common/list.h"
-#include "common/memorypool.h"
 #include "common/textconsole.h"
 #include "common/util.h"
-#include "common/mutex.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 namespace Common {
 
 #define TEMPLATE template<class T>
 #define BASESTRING BaseString<T>
 
-MemoryPool *g_refCountPool = nullptr; // FIXME: This is never freed right now
-#ifndef SCUMMVM_UTIL
-Mutex *g_refCountPoolMutex = nullptr;
-
-void lockMemoryPoolMutex() {
-	// The Mutex class can only be used once g_system is set and initialized,
-	// but we may use the String class earlier than that (it is for example
-	// used in the OSystem_POSIX constructor). However in those early stages
-	// we can hope we don't have multiple threads either.
-	if (!g_system || !g_system->backendInitialized())
-		return;
-	if (!g_refCountPoolMutex)
-		g_refCountPoolMutex = new Mutex();
-	g_refCountPoolMutex->lock();
-}
-
-void unlockMemoryPoolMutex() {
-	if (g_refCountPoolMutex)
-		g_refCountPoolMutex->unlock();
-}
-
-TEMPLATE void BASESTRING::releaseMemoryPoolMutex() {
-	if (g_refCountPoolMutex){
-		delete g_refCountPoolMutex;
-		g_refCountPoolMutex = nullptr;
-	}
+// The reference counts are updated atomically where the compiler allows it,
+// so that threads can copy the same shared string safely.
+static inline void incrementRefCount(int *refCount) {
+#if defined(__GNUC__) && GCC_ATLEAST(4, 7)
+	__atomic_add_fetch(refCount, 1, __ATOMIC_RELAXED);
+#elif defined(_MSC_VER)
+	_InterlockedIncrement((volatile long *)refCount);
+#else
+	++(*refCount);
+#endif
 }
 
+static inline int decrementRefCount(int *refCount) {
+#if defined(__GNUC__) && GCC_ATLEAST(4, 7)
+	return __atomic_sub_fetch(refCount, 1, __ATOMIC_ACQ_REL);
+#elif defined(_MSC_VER)
+	return _InterlockedDecrement((volatile long *)refCount);
+#else
+	return --(*refCount);
 #endif
+}
 
 static uint32 computeCapacity(uint32 len) {
 	// By default, for the capacity we use the next multiple of 32
@@ -75,6 +69,11 @@ BASESTRING::BaseString(const BASESTRING &str)
 		// String in internal storage: just copy it
 		memcpy(_storage, str._storage, _builtinCapacity * sizeof(value_type));
 		_str = _storage;
+	} else if (str._size < SCUMMVM_STRING_SHARE_MIN_LENGTH) {
+		// Short string in external storage: copying it is cheaper than
+		// sharing it
+		_str = _storage;
+		initWithValueTypeStr(str._str, str._size);
 	} else {
 		// String in external storage: use refcount mechanism
 		str.incRefCount();
@@ -85,6 +84,27 @@ BASESTRING::BaseString(const BASESTRING &str)
 	assert(_str != nullptr);
 }
 
+#ifdef USE_CXX11
+TEMPLATE
+BASESTRING::BaseString(BASESTRING &&str)
+	: _size(str._size) {
+	if (str.isStorageIntern()) {
+		// String in internal storage: just copy it
+		memcpy(_storage, str._storage, _builtinCapacity * sizeof(value_type));
+		_str = _storage;
+	} else {
+		// String in external storage: take over the reference of str
+		_extern._refCount = str._extern._refCount;
+		_extern._capacity = str._extern._capacity;
+		_str = str._str;
+	}
+
+	str._size = 0;
+	str._str = str._storage;
+	str._storage[0] = 0;
+}
+#endif
+
 TEMPLATE BASESTRING::BaseString(const value_type *str) : _size(0), _str(_storage) {
 	if (str == nullptr) {
 		_storage[0] = 0;
@@ -120,6 +140,7 @@ TEMPLATE void BASESTRING::ensureCapacity(uint32 new_size, bool keep_old) {
 	bool isShared;
 	uint32 curCapacity, newCapacity;
 	value_type *newStorage;
+	int *newRefCount = nullptr;
 	int *oldRefCount = _extern._refCount;
 
 	if (isStorageIntern()) {
@@ -150,8 +171,7 @@ TEMPLATE void BASESTRING::ensureCapacity(uint32 new_size, bool keep_old) {
 			newCapacity = MAX(curCapacity * 2, computeCapacity(new_size + 1));
 
 		// Allocate new storage
-		newStorage = new value_type[newCapacity];
-		assert(newStorage);
+		newStorage = allocExternStorage(newCapacity, newRefCount);
 	}
 
 	// Copy old data if needed, elsewise reset the new storage.
@@ -173,7 +193,7 @@ TEMPLATE void BASESTRING::ensureCapacity(uint32 new_size, bool keep_old) {
 		// Set the ref count & capacity if we use an external storage.
 		// It is important to do this *after* copying any old content,
 		// else we would override data that has not yet been copied!
-		_extern._refCount = nullptr;
+		_extern._refCount = newRefCount;
 		_extern._capacity = newCapacity;
 	}
 }
@@ -181,23 +201,7 @@ TEMPLATE void BASESTRING::ensureCapacity(uint32 new_size, bool keep_old) {
 TEMPLATE
 void BASESTRING::incRefCount() const {
 	assert(!isStorageIntern());
-	if (_extern._refCount == nullptr) {
-#ifndef SCUMMVM_UTIL
-		lockMemoryPoolMutex();
-#endif
-		if (g_refCountPool == nullptr) {
-			g_refCountPool = new MemoryPool(sizeof(int));
-			assert(g_refCountPool);
-		}
-
-		_extern._refCount = (int *)g_refCountPool->allocChunk();
-#ifndef SCUMMVM_UTIL
-		unlockMemoryPoolMutex();
-#endif
-		*_extern._refCount = 2;
-	} else {
-		++(*_extern._refCount);
-	}
+	incrementRefCount(_extern._refCount);
 }
 
 TEMPLATE
@@ -205,27 +209,14 @@ void BASESTRING::decRefCount(int *oldRefCount) {
 	if (isStorageIntern())
 		return;
 
-	if (oldRefCount) {
-		--(*oldRefCount);
-	}
-	if (!oldRefCount || *oldRefCount <= 0) {
-		// The ref count reached zero, so we free the string storage
-		// and the ref count storage.
-		if (oldRefCount) {
-#ifndef SCUMMVM_UTIL
-			lockMemoryPoolMutex();
-#endif
-			assert(g_refCountPool);
-			g_refCountPool->freeChunk(oldRefCount);
-#ifndef SCUMMVM_UTIL
-			unlockMemoryPoolMutex();
-#endif
-		}
+	if (decrementRefCount(oldRefCount) <= 0) {
+		// The ref count reached zero, so we free the string storage,
+		// which the ref count is part of.
 		// Coverity thinks that we always free memory, as it assumes
 		// (correctly) that there are cases when oldRefCount == 0
 		// Thus, DO NOT COMPILE, trick it and shut tons of false positives
 #ifndef __COVERITY__
-		delete[] _str;
+		free(oldRefCount);
 #endif
 
 		// Even though _str points to a freed memory block now,
@@ -234,6 +225,17 @@ void BASESTRING::decRefCount(int *oldRefCount) {
 	}
 }
 
+TEMPLATE
+typename BASESTRING::value_type *BASESTRING::allocExternStorage(uint32 capacity, int *&refCount) {
+	// The ref count comes first, the value types need no stricter alignment
+	assert(sizeof(value_type) <= sizeof(int));
+	refCount = (int *)malloc(sizeof(int) + capacity * sizeof(value_type));
+	if (!refCount)
+		::error("Common::String: failure to allocate %u bytes", capacity * (uint)sizeof(value_type));
+	*refCount = 1;
+	return (value_type *)(refCount + 1);
+}
+
 TEMPLATE void BASESTRING::initWithValueTypeStr(const value_type *str, uint32 len) {
 	assert(str);
 
@@ -243,10 +245,11 @@ TEMPLATE void BASESTRING::initWithValueTypeStr(const value_type *str, uint32 len
 
 	if (len >= _builtinCapacity) {
 		// Not enough internal storage, so allocate more
-		_extern._capacity = computeCapacity(len + 1);
-		_extern._refCount = nullptr;
-		_str = new value_type[_extern._capacity];
-		assert(_str != nullptr);
+		int *refCount;
+		const uint32 capacity = computeCapacity(len + 1);
+		_str = allocExternStorage(capacity, refCount);
+		_extern._refCount = refCount;
+		_extern._capacity = capacity;
 	}
 
 	// Copy the string into the storage area
@@ -507,6 +510,17 @@ TEMPLATE void BASESTRING::assign(const BaseString &str) {
 		_size = str._size;
 		_str = _storage;
 		memcpy(_str, str._str, (_size + 1) * sizeof(value_type));
+	} else if (str._size < SCUMMVM_STRING_SHARE_MIN_LENGTH) {
+		// Short string in external storage: copy it, reusing our own
+		// storage if it is large enough and not shared
+		if (!isStorageIntern() && *_extern._refCount == 1 && str._size < _extern._capacity) {
+			_size = str._size;
+			memcpy(_str, str._str, (_size + 1) * sizeof(value_type));
+		} else {
+			decRefCount(_extern._refCount);
+			_str = _storage;
+			initWithValueTypeStr(str._str, str._size);
+		}
 	} else {
 		str.incRefCount();
 		decRefCount(_extern._refCount);
@@ -518,6 +532,30 @@ TEMPLATE void BASESTRING::assign(const BaseString &str) {
 	}
 }
 
+#ifdef USE_CXX11
+TEMPLATE void BASESTRING::assign(BaseString &&str) {
+	if (&str == this)
+		return;
+
+	if (str.isStorageIntern()) {
+		assign(static_cast<const BaseString &>(str));
+		return;
+	}
+
+	// Take over the reference of str, instead of adding one
+	decRefCount(_extern._refCount);
+
+	_extern._refCount = str._extern._refCount;
+	_extern._capacity = str._extern._capacity;
+	_size = str._size;
+	_str = str._str;
+
+	str._size = 0;
+	str._str = str._storage;
+	str._storage[0] = 0;
+}
+#endif
+
 TEMPLATE void BASESTRING::assign(value_type c) {
 	decRefCount(_extern._refCount);
 	_str = _storage;
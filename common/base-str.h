@@ -28,12 +28,28 @@
 
 #include <stdarg.h>
 
+/**
+ * The size in bytes the String class aims at, including its internal
+ * storage. Ports short on memory may lower it, at the cost of more heap
+ * allocations.
+ */
+#ifndef SCUMMVM_STRING_BUILTIN_SIZE
+#define SCUMMVM_STRING_BUILTIN_SIZE 32
+#endif
+
+/**
+ * Copies of strings shorter than this, which do not fit in the internal
+ * storage, get their own buffer instead of sharing the one of the original
+ * string.
+ */
+#ifndef SCUMMVM_STRING_SHARE_MIN_LENGTH
+#define SCUMMVM_STRING_SHARE_MIN_LENGTH 64
+#endif
+
 namespace Common {
 template<class T>
 class BaseString {
 public:
-	static void releaseMemoryPoolMutex();
-
 	static const uint32 npos = 0xFFFFFFFF;
 	typedef T          value_type;
 	typedef T *        iterator;
@@ -45,7 +61,7 @@ protected:
 	 * allocations are needed, at the cost of more stack memory usage,
 	 * and of course lots of wasted memory.
 	 */
-	static const uint32 _builtinCapacity = 32 - (sizeof(uint32) + sizeof(char *)) / sizeof(value_type);
+	static const uint32 _builtinCapacity = SCUMMVM_STRING_BUILTIN_SIZE - (sizeof(uint32) + sizeof(char *)) / sizeof(value_type);
 
 	/**
 	 * Length of the string. Stored to avoid having to call strlen
@@ -68,7 +84,8 @@ protected:
 		value_type _storage[_builtinCapacity];
 		/**
 		 * External string storage data -- the refcounter, and the
-		 * capacity of the string _str points to.
+		 * capacity of the string _str points to. The refcounter is
+		 * stored in the same heap block, just before the string.
 		 */
 		struct {
 			mutable int *_refCount;
@@ -87,6 +104,11 @@ public:
 	/** Construct a copy of the given string. */
 	BaseString(const BaseString &str);
 
+#ifdef USE_CXX11
+	/** Construct a string by taking over the storage of @p str, which is left empty. */
+	BaseString(BaseString &&str);
+#endif
+
 	/** Construct a new string from the given NULL-terminated C string. */
 	explicit BaseString(const value_type *str);
 
@@ -242,12 +264,16 @@ protected:
 	void ensureCapacity(uint32 new_size, bool keep_old);
 	void incRefCount() const;
 	void decRefCount(int *oldRefCount);
+	static value_type *allocExternStorage(uint32 capacity, int *&refCount);
 	void initWithValueTypeStr(const value_type *str, uint32 len);
 
 	void assignAppend(const value_type *str);
 	void assignAppend(value_type c);
 	void assignAppend(const BaseString &str);
 	void assign(const BaseString &str);
+#ifdef USE_CXX11
+	void assign(BaseString &&str);
+#endif
 	void assign(value_type c);
 	void assign(const value_type *str);
 
@@ -42,6 +42,23 @@ namespace Common {
  * @{
  */
 
+class BitStreamMemoryStream;
+
+/**
+ * Whether a bit stream may read ahead of the bits it hands out. This is
+ * only allowed for streams that nothing else reads from, and pays off for
+ * streams whose reads are cheap.
+ */
+template<class STREAM>
+struct BitStreamReadAhead {
+	enum { value = false };
+};
+
+template<>
+struct BitStreamReadAhead<BitStreamMemoryStream> {
+	enum { value = true };
+};
+
 /**
  * A template implementing a bit stream for different data memory layouts.
  *
@@ -87,7 +104,14 @@ private:
 
 	/** Fill the container with at least @p min bits. */
 	inline void fillContainer(size_t min) {
-		while (_bitsLeft < min) {
+		if (_bitsLeft >= min)
+			return;
+
+		// When allowed, fill the whole container at once, so that the
+		// following reads don't need to refill it again
+		const size_t target = BitStreamReadAhead<STREAM>::value ? 64 - valueBits : min;
+
+		while (_bitsLeft < target) {
 
 			uint64 data;
 			if (_pos + _bitsLeft + valueBits <= _size) {
@@ -109,7 +133,7 @@ private:
 
 			_bitsLeft += valueBits;
 		}
-}
+	}
 
 	/** Get @p n bits from the bit container. */
 	inline static uint32 getNBits(uint64 value, size_t n) {
@@ -67,6 +67,52 @@ ReadStream *wrapBufferedReadStream(ReadStream *parentStream, uint32 bufSize, Dis
  */
 SeekableReadStream *wrapBufferedSeekableReadStream(SeekableReadStream *parentStream, uint32 bufSize, DisposeAfterUse::Flag disposeParentStream);
 
+/**
+ * Take an arbitrary ReadStream and wrap it in a custom stream that reads it
+ * ahead of time in the background, into @p bufCount buffers of @p bufSize
+ * bytes each. This is meant for data read sequentially while the engine
+ * runs, such as videos or streamed audio, when the storage is slow to
+ * respond, as network filesystems and SD cards are.
+ *
+ * The buffers are filled on a worker thread, see OSystem::createThreadPool().
+ * Should all the buffers be empty when data is needed, or should the backend
+ * have no threads, the data is read directly, just as with a buffered stream.
+ *
+ * The wrapped stream is read from the worker thread. It must therefore not
+ * share its file handle with other streams, as the members of most
+ * archives do, and must not be used directly as long as the wrapper exists.
+ * The wrapper itself must only be used by one thread.
+ *
+ * It is safe to call this with a NULL parameter (in this case, NULL is
+ * returned).
+ *
+ * @param parentStream        The ReadStream to wrap in a custom stream.
+ * @param bufSize             Size of each buffer.
+ * @param bufCount            Number of buffers, rounded up to a power of two.
+ * @param disposeParentStream Flag indicating whether to dispose of the wrapped stream.
+ */
+ReadStream *wrapReadAheadReadStream(ReadStream *parentStream, uint32 bufSize, uint32 bufCount, DisposeAfterUse::Flag disposeParentStream);
+
+/**
+ * Take an arbitrary SeekableReadStream and wrap it in a custom stream that
+ * reads it ahead of time in the background. See wrapReadAheadReadStream()
+ * for details.
+ *
+ * Seeking into the data already read ahead keeps it. Seeking anywhere else
+ * drops it, and pauses the reading ahead until a whole buffer has been read
+ * from the new position, so that random accesses do not read data for
+ * nothing.
+ *
+ * It is safe to call this with a NULL parameter (in this case, NULL is
+ * returned).
+ *
+ * @param parentStream        The SeekableReadStream to wrap in a custom stream.
+ * @param bufSize             Size of each buffer.
+ * @param bufCount            Number of buffers, rounded up to a power of two.
+ * @param disposeParentStream Flag indicating whether to dispose of the wrapped stream.
+ */
+SeekableReadStream *wrapReadAheadSeekableReadStream(SeekableReadStream *parentStream, uint32 bufSize, uint32 bufCount, DisposeAfterUse::Flag disposeParentStream);
+
 /**
  * Take an arbitrary WriteStream and wrap it in a custom stream that
  * transparently provides buffering.
@@ -24,8 +24,11 @@
 #include "common/debug.h"
 #include "common/file.h"
 #include "common/fs.h"
+#include "common/memstream.h"
+#include "common/mutex.h"
 #include "common/system.h"
 #include "common/textconsole.h"
+#include "common/threadpool.h"
 
 static bool isValidDomainName(const Common::String &domName) {
 	const char *p = domName.c_str();
@@ -50,7 +53,28 @@ char const *const ConfigManager::kCloudDomain = "cloud";
 #pragma mark -
 
 
-ConfigManager::ConfigManager() : _activeDomain(nullptr) {
+// Time the configuration file is written after the last flushToDisk() call
+static const uint32 kConfigFlushDelay = 500;
+// How often the flush proc checks whether the pending data was written meanwhile
+static const uint32 kConfigFlushPollDelay = 50;
+
+static uint32 hashConfigData(const byte *data, uint32 size) {
+	// FNV-1a, only used to notice when the configuration did not change
+	uint32 hash = 2166136261u;
+	for (uint32 i = 0; i < size; i++)
+		hash = (hash ^ data[i]) * 16777619u;
+	return hash;
+}
+
+ConfigManager::ConfigManager() : _activeDomain(nullptr), _flushPool(nullptr), _flushMutex(nullptr), _pendingData(nullptr), _pendingSize(0),
+	_pendingHash(0), _pendingDeadline(0), _flushJobRunning(false), _hasWrittenData(false), _writtenHash(0), _writtenSize(0) {
+}
+
+ConfigManager::~ConfigManager() {
+	flushPendingWrites();
+	// This waits for the flush proc, which stops once it sees nothing is pending
+	delete _flushPool;
+	delete _flushMutex;
 }
 
 void ConfigManager::defragment() {
@@ -250,42 +274,23 @@ void ConfigManager::loadFromStream(SeekableReadStream &stream) {
 
 void ConfigManager::flushToDisk() {
 #ifndef __DC__
-	WriteStream *stream;
-
-	if (_filename.empty()) {
-		// Write to the default config file
-		assert(g_system);
-		stream = g_system->createConfigWriteStream();
-		if (!stream)    // If writing to the config file is not possible, do nothing
-			return;
-	} else {
-		DumpFile *dump = new DumpFile();
-		assert(dump);
-
-		if (!dump->open(_filename)) {
-			warning("Unable to write configuration file: %s", _filename.c_str());
-			delete dump;
-			return;
-		}
-
-		stream = dump;
-	}
+	MemoryWriteStreamDynamic stream(DisposeAfterUse::NO);
 
 	// Write the application domain
-	writeDomain(*stream, kApplicationDomain, _appDomain);
+	writeDomain(stream, kApplicationDomain, _appDomain);
 
 	// Write the keymapper domain
-	writeDomain(*stream, kKeymapperDomain, _keymapperDomain);
+	writeDomain(stream, kKeymapperDomain, _keymapperDomain);
 #ifdef USE_CLOUD
 	// Write the cloud domain
-	writeDomain(*stream, kCloudDomain, _cloudDomain);
+	writeDomain(stream, kCloudDomain, _cloudDomain);
 #endif
 
 	DomainMap::const_iterator d;
 
 	// Write the miscellaneous domains next
 	for (d = _miscDomains.begin(); d != _miscDomains.end(); ++d) {
-		writeDomain(*stream, d->_key, d->_value);
+		writeDomain(stream, d->_key, d->_value);
 	}
 
 	// First write the domains in _domainSaveOrder, in that order.
@@ -294,21 +299,140 @@ void ConfigManager::flushToDisk() {
 	Array<String>::const_iterator i;
 	for (i = _domainSaveOrder.begin(); i != _domainSaveOrder.end(); ++i) {
 		if (_gameDomains.contains(*i)) {
-			writeDomain(*stream, *i, _gameDomains[*i]);
+			writeDomain(stream, *i, _gameDomains[*i]);
 		}
 	}
 
 	// Now write the domains which haven't been written yet
 	for (d = _gameDomains.begin(); d != _gameDomains.end(); ++d) {
 		if (find(_domainSaveOrder.begin(), _domainSaveOrder.end(), d->_key) == _domainSaveOrder.end())
-			writeDomain(*stream, d->_key, d->_value);
+			writeDomain(stream, d->_key, d->_value);
+	}
+
+	uint32 size = stream.size();
+	uint32 hash = hashConfigData(stream.getData(), size);
+
+	if (!_flushPool) {
+		// One worker thread, and the calling thread which is not used
+		_flushPool = g_system->createThreadPool(2);
+		if (_flushPool->getThreadCount() < 2) {
+			delete _flushPool;
+			_flushPool = nullptr;
+		} else if (!_flushMutex) {
+			// The mutex is only needed, and only created, once the file is
+			// written from a worker thread
+			_flushMutex = new Mutex();
+		}
+	}
+
+	if (_flushMutex)
+		_flushMutex->lock();
+
+	// Don't rewrite the file if nothing changed
+	bool unchanged = _hasWrittenData && hash == _writtenHash && size == _writtenSize;
+
+	// Keep the deadline of a flush still pending, so that a stream of
+	// flushes does not postpone the write forever
+	if (!_pendingData)
+		_pendingDeadline = g_system->getMillis(true) + kConfigFlushDelay;
+
+	free(_pendingData);
+	_pendingData = unchanged ? nullptr : stream.getData();
+	_pendingSize = size;
+	_pendingHash = hash;
+
+	if (!unchanged && _flushPool && !_flushJobRunning) {
+		_flushJobRunning = true;
+		if (!_flushPool->startBackgroundJob(&flushProc, this))
+			_flushJobRunning = false;
 	}
 
-	delete stream;
+	// Without a worker thread, the file is written right away
+	if (!_flushJobRunning)
+		writePendingData();
+
+	if (_flushMutex)
+		_flushMutex->unlock();
 
+	if (unchanged)
+		free(stream.getData());
 #endif // !__DC__
 }
 
+void ConfigManager::flushPendingWrites() {
+	if (_flushMutex)
+		_flushMutex->lock();
+	writePendingData();
+	if (_flushMutex)
+		_flushMutex->unlock();
+}
+
+void ConfigManager::flushProc(void *refCon) {
+	ConfigManager *configManager = (ConfigManager *)refCon;
+
+	while (true) {
+		int32 remaining;
+		{
+			StackLock lock(*configManager->_flushMutex);
+			if (!configManager->_pendingData) {
+				configManager->_flushJobRunning = false;
+				return;
+			}
+
+			remaining = (int32)(configManager->_pendingDeadline - g_system->getMillis(true));
+			if (remaining <= 0) {
+				configManager->writePendingData();
+				continue;
+			}
+		}
+
+		// Wake up now and then, so that the pool can be deleted soon after
+		// flushPendingWrites() wrote the data
+		g_system->delayMillis(MIN<uint32>(remaining, kConfigFlushPollDelay));
+	}
+}
+
+void ConfigManager::writePendingData() {
+	if (!_pendingData)
+		return;
+
+	WriteStream *stream;
+
+	if (_filename.empty()) {
+		// Write to the default config file
+		assert(g_system);
+		stream = g_system->createConfigWriteStream();
+	} else {
+		DumpFile *dump = new DumpFile();
+		assert(dump);
+
+		if (!dump->open(_filename)) {
+			warning("Unable to write configuration file: %s", _filename.c_str());
+			delete dump;
+			dump = nullptr;
+		}
+
+		stream = dump;
+	}
+
+	// If writing to the config file is not possible, do nothing
+	if (stream) {
+		stream->write(_pendingData, _pendingSize);
+		stream->finalize();
+		if (stream->err()) {
+			warning("Unable to write configuration file: %s", _filename.empty() ? g_system->getDefaultConfigFileName().c_str() : _filename.c_str());
+		} else {
+			_hasWrittenData = true;
+			_writtenHash = _pendingHash;
+			_writtenSize = _pendingSize;
+		}
+		delete stream;
+	}
+
+	free(_pendingData);
+	_pendingData = nullptr;
+}
+
 void ConfigManager::writeDomain(WriteStream &stream, const String &name, const Domain &domain) {
 	if (domain.empty())
 		return; // Don't bother writing empty domains.
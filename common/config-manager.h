@@ -41,6 +41,8 @@ namespace Common {
  * @{
  */
 
+class Mutex;
+class ThreadPool;
 class WriteStream;
 class SeekableReadStream;
 
@@ -185,7 +187,15 @@ public:
 	void                     registerDefault(const String &key, int value); /*!< @overload */
 	void                     registerDefault(const String &key, bool value); /*!< @overload */
 
-	void                     flushToDisk(); /*!< Flush configuration to disk. */
+	/**
+	 * Flush configuration to disk.
+	 *
+	 * Nothing is written if the configuration did not change since the last
+	 * flush. When the backend provides a worker thread, the file is written
+	 * from it shortly after, so that successive flushes are coalesced.
+	 */
+	void                     flushToDisk();
+	void                     flushPendingWrites(); /*!< Write to disk right away the configuration of a flush still pending, if any. */
 
 	void                     setActiveDomain(const String &domName); /*!< Set the given domain as active. */
 	Domain                  *getActiveDomain() { return _activeDomain; } /*!< Get the active domain. */
@@ -215,11 +225,14 @@ public:
 private:
 	friend class Singleton<SingletonBaseType>;
 	ConfigManager();
+	~ConfigManager();
 
 	void			loadFromStream(SeekableReadStream &stream);
 	void			addDomain(const String &domainName, const Domain &domain);
 	void			writeDomain(WriteStream &stream, const String &name, const Domain &domain);
 	void			renameDomain(const String &oldName, const String &newName, DomainMap &map);
+	void			writePendingData();
+	static void		flushProc(void *refCon);
 
 	Domain			_transientDomain;
 	DomainMap		_gameDomains;
@@ -239,6 +252,17 @@ private:
 	Domain *		_activeDomain;
 
 	String			_filename;
+
+	ThreadPool *	_flushPool;        ///< Provides the worker thread the flush proc runs on, or null
+	Mutex *			_flushMutex;       ///< Guards the pending and written data once the flush proc runs on a worker thread
+	byte *			_pendingData;      ///< Serialized configuration waiting to be written, or null
+	uint32			_pendingSize;
+	uint32			_pendingHash;
+	uint32			_pendingDeadline;  ///< Time at which the pending data is written, from getMillis(true)
+	bool			_flushJobRunning;
+	bool			_hasWrittenData;   ///< Whether _writtenHash and _writtenSize describe the file on disk
+	uint32			_writtenHash;
+	uint32			_writtenSize;
 };
 
 /** @} */
@@ -107,6 +107,7 @@ CoroutineScheduler::CoroutineScheduler() {
 
 	pRCfunction = nullptr;
 	pidCounter = 0;
+	signalCount = 0;
 
 	active = new PROCESS;
 	active->pPrevious = nullptr;
@@ -166,6 +167,7 @@ void CoroutineScheduler::reset() {
 
 	// no active processes
 	pCurrent = active->pNext = nullptr;
+	++signalCount;
 
 	// place first process on free list
 	pFreeProcesses = processList;
@@ -226,9 +228,14 @@ void CoroutineScheduler::schedule() {
 	while (pProc != nullptr) {
 		pNext = pProc->pNext;
 
-		if (--pProc->sleepTime <= 0) {
+		if (--pProc->sleepTime <= 0 && pProc->blocked && pProc->wakeSignal == signalCount
+				&& g_system->getMillis() < pProc->wakeTime) {
+			// Nothing the process is waiting for has changed, so it would only block again
+			pProc->sleepTime = 1;
+		} else if (pProc->sleepTime <= 0) {
 			// process is ready for dispatch, activate it
 			pCurrent = pProc;
+			pProc->blocked = false;
 			pProc->coroAddr(pProc->state, pProc->param);
 
 			if (!pProc->state || pProc->state->_sleep <= 0) {
@@ -388,7 +395,8 @@ void CoroutineScheduler::waitForSingleObject(CORO_PARAM, int pid, uint32 duratio
 			break;
 		}
 
-		// Sleep until the next cycle
+		// Sleep until something changes
+		blockCurrent(_ctx->endTime == CORO_INFINITE ? CORO_INFINITE : _ctx->endTime + 1);
 		CORO_SLEEP(1);
 	}
 
@@ -455,7 +463,8 @@ void CoroutineScheduler::waitForMultipleObjects(CORO_PARAM, int nCount, uint32 *
 			break;
 		}
 
-		// Sleep until the next cycle
+		// Sleep until something changes
+		blockCurrent(_ctx->endTime == CORO_INFINITE ? CORO_INFINITE : _ctx->endTime + 1);
 		CORO_SLEEP(1);
 	}
 
@@ -481,7 +490,8 @@ void CoroutineScheduler::sleep(CORO_PARAM, uint32 duration) {
 
 	// Outer loop for doing checks until expiry
 	while (g_system->getMillis() < _ctx->endTime) {
-		// Sleep until the next cycle
+		// Sleep until the end time
+		blockCurrent(_ctx->endTime);
 		CORO_SLEEP(1);
 	}
 
@@ -536,6 +546,7 @@ PROCESS *CoroutineScheduler::createProcess(uint32 pid, CORO_ADDR coroAddr, const
 
 	// wake process up as soon as possible
 	pProc->sleepTime = 1;
+	pProc->blocked = false;
 
 	// set new process id
 	pProc->pid = pid;
@@ -580,6 +591,7 @@ void CoroutineScheduler::killProcess(PROCESS *pKillProc) {
 
 	delete pKillProc->state;
 	pKillProc->state = nullptr;
+	++signalCount;
 
 	// Take the process out of the active chain list
 	pKillProc->pPrevious->pNext = pKillProc->pNext;
@@ -649,6 +661,9 @@ int CoroutineScheduler::killMatchingProcess(uint32 pidKill, int pidMask) {
 		}
 	}
 
+	if (numKilled)
+		++signalCount;
+
 #ifdef DEBUG
 	// adjust process in use
 	numProcs -= numKilled;
@@ -671,6 +686,12 @@ PROCESS *CoroutineScheduler::getProcess(uint32 pid) {
 	return pProc;
 }
 
+void CoroutineScheduler::blockCurrent(uint32 wakeTime) {
+	pCurrent->blocked = true;
+	pCurrent->wakeTime = wakeTime;
+	pCurrent->wakeSignal = signalCount;
+}
+
 EVENT *CoroutineScheduler::getEvent(uint32 pid) {
 	Common::List<EVENT *>::iterator i;
 	for (i = _events.begin(); i != _events.end(); ++i) {
@@ -699,13 +720,16 @@ void CoroutineScheduler::closeEvent(uint32 pidEvent) {
 	if (evt) {
 		_events.remove(evt);
 		delete evt;
+		++signalCount;
 	}
 }
 
 void CoroutineScheduler::setEvent(uint32 pidEvent) {
 	EVENT *evt = getEvent(pidEvent);
-	if (evt)
+	if (evt) {
 		evt->signalled = true;
+		++signalCount;
+	}
 }
 
 void CoroutineScheduler::resetEvent(uint32 pidEvent) {
@@ -722,6 +746,7 @@ void CoroutineScheduler::pulseEvent(uint32 pidEvent) {
 	// Set the event as signalled and pulsing
 	evt->signalled = true;
 	evt->pulsing = true;
+	++signalCount;
 
 	// If there's an active process, and it's not the first in the queue, then reschedule all
 	// the other prcoesses in the queue to run again this frame
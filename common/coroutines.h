@@ -308,6 +308,9 @@ struct PROCESS {
 	int sleepTime;      ///< Number of scheduler cycles to sleep.
 	uint32 pid;         ///< Process ID.
 	uint32 pidWaiting[CORO_MAX_PID_WAITING];    ///< Process ID(s) that the process is currently waiting on.
+	bool blocked;       ///< Set while the process is waiting or sleeping, and need not be resumed until woken.
+	uint32 wakeTime;    ///< Time in milliseconds at which a blocked process must be resumed.
+	uint32 wakeSignal;  ///< Scheduler signal count when a blocked process last checked what it is waiting on.
 	char param[CORO_PARAM_SIZE];    ///< Process-specific information.
 };
 typedef PROCESS *PPROCESS;
@@ -362,6 +365,12 @@ private:
 	/** Event list. */
 	Common::List<EVENT *> _events;
 
+	/**
+	 * Incremented whenever a process ends or an event is signalled, so that
+	 * blocked processes are only resumed when what they wait on may have changed.
+	 */
+	uint32 signalCount;
+
 #ifdef DEBUG
 	/** Diagnostic process counters. */
 	int numProcs;
@@ -382,6 +391,12 @@ private:
 
 	PROCESS *getProcess(uint32 pid);
 	EVENT *getEvent(uint32 pid);
+
+	/**
+	 * Mark the current process as blocked until the given time, or until a
+	 * process ends or an event is signalled.
+	 */
+	void blockCurrent(uint32 wakeTime);
 public:
 	/**
 	 * Kill all processes and place them on the free list.
@@ -65,15 +65,50 @@ EventDispatcher::~EventDispatcher() {
 	}
 }
 
+/**
+ * Merge a motion event into the preceding one from the same source, when
+ * only the latest state of the pointer or axis matters.
+ *
+ * @return False if the events cannot be merged.
+ */
+static bool coalesceMotionEvents(Event &event, const Event &nextEvent) {
+	if (event.type != nextEvent.type)
+		return false;
+
+	if (event.type == EVENT_MOUSEMOVE) {
+		event.mouse = nextEvent.mouse;
+		event.relMouse += nextEvent.relMouse;
+		return true;
+	}
+
+	if (event.type == EVENT_JOYAXIS_MOTION && event.joystick.axis == nextEvent.joystick.axis) {
+		event.joystick.position = nextEvent.joystick.position;
+		return true;
+	}
+
+	return false;
+}
+
 void EventDispatcher::dispatch() {
 	Event event;
+	Event nextEvent;
 
 	dispatchPoll();
 
 	for (List<SourceEntry>::iterator i = _sources.begin(); i != _sources.end(); ++i) {
 		if (i->ignore)
 			continue;
-		while (i->source->pollEvent(event)) {
+
+		bool hasEvent = i->source->pollEvent(event);
+		while (hasEvent) {
+			// High polling rate mice and gamepads queue many motion events between
+			// two calls, only dispatch the latest state of each of them.
+			bool hasNextEvent = false;
+			if (event.type == EVENT_MOUSEMOVE || event.type == EVENT_JOYAXIS_MOTION) {
+				while ((hasNextEvent = i->source->pollEvent(nextEvent)) && coalesceMotionEvents(event, nextEvent)) {
+				}
+			}
+
 			// We only try to process the events via the setup event mapper, when
 			// we have a setup mapper and when the event source allows mapping.
 			if (i->source->allowMapping()) {
@@ -96,6 +131,12 @@ void EventDispatcher::dispatch() {
 			} else {
 				dispatchEvent(event);
 			}
+
+			if (hasNextEvent) {
+				event = nextEvent;
+			} else {
+				hasEvent = i->source->pollEvent(event);
+			}
 		}
 	}
 }
@@ -28,16 +28,49 @@
 
 #include "common/cosinetables.h"
 #include "common/fft.h"
+#include "common/spscqueue.h"
 #include "common/util.h"
 #include "common/textconsole.h"
 
+#if defined(__SSE2__)
+#define USE_FFT_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define USE_FFT_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Common {
 
+namespace {
+
+// The cosine tables only depend on their size, so all FFTs share them.
+// FFTs may be set up on several threads at once, e.g. by video decoders,
+// so each table is built once, published atomically and never freed.
+// All of them together take less than 800 KB.
+CosineTable *volatile s_cosTables[13];
+
+CosineTable *getCosTable(int i) {
+	CosineTable *table = loadAcquire(s_cosTables[i]);
+	if (table)
+		return table;
+
+	table = new CosineTable(1 << (i + 4));
+	if (!compareAndSwapPointer<CosineTable>(s_cosTables[i], nullptr, table)) {
+		// Another thread was faster
+		delete table;
+		table = loadAcquire(s_cosTables[i]);
+	}
+
+	return table;
+}
+
+} // End of anonymous namespace
+
 FFT::FFT(int bits, int inverse) : _bits(bits), _inverse(inverse) {
 	assert((_bits >= 2) && (_bits <= 16));
 
 	int n = 1 << bits;
-	int nPoints;
 
 	_tmpBuf = new Complex[n];
 	_expTab = new Complex[n / 2];
@@ -49,20 +82,14 @@ FFT::FFT(int bits, int inverse) : _bits(bits), _inverse(inverse) {
 		_revTab[-splitRadixPermutation(i, n, _inverse) & (n - 1)] = i;
 
 	for (int i = 0; i < ARRAYSIZE(_cosTables); i++) {
-		if (i + 4 <= _bits) {
-			nPoints = 1 << (i + 4);
-			_cosTables[i] = new Common::CosineTable(nPoints);
-		}
+		if (i + 4 <= _bits)
+			_cosTables[i] = getCosTable(i);
 		else
 			_cosTables[i] = nullptr;
 	}
 }
 
 FFT::~FFT() {
-	for (int i = 0; i < ARRAYSIZE(_cosTables); i++) {
-		delete _cosTables[i];
-	}
-
 	delete[] _revTab;
 	delete[] _expTab;
 	delete[] _tmpBuf;
@@ -176,11 +203,97 @@ static void name(Complex *z, const float *wre, unsigned int n) { \
 	} while(--n);\
 }
 
+#if defined(USE_FFT_SSE2)
+
+// Same as pass() and pass_big(), transforming z[0] and z[1] at once. All
+// inputs are loaded before storing any, like in pass_big().
+static void pass_simd(Complex *z, const float *wre, unsigned int n) {
+	const int o1 = 2 * n;
+	const int o2 = 4 * n;
+	const int o3 = 6 * n;
+	const float *wim = wre + o1;
+
+	// Negate the imaginary or the real parts
+	const __m128 negIm = _mm_set_ps(-1.0f, 1.0f, -1.0f, 1.0f);
+	const __m128 negRe = _mm_set_ps(1.0f, -1.0f, 1.0f, -1.0f);
+
+	for (unsigned int i = 0; i < n; i++, z += 2, wre += 2, wim -= 2) {
+		// The first weight is exactly 1, see TRANSFORM_ZERO
+		const __m128 vwre = _mm_set_ps(wre[1], wre[1], i ? wre[0] : 1.0f, i ? wre[0] : 1.0f);
+		const __m128 vwim = _mm_set_ps(wim[-1], wim[-1], i ? wim[0] : 0.0f, i ? wim[0] : 0.0f);
+
+		const __m128 a0 = _mm_loadu_ps(&z[0].re);
+		const __m128 a1 = _mm_loadu_ps(&z[o1].re);
+		const __m128 a2 = _mm_loadu_ps(&z[o2].re);
+		const __m128 a3 = _mm_loadu_ps(&z[o3].re);
+
+		// (t1, t2) and (t5, t6) of TRANSFORM
+		const __m128 a2Swapped = _mm_shuffle_ps(a2, a2, _MM_SHUFFLE(2, 3, 0, 1));
+		const __m128 a3Swapped = _mm_shuffle_ps(a3, a3, _MM_SHUFFLE(2, 3, 0, 1));
+		const __m128 t12 = _mm_add_ps(_mm_mul_ps(a2, vwre), _mm_mul_ps(_mm_mul_ps(a2Swapped, vwim), negIm));
+		const __m128 t56 = _mm_add_ps(_mm_mul_ps(a3, vwre), _mm_mul_ps(_mm_mul_ps(a3Swapped, vwim), negRe));
+
+		// BUTTERFLIES: the sums (t5, t6), and the differences (t4, t3)
+		const __m128 sum = _mm_add_ps(t12, t56);
+		const __m128 diff = _mm_mul_ps(_mm_sub_ps(t56, t12), negIm);
+		const __m128 diffSwapped = _mm_shuffle_ps(diff, diff, _MM_SHUFFLE(2, 3, 0, 1));
+
+		_mm_storeu_ps(&z[0].re, _mm_add_ps(a0, sum));
+		_mm_storeu_ps(&z[o2].re, _mm_sub_ps(a0, sum));
+		_mm_storeu_ps(&z[o1].re, _mm_add_ps(a1, diffSwapped));
+		_mm_storeu_ps(&z[o3].re, _mm_sub_ps(a1, diffSwapped));
+	}
+}
+
+#elif defined(USE_FFT_NEON)
+
+// Same as pass() and pass_big(), see the SSE2 version above
+static void pass_simd(Complex *z, const float *wre, unsigned int n) {
+	const int o1 = 2 * n;
+	const int o2 = 4 * n;
+	const int o3 = 6 * n;
+	const float *wim = wre + o1;
+
+	// Negate the imaginary or the real parts
+	const float32x4_t negIm = { 1.0f, -1.0f, 1.0f, -1.0f };
+	const float32x4_t negRe = { -1.0f, 1.0f, -1.0f, 1.0f };
+
+	for (unsigned int i = 0; i < n; i++, z += 2, wre += 2, wim -= 2) {
+		// The first weight is exactly 1, see TRANSFORM_ZERO
+		const float wre0 = i ? wre[0] : 1.0f;
+		const float wim0 = i ? wim[0] : 0.0f;
+		const float32x4_t vwre = { wre0, wre0, wre[1], wre[1] };
+		const float32x4_t vwim = { wim0, wim0, wim[-1], wim[-1] };
+
+		const float32x4_t a0 = vld1q_f32(&z[0].re);
+		const float32x4_t a1 = vld1q_f32(&z[o1].re);
+		const float32x4_t a2 = vld1q_f32(&z[o2].re);
+		const float32x4_t a3 = vld1q_f32(&z[o3].re);
+
+		// (t1, t2) and (t5, t6) of TRANSFORM
+		const float32x4_t t12 = vaddq_f32(vmulq_f32(a2, vwre), vmulq_f32(vmulq_f32(vrev64q_f32(a2), vwim), negIm));
+		const float32x4_t t56 = vaddq_f32(vmulq_f32(a3, vwre), vmulq_f32(vmulq_f32(vrev64q_f32(a3), vwim), negRe));
+
+		// BUTTERFLIES: the sums (t5, t6), and the differences (t4, t3)
+		const float32x4_t sum = vaddq_f32(t12, t56);
+		const float32x4_t diffSwapped = vrev64q_f32(vmulq_f32(vsubq_f32(t56, t12), negIm));
+
+		vst1q_f32(&z[0].re, vaddq_f32(a0, sum));
+		vst1q_f32(&z[o2].re, vsubq_f32(a0, sum));
+		vst1q_f32(&z[o1].re, vaddq_f32(a1, diffSwapped));
+		vst1q_f32(&z[o3].re, vsubq_f32(a1, diffSwapped));
+	}
+}
+
+#else
+
 PASS(pass)
 #undef BUTTERFLIES
 #define BUTTERFLIES BUTTERFLIES_BIG
 PASS(pass_big)
 
+#endif
+
 void FFT::fft4(Complex *z) {
 	float t1, t2, t3, t4, t5, t6, t7, t8;
 
@@ -245,10 +358,14 @@ void FFT::fft(int n, int logn, Complex *z) {
 		fft((n / 4), logn - 2, z + (n / 4) * 2);
 		fft((n / 4), logn - 2, z + (n / 4) * 3);
 		assert(_cosTables[logn - 4]);
+#if defined(USE_FFT_SSE2) || defined(USE_FFT_NEON)
+		pass_simd(z, _cosTables[logn - 4]->getTable(), (n / 4) / 2);
+#else
 		if (n > 1024)
 			pass_big(z, _cosTables[logn - 4]->getTable(), (n / 4) / 2);
 		else
 			pass(z, _cosTables[logn - 4]->getTable(), (n / 4) / 2);
+#endif
 	}
 }
 
@@ -143,6 +143,11 @@ uint32 File::read(void *ptr, uint32 len) {
 	return _handle->read(ptr, len);
 }
 
+const byte *File::readInPlace(uint32 dataSize) {
+	assert(_handle);
+	return _handle->readInPlace(dataSize);
+}
+
 
 DumpFile::DumpFile() : _handle(nullptr) {
 }
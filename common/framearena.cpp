@@ -0,0 +1,101 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/framearena.h"
+#include "common/textconsole.h"
+
+namespace Common {
+
+FrameArena::FrameArena(size_t blockSize)
+	: _blockSize(blockSize), _offset(0), _used(0), _highWaterMark(0), _blockAllocations(0) {
+	assert(blockSize > 0);
+}
+
+FrameArena::~FrameArena() {
+	for (uint i = 0; i < _blocks.size(); ++i)
+		::free(_blocks[i].data);
+}
+
+void FrameArena::addBlock(size_t minSize) {
+	Block block;
+	block.size = MAX(_blockSize, minSize);
+	block.data = (byte *)::malloc(block.size);
+	if (!block.data)
+		::error("FrameArena: failure to allocate %u bytes", (uint)block.size);
+
+	_blocks.push_back(block);
+	_offset = 0;
+	_blockAllocations++;
+
+	// Grow geometrically, so that a frame needs few blocks
+	_blockSize = block.size * 2;
+}
+
+void *FrameArena::allocate(size_t size, size_t alignment) {
+	assert(alignment && (alignment & (alignment - 1)) == 0);
+
+	size_t start = 0;
+	if (!_blocks.empty()) {
+		const Block &block = _blocks.back();
+		start = (((size_t)block.data + _offset + alignment - 1) & ~(alignment - 1)) - (size_t)block.data;
+	}
+
+	if (_blocks.empty() || start + size > _blocks.back().size) {
+		// malloc() aligns the blocks for any standard type, a stricter
+		// alignment may need some room up front
+		addBlock(size + alignment);
+		const Block &block = _blocks.back();
+		start = (((size_t)block.data + alignment - 1) & ~(alignment - 1)) - (size_t)block.data;
+	}
+
+	_used += start - _offset + size;
+	_offset = start + size;
+	return _blocks.back().data + start;
+}
+
+void FrameArena::reset() {
+	_highWaterMark = MAX(_highWaterMark, _used);
+
+	if (_blocks.size() > 1) {
+		// This frame needed several blocks. Replace them with one which
+		// is large enough for all of them, so the next frames need none.
+		size_t capacity = getCapacity();
+		for (uint i = 0; i < _blocks.size(); ++i)
+			::free(_blocks[i].data);
+		_blocks.clear();
+
+		_blockSize = capacity;
+		addBlock(capacity);
+	}
+
+	_offset = 0;
+	_used = 0;
+}
+
+size_t FrameArena::getCapacity() const {
+	size_t capacity = 0;
+	for (uint i = 0; i < _blocks.size(); ++i)
+		capacity += _blocks[i].size;
+	return capacity;
+}
+
+} // End of namespace Common
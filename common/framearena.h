@@ -0,0 +1,195 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_FRAMEARENA_H
+#define COMMON_FRAMEARENA_H
+
+#include "common/scummsys.h"
+#include "common/array.h"
+#include "common/noncopyable.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_frame_arena Frame arena
+ * @ingroup common_memory
+ *
+ * @brief Linear allocator for temporary data released all at once.
+ * @{
+ */
+
+/**
+ * A linear ("bump") allocator for the temporary data of a frame, like draw
+ * lists, sort buffers and scratch strings. Allocating only advances a
+ * pointer, and all the allocations are released together by reset().
+ *
+ * The arena grows by blocks as needed. When reset() finds more than one
+ * block, it replaces them with a single one large enough for everything,
+ * so that once the usage of the frames is stable, they do not call
+ * malloc() at all.
+ *
+ * An arena is not thread-safe: each thread needing one has to use its
+ * own instance.
+ */
+class FrameArena : NonCopyable {
+public:
+	/**
+	 * @param blockSize Size of the first block of the arena, allocated on
+	 *                  first use.
+	 */
+	explicit FrameArena(size_t blockSize = 64 * 1024);
+	~FrameArena();
+
+	/**
+	 * Allocate @p size bytes, aligned to @p alignment, which must be a
+	 * power of two. The memory lives until the next call to reset().
+	 */
+	void *allocate(size_t size, size_t alignment = 2 * sizeof(void *));
+
+	/**
+	 * Allocate uninitialized memory for @p count objects of type @p T.
+	 *
+	 * The alignment used is the largest power of two dividing the size of
+	 * @p T, up to the default alignment of allocate().
+	 */
+	template<class T>
+	T *allocateArray(size_t count) {
+		const size_t sizeAlignment = sizeof(T) & (~sizeof(T) + 1);
+		return (T *)allocate(count * sizeof(T), MIN<size_t>(sizeAlignment, 2 * sizeof(void *)));
+	}
+
+	/**
+	 * Release all the allocations at once. No destructors are called.
+	 */
+	void reset();
+
+	/** Return the number of bytes allocated since the last reset. */
+	size_t getUsed() const { return _used; }
+
+	/** Return the largest number of bytes allocated between two resets. */
+	size_t getHighWaterMark() const { return MAX(_highWaterMark, _used); }
+
+	/** Return the total size of the blocks owned by the arena. */
+	size_t getCapacity() const;
+
+	/** Return the number of times the arena had to allocate a block. */
+	uint32 getBlockAllocations() const { return _blockAllocations; }
+
+private:
+	struct Block {
+		byte *data;
+		size_t size;
+	};
+
+	void addBlock(size_t minSize);
+
+	Array<Block> _blocks;
+	size_t _blockSize;
+	size_t _offset;        ///< Offset of the free space in the last block
+	size_t _used;
+	size_t _highWaterMark;
+	uint32 _blockAllocations;
+};
+
+/**
+ * A growable array whose elements live in a FrameArena. It releases no
+ * memory itself: growing leaves the old storage in the arena until it is
+ * reset. The array must not be used anymore after that.
+ *
+ * Unlike an Array, this is meant for data which only exists for a frame,
+ * and then costs no heap allocation at all.
+ */
+template<class T>
+class ArenaArray : NonCopyable {
+public:
+	typedef T *iterator;
+	typedef const T *const_iterator;
+	typedef uint size_type;
+
+	explicit ArenaArray(FrameArena &arena, size_type capacity = 0) : _arena(arena), _storage(nullptr), _size(0), _capacity(0) {
+		reserve(capacity);
+	}
+
+	~ArenaArray() {
+		clear();
+	}
+
+	void push_back(const T &element) {
+		if (_size == _capacity)
+			reserve(_capacity ? _capacity * 2 : 16);
+		new ((void *)&_storage[_size++]) T(element);
+	}
+
+	void pop_back() {
+		assert(_size > 0);
+		_storage[--_size].~T();
+	}
+
+	void reserve(size_type capacity) {
+		if (capacity <= _capacity)
+			return;
+
+		T *oldStorage = _storage;
+		_storage = _arena.allocateArray<T>(capacity);
+		uninitialized_move(oldStorage, oldStorage + _size, _storage);
+		for (size_type i = 0; i < _size; ++i)
+			oldStorage[i].~T();
+		_capacity = capacity;
+	}
+
+	/** Destroy all the elements. The storage stays reserved. */
+	void clear() {
+		for (size_type i = 0; i < _size; ++i)
+			_storage[i].~T();
+		_size = 0;
+	}
+
+	size_type size() const { return _size; }
+	bool empty() const { return _size == 0; }
+
+	T &operator[](size_type idx) {
+		assert(idx < _size);
+		return _storage[idx];
+	}
+
+	const T &operator[](size_type idx) const {
+		assert(idx < _size);
+		return _storage[idx];
+	}
+
+	iterator begin() { return _storage; }
+	iterator end() { return _storage + _size; }
+	const_iterator begin() const { return _storage; }
+	const_iterator end() const { return _storage + _size; }
+
+private:
+	FrameArena &_arena;
+	T *_storage;
+	size_type _size;
+	size_type _capacity;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
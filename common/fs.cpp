@@ -125,6 +125,10 @@ bool FSNode::isWritable() const {
 	return _realNode && _realNode->isWritable();
 }
 
+bool FSNode::getFileStats(int64 &size, int64 &modificationTime) const {
+	return _realNode && _realNode->getFileStats(size, modificationTime);
+}
+
 SeekableReadStream *FSNode::createReadStream() const {
 	if (_realNode == nullptr)
 		return nullptr;
@@ -168,6 +172,17 @@ bool FSNode::createDirectory() const {
 	return _realNode->createDirectory();
 }
 
+bool FSNode::canRename() const {
+	return _realNode && _realNode->canRename();
+}
+
+bool FSNode::renameTo(const FSNode &target) const {
+	if (_realNode == nullptr || target._realNode == nullptr)
+		return false;
+
+	return _realNode->renameTo(*target._realNode);
+}
+
 FSDirectory::FSDirectory(const FSNode &node, int depth, bool flat, bool ignoreClashes, bool includeDirectories)
   : _node(node), _cached(false), _depth(depth), _flat(flat), _ignoreClashes(ignoreClashes),
 	_includeDirectories(includeDirectories) {
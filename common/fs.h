@@ -222,6 +222,16 @@ public:
 	 */
 	bool isWritable() const;
 
+	/**
+	 * Retrieve the size and the time of the last modification of the file
+	 * referred by this node, without opening it. The time is only meant to
+	 * be compared with other times returned by this method, to notice that
+	 * a file has changed.
+	 *
+	 * @return True if both values are known, false otherwise.
+	 */
+	bool getFileStats(int64 &size, int64 &modificationTime) const;
+
 	/**
 	 * Create a SeekableReadStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -248,6 +258,20 @@ public:
 	 * @return True if the directory was created, false otherwise.
 	 */
 	bool createDirectory() const;
+
+	/**
+	 * Check whether renameTo() is supported for this node.
+	 */
+	bool canRename() const;
+
+	/**
+	 * Rename the file referred by this node to the target. If the target
+	 * file exists, it is replaced in a single step, so that there is no
+	 * moment where neither file exists.
+	 *
+	 * @return True if the file was renamed, false otherwise.
+	 */
+	bool renameTo(const FSNode &target) const;
 };
 
 /**
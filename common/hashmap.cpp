@@ -40,13 +40,19 @@ uint hashit(const char *p) {
 	return hash ^ size;
 }
 
+// Convert an ASCII letter to lowercase, without the call and the locale
+// lookup of tolower(). Other characters are left unchanged.
+static inline byte foldCase(byte c) {
+	return c | ((byte)(c - 'A') < 26 ? 0x20 : 0);
+}
+
 // Like hashit, but converts every char to lowercase before hashing.
 uint hashit_lower(const char *p) {
-	uint hash = tolower(*p) << 7;
+	uint hash = (char)foldCase(*p) << 7;
 	byte c;
 	int size = 0;
 	while ((c = *p++)) {
-		hash = (1000003 * hash) ^ tolower(c);
+		hash = (1000003 * hash) ^ foldCase(c);
 		size++;
 	}
 	return hash ^ size;
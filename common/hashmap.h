@@ -123,6 +123,7 @@ private:
 	Val _defaultVal;
 
 	Node **_storage;	///< hashtable of size arrsize.
+	size_type *_hashes;	///< Full hash of the key stored in each used slot of _storage.
 	size_type _mask;		///< Capacity of the HashMap minus one; must be a power of two of minus one
 	size_type _size;
 	size_type _deleted; ///< Number of deleted elements (_dummyNodes)
@@ -155,7 +156,8 @@ private:
 	}
 
 	void assign(const HM_t &map);
-	size_type lookup(const Key &key) const;
+	size_type lookup(const Key &key) const { return lookup(key, _hash(key)); }
+	size_type lookup(const Key &key, size_type hash) const;
 	size_type lookupAndCreateIfMissing(const Key &key);
 	void expandStorage(size_type newCapacity);
 
@@ -236,6 +238,7 @@ public:
 		// Remove the previous content and ...
 		clear();
 		delete[] _storage;
+		delete[] _hashes;
 		// ... copy the new stuff.
 		assign(map);
 		return *this;
@@ -243,6 +246,15 @@ public:
 
 	bool contains(const Key &key) const;
 
+	/**
+	 * Check whether the hashmap contains @p key, whose hash was computed
+	 * beforehand with the same hash function as the one of the map. This
+	 * saves hashing the key again when looking it up in several maps.
+	 */
+	bool contains(const Key &key, size_type hash) const {
+		return _storage[lookup(key, hash)] != nullptr;
+	}
+
 	Val &operator[](const Key &key);
 	const Val &operator[](const Key &key) const;
 
@@ -299,6 +311,22 @@ public:
 		return end();
 	}
 
+	/** Find @p key, whose hash was computed beforehand. @see contains(const Key &, size_type) */
+	iterator	find(const Key &key, size_type hash) {
+		size_type ctr = lookup(key, hash);
+		if (_storage[ctr])
+			return iterator(ctr, this);
+		return end();
+	}
+
+	/** Find @p key, whose hash was computed beforehand. @see contains(const Key &, size_type) */
+	const_iterator	find(const Key &key, size_type hash) const {
+		size_type ctr = lookup(key, hash);
+		if (_storage[ctr])
+			return const_iterator(ctr, this);
+		return end();
+	}
+
 	// TODO: insert() method?
 	/** Return true if hashmap is empty. */
 	bool empty() const {
@@ -350,6 +378,8 @@ HashMap<Key, Val, HashFunc, EqualFunc>::HashMap() : _defaultVal() {
 	_storage = new Node *[HASHMAP_MIN_CAPACITY];
 	assert(_storage != nullptr);
 	memset(_storage, 0, HASHMAP_MIN_CAPACITY * sizeof(Node *));
+	_hashes = new size_type[HASHMAP_MIN_CAPACITY];
+	assert(_hashes != nullptr);
 
 	_size = 0;
 	_deleted = 0;
@@ -386,6 +416,7 @@ HashMap<Key, Val, HashFunc, EqualFunc>::~HashMap() {
 	  freeNode(_storage[ctr]);
 
 	delete[] _storage;
+	delete[] _hashes;
 #ifdef DEBUG_HASH_COLLISIONS
 	extern void updateHashCollisionStats(int, int, int, int, int);
 	updateHashCollisionStats(_collisions, _dummyHits, _lookups, _mask + 1, _size);
@@ -405,6 +436,8 @@ void HashMap<Key, Val, HashFunc, EqualFunc>::assign(const HM_t &map) {
 	_storage = new Node *[_mask + 1];
 	assert(_storage != nullptr);
 	memset(_storage, 0, (_mask + 1) * sizeof(Node *));
+	_hashes = new size_type[_mask + 1];
+	assert(_hashes != nullptr);
 
 	// Simply clone the map given to us, one by one.
 	_size = 0;
@@ -416,6 +449,7 @@ void HashMap<Key, Val, HashFunc, EqualFunc>::assign(const HM_t &map) {
 		} else if (map._storage[ctr] != nullptr) {
 			_storage[ctr] = allocNode(map._storage[ctr]->_key);
 			_storage[ctr]->_value = map._storage[ctr]->_value;
+			_hashes[ctr] = map._hashes[ctr];
 			_size++;
 		}
 	}
@@ -441,11 +475,14 @@ void HashMap<Key, Val, HashFunc, EqualFunc>::clear(bool shrinkArray) {
 
 	if (shrinkArray && _mask >= HASHMAP_MIN_CAPACITY) {
 		delete[] _storage;
+		delete[] _hashes;
 
 		_mask = HASHMAP_MIN_CAPACITY - 1;
 		_storage = new Node *[HASHMAP_MIN_CAPACITY];
 		assert(_storage != nullptr);
 		memset(_storage, 0, HASHMAP_MIN_CAPACITY * sizeof(Node *));
+		_hashes = new size_type[HASHMAP_MIN_CAPACITY];
+		assert(_hashes != nullptr);
 	}
 
 	_size = 0;
@@ -461,6 +498,7 @@ void HashMap<Key, Val, HashFunc, EqualFunc>::expandStorage(size_type newCapacity
 #endif
 	const size_type old_mask = _mask;
 	Node **old_storage = _storage;
+	size_type *old_hashes = _hashes;
 
 	// allocate a new array
 	_size = 0;
@@ -469,6 +507,8 @@ void HashMap<Key, Val, HashFunc, EqualFunc>::expandStorage(size_type newCapacity
 	_storage = new Node *[newCapacity];
 	assert(_storage != nullptr);
 	memset(_storage, 0, newCapacity * sizeof(Node *));
+	_hashes = new size_type[newCapacity];
+	assert(_hashes != nullptr);
 
 	// rehash all the old elements
 	for (size_type ctr = 0; ctr <= old_mask; ++ctr) {
@@ -478,14 +518,15 @@ void HashMap<Key, Val, HashFunc, EqualFunc>::expandStorage(size_type newCapacity
 		// Insert the element from the old table into the new table.
 		// Since we know that no key exists twice in the old table, we
 		// can do this slightly better than by calling lookup, since we
-		// don't have to call _equal().
-		const size_type hash = _hash(old_storage[ctr]->_key);
+		// don't have to call _equal(). The hash of the key is known as well.
+		const size_type hash = old_hashes[ctr];
 		size_type idx = hash & _mask;
 		for (size_type perturb = hash; _storage[idx] != nullptr && _storage[idx] != HASHMAP_DUMMY_NODE; perturb >>= HASHMAP_PERTURB_SHIFT) {
 			idx = (5 * idx + perturb + 1) & _mask;
 		}
 
 		_storage[idx] = old_storage[ctr];
+		_hashes[idx] = hash;
 		_size++;
 	}
 
@@ -494,13 +535,13 @@ void HashMap<Key, Val, HashFunc, EqualFunc>::expandStorage(size_type newCapacity
 	assert(_size == old_size);
 
 	delete[] old_storage;
+	delete[] old_hashes;
 
 	return;
 }
 
 template<class Key, class Val, class HashFunc, class EqualFunc>
-typename HashMap<Key, Val, HashFunc, EqualFunc>::size_type HashMap<Key, Val, HashFunc, EqualFunc>::lookup(const Key &key) const {
-	const size_type hash = _hash(key);
+typename HashMap<Key, Val, HashFunc, EqualFunc>::size_type HashMap<Key, Val, HashFunc, EqualFunc>::lookup(const Key &key, size_type hash) const {
 	size_type ctr = hash & _mask;
 	for (size_type perturb = hash; ; perturb >>= HASHMAP_PERTURB_SHIFT) {
 		if (_storage[ctr] == nullptr)
@@ -509,7 +550,7 @@ typename HashMap<Key, Val, HashFunc, EqualFunc>::size_type HashMap<Key, Val, Has
 #ifdef DEBUG_HASH_COLLISIONS
 			_dummyHits++;
 #endif
-		} else if (_equal(_storage[ctr]->_key, key))
+		} else if (_hashes[ctr] == hash && _equal(_storage[ctr]->_key, key))
 			break;
 
 		ctr = (5 * ctr + perturb + 1) & _mask;
@@ -545,7 +586,7 @@ typename HashMap<Key, Val, HashFunc, EqualFunc>::size_type HashMap<Key, Val, Has
 #endif
 			if (first_free == NONE_FOUND)
 				first_free = ctr;
-		} else if (_equal(_storage[ctr]->_key, key)) {
+		} else if (_hashes[ctr] == hash && _equal(_storage[ctr]->_key, key)) {
 			found = true;
 			break;
 		}
@@ -572,6 +613,7 @@ typename HashMap<Key, Val, HashFunc, EqualFunc>::size_type HashMap<Key, Val, Has
 			_deleted--;
 		_storage[ctr] = allocNode(key);
 		assert(_storage[ctr] != nullptr);
+		_hashes[ctr] = hash;
 		_size++;
 
 		// Keep the load factor below a certain threshold.
@@ -25,8 +25,8 @@
 #ifndef COMMON_HUFFMAN_H
 #define COMMON_HUFFMAN_H
 
+#include "common/algorithm.h"
 #include "common/array.h"
-#include "common/list.h"
 #include "common/types.h"
 
 namespace Common {
@@ -78,12 +78,14 @@ private:
 		uint32 symbol;
 
 		Symbol(uint32 c, uint32 s) : code(c), symbol(s) {}
+
+		bool operator<(const Symbol &other) const { return code < other.code; }
 	};
 
-	typedef List<Symbol> CodeList;
+	typedef Array<Symbol> CodeList;
 	typedef Array<CodeList> CodeLists;
 
-	/** Lists of codes and their symbols, sorted by code length. */
+	/** Lists of codes and their symbols, one per code length, each sorted by code. */
 	CodeLists _codes;
 
 	/** Prefix lookup table used to speed up the decoding of short codes. */
@@ -142,6 +144,10 @@ Huffman<BITSTREAM>::Huffman(uint8 maxLength, uint32 codeCount, const uint32 *cod
 			_codes[lengths[i] - 1 - _prefixTableBits].push_back(Symbol(codes[i], symbol));
 		}
 	}
+
+	// Sort the long codes so that they can be binary searched
+	for (uint i = 0; i < _codes.size(); i++)
+		sort(_codes[i].begin(), _codes[i].end());
 }
 
 template <class BITSTREAM>
@@ -159,9 +165,18 @@ uint32 Huffman<BITSTREAM>::getSymbol(BITSTREAM &bits) const {
 		for (uint32 i = 0; i < _codes.size(); i++) {
 			bits.addBit(code, i + _prefixTableBits);
 
-			for (typename CodeList::const_iterator cCode = _codes[i].begin(); cCode != _codes[i].end(); ++cCode)
-				if (code == cCode->code)
-					return cCode->symbol;
+			const CodeList &list = _codes[i];
+			uint lo = 0, hi = list.size();
+			while (lo < hi) {
+				uint mid = (lo + hi) / 2;
+				if (list[mid].code < code)
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+
+			if (lo < list.size() && list[lo].code == code)
+				return list[lo].symbol;
 		}
 	}
 
@@ -47,6 +47,7 @@
 #include "common/debug.h"
 #include "common/hash-str.h"
 #include "common/installshield_cab.h"
+#include "common/membercache.h"
 #include "common/memstream.h"
 #include "common/substream.h"
 #include "common/ptr.h"
@@ -82,6 +83,7 @@ private:
 	typedef HashMap<String, FileEntry, IgnoreCase_Hash, IgnoreCase_EqualTo> FileMap;
 	FileMap _map;
 	String _baseName;
+	mutable ArchiveMemberCache _cache;
 
 	String getHeaderName() const;
 	String getVolumeName(uint volume) const;
@@ -214,6 +216,7 @@ bool InstallShieldCabinet::open(const String &baseName) {
 void InstallShieldCabinet::close() {
 	_baseName.clear();
 	_map.clear();
+	_cache.clear();
 	_version = 0;
 }
 
@@ -238,6 +241,12 @@ SeekableReadStream *InstallShieldCabinet::createReadStreamForMember(const String
 
 	const FileEntry &entry = _map[name];
 
+	if (entry.flags & 0x04) {
+		SeekableReadStream *cached = _cache.createReadStream(name);
+		if (cached)
+			return cached;
+	}
+
 	ScopedPtr<SeekableReadStream> stream(SearchMan.createReadStreamForMember(getVolumeName((entry.volume == 0) ? 1 : entry.volume)));
 	if (!stream) {
 		warning("Failed to open volume for file '%s'", name.c_str());
@@ -267,7 +276,7 @@ SeekableReadStream *InstallShieldCabinet::createReadStreamForMember(const String
 		return nullptr;
 	}
 
-	return new MemoryReadStream(dst, entry.uncompressedSize, DisposeAfterUse::YES);
+	return _cache.add(name, dst, entry.uncompressedSize);
 #else
 	warning("zlib required to extract compressed CAB file '%s'", name.c_str());
 	return 0;
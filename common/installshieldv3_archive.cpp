@@ -105,6 +105,7 @@ bool InstallShieldV3::open(const Common::String &filename) {
 void InstallShieldV3::close() {
 	delete _stream; _stream = nullptr;
 	_map.clear();
+	_cache.clear();
 }
 
 bool InstallShieldV3::hasFile(const Common::String &name) const {
@@ -126,11 +127,21 @@ Common::SeekableReadStream *InstallShieldV3::createReadStreamForMember(const Com
 	if (!_stream || !_map.contains(name))
 		return nullptr;
 
+	Common::SeekableReadStream *cached = _cache.createReadStream(name);
+	if (cached)
+		return cached;
+
 	const FileEntry &entry = _map[name];
 
 	// Seek to our offset and then send it off to the decompressor
 	_stream->seek(entry.offset);
-	return Common::decompressDCL(_stream, entry.compressedSize, entry.uncompressedSize);
+	byte *data = (byte *)malloc(entry.uncompressedSize);
+	if (!data || !Common::decompressDCL(_stream, data, entry.compressedSize, entry.uncompressedSize)) {
+		free(data);
+		return nullptr;
+	}
+
+	return _cache.add(name, data, entry.uncompressedSize);
 }
 
 } // End of namespace Common
@@ -29,6 +29,7 @@
 #include "common/file.h"
 #include "common/hash-str.h"
 #include "common/hashmap.h"
+#include "common/membercache.h"
 #include "common/str.h"
 
 namespace Common {
@@ -59,6 +60,7 @@ private:
 
 	typedef Common::HashMap<Common::String, FileEntry, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> FileMap;
 	FileMap _map;
+	mutable Common::ArchiveMemberCache _cache;
 };
 
 } // End of namespace Common
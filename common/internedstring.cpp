@@ -0,0 +1,81 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/internedstring.h"
+
+namespace Common {
+
+namespace {
+
+/** The pool of the strings interned by the constructors of InternedString. */
+class GlobalInternedStringPool : public InternedStringPool, public Singleton<GlobalInternedStringPool> {
+};
+
+} // End of anonymous namespace
+
+DECLARE_SINGLETON(GlobalInternedStringPool);
+
+InternedString::InternedString(const String &str) : _entry(InternedStringPool::global().intern(str)._entry) {
+}
+
+InternedString::InternedString(const char *str) : _entry(InternedStringPool::global().intern(String(str))._entry) {
+}
+
+const String &InternedString::toString() const {
+	static const String emptyString;
+	return _entry ? _entry->_str : emptyString;
+}
+
+uint InternedString::hash() const {
+	return _entry ? _entry->_hash : hashit("");
+}
+
+InternedStringPool::~InternedStringPool() {
+	for (EntryMap::iterator i = _entries.begin(); i != _entries.end(); ++i)
+		delete i->_value;
+}
+
+InternedString InternedStringPool::intern(const String &str) {
+	// All the empty strings are the same, whichever pool they come from
+	if (str.empty())
+		return InternedString();
+
+	InternedString::Entry *&entry = _entries.getOrCreateVal(str);
+	if (!entry)
+		entry = new InternedString::Entry(str);
+
+	return InternedString(entry);
+}
+
+InternedString InternedStringPool::find(const String &str) const {
+	EntryMap::const_iterator i = _entries.find(str);
+	if (i == _entries.end())
+		return InternedString();
+
+	return InternedString(i->_value);
+}
+
+InternedStringPool &InternedStringPool::global() {
+	return GlobalInternedStringPool::instance();
+}
+
+} // End of namespace Common
@@ -0,0 +1,143 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_INTERNEDSTRING_H
+#define COMMON_INTERNEDSTRING_H
+
+#include "common/hash-str.h"
+#include "common/singleton.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_internedstring Interned strings
+ * @ingroup common
+ *
+ * @brief API for strings stored once in a pool and compared by identity.
+ *
+ * @{
+ */
+
+class InternedStringPool;
+
+/**
+ * A reference to a string stored in an InternedStringPool.
+ *
+ * All the interned strings with the same contents from the same pool share
+ * the same storage. Comparing two of them only compares pointers, and their
+ * hash is computed once, when the string enters the pool. This makes them
+ * cheap keys for a HashMap, for instance for symbol tables.
+ *
+ * An interned string stays valid as long as its pool exists. The strings of
+ * the global pool stay valid until the end of the program.
+ */
+class InternedString {
+	friend class InternedStringPool;
+
+public:
+	/** Construct an empty string. It does not belong to any pool. */
+	InternedString() : _entry(nullptr) {}
+
+	/** Intern @p str in the global pool. */
+	explicit InternedString(const String &str);
+
+	/** Intern @p str in the global pool. */
+	explicit InternedString(const char *str);
+
+	/** Return the contents of the string. */
+	const String &toString() const;
+
+	const char *c_str() const { return toString().c_str(); }
+	uint size() const { return toString().size(); }
+	bool empty() const { return _entry == nullptr; }
+
+	/** Return the case sensitive hash of the string, as String::hash() does. */
+	uint hash() const;
+
+	bool operator==(const InternedString &x) const { return _entry == x._entry; }
+	bool operator!=(const InternedString &x) const { return _entry != x._entry; }
+
+	/**
+	 * Order the strings by identity. This is fast, but it follows neither
+	 * the order of the contents nor the order of interning.
+	 */
+	bool operator<(const InternedString &x) const { return _entry < x._entry; }
+
+private:
+	struct Entry {
+		String _str;
+		uint _hash;
+
+		Entry(const String &str) : _str(str), _hash(str.hash()) {}
+	};
+
+	explicit InternedString(const Entry *entry) : _entry(entry) {}
+
+	const Entry *_entry;
+};
+
+/**
+ * A set of unique strings, each of which is identified by an InternedString.
+ *
+ * Strings are never removed from a pool. Engines which intern many strings
+ * of their own, such as script symbols, may use a pool of their own, and
+ * release all of its strings at once when they quit. The other users share
+ * the global pool.
+ *
+ * A pool is not thread-safe.
+ */
+class InternedStringPool : NonCopyable {
+public:
+	InternedStringPool() {}
+	~InternedStringPool();
+
+	/** Return the interned string with the contents of @p str, adding it if needed. */
+	InternedString intern(const String &str);
+
+	/** Return the interned string with the contents of @p str, or an empty string if there is none. */
+	InternedString find(const String &str) const;
+
+	/** Return the number of strings in the pool. */
+	uint size() const { return _entries.size(); }
+
+	/** Return the pool used by the constructors of InternedString. */
+	static InternedStringPool &global();
+
+private:
+	typedef HashMap<String, InternedString::Entry *> EntryMap;
+
+	EntryMap _entries;
+};
+
+/** Hash InternedString keys with the hash cached in the pool. */
+template<>
+struct Hash<InternedString> {
+	uint operator()(const InternedString &s) const {
+		return s.hash();
+	}
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
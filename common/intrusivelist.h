@@ -0,0 +1,276 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_INTRUSIVELIST_H
+#define COMMON_INTRUSIVELIST_H
+
+#include "common/scummsys.h"
+#include "common/noncopyable.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_intrusivelist Intrusive lists
+ * @ingroup common
+ *
+ * @brief API for doubly linked lists whose links live in their elements.
+ *
+ * @{
+ */
+
+template<typename T, typename Tag> class IntrusiveList;
+
+/**
+ * The link of an element in an IntrusiveList. Classes put in such a list
+ * derive from it. An object that has to be in several lists at the same time
+ * derives from one link per list, each told apart by a different @p Tag type.
+ *
+ * The link unlinks the object from its list when it is destroyed.
+ */
+template<typename Tag = void>
+class IntrusiveListNode {
+	template<typename T, typename ListTag> friend class IntrusiveList;
+
+public:
+	IntrusiveListNode() : _prev(nullptr), _next(nullptr) {}
+	IntrusiveListNode(const IntrusiveListNode &) : _prev(nullptr), _next(nullptr) {}
+	~IntrusiveListNode() {
+		detach();
+	}
+
+	/** Copying an object does not copy its position in a list. */
+	IntrusiveListNode &operator=(const IntrusiveListNode &) {
+		return *this;
+	}
+
+	/** Check whether the object is in a list. */
+	bool isLinked() const {
+		return _next != nullptr;
+	}
+
+	/** Remove the object from the list it is in, if any. */
+	void detach() {
+		if (!_next)
+			return;
+		_prev->_next = _next;
+		_next->_prev = _prev;
+		_prev = nullptr;
+		_next = nullptr;
+	}
+
+private:
+	IntrusiveListNode *_prev;
+	IntrusiveListNode *_next;
+};
+
+/**
+ * Doubly linked list of objects that hold their own link, with an interface
+ * close to the one of Common::List.
+ *
+ * The list stores pointers to objects owned by the caller: it never allocates
+ * nor frees anything. Inserting or removing an element is done in constant
+ * time, and an element can remove itself without knowing its list. An object
+ * can only be in one list of a given @p Tag at a time.
+ */
+template<typename T, typename Tag = void>
+class IntrusiveList : NonCopyable {
+	typedef IntrusiveListNode<Tag> Node;
+
+	template<typename ValueType>
+	struct IteratorImpl {
+		typedef IteratorImpl<ValueType> Self;
+
+		Node *_node;
+
+		IteratorImpl() : _node(nullptr) {}
+		explicit IteratorImpl(Node *node) : _node(node) {}
+		template<typename OtherType>
+		IteratorImpl(const IteratorImpl<OtherType> &x) : _node(x._node) {}
+
+		Self &operator++() {
+			_node = _node->_next;
+			return *this;
+		}
+		Self operator++(int) {
+			Self tmp(_node);
+			++(*this);
+			return tmp;
+		}
+		Self &operator--() {
+			_node = _node->_prev;
+			return *this;
+		}
+		Self operator--(int) {
+			Self tmp(_node);
+			--(*this);
+			return tmp;
+		}
+		ValueType &operator*() const {
+			return *static_cast<ValueType *>(_node);
+		}
+		ValueType *operator->() const {
+			return static_cast<ValueType *>(_node);
+		}
+
+		template<typename OtherType>
+		bool operator==(const IteratorImpl<OtherType> &x) const {
+			return _node == x._node;
+		}
+		template<typename OtherType>
+		bool operator!=(const IteratorImpl<OtherType> &x) const {
+			return _node != x._node;
+		}
+	};
+
+	Node _anchor; /*!< Sentinel of the list, linked to its first and last element. */
+
+public:
+	typedef IteratorImpl<T>       iterator;       /*!< List iterator. */
+	typedef IteratorImpl<const T> const_iterator; /*!< Const-qualified list iterator. */
+	typedef T                     value_type;     /*!< Value type of the list. */
+	typedef uint                  size_type;      /*!< Size type of the list. */
+
+	IntrusiveList() {
+		_anchor._prev = &_anchor;
+		_anchor._next = &_anchor;
+	}
+
+	/** Unlink all the elements of the list. */
+	~IntrusiveList() {
+		clear();
+		_anchor._prev = nullptr;
+		_anchor._next = nullptr;
+	}
+
+	/** Insert @p element before @p pos. @p element must not be in a list. */
+	void insert(iterator pos, T &element) {
+		Node *node = &element;
+		assert(!node->isLinked());
+		node->_next = pos._node;
+		node->_prev = pos._node->_prev;
+		node->_prev->_next = node;
+		node->_next->_prev = node;
+	}
+
+	/**
+	 * Remove the element at location @p pos from the list and return an
+	 * iterator pointing to the element after it.
+	 */
+	iterator erase(iterator pos) {
+		assert(pos != end());
+		Node *next = pos._node->_next;
+		pos._node->detach();
+		return iterator(next);
+	}
+
+	/** Remove @p element from the list. @p element must be in this list. */
+	void remove(T &element) {
+		static_cast<Node &>(element).detach();
+	}
+
+	/** Insert an @p element at the start of the list. */
+	void push_front(T &element) {
+		insert(begin(), element);
+	}
+
+	/** Append an @p element to the end of the list. */
+	void push_back(T &element) {
+		insert(end(), element);
+	}
+
+	/** Remove the first element of the list. */
+	void pop_front() {
+		assert(!empty());
+		_anchor._next->detach();
+	}
+
+	/** Remove the last element of the list. */
+	void pop_back() {
+		assert(!empty());
+		_anchor._prev->detach();
+	}
+
+	/** Return a reference to the first element of the list. */
+	T &front() {
+		return *static_cast<T *>(_anchor._next);
+	}
+
+	/** Return a reference to the first element of the list. */
+	const T &front() const {
+		return *static_cast<const T *>(_anchor._next);
+	}
+
+	/** Return a reference to the last element of the list. */
+	T &back() {
+		return *static_cast<T *>(_anchor._prev);
+	}
+
+	/** Return a reference to the last element of the list. */
+	const T &back() const {
+		return *static_cast<const T *>(_anchor._prev);
+	}
+
+	/** Return the number of elements in the list. This walks the whole list. */
+	size_type size() const {
+		size_type n = 0;
+		for (const Node *cur = _anchor._next; cur != &_anchor; cur = cur->_next)
+			++n;
+		return n;
+	}
+
+	/** Unlink all the elements of the list. The elements are not destroyed. */
+	void clear() {
+		while (_anchor._next != &_anchor)
+			_anchor._next->detach();
+	}
+
+	/** Check whether the list is empty. */
+	bool empty() const {
+		return _anchor._next == &_anchor;
+	}
+
+	/** Return an iterator to the start of the list. */
+	iterator begin() {
+		return iterator(_anchor._next);
+	}
+
+	/** Return an iterator to the end of the list. */
+	iterator end() {
+		return iterator(&_anchor);
+	}
+
+	/** Return a const iterator to the start of the list. */
+	const_iterator begin() const {
+		return const_iterator(_anchor._next);
+	}
+
+	/** Return a const iterator to the end of the list. */
+	const_iterator end() const {
+		return const_iterator(const_cast<Node *>(&_anchor));
+	}
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
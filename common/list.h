@@ -24,6 +24,7 @@
 #define COMMON_LIST_H
 
 #include "common/list_intern.h"
+#include "common/textconsole.h" // For error()
 
 namespace Common {
 
@@ -40,6 +41,11 @@ namespace Common {
 /**
  * Simple doubly linked list, modeled after the list template of the standard
  * C++ library.
+ *
+ * The list keeps the nodes of the elements it erases, and reuses them for
+ * the next insertions, so that a list with frequent insertions and removals
+ * rarely touches the heap. They are freed along with the list, or by
+ * freeUnusedNodes().
  */
 template<typename t_T>
 class List {
@@ -48,6 +54,7 @@ protected:
 	typedef ListInternal::Node<t_T>		Node;     /*!< An element of the doubly linked list. */
 
 	NodeBase _anchor; /*!< Pointer to the position of the element in the list. */
+	NodeBase *_freeNodes; /*!< Storage of erased nodes kept for reuse, linked through _next. */
 
 public:
 	typedef ListInternal::Iterator<t_T>		iterator; /*!< List iterator. */
@@ -60,11 +67,11 @@ public:
 	/**
 	 * Construct a new empty list.
 	 */
-	List() {
+	List() : _freeNodes(nullptr) {
 		_anchor._prev = &_anchor;
 		_anchor._next = &_anchor;
 	}
-	List(const List<t_T> &list) {  /*!< Construct a new list as a copy of the given @p list. */
+	List(const List<t_T> &list) : _freeNodes(nullptr) {  /*!< Construct a new list as a copy of the given @p list. */
 		_anchor._prev = &_anchor;
 		_anchor._next = &_anchor;
 
@@ -73,6 +80,7 @@ public:
 
 	~List() {
 		clear();
+		freeUnusedNodes();
 	}
 
 	/**
@@ -211,13 +219,22 @@ public:
 		while (pos != &_anchor) {
 			Node *node = static_cast<Node *>(pos);
 			pos = pos->_next;
-			delete node;
+			freeNode(node);
 		}
 
 		_anchor._prev = &_anchor;
 		_anchor._next = &_anchor;
 	}
 
+	/** Free the storage of the nodes kept for reuse after erasing elements. */
+	void freeUnusedNodes() {
+		while (_freeNodes) {
+			NodeBase *next = _freeNodes->_next;
+			::free(_freeNodes);
+			_freeNodes = next;
+		}
+	}
+
 	/** Check whether the list is empty. */
 	bool empty() const {
 		return (&_anchor == _anchor._next);
@@ -266,6 +283,33 @@ public:
 	}
 
 protected:
+	/**
+	 * Create a node holding a copy of @p element, reusing the storage of an
+	 * erased node if there is one.
+	 */
+	Node *allocNode(const t_T &element) {
+		void *storage;
+		if (_freeNodes) {
+			storage = _freeNodes;
+			_freeNodes = _freeNodes->_next;
+		} else {
+			storage = ::malloc(sizeof(Node));
+			if (!storage)
+				::error("Common::List: failure to allocate %u bytes", (uint)sizeof(Node));
+		}
+		return new (storage) Node(element);
+	}
+
+	/**
+	 * Destroy @p node, and keep its storage for reuse.
+	 */
+	void freeNode(Node *node) {
+		node->~Node();
+		NodeBase *storage = new ((void *)node) NodeBase;
+		storage->_next = _freeNodes;
+		_freeNodes = storage;
+	}
+
 	/**
 	 * Erase an element at @p pos.
 	 */
@@ -274,7 +318,7 @@ protected:
 		Node *node = static_cast<Node *>(pos);
 		n._prev->_next = n._next;
 		n._next->_prev = n._prev;
-		delete node;
+		freeNode(node);
 		return n;
 	}
 
@@ -282,8 +326,7 @@ protected:
 	 * Insert an @p element before @p pos.
 	 */
 	void insert(NodeBase *pos, const t_T &element) {
-		ListInternal::NodeBase *newNode = new Node(element);
-		assert(newNode);
+		ListInternal::NodeBase *newNode = allocNode(element);
 
 		newNode->_next = pos;
 		newNode->_prev = pos->_prev;
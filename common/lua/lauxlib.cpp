@@ -23,6 +23,9 @@
 
 #include "lauxlib.h"
 #include "scummvm_file.h"
+#include "common/memorypool.h"
+#include "common/memtrack.h"
+#include "common/system.h"
 #include "common/textconsole.h"
 
 #define FREELIST_REF	0	/* free list of references */
@@ -630,15 +633,93 @@ LUALIB_API int (luaL_loadstring) (lua_State *L, const char *s) {
 /* }====================================================== */
 
 
+/*
+** Scripts create lots of small strings, tables and closures, so blocks
+** of up to POOL_MAXSIZE bytes come from pools of fixed size chunks, one
+** per multiple of POOL_GRANULARITY. Larger blocks use the heap.
+** Lua always passes the old size of a block, which tells which pool it
+** belongs to. The pools of a state are released along with its last
+** block, which is the state itself.
+** With the profiler, the bytes Lua asked for are counted under the
+** memory tag active when the state was created.
+*/
+#define POOL_GRANULARITY	8
+#define POOL_MAXSIZE	128
+#define POOL_COUNT	(POOL_MAXSIZE / POOL_GRANULARITY)
+
+struct LuaPools {
+  Common::MemoryPool *pool[POOL_COUNT];
+  size_t blocks;
+#ifdef ENABLE_PROFILER
+  int memoryTag;
+#endif
+};
+
+#ifdef ENABLE_PROFILER
+#define pool_track(pools, osize, nsize) \
+  { Common::MemoryTracker &tracker = Common::MemoryTracker::instance(); \
+    tracker.freed((pools)->memoryTag, (osize)); \
+    tracker.allocated((pools)->memoryTag, (nsize)); }
+#else
+#define pool_track(pools, osize, nsize) ((void)0)
+#endif
+
+static Common::MemoryPool *getpool (LuaPools *pools, size_t size) {
+  if (size == 0 || size > POOL_MAXSIZE) return NULL;
+  size_t i = (size - 1) / POOL_GRANULARITY;
+  if (!pools->pool[i])
+    pools->pool[i] = new Common::MemoryPool((i + 1) * POOL_GRANULARITY);
+  return pools->pool[i];
+}
+
+static void *pool_alloc (LuaPools *pools, size_t size) {
+  Common::MemoryPool *pool = getpool(pools, size);
+  return pool ? pool->allocChunk() : malloc(size);
+}
+
+static void pool_free (LuaPools *pools, void *ptr, size_t size) {
+  Common::MemoryPool *pool = getpool(pools, size);
+  if (pool) pool->freeChunk(ptr);
+  else free(ptr);
+}
+
 static void *l_alloc (void *ud, void *ptr, size_t osize, size_t nsize) {
-  (void)ud;
-  (void)osize;
+  LuaPools *pools = (LuaPools *)ud;
+  if (ptr == NULL) {
+    if (nsize == 0) return NULL;
+    void *block = pool_alloc(pools, nsize);
+    if (block) {
+      pools->blocks++;
+      pool_track(pools, 0, nsize);
+    }
+    return block;
+  }
   if (nsize == 0) {
-    free(ptr);
+    pool_free(pools, ptr, osize);
+    pool_track(pools, osize, 0);
+    if (--pools->blocks == 0) {  /* the state is gone */
+      for (int i = 0; i < POOL_COUNT; i++)
+        delete pools->pool[i];
+      delete pools;
+    }
     return NULL;
   }
-  else
-    return realloc(ptr, nsize);
+  if (osize > POOL_MAXSIZE && nsize > POOL_MAXSIZE) {
+    void *block = realloc(ptr, nsize);
+    if (block) pool_track(pools, osize, nsize);
+    return block;
+  }
+  if ((osize - 1) / POOL_GRANULARITY == (nsize - 1) / POOL_GRANULARITY) {
+    pool_track(pools, osize, nsize);
+    return ptr;  /* same pool */
+  }
+  void *block = pool_alloc(pools, nsize);
+  if (block) {
+    memcpy(block, ptr, osize < nsize ? osize : nsize);
+    pool_free(pools, ptr, osize);
+    pool_track(pools, osize, nsize);
+  }
+  return block;
 }
 
 
@@ -651,7 +732,37 @@ static int panic (lua_State *L) {
 
 
 LUALIB_API lua_State *luaL_newstate (void) {
-  lua_State *L = lua_newstate(l_alloc, NULL);
+  LuaPools *pools = new LuaPools();
+#ifdef ENABLE_PROFILER
+  pools->memoryTag = Common::MemoryTracker::instance().getCurrentTag("lua");
+#endif
+  lua_State *L = lua_newstate(l_alloc, pools);
+  /* if the state could not be set up, closing it released the pools */
   if (L) lua_atpanic(L, &panic);
   return L;
 }
+
+
+/*
+** Runs one incremental step of the collector, of `budget' kilobytes
+** (see LUA_GCSTEP). Engines call this once per frame, so that the
+** collection work is spread evenly over the frames. Returns whether the
+** step finished a collection cycle. `stats' may be NULL.
+*/
+LUALIB_API int luaL_gcstep (lua_State *L, int budget, luaL_GCStats *stats) {
+  if (stats == NULL)
+    return lua_gc(L, LUA_GCSTEP, budget);
+  unsigned long before = (unsigned long)lua_gc(L, LUA_GCCOUNT, 0) * 1024 +
+                         lua_gc(L, LUA_GCCOUNTB, 0);
+  uint64 start = g_system->getMicros();
+  int finished = lua_gc(L, LUA_GCSTEP, budget);
+  unsigned long micros = (unsigned long)(g_system->getMicros() - start);
+  unsigned long after = (unsigned long)lua_gc(L, LUA_GCCOUNT, 0) * 1024 +
+                        lua_gc(L, LUA_GCCOUNTB, 0);
+  stats->steps++;
+  if (finished) stats->cycles++;
+  stats->totalMicros += micros;
+  if (micros > stats->maxMicros) stats->maxMicros = micros;
+  if (after < before) stats->bytesFreed += before - after;
+  return finished;
+}
@@ -82,6 +82,18 @@ LUALIB_API int (luaL_loadstring) (lua_State *L, const char *s);
 LUALIB_API lua_State *(luaL_newstate) (void);
 
 
+/* statistics of the collector steps run by luaL_gcstep */
+typedef struct luaL_GCStats {
+  unsigned long steps;  /* number of steps */
+  unsigned long cycles;  /* number of collection cycles finished by them */
+  unsigned long totalMicros;  /* time spent in them */
+  unsigned long maxMicros;  /* longest pause caused by one of them */
+  unsigned long bytesFreed;  /* memory released by them */
+} luaL_GCStats;
+
+LUALIB_API int (luaL_gcstep) (lua_State *L, int budget, luaL_GCStats *stats);
+
+
 LUALIB_API const char *(luaL_gsub) (lua_State *L, const char *s, const char *p,
                                                   const char *r);
 
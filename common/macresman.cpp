@@ -27,6 +27,8 @@
 #include "common/fs.h"
 #include "common/macresman.h"
 #include "common/md5.h"
+#include "common/memstream.h"
+#include "common/singleton.h"
 #include "common/substream.h"
 #include "common/textconsole.h"
 #include "common/archive.h"
@@ -45,6 +47,61 @@ namespace Common {
 #define MBI_RFLEN 87
 #define MAXNAMELEN 63
 
+// How many parsed resource maps the shared cache keeps
+#define MAX_CACHED_MAPS 64
+
+/**
+ * The resource maps parsed recently, the most recently used first. Engines
+ * often open the same forks many times, or several copies of the same fork.
+ */
+class MacResMapCache : public Singleton<MacResMapCache> {
+public:
+	MacResMapCache() : _enabled(true) {}
+
+	SharedPtr<MacResManager::ResForkMap> find(const byte *data, uint32 size, uint32 hash) {
+		for (MapList::iterator i = _maps.begin(); i != _maps.end(); ++i) {
+			if ((*i)->hash != hash || (*i)->size != size || memcmp((*i)->data, data, size) != 0)
+				continue;
+
+			SharedPtr<MacResManager::ResForkMap> map = *i;
+			if (i != _maps.begin()) {
+				_maps.erase(i);
+				_maps.push_front(map);
+			}
+			return map;
+		}
+
+		return SharedPtr<MacResManager::ResForkMap>();
+	}
+
+	void add(const SharedPtr<MacResManager::ResForkMap> &map) {
+		if (!_enabled)
+			return;
+
+		_maps.push_front(map);
+		if (_maps.size() > MAX_CACHED_MAPS)
+			_maps.pop_back();
+	}
+
+	void clear() {
+		_maps.clear();
+	}
+
+	void setEnabled(bool enable) {
+		_enabled = enable;
+		if (!enable)
+			clear();
+	}
+
+private:
+	typedef List<SharedPtr<MacResManager::ResForkMap> > MapList;
+
+	MapList _maps;
+	bool _enabled;
+};
+
+DECLARE_SINGLETON(MacResMapCache);
+
 MacResManager::MacResManager() {
 	_stream = nullptr;
 	// _baseFileName cleared by String constructor
@@ -63,6 +120,14 @@ MacResManager::MacResManager() {
 	_resLists = nullptr;
 }
 
+void MacResManager::setMapCacheEnabled(bool enable) {
+	MacResMapCache::instance().setEnabled(enable);
+}
+
+void MacResManager::clearMapCache() {
+	MacResMapCache::instance().clear();
+}
+
 MacResManager::~MacResManager() {
 	close();
 }
@@ -71,18 +136,11 @@ void MacResManager::close() {
 	_resForkOffset = -1;
 	_mode = kResForkNone;
 
-	for (int i = 0; i < _resMap.numTypes; i++) {
-		for (int j = 0; j < _resTypes[i].items; j++)
-			if (_resLists[i][j].nameOffset != -1)
-				delete[] _resLists[i][j].name;
-
-		delete[] _resLists[i];
-	}
-
-	delete[] _resLists; _resLists = nullptr;
-	delete[] _resTypes; _resTypes = nullptr;
+	_map.reset();
+	_resMap.reset();
+	_resTypes = nullptr;
+	_resLists = nullptr;
 	delete _stream; _stream = nullptr;
-	_resMap.numTypes = 0;
 }
 
 bool MacResManager::hasDataFork() const {
@@ -426,19 +484,29 @@ SeekableReadStream *MacResManager::getDataFork() {
 	return nullptr;
 }
 
+MacResManager::Resource *MacResManager::findResource(uint32 typeID, uint16 resID) const {
+	if (!_map)
+		return nullptr;
+
+	HashMap<uint32, uint16>::const_iterator type = _map->typeIndex.find(typeID);
+	if (type == _map->typeIndex.end())
+		return nullptr;
+
+	HashMap<uint32, uint16>::const_iterator res = _map->idIndex.find((type->_value << 16) | resID);
+	if (res == _map->idIndex.end())
+		return nullptr;
+
+	return &_resLists[type->_value][res->_value];
+}
+
 MacResIDArray MacResManager::getResIDArray(uint32 typeID) {
-	int typeNum = -1;
 	MacResIDArray res;
 
-	for (int i = 0; i < _resMap.numTypes; i++)
-		if (_resTypes[i].id == typeID) {
-			typeNum = i;
-			break;
-		}
-
-	if (typeNum == -1)
+	if (!_map || !_map->typeIndex.contains(typeID))
 		return res;
 
+	int typeNum = _map->typeIndex[typeID];
+
 	res.resize(_resTypes[typeNum].items);
 
 	for (int i = 0; i < _resTypes[typeNum].items; i++)
@@ -462,47 +530,37 @@ MacResTagArray MacResManager::getResTagArray() {
 }
 
 String MacResManager::getResName(uint32 typeID, uint16 resID) const {
-	int typeNum = -1;
-
-	for (int i = 0; i < _resMap.numTypes; i++)
-		if (_resTypes[i].id == typeID) {
-			typeNum = i;
-			break;
-		}
-
-	if (typeNum == -1)
+	const Resource *res = findResource(typeID, resID);
+	if (!res)
 		return "";
 
-	for (int i = 0; i < _resTypes[typeNum].items; i++)
-		if (_resLists[typeNum][i].id == resID)
-			return _resLists[typeNum][i].name;
-
-	return "";
+	return res->name;
 }
 
 SeekableReadStream *MacResManager::getResource(uint32 typeID, uint16 resID) {
-	int typeNum = -1;
-	int resNum = -1;
+	const Resource *res = findResource(typeID, resID);
+	if (!res)
+		return nullptr;
 
-	for (int i = 0; i < _resMap.numTypes; i++)
-		if (_resTypes[i].id == typeID) {
-			typeNum = i;
-			break;
-		}
+	_stream->seek(_dataOffset + res->dataOffset);
+	uint32 len = _stream->readUint32BE();
 
-	if (typeNum == -1)
+	// Ignore resources with 0 length
+	if (!len)
 		return nullptr;
 
-	for (int i = 0; i < _resTypes[typeNum].items; i++)
-		if (_resLists[typeNum][i].id == resID) {
-			resNum = i;
-			break;
-		}
+	return _stream->readStream(len);
+}
+
+SeekableReadStream *MacResManager::getResource(const String &fileName) {
+	if (!_map)
+		return nullptr;
 
-	if (resNum == -1)
+	HashMap<String, uint32, IgnoreCase_Hash, IgnoreCase_EqualTo>::const_iterator i = _map->nameIndex.find(fileName);
+	if (i == _map->nameIndex.end())
 		return nullptr;
 
-	_stream->seek(_dataOffset + _resLists[typeNum][resNum].dataOffset);
+	_stream->seek(_dataOffset + _resLists[i->_value >> 16][i->_value & 0xFFFF].dataOffset);
 	uint32 len = _stream->readUint32BE();
 
 	// Ignore resources with 0 length
@@ -512,100 +570,167 @@ SeekableReadStream *MacResManager::getResource(uint32 typeID, uint16 resID) {
 	return _stream->readStream(len);
 }
 
-SeekableReadStream *MacResManager::getResource(const String &fileName) {
-	for (uint32 i = 0; i < _resMap.numTypes; i++) {
-		for (uint32 j = 0; j < _resTypes[i].items; j++) {
-			if (_resLists[i][j].nameOffset != -1 && fileName.equalsIgnoreCase(_resLists[i][j].name)) {
-				_stream->seek(_dataOffset + _resLists[i][j].dataOffset);
-				uint32 len = _stream->readUint32BE();
+SeekableReadStream *MacResManager::getResource(uint32 typeID, const String &fileName) {
+	if (!_map)
+		return nullptr;
 
-				// Ignore resources with 0 length
-				if (!len)
-					return nullptr;
+	HashMap<String, uint32, IgnoreCase_Hash, IgnoreCase_EqualTo>::const_iterator i = _map->typedNameIndex.find(ResForkMap::typedName(typeID, fileName.c_str()));
+	if (i == _map->typedNameIndex.end())
+		return nullptr;
 
-				return _stream->readStream(len);
-			}
-		}
-	}
+	_stream->seek(_dataOffset + _resLists[i->_value >> 16][i->_value & 0xFFFF].dataOffset);
+	uint32 len = _stream->readUint32BE();
 
-	return nullptr;
+	// Ignore resources with 0 length
+	if (!len)
+		return nullptr;
+
+	return _stream->readStream(len);
 }
 
-SeekableReadStream *MacResManager::getResource(uint32 typeID, const String &fileName) {
-	for (uint32 i = 0; i < _resMap.numTypes; i++) {
-		if (_resTypes[i].id != typeID)
-			continue;
+void MacResManager::readMap() {
+	// Read the whole map at once, as parsing it takes many small reads
+	byte *mapData = (byte *)malloc(_mapLength);
+	if (!mapData)
+		return;
+
+	_stream->seek(_mapOffset);
+	if (_stream->read(mapData, _mapLength) != _mapLength) {
+		free(mapData);
+		return;
+	}
 
-		for (uint32 j = 0; j < _resTypes[i].items; j++) {
-			if (_resLists[i][j].nameOffset != -1 && fileName.equalsIgnoreCase(_resLists[i][j].name)) {
-				_stream->seek(_dataOffset + _resLists[i][j].dataOffset);
-				uint32 len = _stream->readUint32BE();
+	// FNV-1a
+	uint32 hash = 2166136261u;
+	for (uint32 i = 0; i < _mapLength; i++)
+		hash = (hash ^ mapData[i]) * 16777619u;
+
+	_map = MacResMapCache::instance().find(mapData, _mapLength, hash);
+	if (_map) {
+		free(mapData);
+	} else {
+		_map = SharedPtr<ResForkMap>(new ResForkMap(mapData, _mapLength, hash));
+		_map->parse();
+		_map->buildIndexes();
+		MacResMapCache::instance().add(_map);
+	}
 
-				// Ignore resources with 0 length
-				if (!len)
-					return nullptr;
+	_resMap = _map->resMap;
+	_resTypes = _map->resTypes;
+	_resLists = _map->resLists;
+}
 
-				return _stream->readStream(len);
-			}
-		}
+MacResManager::ResForkMap::ResForkMap(byte *mapData, uint32 mapSize, uint32 mapHash) :
+	resTypes(nullptr), resLists(nullptr), data(mapData), size(mapSize), hash(mapHash) {
+}
+
+MacResManager::ResForkMap::~ResForkMap() {
+	for (int i = 0; i < resMap.numTypes; i++) {
+		for (int j = 0; j < resTypes[i].items; j++)
+			if (resLists[i][j].nameOffset != -1)
+				delete[] resLists[i][j].name;
+
+		delete[] resLists[i];
 	}
 
-	return nullptr;
+	delete[] resLists;
+	delete[] resTypes;
+	free(data);
 }
 
-void MacResManager::readMap() {
-	_stream->seek(_mapOffset + 22);
+void MacResManager::ResForkMap::parse() {
+	// Offsets are relative to the start of the map
+	MemoryReadStream stream(data, size);
 
-	_resMap.resAttr = _stream->readUint16BE();
-	_resMap.typeOffset = _stream->readUint16BE();
-	_resMap.nameOffset = _stream->readUint16BE();
-	_resMap.numTypes = _stream->readUint16BE();
-	_resMap.numTypes++;
+	stream.seek(22);
 
-	_stream->seek(_mapOffset + _resMap.typeOffset + 2);
-	_resTypes = new ResType[_resMap.numTypes];
+	resMap.resAttr = stream.readUint16BE();
+	resMap.typeOffset = stream.readUint16BE();
+	resMap.nameOffset = stream.readUint16BE();
+	resMap.numTypes = stream.readUint16BE();
+	resMap.numTypes++;
 
-	for (int i = 0; i < _resMap.numTypes; i++) {
-		_resTypes[i].id = _stream->readUint32BE();
-		_resTypes[i].items = _stream->readUint16BE();
-		_resTypes[i].offset = _stream->readUint16BE();
-		_resTypes[i].items++;
+	stream.seek(resMap.typeOffset + 2);
+	resTypes = new ResType[resMap.numTypes];
+
+	for (int i = 0; i < resMap.numTypes; i++) {
+		resTypes[i].id = stream.readUint32BE();
+		resTypes[i].items = stream.readUint16BE();
+		resTypes[i].offset = stream.readUint16BE();
+		resTypes[i].items++;
 
-		debug(8, "resType: <%s> items: %d offset: %d (0x%x)", tag2str(_resTypes[i].id), _resTypes[i].items,  _resTypes[i].offset, _resTypes[i].offset);
+		debug(8, "resType: <%s> items: %d offset: %d (0x%x)", tag2str(resTypes[i].id), resTypes[i].items,  resTypes[i].offset, resTypes[i].offset);
 	}
 
-	_resLists = new ResPtr[_resMap.numTypes];
+	resLists = new ResPtr[resMap.numTypes];
 
-	for (int i = 0; i < _resMap.numTypes; i++) {
-		_resLists[i] = new Resource[_resTypes[i].items];
-		_stream->seek(_resTypes[i].offset + _mapOffset + _resMap.typeOffset);
+	for (int i = 0; i < resMap.numTypes; i++) {
+		resLists[i] = new Resource[resTypes[i].items];
+		stream.seek(resTypes[i].offset + resMap.typeOffset);
 
-		for (int j = 0; j < _resTypes[i].items; j++) {
-			ResPtr resPtr = _resLists[i] + j;
+		for (int j = 0; j < resTypes[i].items; j++) {
+			ResPtr resPtr = resLists[i] + j;
 
-			resPtr->id = _stream->readUint16BE();
-			resPtr->nameOffset = _stream->readUint16BE();
-			resPtr->dataOffset = _stream->readUint32BE();
-			_stream->readUint32BE();
+			resPtr->id = stream.readUint16BE();
+			resPtr->nameOffset = stream.readUint16BE();
+			resPtr->dataOffset = stream.readUint32BE();
+			stream.readUint32BE();
 			resPtr->name = nullptr;
 
 			resPtr->attr = resPtr->dataOffset >> 24;
 			resPtr->dataOffset &= 0xFFFFFF;
 		}
 
-		for (int j = 0; j < _resTypes[i].items; j++) {
-			if (_resLists[i][j].nameOffset != -1) {
-				_stream->seek(_resLists[i][j].nameOffset + _mapOffset + _resMap.nameOffset);
+		for (int j = 0; j < resTypes[i].items; j++) {
+			if (resLists[i][j].nameOffset != -1) {
+				stream.seek(resLists[i][j].nameOffset + resMap.nameOffset);
 
-				byte len = _stream->readByte();
-				_resLists[i][j].name = new char[len + 1];
-				_resLists[i][j].name[len] = 0;
-				_stream->read(_resLists[i][j].name, len);
+				byte len = stream.readByte();
+				resLists[i][j].name = new char[len + 1];
+				resLists[i][j].name[len] = 0;
+				stream.read(resLists[i][j].name, len);
 			}
 		}
 	}
 }
 
+void MacResManager::ResForkMap::buildIndexes() {
+	// Only the first match is indexed, which is the one a linear search finds
+	for (int i = 0; i < resMap.numTypes; i++) {
+		const uint32 typeID = resTypes[i].id;
+		if (typeIndex.contains(typeID))
+			continue;
+		typeIndex[typeID] = i;
+
+		for (int j = 0; j < resTypes[i].items; j++) {
+			const Resource &res = resLists[i][j];
+
+			const uint32 key = (i << 16) | res.id;
+			if (!idIndex.contains(key))
+				idIndex[key] = j;
+		}
+	}
+
+	for (int i = 0; i < resMap.numTypes; i++) {
+		for (int j = 0; j < resTypes[i].items; j++) {
+			const Resource &res = resLists[i][j];
+			if (res.nameOffset == -1)
+				continue;
+
+			if (!nameIndex.contains(res.name))
+				nameIndex[res.name] = (i << 16) | j;
+
+			String key = typedName(resTypes[i].id, res.name);
+			if (!typedNameIndex.contains(key))
+				typedNameIndex[key] = (i << 16) | j;
+		}
+	}
+}
+
+String MacResManager::ResForkMap::typedName(uint32 typeID, const char *name) {
+	return String::format("%08x:%s", typeID, name);
+}
+
 String MacResManager::constructAppleDoubleName(String name) {
 	// Insert "._" before the last portion of a path name
 	for (int i = name.size() - 1; i >= 0; i--) {
@@ -27,6 +27,8 @@
 
 #include "common/array.h"
 #include "common/fs.h"
+#include "common/hash-str.h"
+#include "common/ptr.h"
 #include "common/str.h"
 #include "common/str-array.h"
 
@@ -109,6 +111,18 @@ public:
 	 */
 	void close();
 
+	/**
+	 * Enable or disable the cache of parsed resource maps shared by all the
+	 * managers. When it is enabled, which is the default, opening a fork whose
+	 * resource map is identical to one parsed recently reuses that one.
+	 */
+	static void setMapCacheEnabled(bool enable);
+
+	/**
+	 * Forget all the resource maps kept by the shared cache.
+	 */
+	static void clearMapCache();
+
 	/**
 	 * Query whether or not we have a data fork present.
 	 * @return True if the data fork is present
@@ -208,6 +222,11 @@ public:
 	 */
 	static bool isMacBinary(SeekableReadStream &stream);
 
+	/**
+	 * Return the name of the AppleDouble file holding the resource fork of @p name.
+	 */
+	static String constructAppleDoubleName(String name);
+
 	struct MacVers {
 		byte majorVer;
 		byte minorVer;
@@ -229,7 +248,6 @@ private:
 	bool loadFromRawFork(SeekableReadStream &stream);
 	bool loadFromAppleDouble(SeekableReadStream &stream);
 
-	static String constructAppleDoubleName(String name);
 	static String disassembleAppleDoubleName(String name, bool *isAppleDouble);
 
 	/**
@@ -280,6 +298,37 @@ private:
 
 	typedef Resource *ResPtr;
 
+	/**
+	 * A parsed resource map, with indexes to find its resources quickly. It may
+	 * be shared by several managers opening forks with the same map.
+	 */
+	struct ResForkMap {
+		ResMap resMap;
+		ResType *resTypes;
+		ResPtr *resLists;
+
+		/** The raw map, to recognize identical maps in the shared cache. */
+		byte *data;
+		uint32 size;
+		uint32 hash;
+
+		HashMap<uint32, uint16> typeIndex;        ///< Type ID -> first type with that ID
+		HashMap<uint32, uint16> idIndex;          ///< (type << 16 | resource ID) -> resource
+		HashMap<String, uint32, IgnoreCase_Hash, IgnoreCase_EqualTo> nameIndex;      ///< Name -> (type << 16 | resource)
+		HashMap<String, uint32, IgnoreCase_Hash, IgnoreCase_EqualTo> typedNameIndex; ///< Type ID and name -> (type << 16 | resource)
+
+		ResForkMap(byte *mapData, uint32 mapSize, uint32 mapHash);
+		~ResForkMap();
+
+		void parse();
+		void buildIndexes();
+		static String typedName(uint32 typeID, const char *name);
+	};
+
+	friend class MacResMapCache;
+
+	Resource *findResource(uint32 typeID, uint16 resID) const;
+
 	int32 _resForkOffset;
 	uint32 _resForkSize;
 
@@ -287,6 +336,9 @@ private:
 	uint32 _dataLength;
 	uint32 _mapOffset;
 	uint32 _mapLength;
+	SharedPtr<ResForkMap> _map;
+
+	// The contents of _map, or empty when there is no resource fork
 	ResMap _resMap;
 	ResType *_resTypes;
 	ResPtr  *_resLists;
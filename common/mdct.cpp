@@ -33,6 +33,14 @@
 #include "common/fft.h"
 #include "common/mdct.h"
 
+#if defined(__SSE2__)
+#define USE_MDCT_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define USE_MDCT_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Common {
 
 MDCT::MDCT(int bits, bool inverse, double scale) : _bits(bits), _fft(0) {
@@ -143,8 +151,57 @@ void MDCT::calcHalfIMDCT(float *output, const float *input) {
 
 	_fft->calc(z);
 
+	int k = 0;
+
+#if defined(USE_MDCT_SSE2) || defined(USE_MDCT_NEON)
+	// Post rotation + reordering of two pairs at once. For each element e,
+	// r = e.im * sin - e.re * cos and i = e.im * cos + e.re * sin, and the
+	// elements mirrored around size8 swap their imaginary parts.
+	for (; k + 1 < size8; k += 2) {
+		float *lo = &z[size8 - k - 2].re;
+		float *hi = &z[size8 + k].re;
+
+#if defined(USE_MDCT_SSE2)
+		const __m128 vlo = _mm_loadu_ps(lo);
+		const __m128 vhi = _mm_loadu_ps(hi);
+		const __m128 loSin = _mm_set_ps(_tSin[size8 - k - 1], _tSin[size8 - k - 1], _tSin[size8 - k - 2], _tSin[size8 - k - 2]);
+		const __m128 loCos = _mm_set_ps(_tCos[size8 - k - 1], -_tCos[size8 - k - 1], _tCos[size8 - k - 2], -_tCos[size8 - k - 2]);
+		const __m128 hiSin = _mm_set_ps(_tSin[size8 + k + 1], _tSin[size8 + k + 1], _tSin[size8 + k], _tSin[size8 + k]);
+		const __m128 hiCos = _mm_set_ps(_tCos[size8 + k + 1], -_tCos[size8 + k + 1], _tCos[size8 + k], -_tCos[size8 + k]);
+
+		// (r, i) of each element
+		const __m128 rlo = _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(vlo, vlo, _MM_SHUFFLE(2, 3, 0, 1)), loSin), _mm_mul_ps(vlo, loCos));
+		const __m128 rhi = _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(vhi, vhi, _MM_SHUFFLE(2, 3, 0, 1)), hiSin), _mm_mul_ps(vhi, hiCos));
+
+		// The real parts stay, the imaginary parts come from the mirrored element
+		const __m128 outLo = _mm_shuffle_ps(rlo, rhi, _MM_SHUFFLE(1, 3, 2, 0));
+		const __m128 outHi = _mm_shuffle_ps(rhi, rlo, _MM_SHUFFLE(1, 3, 2, 0));
+		_mm_storeu_ps(lo, _mm_shuffle_ps(outLo, outLo, _MM_SHUFFLE(3, 1, 2, 0)));
+		_mm_storeu_ps(hi, _mm_shuffle_ps(outHi, outHi, _MM_SHUFFLE(3, 1, 2, 0)));
+#else
+		const float32x4_t vlo = vld1q_f32(lo);
+		const float32x4_t vhi = vld1q_f32(hi);
+		const float32x4_t loSin = { _tSin[size8 - k - 2], _tSin[size8 - k - 2], _tSin[size8 - k - 1], _tSin[size8 - k - 1] };
+		const float32x4_t loCos = { -_tCos[size8 - k - 2], _tCos[size8 - k - 2], -_tCos[size8 - k - 1], _tCos[size8 - k - 1] };
+		const float32x4_t hiSin = { _tSin[size8 + k], _tSin[size8 + k], _tSin[size8 + k + 1], _tSin[size8 + k + 1] };
+		const float32x4_t hiCos = { -_tCos[size8 + k], _tCos[size8 + k], -_tCos[size8 + k + 1], _tCos[size8 + k + 1] };
+
+		// (r, i) of each element
+		const float32x4_t rlo = vaddq_f32(vmulq_f32(vrev64q_f32(vlo), loSin), vmulq_f32(vlo, loCos));
+		const float32x4_t rhi = vaddq_f32(vmulq_f32(vrev64q_f32(vhi), hiSin), vmulq_f32(vhi, hiCos));
+
+		// The real parts stay, the imaginary parts come from the mirrored element
+		const uint32x4_t realLanes = { 0xFFFFFFFF, 0, 0xFFFFFFFF, 0 };
+		const float32x4_t rloMirrored = vcombine_f32(vget_high_f32(rlo), vget_low_f32(rlo));
+		const float32x4_t rhiMirrored = vcombine_f32(vget_high_f32(rhi), vget_low_f32(rhi));
+		vst1q_f32(lo, vbslq_f32(realLanes, rlo, rhiMirrored));
+		vst1q_f32(hi, vbslq_f32(realLanes, rhi, rloMirrored));
+#endif
+	}
+#endif
+
 	// Post rotation + reordering
-	for (int k = 0; k < size8; k++) {
+	for (; k < size8; k++) {
 		float r0, i0, r1, i1;
 
 		CMUL(r0, i1, z[size8-k-1].im, z[size8-k-1].re, _tSin[size8-k-1], _tCos[size8-k-1]);
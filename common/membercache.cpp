@@ -0,0 +1,100 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/membercache.h"
+#include "common/memstream.h"
+
+namespace Common {
+
+namespace {
+
+struct FreeDeleter {
+	void operator()(byte *data) {
+		free(data);
+	}
+};
+
+/** A memory stream which holds a reference to the data it reads. */
+class SharedMemoryReadStream : public MemoryReadStream {
+public:
+	SharedMemoryReadStream(const SharedPtr<byte> &data, uint32 size) : MemoryReadStream(data.get(), size), _data(data) {}
+
+private:
+	SharedPtr<byte> _data;
+};
+
+} // End of anonymous namespace
+
+ArchiveMemberCache::ArchiveMemberCache(uint32 maxSize) : _size(0), _maxSize(maxSize) {
+}
+
+SeekableReadStream *ArchiveMemberCache::createReadStream(const String &name) {
+	EntryMap::iterator i = _entries.find(name);
+	if (i == _entries.end())
+		return nullptr;
+
+	// Move the member to the front of the list
+	EntryList::iterator entry = i->_value;
+	if (entry != _lru.begin()) {
+		_lru.push_front(*entry);
+		_lru.erase(entry);
+		i->_value = _lru.begin();
+	}
+
+	return new SharedMemoryReadStream(_lru.front().data, _lru.front().size);
+}
+
+SeekableReadStream *ArchiveMemberCache::add(const String &name, byte *data, uint32 size) {
+	if (size > _maxSize / 4)
+		return new MemoryReadStream(data, size, DisposeAfterUse::YES);
+
+	EntryMap::iterator i = _entries.find(name);
+	if (i != _entries.end()) {
+		_size -= i->_value->size;
+		_lru.erase(i->_value);
+		_entries.erase(i);
+	}
+
+	while (_size + size > _maxSize) {
+		_size -= _lru.back().size;
+		_entries.erase(_lru.back().name);
+		_lru.pop_back();
+	}
+
+	Entry entry;
+	entry.name = name;
+	entry.data = SharedPtr<byte>(data, FreeDeleter());
+	entry.size = size;
+	_lru.push_front(entry);
+	_entries[name] = _lru.begin();
+	_size += size;
+
+	return new SharedMemoryReadStream(entry.data, size);
+}
+
+void ArchiveMemberCache::clear() {
+	_entries.clear();
+	_lru.clear();
+	_size = 0;
+}
+
+} // End of namespace Common
@@ -0,0 +1,105 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_MEMBERCACHE_H
+#define COMMON_MEMBERCACHE_H
+
+#include "common/hash-str.h"
+#include "common/list.h"
+#include "common/ptr.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_membercache Archive member cache
+ * @ingroup common
+ *
+ * @brief API for keeping recently decompressed archive members in memory.
+ *
+ * @{
+ */
+
+class SeekableReadStream;
+
+/**
+ * Cache of the most recently decompressed members of an archive, for the
+ * archive formats whose members have to be decompressed in full each time
+ * they are opened.
+ *
+ * The cache keeps members up to a total size, and evicts the least recently
+ * used ones first. The streams it returns share the cached data, which stays
+ * valid for them after it has been evicted.
+ */
+class ArchiveMemberCache : NonCopyable {
+public:
+	enum {
+		/** The default total size of the cached members. */
+		kDefaultMaxSize = 4 * 1024 * 1024
+	};
+
+	explicit ArchiveMemberCache(uint32 maxSize = kDefaultMaxSize);
+
+	/**
+	 * Return a new stream over the cached contents of the member @p name,
+	 * or nullptr if it is not in the cache.
+	 */
+	SeekableReadStream *createReadStream(const String &name);
+
+	/**
+	 * Cache the contents of the member @p name, and return a new stream over
+	 * them. Members larger than a quarter of the cache are not kept, but
+	 * a stream over them is still returned.
+	 *
+	 * @param name  Name of the member.
+	 * @param data  Contents of the member, allocated with malloc. The cache
+	 *              takes ownership of them.
+	 * @param size  Size of the member.
+	 */
+	SeekableReadStream *add(const String &name, byte *data, uint32 size);
+
+	/** Forget all the cached members. */
+	void clear();
+
+	/** Return the total size of the cached members. */
+	uint32 size() const { return _size; }
+
+private:
+	struct Entry {
+		String name;
+		SharedPtr<byte> data;
+		uint32 size;
+	};
+
+	typedef List<Entry> EntryList;
+	typedef HashMap<String, EntryList::iterator, IgnoreCase_Hash, IgnoreCase_EqualTo> EntryMap;
+
+	EntryList _lru; /*!< The cached members, the most recently used first. */
+	EntryMap _entries;
+	uint32 _size;
+	const uint32 _maxSize;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
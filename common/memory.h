@@ -24,6 +24,7 @@
 #define COMMON_MEMORY_H
 
 #include "common/scummsys.h"
+#include "common/type-traits.h"
 
 namespace Common {
 
@@ -47,6 +48,23 @@ Type *uninitialized_copy(In first, In last, Type *dst) {
 	return dst;
 }
 
+/**
+ * Moves data from the range [first, last) to [dst, dst + (last - first)).
+ * It requires the range [dst, dst + (last - first)) to be valid and
+ * uninitialized. The elements of [first, last) are left in a valid but
+ * unspecified state. Without C++11 the data is copied instead.
+ */
+template<class In, class Type>
+Type *uninitialized_move(In first, In last, Type *dst) {
+	while (first != last)
+#ifdef USE_CXX11
+		new ((void *)dst++) Type(Common::move(*first++));
+#else
+		new ((void *)dst++) Type(*first++);
+#endif
+	return dst;
+}
+
 /**
  * Initializes the memory [first, first + (last - first)) with the value x.
  * It requires the range [first, first + (last - first)) to be valid and
@@ -23,6 +23,11 @@
 #include "common/memorypool.h"
 #include "common/util.h"
 
+#ifndef SCUMMVM_UTIL
+#include "common/mutex.h"
+#include "common/system.h"
+#endif
+
 namespace Common {
 
 enum {
@@ -179,4 +184,112 @@ void MemoryPool::freeUnusedPages() {
 	}
 }
 
+SmallObjectAllocator::SmallObjectAllocator(bool threadSafe) : _threadSafe(threadSafe), _mutex(nullptr) {
+	for (uint i = 0; i < kNumSizeClasses; ++i)
+		_pools[i] = new MemoryPool((i + 1) * kGranularity);
+
+	memset(_stats, 0, sizeof(_stats));
+	for (uint i = 0; i < kNumSizeClasses; ++i)
+		_stats[i].chunkSize = (i + 1) * kGranularity;
+}
+
+SmallObjectAllocator::~SmallObjectAllocator() {
+	for (uint i = 0; i < kNumSizeClasses; ++i)
+		delete _pools[i];
+#ifndef SCUMMVM_UTIL
+	delete _mutex;
+#endif
+}
+
+void *SmallObjectAllocator::allocate(size_t size) {
+	const uint sizeClass = size > kMaxChunkSize ? (uint)kNumSizeClasses : (uint)(MAX<size_t>(size, 1) - 1) / kGranularity;
+
+	void *ptr;
+	const bool locked = lock();
+	if (sizeClass < kNumSizeClasses)
+		ptr = _pools[sizeClass]->allocChunk();
+	else
+		ptr = ::malloc(size);
+
+	Stats &stats = _stats[sizeClass];
+	stats.allocations++;
+	stats.live++;
+	stats.peak = MAX(stats.peak, stats.live);
+	if (locked)
+		unlock();
+
+	if (!ptr)
+		::error("SmallObjectAllocator: failure to allocate %u bytes", (uint)size);
+	return ptr;
+}
+
+void SmallObjectAllocator::deallocate(void *ptr, size_t size) {
+	if (!ptr)
+		return;
+
+	const uint sizeClass = size > kMaxChunkSize ? (uint)kNumSizeClasses : (uint)(MAX<size_t>(size, 1) - 1) / kGranularity;
+
+	const bool locked = lock();
+	if (sizeClass < kNumSizeClasses)
+		_pools[sizeClass]->freeChunk(ptr);
+	else
+		::free(ptr);
+
+	assert(_stats[sizeClass].live > 0);
+	_stats[sizeClass].live--;
+	if (locked)
+		unlock();
+}
+
+void SmallObjectAllocator::freeUnusedPages() {
+	const bool locked = lock();
+	for (uint i = 0; i < kNumSizeClasses; ++i)
+		_pools[i]->freeUnusedPages();
+	if (locked)
+		unlock();
+}
+
+SmallObjectAllocator::Stats SmallObjectAllocator::getStats(uint sizeClass) const {
+	assert(sizeClass <= kNumSizeClasses);
+	return _stats[sizeClass];
+}
+
+static SmallObjectAllocator *g_sharedSmallObjectAllocator = nullptr;
+
+SmallObjectAllocator &SmallObjectAllocator::getShared() {
+	if (!g_sharedSmallObjectAllocator)
+		g_sharedSmallObjectAllocator = new SmallObjectAllocator(true);
+	return *g_sharedSmallObjectAllocator;
+}
+
+void SmallObjectAllocator::releaseSharedMutex() {
+#ifndef SCUMMVM_UTIL
+	if (g_sharedSmallObjectAllocator && g_sharedSmallObjectAllocator->_mutex) {
+		delete g_sharedSmallObjectAllocator->_mutex;
+		g_sharedSmallObjectAllocator->_mutex = nullptr;
+	}
+#endif
+}
+
+bool SmallObjectAllocator::lock() {
+#ifndef SCUMMVM_UTIL
+	// As for the pool of the String class, the Mutex class can only be used
+	// once the backend is initialized. There is only one thread before that.
+	if (!_threadSafe || !g_system || !g_system->backendInitialized())
+		return false;
+	if (!_mutex)
+		_mutex = new Mutex();
+	_mutex->lock();
+	return true;
+#else
+	return false;
+#endif
+}
+
+void SmallObjectAllocator::unlock() {
+#ifndef SCUMMVM_UTIL
+	_mutex->unlock();
+#endif
+}
+
 } // End of namespace Common
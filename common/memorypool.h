@@ -25,10 +25,13 @@
 
 #include "common/scummsys.h"
 #include "common/array.h"
+#include "common/noncopyable.h"
 
 
 namespace Common {
 
+class Mutex;
+
 /**
  * @defgroup common_memory_pool Memory pool
  * @ingroup common_memory
@@ -149,6 +152,91 @@ public:
 	}
 };
 
+/**
+ * An allocator for small objects of any size. It has one memory pool for
+ * each multiple of kGranularity up to kMaxChunkSize, and leaves larger
+ * blocks to malloc().
+ *
+ * The allocator keeps usage statistics for each of its size classes. If it
+ * is created as thread-safe, it serializes all accesses with a mutex once
+ * the backend is initialized, like the pool of the String class does.
+ */
+class SmallObjectAllocator : NonCopyable {
+public:
+	enum {
+		kGranularity = 16,
+		kMaxChunkSize = 256,
+		kNumSizeClasses = kMaxChunkSize / kGranularity
+	};
+
+	struct Stats {
+		size_t chunkSize;   ///< Size of the blocks of the class, 0 for the blocks left to malloc()
+		uint32 allocations; ///< Number of blocks allocated so far
+		uint32 live;        ///< Number of blocks currently in use
+		uint32 peak;        ///< Largest number of blocks in use at the same time
+	};
+
+	explicit SmallObjectAllocator(bool threadSafe = false);
+	~SmallObjectAllocator();
+
+	/**
+	 * Allocate a block of at least @p size bytes, aligned for any object
+	 * of that size.
+	 */
+	void *allocate(size_t size);
+
+	/**
+	 * Return a block to the allocator. @p size must be the size the block
+	 * was allocated with.
+	 */
+	void deallocate(void *ptr, size_t size);
+
+	/** Release the pages of the pools which are not in use anymore. */
+	void freeUnusedPages();
+
+	/**
+	 * Return the statistics of a size class. The classes 0 to
+	 * kNumSizeClasses - 1 are those of the pools, the class
+	 * kNumSizeClasses counts the blocks left to malloc().
+	 */
+	Stats getStats(uint sizeClass) const;
+
+	/**
+	 * The allocator shared by the classes deriving from SmallObject. It is
+	 * thread-safe, and never freed as objects may outlive any owner.
+	 */
+	static SmallObjectAllocator &getShared();
+
+	/** Free the mutex of the shared allocator, while the backend still exists. */
+	static void releaseSharedMutex();
+
+private:
+	/** Lock the mutex if the allocator is thread-safe, and return whether it did. */
+	bool lock();
+	void unlock();
+
+	MemoryPool *_pools[kNumSizeClasses];
+	Stats _stats[kNumSizeClasses + 1];
+	const bool _threadSafe;
+	Mutex *_mutex;
+};
+
+/**
+ * Base class for objects allocated from the shared SmallObjectAllocator.
+ * Deriving a class from it is enough to take its instances, and those of
+ * its subclasses, off the system heap.
+ */
+class SmallObject {
+public:
+	static void *operator new(size_t size) {
+		return SmallObjectAllocator::getShared().allocate(size);
+	}
+
+	static void operator delete(void *ptr, size_t size) {
+		SmallObjectAllocator::getShared().deallocate(ptr, size);
+	}
+};
+
 /** @} */
 
 } // End of namespace Common
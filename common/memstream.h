@@ -71,6 +71,7 @@ public:
 	}
 
 	uint32 read(void *dataPtr, uint32 dataSize);
+	const byte *readInPlace(uint32 dataSize);
 
 	bool eos() const { return _eos; }
 	void clearErr() { _eos = false; }
@@ -97,6 +98,7 @@ public:
 	bool seek(int64 offs, int whence = SEEK_SET) override { return MemoryReadStream::seek(offs, whence); }
 
 	bool skip(uint32 offset) override { return MemoryReadStream::seek(offset, SEEK_CUR); }
+	const byte *readInPlace(uint32 dataSize) override { return MemoryReadStream::readInPlace(dataSize); }
 };
 
 /**
@@ -0,0 +1,111 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/memtrack.h"
+#include "common/algorithm.h"
+
+namespace Common {
+
+DECLARE_SINGLETON(MemoryTracker);
+
+MemoryTracker::MemoryTracker() : _currentTag(kNoTag), _total(0), _peakTotal(0) {
+}
+
+int MemoryTracker::getTag(const char *name) {
+	// The names are string literals, so they are usually the same pointers
+	for (uint i = 0; i < _tags.size(); ++i) {
+		if (_tags[i].name == name)
+			return i;
+	}
+	for (uint i = 0; i < _tags.size(); ++i) {
+		if (!strcmp(_tags[i].name, name))
+			return i;
+	}
+
+	TagStats tag;
+	tag.name = name;
+	tag.current = 0;
+	tag.peak = 0;
+	_tags.push_back(tag);
+	return _tags.size() - 1;
+}
+
+int MemoryTracker::getCurrentTag(const char *defaultName) {
+	if (_currentTag != kNoTag)
+		return _currentTag;
+	return getTag(defaultName);
+}
+
+void MemoryTracker::allocated(int tag, uint64 size) {
+	TagStats &stats = _tags[tag];
+	stats.current += size;
+	stats.peak = MAX(stats.peak, stats.current);
+
+	_total += size;
+	_peakTotal = MAX(_peakTotal, _total);
+}
+
+void MemoryTracker::freed(int tag, uint64 size) {
+	TagStats &stats = _tags[tag];
+	size = MIN(size, stats.current);
+	stats.current -= size;
+	_total -= size;
+}
+
+void MemoryTracker::setUsage(int tag, uint64 size) {
+	const uint64 current = _tags[tag].current;
+	if (size > current)
+		allocated(tag, size - current);
+	else
+		freed(tag, current - size);
+}
+
+namespace {
+struct LargerCurrent {
+	bool operator()(const MemoryTracker::TagStats &a, const MemoryTracker::TagStats &b) const {
+		return a.current > b.current;
+	}
+};
+} // End of anonymous namespace
+
+void MemoryTracker::getStats(Array<TagStats> &stats) const {
+	stats = _tags;
+	sort(stats.begin(), stats.end(), LargerCurrent());
+}
+
+void MemoryTracker::resetPeaks() {
+	for (uint i = 0; i < _tags.size(); ++i)
+		_tags[i].peak = _tags[i].current;
+	_peakTotal = _total;
+}
+
+MemoryTag::MemoryTag(const char *name) {
+	MemoryTracker &tracker = MemoryTracker::instance();
+	_previousTag = tracker._currentTag;
+	tracker._currentTag = tracker.getTag(name);
+}
+
+MemoryTag::~MemoryTag() {
+	MemoryTracker::instance()._currentTag = _previousTag;
+}
+
+} // End of namespace Common
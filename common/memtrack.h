@@ -0,0 +1,141 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_MEMTRACK_H
+#define COMMON_MEMTRACK_H
+
+#include "common/array.h"
+#include "common/noncopyable.h"
+#include "common/singleton.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_memtrack Memory tracker
+ * @ingroup common
+ * @brief Accounting of the memory held by named parts of ScummVM.
+ * @{
+ */
+
+/**
+ * Keeps count of the memory held under named tags, such as "lua" or
+ * "sci resources", with the current and peak amounts of each of them.
+ *
+ * Code owning memory reports it either block by block, with allocated() and
+ * freed(), or as a total it already keeps, with setUsage(). Owners which
+ * allocate for a long time, like a script interpreter, pick their tag when
+ * they are created with getCurrentTag(), so that MEMORY_TAG() scopes decide
+ * where their memory is counted.
+ *
+ * The "mem" debugger command and the performance HUD show the totals.
+ * Code uses the MEMORY_TAG() and MEMORY_USAGE() macros, or checks for
+ * ENABLE_PROFILER, so that the accounting is compiled out unless ScummVM
+ * is configured with --enable-profiler.
+ * The tracker is not thread-safe. Only memory of the main thread should be
+ * reported.
+ */
+class MemoryTracker : public Singleton<MemoryTracker> {
+public:
+	enum {
+		/** The tag of memory reported outside of any MEMORY_TAG() scope. */
+		kNoTag = -1
+	};
+
+	struct TagStats {
+		const char *name;
+		/** The number of bytes held now. */
+		uint64 current;
+		/** The largest number of bytes held since the last resetPeaks(). */
+		uint64 peak;
+	};
+
+	MemoryTracker();
+
+	/**
+	 * Return the tag named @p name, adding it if needed.
+	 * @param name   The name of the tag. It must stay valid, as a string literal does.
+	 */
+	int getTag(const char *name);
+
+	/**
+	 * Return the tag of the innermost MEMORY_TAG() scope, or the tag named
+	 * @p defaultName outside of any scope.
+	 */
+	int getCurrentTag(const char *defaultName);
+
+	/** Count @p size more bytes as held under @p tag. */
+	void allocated(int tag, uint64 size);
+
+	/** Count @p size less bytes as held under @p tag. */
+	void freed(int tag, uint64 size);
+
+	/** Set the number of bytes held under @p tag. */
+	void setUsage(int tag, uint64 size);
+
+	/** Get the tags, largest current amount first. */
+	void getStats(Array<TagStats> &stats) const;
+
+	/** Return the total number of bytes held under all the tags. */
+	uint64 getTotal() const { return _total; }
+
+	/** Return the largest total since the last resetPeaks(). */
+	uint64 getPeakTotal() const { return _peakTotal; }
+
+	/** Make the current amounts the peak ones. */
+	void resetPeaks();
+
+private:
+	friend class MemoryTag;
+
+	Array<TagStats> _tags;
+	int _currentTag;
+	uint64 _total;
+	uint64 _peakTotal;
+};
+
+/** A tag scope, from its construction to its destruction. Use MEMORY_TAG() rather than this. */
+class MemoryTag : NonCopyable {
+public:
+	explicit MemoryTag(const char *name);
+	~MemoryTag();
+
+private:
+	int _previousTag;
+};
+
+#ifdef ENABLE_PROFILER
+#define MEMORY_TAG_CONCAT2(a, b) a##b
+#define MEMORY_TAG_CONCAT(a, b) MEMORY_TAG_CONCAT2(a, b)
+/** Count the memory of the owners created until the end of the enclosing block under the tag @p name. */
+#define MEMORY_TAG(name) ::Common::MemoryTag MEMORY_TAG_CONCAT(memoryTag, __LINE__)(name)
+/** Set the number of bytes held under the tag @p name. */
+#define MEMORY_USAGE(name, size) ::Common::MemoryTracker::instance().setUsage(::Common::MemoryTracker::instance().getTag(name), (size))
+#else
+#define MEMORY_TAG(name) do {} while (0)
+#define MEMORY_USAGE(name, size) do {} while (0)
+#endif
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
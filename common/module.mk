@@ -11,6 +11,7 @@ MODULE_OBJS := \
 	error.o \
 	events.o \
 	file.o \
+	framearena.o \
 	fs.o \
 	gui_options.o \
 	hashmap.o \
@@ -18,6 +19,7 @@ MODULE_OBJS := \
 	ini-file.o \
 	installshield_cab.o \
 	installshieldv3_archive.o \
+	internedstring.o \
 	json.o \
 	language.o \
 	localization.o \
@@ -25,12 +27,16 @@ MODULE_OBJS := \
 	memorypool.o \
 	md5.o \
 	mdct.o \
+	membercache.o \
+	memtrack.o \
 	mutex.o \
 	osd_message_queue.o \
 	platform.o \
+	profiler.o \
 	quicktime.o \
 	random.o \
 	rational.o \
+	readaheadstream.o \
 	rendermode.o \
 	sinewindows.o \
 	str.o \
@@ -41,7 +47,9 @@ MODULE_OBJS := \
 	stuffit.o \
 	system.o \
 	textconsole.o \
+	threadpool.o \
 	tokenizer.o \
+	trace.o \
 	translation.o \
 	unarj.o \
 	unicode-bidi.o \
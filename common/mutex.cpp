@@ -20,15 +20,121 @@
  *
  */
 
+#include "common/algorithm.h"
 #include "common/debug.h"
 #include "common/mutex.h"
 #include "common/system.h"
 
 namespace Common {
 
-Mutex::Mutex() {
+#ifdef ENABLE_PROFILER
+
+namespace {
+
+// The statistics of every mutex ever created. They are kept after the
+// mutex is destroyed, so that they can be reported at exit.
+Array<MutexStats *> *g_mutexStats = nullptr;
+OSystem::MutexRef g_mutexStatsMutex = nullptr;
+
+MutexStats *createMutexStats(const char *name) {
+	MutexStats *stats = new MutexStats();
+	stats->name = name ? name : "unnamed";
+	stats->acquisitions = 0;
+	stats->contended = 0;
+	stats->waitMicros = 0;
+	stats->maxHoldMicros = 0;
+	stats->depth = 0;
+	stats->lockedAt = 0;
+	stats->held = false;
+
+	// The first mutexes are created by the main thread at startup
+	if (!g_mutexStatsMutex) {
+		g_mutexStatsMutex = g_system->createMutex();
+		g_mutexStats = new Array<MutexStats *>();
+	}
+
+	g_system->lockMutex(g_mutexStatsMutex);
+	g_mutexStats->push_back(stats);
+	g_system->unlockMutex(g_mutexStatsMutex);
+	return stats;
+}
+
+void lockWithStats(OSystem::MutexRef mutex, MutexStats *stats) {
+	const bool wasHeld = stats->held;
+	const uint64 start = g_system->getMicros();
+	g_system->lockMutex(mutex);
+	const uint64 now = g_system->getMicros();
+
+	stats->acquisitions++;
+	if (wasHeld && now > start) {
+		stats->contended++;
+		stats->waitMicros += now - start;
+	}
+	if (stats->depth++ == 0) {
+		stats->lockedAt = now;
+		stats->held = true;
+	}
+}
+
+void unlockWithStats(OSystem::MutexRef mutex, MutexStats *stats) {
+	if (--stats->depth == 0) {
+		stats->maxHoldMicros = MAX(stats->maxHoldMicros, g_system->getMicros() - stats->lockedAt);
+		stats->held = false;
+	}
+	g_system->unlockMutex(mutex);
+}
+
+struct MoreContended {
+	bool operator()(const MutexStats &a, const MutexStats &b) const {
+		if (a.waitMicros != b.waitMicros)
+			return a.waitMicros > b.waitMicros;
+		return a.contended > b.contended;
+	}
+};
+
+} // End of anonymous namespace
+
+void getMutexStats(Array<MutexStats> &stats) {
+	stats.clear();
+	if (!g_mutexStatsMutex)
+		return;
+
+	g_system->lockMutex(g_mutexStatsMutex);
+	for (uint i = 0; i < g_mutexStats->size(); ++i) {
+		const MutexStats &mutexStats = *(*g_mutexStats)[i];
+
+		uint j = 0;
+		while (j < stats.size() && strcmp(stats[j].name, mutexStats.name))
+			++j;
+		if (j == stats.size()) {
+			stats.push_back(mutexStats);
+			continue;
+		}
+
+		stats[j].acquisitions += mutexStats.acquisitions;
+		stats[j].contended += mutexStats.contended;
+		stats[j].waitMicros += mutexStats.waitMicros;
+		stats[j].maxHoldMicros = MAX(stats[j].maxHoldMicros, mutexStats.maxHoldMicros);
+	}
+	g_system->unlockMutex(g_mutexStatsMutex);
+
+	sort(stats.begin(), stats.end(), MoreContended());
+}
+
+#else
+
+void getMutexStats(Array<MutexStats> &stats) {
+	stats.clear();
+}
+
+#endif
+
+Mutex::Mutex(const char *name) : _stats(nullptr) {
 	assert(g_system);
 	_mutex = g_system->createMutex();
+#ifdef ENABLE_PROFILER
+	_stats = createMutexStats(name);
+#endif
 }
 
 Mutex::~Mutex() {
@@ -36,11 +142,19 @@ Mutex::~Mutex() {
 }
 
 void Mutex::lock() {
+#ifdef ENABLE_PROFILER
+	lockWithStats(_mutex, _stats);
+#else
 	g_system->lockMutex(_mutex);
+#endif
 }
 
 void Mutex::unlock() {
+#ifdef ENABLE_PROFILER
+	unlockWithStats(_mutex, _stats);
+#else
 	g_system->unlockMutex(_mutex);
+#endif
 }
 
 
@@ -48,12 +162,12 @@ void Mutex::unlock() {
 
 
 StackLock::StackLock(OSystem::MutexRef mutex, const char *mutexName)
-	: _mutex(mutex), _mutexName(mutexName) {
+	: _mutex(mutex), _mutexName(mutexName), _stats(nullptr) {
 	lock();
 }
 
 StackLock::StackLock(const Mutex &mutex, const char *mutexName)
-	: _mutex(mutex._mutex), _mutexName(mutexName) {
+	: _mutex(mutex._mutex), _mutexName(mutexName), _stats(mutex._stats) {
 	lock();
 }
 
@@ -65,6 +179,12 @@ void StackLock::lock() {
 	if (_mutexName != nullptr)
 		debug(6, "Locking mutex %s", _mutexName);
 
+#ifdef ENABLE_PROFILER
+	if (_stats) {
+		lockWithStats(_mutex, _stats);
+		return;
+	}
+#endif
 	g_system->lockMutex(_mutex);
 }
 
@@ -72,6 +192,12 @@ void StackLock::unlock() {
 	if (_mutexName != nullptr)
 		debug(6, "Unlocking mutex %s", _mutexName);
 
+#ifdef ENABLE_PROFILER
+	if (_stats) {
+		unlockWithStats(_mutex, _stats);
+		return;
+	}
+#endif
 	g_system->unlockMutex(_mutex);
 }
 
@@ -24,6 +24,7 @@
 #define COMMON_MUTEX_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
 #include "common/system.h"
 
 namespace Common {
@@ -37,6 +38,7 @@ namespace Common {
  */
 
 class Mutex;
+struct MutexStats;
 
 /**
  * Auxillary class to (un)lock a mutex on the stack.
@@ -44,6 +46,7 @@ class Mutex;
 class StackLock {
 	OSystem::MutexRef _mutex;
 	const char *_mutexName;
+	MutexStats *_stats;
 
 	void lock();
 	void unlock();
@@ -61,15 +64,56 @@ class Mutex {
 	friend class StackLock;
 
 	OSystem::MutexRef _mutex;
+	MutexStats *_stats;
 
 public:
-	Mutex();
+	/**
+	 * @param name  The name of the mutex in the contention statistics. It
+	 *              must stay valid, as a string literal does. Mutexes without
+	 *              a name are counted as "unnamed".
+	 */
+	explicit Mutex(const char *name = nullptr);
 	~Mutex();
 
 	void lock();
 	void unlock();
 };
 
+/**
+ * Contention statistics of the mutexes sharing a name.
+ *
+ * They are only gathered when ScummVM is configured with --enable-profiler,
+ * for the Mutex objects, whether locked directly or through a StackLock.
+ * An acquisition counts as contended when the mutex was held when lock()
+ * was called and taking it did not succeed at once. Locking a mutex again
+ * from the thread holding it is not contended, but may be counted as such
+ * if the backend clock is coarse.
+ */
+struct MutexStats {
+	const char *name;
+	/** The number of times the mutex was taken, recursive locking included. */
+	uint64 acquisitions;
+	/** The number of acquisitions which had to wait for another thread. */
+	uint64 contended;
+	/** The total time spent waiting for the mutex, in microseconds. */
+	uint64 waitMicros;
+	/** The longest time the mutex was held, in microseconds. */
+	uint64 maxHoldMicros;
+
+	// Book-keeping of the mutex itself, protected by it
+	uint depth;
+	uint64 lockedAt;
+	bool held;
+};
+
+/**
+ * Get the contention statistics of all the mutexes created so far, merged
+ * by name, the most contended first. They are empty unless ScummVM is
+ * configured with --enable-profiler. The statistics of mutexes in use are
+ * read while other threads may update them, and can be slightly off.
+ */
+void getMutexStats(Array<MutexStats> &stats);
+
 /** @} */
 
 } // End of namespace Common
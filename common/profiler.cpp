@@ -0,0 +1,181 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#include "common/profiler.h"
+#include "common/algorithm.h"
+#include "common/system.h"
+
+namespace Common {
+
+DECLARE_SINGLETON(Profiler);
+
+Profiler::Profiler() : _root(nullptr), _current(nullptr), _frames(0) {
+	reset();
+}
+
+Profiler::~Profiler() {
+	for (uint i = 0; i < _zones.size(); ++i)
+		delete _zones[i];
+}
+
+void Profiler::reset() {
+	for (uint i = 0; i < _zones.size(); ++i)
+		delete _zones[i];
+	_zones.clear();
+
+	_root = new Zone();
+	_root->name = "";
+	_root->parent = nullptr;
+	_zones.push_back(_root);
+	_current = _root;
+	_frames = 0;
+}
+
+Profiler::Zone *Profiler::findChild(Zone *parent, const char *name) {
+	// The names are string literals, so they are usually the same pointers
+	for (uint i = 0; i < parent->children.size(); ++i) {
+		if (parent->children[i]->name == name)
+			return parent->children[i];
+	}
+	for (uint i = 0; i < parent->children.size(); ++i) {
+		if (!strcmp(parent->children[i]->name, name))
+			return parent->children[i];
+	}
+
+	Zone *zone = new Zone();
+	zone->name = name;
+	zone->parent = parent;
+	zone->micros = 0;
+	zone->calls = 0;
+	memset(zone->frameMicros, 0, sizeof(zone->frameMicros));
+	memset(zone->frameCalls, 0, sizeof(zone->frameCalls));
+	parent->children.push_back(zone);
+	_zones.push_back(zone);
+	return zone;
+}
+
+void Profiler::enterZone(const char *name) {
+	_current = findChild(_current, name);
+}
+
+void Profiler::leaveZone(uint32 micros) {
+	// Ignore the zones left after a reset
+	if (_current == _root)
+		return;
+
+	_current->micros += micros;
+	_current->calls++;
+	_current = _current->parent;
+}
+
+void Profiler::endFrame() {
+	const uint slot = _frames % kMaxFrames;
+	for (uint i = 0; i < _zones.size(); ++i) {
+		Zone *zone = _zones[i];
+		zone->frameMicros[slot] = zone->micros;
+		zone->frameCalls[slot] = zone->calls;
+		zone->micros = 0;
+		zone->calls = 0;
+	}
+	_frames++;
+}
+
+uint Profiler::getFrameCount() const {
+	return MIN<uint32>(_frames, kMaxFrames);
+}
+
+void Profiler::sumFrames(const Zone *zone, uint frames, uint64 &micros, uint32 &calls) const {
+	micros = 0;
+	calls = 0;
+	for (uint i = 0; i < frames; ++i) {
+		const uint slot = (_frames - 1 - i) % kMaxFrames;
+		micros += zone->frameMicros[slot];
+		calls += zone->frameCalls[slot];
+	}
+}
+
+namespace {
+
+struct ZoneTotal {
+	uint index;
+	uint64 micros;
+	uint32 calls;
+
+	bool operator<(const ZoneTotal &other) const {
+		return micros > other.micros;
+	}
+};
+
+} // End of anonymous namespace
+
+void Profiler::addStats(const Zone *zone, uint depth, uint frames, Array<ZoneStats> &stats) const {
+	Array<ZoneTotal> totals;
+	for (uint i = 0; i < zone->children.size(); ++i) {
+		ZoneTotal total;
+		total.index = i;
+		sumFrames(zone->children[i], frames, total.micros, total.calls);
+		if (total.calls)
+			totals.push_back(total);
+	}
+	Common::sort(totals.begin(), totals.end());
+
+	for (uint i = 0; i < totals.size(); ++i) {
+		const Zone *child = zone->children[totals[i].index];
+
+		ZoneStats zoneStats;
+		zoneStats.name = child->name;
+		zoneStats.depth = depth;
+		zoneStats.totalMicros = totals[i].micros;
+		zoneStats.selfMicros = totals[i].micros;
+		zoneStats.calls = totals[i].calls;
+
+		const uint index = stats.size();
+		stats.push_back(zoneStats);
+		addStats(child, depth + 1, frames, stats);
+
+		// Take the time of the direct children out of the parent
+		for (uint j = index + 1; j < stats.size(); ++j) {
+			if (stats[j].depth != depth + 1)
+				continue;
+			stats[index].selfMicros -= MIN(stats[index].selfMicros, stats[j].totalMicros);
+		}
+	}
+}
+
+void Profiler::getStats(uint frames, Array<ZoneStats> &stats) const {
+	stats.clear();
+	frames = MIN(frames, getFrameCount());
+	if (frames)
+		addStats(_root, 0, frames, stats);
+}
+
+ProfileZone::ProfileZone(const char *name) {
+	Profiler::instance().enterZone(name);
+	_start = g_system->getMicros();
+}
+
+ProfileZone::~ProfileZone() {
+	Profiler::instance().leaveZone((uint32)(g_system->getMicros() - _start));
+}
+
+} // End of namespace Common
@@ -0,0 +1,161 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#ifndef COMMON_PROFILER_H
+#define COMMON_PROFILER_H
+
+#include "common/array.h"
+#include "common/noncopyable.h"
+#include "common/singleton.h"
+#include "common/str.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_profiler Profiler
+ * @ingroup common
+ *
+ * @brief Timing of named zones of the engines, aggregated per frame.
+ *
+ * @{
+ */
+
+/**
+ * Collects the time spent in named zones, for the last frames.
+ *
+ * Zones nest: a zone entered while another one is active is its child, and
+ * the same name may appear under several parents. Engines mark the end of
+ * each frame with PROFILE_FRAME(), and the "profile" debugger command shows
+ * the zones of the last frames.
+ *
+ * Engines use the PROFILE_ZONE() and PROFILE_FRAME() macros, which are
+ * compiled out unless ScummVM is configured with --enable-profiler.
+ *
+ * The profiler is not thread-safe. Only the main thread should be profiled.
+ */
+class Profiler : public Singleton<Profiler> {
+public:
+	enum {
+		/** The number of frames for which the zone times are kept. */
+		kMaxFrames = 256
+	};
+
+	/** The total time of a zone over several frames. */
+	struct ZoneStats {
+		const char *name;
+		/** The nesting depth of the zone, 0 for the zones entered first. */
+		uint depth;
+		/** The time spent in the zone, including its children, in microseconds. */
+		uint64 totalMicros;
+		/** The time spent in the zone itself, in microseconds. */
+		uint64 selfMicros;
+		/** The number of times the zone was entered. */
+		uint32 calls;
+	};
+
+	Profiler();
+	~Profiler();
+
+	/**
+	 * Enter the zone @p name, as a child of the active zone.
+	 * @param name   The name of the zone. It must stay valid, as a string literal does.
+	 */
+	void enterZone(const char *name);
+
+	/**
+	 * Leave the active zone.
+	 * @param micros  The time spent in the zone, in microseconds.
+	 */
+	void leaveZone(uint32 micros);
+
+	/** End the current frame. */
+	void endFrame();
+
+	/** Return the number of frames for which the zone times are known. */
+	uint getFrameCount() const;
+
+	/**
+	 * Get the time spent in the zones over the last @p frames frames,
+	 * depth first. The children of a zone follow it, the slowest first.
+	 * The zones which were not entered during those frames are skipped.
+	 */
+	void getStats(uint frames, Array<ZoneStats> &stats) const;
+
+	/** Forget all the zones and frames. */
+	void reset();
+
+private:
+	struct Zone {
+		const char *name;
+		Zone *parent;
+		Array<Zone *> children;
+
+		uint32 micros;
+		uint32 calls;
+		uint32 frameMicros[kMaxFrames];
+		uint32 frameCalls[kMaxFrames];
+	};
+
+	Zone *findChild(Zone *parent, const char *name);
+	void addStats(const Zone *zone, uint depth, uint frames, Array<ZoneStats> &stats) const;
+	void sumFrames(const Zone *zone, uint frames, uint64 &micros, uint32 &calls) const;
+
+	/** The root of the zones, which is never entered. */
+	Zone *_root;
+	/** The innermost active zone. */
+	Zone *_current;
+	/** All the zones, for endFrame(). */
+	Array<Zone *> _zones;
+	/** The number of frames ended since the last reset. */
+	uint32 _frames;
+};
+
+/** A zone, from its construction to its destruction. Use PROFILE_ZONE() rather than this. */
+class ProfileZone : NonCopyable {
+public:
+	explicit ProfileZone(const char *name);
+	~ProfileZone();
+
+private:
+	uint64 _start;
+};
+
+#ifdef ENABLE_PROFILER
+#define PROFILE_ZONE_CONCAT2(a, b) a##b
+#define PROFILE_ZONE_CONCAT(a, b) PROFILE_ZONE_CONCAT2(a, b)
+
+/** Profile the rest of the enclosing block as the zone @p name, which must stay valid. */
+#define PROFILE_ZONE(name) ::Common::ProfileZone PROFILE_ZONE_CONCAT(profileZone, __LINE__)(name)
+
+/** Mark the end of a frame of the engine. */
+#define PROFILE_FRAME() ::Common::Profiler::instance().endFrame()
+#else
+#define PROFILE_ZONE(name) do {} while (0)
+#define PROFILE_FRAME() do {} while (0)
+#endif
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
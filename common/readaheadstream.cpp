@@ -0,0 +1,394 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/bufferedstream.h"
+#include "common/mutex.h"
+#include "common/ptr.h"
+#include "common/list.h"
+#include "common/singleton.h"
+#include "common/spscqueue.h"
+#include "common/system.h"
+#include "common/threadpool.h"
+#include "common/util.h"
+
+namespace Common {
+
+/**
+ * Reads a stream ahead of time into a ring of buffers. The buffers are
+ * filled by the read-ahead thread, and by read() when that thread fell
+ * behind. As long as the stream is read sequentially, read() only copies
+ * data out of the buffers.
+ */
+class ReadAheadStream : public SeekableReadStream {
+public:
+	/**
+	 * The wrapped stream is only seekable if 'seekable' is set, which then
+	 * is the same stream as 'stream'.
+	 */
+	ReadAheadStream(ReadStream *stream, SeekableReadStream *seekable, uint32 bufSize, uint32 bufCount, DisposeAfterUse::Flag disposeParentStream);
+	~ReadAheadStream();
+
+	uint32 read(void *dataPtr, uint32 dataSize) override;
+	bool eos() const override { return _eos; }
+	bool err() const override;
+	void clearErr() override;
+
+	int64 pos() const override { return _pos; }
+	int64 size() const override { return _size; }
+	bool seek(int64 offset, int whence = SEEK_SET) override;
+
+	/**
+	 * Read from the wrapped stream until 'count' buffers are filled, as far
+	 * as there are free buffers. Called by the read-ahead thread, and by
+	 * read() when the read-ahead thread fell behind.
+	 */
+	void fill(uint32 count);
+
+	/** Fill all the buffers, unless the stream is not read sequentially. */
+	void readAhead();
+
+private:
+	/** Seek to 'offset' without dropping the buffers, if it is in them. */
+	bool seekBuffered(int64 offset);
+
+	DisposablePtr<ReadStream> _parentStream;
+	SeekableReadStream *_seekable;
+	/** Size of the wrapped stream, queried once not to disturb the read-ahead thread. */
+	const int64 _size;
+
+	/** Serialises fill(), seek() and err(), i.e. everything accessing _parentStream. */
+	mutable Mutex _parentMutex;
+
+	const uint32 _bufSize;
+	/** The number of buffers minus one. The number of buffers is a power of two. */
+	uint32 _bufMask;
+	byte *_buf;
+	/** How many bytes each buffer holds. */
+	uint32 *_bufLength;
+
+	/** Free running count of filled buffers, only changed by fill() and seek(). */
+	volatile uint32 _head;
+	/** Free running count of consumed buffers, only changed by read() and seek(). */
+	volatile uint32 _tail;
+	/** Whether everything left in the wrapped stream has been read into the buffers. */
+	volatile uint32 _endOfStream;
+	/**
+	 * Whether the stream is read sequentially. The read-ahead thread pauses
+	 * after a seek out of the buffered data, until a whole buffer is read.
+	 */
+	volatile uint32 _sequential;
+
+	/** How far the first filled buffer has been read. */
+	uint32 _bufPos;
+	int64 _pos;
+	bool _eos;
+};
+
+/**
+ * Runs fill() for all read-ahead streams on a worker thread of its own.
+ * The streams start a job on that thread whenever read() used up one of
+ * their buffers and none is running, so the buffers are refilled as soon
+ * as they are free.
+ *
+ * Without worker threads, nothing is read ahead, and the streams are read
+ * by read() only.
+ */
+class ReadAheadScheduler : public Singleton<ReadAheadScheduler> {
+public:
+	void add(ReadAheadStream *stream);
+	void remove(ReadAheadStream *stream);
+
+	/** Start a read-ahead job, unless one is queued or running. */
+	void wakeUp();
+
+private:
+	friend class Singleton<SingletonBaseType>;
+	ReadAheadScheduler() : _pool(nullptr), _jobRunning(0) {}
+
+	static void jobProc(void *refCon);
+	void readAll();
+
+	/** Serialises add() and remove(), and with it creating the pool. */
+	Mutex _registryMutex;
+	/** Protects _streams, held by the read-ahead job while reading. */
+	Mutex _streamsMutex;
+
+	List<ReadAheadStream *> _streams;
+	/** The pool providing the worker thread, while there are streams and it has one. */
+	ThreadPool *_pool;
+	/** Whether a read-ahead job is queued or running. */
+	volatile uint32 _jobRunning;
+};
+
+#pragma mark -
+
+ReadAheadStream::ReadAheadStream(ReadStream *stream, SeekableReadStream *seekable, uint32 bufSize, uint32 bufCount, DisposeAfterUse::Flag disposeParentStream)
+	: _parentStream(stream, disposeParentStream), _seekable(seekable),
+	  _size(seekable ? seekable->size() : 0), _bufSize(bufSize),
+	  _head(0), _tail(0), _endOfStream(0), _sequential(1),
+	  _bufPos(0), _pos(seekable ? seekable->pos() : 0), _eos(false) {
+
+	assert(bufSize > 0);
+
+	uint32 count = 1;
+	while (count < bufCount)
+		count <<= 1;
+	_bufMask = count - 1;
+
+	_buf = new byte[(size_t)count * bufSize];
+	_bufLength = new uint32[count];
+
+	ReadAheadScheduler::instance().add(this);
+}
+
+ReadAheadStream::~ReadAheadStream() {
+	ReadAheadScheduler::instance().remove(this);
+	delete[] _buf;
+	delete[] _bufLength;
+}
+
+void ReadAheadStream::fill(uint32 count) {
+	StackLock lock(_parentMutex);
+
+	count = MIN(count, _bufMask + 1);
+	uint32 head = _head;
+
+	while (head - loadAcquire(_tail) < count && !_endOfStream) {
+		const uint32 index = head & _bufMask;
+		const uint32 len = _parentStream->read(_buf + index * _bufSize, _bufSize);
+
+		if (len > 0) {
+			_bufLength[index] = len;
+			++head;
+			// Publish the buffer before possibly flagging the end of the stream
+			storeRelease(_head, head);
+		}
+
+		if (len < _bufSize)
+			storeRelease(_endOfStream, (uint32)1);
+	}
+}
+
+void ReadAheadStream::readAhead() {
+	if (loadAcquire(_sequential))
+		fill(_bufMask + 1);
+}
+
+uint32 ReadAheadStream::read(void *dataPtr, uint32 dataSize) {
+	byte *dst = (byte *)dataPtr;
+	uint32 total = 0;
+
+	while (total < dataSize) {
+		const uint32 tail = _tail;
+		if (tail == loadAcquire(_head)) {
+			if (loadAcquire(_endOfStream)) {
+				_eos = true;
+				break;
+			}
+
+			// The read-ahead thread fell behind, so read the next buffer right here
+			fill(1);
+			continue;
+		}
+
+		const uint32 index = tail & _bufMask;
+		const uint32 len = MIN(dataSize - total, _bufLength[index] - _bufPos);
+		memcpy(dst + total, _buf + index * _bufSize + _bufPos, len);
+		total += len;
+		_bufPos += len;
+
+		if (_bufPos == _bufLength[index]) {
+			_bufPos = 0;
+			storeRelease(_tail, tail + 1);
+			storeRelease(_sequential, (uint32)1);
+
+			// Refill the buffer just used up
+			if (!loadAcquire(_endOfStream))
+				ReadAheadScheduler::instance().wakeUp();
+		}
+	}
+
+	_pos += total;
+	return total;
+}
+
+bool ReadAheadStream::err() const {
+	StackLock lock(_parentMutex);
+	return _parentStream->err();
+}
+
+void ReadAheadStream::clearErr() {
+	StackLock lock(_parentMutex);
+	_parentStream->clearErr();
+	_eos = false;
+}
+
+bool ReadAheadStream::seek(int64 offset, int whence) {
+	if (!_seekable)
+		return false;
+
+	switch (whence) {
+	case SEEK_END:
+		offset = _size + offset;
+		break;
+	case SEEK_CUR:
+		offset = _pos + offset;
+		break;
+	case SEEK_SET:
+	default:
+		break;
+	}
+
+	_eos = false;
+
+	if (offset >= 0 && offset <= _size && seekBuffered(offset))
+		return true;
+
+	StackLock lock(_parentMutex);
+
+	const bool result = _seekable->seek(offset);
+
+	// Drop everything read so far
+	storeRelease(_tail, (uint32)0);
+	storeRelease(_head, (uint32)0);
+	storeRelease(_endOfStream, (uint32)0);
+	storeRelease(_sequential, (uint32)0);
+	_bufPos = 0;
+	_pos = _seekable->pos();
+
+	return result;
+}
+
+bool ReadAheadStream::seekBuffered(int64 offset) {
+	if (offset == _pos)
+		return true;
+
+	// Stay in the buffered data when possible, like BufferedSeekableReadStream does
+	if (offset < _pos && _pos - offset <= _bufPos) {
+		_bufPos -= _pos - offset;
+		_pos = offset;
+		return true;
+	}
+
+	while (offset > _pos) {
+		const uint32 tail = _tail;
+		if (tail == loadAcquire(_head))
+			break;
+
+		const uint32 index = tail & _bufMask;
+		const uint32 left = _bufLength[index] - _bufPos;
+		if (offset - _pos < left) {
+			_bufPos += offset - _pos;
+			_pos = offset;
+			return true;
+		}
+
+		_bufPos = 0;
+		_pos += left;
+		storeRelease(_tail, tail + 1);
+	}
+
+	return offset == _pos;
+}
+
+#pragma mark -
+
+void ReadAheadScheduler::add(ReadAheadStream *stream) {
+	StackLock registryLock(_registryMutex);
+
+	{
+		StackLock lock(_streamsMutex);
+		_streams.push_back(stream);
+	}
+
+	if (!_pool) {
+		// One worker thread, and the calling thread which is not used
+		_pool = g_system->createThreadPool(2);
+		if (_pool->getThreadCount() < 2) {
+			delete _pool;
+			_pool = nullptr;
+		}
+	}
+
+	wakeUp();
+}
+
+void ReadAheadScheduler::remove(ReadAheadStream *stream) {
+	StackLock registryLock(_registryMutex);
+
+	bool empty;
+	{
+		StackLock lock(_streamsMutex);
+		_streams.remove(stream);
+		empty = _streams.empty();
+	}
+
+	if (!empty || !_pool)
+		return;
+
+	// This waits for a running job to finish, which needs _streamsMutex,
+	// so this must not be held here.
+	delete _pool;
+	_pool = nullptr;
+	storeRelease(_jobRunning, (uint32)0);
+}
+
+void ReadAheadScheduler::wakeUp() {
+	// Only streams call this, so the pool is not deleted meanwhile
+	if (!_pool || loadAcquire(_jobRunning))
+		return;
+
+	storeRelease(_jobRunning, (uint32)1);
+	if (!_pool->startBackgroundJob(&jobProc, this))
+		storeRelease(_jobRunning, (uint32)0);
+}
+
+void ReadAheadScheduler::jobProc(void *refCon) {
+	ReadAheadScheduler *scheduler = (ReadAheadScheduler *)refCon;
+	scheduler->readAll();
+	storeRelease(scheduler->_jobRunning, (uint32)0);
+}
+
+void ReadAheadScheduler::readAll() {
+	StackLock lock(_streamsMutex);
+
+	for (List<ReadAheadStream *>::iterator it = _streams.begin(); it != _streams.end(); ++it)
+		(*it)->readAhead();
+}
+
+DECLARE_SINGLETON(ReadAheadScheduler);
+
+#pragma mark -
+
+ReadStream *wrapReadAheadReadStream(ReadStream *parentStream, uint32 bufSize, uint32 bufCount, DisposeAfterUse::Flag disposeParentStream) {
+	if (parentStream)
+		return new ReadAheadStream(parentStream, nullptr, bufSize, bufCount, disposeParentStream);
+	return nullptr;
+}
+
+SeekableReadStream *wrapReadAheadSeekableReadStream(SeekableReadStream *parentStream, uint32 bufSize, uint32 bufCount, DisposeAfterUse::Flag disposeParentStream) {
+	if (parentStream)
+		return new ReadAheadStream(parentStream, parentStream, bufSize, bufCount, disposeParentStream);
+	return nullptr;
+}
+
+} // End of namespace Common
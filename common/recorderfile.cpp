@@ -47,6 +47,7 @@ PlaybackFile::PlaybackFile()
 	_headerDumped = false;
 	_recordCount = 0;
 	_eventsSize = 0;
+	_screenshotMismatches = 0;
 	memset(_tmpBuffer.data(), 1, kRecordBuffSize);
 
 	_playbackParseState = kFileStateCheckFormat;
@@ -73,6 +74,7 @@ bool PlaybackFile::openRead(const String &fileName) {
 	close();
 	_header.fileName = fileName;
 	_eventsSize = 0;
+	_screenshotMismatches = 0;
 	_tmpPlaybackFile.seek(0);
 	_readStream = wrapBufferedSeekableReadStream(g_system->getSavefileManager()->openForLoading(fileName), 128 * 1024, DisposeAfterUse::YES);
 	if (_readStream == NULL) {
@@ -329,6 +331,8 @@ bool PlaybackFile::hasNextEvent() const {
 RecorderEvent PlaybackFile::getNextEvent() {
 	if (!hasNextEvent()) {
 		debug(3, "end of recorder file reached.");
+		if (!g_eventRec.finishBenchmark())
+			g_system->fatalError();
 		g_system->quit();
 	}
 
@@ -785,6 +789,7 @@ void PlaybackFile::checkRecordedMD5() {
 	if (memcmp(savedMD5, currentMD5, 16) != 0) {
 		debugC(1, kDebugLevelEventRec, "playback:action=\"Check screenshot\" time=%s result = fail", screenTime.c_str());
 		warning("Recorded and current screenshots are different");
+		_screenshotMismatches++;
 	} else {
 		debugC(1, kDebugLevelEventRec, "playback:action=\"Check screenshot\" time=%s result = success", screenTime.c_str());
 	}
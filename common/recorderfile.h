@@ -155,6 +155,10 @@ public:
 
 	bool isEventsBufferEmpty();
 	PlaybackFileHeader &getHeader() {return _header;}
+
+	/** Return the number of the screenshots which differed from the recorded ones. */
+	uint getScreenshotMismatches() const { return _screenshotMismatches; }
+
 	void updateHeader();
 	void addSaveFile(const String &fileName, InSaveFile *saveStream);
 private:
@@ -170,6 +174,7 @@ private:
 	bool _headerDumped;
 	int _recordCount;
 	uint32 _eventsSize;
+	uint _screenshotMismatches;
 	PlaybackFileHeader _header;
 	PlaybackFileState _playbackParseState;
 
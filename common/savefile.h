@@ -256,6 +256,40 @@ public:
 	 * for saving or loading because they are being synced by CloudManager.
 	 */
 	virtual void updateSavefilesList(StringArray &lockedFiles) = 0;
+
+	/**
+	 * Prototype of the procedures called when a save file was written.
+	 *
+	 * @param name     Name of the save file.
+	 * @param success  Whether the save file was written without errors.
+	 * @param refCon   Value passed when the procedure was registered.
+	 */
+	typedef void (*WriteCallback)(const String &name, bool success, void *refCon);
+
+	/**
+	 * Wait for the save files which are still being written in the
+	 * background, if any, to be on disk.
+	 *
+	 * Save file managers which write synchronously have nothing to wait for.
+	 *
+	 * @return True if all the pending save files were written, false otherwise.
+	 */
+	virtual bool flushPendingWrites() { return true; }
+
+	/**
+	 * Register a procedure to be notified when a save file written in the
+	 * background is on disk, or failed to be written.
+	 *
+	 * The procedure may be called from the thread of the writer. It should
+	 * be short and must not call the save file manager back.
+	 *
+	 * Save file managers which write synchronously report their errors
+	 * through OutSaveFile::err() and never call these procedures.
+	 */
+	virtual void addWriteCallback(WriteCallback proc, void *refCon) {}
+
+	/** Unregister a procedure registered with addWriteCallback(). */
+	virtual void removeWriteCallback(WriteCallback proc, void *refCon) {}
 };
 
 /** @} */
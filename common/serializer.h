@@ -25,6 +25,8 @@
 
 #include "common/stream.h"
 #include "common/str.h"
+#include "common/type-traits.h"
+#include "common/util.h"
 
 namespace Common {
 
@@ -53,6 +55,31 @@ namespace Common {
 		_bytesSynced += SIZE; \
 	}
 
+// Sync an array in chunks, so that the stream is only called once per chunk
+#define SYNC_ARRAY_AS(SUFFIX,TYPE,SIZE,READ,WRITE) \
+	template<typename T> \
+	void syncArrayAs ## SUFFIX(T *arr, size_t entries, Version minVersion = 0, Version maxVersion = kLastVersion) { \
+		if (_version < minVersion || _version > maxVersion) \
+			return; \
+		byte buf[256]; \
+		while (entries > 0) { \
+			const size_t count = MIN<size_t>(entries, sizeof(buf) / SIZE); \
+			if (_loadStream) { \
+				const uint32 bytesRead = _loadStream->read(buf, count * SIZE); \
+				memset(buf + bytesRead, 0, count * SIZE - bytesRead); \
+				for (size_t i = 0; i < count; ++i) \
+					arr[i] = static_cast<T>(static_cast<TYPE>(READ(buf + i * SIZE))); \
+			} else { \
+				for (size_t i = 0; i < count; ++i) \
+					WRITE(buf + i * SIZE, static_cast<TYPE>(arr[i])); \
+				_saveStream->write(buf, count * SIZE); \
+			} \
+			arr += count; \
+			entries -= count; \
+			_bytesSynced += count * SIZE; \
+		} \
+	}
+
 #define SYNC_PRIMITIVE(suffix) \
 	template <typename T> \
 	static inline void suffix(Serializer &s, T &value) { \
@@ -140,6 +167,23 @@ public:
 	SYNC_AS(DoubleLE, double, 4)
 	SYNC_AS(DoubleBE, double, 4)
 
+	/**
+	 * Sync arrays of integers with the same format as syncing each entry
+	 * with the matching syncAs method, but much faster for large arrays.
+	 */
+	SYNC_ARRAY_AS(Byte, byte, 1, readByteAt, writeByteAt)
+	SYNC_ARRAY_AS(SByte, int8, 1, readByteAt, writeByteAt)
+
+	SYNC_ARRAY_AS(Uint16LE, uint16, 2, READ_LE_UINT16, WRITE_LE_UINT16)
+	SYNC_ARRAY_AS(Uint16BE, uint16, 2, READ_BE_UINT16, WRITE_BE_UINT16)
+	SYNC_ARRAY_AS(Sint16LE, int16, 2, READ_LE_UINT16, WRITE_LE_UINT16)
+	SYNC_ARRAY_AS(Sint16BE, int16, 2, READ_BE_UINT16, WRITE_BE_UINT16)
+
+	SYNC_ARRAY_AS(Uint32LE, uint32, 4, READ_LE_UINT32, WRITE_LE_UINT32)
+	SYNC_ARRAY_AS(Uint32BE, uint32, 4, READ_BE_UINT32, WRITE_BE_UINT32)
+	SYNC_ARRAY_AS(Sint32LE, int32, 4, READ_LE_UINT32, WRITE_LE_UINT32)
+	SYNC_ARRAY_AS(Sint32BE, int32, 4, READ_BE_UINT32, WRITE_BE_UINT32)
+
 	/**
 	 * Returns true if an I/O failure occurred.
 	 * This flag is never cleared automatically. In order to clear it,
@@ -295,18 +339,67 @@ public:
 		}
 	}
 
+	/**
+	 * Sync an array with a function syncing each entry. The arrays of
+	 * integers synced with the primitive functions above, such as
+	 * Serializer::Uint16LE, are synced in bulk.
+	 */
 	template <typename T>
 	void syncArray(T *arr, size_t entries, void (*serializer)(Serializer &, T &), Version minVersion = 0, Version maxVersion = kLastVersion) {
 		if (_version < minVersion || _version > maxVersion)
 			return;
 
+		typedef typename Conditional<IsIntegral<T>::value, IntegerArray, OtherArray>::type ArrayKind;
+		if (syncArrayInBulk(arr, entries, serializer, ArrayKind()))
+			return;
+
 		for (size_t i = 0; i < entries; ++i) {
 			serializer(*this, arr[i]);
 		}
 	}
+
+private:
+	struct IntegerArray {};
+	struct OtherArray {};
+
+	template <typename T>
+	bool syncArrayInBulk(T *arr, size_t entries, void (*serializer)(Serializer &, T &), IntegerArray) {
+		if (serializer == &Byte<T>)
+			syncArrayAsByte(arr, entries);
+		else if (serializer == &SByte<T>)
+			syncArrayAsSByte(arr, entries);
+		else if (serializer == &Uint16LE<T>)
+			syncArrayAsUint16LE(arr, entries);
+		else if (serializer == &Uint16BE<T>)
+			syncArrayAsUint16BE(arr, entries);
+		else if (serializer == &Sint16LE<T>)
+			syncArrayAsSint16LE(arr, entries);
+		else if (serializer == &Sint16BE<T>)
+			syncArrayAsSint16BE(arr, entries);
+		else if (serializer == &Uint32LE<T>)
+			syncArrayAsUint32LE(arr, entries);
+		else if (serializer == &Uint32BE<T>)
+			syncArrayAsUint32BE(arr, entries);
+		else if (serializer == &Sint32LE<T>)
+			syncArrayAsSint32LE(arr, entries);
+		else if (serializer == &Sint32BE<T>)
+			syncArrayAsSint32BE(arr, entries);
+		else
+			return false;
+		return true;
+	}
+
+	template <typename T>
+	bool syncArrayInBulk(T *arr, size_t entries, void (*serializer)(Serializer &, T &), OtherArray) {
+		return false;
+	}
+
+	static inline byte readByteAt(const byte *ptr) { return *ptr; }
+	static inline void writeByteAt(byte *ptr, byte value) { *ptr = value; }
 };
 
 #undef SYNC_PRIMITIVE
+#undef SYNC_ARRAY_AS
 #undef SYNC_AS
 
 
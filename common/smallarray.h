@@ -0,0 +1,95 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_SMALLARRAY_H
+#define COMMON_SMALLARRAY_H
+
+#include "common/array.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_smallarray Small arrays
+ * @ingroup common
+ *
+ * @brief  Arrays which keep their first elements inline.
+ * @{
+ */
+
+/**
+ * A dynamically sized container with the same interface as Common::Array,
+ * which stores up to @p N elements inside the object itself. It only
+ * allocates memory on the heap once it holds more elements than that.
+ *
+ * This suits arrays that usually hold a handful of elements, such as the
+ * vertices of a polygon or the arguments of a script call. Code can switch
+ * an Array to a SmallArray by changing a typedef. Both share the
+ * implementation in ArrayBase.
+ *
+ * Unlike with Array, moving or swapping a SmallArray whose elements are
+ * stored inline moves the elements one by one, and invalidates the
+ * pointers to them.
+ */
+template<class T, uint N>
+class SmallArray : public ArrayBase<T, N> {
+public:
+	typedef typename ArrayBase<T, N>::size_type size_type; /*!< Size type of the array. */
+
+	SmallArray() {}
+
+	/**
+	 * Construct an array with @p count default-inserted instances of @p T. No
+	 * copies are made.
+	 */
+	explicit SmallArray(size_type count) : ArrayBase<T, N>(count) {}
+
+	/**
+	 * Construct an array with @p count copies of elements with value @p value.
+	 */
+	SmallArray(size_type count, const T &value) : ArrayBase<T, N>(count, value) {}
+
+#ifdef USE_CXX11
+	/**
+	 * Construct an array using list initialization.
+	 * @note
+	 * This constructor is only available when C++11 support is enabled.
+	 */
+	SmallArray(std::initializer_list<T> list) : ArrayBase<T, N>(list) {}
+#endif
+
+	/**
+	 * Construct an array by copying data from a regular array.
+	 */
+	template<class T2>
+	SmallArray(const T2 *array, size_type n) : ArrayBase<T, N>(array, n) {}
+
+	/** Check whether the elements are stored inside the array object. */
+	bool isInline() const {
+		return this->_storage == this->inlineStorage();
+	}
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
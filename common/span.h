@@ -1021,6 +1021,24 @@ public:
 	inline reference operator[](const index_type index) { return _span[index]; }
 };
 
+/**
+ * Obtain a span over the next @p numBytes bytes of @p stream.
+ *
+ * When the stream keeps its data in memory, the span points directly into it,
+ * and @p buffer is left empty. Otherwise, the data is read into @p buffer,
+ * which then owns it. In both cases, the span may be shorter than requested
+ * if the stream ends early.
+ */
+inline Span<const byte> readSpan(SeekableReadStream &stream, uint32 numBytes, SpanOwner<Span<byte> > &buffer) {
+	const byte *data = stream.readInPlace(numBytes);
+	if (data)
+		return Span<const byte>(data, numBytes);
+
+	buffer->allocate(numBytes);
+	const uint32 bytesRead = stream.read(buffer->data(), numBytes);
+	return Span<const byte>(buffer->data(), bytesRead);
+}
+
 } // End of namespace Common
 
 #endif
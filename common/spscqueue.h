@@ -0,0 +1,190 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_SPSCQUEUE_H
+#define COMMON_SPSCQUEUE_H
+
+#include "common/scummsys.h"
+#include "common/noncopyable.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Common {
+
+/**
+ * @defgroup common_spscqueue Lock-free queue
+ * @ingroup common
+ *
+ * @brief Lock-free queue for passing data between exactly two threads.
+ * @{
+ */
+
+/**
+ * Load a value shared with another thread, with acquire semantics: no
+ * memory access following the load can be moved before it.
+ */
+template<typename T>
+inline T loadAcquire(const volatile T &value) {
+#if defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7))
+	return __atomic_load_n(&value, __ATOMIC_ACQUIRE);
+#elif defined(__GNUC__)
+	T tmp = value;
+	__sync_synchronize();
+	return tmp;
+#elif defined(_MSC_VER)
+	// Volatile accesses have acquire/release semantics on MSVC by default
+	T tmp = value;
+	_ReadWriteBarrier();
+	return tmp;
+#else
+	return value;
+#endif
+}
+
+/**
+ * Store a value shared with another thread, with release semantics: no
+ * memory access preceding the store can be moved after it.
+ */
+template<typename T>
+inline void storeRelease(volatile T &dst, T value) {
+#if defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7))
+	__atomic_store_n(&dst, value, __ATOMIC_RELEASE);
+#elif defined(__GNUC__)
+	__sync_synchronize();
+	dst = value;
+#elif defined(_MSC_VER)
+	_ReadWriteBarrier();
+	dst = value;
+#else
+	dst = value;
+#endif
+}
+
+/**
+ * Replace a pointer shared with other threads by @p newValue if it still
+ * is @p oldValue, as a single atomic operation with full barrier semantics.
+ *
+ * @return Whether the pointer was replaced.
+ */
+template<typename T>
+inline bool compareAndSwapPointer(T *volatile &value, T *oldValue, T *newValue) {
+#if defined(__GNUC__)
+	return __sync_bool_compare_and_swap(&value, oldValue, newValue);
+#elif defined(_MSC_VER)
+	return _InterlockedCompareExchangePointer((void *volatile *)&value, newValue, oldValue) == oldValue;
+#else
+	// Like the other helpers, this is not atomic with other compilers
+	if (value != oldValue)
+		return false;
+	value = newValue;
+	return true;
+#endif
+}
+
+/**
+ * Fixed size, lock-free FIFO queue for one producer and one consumer
+ * thread.
+ *
+ * Only one thread at a time may call push(), and only one thread at a time
+ * may call pop(). If either side is shared by several threads, these need
+ * to serialise their access, e.g. with a Mutex that the other side never
+ * takes.
+ *
+ * @tparam T         The type of the elements. They are copied in and out.
+ * @tparam CAPACITY  The maximal number of queued elements, this must be a
+ *                   power of two.
+ */
+template<class T, uint CAPACITY>
+class SPSCQueue : NonCopyable {
+public:
+	SPSCQueue() : _items(), _head(0), _tail(0) {
+		STATIC_ASSERT((CAPACITY & (CAPACITY - 1)) == 0, SPSCQueue_capacity_must_be_a_power_of_two);
+	}
+
+	/**
+	 * Append an element to the queue. Must only be called by the producer.
+	 *
+	 * @return false if the queue is full.
+	 */
+	bool push(const T &item) {
+		const uint tail = _tail;
+		if (tail - loadAcquire(_head) == CAPACITY)
+			return false;
+
+		_items[tail & (CAPACITY - 1)] = item;
+		storeRelease(_tail, tail + 1);
+		return true;
+	}
+
+	/**
+	 * Remove the oldest element from the queue. Must only be called by the
+	 * consumer.
+	 *
+	 * @return false if the queue is empty.
+	 */
+	bool pop(T &item) {
+		const uint head = _head;
+		if (head == loadAcquire(_tail))
+			return false;
+
+		item = _items[head & (CAPACITY - 1)];
+		storeRelease(_head, head + 1);
+		return true;
+	}
+
+	/**
+	 * Return whether the queue is empty. When called by the producer, the
+	 * result can be outdated as soon as it is returned.
+	 */
+	bool empty() const {
+		return loadAcquire(_head) == loadAcquire(_tail);
+	}
+
+	/**
+	 * Return the number of queued elements. When called from any other than
+	 * the producer and consumer thread, this is an approximation.
+	 */
+	uint size() const {
+		return loadAcquire(_tail) - loadAcquire(_head);
+	}
+
+	/** Return the maximal number of queued elements. */
+	uint capacity() const {
+		return CAPACITY;
+	}
+
+private:
+	T _items[CAPACITY];
+
+	/** Read position, only written by the consumer. */
+	volatile uint _head;
+	/** Write position, only written by the producer. */
+	volatile uint _tail;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -81,6 +81,11 @@ public:
 	/** Construct a copy of the given string. */
 	String(const String &str) : BaseString<char>(str) {};
 
+#ifdef USE_CXX11
+	/** Construct a string by taking over the storage of @p str, which is left empty. */
+	String(String &&str) : BaseString<char>(static_cast<BaseString<char> &&>(str)) {}
+#endif
+
 	/** Construct a string consisting of the given character. */
 	explicit String(char c);
 
@@ -89,6 +94,9 @@ public:
 
 	String &operator=(const char *str);
 	String &operator=(const String &str);
+#ifdef USE_CXX11
+	String &operator=(String &&str);
+#endif
 	String &operator=(char c);
 	String &operator+=(const char *str);
 	String &operator+=(const String &str);
@@ -108,6 +108,17 @@ uint32 MemoryReadStream::read(void *dataPtr, uint32 dataSize) {
 	return dataSize;
 }
 
+const byte *MemoryReadStream::readInPlace(uint32 dataSize) {
+	if (dataSize > _size - _pos)
+		return nullptr;
+
+	const byte *data = _ptr;
+	_ptr += dataSize;
+	_pos += dataSize;
+
+	return data;
+}
+
 bool MemoryReadStream::seek(int64 offs, int whence) {
 	// Pre-Condition
 	assert(_pos <= _size);
@@ -271,6 +282,17 @@ bool SeekableSubReadStream::seek(int64 offset, int whence) {
 	return ret;
 }
 
+const byte *SeekableSubReadStream::readInPlace(uint32 dataSize) {
+	if (dataSize > _end - _pos)
+		return nullptr;
+
+	const byte *data = _parentStream->readInPlace(dataSize);
+	if (data)
+		_pos += dataSize;
+
+	return data;
+}
+
 uint32 SafeSeekableSubReadStream::read(void *dataPtr, uint32 dataSize) {
 	// Make sure the parent stream is at the right position
 	seek(0, SEEK_CUR);
@@ -278,6 +300,13 @@ uint32 SafeSeekableSubReadStream::read(void *dataPtr, uint32 dataSize) {
 	return SeekableSubReadStream::read(dataPtr, dataSize);
 }
 
+const byte *SafeSeekableSubReadStream::readInPlace(uint32 dataSize) {
+	// Make sure the parent stream is at the right position
+	seek(0, SEEK_CUR);
+
+	return SeekableSubReadStream::readInPlace(dataSize);
+}
+
 void SeekableReadStream::hexdump(int len, int bytesPerLine, int startOffset) {
 	uint pos_ = pos();
 	uint size_ = size();
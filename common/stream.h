@@ -712,6 +712,18 @@ public:
 	 */
 	virtual bool skip(uint32 offset) { return seek(offset, SEEK_CUR); }
 
+	/**
+	 * Obtain direct access to the next @p dataSize bytes of the stream, and
+	 * skip them, if the stream keeps its data in memory.
+	 *
+	 * The returned data stays valid as long as the stream exists. Streams
+	 * which do not keep their data in memory, or which have fewer than
+	 * @p dataSize bytes left, return nullptr and do not move.
+	 *
+	 * @see Common::readSpan() to fall back to copying the data.
+	 */
+	virtual const byte *readInPlace(uint32 dataSize) { return nullptr; }
+
 	/**
 	 * Read at most one less than the number of characters specified
 	 * by @p bufSize from the stream and store them in the string buffer.
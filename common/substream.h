@@ -86,6 +86,7 @@ public:
 	virtual int64 size() const { return _end - _begin; }
 
 	virtual bool seek(int64 offset, int whence = SEEK_SET);
+	virtual const byte *readInPlace(uint32 dataSize);
 };
 
 /**
@@ -109,6 +110,7 @@ public:
 	virtual bool seek(int64 offset, int whence = SEEK_SET) override { return SeekableSubReadStream::seek(offset, whence); }
 	void hexdump(int len, int bytesPerLine = 16, int startOffset = 0) { SeekableSubReadStream::hexdump(len, bytesPerLine, startOffset); }
 	bool skip(uint32 offset) override { return SeekableSubReadStream::seek(offset, SEEK_CUR); }
+	const byte *readInPlace(uint32 dataSize) override { return SeekableSubReadStream::readInPlace(dataSize); }
 };
 
 /**
@@ -131,6 +133,7 @@ public:
 	}
 
 	virtual uint32 read(void *dataPtr, uint32 dataSize);
+	virtual const byte *readInPlace(uint32 dataSize);
 };
 
 /** @} */
@@ -23,11 +23,14 @@
 #define FORBIDDEN_SYMBOL_EXCEPTION_exit
 
 #include "common/system.h"
+#include "common/config-manager.h"
 #include "common/events.h"
 #include "common/fs.h"
+#include "common/memorypool.h"
 #include "common/savefile.h"
 #include "common/str.h"
 #include "common/taskbar.h"
+#include "common/threadpool.h"
 #include "common/updates.h"
 #include "common/dialogs.h"
 #include "common/textconsole.h"
@@ -114,8 +117,12 @@ void OSystem::initBackend() {
 }
 
 void OSystem::destroy() {
+	// The configuration must be written while the timer manager is alive
+	if (Common::ConfigManager::hasInstance())
+		ConfMan.flushPendingWrites();
+
 	_backendInitialized = false;
-	Common::String::releaseMemoryPoolMutex();
+	Common::SmallObjectAllocator::releaseSharedMutex();
 	delete this;
 }
 
@@ -182,7 +189,14 @@ bool OSystem::setStretchMode(const char *name) {
 	return false;
 }
 
+uint64 OSystem::getMicros() {
+	return (uint64)getMillis(true) * 1000;
+}
+
 void OSystem::fatalError() {
+	if (Common::ConfigManager::hasInstance())
+		ConfMan.flushPendingWrites();
+
 	quit();
 	exit(1);
 }
@@ -219,6 +233,14 @@ bool OSystem::isConnectionLimited() {
 	return false;
 }
 
+Common::ThreadPool *OSystem::createThreadPool(uint threadCount) {
+	return new Common::InlineThreadPool();
+}
+
+Image::MPEGPacketDecoder *OSystem::createMPEGDecoder(uint16 width, uint16 height, const Graphics::PixelFormat &format) {
+	return nullptr;
+}
+
 Common::TimerManager *OSystem::getTimerManager() {
 	return _timerManager;
 }
@@ -40,6 +40,10 @@ namespace Graphics {
 struct Surface;
 }
 
+namespace Image {
+class MPEGPacketDecoder;
+}
+
 namespace GUI {
 class GuiObject;
 class OptionsContainerWidget;
@@ -61,6 +65,7 @@ class TextToSpeechManager;
 #if defined(USE_SYSDIALOGS)
 class DialogManager;
 #endif
+class ThreadPool;
 class TimerManager;
 class SeekableReadStream;
 class WriteStream;
@@ -1357,6 +1362,20 @@ public:
 	 */
 	virtual uint32 getMillis(bool skipRecord = false) = 0;
 
+	/**
+	 * Get a monotonic time stamp in microseconds, with the best resolution
+	 * the platform offers. Its starting point is arbitrary.
+	 *
+	 * This is meant for profiling, performance statistics and for scheduling
+	 * the timer callbacks. Unlike getMillis(), it is not processed by the
+	 * event recorder, so its value must never influence the game state. While
+	 * the event recorder is active, it schedules the timer callbacks on its
+	 * replayed getMillis() instead.
+	 *
+	 * The default implementation is based on getMillis().
+	 */
+	virtual uint64 getMicros();
+
 	/** Delay/sleep for the specified amount of milliseconds. */
 	virtual void delayMillis(uint msecs) = 0;
 
@@ -1474,6 +1493,20 @@ public:
 	 */
 	virtual void deleteMutex(MutexRef mutex) = 0;
 
+	/**
+	 * Create a pool of threads to run independent jobs on.
+	 *
+	 * This is the only way for common code and engines to use several
+	 * threads. The default implementation returns a pool running all jobs
+	 * on the calling thread, which is what backends without threads use.
+	 *
+	 * @param threadCount Number of threads to run jobs on, including
+	 *                    the calling thread, or 0 for one per CPU core.
+	 *
+	 * @return The newly created pool. The caller must delete it.
+	 */
+	virtual Common::ThreadPool *createThreadPool(uint threadCount);
+
 	/** @} */
 
 
@@ -1512,6 +1545,33 @@ public:
 
 
 
+	/** @defgroup common_system_video Video decoding
+	 *  @ingroup common_system
+	 *  @{
+	 */
+
+	/**
+	 * Create a decoder for an MPEG 1/2 video stream which uses the video
+	 * decoding hardware of the platform, for example through VA-API,
+	 * VideoToolbox or MediaCodec.
+	 *
+	 * The decoder converts each picture into the surface passed to it,
+	 * in the given pixel format. The default implementation returns
+	 * nullptr, in which case the video is decoded with libmpeg2.
+	 *
+	 * @param width  Width of the video.
+	 * @param height Height of the video.
+	 * @param format Pixel format of the decoded pictures.
+	 *
+	 * @return The newly created decoder, or nullptr if the video cannot be
+	 *         decoded in hardware. The caller must delete it.
+	 */
+	virtual Image::MPEGPacketDecoder *createMPEGDecoder(uint16 width, uint16 height, const Graphics::PixelFormat &format);
+
+	/** @} */
+
+
+
 	/** @defgroup common_system_misc Miscellaneous
 	 *  @ingroup common_system
 	 *  @{
@@ -1816,6 +1876,18 @@ public:
 	 */
 	virtual Common::String getSystemLanguage() const;
 
+	/**
+	 * Return the amount of physical memory of the device.
+	 *
+	 * Engines size their resource caches after it, through
+	 * getResourceMemoryBudget().
+	 *
+	 * The default implementation returns 0.
+	 *
+	 * @return Physical memory in bytes, or 0 if it is unknown.
+	 */
+	virtual uint64 getPhysicalMemorySize() const { return 0; }
+
 	/**
 	 * Return whether the connection is limited (if available on the target system).
 	 *
@@ -0,0 +1,69 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/threadpool.h"
+#include "common/util.h"
+
+namespace Common {
+
+namespace {
+
+struct RangeJobs {
+	void (*proc)(void *data, uint begin, uint end);
+	void *data;
+	uint size;
+	uint count;
+};
+
+void runRangeJob(void *data, uint job) {
+	const RangeJobs *jobs = (const RangeJobs *)data;
+	const uint begin = (uint)((uint64)jobs->size * job / jobs->count);
+	const uint end = (uint)((uint64)jobs->size * (job + 1) / jobs->count);
+	jobs->proc(jobs->data, begin, end);
+}
+
+} // End of anonymous namespace
+
+void ThreadPool::runRange(void (*proc)(void *data, uint begin, uint end), void *data, uint size, uint minChunk) {
+	if (size == 0)
+		return;
+
+	uint count = MIN(getThreadCount(), size / MAX<uint>(minChunk, 1));
+	if (count <= 1) {
+		proc(data, 0, size);
+		return;
+	}
+
+	RangeJobs jobs;
+	jobs.proc = proc;
+	jobs.data = data;
+	jobs.size = size;
+	jobs.count = count;
+	run(&runRangeJob, &jobs, count);
+}
+
+void InlineThreadPool::run(void (*proc)(void *data, uint job), void *data, uint count) {
+	for (uint job = 0; job < count; ++job)
+		proc(data, job);
+}
+
+} // End of namespace Common
@@ -0,0 +1,95 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_THREADPOOL_H
+#define COMMON_THREADPOOL_H
+
+#include "common/scummsys.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_threadpool Thread pool
+ * @ingroup common
+ *
+ * @brief API for running independent jobs on several threads at once.
+ * @{
+ */
+
+/**
+ * A pool of threads running batches of independent jobs.
+ *
+ * Pools are created through OSystem::createThreadPool(). Backends without
+ * threads return an InlineThreadPool, which runs all jobs on the calling
+ * thread, so code using a pool does not need a separate single threaded
+ * path.
+ *
+ * Jobs must not call into OSystem, apart from locking mutexes, and must
+ * not use a pool themselves.
+ */
+class ThreadPool {
+public:
+	virtual ~ThreadPool() {}
+
+	/**
+	 * Return how many jobs are run at once, including the calling thread.
+	 */
+	virtual uint getThreadCount() const = 0;
+
+	/**
+	 * Call proc(data, job) for each job from 0 to count - 1, in any order
+	 * and on any of the threads, and return when all of them are done.
+	 */
+	virtual void run(void (*proc)(void *data, uint job), void *data, uint count) = 0;
+
+	/**
+	 * Split the range [0, size) in contiguous chunks of at least minChunk
+	 * items, one per thread at most, and call proc(data, begin, end) for
+	 * each of them. Return when all of them are done.
+	 */
+	void runRange(void (*proc)(void *data, uint begin, uint end), void *data, uint size, uint minChunk = 1);
+
+	/**
+	 * Call proc(data) on one of the worker threads, and return without
+	 * waiting for it. The job keeps its thread from taking part in run()
+	 * until it returns. Jobs which have not started yet when the pool is
+	 * deleted are dropped, running ones are waited for.
+	 *
+	 * @return false, without calling proc, if the pool has no worker thread.
+	 */
+	virtual bool startBackgroundJob(void (*proc)(void *data), void *data) { return false; }
+};
+
+/**
+ * Thread pool running all jobs on the calling thread.
+ */
+class InlineThreadPool : public ThreadPool {
+public:
+	uint getThreadCount() const override { return 1; }
+	void run(void (*proc)(void *data, uint job), void *data, uint count) override;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
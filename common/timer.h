@@ -52,7 +52,7 @@ public:
 	 * written following the same safety guidelines as any other threaded code.
 	 *
 	 * @note Although the interval is specified in microseconds, the actual timer resolution
-	 *       may be lower. In particular, with the SDL backend the timer resolution is 10 ms.
+	 *       may be lower. In particular, with the SDL backend the timer resolution is 1 ms (10 ms with SDL 1.2).
 	 *
 	 * @param proc		Callback.
 	 * @param interval	Interval in which the timer shall be invoked (in microseconds).
@@ -0,0 +1,128 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#include "common/trace.h"
+#include "common/file.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+
+namespace Common {
+
+DECLARE_SINGLETON(Tracer);
+
+Tracer::Tracer() : _enabled(false), _origin(0) {
+}
+
+void Tracer::start(const String &fileName) {
+	_fileName = fileName;
+	_origin = g_system->getMicros();
+	_events.clear();
+	_enabled = true;
+}
+
+void Tracer::stop() {
+	if (!_enabled)
+		return;
+
+	flush();
+	_enabled = false;
+	_events.clear();
+}
+
+void Tracer::addEvent(const char *name, const String &detail, uint64 start, uint64 end) {
+	if (!_enabled)
+		return;
+
+	Event event;
+	event.name = name;
+	event.detail = detail;
+	event.start = start - _origin;
+	event.duration = end - start;
+	_events.push_back(event);
+}
+
+static String escapeJSON(const String &str) {
+	String result;
+	for (uint i = 0; i < str.size(); ++i) {
+		const char c = str[i];
+		if (c == '"' || c == '\\') {
+			result += '\\';
+			result += c;
+		} else if ((byte)c < 0x20) {
+			result += String::format("\\u%04x", (byte)c);
+		} else {
+			result += c;
+		}
+	}
+	return result;
+}
+
+void Tracer::flush() {
+	if (!_enabled)
+		return;
+
+	DumpFile file;
+	if (!file.open(_fileName)) {
+		warning("Tracer: Could not open '%s' for writing", _fileName.c_str());
+		return;
+	}
+
+	// The timestamps are in microseconds. All the events come from the
+	// main thread, so the nesting of their scopes gives the call tree.
+	file.writeString("{\"traceEvents\":[\n");
+	for (uint i = 0; i < _events.size(); ++i) {
+		const Event &event = _events[i];
+		String line = String::format("{\"name\":\"%s\",\"cat\":\"scummvm\",\"ph\":\"X\",\"ts\":%llu,\"dur\":%llu,\"pid\":1,\"tid\":1",
+		                             escapeJSON(event.name).c_str(), (unsigned long long)event.start, (unsigned long long)event.duration);
+		if (!event.detail.empty())
+			line += String::format(",\"args\":{\"detail\":\"%s\"}", escapeJSON(event.detail).c_str());
+		line += (i + 1 < _events.size()) ? "},\n" : "}\n";
+		file.writeString(line);
+	}
+	file.writeString("],\"displayTimeUnit\":\"ms\"}\n");
+
+	if (!file.flush() || file.err())
+		warning("Tracer: Could not write '%s'", _fileName.c_str());
+	file.close();
+}
+
+TraceScope::TraceScope(const char *name) : _name(name), _start(0),
+		_enabled(Tracer::hasInstance() && Tracer::instance().isEnabled()) {
+	if (_enabled)
+		_start = g_system->getMicros();
+}
+
+TraceScope::TraceScope(const char *name, const String &detail) : _name(name), _start(0),
+		_enabled(Tracer::hasInstance() && Tracer::instance().isEnabled()) {
+	if (_enabled) {
+		_detail = detail;
+		_start = g_system->getMicros();
+	}
+}
+
+TraceScope::~TraceScope() {
+	if (_enabled)
+		Tracer::instance().addEvent(_name, _detail, _start, g_system->getMicros());
+}
+
+} // End of namespace Common
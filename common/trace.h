@@ -0,0 +1,126 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#ifndef COMMON_TRACE_H
+#define COMMON_TRACE_H
+
+#include "common/array.h"
+#include "common/noncopyable.h"
+#include "common/singleton.h"
+#include "common/str.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_trace Tracing
+ * @ingroup common
+ *
+ * @brief Timing of the startup steps, in the Chrome trace event format.
+ *
+ * @{
+ */
+
+/**
+ * Records the timed scopes of the program, and writes them as a JSON trace
+ * which about:tracing in Chrome, or Perfetto, can show.
+ *
+ * The tracer only exists once start() was called, which is done by the
+ * --trace-file command line option. Until then, a TraceScope costs a check.
+ * The events are kept in memory, and written when flush() is called.
+ *
+ * The tracer is not thread-safe. Only the main thread should be traced.
+ */
+class Tracer : public Singleton<Tracer> {
+public:
+	/** Start recording the events, which will be written to @p fileName. */
+	void start(const String &fileName);
+
+	/** Stop recording the events, after writing them. */
+	void stop();
+
+	/** Return true if the events are being recorded. */
+	bool isEnabled() const { return _enabled; }
+
+	/**
+	 * Record a complete event.
+	 *
+	 * @param name     The name of the event. It must be a string literal.
+	 * @param detail   An optional description, such as a game id or a path.
+	 * @param start    The time the event started at, from OSystem::getMicros().
+	 * @param end      The time the event ended at, from OSystem::getMicros().
+	 */
+	void addEvent(const char *name, const String &detail, uint64 start, uint64 end);
+
+	/** Write all the events recorded so far, replacing the previous file. */
+	void flush();
+
+private:
+	friend class Singleton<SingletonBaseType>;
+	Tracer();
+
+	struct Event {
+		const char *name;
+		String detail;
+		uint64 start;
+		uint64 duration;
+	};
+
+	bool _enabled;
+	String _fileName;
+	uint64 _origin;
+	Array<Event> _events;
+};
+
+/**
+ * Records the time spent from its construction to its destruction, if the
+ * Tracer is enabled. Scopes nest, as they do in the code.
+ *
+ * @code
+ * {
+ *     Common::TraceScope trace("loadPlugins");
+ *     ...
+ * }
+ * @endcode
+ */
+class TraceScope : NonCopyable {
+public:
+	/** Start a scope. @p name must be a string literal. */
+	explicit TraceScope(const char *name);
+
+	/** Start a scope, described by @p detail, for instance a game id. */
+	TraceScope(const char *name, const String &detail);
+
+	~TraceScope();
+
+private:
+	const char *_name;
+	String _detail;
+	uint64 _start;
+	bool _enabled;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -309,8 +309,12 @@ void TranslationManager::loadTranslationsInfoDat(const Common::String &name) {
 		in.read(buf, len);
 		_langNames[i] = String(buf, len - 1).decode();
 	}
+}
+
+void TranslationManager::loadMessageIds(File &in) {
+	char buf[256];
+	int len;
 
-	// Read messages
 	int numMessages = in.readUint16BE();
 	_messageIds.resize(numMessages);
 	for (int i = 0; i < numMessages; ++i) {
@@ -332,6 +336,8 @@ void TranslationManager::loadLanguageDat(int index) {
 	if (index < 0 || index >= (int)_langs.size()) {
 		if (index != -1)
 			warning("Invalid language index %d passed to TranslationManager::loadLanguageDat", index);
+		// The message IDs are only needed to look up translated messages
+		_messageIds.clear();
 		return;
 	}
 
@@ -349,19 +355,26 @@ void TranslationManager::loadLanguageDat(int index) {
 		return;
 	}
 
-	// Get size of blocks to skip.
-	int skipSize = 0;
+	// Read the size of the translation description block, of the original
+	// language (english) block and of each translation block.
+	// All block sizes are written in Uint32BE.
+	Array<uint32> blockSizes(nbTranslations + 2);
+	for (int i = 0; i < nbTranslations + 2; ++i)
+		blockSizes[i] = in.readUint32BE();
 
-	// Skip translation description & size for the original language (english) block
-	// Also skip size of each translation block. All block sizes are written in Uint32BE.
-	for (int i = 0; i < index + 2; ++i)
-		skipSize += in.readUint32BE();
+	const int64 blocksStart = in.pos();
 
-	// We also need to skip the remaining block sizes
-	skipSize += 4 * (nbTranslations - index);	// 4 because block sizes are written in Uint32BE in the .dat file.
+	// The message IDs are in the original language block
+	if (_messageIds.empty()) {
+		in.seek(blocksStart + blockSizes[0]);
+		loadMessageIds(in);
+	}
 
 	// Seek to start of block we want to read
-	in.seek(skipSize, SEEK_CUR);
+	int64 blockStart = blocksStart;
+	for (int i = 0; i < index + 2; ++i)
+		blockStart += blockSizes[i];
+	in.seek(blockStart);
 
 	// Read number of translated messages
 	int nbMessages = in.readUint16BE();
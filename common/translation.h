@@ -220,9 +220,18 @@ private:
 
 	/**
 	 * Load the list of languages from the translations.dat file.
+	 *
+	 * The message IDs are only loaded along with the first translation,
+	 * so that running with the built-in language does not pay for them.
 	 */
 	void loadTranslationsInfoDat(const Common::String &name);
 
+	/**
+	 * Load the message IDs from the original language block of the
+	 * translations.dat file. The file must be positioned at the block.
+	 */
+	void loadMessageIds(File &in);
+
 	/**
 	 * Load the translation for the given language from the translations.dat file.
 	 *
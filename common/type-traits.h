@@ -29,6 +29,46 @@ namespace Common {
 	template <typename T> struct RemoveConst { typedef T type; };
 	template <typename T> struct RemoveConst<const T> { typedef T type; };
 	template <typename T> struct AddConst { typedef const T type; };
+	template <typename T> struct RemoveReference { typedef T type; };
+	template <typename T> struct RemoveReference<T &> { typedef T type; };
+
+	/** Replacement for std::is_integral: whether @p T is a built-in integer type. */
+	template <typename T> struct IsIntegral { static const bool value = false; };
+	template <typename T> struct IsIntegral<const T> : IsIntegral<T> {};
+	template <> struct IsIntegral<bool> { static const bool value = true; };
+	template <> struct IsIntegral<char> { static const bool value = true; };
+	template <> struct IsIntegral<signed char> { static const bool value = true; };
+	template <> struct IsIntegral<unsigned char> { static const bool value = true; };
+	template <> struct IsIntegral<short> { static const bool value = true; };
+	template <> struct IsIntegral<unsigned short> { static const bool value = true; };
+	template <> struct IsIntegral<int> { static const bool value = true; };
+	template <> struct IsIntegral<unsigned int> { static const bool value = true; };
+	template <> struct IsIntegral<long> { static const bool value = true; };
+	template <> struct IsIntegral<unsigned long> { static const bool value = true; };
+	template <> struct IsIntegral<long long> { static const bool value = true; };
+	template <> struct IsIntegral<unsigned long long> { static const bool value = true; };
+
+#ifdef USE_CXX11
+	template <typename T> struct RemoveReference<T &&> { typedef T type; };
+
+	/** Replacement for std::move: cast @p t to an rvalue, so that it may be moved from. */
+	template <typename T>
+	inline typename RemoveReference<T>::type &&move(T &&t) {
+		return static_cast<typename RemoveReference<T>::type &&>(t);
+	}
+
+	/** Replacement for std::forward: pass on @p t as the kind of reference it was given as. */
+	template <typename T>
+	inline T &&forward(typename RemoveReference<T>::type &t) {
+		return static_cast<T &&>(t);
+	}
+
+	/** @overload */
+	template <typename T>
+	inline T &&forward(typename RemoveReference<T>::type &&t) {
+		return static_cast<T &&>(t);
+	}
+#endif
 } // End of namespace Common
 
 #endif
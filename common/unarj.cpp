@@ -30,6 +30,7 @@
 #include "common/unarj.h"
 #include "common/file.h"
 #include "common/hash-str.h"
+#include "common/membercache.h"
 #include "common/memstream.h"
 #include "common/bufferedstream.h"
 #include "common/textconsole.h"
@@ -696,6 +697,7 @@ typedef HashMap<String, ArjHeader*, IgnoreCase_Hash, IgnoreCase_EqualTo> ArjHead
 class ArjArchive : public Archive {
 	ArjHeadersMap _headers;
 	String _arjFilename;
+	mutable ArchiveMemberCache _cache;
 
 public:
 	ArjArchive(const String &name);
@@ -776,6 +778,12 @@ SeekableReadStream *ArjArchive::createReadStreamForMember(const String &name) co
 
 	ArjHeader *hdr = _headers[name];
 
+	if (hdr->method != 0) {
+		SeekableReadStream *cached = _cache.createReadStream(name);
+		if (cached)
+			return cached;
+	}
+
 	File archiveFile;
 	archiveFile.open(_arjFilename);
 	archiveFile.seek(hdr->pos, SEEK_SET);
@@ -804,6 +812,8 @@ SeekableReadStream *ArjArchive::createReadStreamForMember(const String &name) co
 			decoder->decode_f(hdr->origSize);
 
 		delete decoder;
+
+		return _cache.add(name, uncompressedData, hdr->origSize);
 	}
 
 	return new MemoryReadStream(uncompressedData, hdr->origSize, DisposeAfterUse::YES);
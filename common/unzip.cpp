@@ -79,6 +79,13 @@
 #include <zlib.h>
 #endif
 
+#ifdef USE_LIBDEFLATE
+#include <libdeflate.h>
+#define unz_crc32(crc, buf, len) libdeflate_crc32(crc, buf, len)
+#else
+#define unz_crc32(crc, buf, len) crc32(crc, buf, len)
+#endif
+
 #else  // !USE_ZLIB
 
 // Even when zlib is not linked in, we can still open ZIP archives and read
@@ -103,9 +110,16 @@ typedef struct {
 
 #endif  // !USE_ZLIB
 
+#include "common/algorithm.h"
 #include "common/fs.h"
 #include "common/unzip.h"
 #include "common/memstream.h"
+#include "common/mutex.h"
+#include "common/ptr.h"
+#include "common/span.h"
+#include "common/system.h"
+#include "common/threadpool.h"
+#include "common/zlib.h"
 
 #include "common/hashmap.h"
 #include "common/hash-str.h"
@@ -382,6 +396,8 @@ typedef Common::HashMap<Common::String, cached_file_in_zip, Common::IgnoreCase_H
 */
 typedef struct {
 	Common::SeekableReadStream *_stream;				/* io structore of the zipfile */
+	Common::SharedPtr<Common::SeekableReadStream> _sharedStream;	/* owner of _stream, shared with the member streams */
+	Common::SharedPtr<Common::Mutex> _streamMutex;	/* held while _sharedStream is used, shared with the member streams */
 	unz_global_info gi;				/* public global information */
 	uLong byte_before_the_zipfile;	/* byte before the zipfile, (>0 for sfx)*/
 	uLong num_file;					/* number of the current file in the zipfile*/
@@ -544,6 +560,8 @@ unzFile unzOpen(Common::SeekableReadStream *stream) {
 	int err=UNZ_OK;
 
 	us->_stream = stream;
+	us->_sharedStream = Common::SharedPtr<Common::SeekableReadStream>(stream);
+	us->_streamMutex = Common::SharedPtr<Common::Mutex>(new Common::Mutex());
 
 	central_pos = unzlocal_SearchCentralDir(*us->_stream);
 	if (central_pos==0)
@@ -595,7 +613,6 @@ unzFile unzOpen(Common::SeekableReadStream *stream) {
 		err=UNZ_BADZIPFILE;
 
 	if (err != UNZ_OK) {
-		delete us->_stream;
 		delete us;
 		return nullptr;
 	}
@@ -605,6 +622,26 @@ unzFile unzOpen(Common::SeekableReadStream *stream) {
 	us->central_pos = central_pos;
 	us->pfile_in_zip_read = nullptr;
 
+	// Read the whole central directory at once and index it from memory,
+	// instead of doing several small reads and a seek for each entry. The
+	// offsets of the entries are relative to the start of the zipfile, so
+	// they are shifted to point into the buffer while indexing.
+	byte *centralDir = (byte *)malloc(us->size_central_dir);
+	if (centralDir) {
+		us->_stream->seek(us->offset_central_dir + us->byte_before_the_zipfile, SEEK_SET);
+		if (us->_stream->read(centralDir, us->size_central_dir) != us->size_central_dir) {
+			free(centralDir);
+			centralDir = nullptr;
+		}
+	}
+
+	Common::MemoryReadStream centralDirStream(centralDir, centralDir ? us->size_central_dir : 0, DisposeAfterUse::YES);
+	uLong byte_before_the_zipfile = us->byte_before_the_zipfile;
+	if (centralDir) {
+		us->_stream = &centralDirStream;
+		us->byte_before_the_zipfile = 0 - us->offset_central_dir;
+	}
+
 	err = unzGoToFirstFile((unzFile)us);
 
 	while (err == UNZ_OK) {
@@ -626,6 +663,9 @@ unzFile unzOpen(Common::SeekableReadStream *stream) {
 		// Move to the next file
 		err = unzGoToNextFile((unzFile)us);
 	}
+
+	us->_stream = us->_sharedStream.get();
+	us->byte_before_the_zipfile = byte_before_the_zipfile;
 	return (unzFile)us;
 }
 
@@ -644,7 +684,6 @@ int unzClose(unzFile file) {
 	if (s->pfile_in_zip_read != nullptr)
 		unzCloseCurrentFile(file);
 
-	delete s->_stream;
 	delete s;
 	return UNZ_OK;
 }
@@ -1195,7 +1234,7 @@ int unzReadCurrentFile(unzFile file, voidp buf, unsigned len) {
 				*(pfile_in_zip_read_info->stream.next_out+i) = *(pfile_in_zip_read_info->stream.next_in+i);
 
 #ifdef USE_ZLIB
-			pfile_in_zip_read_info->crc32_data = crc32(pfile_in_zip_read_info->crc32_data,
+			pfile_in_zip_read_info->crc32_data = unz_crc32(pfile_in_zip_read_info->crc32_data,
 								pfile_in_zip_read_info->stream.next_out,
 								uDoCopy);
 #endif  // otherwise leave crc32_data as is and it won't be verified at the end
@@ -1228,7 +1267,7 @@ int unzReadCurrentFile(unzFile file, voidp buf, unsigned len) {
 			uOutThis = uTotalOutAfter-uTotalOutBefore;
 
 			pfile_in_zip_read_info->crc32_data =
-				crc32(pfile_in_zip_read_info->crc32_data,bufBefore, (uInt)(uOutThis));
+				unz_crc32(pfile_in_zip_read_info->crc32_data,bufBefore, (uInt)(uOutThis));
 
 			pfile_in_zip_read_info->rest_read_uncompressed -= uOutThis;
 
@@ -1419,11 +1458,117 @@ int unzGetGlobalComment(unzFile file, char *szComment, uLong uSizeBuf) {
 
 namespace Common {
 
+/**
+ * A stream over a stored or compressed member of a ZIP archive, read
+ * directly from the stream of the archive. The stream of the archive is
+ * shared by all its member streams: each read seeks to the position of the
+ * member stream first, and the stream of the archive stays alive as long as
+ * one of its member streams does.
+ *
+ * The archive and its member streams hold a shared mutex while they use the
+ * stream of the archive, so that member streams can be read from other
+ * threads than the one using the archive.
+ */
+class ZipMemberReadStream : public SeekableReadStream {
+	SharedPtr<SeekableReadStream> _parentStream;
+	SharedPtr<Mutex> _parentMutex;
+	const uint32 _begin;
+	const uint32 _size;
+	uint32 _pos;
+	bool _eos;
+
+public:
+	ZipMemberReadStream(const SharedPtr<SeekableReadStream> &parentStream, const SharedPtr<Mutex> &parentMutex, uint32 begin, uint32 size)
+		: _parentStream(parentStream), _parentMutex(parentMutex), _begin(begin), _size(size), _pos(0), _eos(false) {
+	}
+
+	bool eos() const override { return _eos; }
+
+	bool err() const override {
+		StackLock lock(*_parentMutex);
+		return _parentStream->err();
+	}
+
+	void clearErr() override {
+		StackLock lock(*_parentMutex);
+		_eos = false;
+		_parentStream->clearErr();
+	}
+
+	int64 pos() const override { return _pos; }
+	int64 size() const override { return _size; }
+
+	bool seek(int64 offset, int whence = SEEK_SET) override {
+		switch (whence) {
+		case SEEK_END:
+			offset = _size + offset;
+			break;
+		case SEEK_CUR:
+			offset = _pos + offset;
+			break;
+		case SEEK_SET:
+		default:
+			break;
+		}
+		if (offset < 0 || offset > _size)
+			return false;
+		_pos = offset;
+		_eos = false;
+		return true;
+	}
+
+	uint32 read(void *dataPtr, uint32 dataSize) override {
+		if (dataSize > _size - _pos) {
+			dataSize = _size - _pos;
+			_eos = true;
+		}
+		if (!dataSize)
+			return 0;
+
+		StackLock lock(*_parentMutex);
+		if (!_parentStream->seek(_begin + _pos, SEEK_SET))
+			return 0;
+
+		dataSize = _parentStream->read(dataPtr, dataSize);
+		_pos += dataSize;
+		return dataSize;
+	}
+};
 
 class ZipArchive : public Archive {
 	unzFile _zipFile;
 
+	/** Members inflated by prefetchMembers(), which have not been opened yet. */
+	typedef HashMap<String, MemoryReadStream *, IgnoreCase_Hash, IgnoreCase_EqualTo> PrefetchMap;
+	mutable PrefetchMap _prefetched;
+
+	/**
+	 * Members still to be inflated by the prefetch job, in the order they
+	 * are stored. Like _prefetched, this is protected by the stream mutex.
+	 */
+	mutable StringArray _prefetchQueue;
+	/** Whether a prefetch job is queued or running. */
+	bool _prefetchRunning;
+	/** Runs the prefetch job, created by the first prefetchMembers(). */
+	ThreadPool *_prefetchPool;
+
+	/** Inflate the members in _prefetchQueue until it is empty. */
+	static void prefetchProc(void *data);
+
+	/** Open the current file in the zipfile. */
+	SeekableReadStream *openCurrentFile() const;
+
+	/** Read the whole current file in the zipfile into memory. */
+	MemoryReadStream *readCurrentFile() const;
+
 public:
+	/**
+	 * Members at least this large are decompressed while they are read,
+	 * instead of being decompressed into memory at once when they are
+	 * opened.
+	 */
+	static const uint32 kStreamingMinSize = 1024 * 1024;
+
 	ZipArchive(unzFile zipFile);
 
 
@@ -1433,35 +1578,31 @@ public:
 	virtual int listMembers(ArchiveMemberList &list) const;
 	virtual const ArchiveMemberPtr getMember(const String &name) const;
 	virtual SeekableReadStream *createReadStreamForMember(const String &name) const;
-};
 
-/*
-class ZipArchiveMember : public ArchiveMember {
-	unzFile _zipFile;
-
-public:
-	ZipArchiveMember(FSNode &node) : _node(node) {
-	}
-
-	String getName() const {
-		...
-	}
-
-	SeekableReadStream *open() {
-		...
-	}
+	/** See prefetchZipMembers(). */
+	void prefetchMembers(const StringArray &names);
 };
-*/
 
-ZipArchive::ZipArchive(unzFile zipFile) : _zipFile(zipFile) {
+ZipArchive::ZipArchive(unzFile zipFile) : _zipFile(zipFile), _prefetchRunning(false), _prefetchPool(nullptr) {
 	assert(_zipFile);
 }
 
 ZipArchive::~ZipArchive() {
+	// Stop the prefetch job after the member it is inflating
+	{
+		StackLock lock(*((const unz_s *)_zipFile)->_streamMutex);
+		_prefetchQueue.clear();
+	}
+	delete _prefetchPool;
+
+	for (PrefetchMap::iterator i = _prefetched.begin(); i != _prefetched.end(); ++i)
+		delete i->_value;
+
 	unzClose(_zipFile);
 }
 
 bool ZipArchive::hasFile(const String &name) const {
+	StackLock lock(*((const unz_s *)_zipFile)->_streamMutex);
 	return (unzLocateFile(_zipFile, name.c_str(), 2) == UNZ_OK);
 }
 
@@ -1486,9 +1627,52 @@ const ArchiveMemberPtr ZipArchive::getMember(const String &name) const {
 }
 
 SeekableReadStream *ZipArchive::createReadStreamForMember(const String &name) const {
+	StackLock lock(*((const unz_s *)_zipFile)->_streamMutex);
+
+	PrefetchMap::iterator prefetched = _prefetched.find(name);
+	if (prefetched != _prefetched.end()) {
+		// Prefetched members are handed out once
+		SeekableReadStream *stream = prefetched->_value;
+		_prefetched.erase(prefetched);
+		return stream;
+	}
+
+	// Opening the member now makes prefetching it pointless
+	for (uint i = 0; i < _prefetchQueue.size(); ++i) {
+		if (_prefetchQueue[i].equalsIgnoreCase(name)) {
+			_prefetchQueue.remove_at(i);
+			break;
+		}
+	}
+
 	if (unzLocateFile(_zipFile, name.c_str(), 2) != UNZ_OK)
 		return nullptr;
 
+	return openCurrentFile();
+}
+
+SeekableReadStream *ZipArchive::openCurrentFile() const {
+	const unz_s *const archive = (const unz_s *)_zipFile;
+	const unz_file_info &fileInfo = archive->cur_file_info;
+
+	if (fileInfo.uncompressed_size < kStreamingMinSize)
+		return readCurrentFile();
+
+	// Opening the file reads its local header, which tells where its data starts
+	if (unzOpenCurrentFile(_zipFile) != UNZ_OK)
+		return nullptr;
+
+	const uint32 begin = archive->pfile_in_zip_read->pos_in_zipfile + archive->byte_before_the_zipfile;
+	unzCloseCurrentFile(_zipFile);
+
+	if (fileInfo.compression_method == 0)
+		return new ZipMemberReadStream(archive->_sharedStream, archive->_streamMutex, begin, fileInfo.uncompressed_size);
+
+	SeekableReadStream *compressed = new ZipMemberReadStream(archive->_sharedStream, archive->_streamMutex, begin, fileInfo.compressed_size);
+	return wrapDeflateReadStream(compressed, fileInfo.uncompressed_size);
+}
+
+MemoryReadStream *ZipArchive::readCurrentFile() const {
 	unz_file_info fileInfo;
 	if (unzOpenCurrentFile(_zipFile) != UNZ_OK)
 		return nullptr;
@@ -1499,6 +1683,30 @@ SeekableReadStream *ZipArchive::createReadStreamForMember(const String &name) co
 	byte *buffer = (byte *)malloc(fileInfo.uncompressed_size);
 	assert(buffer);
 
+#ifdef USE_ZLIB
+	if (fileInfo.compression_method == Z_DEFLATED && fileInfo.uncompressed_size > 0) {
+		// Inflate the whole member with a single call, instead of going
+		// through the buffers of unzReadCurrentFile()
+		unz_s *const archive = (unz_s *)_zipFile;
+		const uint32 begin = archive->pfile_in_zip_read->pos_in_zipfile + archive->byte_before_the_zipfile;
+		unzCloseCurrentFile(_zipFile);
+
+		SpanOwner<Span<byte> > compressedBuffer;
+		Span<const byte> compressed;
+		if (archive->_stream->seek(begin, SEEK_SET))
+			compressed = readSpan(*archive->_stream, fileInfo.compressed_size, compressedBuffer);
+
+		if (compressed.size() != fileInfo.compressed_size ||
+		    !inflateZlibHeaderless(buffer, fileInfo.uncompressed_size, compressed.data(), compressed.size()) ||
+		    unz_crc32(0, buffer, fileInfo.uncompressed_size) != fileInfo.crc) {
+			free(buffer);
+			return nullptr;
+		}
+
+		return new MemoryReadStream(buffer, fileInfo.uncompressed_size, DisposeAfterUse::YES);
+	}
+#endif
+
 	if (unzReadCurrentFile(_zipFile, buffer, fileInfo.uncompressed_size) != (int)fileInfo.uncompressed_size) {
 		free(buffer);
 		return nullptr;
@@ -1510,11 +1718,88 @@ SeekableReadStream *ZipArchive::createReadStreamForMember(const String &name) co
 	}
 
 	return new MemoryReadStream(buffer, fileInfo.uncompressed_size, DisposeAfterUse::YES);
+}
+
+namespace {
+
+struct PrefetchedMember {
+	String _name;
+	uLong _offset;
+
+	bool operator<(const PrefetchedMember &x) const {
+		return _offset < x._offset;
+	}
+};
+
+} // End of anonymous namespace
+
+void ZipArchive::prefetchMembers(const StringArray &names) {
+	StackLock lock(*((const unz_s *)_zipFile)->_streamMutex);
+
+	Array<PrefetchedMember> members;
+	members.reserve(names.size());
+
+	for (StringArray::const_iterator i = names.begin(); i != names.end(); ++i) {
+		if (_prefetched.contains(*i) || unzLocateFile(_zipFile, i->c_str(), 2) != UNZ_OK)
+			continue;
+
+		PrefetchedMember member;
+		member._name = *i;
+		member._offset = ((const unz_s *)_zipFile)->cur_file_info_internal.offset_curfile;
+		members.push_back(member);
+	}
+
+	// Read the members in the order they are stored, so that the archive is
+	// read forward only
+	sort(members.begin(), members.end());
+
+	for (uint i = 0; i < members.size(); ++i)
+		_prefetchQueue.push_back(members[i]._name);
+
+	if (_prefetchRunning || _prefetchQueue.empty())
+		return;
+
+	// One worker thread, and the calling thread which is not used
+	if (!_prefetchPool)
+		_prefetchPool = g_system->createThreadPool(2);
+
+	_prefetchRunning = true;
+	if (!_prefetchPool->startBackgroundJob(&prefetchProc, this)) {
+		// Without a worker thread, prefetch right away
+		prefetchProc(this);
+	}
+}
+
+void ZipArchive::prefetchProc(void *data) {
+	ZipArchive *zip = (ZipArchive *)data;
+	Mutex &mutex = *((const unz_s *)zip->_zipFile)->_streamMutex;
+
+	// The lock is taken for one member at a time, so that the archive can
+	// be used in between
+	for (;;) {
+		StackLock lock(mutex);
+
+		if (zip->_prefetchQueue.empty()) {
+			zip->_prefetchRunning = false;
+			return;
+		}
+
+		const String name = zip->_prefetchQueue.front();
+		zip->_prefetchQueue.remove_at(0);
+
+		if (zip->_prefetched.contains(name) || unzLocateFile(zip->_zipFile, name.c_str(), 2) != UNZ_OK)
+			continue;
+
+		MemoryReadStream *stream = zip->readCurrentFile();
+		if (stream)
+			zip->_prefetched[name] = stream;
+	}
+}
 
-	// FIXME: instead of reading all into a memory stream, we could
-	// instead create a new ZipStream class. But then we have to be
-	// careful to handle the case where the client code opens multiple
-	// files in the archive and tries to use them independently.
+void prefetchZipMembers(Archive &archive, const StringArray &names) {
+	ZipArchive *zipArchive = dynamic_cast<ZipArchive *>(&archive);
+	if (zipArchive)
+		zipArchive->prefetchMembers(names);
 }
 
 Archive *makeZipArchive(const String &name) {
@@ -24,6 +24,7 @@
 #define COMMON_UNZIP_H
 
 #include "common/str.h"
+#include "common/str-array.h"
 
 namespace Common {
 
@@ -66,6 +67,24 @@ Archive *makeZipArchive(const FSNode &node);
  */
 Archive *makeZipArchive(SeekableReadStream *stream);
 
+/**
+ * Decompress the members @p names of @p archive into memory ahead of time,
+ * so that opening them later does not have to. This is done by a background
+ * job on a worker thread, see OSystem::createThreadPool(). Without worker
+ * threads, it is done right away, for instance while a loading screen is
+ * shown. The members are read in the order they are stored in the archive.
+ * Each prefetched member is kept until it is opened once. Opening a member
+ * before the job got to it reads it as usual, and the job skips it.
+ *
+ * The job reads the stream the archive was created from. That stream must
+ * therefore not share its file handle with other streams, as the members
+ * of other archives do.
+ *
+ * @p archive has to be created by makeZipArchive(). Nothing is done for other
+ * archives, and the names which are not in the archive are ignored.
+ */
+void prefetchZipMembers(Archive &archive, const StringArray &names);
+
 /** @} */
 
 } // End of namespace Common
@@ -61,6 +61,13 @@ U32String &U32String::operator=(const U32String &str) {
 	return *this;
 }
 
+#ifdef USE_CXX11
+U32String &U32String::operator=(U32String &&str) {
+	assign(static_cast<BaseString<u32char_type_t> &&>(str));
+	return *this;
+}
+#endif
+
 U32String &U32String::operator=(const String &str) {
 	clear();
 	decodeInternal(str.c_str(), str.size(), Common::kUtf8);
@@ -24,6 +24,7 @@
 #define FORBIDDEN_SYMBOL_ALLOW_ALL
 
 #include "common/zlib.h"
+#include "common/memstream.h"
 #include "common/ptr.h"
 #include "common/util.h"
 #include "common/stream.h"
@@ -46,12 +47,63 @@
   #endif
 #endif
 
+#if defined(USE_LIBDEFLATE)
+  #include <libdeflate.h>
+#endif
+
 
 namespace Common {
 
 #if defined(USE_ZLIB)
 
+#if defined(USE_LIBDEFLATE)
+
+enum DeflateFormat {
+	kDeflateRaw,
+	kDeflateZlib,
+	kDeflateGzip
+};
+
+/**
+ * Decompress a whole buffer at once with libdeflate, which is a lot faster
+ * than zlib for this. libdeflate fails when the output does not fit in the
+ * destination buffer, where zlib decompresses as much as fits, so the
+ * callers fall back to zlib whenever this fails.
+ */
+static bool inflateOneShot(DeflateFormat format, byte *dst, size_t dstLen, const byte *src, size_t srcLen, size_t *actualLen) {
+	libdeflate_decompressor *decompressor = libdeflate_alloc_decompressor();
+	if (!decompressor)
+		return false;
+
+	libdeflate_result result;
+	switch (format) {
+	case kDeflateZlib:
+		result = libdeflate_zlib_decompress(decompressor, src, srcLen, dst, dstLen, actualLen);
+		break;
+	case kDeflateGzip:
+		result = libdeflate_gzip_decompress(decompressor, src, srcLen, dst, dstLen, actualLen);
+		break;
+	case kDeflateRaw:
+	default:
+		result = libdeflate_deflate_decompress(decompressor, src, srcLen, dst, dstLen, actualLen);
+		break;
+	}
+
+	libdeflate_free_decompressor(decompressor);
+	return result == LIBDEFLATE_SUCCESS;
+}
+
+#endif
+
 bool uncompress(byte *dst, unsigned long *dstLen, const byte *src, unsigned long srcLen) {
+#if defined(USE_LIBDEFLATE)
+	size_t actualLen;
+	if (inflateOneShot(kDeflateZlib, dst, *dstLen, src, srcLen, &actualLen)) {
+		*dstLen = actualLen;
+		return true;
+	}
+#endif
+
 	return Z_OK == ::uncompress(dst, dstLen, src, srcLen);
 }
 
@@ -59,6 +111,13 @@ bool inflateZlibHeaderless(byte *dst, uint dstLen, const byte *src, uint srcLen,
 	if (!dst || !dstLen || !src || !srcLen)
 		return false;
 
+#if defined(USE_LIBDEFLATE)
+	// libdeflate does not support preset dictionaries
+	size_t actualLen;
+	if (!dict && inflateOneShot(kDeflateRaw, dst, dstLen, src, srcLen, &actualLen))
+		return true;
+#endif
+
 	// Initialize zlib
 	z_stream stream;
 	stream.next_in = const_cast<byte *>(src);
@@ -244,23 +303,28 @@ protected:
 
 public:
 
-	GZipReadStream(SeekableReadStream *w, uint32 knownSize = 0) : _wrapped(w), _stream() {
+	GZipReadStream(SeekableReadStream *w, uint32 knownSize = 0, bool headerless = false) : _wrapped(w), _stream() {
 		assert(w != nullptr);
 
-		// Verify file header is correct
-		w->seek(0, SEEK_SET);
-		uint16 header = w->readUint16BE();
-		assert(header == 0x1F8B ||
-		       ((header & 0x0F00) == 0x0800 && header % 31 == 0));
-
-		if (header == 0x1F8B) {
-			// Retrieve the original file size
-			w->seek(-4, SEEK_END);
-			_origSize = w->readUint32LE();
-		} else {
-			// Original size not available in zlib format
-			// use an otherwise known size if supplied.
+		if (headerless) {
+			// Raw deflate data does not store its size
 			_origSize = knownSize;
+		} else {
+			// Verify file header is correct
+			w->seek(0, SEEK_SET);
+			uint16 header = w->readUint16BE();
+			assert(header == 0x1F8B ||
+			       ((header & 0x0F00) == 0x0800 && header % 31 == 0));
+
+			if (header == 0x1F8B) {
+				// Retrieve the original file size
+				w->seek(-4, SEEK_END);
+				_origSize = w->readUint32LE();
+			} else {
+				// Original size not available in zlib format
+				// use an otherwise known size if supplied.
+				_origSize = knownSize;
+			}
 		}
 		_pos = 0;
 		w->seek(0, SEEK_SET);
@@ -271,7 +335,8 @@ public:
 		// the compressed file. This feature was added in zlib 1.2.0.4,
 		// released 10 August 2003.
 		// Note: This is *crucial* for savegame compatibility, do *not* remove!
-		_zlibErr = inflateInit2(&_stream, MAX_WBITS + 32);
+		// A negative windowBits tells zlib that there is no header at all.
+		_zlibErr = inflateInit2(&_stream, headerless ? -MAX_WBITS : MAX_WBITS + 32);
 		if (_zlibErr != Z_OK)
 			return;
 
@@ -492,6 +557,54 @@ public:
 
 #endif	// USE_ZLIB
 
+#if defined(USE_LIBDEFLATE)
+
+enum {
+	/** Largest compressed and decompressed size of a stream decompressed at once. */
+	kOneShotMaxSize = 8 * 1024 * 1024
+};
+
+/**
+ * Decompress a whole gzip or zlib stream into memory at once, if its
+ * decompressed size is known and small enough. Return nullptr otherwise,
+ * with the stream rewound, to decompress it on the fly instead.
+ */
+static SeekableReadStream *inflateWholeStream(SeekableReadStream *stream, uint16 header, uint32 knownSize) {
+	const int64 srcLen = stream->size();
+	if (srcLen > kOneShotMaxSize)
+		return nullptr;
+
+	uint32 dstLen = knownSize;
+	if (header == 0x1F8B) {
+		// The gzip trailer stores the decompressed size
+		stream->seek(-4, SEEK_END);
+		dstLen = stream->readUint32LE();
+		stream->seek(0, SEEK_SET);
+	}
+	if (dstLen == 0 || dstLen > kOneShotMaxSize)
+		return nullptr;
+
+	byte *src = (byte *)malloc(srcLen);
+	byte *dst = (byte *)malloc(dstLen);
+	size_t actualLen = 0;
+	bool success = src && dst && stream->read(src, srcLen) == (uint32)srcLen &&
+		inflateOneShot(header == 0x1F8B ? kDeflateGzip : kDeflateZlib, dst, dstLen, src, srcLen, &actualLen) &&
+		actualLen == dstLen;
+	free(src);
+
+	if (!success) {
+		free(dst);
+		stream->clearErr();
+		stream->seek(0, SEEK_SET);
+		return nullptr;
+	}
+
+	delete stream;
+	return new MemoryReadStream(dst, dstLen, DisposeAfterUse::YES);
+}
+
+#endif
+
 SeekableReadStream *wrapCompressedReadStream(SeekableReadStream *toBeWrapped, uint32 knownSize) {
 	if (toBeWrapped) {
 		if (toBeWrapped->eos() || toBeWrapped->err() || toBeWrapped->size() < 2) {
@@ -504,6 +617,11 @@ SeekableReadStream *wrapCompressedReadStream(SeekableReadStream *toBeWrapped, ui
 				      header % 31 == 0));
 		toBeWrapped->seek(-2, SEEK_CUR);
 		if (isCompressed) {
+#if defined(USE_LIBDEFLATE)
+			SeekableReadStream *inflated = inflateWholeStream(toBeWrapped, header, knownSize);
+			if (inflated)
+				return inflated;
+#endif
 #if defined(USE_ZLIB)
 			return new GZipReadStream(toBeWrapped, knownSize);
 #else
@@ -515,6 +633,17 @@ SeekableReadStream *wrapCompressedReadStream(SeekableReadStream *toBeWrapped, ui
 	return toBeWrapped;
 }
 
+SeekableReadStream *wrapDeflateReadStream(SeekableReadStream *toBeWrapped, uint32 size) {
+	if (!toBeWrapped)
+		return nullptr;
+#if defined(USE_ZLIB)
+	return new GZipReadStream(toBeWrapped, size, true);
+#else
+	delete toBeWrapped;
+	return nullptr;
+#endif
+}
+
 WriteStream *wrapCompressedWriteStream(WriteStream *toBeWrapped) {
 #if defined(USE_ZLIB)
 	if (toBeWrapped)
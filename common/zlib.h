@@ -142,6 +142,21 @@ bool inflateZlibHeaderless(Common::WriteStream *dst, Common::SeekableReadStream
  */
 SeekableReadStream *wrapCompressedReadStream(SeekableReadStream *toBeWrapped, uint32 knownSize = 0);
 
+/**
+ * Take an arbitrary SeekableReadStream holding raw deflate data, without any
+ * gzip or zlib header, such as a member of a ZIP archive, and wrap it in a
+ * custom stream which decompresses it on the fly. As raw deflate data does
+ * not store its decompressed size, it has to be passed as @p size.
+ *
+ * The created stream becomes responsible for freeing the passed stream. When
+ * there is no ZLIB support, the passed stream is destroyed and NULL is
+ * returned.
+ *
+ * @param toBeWrapped	the stream with the compressed data
+ * @param size			the size of the decompressed data
+ */
+SeekableReadStream *wrapDeflateReadStream(SeekableReadStream *toBeWrapped, uint32 size);
+
 /**
  * Take an arbitrary WriteStream and wrap it in a custom stream which provides
  * transparent on-the-fly compression. The compressed data is written in the
@@ -28,11 +28,13 @@
 #include "common/config-manager.h"
 #include "common/system.h"
 #include "common/textconsole.h"
+#include "common/trace.h"
 #include "common/translation.h"
 #include "gui/EventRecorder.h"
 #include "gui/gui-manager.h"
 #include "gui/message.h"
 #include "engines/advancedDetector.h"
+#include "engines/detectioncache.h"
 #include "engines/obsolete.h"
 
 /**
@@ -242,7 +244,10 @@ DetectedGames AdvancedMetaEngineDetection::detectGames(const Common::FSList &fsl
 		return DetectedGames();
 
 	// Compose a hashmap of all files in fslist.
-	composeFileHashMap(allFiles, fslist, (_maxScanDepth == 0 ? 1 : _maxScanDepth));
+	{
+		Common::TraceScope trace("composeFileHashMap");
+		composeFileHashMap(allFiles, fslist, (_maxScanDepth == 0 ? 1 : _maxScanDepth));
+	}
 
 	// Run the detector on this
 	ADDetectedGames matches = detectGame(fslist.begin()->getParent(), allFiles, Common::UNK_LANG, Common::kPlatformUnknown, "");
@@ -353,13 +358,17 @@ Common::Error AdvancedMetaEngineDetection::createInstance(OSystem *syst, Engine
 
 	// Compose a hashmap of all files in fslist.
 	FileMap allFiles;
-	composeFileHashMap(allFiles, files, (_maxScanDepth == 0 ? 1 : _maxScanDepth));
+	{
+		Common::TraceScope trace("composeFileHashMap", path);
+		composeFileHashMap(allFiles, files, (_maxScanDepth == 0 ? 1 : _maxScanDepth));
+	}
 
 	// Clear md5 cache before each detection starts, just in case.
 	MD5Man.clear();
 
 	// Run the detector on this
 	ADDetectedGames matches = detectGame(files.begin()->getParent(), allFiles, language, platform, extra);
+	DetectionCacheMan.flush();
 
 	if (cleanupPirated(matches))
 		return Common::kNoGameDataFoundError;
@@ -374,6 +383,7 @@ Common::Error AdvancedMetaEngineDetection::createInstance(OSystem *syst, Engine
 
 	if (!agdDesc.desc) {
 		// Use fallback detector if there were no matches by other means
+		Common::TraceScope trace("fallbackDetect");
 		ADDetectedGame fallbackDetectedGame = fallbackDetect(allFiles, files);
 		agdDesc = fallbackDetectedGame;
 		if (agdDesc.desc) {
@@ -427,6 +437,7 @@ Common::Error AdvancedMetaEngineDetection::createInstance(OSystem *syst, Engine
 
 	if (plugin) {
 		// Call child class's createInstanceMethod.
+		Common::TraceScope trace("AdvancedMetaEngine::createInstance", agdDesc.desc->gameId);
 		return plugin->get<AdvancedMetaEngine>().createInstance(syst, engine, agdDesc.desc);
 	}
 
@@ -479,84 +490,125 @@ namespace Common {
 	DECLARE_SINGLETON(MD5CacheManager);
 }
 
-bool AdvancedMetaEngineDetection::getFileProperties(const FileMap &allFiles, const ADGameDescription &game, const Common::String fname, FileProperties &fileProps) const {
-	// FIXME/TODO: We don't handle the case that a file is listed as a regular
-	// file and as one with resource fork.
-	Common::String hashname = Common::String::format("%s:%d", fname.c_str(), _md5Bytes);
+/**
+ * Compute the key and the stamp under which the properties of @p fname are
+ * kept in the detection cache. For resource forks, the stamp covers all the
+ * files MacResManager may read the fork from.
+ *
+ * @return False if the properties cannot be cached.
+ */
+static bool getDetectionCacheKey(const AdvancedMetaEngine::FileMap &allFiles, uint md5Bytes, bool resFork, const Common::String &fname, Common::String &key, Common::String &stamp) {
+	Common::String candidates[4];
+	uint numCandidates = 0;
+
+	if (resFork) {
+		candidates[numCandidates++] = fname + ".rsrc";
+		candidates[numCandidates++] = Common::MacResManager::constructAppleDoubleName(fname);
+		candidates[numCandidates++] = fname + ".bin";
+	}
+	candidates[numCandidates++] = fname;
+
+	key.clear();
+	stamp.clear();
+	for (uint i = 0; i < numCandidates; i++) {
+		AdvancedMetaEngine::FileMap::const_iterator file = allFiles.find(candidates[i]);
+		if (file == allFiles.end()) {
+			stamp += "-;";
+			continue;
+		}
 
-	if (MD5Man.contains(hashname)) {
-		fileProps.md5 = MD5Man.getMD5(hashname);
-		fileProps.size = MD5Man.getSize(hashname);
-		return true;
+		if (!DetectionCache::addStamp(stamp, file->_value))
+			return false;
+		if (key.empty())
+			key = Common::String::format("%u:%s", md5Bytes, resFork ? "rsrc:" : "") + file->_value.getPath();
 	}
 
-	if (game.flags & ADGF_MACRESFORK) {
-		FileMapArchive fileMapArchive(allFiles);
+	return !key.empty();
+}
 
-		Common::MacResManager macResMan;
+static bool computeResForkProperties(uint md5Bytes, const AdvancedMetaEngine::FileMap &allFiles, const Common::String &fname, FileProperties &fileProps) {
+	Common::String cacheKey, cacheStamp;
+	bool cacheable = getDetectionCacheKey(allFiles, md5Bytes, true, fname, cacheKey, cacheStamp);
 
-		if (!macResMan.open(fname, fileMapArchive))
-			return false;
+	if (cacheable && DetectionCacheMan.lookup(cacheKey, cacheStamp, fileProps))
+		return true;
 
-		fileProps.md5 = macResMan.computeResForkMD5AsString(_md5Bytes);
-		fileProps.size = macResMan.getResForkDataSize();
+	FileMapArchive fileMapArchive(allFiles);
 
-		if (fileProps.size != 0) {
-			MD5Man.setMD5(hashname, fileProps.md5);
-			MD5Man.setSize(hashname, fileProps.size);
-			return true;
-		}
-	}
+	Common::MacResManager macResMan;
+
+	if (!macResMan.open(fname, fileMapArchive))
+		return false;
+
+	fileProps.md5 = macResMan.computeResForkMD5AsString(md5Bytes);
+	fileProps.size = macResMan.getResForkDataSize();
 
-	if (!allFiles.contains(fname))
+	if (fileProps.size == 0)
 		return false;
 
+	if (cacheable)
+		DetectionCacheMan.store(cacheKey, cacheStamp, fileProps);
+	return true;
+}
+
+static bool computeFileProperties(uint md5Bytes, const AdvancedMetaEngine::FileMap &allFiles, const Common::String &fname, FileProperties &fileProps) {
+	AdvancedMetaEngine::FileMap::const_iterator file = allFiles.find(fname);
+	if (file == allFiles.end())
+		return false;
+
+	Common::String cacheKey, cacheStamp;
+	bool cacheable = getDetectionCacheKey(allFiles, md5Bytes, false, fname, cacheKey, cacheStamp);
+
+	if (cacheable && DetectionCacheMan.lookup(cacheKey, cacheStamp, fileProps))
+		return true;
+
 	Common::File testFile;
 
-	if (!testFile.open(allFiles[fname]))
+	if (!testFile.open(file->_value))
 		return false;
 
-	fileProps.md5 = Common::computeStreamMD5AsString(testFile, _md5Bytes);
 	fileProps.size = testFile.size();
-	MD5Man.setMD5(hashname, fileProps.md5);
-	MD5Man.setSize(hashname, fileProps.size);
+	fileProps.md5 = Common::computeStreamMD5AsString(testFile, md5Bytes);
 
+	if (cacheable)
+		DetectionCacheMan.store(cacheKey, cacheStamp, fileProps);
 	return true;
 }
 
-bool AdvancedMetaEngine::getFilePropertiesExtern(uint md5Bytes, const FileMap &allFiles, const ADGameDescription &game, const Common::String fname, FileProperties &fileProps) const {
+bool AdvancedMetaEngineDetection::getFileProperties(const FileMap &allFiles, const ADGameDescription &game, const Common::String fname, FileProperties &fileProps) const {
 	// FIXME/TODO: We don't handle the case that a file is listed as a regular
 	// file and as one with resource fork.
+	Common::String hashname = Common::String::format("%s:%d", fname.c_str(), _md5Bytes);
 
-	if (game.flags & ADGF_MACRESFORK) {
-		FileMapArchive fileMapArchive(allFiles);
-
-		Common::MacResManager macResMan;
-
-		if (!macResMan.open(fname, fileMapArchive))
-			return false;
-
-		fileProps.md5 = macResMan.computeResForkMD5AsString(md5Bytes);
-		fileProps.size = macResMan.getResForkDataSize();
-
-		if (fileProps.size != 0)
-			return true;
+	if (MD5Man.contains(hashname)) {
+		fileProps.md5 = MD5Man.getMD5(hashname);
+		fileProps.size = MD5Man.getSize(hashname);
+		return true;
 	}
 
-	if (!allFiles.contains(fname))
+	if (!((game.flags & ADGF_MACRESFORK) && computeResForkProperties(_md5Bytes, allFiles, fname, fileProps)) &&
+		!computeFileProperties(_md5Bytes, allFiles, fname, fileProps))
 		return false;
 
-	Common::File testFile;
-
-	if (!testFile.open(allFiles[fname]))
-		return false;
+	MD5Man.setMD5(hashname, fileProps.md5);
+	MD5Man.setSize(hashname, fileProps.size);
 
-	fileProps.size = testFile.size();
-	fileProps.md5 = Common::computeStreamMD5AsString(testFile, md5Bytes);
 	return true;
 }
 
+bool AdvancedMetaEngine::getFilePropertiesExtern(uint md5Bytes, const FileMap &allFiles, const ADGameDescription &game, const Common::String fname, FileProperties &fileProps) const {
+	// FIXME/TODO: We don't handle the case that a file is listed as a regular
+	// file and as one with resource fork.
+
+	if ((game.flags & ADGF_MACRESFORK) && computeResForkProperties(md5Bytes, allFiles, fname, fileProps))
+		return true;
+
+	return computeFileProperties(md5Bytes, allFiles, fname, fileProps);
+}
+
 ADDetectedGames AdvancedMetaEngineDetection::detectGame(const Common::FSNode &parent, const FileMap &allFiles, Common::Language language, Common::Platform platform, const Common::String &extra) const {
+	Common::TraceScope trace("AdvancedMetaEngineDetection::detectGame");
+
 	FilePropertiesMap filesProps;
 	ADDetectedGames matched;
 
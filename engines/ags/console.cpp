@@ -26,6 +26,7 @@
 #include "ags/shared/ac/sprite_cache.h"
 #include "ags/shared/gfx/allegro_bitmap.h"
 #include "ags/shared/script/cc_options.h"
+#include "ags/plugins/plugin_engine.h"
 #include "image/png.h"
 
 namespace AGS {
@@ -36,6 +37,8 @@ AGSConsole::AGSConsole(AGSEngine *vm) : GUI::Debugger(), _vm(vm), _logOutputTarg
 	registerCmd("ags_set_script_dump", WRAP_METHOD(AGSConsole, Cmd_SetScriptDump));
 	registerCmd("ags_sprite_info",   WRAP_METHOD(AGSConsole, Cmd_getSpriteInfo));
 	registerCmd("ags_sprite_dump",  WRAP_METHOD(AGSConsole, Cmd_dumpSprite));
+	registerCmd("ags_sprite_cache",  WRAP_METHOD(AGSConsole, Cmd_spriteCacheStats));
+	registerCmd("ags_plugins",  WRAP_METHOD(AGSConsole, Cmd_pluginProfile));
 
 	_logOutputTarget = new LogOutputTarget();
 	_agsDebuggerOutput = _GP(DbgMgr).RegisterOutput("ScummVMLog", _logOutputTarget, AGS3::AGS::Shared::kDbgMsg_None);
@@ -245,6 +248,71 @@ bool AGSConsole::Cmd_dumpSprite(int argc, const char **argv) {
 	return true;
 }
 
+bool AGSConsole::Cmd_spriteCacheStats(int argc, const char **argv) {
+	if (argc > 2 || (argc == 2 && strcmp(argv[1], "reset"))) {
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	if (argc == 2) {
+		_GP(spriteset).ResetStats();
+		debugPrintf("Sprite cache statistics reset\n");
+		return true;
+	}
+
+	const AGS3::SpriteCache::Stats &stats = _GP(spriteset).GetStats();
+	const uint32 requests = stats.Hits + stats.Misses;
+	debugPrintf("Cache size: %u KB (%u KB locked) of %u KB\n",
+		(uint)(_GP(spriteset).GetCacheSize() / 1024),
+		(uint)(_GP(spriteset).GetLockedSize() / 1024),
+		(uint)(_GP(spriteset).GetMaxCacheSize() / 1024));
+	debugPrintf("Hits: %u, misses: %u (%u%% hit rate)\n", stats.Hits, stats.Misses,
+		requests ? (uint)((uint64)stats.Hits * 100 / requests) : 0);
+	debugPrintf("Evictions: %u, loaded: %u KB\n", stats.Evictions, (uint)(stats.LoadedBytes / 1024));
+	return true;
+}
+
+bool AGSConsole::Cmd_pluginProfile(int argc, const char **argv) {
+	if (argc == 2 && !strcmp(argv[1], "on")) {
+		AGS3::pl_set_profiling(true);
+		debugPrintf("Plugin profiling enabled\n");
+		return true;
+	} else if (argc == 2 && !strcmp(argv[1], "off")) {
+		AGS3::pl_set_profiling(false);
+		debugPrintf("Plugin profiling disabled\n");
+		return true;
+	} else if (argc == 2 && !strcmp(argv[1], "reset")) {
+		AGS3::pl_reset_profiling();
+		debugPrintf("Plugin profile reset\n");
+		return true;
+	} else if (argc != 1) {
+		debugPrintf("Usage: %s [on | off | reset]\n", argv[0]);
+		debugPrintf("Without arguments, prints the time spent in each plugin\n");
+		return true;
+	}
+
+	if (!AGS3::pl_is_profiling())
+		debugPrintf("Plugin profiling is disabled, use \"%s on\" to enable it\n", argv[0]);
+
+	AGS3::std::vector<AGS3::PluginProfileEntry> events, functions;
+	AGS3::pl_get_profile(events, functions);
+
+	debugPrintf("Event hooks:\n");
+	for (uint i = 0; i < events.size(); ++i) {
+		const AGS3::PluginProfileEntry &entry = events[i];
+		debugPrintf("  %-24s %-16s %8u calls %10u us (%u us avg)\n", entry.Plugin.GetCStr(), entry.Name.GetCStr(),
+			entry.Stats.Calls, (uint)entry.Stats.Micros, (uint)(entry.Stats.Micros / entry.Stats.Calls));
+	}
+
+	debugPrintf("Script functions:\n");
+	for (uint i = 0; i < functions.size(); ++i) {
+		const AGS3::PluginProfileEntry &entry = functions[i];
+		debugPrintf("  %-24s %-32s %8u calls %10u us (%u us avg)\n", entry.Plugin.GetCStr(), entry.Name.GetCStr(),
+			entry.Stats.Calls, (uint)entry.Stats.Micros, (uint)(entry.Stats.Micros / entry.Stats.Calls));
+	}
+	return true;
+}
+
 LogOutputTarget::LogOutputTarget() {
 }
 
@@ -441,8 +441,8 @@ bool ShouldAntiAliasText() {
 	return (_GP(game).options[OPT_ANTIALIASFONTS] != 0 || ::AGS::g_vm->_forceTextAA);
 }
 
-void wouttext_outline(Shared::Bitmap *ds, int xxp, int yyp, int usingfont, color_t text_color, const char *texx) {
-	color_t outline_color = ds->GetCompatibleColor(_GP(play).speech_text_shadow);
+// Draws the text, and its outline if the font has one
+static void draw_text_outlined(Bitmap *ds, int xxp, int yyp, int usingfont, color_t text_color, color_t outline_color, const char *texx) {
 	if (get_font_outline(usingfont) >= 0) {
 		// MACPORT FIX 9/6/5: cast
 		wouttextxy(ds, xxp, yyp, (int)get_font_outline(usingfont), outline_color, texx);
@@ -471,6 +471,94 @@ void wouttext_outline(Shared::Bitmap *ds, int xxp, int yyp, int usingfont, color
 	wouttextxy(ds, xxp, yyp, usingfont, text_color, texx);
 }
 
+// Tells whether the pixel of this color would be skipped when blitting with transparency
+static bool is_mask_color(const Bitmap *ds, color_t color) {
+	if (ds->GetColorDepth() == 32)
+		return (color & 0xFFFFFF) == (ds->GetMaskColor() & 0xFFFFFF);
+	return color == ds->GetMaskColor();
+}
+
+// Finds the rectangle containing all the non-transparent pixels of the bitmap
+static bool get_opaque_bounds(const Bitmap *bmp, Rect &bounds) {
+	const int bpp = bmp->GetBPP();
+	int left = bmp->GetWidth(), top = bmp->GetHeight(), right = -1, bottom = -1;
+	for (int y = 0; y < bmp->GetHeight(); ++y) {
+		const uint8 *row = bmp->GetScanLine(y);
+		for (int x = 0; x < bmp->GetWidth(); ++x) {
+			color_t c = (bpp == 1) ? row[x] :
+				(bpp == 2) ? ((const uint16 *)row)[x] : ((const uint32 *)row)[x];
+			if (is_mask_color(bmp, c))
+				continue;
+			left = MIN(left, x);
+			right = MAX(right, x);
+			top = MIN(top, y);
+			bottom = y;
+		}
+	}
+	if (right < 0)
+		return false;
+	bounds = Rect(left, top, right, bottom);
+	return true;
+}
+
+// Draws the text using the image from the text cache, rendering and caching
+// it first if necessary; returns false if this text may not be cached
+static bool draw_text_cached(Bitmap *ds, int xxp, int yyp, int usingfont, color_t text_color, color_t outline_color, const char *texx) {
+	const int outline = get_font_outline(usingfont);
+	if (!is_font_render_cacheable(usingfont) || (outline >= 0 && !is_font_render_cacheable(outline)))
+		return false;
+	const int depth = ds->GetColorDepth();
+	if (depth == 24 || is_mask_color(ds, text_color) ||
+	        (outline != FONT_OUTLINE_NONE && is_mask_color(ds, outline_color)))
+		return false;
+
+	TextRenderCache::Key key;
+	key.Text = texx;
+	key.Font = usingfont;
+	key.ColorDepth = depth;
+	key.Color = text_color;
+	key.OutlineColor = (outline != FONT_OUTLINE_NONE) ? outline_color : 0;
+
+	Bitmap *image = nullptr;
+	int off_x = 0, off_y = 0;
+	if (!_GP(textRenderCache).Get(key, image, off_x, off_y)) {
+		// Render on a transparent bitmap, leaving margins for the glyphs that
+		// stick out of the nominal text bounds, then crop to the visible pixels
+		const int height = getfontheight_outlined(usingfont);
+		int pad_y = height + ABS(_GP(fonts)[usingfont].Info.YOffset);
+		if (outline >= 0)
+			pad_y += ABS(_GP(fonts)[outline].Info.YOffset);
+		const int pad_x = height;
+		std::unique_ptr<Bitmap> canvas(BitmapHelper::CreateTransparentBitmap(
+			wgettextwidth_compensate(texx, usingfont) + pad_x * 2, height + pad_y * 2, depth));
+		draw_text_outlined(canvas.get(), pad_x, pad_y, usingfont, text_color, outline_color, texx);
+
+		Rect bounds;
+		if (get_opaque_bounds(canvas.get(), bounds)) {
+			image = BitmapHelper::CreateBitmap(bounds.GetWidth(), bounds.GetHeight(), depth);
+			image->Blit(canvas.get(), bounds.Left, bounds.Top, 0, 0, bounds.GetWidth(), bounds.GetHeight());
+			off_x = bounds.Left - pad_x;
+			off_y = bounds.Top - pad_y;
+		}
+		_GP(textRenderCache).Put(key, image, off_x, off_y);
+	}
+
+	if (!image)
+		return true; // nothing visible to draw
+	// The target may be a wrapped surface of a different pixel format
+	if (image->GetAllegroBitmap()->format != ds->GetAllegroBitmap()->format)
+		return false;
+	ds->Blit(image, 0, 0, xxp + off_x, yyp + off_y, image->GetWidth(), image->GetHeight(), kBitmap_Transparency);
+	return true;
+}
+
+void wouttext_outline(Shared::Bitmap *ds, int xxp, int yyp, int usingfont, color_t text_color, const char *texx) {
+	color_t outline_color = ds->GetCompatibleColor(_GP(play).speech_text_shadow);
+	if (draw_text_cached(ds, xxp, yyp, usingfont, text_color, outline_color, texx))
+		return;
+	draw_text_outlined(ds, xxp, yyp, usingfont, text_color, outline_color, texx);
+}
+
 void wouttext_aligned(Bitmap *ds, int usexp, int yy, int oriwid, int usingfont, color_t text_color, const char *text, HorAlignment align) {
 
 	if (align & kMAlignHCenter)
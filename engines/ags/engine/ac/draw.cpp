@@ -735,7 +735,27 @@ int sort_out_walk_behinds(Bitmap *sprit, int xx, int yy, int basel, Bitmap *copy
 	if ((checkPixelsFrom != nullptr) && (checkPixelsFrom->GetColorDepth() != spcoldep))
 		quit("sprite colour depth does not match background colour depth");
 
-	for (; ee < sprit->GetWidth(); ee++) {
+	// Use the walk-behind bounds precalculated on room load to find the
+	// columns where the sprite may actually be covered; only walk-behinds
+	// with a higher baseline and overlapping the sprite matter
+	int spanLeft = INT32_MAX, spanRight = INT32_MIN;
+	for (int wb = 1; wb < MAX_WALK_BEHINDS; wb++) {
+		if (_G(walkBehindLeft)[wb] > _G(walkBehindRight)[wb])
+			continue; // not present in this room
+		if (_G(croom)->walkbehind_base[wb] <= basel)
+			continue;
+		if ((_G(walkBehindRight)[wb] < xx) || (_G(walkBehindLeft)[wb] >= xx + sprit->GetWidth()) ||
+		        (_G(walkBehindBottom)[wb] < yy) || (_G(walkBehindTop)[wb] > yy + sprit->GetHeight()))
+			continue;
+		spanLeft = MIN(spanLeft, _G(walkBehindLeft)[wb] - xx);
+		spanRight = MAX(spanRight, _G(walkBehindRight)[wb] - xx);
+	}
+	if (spanLeft > spanRight)
+		return 0;
+	ee = MAX(ee, spanLeft);
+	const int endColumn = MIN(sprit->GetWidth(), spanRight + 1);
+
+	for (; ee < endColumn; ee++) {
 		if (ee + xx >= _GP(thisroom).WalkBehindMask->GetWidth())
 			break;
 
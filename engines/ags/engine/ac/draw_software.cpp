@@ -76,6 +76,18 @@ int IRSpan::mergeSpan(int tx1, int tx2) {
 	return 1;
 }
 
+// Tells whether two rows have the same dirty spans; unlike comparing the
+// whole structs this ignores the leftovers in unused span slots
+static bool IsSameDirtyRow(const IRRow &a, const IRRow &b) {
+	if (a.numSpans != b.numSpans)
+		return false;
+	for (int i = 0; i < a.numSpans; ++i) {
+		if (a.span[i].x1 != b.span[i].x1 || a.span[i].x2 != b.span[i].x2)
+			return false;
+	}
+	return true;
+}
+
 DirtyRects::DirtyRects()
 	: NumDirtyRegions(0) {
 }
@@ -348,7 +360,7 @@ void update_invalid_region(Bitmap *ds, Bitmap *src, const DirtyRects &rects, boo
 			for (int i = 0, rowsInOne = 1; i < surf_height; i += rowsInOne, rowsInOne = 1) {
 				// if there are rows with identical masks, do them all in one go
 				// TODO: what is this for? may this be done at the invalidate_rect merge step?
-				while ((i + rowsInOne < surf_height) && (memcmp(&dirtyRow[i], &dirtyRow[i + rowsInOne], sizeof(IRRow)) == 0))
+				while ((i + rowsInOne < surf_height) && IsSameDirtyRow(dirtyRow[i], dirtyRow[i + rowsInOne]))
 					rowsInOne++;
 
 				const IRRow &dirty_row = dirtyRow[i];
@@ -375,7 +387,7 @@ void update_invalid_region(Bitmap *ds, color_t fill_color, const DirtyRects &rec
 			for (int i = 0, rowsInOne = 1; i < surf_height; i += rowsInOne, rowsInOne = 1) {
 				// if there are rows with identical masks, do them all in one go
 				// TODO: what is this for? may this be done at the invalidate_rect merge step?
-				while ((i + rowsInOne < surf_height) && (memcmp(&dirtyRow[i], &dirtyRow[i + rowsInOne], sizeof(IRRow)) == 0))
+				while ((i + rowsInOne < surf_height) && IsSameDirtyRow(dirtyRow[i], dirtyRow[i + rowsInOne]))
 					rowsInOne++;
 
 				const IRRow &dirty_row = dirtyRow[i];
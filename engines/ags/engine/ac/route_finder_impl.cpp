@@ -83,28 +83,99 @@ void get_lastcpos(int &lastcx_, int &lastcy_) {
 	lastcy_ = _G(lastcy);
 }
 
+// Recently found routes; characters wandering around a room tend to ask
+// for the same routes over and over while the walkable mask stays the same
+struct CachedRoute {
+	uint32_t MaskHash = 0;
+	int FromX = -1, FromY = -1, DestX = -1, DestY = -1;
+	uint32_t LastUsed = 0; // 0 means the entry is unused
+	bool Reachable = false;
+	std::vector<int> NavPoints;
+};
+
+static const int MAXCACHEDROUTES = 8;
+
+// Hashes the contents of the current wallscreen, which is rebuilt from the
+// room mask and the blocking characters and objects before every search
+static uint32_t hash_wallscreen() {
+	uint32_t hash = 2166136261u;
+	hash = (hash ^ (uint32_t)_G(wallscreen)->GetWidth()) * 16777619u;
+	hash = (hash ^ (uint32_t)_G(wallscreen)->GetHeight()) * 16777619u;
+	for (int y = 0; y < _G(wallscreen)->GetHeight(); y++) {
+		const uint8_t *row = _G(wallscreen)->GetScanLine(y);
+		for (int x = 0; x < _G(wallscreen)->GetLineLength(); x++)
+			hash = (hash ^ row[x]) * 16777619u;
+	}
+	return hash;
+}
+
 // new routing using JPS
 static int find_route_jps(int fromx, int fromy, int destx, int desty) {
-	sync_nav_wallscreen();
+	static CachedRoute cachedRoutes[MAXCACHEDROUTES];
+	static uint32_t cacheClock = 0;
+
+	const uint32_t maskHash = hash_wallscreen();
+
+	// Look for the same route on the same mask, otherwise reuse the least
+	// recently used entry
+	CachedRoute *route = nullptr;
+	CachedRoute *oldest = &cachedRoutes[0];
+	for (int i = 0; i < MAXCACHEDROUTES; i++) {
+		CachedRoute &cached = cachedRoutes[i];
+		if (cached.LastUsed != 0 && cached.MaskHash == maskHash && cached.FromX == fromx &&
+		        cached.FromY == fromy && cached.DestX == destx && cached.DestY == desty) {
+			route = &cached;
+			break;
+		}
+		if (cached.LastUsed < oldest->LastUsed)
+			oldest = &cached;
+	}
 
-	static std::vector<int> path, cpath;
-	path.clear();
-	cpath.clear();
+	if (!route) {
+		route = oldest;
 
-	if (_GP(nav).NavigateRefined(fromx, fromy, destx, desty, path, cpath) == Navigation::NAV_UNREACHABLE)
-		return 0;
+		sync_nav_wallscreen();
 
-	_G(num_navpoints) = 0;
+		static std::vector<int> path, cpath;
+		path.clear();
+		cpath.clear();
 
-	// new behavior: cut path if too complex rather than abort with error message
-	int count = std::min<int>((int)cpath.size(), MAXNAVPOINTS);
+		route->MaskHash = maskHash;
+		route->FromX = fromx;
+		route->FromY = fromy;
+		route->DestX = destx;
+		route->DestY = desty;
+		route->NavPoints.clear();
+		route->Reachable = _GP(nav).NavigateRefined(fromx, fromy, destx, desty, path, cpath) != Navigation::NAV_UNREACHABLE;
 
-	for (int i = 0; i < count; i++) {
-		int x, y;
-		_GP(nav).UnpackSquare(cpath[i], x, y);
+		if (route->Reachable) {
+			// new behavior: cut path if too complex rather than abort with error message
+			int count = std::min<int>((int)cpath.size(), MAXNAVPOINTS);
 
-		_G(navpoints)[_G(num_navpoints)++] = MAKE_INTCOORD(x, y);
+			for (int i = 0; i < count; i++) {
+				int x, y;
+				_GP(nav).UnpackSquare(cpath[i], x, y);
+
+				route->NavPoints.push_back(MAKE_INTCOORD(x, y));
+			}
+		}
+	}
+
+	// the clock only has to order the entries, so on wrap-around simply
+	// forget the older ones
+	if (++cacheClock == 0) {
+		for (int i = 0; i < MAXCACHEDROUTES; i++)
+			cachedRoutes[i].LastUsed = 0;
+		cacheClock = 1;
 	}
+	route->LastUsed = cacheClock;
+
+	if (!route->Reachable)
+		return 0;
+
+	_G(num_navpoints) = 0;
+	for (size_t i = 0; i < route->NavPoints.size(); i++)
+		_G(navpoints)[_G(num_navpoints)++] = route->NavPoints[i];
 
 	return 1;
 }
@@ -331,6 +331,7 @@ void ScummVMRendererGraphicsDriver::RenderToBackBuffer() {
 
 void ScummVMRendererGraphicsDriver::RenderSpriteBatch(const ALSpriteBatch &batch, Shared::Bitmap *surface, int surf_offx, int surf_offy) {
 	const std::vector<ALDrawListEntry> &drawlist = batch.List;
+	const Rect clip = surface->GetClip();
 	for (size_t i = 0; i < drawlist.size(); i++) {
 		if (drawlist[i].bitmap == nullptr) {
 			if (_nullSpriteCallback)
@@ -350,6 +351,12 @@ void ScummVMRendererGraphicsDriver::RenderSpriteBatch(const ALSpriteBatch &batch
 		int drawAtX = drawlist[i].x + surf_offx;
 		int drawAtY = drawlist[i].y + surf_offy;
 
+		// Skip sprites which are entirely outside of the surface clip, as
+		// drawing them may still convert the whole sprite to the surface's
+		// color depth before the blitter clips it away
+		if (!AreRectsIntersecting(clip, RectWH(drawAtX, drawAtY, bitmap->_bmp->GetWidth(), bitmap->_bmp->GetHeight())))
+			continue;
+
 		if (bitmap->_transparency >= 255) {
 		} // fully transparent, do nothing
 		else if ((bitmap->_opaque) && (bitmap->_bmp == surface) && (bitmap->_transparency == 0)) {
@@ -44,6 +44,7 @@
 #include "ags/shared/util/string_utils.h"
 #include "ags/engine/media/audio/audio_system.h"
 #include "common/config-manager.h"
+#include "engines/util.h"
 
 namespace AGS3 {
 
@@ -359,7 +360,7 @@ void apply_config(const ConfigTree &cfg) {
 		if (ConfMan.getActiveDomain()->tryGetVal("translation", translation) && !translation.empty())
 			_GP(usetup).translation = translation;
 
-		int cache_size_kb = INIreadint(cfg, "misc", "cachemax", DEFAULTCACHESIZE_KB);
+		int cache_size_kb = INIreadint(cfg, "misc", "cachemax", getResourceMemoryBudget(DEFAULTCACHESIZE_KB * 1024) / 1024);
 		if (cache_size_kb > 0)
 			_GP(spriteset).SetMaxCacheSize((size_t)cache_size_kb * 1024);
 
@@ -69,6 +69,7 @@
 #include "ags/shared/ac/keycode.h"
 #include "ags/events.h"
 #include "ags/globals.h"
+#include "common/profiler.h"
 
 namespace AGS3 {
 
@@ -574,6 +575,7 @@ static void game_loop_check_controls(bool checkControls) {
 }
 
 static void game_loop_do_update() {
+	PROFILE_ZONE("game_loop_do_update");
 	if (_G(debug_flags) & DBG_NOUPDATE);
 	else if (_G(game_paused) == 0) update_stuff();
 }
@@ -595,7 +597,10 @@ static void game_loop_do_render_and_check_mouse(IDriverDependantBitmap *extraBit
 		int mwasatx = _G(mousex), mwasaty = _G(mousey);
 
 		// Only do this if we are not skipping a cutscene
-		render_graphics(extraBitmap, extraX, extraY);
+		{
+			PROFILE_ZONE("render_graphics");
+			render_graphics(extraBitmap, extraX, extraY);
+		}
 
 		// Check Mouse Moves Over Hotspot event
 		// TODO: move this out of render related function? find out why we remember mwasatx and mwasaty before render
@@ -701,6 +706,9 @@ void set_loop_counter(unsigned int new_counter) {
 }
 
 void UpdateGameOnce(bool checkControls, IDriverDependantBitmap *extraBitmap, int extraX, int extraY) {
+	// Each call is a frame of the game
+	PROFILE_FRAME();
+	PROFILE_ZONE("UpdateGameOnce");
 
 	int res;
 
@@ -36,25 +36,52 @@
 #include "audio/decoders/mp3.h"
 #include "audio/decoders/vorbis.h"
 #include "audio/decoders/wave.h"
+#include "audio/pcmcache.h"
 #include "ags/globals.h"
 
 namespace AGS3 {
 
-SOUNDCLIP *my_load_wave(const AssetPath &asset_name, int voll, bool loop) {
+typedef Audio::SeekableAudioStream *(*MakeAudioStreamProc)(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse);
+
+/**
+ * Opens an audio asset. Short clips, which are usually sound effects played
+ * over and over again, are only decoded the first time and then played from
+ * PCMCacheMan. Voice-over clips are played once, and are not cached.
+ */
+static Audio::AudioStream *open_audio_stream(const AssetPath &asset_name, MakeAudioStreamProc makeStream, bool cache) {
+	if (asset_name.Filter.Compare("voice") == 0)
+		cache = false;
+
+	const Common::String key = Common::String::format("%s/%s", asset_name.Filter.GetCStr(), asset_name.Name.GetCStr());
+	if (cache) {
+		Audio::AudioStream *cached = PCMCacheMan.find(key, 0);
+		if (cached)
+			return cached;
+	}
+
 	Common::SeekableReadStream *data = _GP(AssetMgr)->OpenAssetStream(asset_name.Name, asset_name.Filter);
-	if (data) {
-		Audio::AudioStream *audioStream = Audio::makeWAVStream(data, DisposeAfterUse::YES);
+	if (!data)
+		return nullptr;
+
+	Audio::SeekableAudioStream *audioStream = makeStream(data, DisposeAfterUse::YES);
+	if (!cache)
+		return audioStream;
+	return PCMCacheMan.add(key, 0, audioStream);
+}
+
+SOUNDCLIP *my_load_wave(const AssetPath &asset_name, int voll, bool loop) {
+	Audio::AudioStream *audioStream = open_audio_stream(asset_name, Audio::makeWAVStream, true);
+	if (audioStream) {
 		return new SoundClipWave<MUS_WAVE>(audioStream, voll, loop);
 	} else {
 		return nullptr;
 	}
 }
 
-SOUNDCLIP *my_load_static_mp3(const AssetPath &asset_name, int voll, bool loop) {
+static SOUNDCLIP *load_mp3(const AssetPath &asset_name, int voll, bool cache) {
 #ifdef USE_MAD
-	Common::SeekableReadStream *data = _GP(AssetMgr)->OpenAssetStream(asset_name.Name, asset_name.Filter);
-	if (data) {
-		Audio::AudioStream *audioStream = Audio::makeMP3Stream(data, DisposeAfterUse::YES);
+	Audio::AudioStream *audioStream = open_audio_stream(asset_name, Audio::makeMP3Stream, cache);
+	if (audioStream) {
 		return new SoundClipWave<MUS_MP3>(audioStream, voll, false);
 	} else {
 		return nullptr;
@@ -64,15 +91,18 @@ SOUNDCLIP *my_load_static_mp3(const AssetPath &asset_name, int voll, bool loop)
 #endif
 }
 
+SOUNDCLIP *my_load_static_mp3(const AssetPath &asset_name, int voll, bool loop) {
+	return load_mp3(asset_name, voll, true);
+}
+
 SOUNDCLIP *my_load_mp3(const AssetPath &asset_name, int voll) {
-	return my_load_static_mp3(asset_name, voll, false);
+	return load_mp3(asset_name, voll, false);
 }
 
-SOUNDCLIP *my_load_static_ogg(const AssetPath &asset_name, int voll, bool loop) {
+static SOUNDCLIP *load_ogg(const AssetPath &asset_name, int voll, bool loop, bool cache) {
 #ifdef USE_VORBIS
-	Common::SeekableReadStream *data = _GP(AssetMgr)->OpenAssetStream(asset_name.Name, asset_name.Filter);
-	if (data) {
-		Audio::AudioStream *audioStream = Audio::makeVorbisStream(data, DisposeAfterUse::YES);
+	Audio::AudioStream *audioStream = open_audio_stream(asset_name, Audio::makeVorbisStream, cache);
+	if (audioStream) {
 		return new SoundClipWave<MUS_OGG>(audioStream, voll, loop);
 	} else {
 		return nullptr;
@@ -82,8 +112,12 @@ SOUNDCLIP *my_load_static_ogg(const AssetPath &asset_name, int voll, bool loop)
 #endif
 }
 
+SOUNDCLIP *my_load_static_ogg(const AssetPath &asset_name, int voll, bool loop) {
+	return load_ogg(asset_name, voll, loop, true);
+}
+
 SOUNDCLIP *my_load_ogg(const AssetPath &asset_name, int voll) {
-	return my_load_static_ogg(asset_name, voll, false);
+	return load_ogg(asset_name, voll, false, false);
 }
 
 SOUNDCLIP *my_load_midi(const AssetPath &asset_name, bool loop) {
@@ -41,9 +41,11 @@
 #include "ags/engine/ac/statobj/ags_static_object.h"
 #include "ags/engine/ac/statobj/static_array.h"
 #include "ags/engine/ac/dynobj/cc_dynamic_object_addr_and_manager.h"
+#include "ags/plugins/plugin_engine.h"
 #include "ags/shared/util/memory.h"
 #include "ags/shared/util/string_utils.h" // linux strnicmp definition
 #include "ags/globals.h"
+#include "common/system.h"
 
 namespace AGS3 {
 
@@ -254,6 +256,28 @@ void ccInstance::AbortAndDestroy() {
 		return -1; \
 	}
 
+// Tells whether the instruction stores a boolean result in its first
+// register argument, which allows a following conditional jump to be fused
+static inline bool IsCompareInstruction(int32_t code) {
+	switch (code) {
+	case SCMD_ISEQUAL:
+	case SCMD_NOTEQUAL:
+	case SCMD_GREATER:
+	case SCMD_LESSTHAN:
+	case SCMD_GTE:
+	case SCMD_LTE:
+	case SCMD_AND:
+	case SCMD_OR:
+	case SCMD_FGREATER:
+	case SCMD_FLESSTHAN:
+	case SCMD_FGTE:
+	case SCMD_FLTE:
+		return true;
+	default:
+		return false;
+	}
+}
+
 #define ASSERT_STACK_SIZE(N) \
 	if (registers[SREG_SP].RValue - N < &stack[0]) \
 	{ \
@@ -985,6 +1009,9 @@ int ccInstance::Run(int32_t curpc) {
 
 			if (reg1.Type == kScValPluginFunction) {
 				_GP(GlobalReturnValue).Invalidate();
+				const void *pluginFn = reg1.Ptr;
+				const bool profile = pl_is_profiling();
+				const uint64 callStart = profile ? g_system->getMicros() : 0;
 				int32_t int_ret_val;
 				if (next_call_needs_object) {
 					RuntimeScriptValue obj_rval = registers[SREG_OP];
@@ -993,6 +1020,8 @@ int ccInstance::Run(int32_t curpc) {
 				} else {
 					int_ret_val = call_function((intptr_t)reg1.Ptr, nullptr, num_args_to_func, func_callstack.GetHead() + 1);
 				}
+				if (profile)
+					pl_record_function_call(pluginFn, (uint32)(g_system->getMicros() - callStart));
 
 				if (_GP(GlobalReturnValue).IsValid()) {
 					return_value = _GP(GlobalReturnValue);
@@ -1197,6 +1226,20 @@ int ccInstance::Run(int32_t curpc) {
 			return 0;
 
 		pc += codeOp.ArgCount + 1;
+
+		// The compiler follows nearly every comparison into AX with a JZ or
+		// JNZ on it, so take the jump here instead of decoding and
+		// dispatching it as a separate instruction. Jumps which carry an
+		// instance id or a fixup still go through the regular path.
+		if (IsCompareInstruction(codeOp.Instruction.Code) && arg1.IValue == SREG_AX && !write_debug_dump &&
+		        pc + 1 < codeInst->codesize && codeInst->code_fixups[pc + 1] == 0) {
+			const intptr_t nextCode = codeInst->code[pc];
+			if (nextCode == SCMD_JZ || nextCode == SCMD_JNZ) {
+				if (registers[SREG_AX].IsNull() == (nextCode == SCMD_JZ))
+					pc += (int32_t)codeInst->code[pc + 1];
+				pc += 2;
+			}
+		}
 	}
 }
 
@@ -191,6 +191,7 @@ Globals::Globals() {
 	_fonts = new std::vector<AGS::Shared::Font>();
 	_ttfRenderer = new TTFFontRenderer();
 	_wfnRenderer = new WFNFontRenderer();
+	_textRenderCache = new TextRenderCache();
 	_Lines = new SplitLines();
 
 	// game.cpp globals
@@ -423,6 +424,7 @@ Globals::~Globals() {
 	delete _fonts;
 	delete _ttfRenderer;
 	delete _wfnRenderer;
+	delete _textRenderCache;
 	delete _Lines;
 
 	// game.cpp globals
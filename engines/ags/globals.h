@@ -98,6 +98,7 @@ class EngineExports;
 class Navigation;
 class SplitLines;
 class SpriteCache;
+class TextRenderCache;
 class TTFFontRenderer;
 class WFNFontRenderer;
 
@@ -690,6 +691,7 @@ public:
 	TTFFontRenderer *_ttfRenderer;
 	WFNFontRenderer *_wfnRenderer;
 	SplitLines *_Lines;
+	TextRenderCache *_textRenderCache;
 
 	/**@}*/
 
@@ -108,6 +108,30 @@ void BITMAP::floodfill(int x, int y, int color) {
 const int SCALE_THRESHOLD = 0x100;
 #define VGA_COLOR_TRANS(x) ((x) * 255 / 63)
 
+/**
+ * Copies a row of pixels between surfaces of the same format, skipping
+ * masked pixels when requested. Pixels are read from `srcRow + xDir * xCtr`
+ * and written to `destRow + xStart + xCtr`, for xCtr in [xMin, xMax).
+ */
+template<typename PixelType>
+static void copyRow(byte *destRow, const byte *srcRow, int xStart, int xMin, int xMax, int xDir,
+                    bool skipTrans, uint32 alphaMask, uint32 transColor) {
+	PixelType *destP = (PixelType *)destRow;
+	const PixelType *srcP = (const PixelType *)srcRow;
+
+	if (!skipTrans && xDir == 1) {
+		memmove(destP + xStart + xMin, srcP + xMin, (xMax - xMin) * sizeof(PixelType));
+		return;
+	}
+
+	for (int xCtr = xMin; xCtr < xMax; ++xCtr) {
+		const PixelType srcCol = srcP[xDir * xCtr];
+		if (skipTrans && ((srcCol & alphaMask) == transColor))
+			continue;
+		destP[xStart + xCtr] = srcCol;
+	}
+}
+
 void BITMAP::draw(const BITMAP *srcBitmap, const Common::Rect &srcRect,
                   int dstX, int dstY, bool horizFlip, bool vertFlip,
                   bool skipTrans, int srcAlpha, int tintRed, int tintGreen,
@@ -161,21 +185,36 @@ void BITMAP::draw(const BITMAP *srcBitmap, const Common::Rect &srcRect,
 	int xStart = (dstRect.left < destRect.left) ? dstRect.left - destRect.left : 0;
 	int yStart = (dstRect.top < destRect.top) ? dstRect.top - destRect.top : 0;
 
-	for (int destY = yStart, yCtr = 0; yCtr < dstRect.height(); ++destY, ++yCtr) {
-		if (destY < 0 || destY >= destArea.h)
-			continue;
+	// Only iterate over the part of the source that ends up inside the clip
+	const int xMin = MAX(0, -xStart), xMax = MIN<int>(dstRect.width(), destArea.w - xStart);
+	const int yMin = MAX(0, -yStart), yMax = MIN<int>(dstRect.height(), destArea.h - yStart);
+
+	// When blitting to the same format without blending we can just copy the
+	// colors, so such rows go through a dedicated copy loop
+	const bool plainCopy = format.bytesPerPixel == 1 || (sameFormat && srcAlpha == -1);
+
+	for (int yCtr = yMin; yCtr < yMax; ++yCtr) {
+		const int destY = yStart + yCtr;
 		byte *destP = (byte *)destArea.getBasePtr(0, destY);
 		const byte *srcP = (const byte *)src.getBasePtr(
 		                       horizFlip ? srcRect.right - 1 : srcRect.left,
 		                       vertFlip ? srcRect.bottom - 1 - yCtr :
 		                       srcRect.top + yCtr);
 
-		// Loop through the pixels of the row
-		for (int destX = xStart, xCtr = 0, xCtrBpp = 0; xCtr < dstRect.width(); ++destX, ++xCtr, xCtrBpp += src.format.bytesPerPixel) {
-			if (destX < 0 || destX >= destArea.w)
-				continue;
+		if (plainCopy) {
+			if (format.bytesPerPixel == 1)
+				copyRow<uint8>(destP, srcP, xStart, xMin, xMax, xDir, skipTrans, alphaMask, transColor);
+			else if (format.bytesPerPixel == 2)
+				copyRow<uint16>(destP, srcP, xStart, xMin, xMax, xDir, skipTrans, alphaMask, transColor);
+			else
+				copyRow<uint32>(destP, srcP, xStart, xMin, xMax, xDir, skipTrans, alphaMask, transColor);
+			continue;
+		}
 
-			const byte *srcVal = srcP + xDir * xCtrBpp;
+		// Loop through the pixels of the row
+		for (int xCtr = xMin; xCtr < xMax; ++xCtr) {
+			const int destX = xStart + xCtr;
+			const byte *srcVal = srcP + xDir * xCtr * src.format.bytesPerPixel;
 			uint32 srcCol = getColor(srcVal, src.format.bytesPerPixel);
 
 			// Check if this is a transparent color we should skip
@@ -184,18 +223,6 @@ void BITMAP::draw(const BITMAP *srcBitmap, const Common::Rect &srcRect,
 
 			byte *destVal = (byte *)&destP[destX * format.bytesPerPixel];
 
-			// When blitting to the same format we can just copy the color
-			if (format.bytesPerPixel == 1) {
-				*destVal = srcCol;
-				continue;
-			} else if (sameFormat && srcAlpha == -1) {
-				if (format.bytesPerPixel == 4)
-					*(uint32 *)destVal = srcCol;
-				else
-					*(uint16 *)destVal = srcCol;
-				continue;
-			}
-
 			// We need the rgb values to do blending and/or convert between formats
 			if (src.format.bytesPerPixel == 1) {
 				const RGB &rgb = palette[srcCol];
@@ -288,20 +315,19 @@ void BITMAP::stretchDraw(const BITMAP *srcBitmap, const Common::Rect &srcRect,
 	int xStart = (dstRect.left < destRect.left) ? dstRect.left - destRect.left : 0;
 	int yStart = (dstRect.top < destRect.top) ? dstRect.top - destRect.top : 0;
 
-	for (int destY = yStart, yCtr = 0, scaleYCtr = 0; yCtr < dstRect.height();
-	        ++destY, ++yCtr, scaleYCtr += scaleY) {
-		if (destY < 0 || destY >= destArea.h)
-			continue;
+	// Only iterate over the part of the target that is inside the clip
+	const int xMin = MAX(0, -xStart), xMax = MIN<int>(dstRect.width(), destArea.w - xStart);
+	const int yMin = MAX(0, -yStart), yMax = MIN<int>(dstRect.height(), destArea.h - yStart);
+
+	for (int yCtr = yMin, scaleYCtr = yMin * scaleY; yCtr < yMax; ++yCtr, scaleYCtr += scaleY) {
+		const int destY = yStart + yCtr;
 		byte *destP = (byte *)destArea.getBasePtr(0, destY);
 		const byte *srcP = (const byte *)src.getBasePtr(
 		                       srcRect.left, srcRect.top + scaleYCtr / SCALE_THRESHOLD);
 
 		// Loop through the pixels of the row
-		for (int destX = xStart, xCtr = 0, scaleXCtr = 0; xCtr < dstRect.width();
-		        ++destX, ++xCtr, scaleXCtr += scaleX) {
-			if (destX < 0 || destX >= destArea.w)
-				continue;
-
+		for (int xCtr = xMin, scaleXCtr = xMin * scaleX; xCtr < xMax; ++xCtr, scaleXCtr += scaleX) {
+			const int destX = xStart + xCtr;
 			const byte *srcVal = srcP + scaleXCtr / SCALE_THRESHOLD * src.format.bytesPerPixel;
 			uint32 srcCol = getColor(srcVal, src.format.bytesPerPixel);
 
@@ -21,6 +21,7 @@
  */
 
 #include "ags/lib/allegro.h"
+#include "ags/lib/std/map.h"
 #include "ags/lib/std/vector.h"
 #include "ags/shared/core/platform.h"
 #include "ags/plugins/ags_plugin.h"
@@ -74,6 +75,8 @@
 #include "ags/shared/util/stream.h"
 #include "ags/shared/util/string_compat.h"
 #include "ags/shared/util/wgt2_allg.h"
+#include "common/hash-ptr.h"
+#include "common/system.h"
 
 namespace AGS3 {
 
@@ -82,6 +85,15 @@ using namespace AGS::Shared::Memory;
 using namespace AGS::Engine;
 
 const int PLUGIN_API_VERSION = 25;
+// Names of the plugin events, by their bit index
+static const char *const pl_event_names[] = {
+	"KEYPRESS", "MOUSECLICK", "POSTSCREENDRAW", "PRESCREENDRAW", "SAVEGAME", "RESTOREGAME",
+	"PREGUIDRAW", "LEAVEROOM", "ENTERROOM", "TRANSITIONIN", "TRANSITIONOUT", "FINALSCREENDRAW",
+	"TRANSLATETEXT", "SCRIPTDEBUG", "AUDIODECODE", "SPRITELOAD", "PRERENDER", "PRESAVEGAME",
+	"POSTRESTOREGAME"
+};
+#define PL_NUM_EVENTS ARRAYSIZE(pl_event_names)
+
 struct EnginePlugin {
 	char        filename[PLUGIN_FILENAME_MAX + 1];
 	AGS::Engine::Library   library;
@@ -97,6 +109,7 @@ struct EnginePlugin {
 	int (*debugHook)(const char *whichscript, int lineNumber, int reserved) = nullptr;
 	IAGSEngine  eiface;
 	bool        builtin;
+	PluginCallStats eventStats[PL_NUM_EVENTS];
 
 	EnginePlugin() {
 		filename[0] = 0;
@@ -121,6 +134,21 @@ int pluginsWantingDebugHooks = 0;
 static long pl_file_handle = -1;
 static Stream *pl_file_stream = nullptr;
 
+// Script functions registered by the plugins, with their call timings
+struct PluginFunction {
+	int PluginId = 0;
+	String Name;
+	PluginCallStats Stats;
+};
+typedef std::unordered_map<const void *, PluginFunction> PluginFunctionMap;
+
+static bool pl_profiling = false;
+
+static PluginFunctionMap &pl_functions() {
+	static PluginFunctionMap functions;
+	return functions;
+}
+
 void PluginSimulateMouseClick(int pluginButtonID) {
 	_G(pluginSimulatedClick) = pluginButtonID - 1;
 }
@@ -133,6 +161,10 @@ const char *IAGSEngine::GetEngineVersion() {
 }
 void IAGSEngine::RegisterScriptFunction(const char *name, void *addy) {
 	ccAddExternalPluginFunction(name, addy);
+
+	PluginFunction &function = pl_functions()[addy];
+	function.PluginId = pluginId;
+	function.Name = name;
 }
 const char *IAGSEngine::GetGraphicsDriverID() {
 	if (_G(gfxDriver) == nullptr)
@@ -800,6 +832,7 @@ void pl_stop_plugins() {
 		}
 	}
 	numPlugins = 0;
+	pl_functions().clear();
 }
 
 void pl_startup_plugins() {
@@ -817,7 +850,21 @@ NumberPtr pl_run_plugin_hooks(int event, NumberPtr data) {
 	int i, retval = 0;
 	for (i = 0; i < numPlugins; i++) {
 		if (plugins[i].wantHook & event) {
-			retval = plugins[i].onEvent(event, data);
+			if (pl_profiling) {
+				const uint64 start = g_system->getMicros();
+				retval = plugins[i].onEvent(event, data);
+				const uint32 micros = (uint32)(g_system->getMicros() - start);
+
+				for (uint e = 0; e < PL_NUM_EVENTS; e++) {
+					if (event & (1 << e)) {
+						plugins[i].eventStats[e].Calls++;
+						plugins[i].eventStats[e].Micros += micros;
+						break;
+					}
+				}
+			} else {
+				retval = plugins[i].onEvent(event, data);
+			}
 			if (retval)
 				return retval;
 		}
@@ -826,6 +873,59 @@ NumberPtr pl_run_plugin_hooks(int event, NumberPtr data) {
 	return 0;
 }
 
+void pl_set_profiling(bool enabled) {
+	pl_profiling = enabled;
+}
+
+bool pl_is_profiling() {
+	return pl_profiling;
+}
+
+void pl_reset_profiling() {
+	for (int i = 0; i < MAXPLUGINS; i++) {
+		for (uint e = 0; e < PL_NUM_EVENTS; e++)
+			plugins[i].eventStats[e] = PluginCallStats();
+	}
+	for (PluginFunctionMap::iterator it = pl_functions().begin(); it != pl_functions().end(); ++it)
+		it->_value.Stats = PluginCallStats();
+}
+
+void pl_record_function_call(const void *fn, uint32 micros) {
+	PluginFunctionMap::iterator it = pl_functions().find(fn);
+	if (it == pl_functions().end())
+		return;
+	it->_value.Stats.Calls++;
+	it->_value.Stats.Micros += micros;
+}
+
+void pl_get_profile(std::vector<PluginProfileEntry> &events, std::vector<PluginProfileEntry> &functions) {
+	events.clear();
+	functions.clear();
+
+	for (int i = 0; i < numPlugins; i++) {
+		for (uint e = 0; e < PL_NUM_EVENTS; e++) {
+			if (plugins[i].eventStats[e].Calls == 0)
+				continue;
+			PluginProfileEntry entry;
+			entry.Plugin = plugins[i].filename;
+			entry.Name = pl_event_names[e];
+			entry.Stats = plugins[i].eventStats[e];
+			events.push_back(entry);
+		}
+	}
+
+	for (PluginFunctionMap::const_iterator it = pl_functions().begin(); it != pl_functions().end(); ++it) {
+		const PluginFunction &function = it->_value;
+		if (function.Stats.Calls == 0 || function.PluginId < 0 || function.PluginId >= numPlugins)
+			continue;
+		PluginProfileEntry entry;
+		entry.Plugin = plugins[function.PluginId].filename;
+		entry.Name = function.Name;
+		entry.Stats = function.Stats;
+		functions.push_back(entry);
+	}
+}
+
 int pl_run_plugin_debug_hooks(const char *scriptfile, int linenum) {
 	int i, retval = 0;
 	for (i = 0; i < numPlugins; i++) {
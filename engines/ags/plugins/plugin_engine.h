@@ -32,6 +32,7 @@
 #include "ags/lib/std/vector.h"
 #include "ags/engine/game/game_init.h"
 #include "ags/shared/game/plugin_info.h"
+#include "ags/shared/util/string.h"
 
 namespace AGS3 {
 
@@ -61,6 +62,29 @@ bool pl_any_want_hook(int event);
 void pl_set_file_handle(long data, AGS::Shared::Stream *stream);
 void pl_clear_file_handle();
 
+// Number of calls and total time spent in a plugin callback
+struct PluginCallStats {
+	uint32 Calls = 0u;
+	uint64 Micros = 0u;
+};
+
+// Timing of a single plugin event hook or script function
+struct PluginProfileEntry {
+	Shared::String Plugin;
+	Shared::String Name;
+	PluginCallStats Stats;
+};
+
+// Enables or disables timing of the plugin event hooks and script functions
+void pl_set_profiling(bool enabled);
+bool pl_is_profiling();
+// Forgets all the collected plugin timings
+void pl_reset_profiling();
+// Records a call to a script function registered by a plugin
+void pl_record_function_call(const void *fn, uint32 micros);
+// Gathers the timings of the event hooks and script functions which were called
+void pl_get_profile(std::vector<PluginProfileEntry> &events, std::vector<PluginProfileEntry> &functions);
+
 } // namespace AGS3
 
 #endif
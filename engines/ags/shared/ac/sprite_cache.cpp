@@ -129,6 +129,11 @@ void SpriteCache::Init() {
 	_maxCacheSize = (size_t)DEFAULTCACHESIZE_KB * 1024;
 	_liststart = -1;
 	_listend = -1;
+	ResetStats();
+}
+
+void SpriteCache::ResetStats() {
+	_stats = Stats();
 }
 
 void SpriteCache::Reset() {
@@ -255,8 +260,14 @@ Bitmap *SpriteCache::operator [] (sprkey_t index) {
 		return _spriteData[index].Image;
 
 	// Sprite exists in file but is not in mem, load it
-	if ((_spriteData[index].Image == nullptr) && _spriteData[index].IsAssetSprite())
-		LoadSprite(index);
+	if (_spriteData[index].IsAssetSprite()) {
+		if (_spriteData[index].Image == nullptr) {
+			_stats.Misses++;
+			_stats.LoadedBytes += LoadSprite(index);
+		} else {
+			_stats.Hits++;
+		}
+	}
 
 	// Locked sprite that shouldn't be put into MRU list
 	if (_spriteData[index].IsLocked())
@@ -303,6 +314,7 @@ void SpriteCache::DisposeOldest() {
 			quitprintf("SpriteCache::DisposeOldest: attempted to remove sprite %d that was added externally or does not exist", sprnum);
 		}
 		_cacheSize -= _spriteData[sprnum].Size;
+		_stats.Evictions++;
 
 		delete _spriteData[sprnum].Image;
 		_spriteData[sprnum].Image = nullptr;
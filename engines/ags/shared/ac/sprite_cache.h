@@ -165,6 +165,14 @@ private:
 
 class SpriteCache {
 public:
+	// Usage counters of the asset sprites, reported by the debug console
+	struct Stats {
+		uint32_t Hits = 0u;       // requests served from the cache
+		uint32_t Misses = 0u;     // requests that had to load the sprite
+		uint32_t Evictions = 0u;  // sprites disposed to free cache space
+		size_t   LoadedBytes = 0u; // total size of the loaded sprites
+	};
+
 	static const sprkey_t MIN_SPRITE_INDEX = 1; // 0 is reserved for "empty sprite"
 	static const sprkey_t MAX_SPRITE_INDEX = INT32_MAX - 1;
 	static const size_t   MAX_SPRITE_SLOTS = INT32_MAX;
@@ -219,6 +227,12 @@ public:
 	void        SubstituteBitmap(sprkey_t index, Shared::Bitmap *);
 	// Sets max cache size in bytes
 	void        SetMaxCacheSize(size_t size);
+	// Returns the cache usage counters
+	const Stats &GetStats() const {
+		return _stats;
+	}
+	// Resets the cache usage counters
+	void        ResetStats();
 
 	// Loads (if it's not in cache yet) and returns bitmap by the sprite index
 	Shared::Bitmap *operator[] (sprkey_t index);
@@ -265,6 +279,7 @@ private:
 	size_t _maxCacheSize;  // cache size limit
 	size_t _lockedSize;    // size in bytes of currently locked images
 	size_t _cacheSize;     // size in bytes of currently cached images
+	Stats _stats;          // cache usage counters
 
 	// MRU list: the way to track which sprites were used recently.
 	// When clearing up space for new sprites, cache first deletes the sprites
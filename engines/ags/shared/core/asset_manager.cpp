@@ -20,13 +20,16 @@
  *
  */
 
+#include "common/file.h"
 #include "common/memstream.h"
+#include "common/substream.h"
 #include "ags/lib/std/algorithm.h"
 #include "ags/lib/std/utility.h"
 #include "ags/shared/core/platform.h"
 #include "ags/shared/core/asset_manager.h"
 #include "ags/shared/util/multi_file_lib.h"
 #include "ags/shared/util/path.h"
+#include "ags/shared/util/stdio_compat.h"
 #include "ags/shared/util/string_utils.h" // cbuf_to_string_and_free
 
 namespace AGS3 {
@@ -192,6 +195,12 @@ AssetError AssetManager::RegisterAssetLib(const String &path, AssetLibEx *&out_l
 		lib->BaseDir = Path::GetDirectoryPath(lib->BasePath);
 		lib->BaseFileName = Path::GetFilename(lib->BasePath);
 		lib->LibFileNames[0] = lib->BaseFileName;
+
+		// Index assets by name; the first entry wins, same as the linear search did
+		for (size_t i = 0; i < lib->AssetInfos.size(); ++i) {
+			if (!lib->AssetIndex.contains(lib->AssetInfos[i].FileName))
+				lib->AssetIndex[lib->AssetInfos[i].FileName] = i;
+		}
 	}
 
 	out_lib = lib.release();
@@ -218,20 +227,15 @@ bool AssetManager::GetAsset(const String &asset_name, const String &filter, bool
 	return false;
 }
 
-bool AssetManager::GetAssetFromLib(const AssetLibInfo *lib, const String &asset_name,
+bool AssetManager::GetAssetFromLib(const AssetLibEx *lib, const String &asset_name,
                                    AssetLocation *loc, FileOpenMode open_mode, FileWorkMode work_mode) const {
 	if (open_mode != Shared::kFile_Open || work_mode != Shared::kFile_Read)
 		return false; // creating/writing is allowed only for common files on disk
 
-	const AssetInfo *asset = nullptr;
-	for (const auto &a : lib->AssetInfos) {
-		if (a.FileName.CompareNoCase(asset_name) == 0) {
-			asset = &a;
-			break;
-		}
-	}
-	if (asset == nullptr)
+	auto it = lib->AssetIndex.find(asset_name);
+	if (it == lib->AssetIndex.end())
 		return false;
+	const AssetInfo *asset = &lib->AssetInfos[it->_value];
 
 	String libfile = File::FindFileCI(lib->BaseDir, lib->LibFileNames[asset->LibUid]);
 	if (libfile.IsEmpty())
@@ -281,6 +285,20 @@ Common::SeekableReadStream *AssetManager::OpenAssetStream(const String &asset_na
 }
 
 Common::SeekableReadStream *AssetManager::OpenAssetStream(const String &asset_name, const String &filter) const {
+	AssetLocation loc;
+	if (!GetAsset(asset_name, filter, false, &loc, kFile_Open, kFile_Read))
+		return nullptr;
+
+	// Read straight from the file within the asset's bounds, rather than
+	// copying the whole asset into memory first
+	Common::FSNode node = getFSNode(loc.FileName.GetCStr());
+	Common::File *f = new Common::File();
+	if (node.exists() && f->open(node)) {
+		return new Common::SeekableSubReadStream(f, loc.Offset, loc.Offset + loc.Size,
+			DisposeAfterUse::YES);
+	}
+	delete f;
+
 	soff_t assetSize;
 	Stream *stream = OpenAsset(asset_name, filter, &assetSize);
 	if (!stream)
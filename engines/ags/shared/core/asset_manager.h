@@ -45,6 +45,7 @@
 #include "ags/lib/std/memory.h"
 #include "ags/shared/core/asset.h"
 #include "ags/shared/util/file.h" // TODO: extract filestream mode constants or introduce generic ones
+#include "ags/shared/util/string_types.h"
 
 namespace AGS3 {
 namespace AGS {
@@ -125,6 +126,8 @@ public:
 private:
 	struct AssetLibEx : AssetLibInfo {
 		std::vector<String> Filters; // asset filters this library is matching to
+		// case-insensitive lookup of asset name to its index in AssetInfos
+		std::unordered_map<String, size_t, IgnoreCase_Hash, IgnoreCase_EqualTo> AssetIndex;
 	};
 
 	// Loads library and registers its contents into the cache
@@ -132,7 +135,7 @@ private:
 
 	// Tries to find asset in known locations, tests if it's possible to open, and fills in AssetLocation
 	bool        GetAsset(const String &asset_name, const String &filter, bool dir_only, AssetLocation *loc, Shared::FileOpenMode open_mode, Shared::FileWorkMode work_mode) const;
-	bool        GetAssetFromLib(const AssetLibInfo *lib, const String &asset_name, AssetLocation *loc, Shared::FileOpenMode open_mode, Shared::FileWorkMode work_mode) const;
+	bool        GetAssetFromLib(const AssetLibEx *lib, const String &asset_name, AssetLocation *loc, Shared::FileOpenMode open_mode, Shared::FileWorkMode work_mode) const;
 	bool        GetAssetFromDir(const AssetLibInfo *lib, const String &asset_name, AssetLocation *loc, Shared::FileOpenMode open_mode, Shared::FileWorkMode work_mode) const;
 
 	std::vector<AssetLibEx *> _libs;
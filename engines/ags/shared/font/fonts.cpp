@@ -37,6 +37,7 @@ namespace AGS3 {
 
 // Project-dependent implementation
 extern int wgettextwidth_compensate(const char *tex, int font);
+extern bool ShouldAntiAliasText();
 
 #define STD_BUFFER_SIZE 3000
 
@@ -93,6 +94,7 @@ IAGSFontRenderer *font_replace_renderer(size_t fontNumber, IAGSFontRenderer *ren
 	IAGSFontRenderer *oldRender = _GP(fonts)[fontNumber].Renderer;
 	_GP(fonts)[fontNumber].Renderer = renderer;
 	_GP(fonts)[fontNumber].Renderer2 = nullptr;
+	_GP(textRenderCache).InvalidateFont(fontNumber);
 	return oldRender;
 }
 
@@ -142,6 +144,7 @@ void set_font_outline(size_t font_number, int outline_type) {
 	if (font_number >= _GP(fonts).size())
 		return;
 	_GP(fonts)[font_number].Info.Outline = outline_type;
+	_GP(textRenderCache).InvalidateFont(font_number);
 }
 
 int getfontheight(size_t fontNumber) {
@@ -310,8 +313,10 @@ void wouttextxy(Shared::Bitmap *ds, int xxx, int yyy, size_t fontNumber, color_t
 }
 
 void set_fontinfo(size_t fontNumber, const FontInfo &finfo) {
-	if (fontNumber < _GP(fonts).size() && _GP(fonts)[fontNumber].Renderer)
+	if (fontNumber < _GP(fonts).size() && _GP(fonts)[fontNumber].Renderer) {
 		_GP(fonts)[fontNumber].Info = finfo;
+		_GP(textRenderCache).InvalidateFont(fontNumber);
+	}
 }
 
 // Loads a font from disk
@@ -359,6 +364,7 @@ void wfreefont(size_t fontNumber) {
 		_GP(fonts)[fontNumber].Renderer->FreeMemory(fontNumber);
 
 	_GP(fonts)[fontNumber].Renderer = nullptr;
+	_GP(textRenderCache).InvalidateFont(fontNumber);
 }
 
 void free_all_fonts() {
@@ -367,6 +373,123 @@ void free_all_fonts() {
 			_GP(fonts)[i].Renderer->FreeMemory(i);
 	}
 	_GP(fonts).clear();
+	_GP(textRenderCache).Clear();
+}
+
+bool is_font_render_cacheable(size_t fontNumber) {
+	if (fontNumber >= _GP(fonts).size())
+		return false;
+	const IAGSFontRenderer *renderer = _GP(fonts)[fontNumber].Renderer;
+	if (renderer == &_GP(wfnRenderer))
+		return true;
+	// Antialiased text is blended with whatever is below it
+	return renderer == &_GP(ttfRenderer) && !ShouldAntiAliasText();
+}
+
+//=============================================================================
+// TextRenderCache
+//=============================================================================
+
+// Default limit for the total size of the cached text images
+static const size_t DEFAULT_TEXT_CACHE_SIZE = 2 * 1024 * 1024;
+
+TextRenderCache::TextRenderCache()
+	: _maxSize(DEFAULT_TEXT_CACHE_SIZE) {
+}
+
+TextRenderCache::~TextRenderCache() {
+	Clear();
+}
+
+uint TextRenderCache::KeyHash::operator()(const Key &key) const {
+	uint hash = ::Common::hashit(key.Text.GetCStr());
+	hash = hash * 31 + key.Font;
+	hash = hash * 31 + key.ColorDepth;
+	hash = hash * 31 + key.Color;
+	return hash * 31 + key.OutlineColor;
+}
+
+bool TextRenderCache::KeyEqual::operator()(const Key &x, const Key &y) const {
+	return x.Font == y.Font && x.ColorDepth == y.ColorDepth && x.Color == y.Color &&
+		x.OutlineColor == y.OutlineColor && x.Text == y.Text;
+}
+
+size_t TextRenderCache::GetImageSize(const Bitmap *image) {
+	return image ? image->GetWidth() * image->GetHeight() * image->GetBPP() : 0;
+}
+
+bool TextRenderCache::Get(const Key &key, Bitmap *&image, int &off_x, int &off_y) {
+	EntryMap::iterator it = _entries.find(key);
+	if (it == _entries.end())
+		return false;
+	it->_value.LastUse = ++_useCounter;
+	image = it->_value.Image;
+	off_x = it->_value.OffX;
+	off_y = it->_value.OffY;
+	return true;
+}
+
+void TextRenderCache::Put(const Key &key, Bitmap *image, int off_x, int off_y) {
+	const size_t image_size = GetImageSize(image);
+	if (image_size > _maxSize) {
+		delete image;
+		return;
+	}
+
+	EntryMap::iterator it = _entries.find(key);
+	if (it != _entries.end()) {
+		FreeEntry(it->_value);
+		_entries.erase(it);
+	}
+	Shrink(_maxSize - image_size);
+
+	Entry &entry = _entries[key];
+	entry.Image = image;
+	entry.OffX = off_x;
+	entry.OffY = off_y;
+	entry.LastUse = ++_useCounter;
+	_size += image_size;
+}
+
+void TextRenderCache::InvalidateFont(int font) {
+	for (EntryMap::iterator it = _entries.begin(); it != _entries.end(); ++it) {
+		// outlined text also depends on the outline font
+		if (it->_key.Font == font || get_font_outline(it->_key.Font) == font) {
+			FreeEntry(it->_value);
+			_entries.erase(it);
+		}
+	}
+}
+
+void TextRenderCache::Clear() {
+	for (EntryMap::iterator it = _entries.begin(); it != _entries.end(); ++it)
+		FreeEntry(it->_value);
+	_entries.clear();
+	_size = 0;
+}
+
+void TextRenderCache::SetMaxSize(size_t max_bytes) {
+	_maxSize = max_bytes;
+	Shrink(_maxSize);
+}
+
+void TextRenderCache::FreeEntry(Entry &entry) {
+	_size -= GetImageSize(entry.Image);
+	delete entry.Image;
+	entry.Image = nullptr;
+}
+
+void TextRenderCache::Shrink(size_t max_bytes) {
+	// Dispose least recently used images until the cache fits into the limit
+	while (_size > max_bytes && !_entries.empty()) {
+		EntryMap::iterator oldest = _entries.begin();
+		for (EntryMap::iterator it = _entries.begin(); it != _entries.end(); ++it) {
+			if (it->_value.LastUse < oldest->_value.LastUse)
+				oldest = it;
+		}
+		FreeEntry(oldest->_value);
+		_entries.erase(oldest);
+	}
 }
 
 } // namespace AGS3
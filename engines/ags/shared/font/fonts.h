@@ -23,6 +23,7 @@
 #ifndef AGS_SHARED_FONT_FONTS_H
 #define AGS_SHARED_FONT_FONTS_H
 
+#include "common/hashmap.h"
 #include "ags/lib/std/vector.h"
 #include "ags/shared/core/types.h"
 #include "ags/shared/util/string.h"
@@ -139,6 +140,66 @@ private:
 // returns number of lines, or 0 if text cannot be split well to fit in this width
 size_t split_lines(const char *texx, SplitLines &lines, int width, int fontNumber, size_t max_lines = -1);
 
+// TextRenderCache keeps recently drawn lines of text as bitmaps, so that
+// unchanged labels, buttons and speech are blitted instead of going through
+// the font renderer (several times over, for outlined text) on each redraw.
+class TextRenderCache {
+public:
+	struct Key {
+		Shared::String Text;
+		int Font = 0;
+		int ColorDepth = 0;
+		color_t Color = 0;
+		color_t OutlineColor = 0;
+	};
+
+	TextRenderCache();
+	~TextRenderCache();
+
+	// Finds the text image; returns false if it is not cached. The image may
+	// be null if the text did not produce any visible pixels.
+	bool Get(const Key &key, Shared::Bitmap *&image, int &off_x, int &off_y);
+	// Stores the text image at the given offset from the text position;
+	// the cache takes ownership of the bitmap
+	void Put(const Key &key, Shared::Bitmap *image, int off_x, int off_y);
+	// Removes all images made with the given font
+	void InvalidateFont(int font);
+	void Clear();
+
+	void SetMaxSize(size_t max_bytes);
+	size_t GetSize() const {
+		return _size;
+	}
+
+private:
+	struct Entry {
+		Shared::Bitmap *Image = nullptr;
+		int OffX = 0;
+		int OffY = 0;
+		uint32_t LastUse = 0;
+	};
+	struct KeyHash {
+		uint operator()(const Key &key) const;
+	};
+	struct KeyEqual {
+		bool operator()(const Key &x, const Key &y) const;
+	};
+	typedef Common::HashMap<Key, Entry, KeyHash, KeyEqual> EntryMap;
+
+	static size_t GetImageSize(const Shared::Bitmap *image);
+	void FreeEntry(Entry &entry);
+	void Shrink(size_t max_bytes);
+
+	EntryMap _entries;
+	size_t _size = 0;
+	size_t _maxSize;
+	uint32_t _useCounter = 0;
+};
+
+// Tells whether the text drawn with this font may be cached as a bitmap:
+// this is only true for the built-in renderers that draw solid pixels
+bool is_font_render_cacheable(size_t fontNumber);
+
 } // namespace AGS3
 
 #endif
@@ -141,30 +141,16 @@ void ScreenEffects::readVqa(Common::SeekableReadStream *stream) {
 #endif // BLADERUNNER_ORIGINAL_BUGS
 }
 
-//TODO:
-//bool ScreenEffects::isAffectingArea(int x, int y, int width, int height, int z) {
-//	int xx = x >> 1;
-//	int yy = y >> 1;
-//	if (_entries.empty()) {
-//		return false;
-//	}
-//
-//	for(int i = 0; i < _entries.size(); ++i) {
-//		Entry &entry = _entries[i];
-//		if (entry.z < z) {
-//			if (entry.width < (width >> 1) + xx) {
-//				if (entry.width + entry.x > xx) {
-//					if (entry.height < (height >> 1) + yy) {
-//						if (entry.height + entry.y > yy) {
-//							return true;
-//						}
-//					}
-//				}
-//			}
-//		}
-//	}
-//	return false;
-//}
+bool ScreenEffects::isAffectingArea(const Common::Rect &rect) const {
+	// Entries are stored at half of the screen resolution
+	for (Common::Array<const Entry>::iterator entry = _entries.begin(); entry != _entries.end(); ++entry) {
+		Common::Rect entryRect(2 * entry->x, 2 * entry->y, 2 * (entry->x + entry->width), 2 * (entry->y + entry->height));
+		if (entryRect.intersects(rect)) {
+			return true;
+		}
+	}
+	return false;
+}
 
 void ScreenEffects::getColor(Color256 *outColor, uint16 x, uint16 y, uint16 z) const {
 	Color256 color = { 0, 0, 0 };
@@ -26,6 +26,7 @@
 #include "bladerunner/color.h"
 
 #include "common/array.h"
+#include "common/rect.h"
 
 namespace Common {
 class ReadStream;
@@ -64,13 +65,12 @@ public:
 	~ScreenEffects();
 
 	void readVqa(Common::SeekableReadStream *stream);
+	bool isAffectingArea(const Common::Rect &rect) const;
 	void getColor(Color256 *outColor, uint16 x, uint16 y, uint16 z) const;
 #if BLADERUNNER_ORIGINAL_BUGS
 #else
 	void toggleEntry(int effectId, bool skip); // added method to allow skipping specified effects
 #endif // BLADERUNNER_ORIGINAL_BUGS
-	//TODO
-	//bool isAffectingArea(int x, int y, int width, int height, int unk);
 };
 
 } // End of namespace BladeRunner
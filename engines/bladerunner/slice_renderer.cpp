@@ -48,6 +48,7 @@ SliceRenderer::SliceRenderer(BladeRunnerEngine *vm) {
 	_scale     = 0.0f;
 
 	_screenEffects = nullptr;
+	_screenEffectsVisible = false;
 	_view          = nullptr;
 	_lights        = nullptr;
 	_setEffects    = nullptr;
@@ -392,6 +393,12 @@ void SliceRenderer::drawInWorld(int animationId, int animationFrame, Vector3 pos
 		_mvpMatrix
 	);
 
+	// Most actors are nowhere near a screen effect, test the whole actor
+	// once instead of every span. Slices can reach one pixel past the rectangle.
+	Common::Rect effectsRect = _screenRectangle;
+	effectsRect.grow(1);
+	_screenEffectsVisible = _screenEffects->isAffectingArea(effectsRect);
+
 	SliceRendererLights sliceRendererLights = SliceRendererLights(_lights);
 
 	_lights->setupFrame(_view->_frame);
@@ -545,6 +552,11 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 
 	SliceAnimations::Palette &palette = _vm->_sliceAnimations->getPalette(_framePaletteIndex);
 
+	// All the pixels of a slice are on the same line of the surface
+	byte *linePtr = (byte *)surface.getBasePtr(0, CLIP(y, 0, surface.h - 1));
+	const int bytesPerPixel = surface.format.bytesPerPixel;
+	const int xMax = surface.w - 1;
+
 	byte *p = (byte *)_sliceFramePtr + 0x20 + 4 * slice;
 
 	uint32 polyOffset = READ_LE_UINT32(p);
@@ -573,25 +585,36 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 				int vertexZ = (_m21lookup[p[0]] + _m22lookup[p[1]] + _m23) / 64;
 
 				if (vertexZ >= 0 && vertexZ < 65536) {
-					uint32 outColor = palette.value[p[2]];
-					if (advanced) {
-						Color256 aescColor = { 0, 0, 0 };
-						_screenEffects->getColor(&aescColor, vertexX, y, vertexZ);
-
-						Color256 color = palette.color[p[2]];
-						color.r = ((int)(_setEffectColor.r + _lightsColor.r * color.r) / 65536) + aescColor.r;
-						color.g = ((int)(_setEffectColor.g + _lightsColor.g * color.g) / 65536) + aescColor.g;
-						color.b = ((int)(_setEffectColor.b + _lightsColor.b * color.b) / 65536) + aescColor.b;
-						// We need to convert from 5 bits per channel (r,g,b) to 8 bits
-						outColor = _pixelFormat.RGBToColor(Color::get8BitColorFrom5Bit(color.r), Color::get8BitColorFrom5Bit(color.g), Color::get8BitColorFrom5Bit(color.b));
+					// Skip the hidden pixels before computing the color,
+					// spans hidden by the background or by other actors are common
+					int x = previousVertexX;
+					while (x != vertexX && vertexZ >= zbufferLine[x]) {
+						++x;
 					}
 
-					for (int x = previousVertexX; x != vertexX; ++x) {
-						if (vertexZ < zbufferLine[x]) {
-							zbufferLine[x] = (uint16)vertexZ;
+					if (x != vertexX) {
+						uint32 outColor = palette.value[p[2]];
+						if (advanced) {
+							Color256 aescColor = { 0, 0, 0 };
+							if (_screenEffectsVisible) {
+								_screenEffects->getColor(&aescColor, vertexX, y, vertexZ);
+							}
+
+							Color256 color = palette.color[p[2]];
+							color.r = ((int)(_setEffectColor.r + _lightsColor.r * color.r) / 65536) + aescColor.r;
+							color.g = ((int)(_setEffectColor.g + _lightsColor.g * color.g) / 65536) + aescColor.g;
+							color.b = ((int)(_setEffectColor.b + _lightsColor.b * color.b) / 65536) + aescColor.b;
+							// We need to convert from 5 bits per channel (r,g,b) to 8 bits
+							outColor = _pixelFormat.RGBToColor(Color::get8BitColorFrom5Bit(color.r), Color::get8BitColorFrom5Bit(color.g), Color::get8BitColorFrom5Bit(color.b));
+						}
+
+						for (; x != vertexX; ++x) {
+							if (vertexZ < zbufferLine[x]) {
+								zbufferLine[x] = (uint16)vertexZ;
 
-							void *dstPtr = surface.getBasePtr(CLIP(x, 0, surface.w - 1), CLIP(y, 0, surface.h - 1));
-							drawPixel(surface, dstPtr, outColor);
+								void *dstPtr = linePtr + MIN(x, xMax) * bytesPerPixel;
+								drawPixel(surface, dstPtr, outColor);
+							}
 						}
 					}
 				}
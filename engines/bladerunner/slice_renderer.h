@@ -88,6 +88,7 @@ class SliceRenderer {
 
 	Color _setEffectColor;
 	Color _lightsColor;
+	bool  _screenEffectsVisible;
 
 	Graphics::PixelFormat _pixelFormat;
 
@@ -142,6 +142,7 @@ VQADecoder::VQADecoder() {
 VQADecoder::~VQADecoder() {
 	for (uint i = _codebooks.size(); i != 0; --i) {
 		delete[] _codebooks[i - 1].data;
+		delete[] _codebooks[i - 1].colors;
 	}
 	delete _audioTrack;
 	delete _videoTrack;
@@ -468,6 +469,7 @@ bool VQADecoder::readCINF(Common::SeekableReadStream *s, uint32 size) {
 		_codebooks[codebookCount - i].frame = s->readUint16LE();
 		_codebooks[codebookCount - i].size  = s->readUint32LE();
 		_codebooks[codebookCount - i].data  = nullptr;
+		_codebooks[codebookCount - i].colors = nullptr;
 
 		// debug("Codebook %2u: %4d %8d", codebookCount - i, _codebooks[codebookCount - i].frame, _codebooks[codebookCount - i].size);
 
@@ -608,6 +610,7 @@ VQADecoder::VQAVideoTrack::VQAVideoTrack(VQADecoder *vqaDecoder) {
 	_maxZBUFChunkSize = vqaDecoder->_maxZBUFChunkSize;
 
 	_codebook = nullptr;
+	_codebookColors = nullptr;
 	_cbfz     = nullptr;
 
 	_vpointerSize = 0;
@@ -829,16 +832,41 @@ bool VQADecoder::VQAVideoTrack::readVPTR(Common::SeekableReadStream *s, uint32 s
 	return true;
 }
 
+const uint32 *VQADecoder::VQAVideoTrack::getCodebookColors(CodebookInfo &codebookInfo, const Graphics::PixelFormat &format) {
+	if (format != _codebookColorsFormat) {
+		// The surface format changed, all the converted codebooks are stale
+		for (uint i = 0; i < _vqaDecoder->_codebooks.size(); ++i) {
+			delete[] _vqaDecoder->_codebooks[i].colors;
+			_vqaDecoder->_codebooks[i].colors = nullptr;
+		}
+		_codebookColorsFormat = format;
+	}
+
+	if (!codebookInfo.colors) {
+		// Convert the whole codebook once instead of each block every time it is drawn
+		uint32 colorCount = _maxBlocks * _blockW * _blockH;
+		codebookInfo.colors = new uint32[colorCount];
+
+		uint8 a, r, g, b;
+		for (uint32 i = 0; i < colorCount; ++i) {
+			getGameDataColor(READ_LE_UINT16(codebookInfo.data + 2 * i), a, r, g, b);
+			codebookInfo.colors[i] = format.RGBToColor(r, g, b);
+		}
+	}
+
+	return codebookInfo.colors;
+}
+
 void VQADecoder::VQAVideoTrack::VPTRWriteBlock(Graphics::Surface *surface, unsigned int dstBlock, unsigned int srcBlock, int count, bool alpha) {
 	const uint8 *const block_src = &_codebook[2 * srcBlock * _blockW * _blockH];
+	const uint32 *const block_colors = &_codebookColors[srcBlock * _blockW * _blockH];
 
 	uint16 blocks_per_line = _width / _blockW;
+	const int bytesPerPixel = surface->format.bytesPerPixel;
 
 	uint32 intermDiv = 0;
 	uint32 dst_x = 0;
 	uint32 dst_y = 0;
-	uint16 vqaColor = 0;
-	uint8 a, r, g, b;
 
 	for (uint i = count; i != 0; --i) {
 		intermDiv = (dstBlock + count - i) / blocks_per_line;
@@ -846,21 +874,21 @@ void VQADecoder::VQAVideoTrack::VPTRWriteBlock(Graphics::Surface *surface, unsig
 		dst_y = intermDiv * _blockH + _offsetY;
 
 		const uint8 *src_p = block_src;
+		const uint32 *color_p = block_colors;
 
-		for (uint y = _blockH; y != 0; --y) {
-			for (uint x = _blockW; x != 0; --x) {
-				vqaColor = READ_LE_UINT16(src_p);
-				src_p += 2;
-
-				getGameDataColor(vqaColor, a, r, g, b);
+		for (uint y = 0; y != _blockH; ++y) {
+			// clip is too slow and it is not needed
+			byte *dstPtr = (byte *)surface->getBasePtr(dst_x, dst_y + y);
 
-				if (!(alpha && a)) {
-					// clip is too slow and it is not needed
-					// void* dstPtr = surface->getBasePtr(CLIP(dst_x + x, (uint32)0, (uint32)(surface->w - 1)), CLIP(dst_y + y, (uint32)0, (uint32)(surface->h - 1)));
-					void* dstPtr = surface->getBasePtr(dst_x + _blockW - x, dst_y + _blockH - y);
-					// Ignore the alpha in the output as it is inversed in the input
-					drawPixel(*surface, dstPtr, surface->format.RGBToColor(r, g, b));
+			for (uint x = _blockW; x != 0; --x) {
+				// Ignore the alpha in the output as it is inversed in the input
+				if (!(alpha && (READ_LE_UINT16(src_p) & 0x8000))) {
+					drawPixel(*surface, dstPtr, *color_p);
 				}
+
+				src_p += 2;
+				++color_p;
+				dstPtr += bytesPerPixel;
 			}
 		}
 	}
@@ -877,6 +905,8 @@ bool VQADecoder::VQAVideoTrack::decodeFrame(Graphics::Surface *surface) {
 	if (!_codebook || !_vpointer)
 		return false;
 
+	_codebookColors = getCodebookColors(codebookInfo, surface->format);
+
 	uint8 *src = _vpointer;
 	uint8 *end = _vpointer + _vpointerSize;
 
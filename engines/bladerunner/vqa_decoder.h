@@ -134,6 +134,7 @@ public:
 		uint16  frame;
 		uint32  size;
 		uint8  *data;
+		uint32 *colors; // data converted to the pixel format of the surface
 	};
 
 	class VQAVideoTrack;
@@ -217,6 +218,8 @@ public:
 		uint32  _maxZBUFChunkSize;
 
 		uint8   *_codebook;
+		const uint32 *_codebookColors;
+		Graphics::PixelFormat _codebookColorsFormat;
 		uint8   *_cbfz;
 		uint32   _zbufChunkSize;
 		uint8   *_zbufChunk;
@@ -233,6 +236,7 @@ public:
 		uint8   *_screenEffectsData;
 		uint32   _screenEffectsDataSize;
 
+		const uint32 *getCodebookColors(CodebookInfo &codebookInfo, const Graphics::PixelFormat &format);
 		void VPTRWriteBlock(Graphics::Surface *surface, unsigned int dstBlock, unsigned int srcBlock, int count, bool alpha = false);
 		bool decodeFrame(Graphics::Surface *surface);
 	};
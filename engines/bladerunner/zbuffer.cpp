@@ -94,11 +94,13 @@ void ZBuffer::init(int width, int height) {
 	_zbuf2 = new uint16[width * height];
 }
 
-static int decodePartialZBuffer(const uint8 *src, uint16 *curZBUF, uint32 srcLen) {
+// Decode the update into both buffers at once, they are identical in the updated areas
+static int decodePartialZBuffer(const uint8 *src, uint16 *curZBUF, uint16 *curZBUF2, uint32 srcLen) {
 	uint32 dstSize = 640 * 480; // This is taken from global variables?
 	uint32 dstRemain = dstSize;
 
 	uint16 *curzp = curZBUF;
+	uint16 *curzp2 = curZBUF2;
 	const uint16 *inp = (const uint16 *)src;
 
 	while (dstRemain && (inp - (const uint16 *)src) < (ptrdiff_t)srcLen) {
@@ -110,9 +112,12 @@ static int decodePartialZBuffer(const uint8 *src, uint16 *curZBUF, uint32 srcLen
 
 			while (count--) {
 				uint16 value = FROM_LE_16(*inp++);
-				if (value)
+				if (value) {
 					*curzp = value;
+					*curzp2 = value;
+				}
 				++curzp;
+				++curzp2;
 			}
 		} else {
 			count = MIN(count, dstRemain);
@@ -121,9 +126,12 @@ static int decodePartialZBuffer(const uint8 *src, uint16 *curZBUF, uint32 srcLen
 
 			if (!value) {
 				curzp += count;
+				curzp2 += count;
 			} else {
-				while (count--)
+				while (count--) {
 					*curzp++ = value;
+					*curzp2++ = value;
+				}
 			}
 		}
 	}
@@ -164,8 +172,7 @@ bool ZBuffer::decodeData(const uint8 *data, int size) {
 		memcpy(_zbuf2, _zbuf1, 2 * _width * _height);
 	} else {
 		clean();
-		decodePartialZBuffer(data, _zbuf1, size);
-		decodePartialZBuffer(data, _zbuf2, size);
+		decodePartialZBuffer(data, _zbuf1, _zbuf2, size);
 	}
 
 	return true;
@@ -0,0 +1,170 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/config-manager.h"
+#include "common/debug.h"
+#include "common/fs.h"
+#include "common/stream.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+
+#include "engines/detectioncache.h"
+
+namespace Common {
+DECLARE_SINGLETON(DetectionCache);
+}
+
+static const uint32 kDetectionCacheTag = MKTAG('S', 'V', 'D', 'C');
+static const uint32 kDetectionCacheVersion = 1;
+
+// Forget everything rather than let the cache file grow without bounds
+static const uint kDetectionCacheMaxEntries = 65536;
+
+static void writeCacheString(Common::WriteStream &stream, const Common::String &str) {
+	stream.writeUint16LE(str.size());
+	stream.write(str.c_str(), str.size());
+}
+
+static bool readCacheString(Common::ReadStream &stream, Common::String &str) {
+	uint16 size = stream.readUint16LE();
+	str = stream.readString(0, size);
+	return !stream.eos() && !stream.err() && str.size() == size;
+}
+
+DetectionCache::DetectionCache() : _loaded(false), _dirty(false) {
+}
+
+bool DetectionCache::addStamp(Common::String &stamp, const Common::FSNode &node) {
+	int64 size, modificationTime;
+	if (!node.getFileStats(size, modificationTime))
+		return false;
+
+	stamp += Common::String::format("%lld/%lld;", (long long)size, (long long)modificationTime);
+	return true;
+}
+
+bool DetectionCache::lookup(const Common::String &key, const Common::String &stamp, FileProperties &fileProps) {
+	if (!_loaded)
+		load();
+
+	EntryMap::const_iterator i = _entries.find(key);
+	if (i == _entries.end() || i->_value.stamp != stamp)
+		return false;
+
+	fileProps = i->_value.props;
+	return true;
+}
+
+void DetectionCache::store(const Common::String &key, const Common::String &stamp, const FileProperties &fileProps) {
+	if (!_loaded)
+		load();
+
+	if (_entries.size() >= kDetectionCacheMaxEntries && !_entries.contains(key))
+		_entries.clear();
+
+	Entry &entry = _entries.getOrCreateVal(key);
+	entry.stamp = stamp;
+	entry.props = fileProps;
+	_dirty = true;
+}
+
+Common::String DetectionCache::getFileName() const {
+	Common::String configFileName = ConfMan.getCustomConfigFileName();
+	if (configFileName.empty())
+		configFileName = g_system->getDefaultConfigFileName();
+
+	Common::FSNode dir = Common::FSNode(configFileName).getParent();
+	if (!dir.isDirectory())
+		return Common::String();
+
+	return dir.getChild("detection.cache").getPath();
+}
+
+void DetectionCache::load() {
+	_loaded = true;
+	_entries.clear();
+
+	Common::String fileName = getFileName();
+	if (fileName.empty())
+		return;
+
+	Common::FSNode file(fileName);
+	if (!file.exists())
+		return;
+
+	Common::SeekableReadStream *stream = file.createReadStream();
+	if (!stream)
+		return;
+
+	if (stream->readUint32BE() != kDetectionCacheTag || stream->readUint32LE() != kDetectionCacheVersion) {
+		delete stream;
+		return;
+	}
+
+	uint32 count = stream->readUint32LE();
+	for (uint32 i = 0; i < count; i++) {
+		Common::String key;
+		Entry entry;
+
+		if (!readCacheString(*stream, key) || !readCacheString(*stream, entry.stamp) || !readCacheString(*stream, entry.props.md5))
+			break;
+		entry.props.size = stream->readSint64LE();
+		if (stream->eos() || stream->err())
+			break;
+
+		_entries[key] = entry;
+	}
+
+	debugC(2, kDebugGlobalDetection, "Loaded %u entries from the detection cache '%s'", _entries.size(), fileName.c_str());
+	delete stream;
+}
+
+void DetectionCache::flush() {
+	if (!_dirty)
+		return;
+	_dirty = false;
+
+	Common::String fileName = getFileName();
+	if (fileName.empty())
+		return;
+
+	Common::WriteStream *stream = Common::FSNode(fileName).createWriteStream();
+	if (!stream) {
+		warning("Could not write the detection cache '%s'", fileName.c_str());
+		return;
+	}
+
+	stream->writeUint32BE(kDetectionCacheTag);
+	stream->writeUint32LE(kDetectionCacheVersion);
+	stream->writeUint32LE(_entries.size());
+	for (EntryMap::const_iterator i = _entries.begin(); i != _entries.end(); ++i) {
+		writeCacheString(*stream, i->_key);
+		writeCacheString(*stream, i->_value.stamp);
+		writeCacheString(*stream, i->_value.props.md5);
+		stream->writeSint64LE(i->_value.props.size);
+	}
+
+	stream->finalize();
+	if (stream->err())
+		warning("Could not write the detection cache '%s'", fileName.c_str());
+	delete stream;
+}
@@ -0,0 +1,99 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef ENGINES_DETECTIONCACHE_H
+#define ENGINES_DETECTIONCACHE_H
+
+#include "common/hash-str.h"
+#include "common/singleton.h"
+
+#include "engines/game.h"
+
+namespace Common {
+class FSNode;
+}
+
+/**
+ * @addtogroup engines_advdetector
+ * @{
+ */
+
+/**
+ * Cache of the file properties computed during detection, kept on disk
+ * between runs.
+ *
+ * Computing the MD5 of many files, and of Mac resource forks in particular,
+ * can be slow. The cache remembers the properties of each file together with
+ * a stamp made of the size and modification time of the files they were
+ * computed from. An entry is reused only while its stamp is unchanged, so
+ * modified files are checked again automatically.
+ *
+ * The cache is stored next to the configuration file, and is only used on
+ * backends that can report the modification time of files.
+ */
+class DetectionCache : public Common::Singleton<DetectionCache> {
+public:
+	DetectionCache();
+
+	/**
+	 * Append the stamp of @p node to @p stamp.
+	 *
+	 * @return False if the backend cannot tell when the file was modified.
+	 */
+	static bool addStamp(Common::String &stamp, const Common::FSNode &node);
+
+	/**
+	 * Look for the properties cached under @p key. They are only returned
+	 * when they were stored with the same @p stamp.
+	 */
+	bool lookup(const Common::String &key, const Common::String &stamp, FileProperties &fileProps);
+
+	/** Store the properties computed for @p key and @p stamp. */
+	void store(const Common::String &key, const Common::String &stamp, const FileProperties &fileProps);
+
+	/** Write the cache to disk if it changed since it was loaded. */
+	void flush();
+
+private:
+	friend class Common::Singleton<DetectionCache>;
+
+	struct Entry {
+		Common::String stamp;
+		FileProperties props;
+	};
+
+	typedef Common::HashMap<Common::String, Entry> EntryMap;
+
+	void load();
+	Common::String getFileName() const;
+
+	EntryMap _entries;
+	bool _loaded;
+	bool _dirty;
+};
+
+/** Convenience shortcut for accessing the detection cache. */
+#define DetectionCacheMan DetectionCache::instance()
+
+/** @} */
+
+#endif
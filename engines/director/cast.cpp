@@ -594,7 +594,7 @@ void Cast::loadCastChildren() {
 }
 
 void Cast::loadSoundCasts() {
-	debugC(1, kDebugLoading, "****** Preloading sound casts");
+	debugC(1, kDebugLoading, "****** Registering sound casts");
 
 	for (Common::HashMap<int, CastMember *>::iterator c = _loadedCast->begin(); c != _loadedCast->end(); ++c) {
 		if (!c->_value)
@@ -620,7 +620,6 @@ void Cast::loadSoundCasts() {
 		}
 
 		if (_castArchive->hasResource(tag, sndId)) {
-			debugC(2, kDebugLoading, "****** Loading '%s' id: %d", tag2str(tag), sndId);
 			sndData = _castArchive->getResource(tag, sndId);
 		}
 
@@ -630,9 +629,9 @@ void Cast::loadSoundCasts() {
 				AudioFileDecoder *audio = new AudioFileDecoder(_castsInfo[c->_key]->fileName);
 				soundCast->_audio = audio;
 			} else {
-				SNDDecoder *audio = new SNDDecoder();
-				audio->loadStream(*sndData);
-				soundCast->_audio = audio;
+				// the sound data itself is only read when the sound is played
+				soundCast->_sndTag = tag;
+				soundCast->_sndId = sndId;
 				soundCast->_size = sndData->size();
 			}
 			delete sndData;
@@ -61,11 +61,14 @@ CastMemberInfo *CastMember::getInfo() {
 // Bitmap
 /////////////////////////////////////
 
+// Sprites being stretched continuously would otherwise grow the matte cache
+static const uint kMaxMattes = 8;
+
 BitmapCastMember::BitmapCastMember(Cast *cast, uint16 castId, Common::SeekableReadStreamEndian &stream, uint32 castTag, uint16 version, uint8 flags1)
 		: CastMember(cast, castId, stream) {
 	_type = kCastBitmap;
 	_img = nullptr;
-	_matte = nullptr;
+	_mattePalette = nullptr;
 	_noMatte = false;
 	_bytes = 0;
 	_pitch = 0;
@@ -171,8 +174,7 @@ BitmapCastMember::~BitmapCastMember() {
 	if (_img)
 		delete _img;
 
-	if (_matte)
-		delete _matte;
+	clearMattes();
 }
 
 Graphics::MacWidget *BitmapCastMember::createWidget(Common::Rect &bbox, Channel *channel) {
@@ -213,7 +215,7 @@ void BitmapCastMember::copyStretchImg(Graphics::Surface *surface, const Common::
 	}
 }
 
-void BitmapCastMember::createMatte(Common::Rect &bbox) {
+Graphics::FloodFill *BitmapCastMember::createMatte(Common::Rect &bbox) {
 	// Like background trans, but all white pixels NOT ENCLOSED by coloured pixels
 	// are transparent
 	Graphics::Surface tmp;
@@ -221,6 +223,7 @@ void BitmapCastMember::createMatte(Common::Rect &bbox) {
 
 	copyStretchImg(&tmp, bbox);
 
+	Graphics::FloodFill *matte = nullptr;
 	_noMatte = true;
 
 	// Searching white color in the corners
@@ -249,40 +252,60 @@ void BitmapCastMember::createMatte(Common::Rect &bbox) {
 	if (!colorFound) {
 		debugC(1, kDebugImages, "BitmapCastMember::createMatte(): No white color for matte image");
 	} else {
-		delete _matte;
-
-		_matte = new Graphics::FloodFill(&tmp, whiteColor, 0, true);
+		matte = new Graphics::FloodFill(&tmp, whiteColor, 0, true);
 
 		for (int yy = 0; yy < tmp.h; yy++) {
-			_matte->addSeed(0, yy);
-			_matte->addSeed(tmp.w - 1, yy);
+			matte->addSeed(0, yy);
+			matte->addSeed(tmp.w - 1, yy);
 		}
 
 		for (int xx = 0; xx < tmp.w; xx++) {
-			_matte->addSeed(xx, 0);
-			_matte->addSeed(xx, tmp.h - 1);
+			matte->addSeed(xx, 0);
+			matte->addSeed(xx, tmp.h - 1);
 		}
 
-		_matte->fillMask();
+		matte->fillMask();
 		_noMatte = false;
 	}
 
 	tmp.free();
+
+	return matte;
 }
 
 Graphics::Surface *BitmapCastMember::getMatte(Common::Rect &bbox) {
-	// Lazy loading of mattes
-	if (!_matte && !_noMatte) {
-		createMatte(bbox);
+	// The white color may have moved, so start over on palette change
+	if (_mattePalette != g_director->getPalette()) {
+		clearMattes();
+		_mattePalette = g_director->getPalette();
 	}
 
-	// check for the scale matte
-	Graphics::Surface *surface = _matte ? _matte->getMask() : nullptr;
-	if (surface && (surface->w != bbox.width() || surface->h != bbox.height())) {
-		createMatte(bbox);
+	if (_noMatte)
+		return nullptr;
+
+	// Lazy loading of mattes, keeping one per scale the member is drawn at
+	uint32 key = ((uint32)bbox.width() << 16) | (uint16)bbox.height();
+	Graphics::FloodFill *matte = nullptr;
+	if (!_mattes.tryGetVal(key, matte)) {
+		if (_mattes.size() >= kMaxMattes)
+			clearMattes();
+
+		matte = createMatte(bbox);
+		if (!matte)
+			return nullptr;
+
+		_mattes[key] = matte;
 	}
 
-	return _matte ? _matte->getMask() : nullptr;
+	return matte->getMask();
+}
+
+void BitmapCastMember::clearMattes() {
+	for (Common::HashMap<uint32, Graphics::FloodFill *>::iterator it = _mattes.begin(); it != _mattes.end(); ++it)
+		delete it->_value;
+
+	_mattes.clear();
+	_noMatte = false;
 }
 
 
@@ -542,6 +565,8 @@ SoundCastMember::SoundCastMember(Cast *cast, uint16 castId, Common::SeekableRead
 	_type = kCastSound;
 	_audio = nullptr;
 	_looping = 0;
+	_sndTag = 0;
+	_sndId = 0;
 }
 
 SoundCastMember::~SoundCastMember() {
@@ -549,6 +574,22 @@ SoundCastMember::~SoundCastMember() {
 		delete _audio;
 }
 
+AudioDecoder *SoundCastMember::getAudio() {
+	if (!_audio && _sndTag) {
+		debugC(2, kDebugLoading, "****** Loading '%s' id: %d", tag2str(_sndTag), _sndId);
+
+		Common::SeekableReadStreamEndian *sndData = _cast->getArchive()->getResource(_sndTag, _sndId);
+		SNDDecoder *audio = new SNDDecoder();
+		audio->loadStream(*sndData);
+		delete sndData;
+
+		_audio = audio;
+		_sndTag = 0;
+	}
+
+	return _audio;
+}
+
 
 /////////////////////////////////////
 // Text
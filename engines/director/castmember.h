@@ -116,8 +116,9 @@ public:
 	~BitmapCastMember();
 	virtual Graphics::MacWidget *createWidget(Common::Rect &bbox, Channel *channel) override;
 
-	void createMatte(Common::Rect &bbox);
+	Graphics::FloodFill *createMatte(Common::Rect &bbox);
 	Graphics::Surface *getMatte(Common::Rect &bbox);
+	void clearMattes();
 	void copyStretchImg(Graphics::Surface *surface, const Common::Rect &bbox);
 
 	bool hasField(int field) override;
@@ -125,7 +126,11 @@ public:
 	bool setField(int field, const Datum &value) override;
 
 	Image::ImageDecoder *_img;
-	Graphics::FloodFill *_matte;
+
+	// Mattes per drawn size, keyed by (width << 16 | height). They depend
+	// on which palette entry is white, so they belong to _mattePalette.
+	Common::HashMap<uint32, Graphics::FloodFill *> _mattes;
+	const byte *_mattePalette;
 
 	uint16 _pitch;
 	uint16 _regX;
@@ -193,8 +198,15 @@ public:
 	SoundCastMember(Cast *cast, uint16 castId, Common::SeekableReadStreamEndian &stream, uint16 version);
 	~SoundCastMember();
 
+	AudioDecoder *getAudio();
+
 	bool _looping;
 	AudioDecoder *_audio;
+
+	// Resource with the sound data, read on first use (or on preLoadCast)
+	// rather than with the rest of the cast
+	uint32 _sndTag;
+	uint16 _sndId;
 };
 
 class ShapeCastMember : public CastMember {
@@ -161,7 +161,10 @@ bool Channel::isDirty(Sprite *nextSprite) {
 		// When puppet is set, the overall dirty flag should be set when sprite is
 		// modified.
 		isDirtyFlag |= _sprite->_castId != nextSprite->_castId ||
-			_sprite->_ink != nextSprite->_ink;
+			_sprite->_ink != nextSprite->_ink ||
+			_sprite->_blend != nextSprite->_blend ||
+			_sprite->_foreColor != nextSprite->_foreColor ||
+			_sprite->_backColor != nextSprite->_backColor;
 		if (!_sprite->_moveable)
 			isDirtyFlag |= _currentPoint != nextSprite->_startPoint;
 		if (!_sprite->_stretch && !hasTextCastMember(_sprite))
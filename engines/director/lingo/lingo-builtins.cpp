@@ -1306,13 +1306,28 @@ void LB::b_preLoad(int nargs) {
 }
 
 void LB::b_preLoadCast(int nargs) {
-	// We always pretend we preloaded all cast
+	// Casts are loaded with the movie, except for the sound data, which is
+	// normally read when first played. Read it now for the requested members.
 	// Returning the number of the last cast successfully "loaded"
+	if (nargs < 1 || nargs > 2) {
+		g_lingo->dropStack(nargs);
+		return;
+	}
 
-	g_lingo->_theResult = g_lingo->pop();
+	Datum to = g_lingo->pop();
+	Datum from = nargs == 2 ? g_lingo->pop() : to;
 
-	if (nargs == 2)
-		g_lingo->pop();
+	Movie *movie = g_director->getCurrentMovie();
+	CastMemberID fromId = from.asMemberID();
+	CastMemberID toId = to.asMemberID();
+
+	for (int id = fromId.member; movie && id > 0 && id <= toId.member; id++) {
+		CastMember *member = movie->getCastMember(CastMemberID(id, fromId.castLib));
+		if (member && member->_type == kCastSound)
+			((SoundCastMember *)member)->getAudio();
+	}
+
+	g_lingo->_theResult = to;
 }
 
 void LB::b_framesToHMS(int nargs) {
@@ -91,6 +91,13 @@ LingoCompiler::LingoCompiler() {
 	_refMode = false;
 
 	_hadError = false;
+
+	_astCacheSize = 0;
+}
+
+LingoCompiler::~LingoCompiler() {
+	for (Common::HashMap<Common::String, Node *>::iterator it = _astCache.begin(); it != _astCache.end(); ++it)
+		delete it->_value;
 }
 
 ScriptContext *LingoCompiler::compileAnonymous(const Common::U32String &code) {
@@ -100,6 +107,9 @@ ScriptContext *LingoCompiler::compileAnonymous(const Common::U32String &code) {
 	return compileLingo(code, nullptr, kNoneScript, CastMemberID(0, 0), "[anonymous]", true);
 }
 
+// Total size of the script sources whose AST is kept around
+static const uint32 kASTCacheMaxSize = 4 * 1024 * 1024;
+
 ScriptContext *LingoCompiler::compileLingo(const Common::U32String &code, LingoArchive *archive, ScriptType type, CastMemberID id, const Common::String &scriptName, bool anonymous) {
 	_assemblyArchive = archive;
 	_assemblyAST = nullptr;
@@ -114,13 +124,24 @@ ScriptContext *LingoCompiler::compileLingo(const Common::U32String &code, LingoA
 	Common::String codeNorm = codePreprocessor(code, archive, type, id).encode(Common::kUtf8);
 	const char *utf8Code = codeNorm.c_str();
 
-	// Parse the Lingo and build an AST
-	parse(utf8Code);
-	if (!_assemblyAST) {
-		delete _assemblyContext;
-		delete _currentAssembly;
-		delete _methodVars;
-		return nullptr;
+	// Parse the Lingo and build an AST, unless we already did for this code
+	bool cachedAST = false;
+	if (!anonymous && _astCache.tryGetVal(codeNorm, _assemblyAST)) {
+		cachedAST = true;
+	} else {
+		parse(utf8Code);
+		if (!_assemblyAST) {
+			delete _assemblyContext;
+			delete _currentAssembly;
+			delete _methodVars;
+			return nullptr;
+		}
+
+		if (!anonymous && !_hadError && _astCacheSize + codeNorm.size() <= kASTCacheMaxSize) {
+			_astCache[codeNorm] = _assemblyAST;
+			_astCacheSize += codeNorm.size();
+			cachedAST = true;
+		}
 	}
 
 	// Generate bytecode
@@ -129,7 +150,9 @@ ScriptContext *LingoCompiler::compileLingo(const Common::U32String &code, LingoA
 		delete _assemblyContext;
 		delete _currentAssembly;
 		delete _methodVars;
-		delete _assemblyAST;
+		if (!cachedAST)
+			delete _assemblyAST;
+		_assemblyAST = nullptr;
 		return nullptr;
 	}
 
@@ -197,7 +220,8 @@ ScriptContext *LingoCompiler::compileLingo(const Common::U32String &code, LingoA
 	delete _methodVars;
 	_methodVars = nullptr;
 	_currentAssembly = nullptr;
-	delete _assemblyAST;
+	if (!cachedAST)
+		delete _assemblyAST;
 	_assemblyAST = nullptr;
 	_assemblyContext = nullptr;
 	_assemblyArchive = nullptr;
@@ -821,6 +845,9 @@ bool LingoCompiler::visitIfElseStmtNode(IfElseStmtNode *node) {
 bool LingoCompiler::visitRepeatWhileNode(RepeatWhileNode *node) {
 	LoopNode *prevLoop = _currentLoop;
 	_currentLoop = node;
+	// the node may come from the AST cache and carry jumps from its last compile
+	node->nextRepeats.clear();
+	node->exitRepeats.clear();
 
 	uint startPos = _currentAssembly->size();
 	COMPILE(node->cond);
@@ -850,6 +877,9 @@ bool LingoCompiler::visitRepeatWhileNode(RepeatWhileNode *node) {
 bool LingoCompiler::visitRepeatWithToNode(RepeatWithToNode *node) {
 	LoopNode *prevLoop = _currentLoop;
 	_currentLoop = node;
+	// the node may come from the AST cache and carry jumps from its last compile
+	node->nextRepeats.clear();
+	node->exitRepeats.clear();
 
 	COMPILE(node->start);
 	codeVarSet(*node->var);
@@ -901,6 +931,9 @@ bool LingoCompiler::visitRepeatWithToNode(RepeatWithToNode *node) {
 bool LingoCompiler::visitRepeatWithInNode(RepeatWithInNode *node) {
 	LoopNode *prevLoop = _currentLoop;
 	_currentLoop = node;
+	// the node may come from the AST cache and carry jumps from its last compile
+	node->nextRepeats.clear();
+	node->exitRepeats.clear();
 
 	COMPILE(node->list);
 	code1(LC::c_stackpeek);
@@ -32,7 +32,7 @@ namespace Director {
 class LingoCompiler : NodeVisitor {
 public:
 	LingoCompiler();
-	virtual ~LingoCompiler() {}
+	virtual ~LingoCompiler();
 
 	ScriptContext *compileAnonymous(const Common::U32String &code);
 	ScriptContext *compileLingo(const Common::U32String &code, LingoArchive *archive, ScriptType type, CastMemberID id, const Common::String &scriptName, bool anonyomous = false);
@@ -72,6 +72,13 @@ public:
 
 	bool _hadError;
 
+	// Parsed scripts keyed by their preprocessed source, so movies sharing
+	// scripts don't have to go through the parser again on every load.
+	// Code generation still runs each time, as it has side effects on the
+	// archive and the globals.
+	Common::HashMap<Common::String, Node *> _astCache;
+	uint32 _astCacheSize;
+
 public:
 	virtual bool visitScriptNode(ScriptNode *node);
 	virtual bool visitFactoryNode(FactoryNode *node);
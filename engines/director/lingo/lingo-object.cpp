@@ -242,11 +242,24 @@ Symbol ScriptContext::define(const Common::String &name, ScriptData *code, Commo
 	return sym;
 }
 
+AbstractObject *ScriptContext::getAncestor() {
+	if (_objType != kScriptObj)
+		return nullptr;
+
+	DatumHash::iterator it = _properties.find("ancestor");
+	if (it == _properties.end() || it->_value.type != OBJECT
+			|| !(it->_value.u.obj->getObjType() & (kScriptObj | kXtraObj)))
+		return nullptr;
+
+	return it->_value.u.obj;
+}
+
 Symbol ScriptContext::getMethod(const Common::String &methodName) {
 	Symbol sym;
 
-	if (_functionHandlers.contains(methodName)) {
-		sym = _functionHandlers[methodName];
+	SymbolHash::iterator it = _functionHandlers.find(methodName);
+	if (it != _functionHandlers.end()) {
+		sym = it->_value;
 		sym.target = this;
 		return sym;
 	}
@@ -255,13 +268,12 @@ Symbol ScriptContext::getMethod(const Common::String &methodName) {
 	if (sym.type != VOIDSYM)
 		return sym;
 
-	if (_objType == kScriptObj) {
-		if (_properties.contains("ancestor") && _properties["ancestor"].type == OBJECT
-				&& (_properties["ancestor"].u.obj->getObjType() & (kScriptObj | kXtraObj))) {
-			// ancestor method
-			debugC(3, kDebugLingoExec, "Calling method '%s' on ancestor: <%s>", methodName.c_str(), _properties["ancestor"].asString(true).c_str());
-			return _properties["ancestor"].u.obj->getMethod(methodName);
-		}
+	AbstractObject *ancestor = getAncestor();
+	if (ancestor) {
+		// ancestor method
+		if (debugChannelSet(3, kDebugLingoExec))
+			debugC(3, kDebugLingoExec, "Calling method '%s' on ancestor: <%s>", methodName.c_str(), Datum(ancestor).asString(true).c_str());
+		return ancestor->getMethod(methodName);
 	}
 
 	return sym;
@@ -274,11 +286,9 @@ bool ScriptContext::hasProp(const Common::String &propName) {
 	if (_properties.contains(propName)) {
 		return true;
 	}
-	if (_objType == kScriptObj) {
-		if (_properties.contains("ancestor") && _properties["ancestor"].type == OBJECT
-				&& (_properties["ancestor"].u.obj->getObjType() & (kScriptObj | kXtraObj))) {
-			return _properties["ancestor"].u.obj->hasProp(propName);
-		}
+	AbstractObject *ancestor = getAncestor();
+	if (ancestor) {
+		return ancestor->hasProp(propName);
 	}
 	return false;
 }
@@ -287,15 +297,15 @@ Datum ScriptContext::getProp(const Common::String &propName) {
 	if (_disposed) {
 		error("Property '%s' accessed on disposed object <%s>", propName.c_str(), Datum(this).asString(true).c_str());
 	}
-	if (_properties.contains(propName)) {
-		return _properties[propName];
+	DatumHash::iterator it = _properties.find(propName);
+	if (it != _properties.end()) {
+		return it->_value;
 	}
-	if (_objType == kScriptObj) {
-		if (_properties.contains("ancestor") && _properties["ancestor"].type == OBJECT
-				&& (_properties["ancestor"].u.obj->getObjType() & (kScriptObj | kXtraObj))) {
-			debugC(3, kDebugLingoExec, "Getting prop '%s' from ancestor: <%s>", propName.c_str(), _properties["ancestor"].asString(true).c_str());
-			return _properties["ancestor"].u.obj->getProp(propName);
-		}
+	AbstractObject *ancestor = getAncestor();
+	if (ancestor) {
+		if (debugChannelSet(3, kDebugLingoExec))
+			debugC(3, kDebugLingoExec, "Getting prop '%s' from ancestor: <%s>", propName.c_str(), Datum(ancestor).asString(true).c_str());
+		return ancestor->getProp(propName);
 	}
 	return _properties[propName]; // return new property
 }
@@ -304,16 +314,16 @@ bool ScriptContext::setProp(const Common::String &propName, const Datum &value)
 	if (_disposed) {
 		error("Property '%s' accessed on disposed object <%s>", propName.c_str(), Datum(this).asString(true).c_str());
 	}
-	if (_properties.contains(propName)) {
-		_properties[propName] = value;
+	DatumHash::iterator it = _properties.find(propName);
+	if (it != _properties.end()) {
+		it->_value = value;
 		return true;
 	}
-	if (_objType == kScriptObj) {
-		if (_properties.contains("ancestor") && _properties["ancestor"].type == OBJECT
-				&& (_properties["ancestor"].u.obj->getObjType() & (kScriptObj | kXtraObj))) {
-			debugC(3, kDebugLingoExec, "Getting prop '%s' from ancestor: <%s>", propName.c_str(), _properties["ancestor"].asString(true).c_str());
-			return _properties["ancestor"].u.obj->setProp(propName, value);
-		}
+	AbstractObject *ancestor = getAncestor();
+	if (ancestor) {
+		if (debugChannelSet(3, kDebugLingoExec))
+			debugC(3, kDebugLingoExec, "Getting prop '%s' from ancestor: <%s>", propName.c_str(), Datum(ancestor).asString(true).c_str());
+		return ancestor->setProp(propName, value);
 	}
 	return false;
 }
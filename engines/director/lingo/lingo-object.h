@@ -141,13 +141,17 @@ public:
 
 
 		Symbol sym;
-		if (_methods && _methods->contains(methodId)) {
-			sym = (*_methods)[methodId];
-			sym.target = this;
-			return sym;
+		if (_methods) {
+			SymbolHash::iterator it = _methods->find(methodId);
+			if (it != _methods->end()) {
+				sym = it->_value;
+				sym.target = this;
+				return sym;
+			}
 		}
-		if (g_lingo->_methods.contains(methodId) && (g_lingo->_methods[methodId].targetType & _objType)) {
-			sym = g_lingo->_methods[methodId];
+		SymbolHash::iterator it = g_lingo->_methods.find(methodId);
+		if (it != g_lingo->_methods.end() && (it->_value.targetType & _objType)) {
+			sym = it->_value;
 			sym.target = this;
 			return sym;
 		}
@@ -212,6 +216,9 @@ public:
 	bool setProp(const Common::String &propName, const Datum &value) override;
 
 	Symbol define(const Common::String &name, ScriptData *code, Common::Array<Common::String> *argNames, Common::Array<Common::String> *varNames);
+
+private:
+	AbstractObject *getAncestor();
 };
 
 namespace LM {
@@ -532,15 +532,21 @@ void Score::renderSprites(uint16 frameId, RenderMode mode) {
 			_movie->_videoPlayback = true;
 
 		if (channel->isDirty(nextSprite) || widgetRedrawn || mode == kRenderForceUpdate) {
-			if (!currentSprite->_trails)
-				_window->addDirtyRect(channel->getBbox());
+			Common::Rect oldBbox = channel->getBbox();
+			bool trails = currentSprite->_trails;
+			if (!trails)
+				_window->addDirtyRect(oldBbox);
 
 			channel->setClean(nextSprite, i);
 			// Check again to see if a video has just been started by setClean.
 			if (channel->isActiveVideo())
 				_movie->_videoPlayback = true;
 
-			_window->addDirtyRect(channel->getBbox());
+			// Only the area the sprite moved or grew into needs to be added,
+			// the old one is already queued for redrawing
+			Common::Rect newBbox = channel->getBbox();
+			if (trails || newBbox != oldBbox)
+				_window->addDirtyRect(newBbox);
 			debugC(2, kDebugImages, "Score::renderSprites(): CH: %-3d castId: %s [ink: %d, puppet: %d, moveable: %d, visible: %d] [bbox: %d,%d,%d,%d] [type: %d fg: %d bg: %d] [script: %s]", i, currentSprite->_castId.asString().c_str(), currentSprite->_ink, currentSprite->_puppet, currentSprite->_moveable, channel->_visible, PRINT_RECT(channel->getBbox()), currentSprite->_spriteType, currentSprite->_foreColor, currentSprite->_backColor, currentSprite->_scriptId.asString().c_str());
 		} else {
 			channel->setClean(nextSprite, i, true);
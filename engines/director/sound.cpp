@@ -107,7 +107,7 @@ void DirectorSound::playCastMember(CastMemberID memberID, uint8 soundChannel, bo
 				if (!allowRepeat && lastPlayingCast(soundChannel) == memberID)
 					return;
 				bool looping = ((SoundCastMember *)soundCast)->_looping;
-				AudioDecoder *ad = ((SoundCastMember *)soundCast)->_audio;
+				AudioDecoder *ad = ((SoundCastMember *)soundCast)->getAudio();
 				if (!ad) {
 					warning("DirectorSound::playCastMember: no audio data attached to %s", memberID.asString().c_str());
 					return;
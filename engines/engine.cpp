@@ -30,6 +30,7 @@
 #include "engines/dialogs.h"
 #include "engines/util.h"
 #include "engines/metaengine.h"
+#include "engines/snapshots.h"
 
 #include "common/config-manager.h"
 #include "common/events.h"
@@ -146,10 +147,13 @@ Engine::Engine(OSystem *syst)
 		_engineStartTime(_system->getMillis()),
 		_mainMenuDialog(NULL),
 		_debugger(NULL),
+		_snapshots(nullptr),
 		_autosaveInterval(ConfMan.getInt("autosave_period")),
-		_lastAutosaveTime(_system->getMillis()) {
+		_lastAutosaveTime(_system->getMillis()),
+		_saveWriteFailed(false) {
 
 	g_engine = this;
+	_saveFileMan->addWriteCallback(&saveWrittenProc, this);
 	Common::setErrorOutputFormatter(defaultOutputFormatter);
 	Common::setErrorHandler(defaultErrorHandler);
 
@@ -181,6 +185,11 @@ Engine::Engine(OSystem *syst)
 Engine::~Engine() {
 	_mixer->stopAll();
 
+	// Make sure the last saves are on disk when the engine quits.
+	_saveFileMan->removeWriteCallback(&saveWrittenProc, this);
+	_saveFileMan->flushPendingWrites();
+
+	delete _snapshots;
 	delete _debugger;
 	delete _mainMenuDialog;
 	g_engine = NULL;
@@ -403,6 +412,22 @@ void initGraphics3d(int width, int height) {
 	g_system->endGFXTransaction();
 }
 
+uint32 getResourceMemoryBudget(uint32 engineDefault) {
+	if (ConfMan.hasKey("resource_memory_budget")) {
+		int budget = ConfMan.getInt("resource_memory_budget");
+		if (budget > 0)
+			return MIN<uint32>(budget, 2047) * 1024 * 1024;
+	}
+
+	// Leave most of the memory to the rest of the system and to the game's
+	// data which is not cached
+	uint64 physicalMemory = g_system->getPhysicalMemorySize();
+	if (!physicalMemory)
+		return engineDefault;
+
+	return (uint32)MIN<uint64>(physicalMemory / 16, 1024 * 1024 * 1024);
+}
+
 void GUIErrorMessageWithURL(const Common::U32String &msg, const char *url) {
 	GUIErrorMessage(msg, url);
 }
@@ -520,7 +545,17 @@ void Engine::checkCD() {
 #endif // defined(WIN32) && !defined(__SYMBIAN32__)
 }
 
+void Engine::saveWrittenProc(const Common::String &name, bool success, void *refCon) {
+	if (!success)
+		((Engine *)refCon)->_saveWriteFailed = true;
+}
+
 void Engine::handleAutoSave() {
+	if (_saveWriteFailed) {
+		_saveWriteFailed = false;
+		g_system->displayMessageOnOSD(_("Failed to write the saved game"));
+	}
+
 	const int diff = _system->getMillis() - _lastAutosaveTime;
 
 	if (_autosaveInterval != 0 && diff > (_autosaveInterval * 1000)) {
@@ -868,6 +903,13 @@ GUI::Debugger *Engine::getOrCreateDebugger() {
 	return _debugger;
 }
 
+SnapshotManager *Engine::getSnapshotManager() {
+	if (!_snapshots)
+		_snapshots = new SnapshotManager(this);
+
+	return _snapshots;
+}
+
 /*
 EnginePlugin *Engine::getMetaEnginePlugin() const {
 	return EngineMan.findPlugin(ConfMan.get("engineid"));
@@ -33,6 +33,7 @@
 class OSystem;
 class MetaEngineDetection;
 class MetaEngine;
+class SnapshotManager;
 
 namespace Audio {
 class Mixer;
@@ -210,6 +211,12 @@ private:
 	 */
 	int _lastAutosaveTime;
 
+	/**
+	 * Set by the save file manager when a save file written in the background
+	 * failed to be written. The user is told on the next handleAutoSave().
+	 */
+	volatile bool _saveWriteFailed;
+
 	/**
 	 * Save slot selected via the global main menu.
 	 *
@@ -222,6 +229,11 @@ private:
 	 * Optional debugger for the engine.
 	 */
 	GUI::Debugger *_debugger;
+
+	/**
+	 * In-memory snapshots of the game state, created when first used.
+	 */
+	SnapshotManager *_snapshots;
 public:
 
 
@@ -347,6 +359,14 @@ public:
 	 */
 	GUI::Debugger *getOrCreateDebugger();
 
+	/**
+	 * Return the in-memory snapshots of the game state, creating them when
+	 * first used.
+	 *
+	 * @see SnapshotManager
+	 */
+	SnapshotManager *getSnapshotManager();
+
 	/**
 	 * Determine whether the engine supports the specified feature.
 	 */
@@ -526,6 +546,9 @@ private:
 	 */
 	friend class PauseToken;
 
+	/** Called by the save file manager when a save file was written in the background. */
+	static void saveWrittenProc(const Common::String &name, bool success, void *refCon);
+
 public:
 
 	/**
@@ -0,0 +1,79 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "glk/glulx/debugger.h"
+#include "glk/glulx/glulx.h"
+#include "common/algorithm.h"
+
+namespace Glk {
+namespace Glulx {
+
+struct CallCount {
+	uint _addr;
+	uint _count;
+};
+
+static bool compareCallCounts(const CallCount &a, const CallCount &b) {
+	return a._count > b._count || (a._count == b._count && a._addr < b._addr);
+}
+
+Debugger::Debugger() : Glk::Debugger() {
+	registerCmd("profile", WRAP_METHOD(Debugger, cmdProfile));
+}
+
+bool Debugger::cmdProfile(int argc, const char **argv) {
+	if (argc == 2 && !strcmp(argv[1], "on")) {
+		g_vm->_countCalls = true;
+		debugPrintf("Function call counting is on\n");
+	} else if (argc == 2 && !strcmp(argv[1], "off")) {
+		g_vm->_countCalls = false;
+		debugPrintf("Function call counting is off\n");
+	} else if (argc == 2 && !strcmp(argv[1], "clear")) {
+		g_vm->_callCounts.clear();
+		debugPrintf("Function call counts cleared\n");
+	} else if (argc <= 2) {
+		uint limit = (argc == 2) ? strToInt(argv[1]) : 20;
+
+		Common::Array<CallCount> counts;
+		for (Common::HashMap<uint, uint>::const_iterator i = g_vm->_callCounts.begin();
+				i != g_vm->_callCounts.end(); ++i) {
+			CallCount cc;
+			cc._addr = i->_key;
+			cc._count = i->_value;
+			counts.push_back(cc);
+		}
+		Common::sort(counts.begin(), counts.end(), compareCallCounts);
+
+		if (counts.empty())
+			debugPrintf("No function calls recorded%s\n", g_vm->_countCalls ? "" : ", use 'profile on' to start counting");
+		for (uint idx = 0; idx < counts.size() && idx < limit; ++idx)
+			debugPrintf("%08x  %u%s\n", counts[idx]._addr, counts[idx]._count,
+				g_vm->accel_get_func(counts[idx]._addr) ? "  (accelerated)" : "");
+	} else {
+		debugPrintf("profile [on | off | clear | <count>]\n");
+	}
+
+	return true;
+}
+
+} // End of namespace Glulx
+} // End of namespace Glk
@@ -39,7 +39,12 @@ void Glulx::execute_loop() {
 	gfloat32 valf, valf1, valf2;
 #endif /* FLOAT_SUPPORT */
 
-	while (!done_executing && !g_vm->shouldQuit()) {
+	uint quitCheck = 0;
+
+	while (!done_executing) {
+		/* Polling for a quit goes through the event manager, so only do it every so often */
+		if ((quitCheck++ & 0x3FF) == 0 && g_vm->shouldQuit())
+			break;
 
 		profile_tick();
 		debugger_tick();
@@ -21,6 +21,7 @@
  */
 
 #include "glk/glulx/glulx.h"
+#include "glk/glulx/debugger.h"
 #include "common/config-manager.h"
 #include "common/translation.h"
 
@@ -46,12 +47,17 @@ Glulx::Glulx(OSystem *syst, const GlkGameDescription &gameDesc) : GlkAPI(syst, g
 		// serial
 		max_undo_level(8), undo_chain_size(0), undo_chain_num(0), undo_chain(nullptr), ramcache(nullptr),
 		// string
-		iosys_mode(0), iosys_rock(0), tablecache_valid(false), glkio_unichar_han_ptr(nullptr) {
+		iosys_mode(0), iosys_rock(0), tablecache_valid(false), glkio_unichar_han_ptr(nullptr),
+		_countCalls(false) {
 	g_vm = this;
 
 	glkopInit();
 }
 
+void Glulx::createDebugger() {
+	setDebugger(new Debugger());
+}
+
 void Glulx::runGame() {
 	if (!is_gamefile_valid())
 		return;
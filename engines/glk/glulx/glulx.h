@@ -26,6 +26,7 @@
 #define GLK_GLULXE
 
 #include "common/scummsys.h"
+#include "common/hashmap.h"
 #include "common/random.h"
 #include "glk/glk_api.h"
 #include "glk/glulx/glulx_types.h"
@@ -393,6 +394,17 @@ protected:
 	void dumpcache(cacheblock_t *cablist, int count, int indent);
 
 	/**@}*/
+protected:
+	/**
+	 * Create the debugger
+	 */
+	void createDebugger() override;
+public:
+	/**
+	 * When set, calls to each function address are tallied in _callCounts
+	 */
+	bool _countCalls;
+	Common::HashMap<uint, uint> _callCounts;
 public:
 	/**
 	 * Constructor
@@ -831,7 +843,10 @@ public:
 	#else /* VM_PROFILING */
 	void profile_tick() {}
 	void profile_profiling_active() {}
-	void profile_in(uint addr, uint stackuse, int accel) {}
+	void profile_in(uint addr, uint stackuse, int accel) {
+		if (_countCalls)
+			_callCounts[addr]++;
+	}
 	void profile_out(uint stackuse)  {}
 	void profile_fail(const char *reason) {}
 	void profile_quit() {}
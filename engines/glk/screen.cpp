@@ -187,4 +187,9 @@ size_t Screen::stringWidthUni(int fontIdx, const Common::U32String &text, int sp
 	return font->getStringWidth(text) * GLI_SUBPIX;
 }
 
+size_t Screen::charWidthUni(int fontIdx, uint32 ch, uint32 prevCh) {
+	const Graphics::Font *font = _fonts[fontIdx];
+	return (font->getCharWidth(ch) + font->getKerningOffset(prevCh, ch)) * GLI_SUBPIX;
+}
+
 } // End of namespace Glk
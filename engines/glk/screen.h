@@ -133,6 +133,16 @@ public:
 	 * @returns         Width of string multiplied by GLI_SUBPIX
 	 */
 	size_t stringWidthUni(int fontIdx, const Common::U32String &text, int spw = 0);
+
+	/**
+	 * Get the width in pixels of a single character. Summing this over a string
+	 * gives the same result as stringWidthUni
+	 * @param fontIdx   Which font to use
+	 * @param ch        Character to get the width of
+	 * @param prevCh    Preceding character in the string, or 0, for kerning
+	 * @returns         Width of character multiplied by GLI_SUBPIX
+	 */
+	size_t charWidthUni(int fontIdx, uint32 ch, uint32 prevCh = 0);
 };
 
 } // End of namespace Glk
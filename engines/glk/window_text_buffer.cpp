@@ -40,7 +40,8 @@ TextBufferWindow::TextBufferWindow(Windows *windows, uint rock) : TextWindow(win
 		_font(g_conf->_propInfo), _historyPos(0), _historyFirst(0), _historyPresent(0),
 		_lastSeen(0), _scrollPos(0), _scrollMax(0), _scrollBack(SCROLLBACK), _width(-1), _height(-1),
 		_inBuf(nullptr), _lineTerminators(nullptr), _echoLineInput(true), _ladjw(0), _radjw(0),
-		_ladjn(0), _radjn(0), _numChars(0), _chars(nullptr), _attrs(nullptr), _spaced(0), _dashed(0),
+		_ladjn(0), _radjn(0), _numChars(0), _widthChars(0), _lineWidth(0), _chars(nullptr), _attrs(nullptr),
+		_spaced(0), _dashed(0),
 		_copyBuf(0), _copyPos(0) {
 	_type = wintype_TextBuffer;
 	_history.resize(HISTORYLEN);
@@ -310,6 +311,8 @@ void TextBufferWindow::putText(const char *buf, int len, int pos, int oldlen) {
 	if (_numChars + diff >= TBLINELEN)
 		return;
 
+	_widthChars = MIN(_widthChars, pos);
+
 	if (diff != 0 && pos + oldlen < _numChars) {
 		memmove(_chars + pos + len,
 				_chars + pos + oldlen,
@@ -342,6 +345,8 @@ void TextBufferWindow::putTextUni(const uint32 *buf, int len, int pos, int oldle
 	if (_numChars + diff >= TBLINELEN)
 		return;
 
+	_widthChars = MIN(_widthChars, pos);
+
 	if (diff != 0 && pos + oldlen < _numChars) {
 		memmove(_chars + pos + len,
 				_chars + pos + oldlen,
@@ -479,6 +484,9 @@ void TextBufferWindow::putCharUni(uint32 ch) {
 		}
 	}
 
+	// Anything past this point in the cached width has been replaced
+	_widthChars = MIN(_widthChars, _numChars);
+
 	_chars[_numChars] = ch;
 	_attrs[_numChars] = _attr;
 	_numChars++;
@@ -490,7 +498,7 @@ void TextBufferWindow::putCharUni(uint32 ch) {
 			&& !_styles[_attrs[linelen - 1].style].reverse)
 		linelen--;
 
-	if (calcWidth(_chars, _attrs, 0, linelen, -1) >= pw) {
+	if (calcLineWidth(linelen) >= pw) {
 		bpoint = _numChars;
 
 		for (i = _numChars - 1; i > 0; i--) {
@@ -542,6 +550,7 @@ void TextBufferWindow::clear() {
 	_dashed = 0;
 
 	_numChars = 0;
+	_widthChars = 0;
 
 	for (i = 0; i < _scrollBack; i++) {
 		_lines[i]._len = 0;
@@ -1568,6 +1577,7 @@ void TextBufferWindow::scrollOneLine(bool forced) {
 	touch(0);
 	_lines[0]._len = 0;
 	_lines[0]._newLine = 0;
+	_widthChars = 0;
 	_lines[0]._lm = _ladjw;
 	_lines[0]._rm = _radjw;
 	_lines[0]._lPic = nullptr;
@@ -1616,22 +1626,43 @@ void TextBufferWindow::scrollResize() {
 int TextBufferWindow::calcWidth(const uint32 *chars, const Attributes *attrs, int startchar, int numChars, int spw) {
 	Screen &screen = *g_vm->_screen;
 	int w = 0;
-	int a, b;
+	int font = 0;
 
-	a = startchar;
-	for (b = startchar; b < numChars; b++) {
-		if (attrs[a] != attrs[b]) {
-			w += screen.stringWidthUni(attrs[a].attrFont(_styles),
-									   Common::U32String(chars + a, b - a), spw);
-			a = b;
-		}
-	}
+	// Measure character by character rather than building a string for each run of attributes.
+	// Kerning only applies between characters in the same run
+	for (int b = startchar; b < numChars; b++) {
+		bool runStart = b == startchar || attrs[b] != attrs[b - 1];
+		if (runStart)
+			font = attrs[b].attrFont(_styles);
 
-	w += screen.stringWidthUni(attrs[a].attrFont(_styles), Common::U32String(chars + a, b - a), spw);
+		w += screen.charWidthUni(font, chars[b], runStart ? 0 : chars[b - 1]);
+	}
 
 	return w;
 }
 
+int TextBufferWindow::calcLineWidth(int numChars) {
+	if (_widthChars > numChars) {
+		_widthChars = 0;
+		_lineWidth = 0;
+	}
+
+	if (_widthChars == 0) {
+		_lineWidth = calcWidth(_chars, _attrs, 0, numChars, -1);
+	} else if (_widthChars < numChars) {
+		// Continue the last attribute run rather than starting a new one at _widthChars
+		Screen &screen = *g_vm->_screen;
+		for (int b = _widthChars; b < numChars; b++) {
+			bool runStart = _attrs[b] != _attrs[b - 1];
+			_lineWidth += screen.charWidthUni(_attrs[b].attrFont(_styles), _chars[b],
+				runStart ? 0 : _chars[b - 1]);
+		}
+	}
+
+	_widthChars = numChars;
+	return _lineWidth;
+}
+
 void TextBufferWindow::getSize(uint *width, uint *height) const {
 	if (width)
 		*width = (_bbox.width() - g_conf->_tMarginX * 2) / _font._cellW;
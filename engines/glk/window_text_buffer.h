@@ -92,6 +92,12 @@ private:
 	void scrollOneLine(bool forced);
 	void scrollResize();
 	int calcWidth(const uint32 *chars, const Attributes *attrs, int startchar, int numchars, int spw);
+
+	/**
+	 * Returns the width of the first numChars characters of the current line. The width of the
+	 * line so far is cached, so that adding characters one at a time only measures the new ones
+	 */
+	int calcLineWidth(int numChars);
 public:
 	int _width, _height;
 	int _spaced;
@@ -101,6 +107,8 @@ public:
 	int _scrollBack;
 
 	int _numChars;        ///< number of chars in last line: lines[0]
+	int _widthChars;      ///< number of chars at the start of lines[0] covered by _width
+	int _lineWidth;       ///< cached width of the first _widthChars chars in lines[0]
 	uint32 *_chars;       ///< alias to lines[0].chars
 	Attributes *_attrs;   ///< alias to lines[0].attrs
 
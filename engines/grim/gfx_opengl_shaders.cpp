@@ -230,6 +230,7 @@ GfxOpenGLS::GfxOpenGLS() {
 	_dimProgram = nullptr;
 	_dimPlaneProgram = nullptr;
 	_dimRegionProgram = nullptr;
+	_emiFaceUniforms.shader = nullptr;
 
 	float div = 6.0f;
 	_overworldProjMatrix = makeFrustumMatrix(-1.f / div, 1.f / div, -0.75f / div, 0.75f / div, 1.0f / div, 3276.8f);
@@ -655,6 +656,7 @@ void GfxOpenGLS::getActorScreenBBox(const Actor *actor, Common::Point &p1, Commo
 
 void GfxOpenGLS::startActorDraw(const Actor *actor) {
 	_currentActor = actor;
+	_emiFaceUniforms.shader = nullptr;
 	glEnable(GL_DEPTH_TEST);
 
 	const Math::Vector3d &pos = actor->getWorldPos();
@@ -948,10 +950,27 @@ void GfxOpenGLS::drawEMIModelFace(const EMIModel* model, const EMIMeshFace* face
 		actorShader = mud->_shader;
 	actorShader->use();
 	bool textured = face->_hasTexture && !_currentShadowArray;
-	actorShader->setUniform("textured", textured ? GL_TRUE : GL_FALSE);
-	actorShader->setUniform("swapRandB", _selectedTexture->_colorFormat == BM_BGRA || _selectedTexture->_colorFormat == BM_BGR888);
-	actorShader->setUniform("useVertexAlpha", _selectedTexture->_colorFormat == BM_BGRA);
-	actorShader->setUniform1f("meshAlpha", (model->_meshAlphaMode == Actor::AlphaReplace) ? model->_meshAlpha : 1.0f);
+	bool swapRandB = _selectedTexture->_colorFormat == BM_BGRA || _selectedTexture->_colorFormat == BM_BGR888;
+	bool useVertexAlpha = _selectedTexture->_colorFormat == BM_BGRA;
+	float meshAlpha = (model->_meshAlphaMode == Actor::AlphaReplace) ? model->_meshAlpha : 1.0f;
+
+	// Faces of the same mesh mostly share these, so skip redundant updates
+	EMIFaceUniforms &last = _emiFaceUniforms;
+	bool newShader = last.shader != actorShader;
+	if (newShader || last.textured != textured)
+		actorShader->setUniform("textured", textured ? GL_TRUE : GL_FALSE);
+	if (newShader || last.swapRandB != swapRandB)
+		actorShader->setUniform("swapRandB", swapRandB);
+	if (newShader || last.useVertexAlpha != useVertexAlpha)
+		actorShader->setUniform("useVertexAlpha", useVertexAlpha);
+	if (newShader || last.meshAlpha != meshAlpha)
+		actorShader->setUniform1f("meshAlpha", meshAlpha);
+
+	last.shader = actorShader;
+	last.textured = textured;
+	last.swapRandB = swapRandB;
+	last.useVertexAlpha = useVertexAlpha;
+	last.meshAlpha = meshAlpha;
 
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, face->_indicesEBO);
 
@@ -1053,6 +1072,7 @@ void GfxOpenGLS::drawSprite(const Sprite *sprite) {
 	extraMatrix.transpose();
 	_spriteProgram->setUniform("extraMatrix", extraMatrix);
 	_spriteProgram->setUniform("textured", GL_TRUE);
+	_emiFaceUniforms.shader = nullptr;
 	_spriteProgram->setUniform("swapRandB", _selectedTexture->_colorFormat == BM_BGRA || _selectedTexture->_colorFormat == BM_BGR888);
 	if (g_grim->getGameType() == GType_GRIM) {
 		_spriteProgram->setUniform1f("alphaRef", 0.5f);
@@ -217,6 +217,17 @@ protected:
 	void createSpecialtyTextureFromScreen(uint id, uint8 *data, int x, int y, int width, int height) override;
 
 private:
+	// Per face uniforms last set by drawEMIModelFace() since the last
+	// startActorDraw(), so that they are only updated when they change
+	struct EMIFaceUniforms {
+		OpenGL::ShaderGL *shader;
+		bool textured;
+		bool swapRandB;
+		bool useVertexAlpha;
+		float meshAlpha;
+	};
+	EMIFaceUniforms _emiFaceUniforms;
+
 	const Actor *_currentActor;
 	float _alpha;
 	int _maxLights;
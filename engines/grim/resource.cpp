@@ -53,6 +53,8 @@
 #include "common/config-manager.h"
 #include "common/translation.h"
 
+#include "engines/util.h"
+
 namespace Grim {
 
 ResourceLoader *g_resourceloader = nullptr;
@@ -72,9 +74,11 @@ public:
 	}
 };
 
-ResourceLoader::ResourceLoader() {
-	_cacheDirty = false;
-	_cacheMemorySize = 0;
+// Total size of the files kept in memory by openNewStreamFile(), when
+// the resource memory budget is unknown
+static const uint32 kCacheMaxSize = 64 * 1024 * 1024;
+
+ResourceLoader::ResourceLoader() : _cache(getResourceMemoryBudget(kCacheMaxSize)) {
 
 	Lab *l;
 	Common::ArchiveMemberList files, updFiles;
@@ -229,11 +233,6 @@ void clearList(Common::List<T> &list) {
 }
 
 ResourceLoader::~ResourceLoader() {
-	for (Common::Array<ResourceCache>::iterator i = _cache.begin(); i != _cache.end(); ++i) {
-		ResourceCache &r = *i;
-		delete[] r.fname;
-		delete[] r.resPtr;
-	}
 	clearList(_models);
 	clearList(_colormaps);
 	clearList(_keyframeAnims);
@@ -241,34 +240,6 @@ ResourceLoader::~ResourceLoader() {
 	MD5Check::clear();
 }
 
-static int sortCallback(const void *entry1, const void *entry2) {
-	return scumm_stricmp(((const ResourceLoader::ResourceCache *)entry1)->fname, ((const ResourceLoader::ResourceCache *)entry2)->fname);
-}
-
-Common::SeekableReadStream *ResourceLoader::getFileFromCache(const Common::String &filename) const {
-	ResourceLoader::ResourceCache *entry = getEntryFromCache(filename);
-	if (!entry)
-		return nullptr;
-
-	return new Common::MemoryReadStream(entry->resPtr, entry->len);
-
-}
-
-ResourceLoader::ResourceCache *ResourceLoader::getEntryFromCache(const Common::String &filename) const {
-	if (_cache.empty())
-		return nullptr;
-
-	if (_cacheDirty) {
-		qsort(_cache.begin(), _cache.size(), sizeof(ResourceCache), sortCallback);
-		_cacheDirty = false;
-	}
-
-	ResourceCache key;
-	key.fname = const_cast<char *>(filename.c_str());
-
-	return (ResourceLoader::ResourceCache *)bsearch(&key, _cache.begin(), _cache.size(), sizeof(ResourceCache), sortCallback);
-}
-
 Common::SeekableReadStream *ResourceLoader::loadFile(const Common::String &filename) const {
 	Common::SeekableReadStream *rs = nullptr;
 	if (SearchMan.hasFile(filename))
@@ -285,18 +256,17 @@ Common::SeekableReadStream *ResourceLoader::openNewStreamFile(Common::String fna
 	fname.toLowercase();
 
 	if (cache) {
-		s = getFileFromCache(fname);
+		s = _cache.createReadStream(fname);
 		if (!s) {
 			s = loadFile(fname);
 			if (!s)
 				return nullptr;
 
 			uint32 size = s->size();
-			byte *buf = new byte[size];
+			byte *buf = (byte *)malloc(size);
 			s->read(buf, size);
-			putIntoCache(fname, buf, size);
 			delete s;
-			s = new Common::MemoryReadStream(buf, size);
+			s = _cache.add(fname, buf, size);
 		}
 	} else {
 		s = loadFile(fname);
@@ -305,17 +275,6 @@ Common::SeekableReadStream *ResourceLoader::openNewStreamFile(Common::String fna
 	return Common::wrapCompressedReadStream(s);
 }
 
-void ResourceLoader::putIntoCache(const Common::String &fname, byte *res, uint32 len) const {
-	ResourceCache entry;
-	entry.resPtr = res;
-	entry.len = len;
-	entry.fname = new char[fname.size() + 1];
-	strcpy(entry.fname, fname.c_str());
-	_cacheMemorySize += len;
-	_cache.push_back(entry);
-	_cacheDirty = true;
-}
-
 CMap *ResourceLoader::loadColormap(const Common::String &filename) {
 	Common::SeekableReadStream *stream = openNewStreamFile(filename.c_str());
 	if (!stream) {
@@ -562,26 +521,6 @@ Overlay *ResourceLoader::loadOverlay(const Common::String &filename) {
 	return result;
 }
 
-void ResourceLoader::uncache(const char *filename) const {
-	Common::String fname = filename;
-	fname.toLowercase();
-
-	if (_cacheDirty) {
-		qsort(_cache.begin(), _cache.size(), sizeof(ResourceCache), sortCallback);
-		_cacheDirty = false;
-	}
-
-	for (unsigned int i = 0; i < _cache.size(); i++) {
-		if (fname.compareTo(_cache[i].fname) == 0) {
-			delete[] _cache[i].fname;
-			_cacheMemorySize -= _cache[i].len;
-			delete[] _cache[i].resPtr;
-			_cache.remove_at(i);
-			_cacheDirty = true;
-		}
-	}
-}
-
 void ResourceLoader::uncacheModel(Model *m) {
 	_models.remove(m);
 }
@@ -25,6 +25,7 @@
 
 #include "common/archive.h"
 #include "common/array.h"
+#include "common/membercache.h"
 
 #include "engines/grim/object.h"
 
@@ -86,24 +87,14 @@ public:
 	void uncacheLipSync(LipSync *l);
 	void uncacheAnimationEmi(AnimationEmi *a);
 
-	struct ResourceCache {
-		char *fname;
-		byte *resPtr;
-		uint32 len;
-	};
-
 	static Common::String fixFilename(const Common::String &filename, bool append = true);
 
 private:
 	Common::SeekableReadStream *loadFile(const Common::String &filename) const;
-	Common::SeekableReadStream *getFileFromCache(const Common::String &filename) const;
-	ResourceLoader::ResourceCache *getEntryFromCache(const Common::String &filename) const;
-	void putIntoCache(const Common::String &fname, byte *res, uint32 len) const;
-	void uncache(const char *fname) const;
-
-	mutable Common::Array<ResourceCache> _cache;
-	mutable bool _cacheDirty;
-	mutable int32 _cacheMemorySize;
+
+	// Most recently used files opened with caching, up to the resource memory budget.
+	// Streams on evicted files stay valid until they are deleted.
+	mutable Common::ArchiveMemberCache _cache;
 
 	Common::List<EMIModel *> _emiModels;
 	Common::List<Model *> _models;
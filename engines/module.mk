@@ -2,12 +2,14 @@ MODULE := engines
 
 MODULE_OBJS := \
 	advancedDetector.o \
+	detectioncache.o \
 	dialogs.o \
 	engine.o \
 	game.o \
 	metaengine.o \
 	obsolete.o \
-	savestate.o
+	savestate.o \
+	snapshots.o
 
 # Include common rules
 include $(srcdir)/rules.mk
@@ -68,7 +68,7 @@ void MohawkSurface::convertToTrueColor() {
 	_surface = surface;
 }
 
-GraphicsManager::GraphicsManager() {
+GraphicsManager::GraphicsManager() : _cacheUseCounter(0) {
 }
 
 GraphicsManager::~GraphicsManager() {
@@ -85,17 +85,39 @@ void GraphicsManager::clearCache() {
 	}
 
 	_cache.clear();
+	_cacheLastUse.clear();
 	_subImageCache.clear();
 }
 
+void GraphicsManager::trimCache(uint32 maxSize) {
+	uint32 size = 0;
+	for (Common::HashMap<uint16, MohawkSurface *>::iterator it = _cache.begin(); it != _cache.end(); it++) {
+		Graphics::Surface *surface = it->_value->getSurface();
+		size += surface->pitch * surface->h;
+	}
+
+	while (size > maxSize && !_cache.empty()) {
+		Common::HashMap<uint16, MohawkSurface *>::iterator oldest = _cache.begin();
+		for (Common::HashMap<uint16, MohawkSurface *>::iterator it = _cache.begin(); it != _cache.end(); it++)
+			if (_cacheLastUse[it->_key] < _cacheLastUse[oldest->_key])
+				oldest = it;
+
+		Graphics::Surface *surface = oldest->_value->getSurface();
+		size -= surface->pitch * surface->h;
+
+		delete oldest->_value;
+		_cacheLastUse.erase(oldest->_key);
+		_cache.erase(oldest);
+	}
+}
+
 MohawkSurface *GraphicsManager::findImage(uint16 id) {
 	if (!_cache.contains(id))
 		_cache[id] = decodeImage(id);
 
-	// TODO: Probably would be nice to limit the size of the cache
-	// Currently, this can't get large because it is freed on every
-	// card/stack change in Myst/Riven so I'm not worried about it.
-	// Doesn't mean this shouldn't be done in the future.
+	// Images can outlive the card they were loaded for, remember when
+	// they were last used so that trimCache() can free the stale ones
+	_cacheLastUse[id] = ++_cacheUseCounter;
 
 	return _cache[id];
 }
@@ -228,6 +250,7 @@ void GraphicsManager::addImageToCache(uint16 id, MohawkSurface *surface) {
 		error("Image %d already in cache", id);
 
 	_cache[id] = surface;
+	_cacheLastUse[id] = ++_cacheUseCounter;
 }
 
 } // End of namespace Mohawk
@@ -232,6 +232,12 @@ void MohawkEngine_Riven::doFrame() {
 
 	// Update the screen once per frame
 	_system->updateScreen();
+
+	// Use the spare time to decode the backgrounds of the cards
+	// the player may go to next
+	if (!_scriptMan->hasQueuedScripts())
+		_gfx->prefetchNextImage();
+
 	uint32 loopElapsed = _system->getMillis() - loopStart;
 
 	// Cut down on CPU usage
@@ -384,6 +390,7 @@ void MohawkEngine_Riven::changeToStack(uint16 stackId) {
 	_sound->stopAllSLST();
 
 	// Clear the graphics cache; images aren't used across stack boundaries
+	_gfx->clearImagePrefetch();
 	_gfx->clearCache();
 
 	// Clear the old stack files out
@@ -608,9 +615,9 @@ static const RivenSpecialChange rivenSpecialChange[] = {
 void MohawkEngine_Riven::changeToCard(uint16 dest) {
 	debug (1, "Changing to card %d", dest);
 
-	// Clear the graphics cache (images typically aren't used
-	// on different cards).
-	_gfx->clearCache();
+	// Keep the most recently used images around, going back and forth
+	// between neighboring cards is common and decoding takes a while.
+	_gfx->trimCache(kRivenImageCacheSize);
 
 	if (!isGameVariant(GF_DEMO)) {
 		for (byte i = 0; i < ARRAYSIZE(rivenSpecialChange); i++)
@@ -31,6 +31,7 @@
 #include "mohawk/resource.h"
 #include "mohawk/riven.h"
 
+#include "common/algorithm.h"
 #include "common/memstream.h"
 
 namespace Mohawk {
@@ -648,6 +649,40 @@ void RivenCard::enter(bool unkMovies) {
 	}
 
 	runScript(kCardEnterScript);
+
+	prefetchNeighborCards();
+}
+
+void RivenCard::prefetchNeighborCards() {
+	Common::Array<uint16> cards;
+	for (uint i = 0; i < _hotspots.size(); i++) {
+		_hotspots[i]->collectCardChanges(cards);
+	}
+
+	Common::Array<uint16> images;
+	for (uint i = 0; i < cards.size(); i++) {
+		if (cards[i] == _id || !_vm->hasResource(ID_PLST, cards[i]))
+			continue;
+
+		// Read just enough of the picture list to find the
+		// picture drawn by the default load script
+		Common::SeekableReadStream *plst = _vm->getResource(ID_PLST, cards[i]);
+		uint16 recordCount = plst->readUint16BE();
+		for (uint j = 0; j < recordCount; j++) {
+			uint16 index = plst->readUint16BE();
+			uint16 image = plst->readUint16BE();
+			plst->skip(8);
+
+			if (index == 1) {
+				if (Common::find(images.begin(), images.end(), image) == images.end())
+					images.push_back(image);
+				break;
+			}
+		}
+		delete plst;
+	}
+
+	_vm->_gfx->prefetchImages(images);
 }
 
 void RivenCard::initializeZipMode() {
@@ -1340,6 +1375,12 @@ void RivenHotspot::applyScriptPatches(uint32 cardGlobalId) {
 	}
 }
 
+void RivenHotspot::collectCardChanges(Common::Array<uint16> &cards) const {
+	for (uint16 i = 0; i < _scripts.size(); i++) {
+		_scripts[i].script->collectCardChanges(cards);
+	}
+}
+
 bool RivenHotspot::isEnabled() const {
 	return (_flags & kFlagEnabled) != 0;
 }
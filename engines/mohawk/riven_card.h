@@ -144,6 +144,9 @@ public:
 	void dump() const;
 
 private:
+	/** Queue the default background images of the cards the hotspots lead to for decoding */
+	void prefetchNeighborCards();
+
 	void loadCardResource(uint16 id);
 	void loadHotspots(uint16 id);
 	void loadCardPictureList(uint16 id);
@@ -274,6 +277,9 @@ public:
 	/** Apply patches to the hotspot's scripts to fix bugs in the original game scripts */
 	void applyScriptPatches(uint32 cardGlobalId);
 
+	/** Append the destination ids of the card changes the hotspot's scripts can perform */
+	void collectCardChanges(Common::Array<uint16> &cards) const;
+
 	/** Apply patches to the hotspot's properties to fix bugs in the original game scripts */
 	void applyPropertiesPatches(uint32 cardGlobalId);
 
@@ -371,16 +371,35 @@ void RivenGraphics::copyImageToScreen(uint16 image, uint32 left, uint32 top, uin
 	beginScreenUpdate();
 
 	// Clip the width to fit on the screen. Fixes some images.
-	if (left + surface->w > 608)
-		surface->w = 608 - left;
+	// The surface stays cached, so it must not be modified.
+	uint16 width = surface->w;
+	if (left + width > 608)
+		width = 608 - left;
 
 	for (uint16 i = 0; i < surface->h; i++)
-		memcpy(_mainScreen->getBasePtr(left, i + top), surface->getBasePtr(0, i), surface->w * surface->format.bytesPerPixel);
+		memcpy(_mainScreen->getBasePtr(left, i + top), surface->getBasePtr(0, i), width * surface->format.bytesPerPixel);
 
 	_dirtyScreen = true;
 	applyScreenUpdate();
 }
 
+void RivenGraphics::prefetchImages(const Common::Array<uint16> &images) {
+	_prefetchQueue = images;
+}
+
+void RivenGraphics::prefetchNextImage() {
+	if (_prefetchQueue.empty())
+		return;
+
+	uint16 image = _prefetchQueue.remove_at(0);
+	if (_vm->hasResource(ID_TBMP, image))
+		preloadImage(image);
+}
+
+void RivenGraphics::clearImagePrefetch() {
+	_prefetchQueue.clear();
+}
+
 void RivenGraphics::updateScreen() {
 	if (_dirtyScreen) {
 		// Copy to screen if there's no transition. Otherwise transition.
@@ -59,6 +59,11 @@ enum RivenCreditsImageNumber {
 	kRivenCreditsLastImage   = 320
 };
 
+enum {
+	/** Decoded images kept in memory across card changes, about 16 full screen backgrounds */
+	kRivenImageCacheSize = 8 * 1024 * 1024
+};
+
 class RivenGraphics : public GraphicsManager {
 public:
 	explicit RivenGraphics(MohawkEngine_Riven *vm);
@@ -92,6 +97,13 @@ public:
 	/** Update the screen with the water and fly effects */
 	void updateEffects();
 
+	// Image prefetching
+	/** Replace the list of images to decode ahead of time while the game is idle */
+	void prefetchImages(const Common::Array<uint16> &images);
+	/** Decode the next queued image if any */
+	void prefetchNextImage();
+	void clearImagePrefetch();
+
 	// Transitions
 	void scheduleTransition(RivenTransition id, const Common::Rect &rect = Common::Rect(0, 0, 608, 392));
 	void runScheduledTransition();
@@ -123,6 +135,8 @@ private:
 	WaterEffect *_waterEffect;
 	FliesEffect *_fliesEffect;
 
+	Common::Array<uint16> _prefetchQueue;
+
 	// Transitions
 	RivenTransition _scheduledTransition;
 	Common::Rect _transitionRect;
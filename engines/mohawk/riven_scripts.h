@@ -128,6 +128,9 @@ public:
 	/** Print script details to the standard output */
 	void dumpScript(byte tabs);
 
+	/** Append the destination ids of the card changes the script can perform */
+	void collectCardChanges(Common::Array<uint16> &cards) const;
+
 	/** Apply patches to card script to fix bugs in the original game scripts */
 	void applyCardPatches(MohawkEngine_Riven *vm, uint32 cardGlobalId, uint16 scriptType, uint16 hotspotId);
 
@@ -267,6 +270,9 @@ public:
 	/** Apply card patches for the command's sub-scripts */
 	virtual void applyCardPatches(uint32 globalId, int scriptType, uint16 hotspotId) {}
 
+	/** Append the destination ids of the card changes the command can perform */
+	virtual void collectCardChanges(Common::Array<uint16> &cards) const {}
+
 protected:
 	MohawkEngine_Riven *_vm;
 };
@@ -291,6 +297,7 @@ public:
 	void dump(byte tabs) override;
 	void execute() override;
 	RivenCommandType getType() const override;
+	void collectCardChanges(Common::Array<uint16> &cards) const override;
 
 private:
 	typedef void (RivenSimpleCommand::*OpcodeProcRiven)(uint16 op, const ArgumentArray &args);
@@ -365,6 +372,7 @@ public:
 	void execute() override;
 	RivenCommandType getType() const override;
 	void applyCardPatches(uint32 globalId, int scriptType, uint16 hotspotId) override;
+	void collectCardChanges(Common::Array<uint16> &cards) const override;
 
 private:
 	RivenSwitchCommand(MohawkEngine_Riven *vm);
@@ -177,6 +177,18 @@ bool Renderer::isCubeFaceVisible(uint face) {
 	return _frustum.isInside(_cubeFacesAABB[face]);
 }
 
+bool Renderer::isTexturedRect3DVisible(const Math::Vector3d &topLeft, const Math::Vector3d &bottomLeft,
+                                       const Math::Vector3d &topRight, const Math::Vector3d &bottomRight) {
+	// The renderers mirror the X axis when drawing 3D rectangles
+	Math::AABB aabb;
+	aabb.expand(Math::Vector3d(-topLeft.x(), topLeft.y(), topLeft.z()));
+	aabb.expand(Math::Vector3d(-bottomLeft.x(), bottomLeft.y(), bottomLeft.z()));
+	aabb.expand(Math::Vector3d(-topRight.x(), topRight.y(), topRight.z()));
+	aabb.expand(Math::Vector3d(-bottomRight.x(), bottomRight.y(), bottomRight.z()));
+
+	return _frustum.isInside(aabb);
+}
+
 void Renderer::flipVertical(Graphics::Surface *s) {
 	for (int y = 0; y < s->h / 2; ++y) {
 		// Flip the lines
@@ -162,6 +162,8 @@ public:
 	void setupCameraPerspective(float pitch, float heading, float fov);
 
 	bool isCubeFaceVisible(uint face);
+	bool isTexturedRect3DVisible(const Math::Vector3d &topLeft, const Math::Vector3d &bottomLeft,
+	                             const Math::Vector3d &topRight, const Math::Vector3d &bottomRight);
 
 	Math::Matrix4 getMvpMatrix() const { return _mvpMatrix; }
 
@@ -39,6 +39,8 @@ Movie::Movie(Myst3Engine *vm, uint16 id) :
 		_startFrame(0),
 		_endFrame(0),
 		_texture(0),
+		_decodedFrame(nullptr),
+		_textureDirty(false),
 		_force2d(false),
 		_forceOpaque(false),
 		_subtitles(0),
@@ -129,6 +131,8 @@ void Movie::loadPosition(const ResourceDescription::VideoData &videoData) {
 }
 
 void Movie::draw2d() {
+	uploadTexture();
+
 	Common::Rect screenRect = Common::Rect(_bink.getWidth(), _bink.getHeight());
 	screenRect.translate(_posU, _posV);
 
@@ -141,6 +145,12 @@ void Movie::draw2d() {
 }
 
 void Movie::draw3d() {
+	// Movies looking away from the camera keep decoding,
+	// but their frames don't need to be uploaded
+	if (!_vm->_gfx->isTexturedRect3DVisible(_pTopLeft, _pBottomLeft, _pTopRight, _pBottomRight))
+		return;
+
+	uploadTexture();
 	_vm->_gfx->drawTexturedRect3D(_pTopLeft, _pBottomLeft, _pTopRight, _pBottomRight, _texture);
 }
 
@@ -169,10 +179,21 @@ void Movie::drawNextFrameToTexture() {
 	const Graphics::Surface *frame = _bink.decodeNextFrame();
 
 	if (frame) {
-		if (_texture)
-			_texture->update(frame);
-		else
+		if (_texture) {
+			// Several frames may be decoded between two draws,
+			// only the last one needs to be uploaded
+			_decodedFrame = frame;
+			_textureDirty = true;
+		} else {
 			_texture = _vm->_gfx->createTexture(frame);
+		}
+	}
+}
+
+void Movie::uploadTexture() {
+	if (_textureDirty) {
+		_texture->update(_decodedFrame);
+		_textureDirty = false;
 	}
 }
 
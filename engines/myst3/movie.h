@@ -75,6 +75,10 @@ protected:
 	Video::BinkDecoder _bink;
 	Texture *_texture;
 
+	/** Last decoded frame, owned by the decoder. Uploaded when the movie is drawn. */
+	const Graphics::Surface *_decodedFrame;
+	bool _textureDirty;
+
 	int32 _startFrame;
 	int32 _endFrame;
 
@@ -86,6 +90,7 @@ protected:
 	int32 adjustFrameForRate(int32 frame, bool dataToBink);
 	void loadPosition(const ResourceDescription::VideoData &videoData);
 	void drawNextFrameToTexture();
+	void uploadTexture();
 
 	void draw2d();
 	void draw3d();
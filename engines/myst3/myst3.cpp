@@ -20,6 +20,7 @@
  *
  */
 
+#include "common/algorithm.h"
 #include "common/debug-channels.h"
 #include "common/events.h"
 #include "common/error.h"
@@ -71,7 +72,7 @@ Myst3Engine::Myst3Engine(OSystem *syst, const Myst3GameDescription *version) :
 		_inputSpacePressed(false), _inputEnterPressed(false),
 		_inputEscapePressed(false), _inputTildePressed(false),
 		_inputEscapePressedNotConsumed(false),
-		_interactive(false),
+		_interactive(false), _cubeFaceCacheSize(0), _cubeFaceCacheTick(0),
 		_menuAction(0), _projectorBackground(0),
 		_shakeEffect(0), _rotationEffect(0),
 		_backgroundSoundScriptLastRoomId(0),
@@ -107,6 +108,7 @@ Myst3Engine::Myst3Engine(OSystem *syst, const Myst3GameDescription *version) :
 }
 
 Myst3Engine::~Myst3Engine() {
+	clearCubeFaceCache();
 	closeArchives();
 
 	delete _menu;
@@ -207,6 +209,7 @@ Common::Error Myst3Engine::run() {
 		}
 
 		drawFrame();
+		prefetchCubeFace();
 	}
 
 	unloadNode();
@@ -823,6 +826,7 @@ void Myst3Engine::goToNode(uint16 nodeID, TransitionType transitionType) {
 
 void Myst3Engine::loadNode(uint16 nodeID, uint32 roomID, uint32 ageID) {
 	unloadNode();
+	_cubeFacePrefetchQueue.clear();
 
 	_scriptEngine->run(&_db->getNodeInitScript());
 
@@ -862,6 +866,8 @@ void Myst3Engine::loadNode(uint16 nodeID, uint32 roomID, uint32 ageID) {
 	_shakeEffect = ShakeEffect::create(this);
 	_rotationEffect = RotationEffect::create(this);
 
+	queueNeighbourCubeFaces();
+
 	// WORKAROUND: In Narayan, the scripts in node NACH 9 test on var 39
 	// without first reinitializing it leading to Saavedro not always giving
 	// Releeshan to the player when he is trapped between both shields.
@@ -1402,6 +1408,149 @@ Graphics::Surface *Myst3Engine::decodeJpeg(const ResourceDescription *jpegDesc)
 	return rgbaSurface;
 }
 
+Graphics::Surface *Myst3Engine::decodeCubeFace(const Common::String &room, uint16 nodeID, uint16 face) {
+	ResourceDescription jpegDesc = getFileDescription(room, nodeID, face, Archive::kCubeFace);
+	if (!jpegDesc.isValid())
+		return nullptr;
+
+	return decodeJpeg(&jpegDesc);
+}
+
+static Common::String cubeFaceKey(const Common::String &room, uint16 nodeID, uint16 face) {
+	return Common::String::format("%s-%d-%d", room.c_str(), nodeID, face);
+}
+
+Graphics::Surface *Myst3Engine::loadCubeFace(uint16 nodeID, uint16 face) {
+	Common::String room = _db->getRoomName(_state->getLocationRoom(), _state->getLocationAge());
+	Common::String key = cubeFaceKey(room, nodeID, face);
+
+	CubeFaceCache::iterator it = _cubeFaceCache.find(key);
+	if (it == _cubeFaceCache.end()) {
+		Graphics::Surface *bitmap = decodeCubeFace(room, nodeID, face);
+		if (!bitmap)
+			error("Face %d does not exist", nodeID);
+
+		addCubeFaceToCache(key, bitmap);
+		it = _cubeFaceCache.find(key);
+	}
+
+	it->_value.lastUse = ++_cubeFaceCacheTick;
+
+	// Spot items are drawn onto the face bitmaps, the cached copy must stay pristine
+	Graphics::Surface *bitmap = new Graphics::Surface();
+	bitmap->copyFrom(*it->_value.bitmap);
+	return bitmap;
+}
+
+void Myst3Engine::addCubeFaceToCache(const Common::String &key, Graphics::Surface *bitmap) {
+	static const uint32 kCubeFaceCacheMaxSize = 64 * 1024 * 1024;
+
+	uint32 size = bitmap->pitch * bitmap->h;
+
+	// Evict the least recently used faces until the new one fits
+	while (!_cubeFaceCache.empty() && _cubeFaceCacheSize + size > kCubeFaceCacheMaxSize) {
+		CubeFaceCache::iterator oldest = _cubeFaceCache.begin();
+		for (CubeFaceCache::iterator it = _cubeFaceCache.begin(); it != _cubeFaceCache.end(); ++it) {
+			if (it->_value.lastUse < oldest->_value.lastUse)
+				oldest = it;
+		}
+
+		Graphics::Surface *evicted = oldest->_value.bitmap;
+		_cubeFaceCacheSize -= evicted->pitch * evicted->h;
+		evicted->free();
+		delete evicted;
+		_cubeFaceCache.erase(oldest);
+	}
+
+	CachedCubeFace &entry = _cubeFaceCache[key];
+	entry.bitmap = bitmap;
+	entry.lastUse = ++_cubeFaceCacheTick;
+	_cubeFaceCacheSize += size;
+}
+
+void Myst3Engine::clearCubeFaceCache() {
+	for (CubeFaceCache::iterator it = _cubeFaceCache.begin(); it != _cubeFaceCache.end(); ++it) {
+		it->_value.bitmap->free();
+		delete it->_value.bitmap;
+	}
+
+	_cubeFaceCache.clear();
+	_cubeFaceCacheSize = 0;
+	_cubeFacePrefetchQueue.clear();
+}
+
+void Myst3Engine::queueNeighbourCubeFaces() {
+	static const uint kMaxPrefetchedNodes = 4;
+
+	if (_state->getViewType() != kCube)
+		return;
+
+	uint16 currentNode = _state->getLocationNode();
+	NodePtr nodeData = _db->getNodeData(currentNode, _state->getLocationRoom(), _state->getLocationAge());
+	if (!nodeData)
+		return;
+
+	Common::String room = _db->getRoomName(_state->getLocationRoom(), _state->getLocationAge());
+
+	// The nodes the player can walk to are the targets of the
+	// go to node opcodes in the hotspot scripts of the current node
+	Common::Array<uint16> neighbours;
+	for (uint i = 0; i < nodeData->hotspots.size(); i++) {
+		const Common::Array<Opcode> &script = nodeData->hotspots[i].script;
+		for (uint j = 0; j < script.size(); j++) {
+			switch (script[j].op) {
+			case 136: // goToNodeTransition
+			case 137: // goToNodeTrans2
+			case 138: // goToNodeTrans1
+			case 140: // zipToNode
+				break;
+			default:
+				continue;
+			}
+
+			int16 target = script[j].args[0];
+			if (target <= 0 || target == currentNode)
+				continue; // Variable references and the current node
+
+			if (Common::find(neighbours.begin(), neighbours.end(), (uint16)target) == neighbours.end()
+					&& neighbours.size() < kMaxPrefetchedNodes)
+				neighbours.push_back(target);
+		}
+	}
+
+	for (uint i = 0; i < neighbours.size(); i++) {
+		for (uint16 face = 1; face <= 6; face++) {
+			if (_cubeFaceCache.contains(cubeFaceKey(room, neighbours[i], face)))
+				continue;
+
+			PrefetchedCubeFace entry;
+			entry.room = room;
+			entry.nodeID = neighbours[i];
+			entry.face = face;
+			_cubeFacePrefetchQueue.push_back(entry);
+		}
+	}
+}
+
+void Myst3Engine::prefetchCubeFace() {
+	// Only decode one face per frame so the prefetching does not cause hitches itself
+	while (!_cubeFacePrefetchQueue.empty()) {
+		PrefetchedCubeFace entry = _cubeFacePrefetchQueue.front();
+		_cubeFacePrefetchQueue.remove_at(0);
+
+		Common::String key = cubeFaceKey(entry.room, entry.nodeID, entry.face);
+		if (_cubeFaceCache.contains(key))
+			continue;
+
+		Graphics::Surface *bitmap = decodeCubeFace(entry.room, entry.nodeID, entry.face);
+		if (!bitmap)
+			continue; // Not a cube node
+
+		addCubeFaceToCache(key, bitmap);
+		return;
+	}
+}
+
 int16 Myst3Engine::openDialog(uint16 id) {
 	Dialog *dialog;
 
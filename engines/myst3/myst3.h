@@ -26,6 +26,8 @@
 #include "engines/engine.h"
 
 #include "common/array.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
 #include "common/ptr.h"
 #include "common/system.h"
 #include "common/random.h"
@@ -134,6 +136,14 @@ public:
 	Graphics::Surface *loadTexture(uint16 id);
 	static Graphics::Surface *decodeJpeg(const ResourceDescription *jpegDesc);
 
+	/**
+	 * Get a copy of a face of a cube node from the current room
+	 *
+	 * Faces are served from the decoded face cache when possible.
+	 * The caller owns the returned surface.
+	 */
+	Graphics::Surface *loadCubeFace(uint16 nodeID, uint16 face);
+
 	void goToNode(uint16 nodeID, TransitionType transition);
 	void loadNode(uint16 nodeID, uint32 roomID = 0, uint32 ageID = 0);
 	void unloadNode();
@@ -223,6 +233,29 @@ private:
 
 	bool _interactive;
 
+	struct CachedCubeFace {
+		Graphics::Surface *bitmap;
+		uint32 lastUse;
+	};
+
+	struct PrefetchedCubeFace {
+		Common::String room;
+		uint16 nodeID;
+		uint16 face;
+	};
+
+	typedef Common::HashMap<Common::String, CachedCubeFace> CubeFaceCache;
+
+	/**
+	 * Decoded faces of the recently visited cube nodes and of their
+	 * neighbours, so that moving between nodes does not stall on
+	 * decoding six JPEG images.
+	 */
+	CubeFaceCache _cubeFaceCache;
+	uint32 _cubeFaceCacheSize;
+	uint32 _cubeFaceCacheTick;
+	Common::Array<PrefetchedCubeFace> _cubeFacePrefetchQueue;
+
 	uint32 _backgroundSoundScriptLastRoomId;
 	uint32 _backgroundSoundScriptLastAgeId;
 
@@ -245,6 +278,12 @@ private:
 
 	bool isInventoryVisible();
 
+	Graphics::Surface *decodeCubeFace(const Common::String &room, uint16 nodeID, uint16 face);
+	void addCubeFaceToCache(const Common::String &key, Graphics::Surface *bitmap);
+	void clearCubeFaceCache();
+	void queueNeighbourCubeFaces();
+	void prefetchCubeFace();
+
 	void interactWithHoveredElement();
 
 	friend class Console;
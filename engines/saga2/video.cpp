@@ -46,8 +46,12 @@ void Saga2Engine::startVideo(const char *fileName, int x, int y) {
 	Common::strlcat(file, fileName, 260);
 	nameCheck(file, VIDEO_EXT, 260);
 
-	if (!_smkDecoder)
+	if (!_smkDecoder) {
 		_smkDecoder = new Video::SmackerDecoder();
+		// The videos are big and usually played from the CD
+		_smkDecoder->setReadAhead(8);
+		_smkDecoder->setDecodeAhead(4);
+	}
 
 	if (!_smkDecoder->loadFile(file)) {
 		warning("startVideo: Cannot open file %s", file);
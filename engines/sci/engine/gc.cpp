@@ -22,6 +22,7 @@
 
 #include "sci/engine/gc.h"
 #include "common/array.h"
+#include "common/system.h"
 #include "sci/graphics/ports.h"
 
 #ifdef ENABLE_SCI32
@@ -181,6 +182,8 @@ AddrSet *findAllActiveReferences(EngineState *s) {
 
 void run_gc(EngineState *s) {
 	SegManager *segMan = s->_segMan;
+	const uint32 startTime = g_system->getMillis();
+	uint32 freed = 0;
 
 	// Some debug stuff
 	debugC(kDebugLevelGC, "[GC] Running...");
@@ -214,6 +217,8 @@ void run_gc(EngineState *s) {
 				if (!activeRefs->contains(addr)) {
 					// Not found -> we can free it
 					mobj->freeAtAddress(segMan, addr);
+					segMan->invalidateSelectorCache();
+					++freed;
 					debugC(kDebugLevelGC, "[GC] Deallocating %04x:%04x", PRINT_REG(addr));
 #ifdef GC_DEBUG_CODE
 					segcount[type]++;
@@ -226,6 +231,14 @@ void run_gc(EngineState *s) {
 
 	delete activeRefs;
 
+	GCStats &stats = s->gcStats;
+	stats.lastPause = g_system->getMillis() - startTime;
+	stats.maxPause = MAX(stats.maxPause, stats.lastPause);
+	stats.totalPause += stats.lastPause;
+	stats.freed += freed;
+	++stats.runs;
+	debugC(kDebugLevelGC, "[GC] Freed %u objects in %u ms", freed, stats.lastPause);
+
 #ifdef GC_DEBUG_CODE
 	// Output debug summary of garbage collection
 	debugC(kDebugLevelGC, "[GC] Summary:");
@@ -235,4 +248,13 @@ void run_gc(EngineState *s) {
 #endif
 }
 
+void run_deferred_gc(EngineState *s) {
+	if (s->gcCountDown > 0)
+		return;
+
+	s->gcCountDown = s->scriptGCInterval;
+	++s->gcStats.deferredRuns;
+	run_gc(s);
+}
+
 } // End of namespace Sci
@@ -55,6 +55,14 @@ AddrSet *findAllActiveReferences(EngineState *s);
  */
 void run_gc(EngineState *s);
 
+/**
+ * Runs garbage collection if it is due. This is called by kernel functions
+ * which wait for the next frame, so that the time spent collecting garbage is
+ * taken from the wait instead of causing a hitch in the middle of a frame.
+ * @param s The state in which we should gc
+ */
+void run_deferred_gc(EngineState *s);
+
 struct WorklistManager {
 	Common::Array<reg_t> _worklist;
 	AddrSet _map;	// used for 2 contains() calls, inside push() and run_gc()
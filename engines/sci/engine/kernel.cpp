@@ -959,6 +959,8 @@ void script_adjust_opcode_formats() {
 		g_sci->_opcode_formats[op_superP][0] = Script_None;
 	}
 #endif
+
+	initInstructionFormats();
 }
 
 } // End of namespace Sci
@@ -33,6 +33,7 @@
 #include "sci/event.h"
 #include "sci/resource/resource.h"
 #include "sci/engine/features.h"
+#include "sci/engine/gc.h"
 #include "sci/engine/guest_additions.h"
 #include "sci/engine/savegame.h"
 #include "sci/engine/state.h"
@@ -397,6 +398,7 @@ reg_t kTextSize(EngineState *s, int argc, reg_t *argv) {
 reg_t kWait(EngineState *s, int argc, reg_t *argv) {
 	uint16 ticks = argv[0].toUint16();
 
+	run_deferred_gc(s);
 	const uint16 delta = s->wait(ticks);
 
 	if (g_sci->_guestAdditions->kWaitHook()) {
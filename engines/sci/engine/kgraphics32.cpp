@@ -31,6 +31,7 @@
 #include "sci/event.h"
 #include "sci/resource/resource.h"
 #include "sci/engine/features.h"
+#include "sci/engine/gc.h"
 #include "sci/engine/state.h"
 #include "sci/engine/selector.h"
 #include "sci/engine/kernel.h"
@@ -242,6 +243,7 @@ reg_t kGetHighPlanePri(EngineState *s, int argc, reg_t *argv) {
 
 reg_t kFrameOut(EngineState *s, int argc, reg_t *argv) {
 	bool showBits = argc > 0 ? argv[0].toUint16() : true;
+	run_deferred_gc(s);
 	g_sci->_gfxFrameout->kernelFrameOut(showBits);
 	s->_eventCounter = 0;
 	return s->r_acc;
@@ -21,6 +21,7 @@
  */
 
 #include "common/config-manager.h"
+#include "common/profiler.h"
 #include "common/savefile.h"
 #include "common/system.h"
 #include "common/translation.h"
@@ -60,6 +61,9 @@ reg_t kRestartGame16(EngineState *s, int argc, reg_t *argv) {
 ** Returns the restarting_flag in acc
 */
 reg_t kGameIsRestarting(EngineState *s, int argc, reg_t *argv) {
+	// The game scripts call this once per game cycle
+	PROFILE_FRAME();
+
 	s->r_acc = make_reg(0, s->gameIsRestarting);
 
 	if (argc) { // Only happens during replay
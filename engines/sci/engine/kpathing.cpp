@@ -117,10 +117,18 @@ struct Vertex {
 	// Previous vertex in shortest path
 	Vertex *path_prev;
 
+	// A* open and closed set membership
+	bool isOpen, isClosed;
+
+	// Index into the visibility cache, or -1 for single-vertex polygons
+	int cacheIndex;
+
 public:
 	Vertex(const Common::Point &p) : v(p) {
 		costG = HUGE_DISTANCE;
 		path_prev = NULL;
+		isOpen = isClosed = false;
+		cacheIndex = -1;
 	}
 };
 
@@ -256,6 +264,13 @@ struct PathfindingState {
 	// Total number of vertices
 	int vertices;
 
+	// Vertices which start a polygon edge
+	Common::Array<Vertex *> edges;
+
+	// Visibility between polygon vertices, shared between kAvoidPath calls
+	byte *visibility;
+	int cachedVertices;
+
 	// Point to prepend and append to final path
 	Common::Point *_prependPoint;
 	Common::Point *_appendPoint;
@@ -270,6 +285,8 @@ struct PathfindingState {
 		_prependPoint = NULL;
 		_appendPoint = NULL;
 		vertices = 0;
+		visibility = NULL;
+		cachedVertices = 0;
 	}
 
 	~PathfindingState() {
@@ -705,36 +722,67 @@ static int inside(const Common::Point &p, Vertex *vertex) {
  * @param vertex_cur	the vertex
  * @return list of vertices that are visible from vert
  */
-static VertexList *visible_vertices(PathfindingState *s, Vertex *vertex_cur) {
-	VertexList *visVerts = new VertexList();
+static bool is_visible(PathfindingState *s, Vertex *vertex_cur, Vertex *vertex) {
+	// Make sure we don't intersect a polygon locally at the vertices
+	if ((vertex == vertex_cur) || (inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
+		return false;
 
-	for (int i = 0; i < s->vertices; i++) {
-		Vertex *vertex = s->vertex_index[i];
+	const Common::Point &a = vertex_cur->v;
+	const Common::Point &b = vertex->v;
+	const int16 minX = MIN(a.x, b.x), maxX = MAX(a.x, b.x);
+	const int16 minY = MIN(a.y, b.y), maxY = MAX(a.y, b.y);
+	const bool degenerate = (a == b);
+
+	// Check for intersecting edges
+	for (uint j = 0; j < s->edges.size(); j++) {
+		Vertex *edge = s->edges[j];
+		const Common::Point &c = edge->v;
+		const Common::Point &d = CLIST_NEXT(edge)->v;
+
+		// Edges outside the bounding box of the line can neither contain
+		// one of its points nor properly intersect it
+		if (!degenerate &&
+			(MAX(c.x, d.x) < minX || MIN(c.x, d.x) > maxX ||
+			 MAX(c.y, d.y) < minY || MIN(c.y, d.y) > maxY))
+			continue;
+
+		if (between(a, b, c)) {
+			// If we hit a vertex, make sure we can pass through it without intersecting its polygon
+			if ((inside(a, edge)) || (inside(b, edge)))
+				return false;
 
-		// Make sure we don't intersect a polygon locally at the vertices
-		if ((vertex == vertex_cur) || (inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
+			// This edge won't properly intersect, so we continue
 			continue;
+		}
 
-		// Check for intersecting edges
-		int j;
-		for (j = 0; j < s->vertices; j++) {
-			Vertex *edge = s->vertex_index[j];
-			if (VERTEX_HAS_EDGES(edge)) {
-				if (between(vertex_cur->v, vertex->v, edge->v)) {
-					// If we hit a vertex, make sure we can pass through it without intersecting its polygon
-					if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
-						break;
-
-					// This edge won't properly intersect, so we continue
-					continue;
-				}
+		if (intersect_proper(a, b, c, d))
+			return false;
+	}
 
-				if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
-					break;
+	return true;
+}
+
+static VertexList *visible_vertices(PathfindingState *s, Vertex *vertex_cur) {
+	VertexList *visVerts = new VertexList();
+
+	for (int i = 0; i < s->vertices; i++) {
+		Vertex *vertex = s->vertex_index[i];
+		bool visible;
+
+		// Visibility between two polygon vertices only depends on the
+		// polygon edges, so it can be reused for as long as they don't change
+		if (vertex_cur->cacheIndex >= 0 && vertex->cacheIndex >= 0) {
+			byte &cached = s->visibility[vertex_cur->cacheIndex * s->cachedVertices + vertex->cacheIndex];
+			if (!cached) {
+				cached = is_visible(s, vertex_cur, vertex) ? 1 : 2;
+				s->visibility[vertex->cacheIndex * s->cachedVertices + vertex_cur->cacheIndex] = cached;
 			}
+			visible = (cached == 1);
+		} else {
+			visible = is_visible(s, vertex_cur, vertex);
 		}
 
-		if (j == s->vertices)
+		if (visible)
 			visVerts->push_front(vertex);
 	}
 
@@ -1348,6 +1396,44 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 	return pf_s;
 }
 
+/**
+ * Collects the polygon edges of the pathfinding state and attaches it to the
+ * visibility cache. The cache is emptied if the polygon edges differ from the
+ * ones of the previous call.
+ * Parameters: (PathfindingState *) s: The pathfinding state
+ *             (AvoidPathCache &) cache: The visibility cache
+ */
+static void attach_visibility_cache(PathfindingState *s, AvoidPathCache &cache) {
+	Common::Array<int16> key;
+
+	for (int i = 0; i < s->vertices; i++) {
+		Vertex *vertex = s->vertex_index[i];
+		if (VERTEX_HAS_EDGES(vertex)) {
+			vertex->cacheIndex = s->edges.size();
+			s->edges.push_back(vertex);
+		}
+	}
+
+	key.reserve(s->edges.size() * 3);
+	for (uint i = 0; i < s->edges.size(); i++) {
+		const Vertex *vertex = s->edges[i];
+		key.push_back(vertex->v.x);
+		key.push_back(vertex->v.y);
+		key.push_back(CLIST_NEXT(vertex)->cacheIndex);
+	}
+
+	const uint size = s->edges.size() * s->edges.size();
+	if (key != cache.key || cache.visibility.size() != size) {
+		debugC(kDebugLevelAvoidPath, "[avoidpath] Polygons changed, resetting visibility cache (%u vertices)", s->edges.size());
+		cache.key = key;
+		cache.visibility.clear();
+		cache.visibility.resize(size);
+	}
+
+	s->visibility = cache.visibility.data();
+	s->cachedVertices = s->edges.size();
+}
+
 /**
  * Computes a shortest path from vertex_start to vertex_end. The caller can
  * construct the resulting path by following the path_prev links from
@@ -1356,13 +1442,12 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
  * Parameters: (PathfindingState *) s: The pathfinding state
  */
 static void AStar(PathfindingState *s) {
-	// Vertices of which the shortest path is known
-	VertexList closedSet;
-
-	// The remaining vertices
+	// The remaining vertices. Vertices of which the shortest path is known
+	// are flagged as closed.
 	VertexList openSet;
 
 	openSet.push_front(s->vertex_start);
+	s->vertex_start->isOpen = true;
 	s->vertex_start->costG = 0;
 	s->vertex_start->costF = (uint32)sqrt((float)s->vertex_start->v.sqrDist(s->vertex_end->v));
 
@@ -1388,7 +1473,8 @@ static void AStar(PathfindingState *s) {
 			break;
 
 		// Move vertex from set open to set closed
-		closedSet.push_front(vertex_min);
+		vertex_min->isOpen = false;
+		vertex_min->isClosed = true;
 		openSet.erase(vertex_min_it);
 
 		VertexList *visVerts = visible_vertices(s, vertex_min);
@@ -1397,11 +1483,13 @@ static void AStar(PathfindingState *s) {
 			uint32 new_dist;
 			Vertex *vertex = *it;
 
-			if (closedSet.contains(vertex))
+			if (vertex->isClosed)
 				continue;
 
-			if (!openSet.contains(vertex))
+			if (!vertex->isOpen) {
 				openSet.push_front(vertex);
+				vertex->isOpen = true;
+			}
 
 			new_dist = vertex_min->costG + (uint32)sqrt((float)vertex_min->v.sqrDist(vertex->v));
 
@@ -1624,7 +1712,9 @@ reg_t kAvoidPath(EngineState *s, int argc, reg_t *argv) {
 			return output;
 		}
 
-		// Apply Dijkstra
+		attach_visibility_cache(p, s->_avoidPathCache);
+
+		// Apply A*
 		AStar(p);
 
 		output = output_path(p, s);
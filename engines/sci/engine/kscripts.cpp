@@ -46,6 +46,11 @@ reg_t kLoad(EngineState *s, int argc, reg_t *argv) {
 	if (restype == kResourceTypeMemory)
 		return s->_segMan->allocateHunkEntry("kLoad()", resnr);
 
+	// Resources are loaded on demand, but the game tells us here that it
+	// is going to need this one soon, so load it the next time it waits
+	if (restype != kResourceTypeInvalid)
+		g_sci->getResMan()->prefetchResource(ResourceId(restype, resnr));
+
 	return make_reg(0, ((restype << 11) | resnr)); // Return the resource identifier as handle
 }
 
@@ -43,6 +43,10 @@ SegManager::SegManager(ResourceManager *resMan, ScriptPatcher *scriptPatcher)
 	_saveDirPtr = NULL_REG;
 	_parserPtr = NULL_REG;
 
+	for (uint i = 0; i < kSelectorCacheSize; i++)
+		_selectorCache[i].generation = 0;
+	_selectorCacheGeneration = 1;
+
 #ifdef ENABLE_SCI32
 	_arraysSegId = 0;
 	_bitmapSegId = 0;
@@ -56,6 +60,8 @@ SegManager::~SegManager() {
 }
 
 void SegManager::resetSegMan() {
+	invalidateSelectorCache();
+
 	// Free memory
 	for (uint i = 0; i < _heap.size(); i++) {
 		if (_heap[i])
@@ -125,6 +131,7 @@ SegmentObj *SegManager::allocSegment(SegmentObj *mem, SegmentId *segid) {
 		_heap.push_back(0);
 	}
 	_heap[id] = mem;
+	invalidateSelectorCache();
 
 	return mem;
 }
@@ -182,6 +189,7 @@ void SegManager::deallocate(SegmentId seg) {
 
 	delete mobj;
 	_heap[actualSegment] = NULL;
+	invalidateSelectorCache();
 }
 
 bool SegManager::isHeapObject(reg_t pos) const {
@@ -489,6 +497,7 @@ Clone *SegManager::allocateClone(reg_t *addr) {
 		table = (CloneTable *)_heap[_clonesSegId];
 
 	offset = table->allocEntry();
+	invalidateSelectorCache();
 
 	*addr = make_reg(_clonesSegId, offset);
 	return &table->at(offset);
@@ -1094,6 +1103,7 @@ int SegManager::instantiateScript(int scriptNum, bool applyScriptPatches) {
 	}
 
 	scr->load(scriptNum, _resMan, _scriptPatcher, applyScriptPatches);
+	invalidateSelectorCache();
 	scr->initializeLocals(this);
 	scr->initializeClasses(this);
 	scr->initializeObjects(this, segmentId, applyScriptPatches);
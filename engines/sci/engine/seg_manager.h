@@ -463,7 +463,42 @@ public:
 
 	const Common::Array<SegmentObj *> &getSegments() const { return _heap; }
 
+	// 9. Selector lookup cache
+
+	/**
+	 * A cached result of lookupSelector(). An entry is valid while its
+	 * generation matches the current one.
+	 */
+	struct SelectorCacheEntry {
+		reg_t obj;
+		Selector selector;
+		uint32 generation;
+		SelectorType type;
+		int varIndex;
+		reg_t func;
+	};
+
+	SelectorCacheEntry &getSelectorCacheEntry(reg_t obj, Selector selector) {
+		const uint hash = obj.getOffset() * 31 + obj.getSegment() * 1021 + selector;
+		return _selectorCache[hash & (kSelectorCacheSize - 1)];
+	}
+
+	uint32 getSelectorCacheGeneration() const { return _selectorCacheGeneration; }
+
+	/**
+	 * Forget all cached selector lookups. Must be called whenever objects
+	 * are created or freed, since their addresses get reused.
+	 */
+	void invalidateSelectorCache() { ++_selectorCacheGeneration; }
+
 private:
+	enum {
+		kSelectorCacheSize = 1024
+	};
+
+	SelectorCacheEntry _selectorCache[kSelectorCacheSize];
+	uint32 _selectorCacheGeneration;
+
 	Common::Array<SegmentObj *> _heap;
 	Common::Array<Class> _classTable; /**< Table of all classes */
 	/** Map script ids to segment ids. */
@@ -327,48 +327,53 @@ void invokeSelector(EngineState *s, reg_t object, int selectorId,
 }
 
 SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector selectorId, ObjVarRef *varp, reg_t *fptr) {
-	const Object *obj = segMan->getObject(obj_location);
-	int index;
-	bool oldScriptHeader = (getSciVersion() == SCI_VERSION_0_EARLY);
-
 	// Early SCI versions used the LSB in the selector ID as a read/write
 	// toggle, meaning that we must remove it for selector lookup.
-	if (oldScriptHeader)
+	if (getSciVersion() == SCI_VERSION_0_EARLY)
 		selectorId &= ~1;
 
-	if (!obj) {
-		const SciCallOrigin origin = g_sci->getEngineState()->getCurrentCallOrigin();
-		error("lookupSelector: Attempt to send to non-object or invalid script. Address %04x:%04x, %s", PRINT_REG(obj_location), origin.toString().c_str());
-	}
-
-	index = obj->locateVarSelector(segMan, selectorId);
+	// The same selectors are sent to the same objects over and over, e.g.
+	// by the animation and motion code, so the results are cached until
+	// objects get created or freed.
+	SegManager::SelectorCacheEntry &entry = segMan->getSelectorCacheEntry(obj_location, selectorId);
+	if (entry.generation != segMan->getSelectorCacheGeneration() || entry.obj != obj_location || entry.selector != selectorId) {
+		const Object *obj = segMan->getObject(obj_location);
 
-	if (index >= 0) {
-		// Found it as a variable
-		if (varp) {
-			varp->obj = obj_location;
-			varp->varindex = index;
+		if (!obj) {
+			const SciCallOrigin origin = g_sci->getEngineState()->getCurrentCallOrigin();
+			error("lookupSelector: Attempt to send to non-object or invalid script. Address %04x:%04x, %s", PRINT_REG(obj_location), origin.toString().c_str());
 		}
-		return kSelectorVariable;
-	} else {
-		// Check if it's a method, with recursive lookup in superclasses
-		while (obj) {
-			index = obj->funcSelectorPosition(selectorId);
-			if (index >= 0) {
-				if (fptr)
-					*fptr = obj->getFunction(index);
-
-				return kSelectorMethod;
-			} else {
+
+		entry.obj = obj_location;
+		entry.selector = selectorId;
+		entry.generation = segMan->getSelectorCacheGeneration();
+		entry.type = kSelectorNone;
+		entry.varIndex = obj->locateVarSelector(segMan, selectorId);
+
+		if (entry.varIndex >= 0) {
+			// Found it as a variable
+			entry.type = kSelectorVariable;
+		} else {
+			// Check if it's a method, with recursive lookup in superclasses
+			while (obj) {
+				const int index = obj->funcSelectorPosition(selectorId);
+				if (index >= 0) {
+					entry.type = kSelectorMethod;
+					entry.func = obj->getFunction(index);
+					break;
+				}
 				obj = segMan->getObject(obj->getSuperClassSelector());
 			}
 		}
-
-		return kSelectorNone;
 	}
 
-
-//	return _lookupSelector_function(segMan, obj, selectorId, fptr);
+	if (entry.type == kSelectorVariable && varp) {
+		varp->obj = obj_location;
+		varp->varindex = entry.varIndex;
+	} else if (entry.type == kSelectorMethod && fptr) {
+		*fptr = entry.func;
+	}
+	return entry.type;
 }
 
 } // End of namespace Sci
@@ -83,6 +83,8 @@ void EngineState::reset(bool isRestoring) {
 		_memorySegmentSize = 0;
 		_fileHandles.resize(5);
 		abortScriptProcessing = kAbortNone;
+		gcDeferred = true;
+		memset(&gcStats, 0, sizeof(gcStats));
 	} else {
 		g_sci->_guestAdditions->reset();
 	}
@@ -98,6 +98,28 @@ struct SciCallOrigin {
 	}
 };
 
+/**
+ * Run and pause time statistics of the garbage collector.
+ */
+struct GCStats {
+	uint32 runs;		///< Garbage collections run
+	uint32 deferredRuns;	///< Garbage collections postponed to kWait or kFrameOut
+	uint32 freed;		///< Objects freed
+	uint32 lastPause;	///< Duration of the last garbage collection in ms
+	uint32 maxPause;	///< Longest garbage collection in ms
+	uint32 totalPause;	///< Time spent in garbage collection in ms
+};
+
+/**
+ * Remembers which polygon vertices could see each other during earlier
+ * kAvoidPath calls, for as long as the game keeps using the same polygons.
+ * @see kpathing.cpp
+ */
+struct AvoidPathCache {
+	Common::Array<int16> key;	///< Position and successor of every polygon vertex
+	Common::Array<byte> visibility;	///< Visibility of each vertex pair, 0 if not known yet
+};
+
 struct EngineState : public Common::Serializable {
 public:
 	EngineState(SegManager *segMan);
@@ -143,6 +165,8 @@ public:
 
 	uint _chosenQfGImportItem; // Remembers the item selected in QfG import rooms
 
+	AvoidPathCache _avoidPathCache; // Refer to kAvoidPath()
+
 	bool _cursorWorkaroundActive; // Refer to GfxCursor::setPosition()
 	int16 _cursorWorkaroundPosCount; // When the cursor is reported to be at the previously set coordinate, we won't disable the workaround unless it happened for this many times
 	Common::Point _cursorWorkaroundPoint;
@@ -195,6 +219,8 @@ public:
 	void shrinkStackToBase();
 
 	int gcCountDown; /**< Number of kernel calls until next gc */
+	bool gcDeferred; /**< Whether a due gc waits for the next kWait or kFrameOut */
+	GCStats gcStats;
 
 	MessageState *_msgState;
 
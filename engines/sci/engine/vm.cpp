@@ -23,6 +23,7 @@
 #include "common/config-manager.h"
 #include "common/debug.h"
 #include "common/debug-channels.h"
+#include "common/profiler.h"
 
 #include "sci/sci.h"
 #include "sci/console.h"
@@ -381,7 +382,10 @@ static void callKernelFunc(EngineState *s, int kernelCallNr, int argc) {
 	if (!kernelCall.subFunctionCount) {
 		argv[-1] = make_reg(0, argc); // The first argument is argc
 		addKernelCallToExecStack(s, kernelCallNr, -1, argc, argv);
-		s->r_acc = kernelCall.function(s, argc, argv);
+		{
+			PROFILE_ZONE(kernelCall.name);
+			s->r_acc = kernelCall.function(s, argc, argv);
+		}
 
 		if (g_sci->checkKernelBreakpoint(kernelCall.name))
 			logKernelCall(&kernelCall, NULL, s, argc, argv, s->r_acc);
@@ -448,7 +452,10 @@ static void callKernelFunc(EngineState *s, int kernelCallNr, int argc) {
 			error("[VM] k%s: subfunction ID %d requested, but not available", kernelCall.name, subId);
 		argv[-1] = make_reg(0, argc); // The first argument is argc
 		addKernelCallToExecStack(s, kernelCallNr, subId, argc, argv);
-		s->r_acc = kernelSubCall.function(s, argc, argv);
+		{
+			PROFILE_ZONE(kernelSubCall.name);
+			s->r_acc = kernelSubCall.function(s, argc, argv);
+		}
 
 		if (g_sci->checkKernelBreakpoint(kernelSubCall.name))
 			logKernelCall(&kernelCall, &kernelSubCall, s, argc, argv, s->r_acc);
@@ -459,66 +466,107 @@ static void callKernelFunc(EngineState *s, int kernelCallNr, int argc) {
 		s->_executionStack.pop_back();
 }
 
+namespace {
+
+enum OperandType {
+	kOperandNone,	// No data, the parameter stays 0
+	kOperandByte,
+	kOperandSByte,
+	kOperandWord,
+	kOperandSWord,
+	kOperandInvalid
+};
+
+struct InstructionFormat {
+	byte numOperands;
+	byte operands[3];
+};
+
+/**
+ * The operand layout of each extended opcode. The "byte" bit of the extended
+ * opcode is already resolved, so decoding does not need to look at the
+ * opcode formats again for every instruction.
+ */
+InstructionFormat s_instructionFormats[256];
+
+} // End of anonymous namespace
+
+void initInstructionFormats() {
+	for (int extOpcode = 0; extOpcode < 256; ++extOpcode) {
+		const byte opcode = extOpcode >> 1;
+		const bool byteOperands = extOpcode & 1;
+		InstructionFormat &format = s_instructionFormats[extOpcode];
+
+		format.numOperands = 0;
+		for (int i = 0; g_sci->_opcode_formats[opcode][i]; ++i) {
+			assert(i < 3);
+			byte type;
+			switch (g_sci->_opcode_formats[opcode][i]) {
+			case Script_Byte:
+				type = kOperandByte;
+				break;
+			case Script_SByte:
+				type = kOperandSByte;
+				break;
+			case Script_Word:
+				type = kOperandWord;
+				break;
+			case Script_SWord:
+				type = kOperandSWord;
+				break;
+			case Script_Variable:
+			case Script_Property:
+			case Script_Local:
+			case Script_Temp:
+			case Script_Global:
+			case Script_Param:
+			case Script_Offset:
+				type = byteOperands ? kOperandByte : kOperandWord;
+				break;
+			case Script_SVariable:
+			case Script_SRelative:
+				type = byteOperands ? kOperandSByte : kOperandSWord;
+				break;
+			case Script_None:
+			case Script_End:
+				type = kOperandNone;
+				break;
+			case Script_Invalid:
+			default:
+				type = kOperandInvalid;
+				break;
+			}
+			format.operands[format.numOperands++] = type;
+		}
+	}
+}
+
 int readPMachineInstruction(const byte *src, byte &extOpcode, int16 opparams[4]) {
 	uint offset = 0;
 	extOpcode = src[offset++]; // Get "extended" opcode (lower bit has special meaning)
 	const byte opcode = extOpcode >> 1;	// get the actual opcode
+	const InstructionFormat &format = s_instructionFormats[extOpcode];
 
 	memset(opparams, 0, 4*sizeof(int16));
 
-	for (int i = 0; g_sci->_opcode_formats[opcode][i]; ++i) {
-		//debugN("Opcode: 0x%x, Opnumber: 0x%x, temp: %d\n", opcode, opcode, temp);
-		assert(i < 3);
-		switch (g_sci->_opcode_formats[opcode][i]) {
-
-		case Script_Byte:
+	for (int i = 0; i < format.numOperands; ++i) {
+		switch (format.operands[i]) {
+		case kOperandByte:
 			opparams[i] = src[offset++];
 			break;
-		case Script_SByte:
+		case kOperandSByte:
 			opparams[i] = (int8)src[offset++];
 			break;
-
-		case Script_Word:
+		case kOperandWord:
 			opparams[i] = READ_SCI11ENDIAN_UINT16(src + offset);
 			offset += 2;
 			break;
-		case Script_SWord:
+		case kOperandSWord:
 			opparams[i] = (int16)READ_SCI11ENDIAN_UINT16(src + offset);
 			offset += 2;
 			break;
-
-		case Script_Variable:
-		case Script_Property:
-
-		case Script_Local:
-		case Script_Temp:
-		case Script_Global:
-		case Script_Param:
-
-		case Script_Offset:
-			if (extOpcode & 1) {
-				opparams[i] = src[offset++];
-			} else {
-				opparams[i] = READ_SCI11ENDIAN_UINT16(src + offset);
-				offset += 2;
-			}
-			break;
-
-		case Script_SVariable:
-		case Script_SRelative:
-			if (extOpcode & 1) {
-				opparams[i] = (int8)src[offset++];
-			} else {
-				opparams[i] = (int16)READ_SCI11ENDIAN_UINT16(src + offset);
-				offset += 2;
-			}
-			break;
-
-		case Script_None:
-		case Script_End:
+		case kOperandNone:
 			break;
-
-		case Script_Invalid:
 		default:
 			error("opcode %02x: Invalid", extOpcode);
 		}
@@ -906,8 +954,10 @@ void run_vm(EngineState *s) {
 		}
 
 		case op_callk: { // 0x21 (33)
-			// Run the garbage collector, if needed
-			if (s->gcCountDown-- <= 0) {
+			// Run the garbage collector, if needed. Unless disabled, a due
+			// collection waits for the next kWait or kFrameOut, but not for
+			// longer than another interval.
+			if (s->gcCountDown-- <= 0 && (!s->gcDeferred || s->gcCountDown < -s->scriptGCInterval)) {
 				s->gcCountDown = s->scriptGCInterval;
 				run_gc(s);
 			}
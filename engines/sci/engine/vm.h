@@ -326,6 +326,13 @@ enum SciOpcodes {
 
 void script_adjust_opcode_formats();
 
+/**
+ * Resolve the operand layout of every extended opcode from the current
+ * opcode formats, for readPMachineInstruction. Must be called whenever
+ * the opcode formats change.
+ */
+void initInstructionFormats();
+
 /**
  * Executes function pubfunct of the specified script.
  * @param[in] s				The state which is to be executed with
@@ -91,12 +91,26 @@ void CelObj::init() {
 	_drawBlackLines = false;
 	_nextCacheId = 1;
 	_scaler.reset(new CelScaler());
-	_cache.reset(new CelCache(100));
+	_cacheIndex.reset(new CelCacheIndex());
+
+	// SSCI kept up to 100 cels, which is far too few for scenes with many
+	// distinct cels and used to make the cache thrash
+	int capacity = kDefaultCelCacheEntries;
+	if (ConfMan.hasKey("sci_cel_cache_entries")) {
+		capacity = MAX(ConfMan.getInt("sci_cel_cache_entries"), 1);
+	}
+
+	memset(&_cacheStats, 0, sizeof(_cacheStats));
+	_cacheStats.capacity = capacity;
+
+	// Cache entries cannot be moved, so allocate all slots up front
+	_cache.reset(new CelCache(capacity));
 }
 
 void CelObj::deinit() {
 	_scaler.reset();
 	_cache.reset();
+	_cacheIndex.reset();
 }
 
 #pragma mark -
@@ -687,43 +701,55 @@ void CelObj::submitPalette() const {
 
 int CelObj::_nextCacheId = 1;
 Common::ScopedPtr<CelCache> CelObj::_cache;
+Common::ScopedPtr<CelCacheIndex> CelObj::_cacheIndex;
+CelCacheStats CelObj::_cacheStats;
 
 int CelObj::searchCache(const CelInfo32 &celInfo, int *const nextInsertIndex) const {
-	*nextInsertIndex = -1;
-	int oldestId = _nextCacheId + 1;
-	int oldestIndex = 0;
+	CelCacheIndex::const_iterator it = _cacheIndex->find(celInfo);
+	if (it != _cacheIndex->end()) {
+		++_cacheStats.hits;
+		(*_cache)[it->_value].id = ++_nextCacheId;
+		*nextInsertIndex = -1;
+		return it->_value;
+	}
 
-	for (int i = 0, len = _cache->size(); i < len; ++i) {
-		CelCacheEntry &entry = (*_cache)[i];
+	++_cacheStats.misses;
 
-		if (entry.celObj == nullptr) {
-			if (*nextInsertIndex == -1) {
-				*nextInsertIndex = i;
-			}
-		} else if (entry.celObj->_info == celInfo) {
-			entry.id = ++_nextCacheId;
-			return i;
-		} else if (oldestId > entry.id) {
+	if (_cacheStats.entries < _cache->size()) {
+		*nextInsertIndex = _cacheStats.entries;
+		return -1;
+	}
+
+	int oldestId = _nextCacheId + 1;
+	int oldestIndex = 0;
+	for (int i = 0, len = _cacheStats.entries; i < len; ++i) {
+		const CelCacheEntry &entry = (*_cache)[i];
+		if (oldestId > entry.id) {
 			oldestId = entry.id;
 			oldestIndex = i;
 		}
 	}
 
-	if (*nextInsertIndex == -1) {
-		*nextInsertIndex = oldestIndex;
-	}
-
+	*nextInsertIndex = oldestIndex;
 	return -1;
 }
 
 void CelObj::putCopyInCache(const int cacheIndex) const {
-	if (cacheIndex == -1) {
+	if (cacheIndex == -1 || cacheIndex >= (int)_cache->size()) {
 		error("Invalid cache index");
 	}
 
 	CelCacheEntry &entry = (*_cache)[cacheIndex];
+	if (entry.celObj) {
+		_cacheIndex->erase(entry.celObj->_info);
+		++_cacheStats.evictions;
+	} else {
+		++_cacheStats.entries;
+	}
+
 	entry.celObj.reset(duplicate());
 	entry.id = ++_nextCacheId;
+	(*_cacheIndex)[_info] = cacheIndex;
 }
 
 #pragma mark -
@@ -23,6 +23,7 @@
 #ifndef SCI_GRAPHICS_CELOBJ32_H
 #define SCI_GRAPHICS_CELOBJ32_H
 
+#include "common/hashmap.h"
 #include "common/rational.h"
 #include "common/rect.h"
 #include "sci/resource/resource.h"
@@ -106,7 +107,7 @@ struct CelInfo32 {
 
 	// This is the equivalence criteria used by CelObj::searchCache in at least
 	// SSCI SQ6. Notably, it does not check the color field.
-	inline bool operator==(const CelInfo32 &other) {
+	inline bool operator==(const CelInfo32 &other) const {
 		return (
 			type == other.type &&
 			resourceId == other.resourceId &&
@@ -116,7 +117,7 @@ struct CelInfo32 {
 		);
 	}
 
-	inline bool operator!=(const CelInfo32 &other) {
+	inline bool operator!=(const CelInfo32 &other) const {
 		return !(*this == other);
 	}
 
@@ -152,6 +153,40 @@ struct CelCacheEntry {
 
 typedef Common::Array<CelCacheEntry> CelCache;
 
+/**
+ * Hash and equality functions for looking up cache slots by CelInfo32, using
+ * the same equivalence criteria as CelInfo32::operator==.
+ */
+struct CelInfo32Hash {
+	uint operator()(const CelInfo32 &info) const {
+		return (info.type << 28) ^ (info.resourceId << 12) ^ (info.loopNo << 6) ^ info.celNo ^
+			(info.bitmap.getSegment() << 16) ^ info.bitmap.getOffset();
+	}
+};
+
+struct CelInfo32EqualTo {
+	bool operator()(const CelInfo32 &a, const CelInfo32 &b) const {
+		return a == b;
+	}
+};
+
+typedef Common::HashMap<CelInfo32, int, CelInfo32Hash, CelInfo32EqualTo> CelCacheIndex;
+
+enum {
+	/**
+	 * The default number of cels the cel cache holds.
+	 */
+	kDefaultCelCacheEntries = 512
+};
+
+struct CelCacheStats {
+	uint32 hits;		///< Cels found in the cache
+	uint32 misses;		///< Cels which had to be read from their resource
+	uint32 evictions;	///< Cached cels replaced by a newer one
+	uint32 entries;		///< Cels currently in the cache
+	uint32 capacity;	///< Cels the cache may hold
+};
+
 #pragma mark -
 #pragma mark CelScaler
 
@@ -352,6 +387,11 @@ public:
 	 */
 	static void deinit();
 
+	/**
+	 * Returns the current cel cache statistics.
+	 */
+	static const CelCacheStats &getCacheStats() { return _cacheStats; }
+
 	virtual ~CelObj() {};
 
 	/**
@@ -466,11 +506,26 @@ protected:
 	 */
 	static Common::ScopedPtr<CelCache> _cache;
 
+	/**
+	 * Maps the CelInfo32 of each cached cel to its slot in `_cache`.
+	 */
+	static Common::ScopedPtr<CelCacheIndex> _cacheIndex;
+
+	/**
+	 * Size and hit statistics of the cel cache. The cache grows until it
+	 * holds the number of cels set with the `sci_cel_cache_entries` option,
+	 * and replaces the least recently used cels after that. Cached cels
+	 * share their pixel data with the resource manager, so each entry only
+	 * costs the cel object itself.
+	 */
+	static CelCacheStats _cacheStats;
+
 	/**
 	 * Searches the cel cache for a CelObj matching the provided CelInfo32. If
 	 * not found, -1 is returned. `nextInsertIndex` will receive the index of
-	 * the oldest item in the cache, which can be used to replace the oldest
-	 * item with a newer item.
+	 * a free slot, or of the oldest item in the cache once the cache is full,
+	 * which can be used to replace the oldest item with a
+	 * newer item.
 	 */
 	int searchCache(const CelInfo32 &celInfo, int *nextInsertIndex) const;
 
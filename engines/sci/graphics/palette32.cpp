@@ -380,6 +380,7 @@ static const uint8 gammaTables[GfxPalette32::numGammaTables][256] = {
 	_varyDirection(0),
 	_varyPercent(0),
 	_varyTargetPercent(0),
+	_varyBlendPercent(-1),
 	_varyNumTimesPaused(0),
 
 	// Palette cycling
@@ -716,26 +717,27 @@ void GfxPalette32::applyVary() {
 			}
 		}
 	} else {
+		// The blend only depends on the vary percentage and the channel
+		// difference, so the divisions are done once per percentage step
+		// instead of three times per color per frame
+		if (_varyBlendPercent != _varyPercent) {
+			for (int delta = -255; delta <= 255; ++delta) {
+				_varyBlendTable[delta + 255] = (delta * _varyPercent) / 100;
+			}
+			_varyBlendPercent = _varyPercent;
+		}
+
+		const int16 *const blend = _varyBlendTable + 255;
+
 		for (int i = 0; i < ARRAYSIZE(_nextPalette.colors); ++i) {
 			if (i >= _varyFromColor && i <= _varyToColor) {
-				Color targetColor = _varyTargetPalette->colors[i];
-				Color sourceColor;
-
-				if (_varyStartPalette) {
-					sourceColor = _varyStartPalette->colors[i];
-				} else {
-					sourceColor = _sourcePalette.colors[i];
-				}
+				const Color &targetColor = _varyTargetPalette->colors[i];
+				const Color &sourceColor = _varyStartPalette ? _varyStartPalette->colors[i] : _sourcePalette.colors[i];
 
 				Color computedColor;
-
-				int color;
-				color = targetColor.r - sourceColor.r;
-				computedColor.r = ((color * _varyPercent) / 100) + sourceColor.r;
-				color = targetColor.g - sourceColor.g;
-				computedColor.g = ((color * _varyPercent) / 100) + sourceColor.g;
-				color = targetColor.b - sourceColor.b;
-				computedColor.b = ((color * _varyPercent) / 100) + sourceColor.b;
+				computedColor.r = blend[targetColor.r - sourceColor.r] + sourceColor.r;
+				computedColor.g = blend[targetColor.g - sourceColor.g] + sourceColor.g;
+				computedColor.b = blend[targetColor.b - sourceColor.b] + sourceColor.b;
 				computedColor.used = sourceColor.used;
 
 				_nextPalette.colors[i] = computedColor;
@@ -1032,16 +1034,30 @@ void GfxPalette32::fadeOff() {
 }
 
 void GfxPalette32::applyFade() {
+	// Fades are almost always applied with the same intensity to a contiguous
+	// run of colors, so the scaled channel values are only recalculated when
+	// the intensity changes
+	uint8 scaled[256];
+	int lastPercent = -1;
+
 	for (int i = 0; i < ARRAYSIZE(_fadeTable); ++i) {
-		if (_fadeTable[i] == 100) {
+		const uint16 percent = _fadeTable[i];
+		if (percent == 100) {
 			continue;
 		}
 
+		if (percent != lastPercent) {
+			for (uint value = 0; value < ARRAYSIZE(scaled); ++value) {
+				scaled[value] = MIN<uint>(255, value * percent / 100);
+			}
+			lastPercent = percent;
+		}
+
 		Color &color = _nextPalette.colors[i];
 
-		color.r = MIN(255, (uint16)color.r * _fadeTable[i] / 100);
-		color.g = MIN(255, (uint16)color.g * _fadeTable[i] / 100);
-		color.b = MIN(255, (uint16)color.b * _fadeTable[i] / 100);
+		color.r = scaled[color.r];
+		color.g = scaled[color.g];
+		color.b = scaled[color.b];
 	}
 }
 
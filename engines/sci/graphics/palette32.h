@@ -497,6 +497,19 @@ private:
 	 */
 	int16 _varyTargetPercent;
 
+	/**
+	 * The blend offsets for every possible difference between a target and
+	 * source channel value at `_varyBlendPercent`, so that applying a vary
+	 * does not need to divide each channel of every color on every frame.
+	 */
+	int16 _varyBlendTable[511];
+
+	/**
+	 * The vary percentage that `_varyBlendTable` was built for, or -1 if the
+	 * table has not been built yet.
+	 */
+	int16 _varyBlendPercent;
+
 	/**
 	 * The number of times palette varying has been paused.
 	 */
@@ -42,6 +42,78 @@ void DrawList::add(ScreenItem *screenItem, const Common::Rect &rect) {
 	DrawListBase::add(drawItem);
 }
 
+#pragma mark -
+#pragma mark ScreenItemGrid
+
+ScreenItemGrid::ScreenItemGrid(const ScreenItemList &list, const uint count, const Common::Rect &bounds) :
+	_bounds(bounds) {
+	assert(count <= kMaxItems);
+
+	_cellWidth = MAX<int16>(1, (_bounds.width() + kCellsPerSide - 1) / kCellsPerSide);
+	_cellHeight = MAX<int16>(1, (_bounds.height() + kCellsPerSide - 1) / kCellsPerSide);
+	memset(_cells, 0, sizeof(_cells));
+	memset(_selection, 0, sizeof(_selection));
+
+	for (uint i = 0; i < count; ++i) {
+		const ScreenItem *item = list[i];
+		if (item == nullptr) {
+			continue;
+		}
+
+		int x1, y1, x2, y2;
+		getCellRange(item->_screenRect, x1, y1, x2, y2);
+		for (int y = y1; y <= y2; ++y) {
+			for (int x = x1; x <= x2; ++x) {
+				_cells[y * kCellsPerSide + x][i / 32] |= 1 << (i % 32);
+			}
+		}
+	}
+}
+
+void ScreenItemGrid::getCellRange(const Common::Rect &rect, int &x1, int &y1, int &x2, int &y2) const {
+	// Rect::intersects also reports zero-sized rects as intersecting, so
+	// those still need to occupy at least one cell
+	x1 = CLIP<int>((rect.left - _bounds.left) / _cellWidth, 0, kCellsPerSide - 1);
+	x2 = CLIP<int>((MAX(rect.right - 1, (int)rect.left) - _bounds.left) / _cellWidth, 0, kCellsPerSide - 1);
+	y1 = CLIP<int>((rect.top - _bounds.top) / _cellHeight, 0, kCellsPerSide - 1);
+	y2 = CLIP<int>((MAX(rect.bottom - 1, (int)rect.top) - _bounds.top) / _cellHeight, 0, kCellsPerSide - 1);
+}
+
+void ScreenItemGrid::select(const Common::Rect &rect) {
+	memset(_selection, 0, sizeof(_selection));
+
+	int x1, y1, x2, y2;
+	getCellRange(rect, x1, y1, x2, y2);
+	for (int y = y1; y <= y2; ++y) {
+		for (int x = x1; x <= x2; ++x) {
+			const uint32 *cell = _cells[y * kCellsPerSide + x];
+			for (int i = 0; i < kWords; ++i) {
+				_selection[i] |= cell[i];
+			}
+		}
+	}
+}
+
+int ScreenItemGrid::findNext(const uint index) const {
+	uint i = index;
+	while (i < kMaxItems) {
+		uint32 word = _selection[i / 32] >> (i % 32);
+		if (word == 0) {
+			// Skip to the start of the next word
+			i = (i | 31) + 1;
+			continue;
+		}
+
+		while (!(word & 1)) {
+			word >>= 1;
+			++i;
+		}
+		return i;
+	}
+
+	return -1;
+}
+
 #pragma mark -
 #pragma mark Plane
 uint16 Plane::_nextObjectId; // Will be initialized in Plane::init()
@@ -431,21 +503,23 @@ void Plane::calcLists(Plane &visiblePlane, const PlaneList &planeList, DrawList
 	DrawList::size_type drawListSizePrimary = drawList.size();
 	const RectList::size_type eraseListCount = eraseList.size();
 
+	// Items can be removed from the list while the draw list is built above,
+	// so only items still in the list are partitioned
+	const ScreenItemList::size_type gridItemCount = MIN<ScreenItemList::size_type>(screenItemCount, _screenItemList.size());
+
 	if (getSciVersion() == SCI_VERSION_3) {
 		_screenItemList.sort();
 		bool pictureDrawn = false;
 		bool screenItemDrawn = false;
 
+		ScreenItemGrid grid(_screenItemList, gridItemCount, _screenRect);
 		for (RectList::size_type i = 0; i < eraseListCount; ++i) {
 			const Common::Rect &rect = *eraseList[i];
 
-			for (ScreenItemList::size_type j = 0; j < screenItemCount; ++j) {
+			grid.select(rect);
+			for (int j = grid.findNext(0); j != -1; j = grid.findNext(j + 1)) {
 				ScreenItem *item = _screenItemList[j];
 
-				if (item == nullptr) {
-					continue;
-				}
-
 				if (rect.intersects(item->_screenRect)) {
 					const Common::Rect intersection = rect.findIntersectingRect(item->_screenRect);
 					if (!item->_deleted) {
@@ -474,14 +548,18 @@ void Plane::calcLists(Plane &visiblePlane, const PlaneList &planeList, DrawList
 		}
 
 		_screenItemList.unsort();
-	} else {
+	}
+
+	ScreenItemGrid grid(_screenItemList, gridItemCount, _screenRect);
+
+	if (getSciVersion() != SCI_VERSION_3) {
 		// Add all items overlapping the erase list to the draw list
 		for (RectList::size_type i = 0; i < eraseListCount; ++i) {
 			const Common::Rect &rect = *eraseList[i];
-			for (ScreenItemList::size_type j = 0; j < screenItemCount; ++j) {
+			grid.select(rect);
+			for (int j = grid.findNext(0); j != -1; j = grid.findNext(j + 1)) {
 				ScreenItem *item = _screenItemList[j];
 				if (
-					item != nullptr &&
 					!item->_created && !item->_updated && !item->_deleted &&
 					rect.intersects(item->_screenRect)
 				) {
@@ -504,16 +582,15 @@ void Plane::calcLists(Plane &visiblePlane, const PlaneList &planeList, DrawList
 				drawListEntry = drawList[i];
 			}
 
-			for (ScreenItemList::size_type j = 0; j < screenItemCount; ++j) {
-				ScreenItem *newItem = nullptr;
-				if (j < _screenItemList.size()) {
-					newItem = _screenItemList[j];
-				}
+			if (drawListEntry == nullptr) {
+				continue;
+			}
 
-				if (
-					drawListEntry != nullptr && newItem != nullptr &&
-					!newItem->_created && !newItem->_updated && !newItem->_deleted
-				) {
+			grid.select(drawListEntry->rect);
+			for (int j = grid.findNext(0); j != -1; j = grid.findNext(j + 1)) {
+				ScreenItem *newItem = _screenItemList[j];
+
+				if (!newItem->_created && !newItem->_updated && !newItem->_deleted) {
 					const ScreenItem *drawnItem = drawListEntry->screenItem;
 
 					if (newItem->hasPriorityAbove(*drawnItem) &&
@@ -575,13 +652,19 @@ void Plane::decrementScreenItemArrayCounts(Plane *visiblePlane, const bool force
 void Plane::filterDownEraseRects(DrawList &drawList, RectList &eraseList, RectList &higherEraseList) const {
 	const RectList::size_type higherEraseCount = higherEraseList.size();
 
+	if (higherEraseCount == 0) {
+		return;
+	}
+
+	ScreenItemGrid grid(_screenItemList, _screenItemList.size(), _screenRect);
+
 	if (_type == kPlaneTypeTransparent || _type == kPlaneTypeTransparentPicture) {
 		for (RectList::size_type i = 0; i < higherEraseCount; ++i) {
 			const Common::Rect &r = *higherEraseList[i];
-			const ScreenItemList::size_type screenItemCount = _screenItemList.size();
-			for (ScreenItemList::size_type j = 0; j < screenItemCount; ++j) {
+			grid.select(r);
+			for (int j = grid.findNext(0); j != -1; j = grid.findNext(j + 1)) {
 				const ScreenItem *item = _screenItemList[j];
-				if (item != nullptr && r.intersects(item->_screenRect)) {
+				if (r.intersects(item->_screenRect)) {
 					mergeToDrawList(j, r, drawList);
 				}
 			}
@@ -593,10 +676,10 @@ void Plane::filterDownEraseRects(DrawList &drawList, RectList &eraseList, RectLi
 				r.clip(_screenRect);
 				mergeToRectList(r, eraseList);
 
-				const ScreenItemList::size_type screenItemCount = _screenItemList.size();
-				for (ScreenItemList::size_type j = 0; j < screenItemCount; ++j) {
+				grid.select(r);
+				for (int j = grid.findNext(0); j != -1; j = grid.findNext(j + 1)) {
 					const ScreenItem *item = _screenItemList[j];
-					if (item != nullptr && r.intersects(item->_screenRect)) {
+					if (r.intersects(item->_screenRect)) {
 						mergeToDrawList(j, r, drawList);
 					}
 				}
@@ -619,12 +702,17 @@ void Plane::filterDownEraseRects(DrawList &drawList, RectList &eraseList, RectLi
 
 void Plane::filterUpDrawRects(DrawList &drawList, const DrawList &lowerDrawList) const {
 	const DrawList::size_type lowerDrawCount = lowerDrawList.size();
+	if (lowerDrawCount == 0) {
+		return;
+	}
+
+	ScreenItemGrid grid(_screenItemList, _screenItemList.size(), _screenRect);
 	for (DrawList::size_type i = 0; i < lowerDrawCount; ++i) {
 		const Common::Rect &r = lowerDrawList[i]->rect;
-		const ScreenItemList::size_type screenItemCount = _screenItemList.size();
-		for (ScreenItemList::size_type j = 0; j < screenItemCount; ++j) {
+		grid.select(r);
+		for (int j = grid.findNext(0); j != -1; j = grid.findNext(j + 1)) {
 			const ScreenItem *item = _screenItemList[j];
-			if (item != nullptr && r.intersects(item->_screenRect)) {
+			if (r.intersects(item->_screenRect)) {
 				mergeToDrawList(j, r, drawList);
 			}
 		}
@@ -633,12 +721,17 @@ void Plane::filterUpDrawRects(DrawList &drawList, const DrawList &lowerDrawList)
 
 void Plane::filterUpEraseRects(DrawList &drawList, const RectList &lowerEraseList) const {
 	const RectList::size_type lowerEraseCount = lowerEraseList.size();
+	if (lowerEraseCount == 0) {
+		return;
+	}
+
+	ScreenItemGrid grid(_screenItemList, _screenItemList.size(), _screenRect);
 	for (RectList::size_type i = 0; i < lowerEraseCount; ++i) {
 		const Common::Rect &r = *lowerEraseList[i];
-		const ScreenItemList::size_type screenItemCount = _screenItemList.size();
-		for (ScreenItemList::size_type j = 0; j < screenItemCount; ++j) {
+		grid.select(r);
+		for (int j = grid.findNext(0); j != -1; j = grid.findNext(j + 1)) {
 			const ScreenItem *item = _screenItemList[j];
-			if (item != nullptr && r.intersects(item->_screenRect)) {
+			if (r.intersects(item->_screenRect)) {
 				mergeToDrawList(j, r, drawList);
 			}
 		}
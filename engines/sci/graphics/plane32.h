@@ -93,6 +93,52 @@ public:
 	}
 };
 
+#pragma mark -
+#pragma mark ScreenItemGrid
+
+/**
+ * A uniform grid over the screen rectangle of a plane which records the
+ * screen items touching each cell. It is used to find the screen items that
+ * may intersect a rectangle without testing every screen item of the plane.
+ * Candidates are returned in screen item list order, so callers process them
+ * in the same order as a linear scan of the list would.
+ */
+class ScreenItemGrid {
+public:
+	enum {
+		kCellsPerSide = 8,
+		kMaxItems = 256,
+		kWords = kMaxItems / 32
+	};
+
+	/**
+	 * Records the screen rects of the first `count` items of `list`. The
+	 * grid must be rebuilt whenever the list is reordered or packed, or the
+	 * screen rect of an item changes.
+	 */
+	ScreenItemGrid(const ScreenItemList &list, uint count, const Common::Rect &bounds);
+
+	/**
+	 * Selects the screen items whose cells overlap the given rectangle. This
+	 * is a superset of the items whose screen rect intersects it.
+	 */
+	void select(const Common::Rect &rect);
+
+	/**
+	 * Returns the index of the first selected screen item at or after
+	 * `index`, or -1 if there is none.
+	 */
+	int findNext(uint index) const;
+
+private:
+	Common::Rect _bounds;
+	int16 _cellWidth, _cellHeight;
+	uint32 _cells[kCellsPerSide * kCellsPerSide][kWords];
+	uint32 _selection[kWords];
+
+	void getCellRange(const Common::Rect &rect, int &x1, int &y1, int &x2, int &y2) const;
+};
+
 class PlaneList;
 
 #pragma mark -
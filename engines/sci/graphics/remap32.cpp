@@ -188,6 +188,21 @@ bool SingleRemap::apply() {
 	const GfxRemap32 *const gfxRemap32 = g_sci->_gfxRemap32;
 	const uint8 remapStartColor = gfxRemap32->getStartColor();
 
+	// Only entries whose ideal color or current target color changed need to
+	// be matched again, so when a palette update did not touch any color used
+	// by this remap there is nothing to rebuild
+	bool hasChanges = false;
+	for (uint i = 1; i < remapStartColor; ++i) {
+		if (_idealColorsChanged[i] || _originalColorsChanged[_remapColors[i]]) {
+			hasChanges = true;
+			break;
+		}
+	}
+
+	if (!hasChanges) {
+		return false;
+	}
+
 	// Blocked colors are not allowed to be used as target colors for the remap
 	bool blockedColors[237];
 	Common::fill(blockedColors, &blockedColors[237], false);
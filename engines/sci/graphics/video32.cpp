@@ -234,46 +234,27 @@ void VideoPlayer::submitPalette(const uint8 palette[256 * 3]) const {
 }
 
 void VideoPlayer::renderFrame(const Graphics::Surface &nextFrame) const {
-	bool freeConvertedFrame;
-	Graphics::Surface *convertedFrame;
+	const Graphics::Surface *convertedFrame;
 	// Avoid creating a duplicate copy of the surface when it is not necessary
 	if (_decoder->getPixelFormat() == g_system->getScreenFormat()) {
-		freeConvertedFrame = false;
-		convertedFrame = const_cast<Graphics::Surface *>(&nextFrame);
+		convertedFrame = &nextFrame;
 	} else {
-		freeConvertedFrame = true;
-		convertedFrame = nextFrame.convertTo(g_system->getScreenFormat(), _decoder->getPalette());
+		nextFrame.convertTo(_convertedFrame, g_system->getScreenFormat(), _decoder->getPalette());
+		convertedFrame = &_convertedFrame;
 	}
-	assert(convertedFrame);
 
 	if (_decoder->getWidth() != _drawRect.width() || _decoder->getHeight() != _drawRect.height()) {
-		Graphics::Surface *const unscaledFrame(convertedFrame);
 #ifdef USE_RGB_COLOR
-		if (_hqVideoMode) {
-			convertedFrame = unscaledFrame->scale(_drawRect.width(), _drawRect.height(), true);
-		} else {
-#elif 1
-		{
+		const bool filtering = _hqVideoMode;
 #else
-		}
+		const bool filtering = false;
 #endif
-			convertedFrame = unscaledFrame->scale(_drawRect.width(), _drawRect.height(), false);
-		}
-		assert(convertedFrame);
-		if (freeConvertedFrame) {
-			unscaledFrame->free();
-			delete unscaledFrame;
-		}
-		freeConvertedFrame = true;
+		convertedFrame->scale(_scaledFrame, _drawRect.width(), _drawRect.height(), filtering);
+		convertedFrame = &_scaledFrame;
 	}
 
 	g_system->copyRectToScreen(convertedFrame->getPixels(), convertedFrame->pitch, _drawRect.left, _drawRect.top, _drawRect.width(), _drawRect.height());
 	g_sci->_gfxFrameout->updateScreen();
-
-	if (freeConvertedFrame) {
-		convertedFrame->free();
-		delete convertedFrame;
-	}
 }
 
 template <typename PixelType>
@@ -343,6 +324,7 @@ void SEQPlayer::play(const Common::String &fileName, const int16 numTicks, const
 	startHQVideo();
 	playUntilEvent(kEventFlagMouseDown | kEventFlagEscapeKey);
 	endHQVideo();
+	freeFrameBuffers();
 	g_system->fillScreen(0);
 	_decoder.reset();
 }
@@ -485,6 +467,7 @@ AVIPlayer::IOStatus AVIPlayer::close() {
 	g_system->fillScreen(0);
 	g_sci->_gfxCursor32->unhide();
 	_decoder->close();
+	freeFrameBuffers();
 	_status = kAVINotOpen;
 	return kIOSuccess;
 }
@@ -536,6 +519,7 @@ void QuickTimePlayer::play(const Common::String& fileName) {
 	startHQVideo();
 	playUntilEvent(kEventFlagMouseDown | kEventFlagEscapeKey);
 	endHQVideo();
+	freeFrameBuffers();
 
 	g_system->fillScreen(0);
 	_decoder.reset();
@@ -684,6 +668,8 @@ VMDPlayer::IOStatus VMDPlayer::close() {
 	}
 
 	_decoder->close();
+	freeFrameBuffers();
+	_censoredFrame.free();
 
 	if (_bundledVmd) {
 		g_sci->getResMan()->unlockResource(_bundledVmd);
@@ -1072,12 +1058,9 @@ void VMDPlayer::renderFrame(const Graphics::Surface &nextFrame) const {
 		if (_blobs.empty()) {
 			renderOverlay(nextFrame);
 		} else {
-			Graphics::Surface censoredFrame;
-			censoredFrame.create(nextFrame.w, nextFrame.h, nextFrame.format);
-			censoredFrame.copyFrom(nextFrame);
-			drawBlobs(censoredFrame);
-			renderOverlay(censoredFrame);
-			censoredFrame.free();
+			nextFrame.convertTo(_censoredFrame, nextFrame.format);
+			drawBlobs(_censoredFrame);
+			renderOverlay(_censoredFrame);
 		}
 	}
 }
@@ -1211,6 +1194,7 @@ void DuckPlayer::close() {
 	}
 
 	_decoder->close();
+	freeFrameBuffers();
 
 	endHQVideo();
 
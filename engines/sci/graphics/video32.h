@@ -78,7 +78,9 @@ public:
 #endif
 		{}
 
-	virtual ~VideoPlayer() {}
+	virtual ~VideoPlayer() {
+		freeFrameBuffers();
+	}
 
 protected:
 	EventManager *_eventMan;
@@ -156,6 +158,21 @@ protected:
 	 */
 	virtual void renderFrame(const Graphics::Surface &nextFrame) const;
 
+	/**
+	 * Surfaces receiving frames converted to the screen format and scaled to
+	 * the draw rect by renderFrame. They are kept between frames to avoid
+	 * allocating new surfaces for every frame.
+	 */
+	mutable Graphics::Surface _convertedFrame, _scaledFrame;
+
+	/**
+	 * Frees the surfaces kept by renderFrame once playback has finished.
+	 */
+	void freeFrameBuffers() {
+		_convertedFrame.free();
+		_scaledFrame.free();
+	}
+
 	/**
 	 * Renders a video frame to an intermediate surface using low-quality
 	 * scaling, black-lining, or direct copy, depending upon the passed flags.
@@ -677,6 +694,11 @@ private:
 
 	Common::List<Blob> _blobs;
 
+	/**
+	 * A copy of the current frame with the censorship blobs drawn over it.
+	 */
+	mutable Graphics::Surface _censoredFrame;
+
 	void drawBlobs(Graphics::Surface& frame) const;
 };
 
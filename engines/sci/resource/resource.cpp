@@ -25,6 +25,8 @@
 #include "common/file.h"
 #include "common/fs.h"
 #include "common/macresman.h"
+#include "common/memtrack.h"
+#include "common/system.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
 #ifdef ENABLE_SCI32
@@ -32,6 +34,8 @@
 #include "common/memstream.h"
 #endif
 
+#include "engines/util.h"
+
 #include "sci/engine/workarounds.h"
 #include "sci/parser/vocabulary.h"
 #include "sci/resource/resource.h"
@@ -212,6 +216,7 @@ Resource::Resource(ResourceManager *resMan, ResourceId id) : SciSpan<const byte>
 	_fileOffset = 0;
 	_status = kResStatusNoMalloc;
 	_lockers = 0;
+	_prefetched = false;
 	_source = nullptr;
 	_header = nullptr;
 	_headerSize = 0;
@@ -1011,6 +1016,8 @@ void ResourceManager::init() {
 	_memoryLocked = 0;
 	_memoryLRU = 0;
 	_LRU.clear();
+	_prefetchQueue.clear();
+	memset(&_prefetchStats, 0, sizeof(_prefetchStats));
 	_resMap.clear();
 	_audioMapSCI1 = NULL;
 #ifdef ENABLE_SCI32
@@ -1084,6 +1091,8 @@ void ResourceManager::init() {
 		_maxMemoryLRU = 4096 * 1024; // 4MiB
 	}
 
+	_maxMemoryLRU = getResourceMemoryBudget(_maxMemoryLRU);
+
 	switch (_viewType) {
 	case kViewEga:
 		debugC(1, kDebugLevelResMan, "resMan: Detected EGA graphic resources");
@@ -1173,10 +1182,60 @@ void ResourceManager::freeOldResources() {
 		Resource *goner = _LRU.back();
 		removeFromLRU(goner);
 		goner->unalloc();
+		if (goner->_prefetched) {
+			goner->_prefetched = false;
+			_prefetchStats.wasted++;
+		}
 #ifdef SCI_VERBOSE_RESMAN
 		debug("resMan-debug: LRU: Freeing %s (%d bytes)", goner->_id.toString().c_str(), goner->size);
 #endif
 	}
+
+	MEMORY_USAGE("sci resources", _memoryLRU + _memoryLocked);
+}
+
+void ResourceManager::prefetchResource(ResourceId id) {
+	// Keep the queue short, resources requested long ago are likely not
+	// needed any more by the time the queue gets to them
+	const uint kMaxPrefetchQueue = 32;
+
+	Resource *res = testResource(id);
+	if (!res || res->_status != kResStatusNoMalloc)
+		return;
+
+	uint queued = 0;
+	for (Common::List<ResourceId>::const_iterator it = _prefetchQueue.begin(); it != _prefetchQueue.end(); ++it, ++queued) {
+		if (*it == id)
+			return;
+	}
+	if (queued >= kMaxPrefetchQueue)
+		_prefetchQueue.pop_front();
+
+	_prefetchQueue.push_back(id);
+	_prefetchStats.queued++;
+}
+
+bool ResourceManager::processPrefetchQueue(uint32 deadline) {
+	while (!_prefetchQueue.empty() && g_system->getMillis() < deadline) {
+		// Resources may have been loaded or even replaced in the meantime,
+		// so they are looked up again
+		Resource *res = testResource(_prefetchQueue.front());
+		_prefetchQueue.pop_front();
+		if (!res || res->_status != kResStatusNoMalloc)
+			continue;
+
+		loadResource(res);
+		if (res->_status != kResStatusAllocated)
+			continue;
+
+		debugC(2, kDebugLevelResMan, "[resMan] Prefetched %s", res->_id.toString().c_str());
+		res->_prefetched = true;
+		_prefetchStats.loaded++;
+		addToLRU(res);
+		freeOldResources();
+	}
+
+	return !_prefetchQueue.empty();
 }
 
 Common::List<ResourceId> ResourceManager::listResources(ResourceType type, int mapNumber) {
@@ -1215,6 +1274,11 @@ Resource *ResourceManager::findResource(ResourceId id, bool lock) {
 	if (!retval)
 		return NULL;
 
+	if (retval->_prefetched) {
+		retval->_prefetched = false;
+		_prefetchStats.hits++;
+	}
+
 	if (retval->_status == kResStatusNoMalloc)
 		loadResource(retval);
 	else if (retval->_status == kResStatusEnqueued)
@@ -1242,6 +1306,8 @@ Resource *ResourceManager::findResource(ResourceId id, bool lock) {
 			addToLRU(retval);
 	}
 
+	MEMORY_USAGE("sci resources", _memoryLRU + _memoryLocked);
+
 	if (retval->data())
 		return retval;
 	else {
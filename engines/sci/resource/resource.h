@@ -298,6 +298,7 @@ protected:
 	int32 _fileOffset; /**< Offset in file */
 	ResourceStatus _status;
 	uint16 _lockers; /**< Number of places where this resource was locked */
+	bool _prefetched; /**< Loaded by the prefetcher and not requested since */
 	ResourceSource *_source;
 	ResourceManager *_resMan;
 
@@ -383,6 +384,30 @@ public:
 	 */
 	Resource *testResource(ResourceId id);
 
+	/**
+	 * Queues a resource to be loaded ahead of time, while the engine would
+	 * otherwise be waiting. Prefetched resources are put under LRU control
+	 * like any other unlocked resource.
+	 * @param id	Id of the resource the game is likely to need soon
+	 */
+	void prefetchResource(ResourceId id);
+
+	/**
+	 * Loads queued resources until the queue is empty or the time given
+	 * by @p deadline (in g_system->getMillis() time) has passed.
+	 * @return true if there are still resources queued
+	 */
+	bool processPrefetchQueue(uint32 deadline);
+
+	struct PrefetchStats {
+		uint32 queued;	///< Resources added to the prefetch queue
+		uint32 loaded;	///< Resources actually loaded ahead of time
+		uint32 hits;	///< Prefetched resources which were requested while still loaded
+		uint32 wasted;	///< Prefetched resources which were freed before being used
+	};
+
+	const PrefetchStats &getPrefetchStats() const { return _prefetchStats; }
+
 	/**
 	 * Returns a list of all resources of the specified type.
 	 * @param type		The resource type to look for
@@ -490,6 +515,8 @@ protected:
 	int _memoryLocked;	///< Amount of resource bytes in locked memory
 	int _memoryLRU;		///< Amount of resource bytes under LRU control
 	Common::List<Resource *> _LRU; ///< Last Resource Used list
+	Common::List<ResourceId> _prefetchQueue; ///< Resources to load when idle, see prefetchResource()
+	PrefetchStats _prefetchStats;
 	ResourceMap _resMap;
 	Common::List<Common::File *> _volumeFiles; ///< list of opened volume files
 	ResourceSource *_audioMapSCI1; ///< Currently loaded audio map for SCI1
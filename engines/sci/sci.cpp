@@ -870,7 +870,10 @@ void SciEngine::sleep(uint32 msecs) {
 #endif
 		time = g_system->getMillis();
 		if (time + 10 < wakeUpTime) {
-			g_system->delayMillis(10);
+			// Rather than only waiting, load the resources the game
+			// announced with kLoad
+			if (!_resMan->processPrefetchQueue(time + 10))
+				g_system->delayMillis(10);
 		} else {
 			if (time < wakeUpTime)
 				g_system->delayMillis(wakeUpTime - time);
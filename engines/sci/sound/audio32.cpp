@@ -239,6 +239,12 @@ int Audio32::writeAudioInternal(Audio::AudioStream &sourceStream, Audio::RateCon
 	return samplePairsWritten << 1;
 }
 
+int Audio32::writeAudioInternal(Audio::AudioStream &sourceStream, Audio::RateConverter &converter, int32 *targetBus, const int numSamples, const Audio::st_volume_t leftVolume, const Audio::st_volume_t rightVolume) {
+	const int samplePairsToRead = numSamples >> 1;
+	const int samplePairsWritten = converter.flowMix(sourceStream, targetBus, samplePairsToRead, leftVolume, rightVolume);
+	return samplePairsWritten << 1;
+}
+
 int16 Audio32::getNumChannelsToMix() const {
 	Common::StackLock lock(_mutex);
 	int16 numChannels = 0;
@@ -305,10 +311,12 @@ int Audio32::readBuffer(Audio::st_sample_t *const buffer, const int numSamples)
 
 	const bool playOnlyMonitoredChannel = getSciVersion() != SCI_VERSION_3 && _monitoredChannelIndex != -1;
 
-	// The caller of `readBuffer` is a rate converter, which reuses (without
-	// clearing) an intermediate buffer, so we need to zero the intermediate
-	// buffer to prevent mixing into audio data from the last callback.
-	memset(buffer, 0, numSamples * sizeof(Audio::st_sample_t));
+	// Channels are summed on a 32-bit bus and only clamped once at the end,
+	// instead of clamping every sample after each channel is added
+	if (numSamples > (int)_mixBus.size()) {
+		_mixBus.resize(numSamples);
+	}
+	memset(_mixBus.data(), 0, numSamples * sizeof(int32));
 
 	// This emulates the attenuated mixing mode of SSCI engine, which reduces
 	// the volume of the target buffer when each new channel is mixed in.
@@ -417,11 +425,11 @@ int Audio32::readBuffer(Audio::st_sample_t *const buffer, const int numSamples)
 			memset(_monitoredBuffer.data(), 0, _monitoredBuffer.size() * sizeof(Audio::st_sample_t));
 			_numMonitoredSamples = writeAudioInternal(*channel.stream, *channel.converter, _monitoredBuffer.data(), numSamples, leftVolume, rightVolume);
 
-			Audio::st_sample_t *sourceBuffer = _monitoredBuffer.data();
-			Audio::st_sample_t *targetBuffer = buffer;
+			const Audio::st_sample_t *sourceBuffer = _monitoredBuffer.data();
+			int32 *targetBus = _mixBus.data();
 			const Audio::st_sample_t *const end = _monitoredBuffer.data() + _numMonitoredSamples;
 			while (sourceBuffer != end) {
-				Audio::clampedAdd(*targetBuffer++, *sourceBuffer++);
+				*targetBus++ += *sourceBuffer++;
 			}
 
 			if (_numMonitoredSamples > maxSamplesWritten) {
@@ -438,13 +446,15 @@ int Audio32::readBuffer(Audio::st_sample_t *const buffer, const int numSamples)
 				leftVolume = rightVolume = 0;
 			}
 
-			const int channelSamplesWritten = writeAudioInternal(*channel.stream, *channel.converter, buffer, numSamples, leftVolume, rightVolume);
+			const int channelSamplesWritten = writeAudioInternal(*channel.stream, *channel.converter, _mixBus.data(), numSamples, leftVolume, rightVolume);
 			if (channelSamplesWritten > maxSamplesWritten) {
 				maxSamplesWritten = channelSamplesWritten;
 			}
 		}
 	}
 
+	Audio::clampMixBus(buffer, _mixBus.data(), maxSamplesWritten);
+
 	_inAudioThread = false;
 
 	return maxSamplesWritten;
@@ -221,6 +221,18 @@ private:
 	 */
 	int writeAudioInternal(Audio::AudioStream &sourceStream, Audio::RateConverter &converter, Audio::st_sample_t *targetBuffer, const int numSamples, const Audio::st_volume_t leftVolume, const Audio::st_volume_t rightVolume);
 
+	/**
+	 * Adds audio from the given source stream to the 32-bit mix bus using the
+	 * given rate converter, without clamping.
+	 */
+	int writeAudioInternal(Audio::AudioStream &sourceStream, Audio::RateConverter &converter, int32 *targetBus, const int numSamples, const Audio::st_volume_t leftVolume, const Audio::st_volume_t rightVolume);
+
+	/**
+	 * The 32-bit buffer all channels are mixed into before the result is
+	 * clamped into the output buffer of readBuffer.
+	 */
+	Common::Array<int32> _mixBus;
+
 #pragma mark -
 #pragma mark Channel management
 public:
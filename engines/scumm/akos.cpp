@@ -637,6 +637,179 @@ void AkosRenderer::codec1_genericDecode(Codec1 &v1) {
 	} while (1);
 }
 
+namespace {
+
+/**
+ * How codec1_drawColumns() combines a costume pixel with the screen. Each
+ * mode is a separate instantiation, so the inner loop does not test the
+ * shadow mode, the game version and the pixel format for every pixel.
+ */
+enum Codec1ShadowOp {
+	kCodec1Opaque,		///< Shadow mode 0
+	kCodec1Shadow13,	///< Shadow mode 1: color 13 is darkened through the shadow table
+	kCodec1Blend16,		///< Shadow mode 3 in 16bpp games: average with the screen
+	kCodec1XMap,		///< Shadow mode 3 in HE 90+ games: mapped through xmap
+	kCodec1LowColors	///< Shadow mode 3 otherwise: colors below 8 mapped through the shadow table
+};
+
+} // End of anonymous namespace
+
+template<bool kScaleY, int kShadow, bool k16Bit>
+void AkosRenderer::codec1_drawColumns(Codec1 &v1) {
+	const byte *src = _srcptr;
+	byte *dst = v1.destptr;
+	byte len = v1.replen;
+	uint16 color = v1.repcolor;
+	uint16 height = _height;
+	int y = v1.y;
+
+	const int top = v1.boundsRect.top;
+	const int bottom = v1.boundsRect.bottom;
+	const int pitch = _out.pitch;
+	const int numStrips = _numStrips;
+	const byte scaleY = _scaleY;
+
+	const byte *scaleytab = &v1.scaletable[v1.scaleYindex];
+	byte maskbit = revBitMask(v1.x & 7);
+	const byte *mask = _vm->getMaskBuffer(v1.x - (_vm->_virtscr[kMainVirtScreen].xstart & 7), v1.y, _zbuf);
+
+	// The horizontal clipping only changes from one column to the next, so
+	// it is resolved when a column starts rather than for every pixel.
+	bool drawColumn = (v1.x >= 0 && v1.x < v1.boundsRect.right);
+
+	if (len)
+		goto StartPos;
+
+	do {
+		len = *src++;
+		color = len >> v1.shr;
+		len &= v1.mask;
+		if (!len)
+			len = *src++;
+
+		do {
+			if (!kScaleY || *scaleytab++ < scaleY) {
+				if (color && drawColumn && y >= top && y < bottom && !(*mask & maskbit)) {
+					uint16 pcolor = _palette[color];
+
+					if (kShadow == kCodec1Shadow13) {
+						if (pcolor == 13)
+							pcolor = _shadow_table[*dst];
+					} else if (kShadow == kCodec1Blend16) {
+						uint16 srcColor = (pcolor >> 1) & 0x7DEF;
+						uint16 dstColor = (READ_UINT16(dst) >> 1) & 0x7DEF;
+						pcolor = srcColor + dstColor;
+					} else if (kShadow == kCodec1XMap) {
+						pcolor = xmap[(pcolor << 8) + *dst];
+					} else if (kShadow == kCodec1LowColors) {
+						if (pcolor < 8)
+							pcolor = _shadow_table[(pcolor << 8) + *dst];
+					}
+
+					if (k16Bit)
+						WRITE_UINT16(dst, pcolor);
+					else
+						*dst = pcolor;
+				}
+				dst += pitch;
+				mask += numStrips;
+				y++;
+			}
+			if (!--height) {
+				if (!--v1.skip_width)
+					return;
+				height = _height;
+				y = v1.y;
+
+				scaleytab = &v1.scaletable[v1.scaleYindex];
+
+				if (_scaleX == 255 || v1.scaletable[v1.scaleXindex] < _scaleX) {
+					v1.x += v1.scaleXstep;
+					if (v1.x < 0 || v1.x >= v1.boundsRect.right)
+						return;
+					maskbit = revBitMask(v1.x & 7);
+					v1.destptr += v1.scaleXstep * (k16Bit ? 2 : 1);
+					drawColumn = true;
+				} else
+					drawColumn = false;
+				v1.scaleXindex += v1.scaleXstep;
+				dst = v1.destptr;
+				mask = _vm->getMaskBuffer(v1.x - (_vm->_virtscr[kMainVirtScreen].xstart & 7), v1.y, _zbuf);
+			}
+		StartPos:;
+		} while (--len);
+	} while (1);
+}
+
+void AkosRenderer::codec1_specialisedDecode(Codec1 &v1) {
+	const bool is16Bit = (_vm->_bytesPerPixel == 2);
+	const bool scaleY = (_scaleY != 255);
+
+	int shadowOp;
+	switch (_shadow_mode) {
+	case 0:
+		shadowOp = kCodec1Opaque;
+		break;
+	case 1:
+		shadowOp = kCodec1Shadow13;
+		break;
+	case 3:
+		if (_vm->_game.features & GF_16BIT_COLOR)
+			shadowOp = kCodec1Blend16;
+		else if (_vm->_game.heversion >= 90)
+			shadowOp = kCodec1XMap;
+		else
+			shadowOp = kCodec1LowColors;
+		break;
+	default:
+		// Hit testing and the unsupported shadow modes
+		codec1_genericDecode(v1);
+		return;
+	}
+
+	if (_actorHitMode) {
+		codec1_genericDecode(v1);
+		return;
+	}
+
+#define CODEC1_DRAW(shadow, bits16) \
+	if (scaleY) \
+		codec1_drawColumns<true, shadow, bits16>(v1); \
+	else \
+		codec1_drawColumns<false, shadow, bits16>(v1); \
+	return
+
+	if (is16Bit) {
+		switch (shadowOp) {
+		case kCodec1Opaque:
+			CODEC1_DRAW(kCodec1Opaque, true);
+		case kCodec1Shadow13:
+			CODEC1_DRAW(kCodec1Shadow13, true);
+		case kCodec1Blend16:
+			CODEC1_DRAW(kCodec1Blend16, true);
+		default:
+			break;
+		}
+	} else {
+		switch (shadowOp) {
+		case kCodec1Opaque:
+			CODEC1_DRAW(kCodec1Opaque, false);
+		case kCodec1Shadow13:
+			CODEC1_DRAW(kCodec1Shadow13, false);
+		case kCodec1XMap:
+			CODEC1_DRAW(kCodec1XMap, false);
+		case kCodec1LowColors:
+			CODEC1_DRAW(kCodec1LowColors, false);
+		default:
+			break;
+		}
+	}
+
+#undef CODEC1_DRAW
+
+	codec1_genericDecode(v1);
+}
+
 // This is exact duplicate of smallCostumeScaleTable[] in costume.cpp
 // See FIXME below for explanation
 const byte smallCostumeScaleTableAKOS[256] = {
@@ -998,7 +1171,7 @@ byte AkosRenderer::codec1(int xmoveCur, int ymoveCur) {
 	v1.height = _out.h;
 	v1.destptr = (byte *)_out.getBasePtr(v1.x, v1.y);
 
-	codec1_genericDecode(v1);
+	codec1_specialisedDecode(v1);
 
 	return drawFlag;
 }
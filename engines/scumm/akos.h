@@ -113,6 +113,9 @@ protected:
 
 	byte codec1(int xmoveCur, int ymoveCur);
 	void codec1_genericDecode(Codec1 &v1);
+	void codec1_specialisedDecode(Codec1 &v1);
+	template<bool kScaleY, int kShadow, bool k16Bit>
+	void codec1_drawColumns(Codec1 &v1);
 	byte codec5(int xmoveCur, int ymoveCur);
 	byte codec16(int xmoveCur, int ymoveCur);
 	byte codec32(int xmoveCur, int ymoveCur);
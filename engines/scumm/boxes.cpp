@@ -205,6 +205,11 @@ void ScummEngine::setBoxFlags(int box, int val) {
 			ptr->v2.flags = val;
 		else
 			ptr->old.flags = val;
+
+		// V0 boxes are smaller than the V2 layout used above, so the
+		// write lands in the coordinates of the following box.
+		if (_game.version == 0)
+			_boxCache.boxData = nullptr;
 	}
 }
 
@@ -520,24 +525,35 @@ bool ScummEngine::checkXYInBoxBounds(int boxnum, int x, int y) {
 	if (boxnum < 0 || boxnum == Actor::kInvalidBox)
 		return false;
 
-	BoxCoords box = getBoxCoordinates(boxnum);
-	const Common::Point p(x, y);
+	BoxCoords box;
+	if (updateBoxCoordsCache() && boxnum < (int)_boxCache.coords.size()) {
+		// Quick check against the precomputed bounding box: if the point
+		// lies outside of it, it certainly is *not* inside the quadrangle.
+		const BoxCache::Bounds &bounds = _boxCache.bounds[boxnum];
+		if (x < bounds.left || x > bounds.right || y < bounds.top || y > bounds.bottom)
+			return false;
+		box = _boxCache.coords[boxnum];
+	} else {
+		box = decodeBoxCoordinates(boxnum);
 
-	// Quick check: If the x (resp. y) coordinate of the point is
-	// strictly smaller (bigger) than the x (y) coordinates of all
-	// corners of the quadrangle, then it certainly is *not* contained
-	// inside the quadrangle.
-	if (x < box.ul.x && x < box.ur.x && x < box.lr.x && x < box.ll.x)
-		return false;
+		// Quick check: If the x (resp. y) coordinate of the point is
+		// strictly smaller (bigger) than the x (y) coordinates of all
+		// corners of the quadrangle, then it certainly is *not* contained
+		// inside the quadrangle.
+		if (x < box.ul.x && x < box.ur.x && x < box.lr.x && x < box.ll.x)
+			return false;
 
-	if (x > box.ul.x && x > box.ur.x && x > box.lr.x && x > box.ll.x)
-		return false;
+		if (x > box.ul.x && x > box.ur.x && x > box.lr.x && x > box.ll.x)
+			return false;
 
-	if (y < box.ul.y && y < box.ur.y && y < box.lr.y && y < box.ll.y)
-		return false;
+		if (y < box.ul.y && y < box.ur.y && y < box.lr.y && y < box.ll.y)
+			return false;
 
-	if (y > box.ul.y && y > box.ur.y && y > box.lr.y && y > box.ll.y)
-		return false;
+		if (y > box.ul.y && y > box.ur.y && y > box.lr.y && y > box.ll.y)
+			return false;
+	}
+
+	const Common::Point p(x, y);
 
 	// Corner case: If the box is a simple line segment, we consider the
 	// point to be contained "in" (or rather, lying on) the line if it
@@ -571,7 +587,45 @@ bool ScummEngine::checkXYInBoxBounds(int boxnum, int x, int y) {
 	return true;
 }
 
+void ScummEngine::clearBoxCache() {
+	_boxCache.clear();
+}
+
+/**
+ * Make sure the decoded box coordinates match the current box set.
+ * Returns false if there are no boxes in the current room.
+ */
+bool ScummEngine::updateBoxCoordsCache() {
+	const byte *ptr = getResourceAddress(rtMatrix, 2);
+	if (!ptr)
+		return false;
+	if (ptr == _boxCache.boxData)
+		return true;
+
+	const int numOfBoxes = getNumBoxes();
+	_boxCache.coords.resize(numOfBoxes);
+	_boxCache.bounds.resize(numOfBoxes);
+	for (int i = 0; i < numOfBoxes; i++) {
+		const BoxCoords &box = _boxCache.coords[i] = decodeBoxCoordinates(i);
+		BoxCache::Bounds &bounds = _boxCache.bounds[i];
+		bounds.left = MIN(MIN(box.ul.x, box.ur.x), MIN(box.ll.x, box.lr.x));
+		bounds.right = MAX(MAX(box.ul.x, box.ur.x), MAX(box.ll.x, box.lr.x));
+		bounds.top = MIN(MIN(box.ul.y, box.ur.y), MIN(box.ll.y, box.lr.y));
+		bounds.bottom = MAX(MAX(box.ul.y, box.ur.y), MAX(box.ll.y, box.lr.y));
+	}
+	_boxCache.boxData = ptr;
+	return true;
+}
+
 BoxCoords ScummEngine::getBoxCoordinates(int boxnum) {
+	// Box numbers outside of the table (see the workarounds in
+	// getBoxBaseAddr) take the slow path.
+	if (updateBoxCoordsCache() && boxnum >= 0 && boxnum < (int)_boxCache.coords.size())
+		return _boxCache.coords[boxnum];
+	return decodeBoxCoordinates(boxnum);
+}
+
+BoxCoords ScummEngine::decodeBoxCoordinates(int boxnum) {
 	BoxCoords tmp, *box = &tmp;
 	Box *bp = getBoxBaseAddr(boxnum);
 	assert(bp);
@@ -754,6 +808,15 @@ int ScummEngine::getNextBox(byte from, byte to) {
 		return (int8)boxm[to];
 	}
 
+	// WORKAROUND #2: In addition to the above, we have to add this special
+	// case to fix the scene in Indy3 where Indy meets Hitler in Berlin.
+	// See bug #1017 and also bug #1052.
+	if ((_game.id == GID_INDY3) && _roomResource == 46 && from == 1 && to == 0)
+		return 0;
+
+	if (updateNextBoxCache(numOfBoxes))
+		return _boxCache.nextBox[from * numOfBoxes + to];
+
 	// WORKAROUND #1: It seems that in some cases, the box matrix is corrupt
 	// (more precisely, is too short) in the datafiles already. In
 	// particular this seems to be the case in room 46 of Indy3 EGA (see
@@ -767,12 +830,6 @@ int ScummEngine::getNextBox(byte from, byte to) {
 	// resource, and abort the search once we reach the end.
 	const byte *end = boxm + getResourceSize(rtMatrix, 1);
 
-	// WORKAROUND #2: In addition to the above, we have to add this special
-	// case to fix the scene in Indy3 where Indy meets Hitler in Berlin.
-	// See bug #1017 and also bug #1052.
-	if ((_game.id == GID_INDY3) && _roomResource == 46 && from == 1 && to == 0)
-		return 0;
-
 	// Skip up to the matrix data for box 'from'
 	for (i = 0; i < from && boxm < end; i++) {
 		while (boxm < end && *boxm != 0xFF)
@@ -793,6 +850,44 @@ int ScummEngine::getNextBox(byte from, byte to) {
 	return dest;
 }
 
+/**
+ * Expand the run-length encoded v3+ box matrix into a plain table, so that
+ * getNextBox does not have to skip over all preceding rows on each call.
+ * See getNextBox and createBoxMatrix for the format.
+ */
+bool ScummEngine::updateNextBoxCache(int numOfBoxes) {
+	const byte *ptr = getResourceAddress(rtMatrix, 1);
+	if (!ptr)
+		return false;
+	if (ptr == _boxCache.matrixData && _boxCache.nextBox.size() == (uint)(numOfBoxes * numOfBoxes))
+		return true;
+
+	const byte *boxm = getBoxMatrixBaseAddr();
+	const byte *end = ptr + getResourceSize(rtMatrix, 1);
+
+	_boxCache.nextBox.resize(numOfBoxes * numOfBoxes);
+	memset(_boxCache.nextBox.data(), -1, numOfBoxes * numOfBoxes);
+	for (int from = 0; from < numOfBoxes; from++) {
+		int8 *row = &_boxCache.nextBox[from * numOfBoxes];
+
+		// Later triples override earlier ones, just like in the linear
+		// search getNextBox used to perform.
+		while (boxm < end && boxm[0] != 0xFF) {
+			for (int to = boxm[0]; to <= boxm[1] && to < numOfBoxes; to++)
+				row[to] = (int8)boxm[2];
+			boxm += 3;
+		}
+		if (boxm >= end) {
+			debug(0, "The box matrix apparently is truncated (room %d)", _roomResource);
+			break;
+		}
+		boxm++;
+	}
+
+	_boxCache.matrixData = ptr;
+	return true;
+}
+
 /*
  * Computes the next point actor a has to walk towards in a straight
  * line in order to get from box1 to box3 via box2.
@@ -1043,6 +1138,7 @@ void ScummEngine::createBoxMatrix() {
 	// the boxes 7,8,9,10,11 the shortest way is to go via box 15.
 	// See also getNextBox.
 
+	clearBoxCache();
 	byte *matrixStart = _res->createResource(rtMatrix, 1, BOX_MATRIX_SIZE);
 	const byte *matrixEnd = matrixStart + BOX_MATRIX_SIZE;
 
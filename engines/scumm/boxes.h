@@ -23,6 +23,7 @@
 #ifndef SCUMM_BOXES_H
 #define SCUMM_BOXES_H
 
+#include "common/array.h"
 #include "common/rect.h"
 
 namespace Scumm {
@@ -49,6 +50,34 @@ struct BoxCoords {			/* Box coordinates */
 	Common::Point lr;
 };
 
+/**
+ * Decoded copy of the walkbox data of the current box set. The box
+ * coordinates and the itinerary matrix are parsed out of the rtMatrix
+ * resources once per room (or box set) instead of on every query made
+ * while actors walk around.
+ */
+struct BoxCache {
+	struct Bounds {
+		int16 left, top, right, bottom;	// inclusive
+	};
+
+	BoxCache() : boxData(nullptr), matrixData(nullptr) {}
+
+	const byte *boxData;			///< rtMatrix 2 data the coordinates were decoded from
+	Common::Array<BoxCoords> coords;
+	Common::Array<Bounds> bounds;
+
+	const byte *matrixData;		///< rtMatrix 1 data the itinerary was decoded from
+	Common::Array<int8> nextBox;	///< numBoxes * numBoxes entries, v3+ only
+
+	void clear() {
+		boxData = matrixData = nullptr;
+		coords.clear();
+		bounds.clear();
+		nextBox.clear();
+	}
+};
+
 int getClosestPtOnBox(const BoxCoords &box, int x, int y, int16& outX, int16& outY);
 
 } // End of namespace Scumm
@@ -436,14 +436,6 @@ extern "C" int ClassicProc3RendererShadowARM(int _scaleY,
 #endif
 
 void ClassicCostumeRenderer::proc3(Codec1 &v1) {
-	const byte *mask, *src;
-	byte *dst;
-	byte len, maskbit;
-	int y;
-	uint color, height, pcolor;
-	byte scaleIndexY;
-	bool masked;
-
 #ifdef USE_ARM_COSTUME_ASM
 	if (((_shadow_mode & 0x20) == 0) &&
 	    (v1.mask_ptr != NULL) &&
@@ -464,6 +456,46 @@ void ClassicCostumeRenderer::proc3(Codec1 &v1) {
 	}
 #endif /* USE_ARM_COSTUME_ASM */
 
+	// Pick the variant of the drawing loop without tests for the scaling,
+	// mask and shadow modes which do not apply.
+	const bool scaleY = (_scaleY != 255);
+	const bool masked = (v1.mask_ptr != NULL);
+
+	if (_shadow_mode & 0x20) {
+		if (scaleY && masked)
+			proc3_drawColumns<true, true, true>(v1);
+		else if (scaleY)
+			proc3_drawColumns<true, false, true>(v1);
+		else if (masked)
+			proc3_drawColumns<false, true, true>(v1);
+		else
+			proc3_drawColumns<false, false, true>(v1);
+	} else {
+		if (scaleY && masked)
+			proc3_drawColumns<true, true, false>(v1);
+		else if (scaleY)
+			proc3_drawColumns<true, false, false>(v1);
+		else if (masked)
+			proc3_drawColumns<false, true, false>(v1);
+		else
+			proc3_drawColumns<false, false, false>(v1);
+	}
+}
+
+template<bool kScaleY, bool kMasked, bool kShadowAll>
+void ClassicCostumeRenderer::proc3_drawColumns(Codec1 &v1) {
+	const byte *mask, *src;
+	byte *dst;
+	byte len, maskbit;
+	int y;
+	uint color, height, pcolor;
+	byte scaleIndexY;
+
+	const int pitch = _out.pitch;
+	const int outHeight = _out.h;
+	const byte scaleY = _scaleY;
+	const byte *shadowTable = _shadow_table;
+
 	y = v1.y;
 	src = _srcptr;
 	dst = v1.destptr;
@@ -475,6 +507,10 @@ void ClassicCostumeRenderer::proc3(Codec1 &v1) {
 	maskbit = revBitMask(v1.x & 7);
 	mask = v1.mask_ptr + v1.x / 8;
 
+	// The horizontal clipping only changes from one column to the next, so
+	// it is resolved when a column starts rather than for every pixel.
+	bool drawColumn = (v1.x >= 0 && v1.x < _out.w);
+
 	if (len)
 		goto StartPos;
 
@@ -486,20 +522,18 @@ void ClassicCostumeRenderer::proc3(Codec1 &v1) {
 			len = *src++;
 
 		do {
-			if (_scaleY == 255 || v1.scaletable[scaleIndexY++] < _scaleY) {
-				masked = (y < 0 || y >= _out.h) || (v1.x < 0 || v1.x >= _out.w) || (v1.mask_ptr && (mask[0] & maskbit));
-
-				if (color && !masked) {
-					if (_shadow_mode & 0x20) {
-						pcolor = _shadow_table[*dst];
+			if (!kScaleY || v1.scaletable[scaleIndexY++] < scaleY) {
+				if (color && drawColumn && y >= 0 && y < outHeight && !(kMasked && (mask[0] & maskbit))) {
+					if (kShadowAll) {
+						pcolor = shadowTable[*dst];
 					} else {
 						pcolor = _palette[color];
-						if (pcolor == 13 && _shadow_table)
-							pcolor = _shadow_table[*dst];
+						if (pcolor == 13 && shadowTable)
+							pcolor = shadowTable[*dst];
 					}
 					*dst = pcolor;
 				}
-				dst += _out.pitch;
+				dst += pitch;
 				mask += _numStrips;
 				y++;
 			}
@@ -517,6 +551,7 @@ void ClassicCostumeRenderer::proc3(Codec1 &v1) {
 						return;
 					maskbit = revBitMask(v1.x & 7);
 					v1.destptr += v1.scaleXstep;
+					drawColumn = true;
 				}
 				_scaleIndexX += v1.scaleXstep;
 				dst = v1.destptr;
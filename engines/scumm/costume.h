@@ -99,6 +99,8 @@ protected:
 	byte drawLimb(const Actor *a, int limb) override;
 
 	void proc3(Codec1 &v1);
+	template<bool kScaleY, bool kMasked, bool kShadowAll>
+	void proc3_drawColumns(Codec1 &v1);
 	void proc3_ami(Codec1 &v1);
 
 	void procC64(Codec1 &v1, int actor);
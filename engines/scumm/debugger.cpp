@@ -37,6 +37,8 @@
 
 namespace Scumm {
 
+extern const char *nameOfResType(ResType type);
+
 void debugC(int channel, const char *s, ...) {
 	char buf[STRINGBUFLEN];
 	va_list va;
@@ -79,6 +81,7 @@ ScummDebugger::ScummDebugger(ScummEngine *s)
 	registerCmd("scr",       WRAP_METHOD(ScummDebugger, Cmd_Script));
 	registerCmd("scripts",   WRAP_METHOD(ScummDebugger, Cmd_PrintScript));
 	registerCmd("importres", WRAP_METHOD(ScummDebugger, Cmd_ImportRes));
+	registerCmd("resources", WRAP_METHOD(ScummDebugger, Cmd_Resources));
 
 	if (_vm->_game.id == GID_LOOM)
 		registerCmd("drafts",  WRAP_METHOD(ScummDebugger, Cmd_PrintDraft));
@@ -325,6 +328,42 @@ bool ScummDebugger::Cmd_ImportRes(int argc, const char** argv) {
 	return true;
 }
 
+bool ScummDebugger::Cmd_Resources(int argc, const char **argv) {
+	ResourceManager *res = _vm->_res;
+
+	if (argc > 1) {
+		if (!strcmp(argv[1], "reset")) {
+			res->resetStats();
+			debugPrintf("Resource statistics reset\n");
+		} else {
+			debugPrintf("Syntax: resources [reset]\n");
+		}
+		return true;
+	}
+
+	debugPrintf("Heap: %d of %d bytes\n", res->getAllocatedSize(), res->getMaxHeapThreshold());
+	debugPrintf("+------------+----+---------+---------+-------+-------+-----+----------+\n");
+	debugPrintf("|type        |num |   bytes |  budget |  hits |misses |evict|    loaded|\n");
+	debugPrintf("+------------+----+---------+---------+-------+-------+-----+----------+\n");
+	for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
+		int num = 0;
+		for (ResId idx = 0; idx < res->_types[type].size(); idx++) {
+			if (res->_types[type][idx]._address)
+				num++;
+		}
+
+		const ResourceManager::TypeStats &stats = res->getTypeStats(type);
+		if (!num && !stats.hits && !stats.misses)
+			continue;
+
+		debugPrintf("|%-12s|%4d|%9d|%9d|%7d|%7d|%5d|%10d|\n",
+				nameOfResType(type), num, res->getAllocatedSize(type), res->getTypeBudget(type),
+				stats.hits, stats.misses, stats.evictions, stats.bytesLoaded);
+	}
+	debugPrintf("+------------+----+---------+---------+-------+-------+-----+----------+\n");
+	return true;
+}
+
 bool ScummDebugger::Cmd_PrintScript(int argc, const char **argv) {
 	int i;
 	ScriptSlot *ss = _vm->vm.slot;
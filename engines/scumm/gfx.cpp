@@ -20,6 +20,7 @@
  *
  */
 
+#include "common/profiler.h"
 #include "common/system.h"
 #include "scumm/actor.h"
 #include "scumm/charset.h"
@@ -215,6 +216,8 @@ Gdi::Gdi(ScummEngine *vm) : _vm(vm) {
 	_zbufferDisabled = false;
 	_objectMode = false;
 	_distaff = false;
+	_stripCacheEnabled = false;
+	_stripCachePaletteHash = 0;
 }
 
 Gdi::~Gdi() {
@@ -275,6 +278,7 @@ void Gdi::init() {
 }
 
 void Gdi::roomChanged(byte *roomptr) {
+	clearStripCache();
 }
 
 void GdiNES::roomChanged(byte *roomptr) {
@@ -587,27 +591,47 @@ void ScummEngine::updateDirtyScreen(VirtScreenNumber slot) {
 	if (vs->h == 0)
 		return;
 
-	int i;
-	int w = 8;
-	int start = 0;
-
-	for (i = 0; i < _gdi->_numStrips; i++) {
-		if (vs->bdirty[i]) {
-			const int top = vs->tdirty[i];
-			const int bottom = vs->bdirty[i];
-			vs->tdirty[i] = vs->h;
-			vs->bdirty[i] = 0;
-			if (i != (_gdi->_numStrips - 1) && vs->bdirty[i + 1] == bottom && vs->tdirty[i + 1] == top) {
-				// Simple optimizations: if two or more neighboring strips
-				// form one bigger rectangle, coalesce them.
-				w += 8;
+	// Neighboring dirty strips are coalesced into one rectangle, even if
+	// their dirty ranges differ, as long as that at most doubles the area
+	// to be drawn. Each drawStripToScreen call composites the text surface
+	// and hands its rectangle to the backend separately, so a few more
+	// pixels are cheaper than another call. MM NES treats full screen
+	// updates specially, so it only merges strips with equal ranges.
+	const int maxArea = (_game.platform == Common::kPlatformNES) ? 1 : 2;
+	int start = -1, end = 0;
+	int top = 0, bottom = 0;
+	int area = 0;
+
+	for (int i = 0; i < _gdi->_numStrips; i++) {
+		const int t = vs->tdirty[i];
+		const int b = vs->bdirty[i];
+		if (b == 0)
+			continue;
+		vs->tdirty[i] = vs->h;
+		vs->bdirty[i] = 0;
+		if (b <= t)
+			continue;
+
+		if (start >= 0) {
+			const int mergedTop = MIN(top, t);
+			const int mergedBottom = MAX(bottom, b);
+			if ((i + 1 - start) * (mergedBottom - mergedTop) <= maxArea * (area + b - t)) {
+				end = i + 1;
+				top = mergedTop;
+				bottom = mergedBottom;
+				area += b - t;
 				continue;
 			}
-			drawStripToScreen(vs, start * 8, w, top, bottom);
-			w = 8;
+			drawStripToScreen(vs, start * 8, (end - start) * 8, top, bottom);
 		}
-		start = i + 1;
+		start = i;
+		end = i + 1;
+		top = t;
+		bottom = b;
+		area = b - t;
 	}
+	if (start >= 0)
+		drawStripToScreen(vs, start * 8, (end - start) * 8, top, bottom);
 }
 
 /**
@@ -787,6 +811,7 @@ void ScummEngine::drawStripToScreen(VirtScreen *vs, int x, int width, int top, i
 	}
 
 	// Finally blit the whole thing to the screen
+	PROFILE_ZONE("copyRectToScreen");
 	_system->copyRectToScreen(src, pitch, x, y, width, height);
 }
 
@@ -1031,7 +1056,7 @@ void ScummEngine::redrawBGStrip(int start, int num) {
 	else
 		room = getResourceAddress(rtRoom, _roomResource);
 
-	_gdi->drawBitmap(room + _IM00_offs, &_virtscr[kMainVirtScreen], s, 0, _roomWidth, _virtscr[kMainVirtScreen].h, s, num, 0);
+	_gdi->drawBitmap(room + _IM00_offs, &_virtscr[kMainVirtScreen], s, 0, _roomWidth, _virtscr[kMainVirtScreen].h, s, num, Gdi::dbCacheStrips);
 }
 
 void ScummEngine::restoreBackground(Common::Rect rect, byte backColor) {
@@ -1854,6 +1879,20 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 	_objectMode = (flag & dbObjectMode) == dbObjectMode;
 	prepareDrawBitmap(ptr, vs, x, y, width, height, stripnr, numstrip);
 
+	// Only the room background is cached, see redrawBGStrip()
+	bool useStripCache = _stripCacheEnabled && (flag & dbCacheStrips) && vs->number == kMainVirtScreen &&
+		vs->format.bytesPerPixel == 1;
+	if (useStripCache) {
+		// The decoders map the colors through the room palette
+		uint32 paletteHash = 2166136261u;
+		for (int i = 0; i < 256; i++)
+			paletteHash = (paletteHash ^ _vm->_roomPalette[i]) * 16777619u;
+		if (paletteHash != _stripCachePaletteHash) {
+			clearStripCache();
+			_stripCachePaletteHash = paletteHash;
+		}
+	}
+
 	sx = x - vs->xstart / 8;
 	if (sx < 0) {
 		numstrip -= -sx;
@@ -1886,11 +1925,22 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 		else
 			dstPtr = (byte *)vs->getBasePtr(x * 8, y);
 
-		transpStrip = drawStrip(dstPtr, vs, x, y, width, height, stripnr, smap_ptr);
+		if (!useStripCache || !restoreCachedStrip(dstPtr, vs, x, y, height, stripnr, smap_ptr, numzbuf, zplane_list, transpStrip)) {
+			transpStrip = drawStrip(dstPtr, vs, x, y, width, height, stripnr, smap_ptr);
+
+			// Transparent strips are drawn over the previous content, which is
+			// not known when they are restored
+			bool cacheStrip = useStripCache && !transpStrip;
 
-		// COMI and HE games only uses flag value
-		if (_vm->_game.version == 8 || _vm->_game.heversion >= 60)
-			transpStrip = true;
+			// COMI and HE games only uses flag value
+			if (_vm->_game.version == 8 || _vm->_game.heversion >= 60)
+				transpStrip = true;
+
+			decodeMask(x, y, width, height, stripnr, numzbuf, zplane_list, transpStrip, flag);
+
+			if (cacheStrip)
+				storeCachedStrip(dstPtr, vs, x, y, height, stripnr, smap_ptr, numzbuf, zplane_list);
+		}
 
 		if (vs->hasTwoBuffers) {
 			byte *frontBuf = (byte *)vs->getBasePtr(x * 8, y);
@@ -1900,8 +1950,6 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 				clear8Col(frontBuf, vs->pitch, height, vs->format.bytesPerPixel);
 		}
 
-		decodeMask(x, y, width, height, stripnr, numzbuf, zplane_list, transpStrip, flag);
-
 #if 0
 		// HACK: blit mask(s) onto normal screen. Useful to debug masking
 		for (int i = 0; i < numzbuf; i++) {
@@ -1928,6 +1976,76 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 	}
 }
 
+void Gdi::clearStripCache() {
+	_stripCache.clear();
+}
+
+bool Gdi::restoreCachedStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int height,
+					int stripnr, const byte *smap_ptr, int numzbuf, const byte *zplane_list[9], bool &transpStrip) {
+	if (stripnr < 0 || stripnr >= (int)_stripCache.size())
+		return false;
+
+	const CachedStrip &strip = _stripCache[stripnr];
+	if (strip.smap != smap_ptr || strip.height != height || strip.y != y || strip.numZBuffer != numzbuf)
+		return false;
+
+	const byte *src = strip.data.begin();
+	for (int h = 0; h < height; h++) {
+		memcpy(dstPtr, src, 8);
+		dstPtr += vs->pitch;
+		src += 8;
+	}
+
+	// decodeMask() leaves alone the masks of the missing z-planes
+	for (int i = 1; i < numzbuf; i++) {
+		if (!zplane_list[i])
+			continue;
+
+		byte *mask_ptr = getMaskBuffer(x, y, i);
+		for (int h = 0; h < height; h++) {
+			*mask_ptr = *src++;
+			mask_ptr += _numStrips;
+		}
+	}
+
+	// Only opaque strips are cached
+	transpStrip = (_vm->_game.version == 8 || _vm->_game.heversion >= 60);
+	return true;
+}
+
+void Gdi::storeCachedStrip(const byte *dstPtr, VirtScreen *vs, int x, int y, const int height,
+					int stripnr, const byte *smap_ptr, int numzbuf, const byte *zplane_list[9]) {
+	if (stripnr < 0)
+		return;
+	if (stripnr >= (int)_stripCache.size())
+		_stripCache.resize(stripnr + 1);
+
+	CachedStrip &strip = _stripCache[stripnr];
+	strip.smap = smap_ptr;
+	strip.height = height;
+	strip.y = y;
+	strip.numZBuffer = numzbuf;
+	strip.data.resize(8 * height + MAX(numzbuf - 1, 0) * height);
+
+	byte *dst = strip.data.begin();
+	for (int h = 0; h < height; h++) {
+		memcpy(dst, dstPtr, 8);
+		dstPtr += vs->pitch;
+		dst += 8;
+	}
+
+	for (int i = 1; i < numzbuf; i++) {
+		if (!zplane_list[i])
+			continue;
+
+		const byte *mask_ptr = getMaskBuffer(x, y, i);
+		for (int h = 0; h < height; h++) {
+			*dst++ = *mask_ptr;
+			mask_ptr += _numStrips;
+		}
+	}
+}
+
 bool Gdi::drawStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int width, const int height,
 					int stripnr, const byte *smap_ptr) {
 	// Do some input verification and make sure the strip/strip offset
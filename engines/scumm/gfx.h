@@ -23,6 +23,7 @@
 #ifndef SCUMM_GFX_H
 #define SCUMM_GFX_H
 
+#include "common/array.h"
 #include "common/system.h"
 #include "common/list.h"
 
@@ -220,6 +221,29 @@ protected:
 	/** Flag which is true when an object is being rendered, false otherwise. */
 	bool _objectMode;
 
+	/**
+	 * A room background strip as decoded by drawStrip(), followed by its
+	 * z-plane masks as decoded by decodeMask().
+	 */
+	struct CachedStrip {
+		const byte *smap;	///< The SMAP the strip was decoded from, or null if unset
+		int y, height;
+		int numZBuffer;
+		Common::Array<byte> data;
+
+		CachedStrip() : smap(nullptr), y(0), height(0), numZBuffer(0) {}
+	};
+
+	/** Flag which is true when the room background strips may be cached. */
+	bool _stripCacheEnabled;
+	uint32 _stripCachePaletteHash;
+	Common::Array<CachedStrip> _stripCache;
+
+	bool restoreCachedStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int height,
+					int stripnr, const byte *smap_ptr, int numzbuf, const byte *zplane_list[9], bool &transpStrip);
+	void storeCachedStrip(const byte *dstPtr, VirtScreen *vs, int x, int y, const int height,
+					int stripnr, const byte *smap_ptr, int numzbuf, const byte *zplane_list[9]);
+
 public:
 	/** Flag which is true when loading objects or titles for distaff, in PCEngine version of Loom. */
 	bool _distaff;
@@ -276,6 +300,14 @@ public:
 	virtual void loadTiles(byte *roomptr);
 	void setTransparentColor(byte transparentColor) { _transparentColor = transparentColor; }
 
+	/**
+	 * Keep the room background strips decoded by drawBitmap(), so that
+	 * scrolling and redrawing the background does not decode them again.
+	 * Only Gdi classes using the generic strip and mask decoders may opt in.
+	 */
+	void enableStripCache() { _stripCacheEnabled = true; }
+	void clearStripCache();
+
 	void drawBitmap(const byte *ptr, VirtScreen *vs, int x, int y, const int width, const int height,
 	                int stripnr, int numstrip, byte flag);
 
@@ -293,7 +325,8 @@ public:
 	enum DrawBitmapFlags {
 		dbAllowMaskOr   = 1 << 0,
 		dbDrawMaskOnAll = 1 << 1,
-		dbObjectMode    = 2 << 2
+		dbObjectMode    = 2 << 2,
+		dbCacheStrips   = 1 << 4	///< Reuse the strips decoded earlier, see enableStripCache()
 	};
 };
 
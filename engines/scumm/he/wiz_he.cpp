@@ -371,6 +371,20 @@ void Wiz::writeColor(uint8 *dstPtr, int dstType, uint16 color) {
 }
 
 #ifdef USE_RGB_COLOR
+/**
+ * Whether runs of little endian 16-bit source pixels can be copied
+ * verbatim into a destination of the given type (see writeColor).
+ */
+static inline bool canCopy16BitRun(int dstType) {
+	if (dstType == kDstMemory || dstType == kDstResource)
+		return true;
+#ifdef SCUMM_LITTLE_ENDIAN
+	return dstType == kDstCursor || dstType == kDstScreen;
+#else
+	return false;
+#endif
+}
+
 void Wiz::copy16BitWizImage(uint8 *dst, const uint8 *src, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, int srcw, int srch, const Common::Rect *rect, int flags, const uint8 *xmapPtr) {
 	Common::Rect r1, r2;
 	if (calcClipRects(dstw, dsth, srcx, srcy, srcw, srch, rect, r1, r2)) {
@@ -773,9 +787,20 @@ void Wiz::decompress16BitWizImage(uint8 *dst, int dstPitch, int dstType, const u
 					if (w < 0) {
 						code += w;
 					}
-					while (code--) {
-						write16BitColor<type>(dstPtr, dataPtr, dstType, xmapPtr);
-						dstPtr += dstInc;
+					if (type == kWizCopy) {
+						// Convert the run color only once
+						uint8 pixel[2];
+						writeColor(pixel, dstType, READ_LE_UINT16(dataPtr));
+						while (code--) {
+							dstPtr[0] = pixel[0];
+							dstPtr[1] = pixel[1];
+							dstPtr += dstInc;
+						}
+					} else {
+						while (code--) {
+							write16BitColor<type>(dstPtr, dataPtr, dstType, xmapPtr);
+							dstPtr += dstInc;
+						}
 					}
 					dataPtr += 2;
 				} else {
@@ -793,10 +818,16 @@ void Wiz::decompress16BitWizImage(uint8 *dst, int dstPitch, int dstType, const u
 					if (w < 0) {
 						code += w;
 					}
-					while (code--) {
-						write16BitColor<type>(dstPtr, dataPtr, dstType, xmapPtr);
-						dataPtr += 2;
-						dstPtr += dstInc;
+					if (type == kWizCopy && dstInc == 2 && canCopy16BitRun(dstType)) {
+						memcpy(dstPtr, dataPtr, code * 2);
+						dataPtr += code * 2;
+						dstPtr += code * 2;
+					} else {
+						while (code--) {
+							write16BitColor<type>(dstPtr, dataPtr, dstType, xmapPtr);
+							dataPtr += 2;
+							dstPtr += dstInc;
+						}
 					}
 				}
 			}
@@ -907,9 +938,15 @@ void Wiz::decompressWizImage(uint8 *dst, int dstPitch, int dstType, const uint8
 					if (w < 0) {
 						code += w;
 					}
-					while (code--) {
-						write8BitColor<type>(dstPtr, dataPtr, dstType, palPtr, xmapPtr, bitDepth);
-						dstPtr += dstInc;
+					if (type != kWizXMap && dstInc == 1) {
+						// Solid runs do not depend on the destination
+						memset(dstPtr, (type == kWizRMap) ? palPtr[*dataPtr] : *dataPtr, code);
+						dstPtr += code;
+					} else {
+						while (code--) {
+							write8BitColor<type>(dstPtr, dataPtr, dstType, palPtr, xmapPtr, bitDepth);
+							dstPtr += dstInc;
+						}
 					}
 					dataPtr++;
 				} else {
@@ -927,10 +964,16 @@ void Wiz::decompressWizImage(uint8 *dst, int dstPitch, int dstType, const uint8
 					if (w < 0) {
 						code += w;
 					}
-					while (code--) {
-						write8BitColor<type>(dstPtr, dataPtr, dstType, palPtr, xmapPtr, bitDepth);
-						dataPtr++;
-						dstPtr += dstInc;
+					if (type == kWizCopy && dstInc == 1) {
+						memcpy(dstPtr, dataPtr, code);
+						dataPtr += code;
+						dstPtr += code;
+					} else {
+						while (code--) {
+							write8BitColor<type>(dstPtr, dataPtr, dstType, palPtr, xmapPtr, bitDepth);
+							dataPtr++;
+							dstPtr += dstInc;
+						}
 					}
 				}
 			}
@@ -954,6 +997,14 @@ void Wiz::decompressRawWizImage(uint8 *dst, int dstPitch, int dstType, const uin
 	if (w <= 0 || h <= 0) {
 		return;
 	}
+	if (type == kWizCopy && bitDepth == 1 && transColor == -1) {
+		while (h--) {
+			memcpy(dst, src, w);
+			src += srcPitch;
+			dst += dstPitch;
+		}
+		return;
+	}
 	while (h--) {
 		for (int i = 0; i < w; ++i) {
 			uint8 col = src[i];
@@ -149,6 +149,7 @@ BundleMgr::BundleMgr(BundleDirCache *cache) {
 	_fileBundleId = -1;
 	_file = new ScummFile();
 	_compInputBuff = NULL;
+	clearBlockCache();
 }
 
 BundleMgr::~BundleMgr() {
@@ -194,8 +195,7 @@ bool BundleMgr::open(const char *filename, bool &compressed, bool errorFlag) {
 	assert(_bundleTable);
 	_compTableLoaded = false;
 	_isUncompressed = false;
-	_outputSize = 0;
-	_lastBlock = -1;
+	clearBlockCache();
 
 	return true;
 }
@@ -208,8 +208,7 @@ void BundleMgr::close() {
 		_numCompItems = 0;
 		_compTableLoaded = false;
 		_isUncompressed = false;
-		_lastBlock = -1;
-		_outputSize = 0;
+		clearBlockCache();
 		_curSampleId = -1;
 		free(_compTable);
 		_compTable = NULL;
@@ -254,6 +253,39 @@ bool BundleMgr::loadCompTable(int32 index) {
 	return true;
 }
 
+void BundleMgr::clearBlockCache() {
+	for (int i = 0; i < kNumCachedBlocks; i++)
+		_blockCache[i].block = -1;
+	_blockClock = 0;
+}
+
+const BundleMgr::CachedBlock &BundleMgr::getBlock(int32 index, int32 block) {
+	CachedBlock *entry = &_blockCache[0];
+	for (int i = 0; i < kNumCachedBlocks; i++) {
+		if (_blockCache[i].block == block) {
+			_blockCache[i].lastUsed = ++_blockClock;
+			return _blockCache[i];
+		}
+		// Unused entries have never been touched, so they go first
+		if (_blockCache[i].block == -1 || _blockCache[i].lastUsed < entry->lastUsed)
+			entry = &_blockCache[i];
+		if (entry->block == -1)
+			break;
+	}
+
+	// CMI hack: one more zero byte at the end of input buffer
+	_compInputBuff[_compTable[block].size] = 0;
+	_file->seek(_bundleTable[index].offset + _compTable[block].offset, SEEK_SET);
+	_file->read(_compInputBuff, _compTable[block].size);
+	entry->size = BundleCodecs::decompressCodec(_compTable[block].codec, _compInputBuff, entry->data, _compTable[block].size);
+	if (entry->size > kBlockSize) {
+		error("_outputSize: %d", entry->size);
+	}
+	entry->block = block;
+	entry->lastUsed = ++_blockClock;
+	return *entry;
+}
+
 int32 BundleMgr::decompressSampleByCurIndex(int32 offset, int32 size, byte **compFinal, int headerSize, bool headerOutside) {
 	bool ignored = false;
 	return decompressSampleByIndex(_curSampleId, offset, size, compFinal, headerSize, headerOutside, ignored);
@@ -307,19 +339,9 @@ int32 BundleMgr::decompressSampleByIndex(int32 index, int32 offset, int32 size,
 	skip = (offset + headerSize) % 0x2000;
 
 	for (i = firstBlock; i <= lastBlock; i++) {
-		if (_lastBlock != i) {
-			// CMI hack: one more zero byte at the end of input buffer
-			_compInputBuff[_compTable[i].size] = 0;
-			_file->seek(_bundleTable[index].offset + _compTable[i].offset, SEEK_SET);
-			_file->read(_compInputBuff, _compTable[i].size);
-			_outputSize = BundleCodecs::decompressCodec(_compTable[i].codec, _compInputBuff, _compOutputBuff, _compTable[i].size);
-			if (_outputSize > 0x2000) {
-				error("_outputSize: %d", _outputSize);
-			}
-			_lastBlock = i;
-		}
+		const CachedBlock &blockData = getBlock(index, i);
 
-		outputSize = _outputSize;
+		outputSize = blockData.size;
 
 		if (headerOutside) {
 			outputSize -= skip;
@@ -336,7 +358,7 @@ int32 BundleMgr::decompressSampleByIndex(int32 index, int32 offset, int32 size,
 
 		assert(finalSize + outputSize <= blocksFinalSize);
 
-		memcpy(*compFinal + finalSize, _compOutputBuff + skip, outputSize);
+		memcpy(*compFinal + finalSize, blockData.data + skip, outputSize);
 		finalSize += outputSize;
 
 		size -= outputSize;
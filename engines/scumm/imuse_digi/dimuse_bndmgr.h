@@ -86,12 +86,28 @@ private:
 	bool _compTableLoaded;
 	bool _isUncompressed;
 	int _fileBundleId;
-	byte _compOutputBuff[0x2000];
 	byte *_compInputBuff;
-	int _outputSize;
-	int _lastBlock;
+
+	// Music regions loop and jump back to earlier blocks, so the last few
+	// decompressed blocks are kept around.
+	enum {
+		kBlockSize = 0x2000,
+		kNumCachedBlocks = 8
+	};
+
+	struct CachedBlock {
+		int32 block;	// -1 if unused
+		int32 size;
+		uint32 lastUsed;
+		byte data[kBlockSize];
+	};
+
+	CachedBlock _blockCache[kNumCachedBlocks];
+	uint32 _blockClock;
 
 	bool loadCompTable(int32 index);
+	void clearBlockCache();
+	const CachedBlock &getBlock(int32 index, int32 block);
 
 public:
 
@@ -33,14 +33,16 @@ NutRenderer::NutRenderer(ScummEngine *vm, const char *filename) :
 	_numChars(0),
 	_maxCharSize(0),
 	_fontHeight(0),
-	_charBuffer(0),
 	_decodedData(0) {
 	memset(_chars, 0, sizeof(_chars));
 	loadFont(filename);
 }
 
 NutRenderer::~NutRenderer() {
-	delete[] _charBuffer;
+	if (_bpp < 8) {
+		for (int i = 0; i < ARRAYSIZE(_chars); i++)
+			delete[] _chars[i].unpacked;
+	}
 	delete[] _decodedData;
 }
 
@@ -255,8 +257,9 @@ void NutRenderer::loadFont(const char *filename) {
 
 		delete[] _decodedData;
 		_decodedData = compressedData;
-
-		_charBuffer = new byte[_maxCharSize];
+	} else {
+		for (l = 0; l < 256; l++)
+			_chars[l].unpacked = _chars[l].src;
 	}
 
 	delete[] dataSrc;
@@ -283,11 +286,15 @@ int NutRenderer::getCharHeight(byte c) const {
 	return _chars[c].height;
 }
 
-byte *NutRenderer::unpackChar(byte c) {
-	if (_bpp == 8)
-		return _chars[c].src;
+const byte *NutRenderer::unpackChar(byte c) {
+	// The compressed glyphs are expanded only once, when they are first
+	// drawn. Text usually uses a small subset of the font, so this keeps
+	// most of the memory savings of the compression.
+	if (_chars[c].unpacked)
+		return _chars[c].unpacked;
 
 	byte *src = _chars[c].src;
+	byte *dst = _chars[c].unpacked = new byte[_chars[c].width * _chars[c].height];
 	int pitch = (_bpp * _chars[c].width + 7) / 8;
 
 	for (int ty = 0; ty < _chars[c].height; ty++) {
@@ -318,12 +325,12 @@ byte *NutRenderer::unpackChar(byte c) {
 					val |= (1 << i);
 			}
 
-			_charBuffer[ty * _chars[c].width + tx] = _palette[val];
+			dst[ty * _chars[c].width + tx] = _palette[val];
 		}
 		src += pitch;
 	}
 
-	return _charBuffer;
+	return dst;
 }
 
 void NutRenderer::drawFrame(byte *dst, int c, int x, int y) {
@@ -42,7 +42,6 @@ protected:
 	int _numChars;
 	int _maxCharSize;
 	int _fontHeight;
-	byte *_charBuffer;
 	byte *_decodedData;
 	byte *_paletteMap;
 	byte _bpp;
@@ -51,6 +50,7 @@ protected:
 		uint16 width;
 		uint16 height;
 		byte *src;
+		byte *unpacked;	// glyph expanded to 8 bpp on first use, see unpackChar
 		byte transparency;
 	} _chars[256];
 
@@ -58,7 +58,7 @@ protected:
 	void codec21(byte *dst, const byte *src, int width, int height, int pitch);
 
 	void loadFont(const char *filename);
-	byte *unpackChar(byte c);
+	const byte *unpackChar(byte c);
 
 public:
 	NutRenderer(ScummEngine *vm, const char *filename);
@@ -752,8 +752,10 @@ byte *ScummEngine::getResourceAddress(ResType type, ResId idx) {
 		return NULL;
 
 	// If the resource is missing, but loadable from the game data files, try to do so.
+	bool miss = false;
 	if (!_res->_types[type][idx]._address && _res->_types[type]._mode != kDynamicResTypeMode) {
 		ensureResourceLoaded(type, idx);
+		miss = true;
 	}
 
 	ptr = (byte *)_res->_types[type][idx]._address;
@@ -762,7 +764,7 @@ byte *ScummEngine::getResourceAddress(ResType type, ResId idx) {
 		return NULL;
 	}
 
-	_res->setResourceCounter(type, idx, 1);
+	_res->touchResource(type, idx, miss);
 
 	debugC(DEBUG_RESOURCE, "getResourceAddress(%s,%d) == %p", nameOfResType(type), idx, (void *)ptr);
 	return ptr;
@@ -808,6 +810,19 @@ void ResourceManager::setResourceCounter(ResType type, ResId idx, byte counter)
 	_types[type][idx].setResourceCounter(counter);
 }
 
+void ResourceManager::touchResource(ResType type, ResId idx, bool miss) {
+	Resource &res = _types[type][idx];
+	res.setResourceCounter(1);
+	res._lastUsed = ++_useClock;
+
+	if (_types[type]._mode != kDynamicResTypeMode) {
+		if (miss)
+			_typeStats[type].misses++;
+		else
+			_typeStats[type].hits++;
+	}
+}
+
 void ResourceManager::Resource::setResourceCounter(byte counter) {
 	_flags &= RF_LOCK;	// Clear lower 7 bits, preserve the lock bit.
 	_flags |= counter;	// Update the usage counter
@@ -837,7 +852,7 @@ byte *ResourceManager::createResource(ResType type, ResId idx, uint32 size) {
 
 	nukeResource(type, idx);
 
-	expireResources(size);
+	expireResources(type, size);
 
 	byte *ptr = new byte[size + SAFETY_AREA];
 	if (ptr == NULL) {
@@ -846,9 +861,13 @@ byte *ResourceManager::createResource(ResType type, ResId idx, uint32 size) {
 
 	memset(ptr, 0, size + SAFETY_AREA);
 	_allocatedSize += size;
+	_typeAllocatedSize[type] += size;
+	if (_types[type]._mode != kDynamicResTypeMode)
+		_typeStats[type].bytesLoaded += size;
 
 	_types[type][idx]._address = ptr;
 	_types[type][idx]._size = size;
+	_types[type][idx]._lastUsed = ++_useClock;
 	setResourceCounter(type, idx, 1);
 	return ptr;
 }
@@ -860,6 +879,7 @@ ResourceManager::Resource::Resource() {
 	_status = 0;
 	_roomno = 0;
 	_roomoffs = 0;
+	_lastUsed = 0;
 }
 
 ResourceManager::Resource::~Resource() {
@@ -888,6 +908,12 @@ ResourceManager::ResourceManager(ScummEngine *vm) : _vm(vm) {
 	_maxHeapThreshold = 0;
 	_minHeapThreshold = 0;
 	_expireCounter = 0;
+	_useClock = 0;
+
+	for (int type = 0; type <= rtLast; type++) {
+		_typeAllocatedSize[type] = 0;
+		_typeBudget[type] = 0;
+	}
 }
 
 ResourceManager::~ResourceManager() {
@@ -901,6 +927,16 @@ void ResourceManager::setHeapThreshold(int min, int max) {
 	_minHeapThreshold = min;
 }
 
+void ResourceManager::setTypeBudget(ResType type, uint32 budget) {
+	assert(type >= rtFirst && type <= rtLast);
+	_typeBudget[type] = budget;
+}
+
+void ResourceManager::resetStats() {
+	for (int type = 0; type <= rtLast; type++)
+		_typeStats[type] = TypeStats();
+}
+
 bool ResourceManager::validateResource(const char *str, ResType type, ResId idx) const {
 	if (type < rtFirst || type > rtLast || (uint)idx >= (uint)_types[type].size()) {
 		warning("%s Illegal Glob type %s (%d) num %d", str, nameOfResType(type), type, idx);
@@ -914,6 +950,7 @@ void ResourceManager::nukeResource(ResType type, ResId idx) {
 	if (ptr != NULL) {
 		debugC(DEBUG_RESOURCE, "nukeResource(%s,%d)", nameOfResType(type), idx);
 		_allocatedSize -= _types[type][idx]._size;
+		_typeAllocatedSize[type] -= _types[type][idx]._size;
 		_types[type][idx].nuke();
 	}
 }
@@ -1048,10 +1085,60 @@ void ResourceManager::Resource::setOnHeap() {
 	_status &= ~RF_OFFHEAP;
 }
 
-void ResourceManager::expireResources(uint32 size) {
-	byte best_counter;
-	ResType best_type;
-	int best_res = 0;
+bool ResourceManager::findExpireCandidate(ResType onlyType, ResType &bestType, ResId &bestIdx) const {
+	bestType = rtInvalid;
+	bestIdx = 0;
+
+	bool bestMarked = false;
+	uint32 bestLastUsed = 0;
+
+	for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
+		if (onlyType != rtInvalid && type != onlyType)
+			continue;
+
+		// Only resources which can be reloaded from the data files can be
+		// unloaded to free memory.
+		if (_types[type]._mode == kDynamicResTypeMode)
+			continue;
+
+		ResId idx = _types[type].size();
+		while (idx-- > 0) {
+			const Resource &tmp = _types[type][idx];
+			if (!tmp._address || tmp.isLocked() || tmp.isOffHeap())
+				continue;
+
+			// Resources used since the counters were last increased are
+			// possibly still referenced, keep them.
+			byte counter = tmp.getResourceCounter();
+			if (counter < 2)
+				continue;
+
+			// Resources marked by the scripts go first, then the least
+			// recently used ones.
+			bool marked = (counter == RF_USAGE_MAX);
+			if (bestType != rtInvalid) {
+				if (bestMarked && !marked)
+					continue;
+				if (bestMarked == marked && tmp._lastUsed >= bestLastUsed)
+					continue;
+			}
+
+			if (_vm->isResourceInUse(type, idx))
+				continue;
+
+			bestType = type;
+			bestIdx = idx;
+			bestMarked = marked;
+			bestLastUsed = tmp._lastUsed;
+		}
+	}
+
+	return bestType != rtInvalid;
+}
+
+void ResourceManager::expireResources(ResType type, uint32 size) {
+	ResType bestType;
+	ResId bestIdx;
 	uint32 oldAllocatedSize;
 
 	if (_expireCounter != 0xFF) {
@@ -1059,40 +1146,30 @@ void ResourceManager::expireResources(uint32 size) {
 		increaseResourceCounters();
 	}
 
-	if (size + _allocatedSize < _maxHeapThreshold)
-		return;
-
 	oldAllocatedSize = _allocatedSize;
 
-	do {
-		best_type = rtInvalid;
-		best_counter = 2;
-
-		for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
-			if (_types[type]._mode != kDynamicResTypeMode) {
-				// Resources of this type can be reloaded from the data files,
-				// so we can potentially unload them to free memory.
-				ResId idx = _types[type].size();
-				while (idx-- > 0) {
-					Resource &tmp = _types[type][idx];
-					byte counter = tmp.getResourceCounter();
-					if (!tmp.isLocked() && counter >= best_counter && tmp._address && !_vm->isResourceInUse(type, idx) && !tmp.isOffHeap()) {
-						best_counter = counter;
-						best_type = type;
-						best_res = idx;
-					}
-				}
-			}
+	if (_typeBudget[type]) {
+		while (size + _typeAllocatedSize[type] > _typeBudget[type]) {
+			if (!findExpireCandidate(type, bestType, bestIdx))
+				break;
+			nukeResource(bestType, bestIdx);
+			_typeStats[bestType].evictions++;
 		}
+	}
 
-		if (!best_type)
-			break;
-		nukeResource(best_type, best_res);
-	} while (size + _allocatedSize > _minHeapThreshold);
+	if (size + _allocatedSize >= _maxHeapThreshold) {
+		do {
+			if (!findExpireCandidate(rtInvalid, bestType, bestIdx))
+				break;
+			nukeResource(bestType, bestIdx);
+			_typeStats[bestType].evictions++;
+		} while (size + _allocatedSize > _minHeapThreshold);
 
-	increaseResourceCounters();
+		increaseResourceCounters();
+	}
 
-	debugC(DEBUG_RESOURCE, "Expired resources, mem %d -> %d", oldAllocatedSize, _allocatedSize);
+	if (oldAllocatedSize != _allocatedSize)
+		debugC(DEBUG_RESOURCE, "Expired resources, mem %d -> %d", oldAllocatedSize, _allocatedSize);
 }
 
 void ResourceManager::freeResources() {
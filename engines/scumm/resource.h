@@ -126,6 +126,13 @@ public:
 		 */
 		uint32 _roomoffs;
 
+		/**
+		 * Value of the resource manager's use clock when this resource was
+		 * last accessed. Used to expire the least recently used resources
+		 * first.
+		 */
+		uint32 _lastUsed;
+
 	public:
 		Resource();
 		~Resource();
@@ -171,17 +178,50 @@ public:
 	};
 	ResTypeData _types[rtLast + 1];
 
+	/**
+	 * Usage statistics of a resource type, as shown by the debugger.
+	 */
+	struct TypeStats {
+		uint32 hits;		///< Accesses to a resource which was already loaded
+		uint32 misses;		///< Accesses which had to load the resource first
+		uint32 evictions;	///< Resources expired to free memory
+		uint32 bytesLoaded;	///< Bytes loaded from the game data files
+
+		TypeStats() : hits(0), misses(0), evictions(0), bytesLoaded(0) {}
+	};
+
 protected:
 	uint32 _allocatedSize;
 	uint32 _maxHeapThreshold, _minHeapThreshold;
 	byte _expireCounter;
 
+	uint32 _useClock;
+	uint32 _typeAllocatedSize[rtLast + 1];
+	uint32 _typeBudget[rtLast + 1];
+	TypeStats _typeStats[rtLast + 1];
+
 public:
 	ResourceManager(ScummEngine *vm);
 	~ResourceManager();
 
 	void setHeapThreshold(int min, int max);
 
+	/**
+	 * Limit the memory used by the resources of the given type. When the
+	 * resources of that type use more, the least recently used of them are
+	 * expired first, even if the heap threshold is not reached yet.
+	 * A budget of 0 means no limit.
+	 */
+	void setTypeBudget(ResType type, uint32 budget);
+	uint32 getTypeBudget(ResType type) const { return _typeBudget[type]; }
+
+	uint32 getAllocatedSize() const { return _allocatedSize; }
+	uint32 getAllocatedSize(ResType type) const { return _typeAllocatedSize[type]; }
+	uint32 getMaxHeapThreshold() const { return _maxHeapThreshold; }
+
+	const TypeStats &getTypeStats(ResType type) const { return _typeStats[type]; }
+	void resetStats();
+
 	void allocResTypeData(ResType type, uint32 tag, int num, ResTypeMode mode);
 	void freeResources();
 
@@ -215,6 +255,13 @@ public:
 	 */
 	void setResourceCounter(ResType type, ResId idx, byte counter);
 
+	/**
+	 * Mark the specified resource as just used: reset its counter and
+	 * record the access in the statistics. A miss is an access which had
+	 * to load the resource first.
+	 */
+	void touchResource(ResType type, ResId idx, bool miss);
+
 	/**
 	 * Increment the counter of all unlocked loaded resources.
 	 * The maximal count is 255.
@@ -228,7 +275,21 @@ public:
 //protected:
 	bool validateResource(const char *str, ResType type, ResId idx) const;
 protected:
-	void expireResources(uint32 size);
+	/**
+	 * Make room for a new resource of the given type and size. Resources of
+	 * that type are expired first while the type is over its budget. Then,
+	 * if the total heap threshold would be exceeded, the least recently
+	 * used expirable resources of any type are expired until the heap is
+	 * back under the lower threshold. Resources which scripts marked as no
+	 * longer needed go first.
+	 */
+	void expireResources(ResType type, uint32 size);
+
+	/**
+	 * Find the best resource to expire, either of any type (rtInvalid) or
+	 * of the given type. Returns false if no resource can be expired.
+	 */
+	bool findExpireCandidate(ResType onlyType, ResType &bestType, ResId &bestIdx) const;
 };
 
 } // End of namespace Scumm
@@ -481,6 +481,7 @@ void ScummEngine::resetRoomSubBlocks() {
 
 	_res->nukeResource(rtMatrix, 1);
 	_res->nukeResource(rtMatrix, 2);
+	clearBoxCache();
 	if (_game.features & GF_SMALL_HEADER) {
 		ptr = findResourceData(MKTAG('B','O','X','D'), roomptr);
 		if (ptr) {
@@ -739,6 +740,7 @@ void ScummEngine_v3old::resetRoomSubBlocks() {
 	//
 	_res->nukeResource(rtMatrix, 1);
 	_res->nukeResource(rtMatrix, 2);
+	clearBoxCache();
 
 	if (_game.version <= 2)
 		ptr = roomptr + *(roomptr + 0x15);
@@ -434,6 +434,10 @@ bool ScummEngine::loadState(int slot, bool compat, Common::String &filename) {
 				_res->nukeResource(type, idx);
 			}
 
+	// The room is loaded again, maybe at the same address
+	_gdi->clearStripCache();
+	clearBoxCache();
+
 	resetScummVars();
 
 	if (_game.features & GF_OLD_BUNDLE)
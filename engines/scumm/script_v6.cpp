@@ -3075,6 +3075,7 @@ void ScummEngine_v6::o6_setBoxSet() {
 		error("ScummEngine_v6::o6_setBoxSet: Can't find dboxes for set %d", arg);
 
 	dboxSize = READ_BE_UINT32(boxd + 4) - 8;
+	clearBoxCache();
 	byte *matrix = _res->createResource(rtMatrix, 2, dboxSize);
 
 	assert(matrix);
@@ -25,7 +25,9 @@
 #include "common/macresman.h"
 #include "common/md5.h"
 #include "common/events.h"
+#include "common/profiler.h"
 #include "common/system.h"
+#include "common/trace.h"
 #include "common/translation.h"
 
 #include "engines/util.h"
@@ -132,6 +134,7 @@ ScummEngine::ScummEngine(OSystem *syst, const DetectorResult &dr)
 		_gdi = new GdiV2(this);
 	} else {
 		_gdi = new Gdi(this);
+		_gdi->enableStripCache();
 	}
 	_res = new ResourceManager(this);
 
@@ -1100,6 +1103,7 @@ ScummEngine_v8::~ScummEngine_v8() {
 #pragma mark -
 
 Common::Error ScummEngine::init() {
+	Common::TraceScope trace("ScummEngine::init");
 
 	const Common::FSNode gameDataDir(ConfMan.get("path"));
 
@@ -1467,9 +1471,15 @@ Common::Error ScummEngine::init() {
 
 	_outputPixelFormat = _system->getScreenFormat();
 
-	setupScumm(macResourceFile);
+	{
+		Common::TraceScope setupTrace("ScummEngine::setupScumm");
+		setupScumm(macResourceFile);
+	}
 
-	readIndexFile();
+	{
+		Common::TraceScope indexTrace("ScummEngine::readIndexFile");
+		readIndexFile();
+	}
 
 	// Create the debugger now that _numVariables has been set
 	setDebugger(new ScummDebugger(this));
@@ -1602,7 +1612,27 @@ void ScummEngine::setupScumm(const Common::String &macResourceFile) {
 		maxHeapThreshold = 550000;
 	}
 
-	_res->setHeapThreshold(400000, maxHeapThreshold);
+	maxHeapThreshold = MIN<uint32>(getResourceMemoryBudget(maxHeapThreshold), 0x7FFFFFFF);
+
+	// The heap size can be overridden, e.g. by ports with little memory.
+	// A size of 0 keeps all the resources in memory once loaded.
+	if (ConfMan.hasKey("scumm_heap_size")) {
+		int heapSize = ConfMan.getInt("scumm_heap_size");
+		if (heapSize > 0)
+			maxHeapThreshold = heapSize * 1024;
+		else
+			maxHeapThreshold = 0x7FFFFFFF;
+	}
+
+	_res->setHeapThreshold(MIN(400000, maxHeapThreshold / 4 * 3), maxHeapThreshold);
+
+	// Sounds (digital speech and music in particular) can be much bigger
+	// than the costumes and scripts used at the same time. Keep them from
+	// taking the whole heap, so that they expire each other first.
+	int soundBudget = maxHeapThreshold / 2;
+	if (ConfMan.hasKey("scumm_sound_heap_size"))
+		soundBudget = ConfMan.getInt("scumm_sound_heap_size") * 1024;
+	_res->setTypeBudget(rtSound, soundBudget > 0 ? soundBudget : 0);
 
 	free(_compositeBuf);
 	_compositeBuf = (byte *)malloc(_screenWidth * _textSurfaceMultiplier * _screenHeight * _textSurfaceMultiplier * _outputPixelFormat.bytesPerPixel);
@@ -2358,6 +2388,7 @@ Common::Error ScummEngine::go() {
 
 		// Run the main loop
 		scummLoop(delta);
+		PROFILE_FRAME();
 
 		// Halt the stop watch and compute how much time this iteration took.
 		diff = _system->getMillis() - diff;
@@ -2413,6 +2444,8 @@ void ScummEngine_v0::scummLoop(int delta) {
 }
 
 void ScummEngine::scummLoop(int delta) {
+	PROFILE_ZONE("scummLoop");
+
 	if (_game.version >= 3) {
 		VAR(VAR_TMR_1) += delta;
 		VAR(VAR_TMR_2) += delta;
@@ -2503,9 +2536,12 @@ load_game:
 	if (_game.heversion >= 80) {
 		((SoundHE *)_sound)->processSoundCode();
 	}
-	runAllScripts();
-	checkExecVerbs();
-	checkAndRunSentenceScript();
+	{
+		PROFILE_ZONE("runAllScripts");
+		runAllScripts();
+		checkExecVerbs();
+		checkAndRunSentenceScript();
+	}
 
 	if (shouldQuit())
 		return;
@@ -2533,13 +2569,22 @@ load_game:
 		if (_game.version > 3)
 			CHARSET_1();
 
-		scummLoop_handleDrawing();
+		{
+			PROFILE_ZONE("handleDrawing");
+			scummLoop_handleDrawing();
+		}
 
-		scummLoop_handleActors();
+		{
+			PROFILE_ZONE("handleActors");
+			scummLoop_handleActors();
+		}
 
 		_fullRedraw = false;
 
-		scummLoop_handleEffects();
+		{
+			PROFILE_ZONE("handleEffects");
+			scummLoop_handleEffects();
+		}
 
 		if (VAR_MAIN_SCRIPT != 0xFF && VAR(VAR_MAIN_SCRIPT) != 0) {
 			runScript(VAR(VAR_MAIN_SCRIPT), 0, 0, 0);
@@ -2549,8 +2594,11 @@ load_game:
 		handleMouseOver(oldEgo != VAR(VAR_EGO));
 
 		// Render everything to the screen.
-		updatePalette();
-		drawDirtyScreenParts();
+		{
+			PROFILE_ZONE("drawDirtyScreenParts");
+			updatePalette();
+			drawDirtyScreenParts();
+		}
 
 		// FIXME / TODO: Try to move the following to scummLoop_handleSound or
 		// scummLoop_handleActors (but watch out for regressions!)
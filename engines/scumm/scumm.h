@@ -39,6 +39,7 @@
 #include "graphics/surface.h"
 #include "graphics/sjis.h"
 
+#include "scumm/boxes.h"
 #include "scumm/gfx.h"
 #include "scumm/detection.h"
 #include "scumm/script.h"
@@ -607,8 +608,20 @@ protected:
 	void resetScriptPointer();
 	int getVerbEntrypoint(int obj, int entry);
 
-	void refreshScriptPointer();
-	byte fetchScriptByte();
+	/**
+	 * Check whether the resource that contains the active script moved, and
+	 * if so, update the script pointer. This runs for every byte fetched, so
+	 * only the check is done inline.
+	 */
+	void refreshScriptPointer() {
+		if (*_lastCodePtr != _scriptOrgPointer)
+			relocateScriptPointer();
+	}
+	void relocateScriptPointer();
+	byte fetchScriptByte() {
+		refreshScriptPointer();
+		return *_scriptPointer++;
+	}
 	virtual uint fetchScriptWord();
 	virtual int fetchScriptWordSigned();
 	uint fetchScriptDWord();
@@ -1079,7 +1092,15 @@ public:
 	int getScale(int box, int x, int y);
 	int getScaleFromSlot(int slot, int x, int y);
 
+	void clearBoxCache();
+
 protected:
+	BoxCache _boxCache;
+
+	BoxCoords decodeBoxCoordinates(int boxnum);
+	bool updateBoxCoordsCache();
+	bool updateNextBoxCache(int numOfBoxes);
+
 	// Scaling slots/items
 	struct ScaleSlot {
 		int x1, y1, scale1;
@@ -53,6 +53,7 @@ protected:
 	void proc4WithoutFDFE(byte *dst, const byte *src, int32, int, int, int, int16 *);
 public:
 	void decode(byte *dst, const byte *src);
+	int32 getFrameSize() const { return _frameSize; }
 };
 
 } // End of namespace Scumm
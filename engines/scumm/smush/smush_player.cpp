@@ -22,7 +22,10 @@
 
 #include "common/config-manager.h"
 #include "common/file.h"
+#include "common/memstream.h"
+#include "common/spscqueue.h"
 #include "common/system.h"
+#include "common/threadpool.h"
 #include "common/util.h"
 #include "common/rect.h"
 
@@ -251,6 +254,21 @@ SmushPlayer::SmushPlayer(ScummEngine_v7 *scumm) {
 	_pauseStartTime = 0;
 	_pauseTime = 0;
 
+	_aheadFrames = 0;
+	_aheadActive = false;
+	_aheadEnd = false;
+	_aheadPool = nullptr;
+	_aheadJobRunning = 0;
+	_aheadCodec37 = nullptr;
+	_aheadCodec47 = nullptr;
+	_aheadHead = 0;
+	_aheadCount = 0;
+	_curAheadFrame = nullptr;
+	_curAheadObject = 0;
+	for (int i = 0; i < kMaxAheadFrames; i++) {
+		_ahead[i].data = nullptr;
+		_ahead[i].endOfFile = false;
+	}
 
 	_IACTchannel = new Audio::SoundHandle();
 	_compressedFileSoundHandle = new Audio::SoundHandle();
@@ -292,6 +310,8 @@ void SmushPlayer::init(int32 speed) {
 }
 
 void SmushPlayer::release() {
+	stopDecodeAhead();
+
 	_vm->_smushVideoShouldFinish = true;
 
 	for (int i = 0; i < 5; i++) {
@@ -737,7 +757,7 @@ void SmushPlayer::handleNewPalette(int32 subSize, Common::SeekableReadStream &b)
 void smush_decode_codec1(byte *dst, const byte *src, int left, int top, int width, int height, int pitch);
 void smush_decode_codec20(byte *dst, const byte *src, int left, int top, int width, int height, int pitch);
 
-void SmushPlayer::decodeFrameObject(int codec, const uint8 *src, int left, int top, int width, int height) {
+void SmushPlayer::decodeFrameObject(int codec, const uint8 *src, int left, int top, int width, int height, const AheadObject *ahead) {
 	if ((height == 242) && (width == 384)) {
 		if (_specialBuffer == 0)
 			_specialBuffer = (byte *)malloc(242 * 384);
@@ -764,12 +784,22 @@ void SmushPlayer::decodeFrameObject(int codec, const uint8 *src, int left, int t
 		smush_decode_codec1(_dst, src, left, top, width, height, _vm->_screenWidth);
 		break;
 	case 37:
+		if (ahead) {
+			if (ahead->pixels)
+				memcpy(_dst, ahead->pixels, ahead->size);
+			break;
+		}
 		if (!_codec37)
 			_codec37 = new Codec37Decoder(width, height);
 		if (_codec37)
 			_codec37->decode(_dst, src);
 		break;
 	case 47:
+		if (ahead) {
+			if (ahead->pixels)
+				memcpy(_dst, ahead->pixels, ahead->size);
+			break;
+		}
 		if (!_codec47)
 			_codec47 = new Codec47Decoder(width, height);
 		if (_codec47)
@@ -794,11 +824,18 @@ void SmushPlayer::decodeFrameObject(int codec, const uint8 *src, int left, int t
 
 #ifdef USE_ZLIB
 void SmushPlayer::handleZlibFrameObject(int32 subSize, Common::SeekableReadStream &b) {
+	const AheadObject *ahead = nextAheadObject();
+
 	if (_skipNext) {
 		_skipNext = false;
 		return;
 	}
 
+	if (ahead) {
+		decodeFrameObject(ahead->codec, nullptr, 0, 0, ahead->width, ahead->height, ahead);
+		return;
+	}
+
 	int32 chunkSize = subSize;
 	byte *chunkBuffer = (byte *)malloc(chunkSize);
 	assert(chunkBuffer);
@@ -825,11 +862,18 @@ void SmushPlayer::handleZlibFrameObject(int32 subSize, Common::SeekableReadStrea
 
 void SmushPlayer::handleFrameObject(int32 subSize, Common::SeekableReadStream &b) {
 	assert(subSize >= 14);
+	const AheadObject *ahead = nextAheadObject();
+
 	if (_skipNext) {
 		_skipNext = false;
 		return;
 	}
 
+	if (ahead) {
+		decodeFrameObject(ahead->codec, nullptr, 0, 0, ahead->width, ahead->height, ahead);
+		return;
+	}
+
 	int codec = b.readUint16LE();
 	int left = b.readUint16LE();
 	int top = b.readUint16LE();
@@ -1033,6 +1077,48 @@ void SmushPlayer::parseNextFrame() {
 
 	assert(_base);
 
+	// Interactive Full Throttle scenes seek around the file, so these are
+	// always decoded when due.
+	if (!_insanity && _aheadFrames > 0 && !_aheadActive)
+		startDecodeAhead();
+
+	if (_aheadActive) {
+		AheadFrame frame;
+		popAheadFrame(frame);
+
+		if (frame.endOfFile) {
+			_vm->_smushVideoShouldFinish = true;
+			_endOfFile = true;
+			return;
+		}
+
+		debug(3, "Chunk: %s at %x", tag2str(frame.type), frame.offset);
+
+		Common::MemoryReadStream stream(frame.data, frame.size);
+		_curAheadFrame = &frame;
+		_curAheadObject = 0;
+
+		switch (frame.type) {
+		case MKTAG('A','H','D','R'):
+			handleAnimHeader(frame.size, stream);
+			break;
+		case MKTAG('F','R','M','E'):
+			handleFrame(frame.size, stream);
+			break;
+		default:
+			error("Unknown Chunk found at %x: %s, %d", frame.offset, tag2str(frame.type), frame.size);
+		}
+
+		_curAheadFrame = nullptr;
+		freeAheadFrame(frame);
+
+		// Decode a frame for the slot just freed
+		wakeUpDecodeAhead();
+
+		_vm->_imuseDigital->flushTracks();
+		return;
+	}
+
 	const uint32 subType = _base->readUint32BE();
 	const int32 subSize = _base->readUint32BE();
 	const int32 subOffset = _base->pos();
@@ -1064,6 +1150,230 @@ void SmushPlayer::parseNextFrame() {
 	_vm->_imuseDigital->flushTracks();
 }
 
+const SmushPlayer::AheadObject *SmushPlayer::nextAheadObject() {
+	if (!_curAheadFrame || _curAheadObject >= _curAheadFrame->objects.size())
+		return nullptr;
+
+	const AheadObject *object = &_curAheadFrame->objects[_curAheadObject++];
+	return object->decoded ? object : nullptr;
+}
+
+void SmushPlayer::startDecodeAhead() {
+	_aheadHead = 0;
+	_aheadCount = 0;
+	_aheadEnd = false;
+	_aheadActive = true;
+
+	// One worker thread, and the calling thread which is not used. Without
+	// a worker thread the frames are still read and decoded by
+	// popAheadFrame(), just like without decoding ahead.
+	_aheadPool = _vm->_system->createThreadPool(2);
+	if (_aheadPool->getThreadCount() < 2) {
+		delete _aheadPool;
+		_aheadPool = nullptr;
+	}
+
+	wakeUpDecodeAhead();
+}
+
+void SmushPlayer::stopDecodeAhead() {
+	if (!_aheadActive)
+		return;
+
+	{
+		Common::StackLock lock(_aheadQueueMutex);
+		_aheadActive = false;
+	}
+
+	// This waits for a running job, which stops after the current frame
+	delete _aheadPool;
+	_aheadPool = nullptr;
+	_aheadJobRunning = 0;
+
+	Common::StackLock decodeLock(_aheadDecodeMutex);
+	Common::StackLock lock(_aheadQueueMutex);
+	while (_aheadCount > 0) {
+		freeAheadFrame(_ahead[_aheadHead]);
+		_aheadHead = (_aheadHead + 1) % kMaxAheadFrames;
+		_aheadCount--;
+	}
+
+	delete _aheadCodec37;
+	_aheadCodec37 = nullptr;
+	delete _aheadCodec47;
+	_aheadCodec47 = nullptr;
+}
+
+void SmushPlayer::wakeUpDecodeAhead() {
+	if (!_aheadPool || Common::loadAcquire(_aheadJobRunning))
+		return;
+
+	Common::storeRelease(_aheadJobRunning, (uint32)1);
+	if (!_aheadPool->startBackgroundJob(&decodeAheadProc, this))
+		Common::storeRelease(_aheadJobRunning, (uint32)0);
+}
+
+void SmushPlayer::decodeAheadProc(void *refCon) {
+	SmushPlayer *player = (SmushPlayer *)refCon;
+	player->fillAheadQueue();
+	Common::storeRelease(player->_aheadJobRunning, (uint32)0);
+}
+
+void SmushPlayer::fillAheadQueue() {
+	for (;;) {
+		Common::StackLock decodeLock(_aheadDecodeMutex);
+		{
+			Common::StackLock lock(_aheadQueueMutex);
+			if (!_aheadActive || _aheadEnd || _aheadCount >= (uint)_aheadFrames)
+				return;
+		}
+
+		AheadFrame frame;
+		readAheadFrame(frame);
+
+		Common::StackLock lock(_aheadQueueMutex);
+		_aheadEnd = frame.endOfFile;
+		_ahead[(_aheadHead + _aheadCount) % kMaxAheadFrames] = frame;
+		_aheadCount++;
+	}
+}
+
+void SmushPlayer::popAheadFrame(AheadFrame &frame) {
+	bool decodeHere = false;
+
+	for (;;) {
+		{
+			Common::StackLock lock(_aheadQueueMutex);
+			if (_aheadCount > 0) {
+				frame = _ahead[_aheadHead];
+				_ahead[_aheadHead].data = nullptr;
+				_ahead[_aheadHead].objects.clear();
+				_aheadHead = (_aheadHead + 1) % kMaxAheadFrames;
+				_aheadCount--;
+				return;
+			}
+		}
+
+		if (decodeHere)
+			break;
+
+		// Nothing is ready. Wait for the frame currently being decoded,
+		// if any, and otherwise decode it right now.
+		_aheadDecodeMutex.lock();
+		decodeHere = true;
+	}
+
+	readAheadFrame(frame);
+	{
+		Common::StackLock lock(_aheadQueueMutex);
+		_aheadEnd = frame.endOfFile;
+	}
+	_aheadDecodeMutex.unlock();
+}
+
+void SmushPlayer::readAheadFrame(AheadFrame &frame) {
+	frame.type = _base->readUint32BE();
+	frame.size = _base->readUint32BE();
+	frame.offset = _base->pos();
+	frame.data = nullptr;
+	frame.endOfFile = false;
+	frame.objects.clear();
+
+	if (_base->pos() >= (int32)_baseSize) {
+		frame.endOfFile = true;
+		return;
+	}
+
+	frame.data = (byte *)malloc(MAX<int32>(frame.size, 1));
+	assert(frame.data);
+	int32 read = _base->read(frame.data, frame.size);
+	if (read < frame.size)
+		memset(frame.data + read, 0, frame.size - read);
+	_base->seek(frame.offset + frame.size, SEEK_SET);
+
+	if (frame.type != MKTAG('F','R','M','E'))
+		return;
+
+	// Walk the sub-chunks the same way handleFrame() does, and decode
+	// the frame objects on the way.
+	int32 frameSize = frame.size;
+	int32 pos = 0;
+	while (frameSize > 0 && pos + 8 <= frame.size) {
+		const uint32 subType = READ_BE_UINT32(frame.data + pos);
+		const int32 subSize = READ_BE_UINT32(frame.data + pos + 4);
+		const int32 subOffset = pos + 8;
+		if (subSize < 0 || subOffset + subSize > frame.size)
+			break;
+
+		const byte *sub = frame.data + subOffset;
+		if (subType == MKTAG('F','O','B','J') && subSize >= 14) {
+			decodeAheadObject(frame, sub, sub + 14);
+#ifdef USE_ZLIB
+		} else if (subType == MKTAG('Z','F','O','B') && subSize >= 4) {
+			unsigned long decompressedSize = READ_BE_UINT32(sub);
+			byte *fobjBuffer = (byte *)malloc(decompressedSize);
+			if (!Common::uncompress(fobjBuffer, &decompressedSize, sub + 4, subSize - 4))
+				error("SmushPlayer::readAheadFrame() Zlib uncompress error");
+			decodeAheadObject(frame, fobjBuffer, fobjBuffer + 14);
+			free(fobjBuffer);
+#endif
+		}
+
+		frameSize -= subSize + 8;
+		pos = subOffset + subSize;
+		if (subSize & 1) {
+			pos++;
+			frameSize--;
+		}
+	}
+}
+
+void SmushPlayer::decodeAheadObject(AheadFrame &frame, const byte *header, const byte *src) {
+	AheadObject object;
+	object.codec = READ_LE_UINT16(header);
+	object.width = READ_LE_UINT16(header + 6);
+	object.height = READ_LE_UINT16(header + 8);
+	object.decoded = false;
+	object.pixels = nullptr;
+	object.size = 0;
+
+	// Only full screen objects are drawn outside of Full Throttle's
+	// interactive scenes, see decodeFrameObject(). The others are left to
+	// it, so the decoders used here only ever see the full screen images.
+	const bool fullScreen = (object.width == 384 && object.height == 242) ||
+		(object.width == _vm->_screenWidth && object.height == _vm->_screenHeight);
+
+	if (fullScreen && object.codec == 37) {
+		if (!_aheadCodec37)
+			_aheadCodec37 = new Codec37Decoder(object.width, object.height);
+		object.size = _aheadCodec37->getFrameSize();
+		object.pixels = (byte *)malloc(object.size);
+		_aheadCodec37->decode(object.pixels, src);
+		object.decoded = true;
+	} else if (fullScreen && object.codec == 47) {
+		if (!_aheadCodec47)
+			_aheadCodec47 = new Codec47Decoder(object.width, object.height);
+		object.size = _aheadCodec47->getFrameSize();
+		object.pixels = (byte *)malloc(object.size);
+		if (!_aheadCodec47->decode(object.pixels, src)) {
+			free(object.pixels);
+			object.pixels = nullptr;
+		}
+		object.decoded = true;
+	}
+
+	frame.objects.push_back(object);
+}
+
+void SmushPlayer::freeAheadFrame(AheadFrame &frame) {
+	for (uint i = 0; i < frame.objects.size(); i++)
+		free(frame.objects[i].pixels);
+	frame.objects.clear();
+
+	free(frame.data);
+	frame.data = nullptr;
+}
+
 void SmushPlayer::setPalette(const byte *palette) {
 	memcpy(_pal, palette, 0x300);
 	setDirtyColors(0, 255);
@@ -1192,6 +1502,10 @@ void SmushPlayer::play(const char *filename, int32 speed, int32 offset, int32 st
 
 	_pauseTime = 0;
 
+	_aheadFrames = 2;
+	if (ConfMan.hasKey("smush_decode_ahead"))
+		_aheadFrames = CLIP<int>(ConfMan.getInt("smush_decode_ahead"), 0, kMaxAheadFrames);
+
 	int skipped = 0;
 
 	for (;;) {
@@ -23,6 +23,8 @@
 #if !defined(SCUMM_SMUSH_PLAYER_H) && defined(ENABLE_SCUMM_7_8)
 #define SCUMM_SMUSH_PLAYER_H
 
+#include "common/array.h"
+#include "common/mutex.h"
 #include "common/util.h"
 
 namespace Audio {
@@ -30,6 +32,10 @@ class SoundHandle;
 class QueuingAudioStream;
 }
 
+namespace Common {
+class ThreadPool;
+}
+
 namespace Scumm {
 
 class ScummEngine_v7;
@@ -86,6 +92,55 @@ private:
 	bool _middleAudio;
 	bool _skipPalette;
 
+	/**
+	 * A frame object whose codec 37 or 47 image was decoded ahead of time.
+	 */
+	struct AheadObject {
+		int codec;
+		int width, height;
+		bool decoded;		///< False if the object is decoded when the frame is shown
+		byte *pixels;
+		uint32 size;
+	};
+
+	/**
+	 * A chunk read and decoded ahead of time.
+	 */
+	struct AheadFrame {
+		uint32 type;
+		int32 size;
+		int32 offset;
+		byte *data;
+		bool endOfFile;
+		Common::Array<AheadObject> objects;	///< One entry per FOBJ/ZFOB chunk
+	};
+
+	enum {
+		kMaxAheadFrames = 8
+	};
+
+	/**
+	 * Number of frames decoded ahead, or 0 if everything is decoded when
+	 * the frame is due. Frames are decoded ahead by a background job of a
+	 * thread pool, which is started whenever a frame was shown. Only the
+	 * full screen codec 37 and 47 images are decoded ahead, with decoders
+	 * of their own; the other objects and the audio, palette and text
+	 * chunks are still handled in order when the frame is shown.
+	 */
+	int _aheadFrames;
+	bool _aheadActive;
+	bool _aheadEnd;
+	Common::ThreadPool *_aheadPool;		///< Provides the worker thread, or null to decode when due
+	volatile uint32 _aheadJobRunning;
+	Codec37Decoder *_aheadCodec37;		///< Only used with _aheadDecodeMutex held
+	Codec47Decoder *_aheadCodec47;
+	AheadFrame _ahead[kMaxAheadFrames];
+	uint _aheadHead, _aheadCount;
+	Common::Mutex _aheadQueueMutex;		///< Protects the queue of ready frames
+	Common::Mutex _aheadDecodeMutex;	///< Held while reading and decoding the next frame
+	const AheadFrame *_curAheadFrame;
+	uint _curAheadObject;
+
 public:
 	SmushPlayer(ScummEngine_v7 *scumm);
 	~SmushPlayer();
@@ -121,7 +176,8 @@ private:
 	void tryCmpFile(const char *filename);
 
 	bool readString(const char *file);
-	void decodeFrameObject(int codec, const uint8 *src, int left, int top, int width, int height);
+	void decodeFrameObject(int codec, const uint8 *src, int left, int top, int width, int height, const AheadObject *ahead = nullptr);
+	const AheadObject *nextAheadObject();
 	void handleAnimHeader(int32 subSize, Common::SeekableReadStream &);
 	void handleFrame(int32 frameSize, Common::SeekableReadStream &);
 	void handleNewPalette(int32 subSize, Common::SeekableReadStream &);
@@ -139,6 +195,16 @@ private:
 	void readPalette(byte *, Common::SeekableReadStream &);
 
 	void timerCallback();
+
+	void startDecodeAhead();
+	void stopDecodeAhead();
+	void readAheadFrame(AheadFrame &frame);
+	void decodeAheadObject(AheadFrame &frame, const byte *header, const byte *src);
+	void freeAheadFrame(AheadFrame &frame);
+	void fillAheadQueue();
+	void popAheadFrame(AheadFrame &frame);
+	void wakeUpDecodeAhead();
+	static void decodeAheadProc(void *refCon);
 };
 
 } // End of namespace Scumm
@@ -0,0 +1,195 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "engines/snapshots.h"
+#include "engines/engine.h"
+
+#include "common/memstream.h"
+
+namespace {
+
+// Runs of zeros shorter than this are kept in the literal runs
+const uint32 kMinZeroRun = 8;
+
+void writeLength(Common::Array<byte> &out, uint32 value) {
+	while (value >= 0x80) {
+		out.push_back((value & 0x7F) | 0x80);
+		value >>= 7;
+	}
+	out.push_back(value);
+}
+
+uint32 readLength(const byte *&in) {
+	uint32 value = 0;
+	int shift = 0;
+	byte b;
+	do {
+		b = *in++;
+		value |= (b & 0x7F) << shift;
+		shift += 7;
+	} while (b & 0x80);
+	return value;
+}
+
+inline byte xorAt(const byte *a, uint32 aSize, const byte *b, uint32 bSize, uint32 pos) {
+	return (pos < aSize ? a[pos] : 0) ^ (pos < bSize ? b[pos] : 0);
+}
+
+} // End of anonymous namespace
+
+void SnapshotManager::encodeDelta(Common::Array<byte> &out, const byte *a, uint32 aSize, const byte *b, uint32 bSize) {
+	const uint32 size = MAX(aSize, bSize);
+	uint32 pos = 0;
+
+	while (pos < size) {
+		const uint32 zeroStart = pos;
+		while (pos < size && !xorAt(a, aSize, b, bSize, pos))
+			++pos;
+		if (pos == size)
+			break;
+
+		const uint32 literalStart = pos;
+		uint32 zeros = 0;
+		while (pos < size && zeros < kMinZeroRun) {
+			zeros = xorAt(a, aSize, b, bSize, pos) ? 0 : zeros + 1;
+			++pos;
+		}
+		pos -= zeros;
+
+		writeLength(out, literalStart - zeroStart);
+		writeLength(out, pos - literalStart);
+		for (uint32 i = literalStart; i < pos; ++i)
+			out.push_back(xorAt(a, aSize, b, bSize, i));
+	}
+}
+
+void SnapshotManager::applyDelta(byte *data, const Common::Array<byte> &delta) {
+	const byte *in = delta.begin();
+	uint32 pos = 0;
+
+	while (in != delta.end()) {
+		pos += readLength(in);
+		for (uint32 literals = readLength(in); literals > 0; --literals)
+			data[pos++] ^= *in++;
+	}
+}
+
+SnapshotManager::SnapshotManager(Engine *engine, uint32 maxMemory)
+	: _engine(engine), _maxMemory(maxMemory), _memoryUsage(0) {
+}
+
+Common::Error SnapshotManager::saveState(Common::WriteStream *stream) {
+	return _engine->saveGameStream(stream, false);
+}
+
+Common::Error SnapshotManager::loadState(Common::SeekableReadStream *stream) {
+	return _engine->loadGameStream(stream);
+}
+
+Common::Error SnapshotManager::takeSnapshot() {
+	Common::MemoryWriteStreamDynamic stream(DisposeAfterUse::YES);
+	Common::Error error = saveState(&stream);
+	if (error.getCode() != Common::kNoError)
+		return error;
+
+	const byte *data = stream.getData();
+	const uint32 size = stream.size();
+
+	// The previous latest snapshot is now kept as the difference to this one
+	if (!_snapshots.empty()) {
+		Snapshot &previous = _snapshots.back();
+		encodeDelta(previous.delta, _latest.data(), _latest.size(), data, size);
+		_memoryUsage += previous.delta.size();
+	}
+
+	Snapshot snapshot;
+	snapshot.size = size;
+	_snapshots.push_back(snapshot);
+
+	_memoryUsage -= _latest.size();
+	_latest.resize(size);
+	if (size)
+		memcpy(_latest.data(), data, size);
+	_memoryUsage += size;
+
+	dropOldSnapshots();
+	return Common::kNoError;
+}
+
+Common::Error SnapshotManager::restoreSnapshot(uint stepsBack) {
+	if (stepsBack >= _snapshots.size())
+		return Common::Error(Common::kReadingFailed, "No such snapshot");
+
+	const uint index = _snapshots.size() - 1 - stepsBack;
+
+	// Undo the differences from the latest snapshot down to the requested one
+	uint32 bufferSize = _latest.size();
+	for (uint i = index; i < _snapshots.size(); ++i)
+		bufferSize = MAX(bufferSize, _snapshots[i].size);
+
+	Common::Array<byte> state;
+	state.resize(bufferSize);
+	if (!_latest.empty())
+		memcpy(state.data(), _latest.data(), _latest.size());
+	if (bufferSize > _latest.size())
+		memset(state.data() + _latest.size(), 0, bufferSize - _latest.size());
+	for (uint i = _snapshots.size() - 1; i-- > index;)
+		applyDelta(state.data(), _snapshots[i].delta);
+	state.resize(_snapshots[index].size);
+
+	Common::MemoryReadStream stream(state.data(), state.size());
+	Common::Error error = loadState(&stream);
+	if (error.getCode() != Common::kNoError)
+		return error;
+
+	// The restored snapshot becomes the latest one
+	for (uint i = index; i < _snapshots.size(); ++i)
+		_memoryUsage -= _snapshots[i].delta.size();
+	_snapshots.resize(index + 1);
+	_snapshots.back().delta.clear();
+
+	_memoryUsage -= _latest.size();
+	_latest = Common::move(state);
+	_memoryUsage += _latest.size();
+
+	return Common::kNoError;
+}
+
+void SnapshotManager::clear() {
+	_snapshots.clear();
+	_latest.clear();
+	_memoryUsage = 0;
+}
+
+void SnapshotManager::dropOldSnapshots() {
+	uint dropped = 0;
+	while (_snapshots.size() - dropped > 1 && _memoryUsage > _maxMemory) {
+		_memoryUsage -= _snapshots[dropped].delta.size();
+		++dropped;
+	}
+
+	if (dropped) {
+		for (uint i = dropped; i < _snapshots.size(); ++i)
+			_snapshots[i - dropped] = Common::move(_snapshots[i]);
+		_snapshots.resize(_snapshots.size() - dropped);
+	}
+}
@@ -0,0 +1,129 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef ENGINES_SNAPSHOTS_H
+#define ENGINES_SNAPSHOTS_H
+
+#include "common/array.h"
+#include "common/error.h"
+
+namespace Common {
+class SeekableReadStream;
+class WriteStream;
+}
+
+class Engine;
+
+/**
+ * @defgroup engines_snapshots Snapshots
+ * @ingroup engines
+ *
+ * @brief API for keeping in-memory game states to go back to.
+ *
+ * @{
+ */
+
+/**
+ * Keeps recent game states of an engine in memory, so that the game can be
+ * rewound to them quickly, e.g. for quick retries or when debugging.
+ *
+ * The states are made with Engine::saveGameStream() and restored with
+ * Engine::loadGameStream(), so any engine implementing them can use it.
+ * The caller is responsible for only taking and restoring snapshots when
+ * the engine allows saving and loading.
+ *
+ * Only the latest snapshot is kept whole. Each older one is kept as the
+ * difference to the next one, which successive saves of a game keep small.
+ * The oldest snapshots are dropped when the memory limit is reached.
+ */
+class SnapshotManager {
+public:
+	/**
+	 * @param engine     The engine to take the snapshots of. This may be
+	 *                   null in subclasses overriding saveState() and
+	 *                   loadState().
+	 * @param maxMemory  The memory the snapshots may use, in bytes. The
+	 *                   latest snapshot is kept even if it is larger.
+	 */
+	SnapshotManager(Engine *engine, uint32 maxMemory = 16 * 1024 * 1024);
+	virtual ~SnapshotManager() {}
+
+	/**
+	 * Save the current game state as the latest snapshot.
+	 */
+	Common::Error takeSnapshot();
+
+	/**
+	 * Load a snapshot, and drop the snapshots taken after it.
+	 *
+	 * @param stepsBack  0 for the latest snapshot, 1 for the one before it...
+	 */
+	Common::Error restoreSnapshot(uint stepsBack = 0);
+
+	/** Drop all the snapshots. */
+	void clear();
+
+	uint getSnapshotCount() const { return _snapshots.size(); }
+
+	/** The memory used by the snapshots, in bytes. */
+	uint32 getMemoryUsage() const { return _memoryUsage; }
+
+	/**
+	 * Append a XOR b to 'out', the shorter one padded with zeros, as pairs
+	 * of the length of a run of zeros and of a literal run, followed by the
+	 * literal bytes. Trailing zeros are left out.
+	 */
+	static void encodeDelta(Common::Array<byte> &out, const byte *a, uint32 aSize, const byte *b, uint32 bSize);
+
+	/** XOR 'data' with a difference made by encodeDelta(). */
+	static void applyDelta(byte *data, const Common::Array<byte> &delta);
+
+protected:
+	/** Save the game state, with Engine::saveGameStream() by default. */
+	virtual Common::Error saveState(Common::WriteStream *stream);
+
+	/** Load a game state, with Engine::loadGameStream() by default. */
+	virtual Common::Error loadState(Common::SeekableReadStream *stream);
+
+private:
+	struct Snapshot {
+		/** The size of the saved game state. */
+		uint32 size;
+		/** The state XOR the next newer one, without the runs of zeros. */
+		Common::Array<byte> delta;
+	};
+
+	void dropOldSnapshots();
+
+	Engine *_engine;
+	const uint32 _maxMemory;
+	uint32 _memoryUsage;
+
+	/** The snapshots, oldest first. */
+	Common::Array<Snapshot> _snapshots;
+	/** The game state of the latest snapshot. */
+	Common::Array<byte> _latest;
+};
+
+/** @} */
+
+#endif
@@ -28,6 +28,8 @@
 
 #include "common/debug.h"
 #include "common/file.h"
+#include "common/membercache.h"
+#include "common/ptr.h"
 #include "common/substream.h"
 
 namespace Stark {
@@ -96,13 +98,25 @@ Common::String XARCMember::readString(Common::ReadStream &stream) {
 
 // ARCHIVE
 
-bool XARCArchive::open(const Common::String &filename) {
-	Common::File stream;
-	if (!stream.open(filename)) {
+XARCArchive::XARCArchive() :
+		_dataCache(nullptr) {
+}
+
+bool XARCArchive::open(const Common::String &filename, Common::ArchiveMemberCache *dataCache) {
+	Common::ScopedPtr<Common::SeekableReadStream> cachedStream;
+	if (dataCache) {
+		cachedStream.reset(dataCache->createReadStream(filename));
+	}
+
+	Common::File file;
+	if (!cachedStream && !file.open(filename)) {
 		return false;
 	}
 
+	Common::SeekableReadStream &stream = cachedStream ? *cachedStream : file;
+
 	_filename = filename;
+	_dataCache = dataCache;
 
 	// Unknown: always 1? version?
 	uint32 unknown = stream.readUint32LE();
@@ -195,6 +209,17 @@ Common::SeekableReadStream *XARCArchive::createReadStreamForMember(const Common:
 }
 
 Common::SeekableReadStream *XARCArchive::createReadStreamForMember(const XARCMember *member) const {
+	uint32 offset = member->getOffset();
+	uint32 length = member->getLength();
+
+	// Use the cached archive contents if they are still available
+	if (_dataCache) {
+		Common::SeekableReadStream *data = _dataCache->createReadStream(_filename);
+		if (data) {
+			return new Common::SeekableSubReadStream(data, offset, offset + length, DisposeAfterUse::YES);
+		}
+	}
+
 	// Open the xarc file
 	Common::File *f = new Common::File;
 	if (!f)
@@ -206,8 +231,6 @@ Common::SeekableReadStream *XARCArchive::createReadStreamForMember(const XARCMem
 	}
 
 	// Return the substream that contains the archive member
-	uint32 offset = member->getOffset();
-	uint32 length = member->getLength();
 	return new Common::SeekableSubReadStream(f, offset, offset + length, DisposeAfterUse::YES);
 
 	// Different approach: keep the archive open and read full resources to memory
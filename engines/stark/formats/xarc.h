@@ -26,6 +26,10 @@
 #include "common/archive.h"
 #include "common/stream.h"
 
+namespace Common {
+class ArchiveMemberCache;
+}
+
 namespace Stark {
 namespace Formats {
 
@@ -33,7 +37,15 @@ class XARCMember;
 
 class XARCArchive : public Common::Archive {
 public:
-	bool open(const Common::String &filename);
+	XARCArchive();
+
+	/**
+	 * Open an archive
+	 *
+	 * When a data cache is provided, the members are read from the cached
+	 * contents of the archive file if they are available there.
+	 */
+	bool open(const Common::String &filename, Common::ArchiveMemberCache *dataCache = nullptr);
 	Common::String getFilename() const;
 
 	// Archive API
@@ -48,6 +60,7 @@ public:
 private:
 	Common::String _filename;
 	Common::ArchiveMemberList _members;
+	Common::ArchiveMemberCache *_dataCache;
 };
 
 } // End of namespace Formats
@@ -40,7 +40,8 @@ namespace Gfx {
 OpenGLSActorRenderer::OpenGLSActorRenderer(OpenGLSDriver *gfx) :
 		VisualActor(),
 		_gfx(gfx),
-		_faceVBO(0) {
+		_faceVBO(0),
+		_faceEBO(0) {
 	_shader = _gfx->createActorShaderInstance();
 	_shadowShader = _gfx->createShadowShaderInstance();
 }
@@ -97,12 +98,20 @@ void OpenGLSActorRenderer::render(const Math::Vector3d &position, float directio
 	setBonePositionArrayUniform(_shader, "bonePosition");
 	setLightArrayUniform(lights);
 
-	Common::Array<Face *> faces = _model->getFaces();
-	Common::Array<Material *> mats = _model->getMaterials();
+	const Common::Array<Face *> &faces = _model->getFaces();
+	const Common::Array<Material *> &mats = _model->getMaterials();
 
-	for (Common::Array<Face *>::const_iterator face = faces.begin(); face != faces.end(); ++face) {
-		// For each face draw its vertices from the VBO, indexed by the EBO
-		const Material *material = mats[(*face)->materialId];
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _faceEBO);
+
+	uint first = 0;
+	while (first < faces.size()) {
+		// Consecutive faces sharing a material are drawn with a single call
+		uint32 materialId = faces[first]->materialId;
+		uint last = first + 1;
+		while (last < faces.size() && faces[last]->materialId == materialId)
+			last++;
+
+		const Material *material = mats[materialId];
 		const Gfx::Texture *tex = resolveTexture(material);
 		if (tex) {
 			tex->bind();
@@ -113,9 +122,10 @@ void OpenGLSActorRenderer::render(const Math::Vector3d &position, float directio
 		_shader->setUniform("textured", tex != nullptr);
 		_shader->setUniform("color", Math::Vector3d(material->r, material->g, material->b));
 
-		GLuint ebo = _faceEBO[*face];
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-		glDrawElements(GL_TRIANGLES, (*face)->vertexIndices.size(), GL_UNSIGNED_INT, 0);
+		glDrawElements(GL_TRIANGLES, _faceOffsets[last] - _faceOffsets[first], GL_UNSIGNED_INT,
+		               (const GLvoid *)(_faceOffsets[first] * sizeof(uint32)));
+
+		first = last;
 	}
 
 	_shader->unbind();
@@ -144,11 +154,9 @@ void OpenGLSActorRenderer::render(const Math::Vector3d &position, float directio
 		modelInverse.inverse();
 		setShadowUniform(lights, position, modelInverse.getRotation());
 
-		for (Common::Array<Face *>::const_iterator face = faces.begin(); face != faces.end(); ++face) {
-			GLuint ebo = _faceEBO[*face];
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-			glDrawElements(GL_TRIANGLES, (*face)->vertexIndices.size(), GL_UNSIGNED_INT, 0);
-		}
+		// The shadow does not depend on the materials, all the faces can be drawn at once
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _faceEBO);
+		glDrawElements(GL_TRIANGLES, _faceOffsets.back(), GL_UNSIGNED_INT, 0);
 
 		glDisable(GL_BLEND);
 		glDisable(GL_STENCIL_TEST);
@@ -161,20 +169,15 @@ void OpenGLSActorRenderer::clearVertices() {
 	OpenGL::ShaderGL::freeBuffer(_faceVBO); // Zero names are silently ignored
 	_faceVBO = 0;
 
-	for (FaceBufferMap::iterator it = _faceEBO.begin(); it != _faceEBO.end(); ++it) {
-		OpenGL::ShaderGL::freeBuffer(it->_value);
-	}
+	OpenGL::ShaderGL::freeBuffer(_faceEBO);
+	_faceEBO = 0;
 
-	_faceEBO.clear();
+	_faceOffsets.clear();
 }
 
 void OpenGLSActorRenderer::uploadVertices() {
 	_faceVBO = createModelVBO(_model);
-
-	Common::Array<Face *> faces = _model->getFaces();
-	for (Common::Array<Face *>::const_iterator face = faces.begin(); face != faces.end(); ++face) {
-		_faceEBO[*face] = createFaceEBO(*face);
-	}
+	_faceEBO = createModelEBO(_model);
 }
 
 GLuint OpenGLSActorRenderer::createModelVBO(const Model *model) {
@@ -212,8 +215,20 @@ GLuint OpenGLSActorRenderer::createModelVBO(const Model *model) {
 	return vbo;
 }
 
-GLuint OpenGLSActorRenderer::createFaceEBO(const Face *face) {
-	return OpenGL::ShaderGL::createBuffer(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32) * face->vertexIndices.size(), &face->vertexIndices[0]);
+GLuint OpenGLSActorRenderer::createModelEBO(const Model *model) {
+	const Common::Array<Face *> &faces = model->getFaces();
+
+	// Store the indices of all the faces one after the other in a single buffer
+	Common::Array<uint32> indices;
+	_faceOffsets.resize(faces.size() + 1);
+	for (uint i = 0; i < faces.size(); i++) {
+		_faceOffsets[i] = indices.size();
+		indices.push_back(faces[i]->vertexIndices);
+	}
+	_faceOffsets[faces.size()] = indices.size();
+
+	return OpenGL::ShaderGL::createBuffer(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32) * indices.size(),
+	                                      indices.empty() ? nullptr : &indices.front());
 }
 
 void OpenGLSActorRenderer::setBonePositionArrayUniform(OpenGL::ShaderGL *shader, const char *uniform) {
@@ -26,8 +26,7 @@
 #include "engines/stark/gfx/renderentry.h"
 #include "engines/stark/visual/actor.h"
 
-#include "common/hashmap.h"
-#include "common/hash-ptr.h"
+#include "common/array.h"
 
 #include "graphics/opengl/system_headers.h"
 
@@ -50,18 +49,19 @@ public:
 	void render(const Math::Vector3d &position, float direction, const LightEntryArray &lights) override;
 
 protected:
-	typedef Common::HashMap<Face *, GLuint> FaceBufferMap;
-
 	OpenGLSDriver *_gfx;
 	OpenGL::ShaderGL *_shader, *_shadowShader;
 
 	GLuint _faceVBO;
-	FaceBufferMap _faceEBO;
+	GLuint _faceEBO;
+
+	/** Index of the first vertex of each face in the EBO, followed by the total count */
+	Common::Array<uint32> _faceOffsets;
 
 	void clearVertices();
 	void uploadVertices();
 	GLuint createModelVBO(const Model *model);
-	GLuint createFaceEBO(const Face *face);
+	GLuint createModelEBO(const Model *model);
 	void setBonePositionArrayUniform(OpenGL::ShaderGL *shader, const char *uniform);
 	void setBoneRotationArrayUniform(OpenGL::ShaderGL *shader, const char *uniform);
 	void setLightArrayUniform(const LightEntryArray &lights);
@@ -39,6 +39,7 @@ OpenGLSPropRenderer::OpenGLSPropRenderer(Driver *gfx) :
 		VisualProp(),
 		_gfx(gfx),
 		_faceVBO(0),
+		_faceEBO(0),
 		_modelIsDirty(true) {
 	static const char* attributes[] = { "position", "normal", "texcoord", nullptr };
 	_shader = OpenGL::ShaderGL::fromFiles("stark_prop", attributes);
@@ -88,10 +89,17 @@ void OpenGLSPropRenderer::render(const Math::Vector3d &position, float direction
 	const Common::Array<Face> &faces = _model->getFaces();
 	const Common::Array<Material> &materials = _model->getMaterials();
 
-	for (Common::Array<Face>::const_iterator face = faces.begin(); face != faces.end(); ++face) {
-		const Material &material = materials[face->materialId];
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _faceEBO);
 
-		// For each face draw its vertices from the VBO, indexed by the EBO
+	uint first = 0;
+	while (first < faces.size()) {
+		// Consecutive faces sharing a material are drawn with a single call
+		uint32 materialId = faces[first].materialId;
+		uint last = first + 1;
+		while (last < faces.size() && faces[last].materialId == materialId)
+			last++;
+
+		const Material &material = materials[materialId];
 		const Gfx::Texture *tex = _texture->getTexture(material.texture);
 		if (tex) {
 			tex->bind();
@@ -103,9 +111,10 @@ void OpenGLSPropRenderer::render(const Math::Vector3d &position, float direction
 		_shader->setUniform("color", Math::Vector3d(material.r, material.g, material.b));
 		_shader->setUniform("doubleSided", material.doubleSided ? 1 : 0);
 
-		GLuint ebo = _faceEBO[face];
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-		glDrawElements(GL_TRIANGLES, face->vertexIndices.size(), GL_UNSIGNED_INT, 0);
+		glDrawElements(GL_TRIANGLES, _faceOffsets[last] - _faceOffsets[first], GL_UNSIGNED_INT,
+		               (const GLvoid *)(_faceOffsets[first] * sizeof(uint32)));
+
+		first = last;
 	}
 
 	_shader->unbind();
@@ -113,21 +122,17 @@ void OpenGLSPropRenderer::render(const Math::Vector3d &position, float direction
 
 void OpenGLSPropRenderer::clearVertices() {
 	OpenGL::ShaderGL::freeBuffer(_faceVBO);
+	_faceVBO = 0;
 
-	for (FaceBufferMap::iterator it = _faceEBO.begin(); it != _faceEBO.end(); ++it) {
-		OpenGL::ShaderGL::freeBuffer(it->_value);
-	}
+	OpenGL::ShaderGL::freeBuffer(_faceEBO);
+	_faceEBO = 0;
 
-	_faceEBO.clear();
+	_faceOffsets.clear();
 }
 
 void OpenGLSPropRenderer::uploadVertices() {
 	_faceVBO = createFaceVBO();
-
-	const Common::Array<Face> &faces = _model->getFaces();
-	for (Common::Array<Face>::const_iterator face = faces.begin(); face != faces.end(); ++face) {
-		_faceEBO[face] = createFaceEBO(face);
-	}
+	_faceEBO = createFaceEBO();
 }
 
 GLuint OpenGLSPropRenderer::createFaceVBO() {
@@ -136,8 +141,20 @@ GLuint OpenGLSPropRenderer::createFaceVBO() {
 	return OpenGL::ShaderGL::createBuffer(GL_ARRAY_BUFFER, sizeof(float) * 9 * vertices.size(), &vertices.front());
 }
 
-GLuint OpenGLSPropRenderer::createFaceEBO(const Face *face) {
-	return OpenGL::ShaderGL::createBuffer(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32) * face->vertexIndices.size(), &face->vertexIndices.front());
+GLuint OpenGLSPropRenderer::createFaceEBO() {
+	const Common::Array<Face> &faces = _model->getFaces();
+
+	// Store the indices of all the faces one after the other in a single buffer
+	Common::Array<uint32> indices;
+	_faceOffsets.resize(faces.size() + 1);
+	for (uint i = 0; i < faces.size(); i++) {
+		_faceOffsets[i] = indices.size();
+		indices.push_back(faces[i].vertexIndices);
+	}
+	_faceOffsets[faces.size()] = indices.size();
+
+	return OpenGL::ShaderGL::createBuffer(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32) * indices.size(),
+	                                      indices.empty() ? nullptr : &indices.front());
 }
 
 void OpenGLSPropRenderer::setLightArrayUniform(const LightEntryArray &lights) {
@@ -26,8 +26,7 @@
 #include "engines/stark/model/model.h"
 #include "engines/stark/visual/prop.h"
 
-#include "common/hashmap.h"
-#include "common/hash-ptr.h"
+#include "common/array.h"
 
 #include "graphics/opengl/system_headers.h"
 
@@ -51,19 +50,20 @@ public:
 	void render(const Math::Vector3d &position, float direction, const LightEntryArray &lights) override;
 
 protected:
-	typedef Common::HashMap<const Face *, GLuint> FaceBufferMap;
-
 	Driver *_gfx;
 	OpenGL::ShaderGL *_shader;
 
 	bool _modelIsDirty;
 	GLuint _faceVBO;
-	FaceBufferMap _faceEBO;
+	GLuint _faceEBO;
+
+	/** Index of the first vertex of each face in the EBO, followed by the total count */
+	Common::Array<uint32> _faceOffsets;
 
 	void clearVertices();
 	void uploadVertices();
 	GLuint createFaceVBO();
-	GLuint createFaceEBO(const Face *face);
+	GLuint createFaceEBO();
 
 	void setLightArrayUniform(const LightEntryArray &lights);
 
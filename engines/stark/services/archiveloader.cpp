@@ -26,13 +26,17 @@
 #include "engines/stark/resources/level.h"
 #include "engines/stark/resources/location.h"
 
+#include "common/file.h"
+
 namespace Stark {
 
-ArchiveLoader::LoadedArchive::LoadedArchive(const Common::String& archiveName) :
+static const uint32 kArchiveDataCacheSize = 64 * 1024 * 1024;
+
+ArchiveLoader::LoadedArchive::LoadedArchive(const Common::String& archiveName, Common::ArchiveMemberCache *dataCache) :
 		_filename(archiveName),
 		_root(nullptr),
 		_useCount(0) {
-	if (!_xarc.open(archiveName)) {
+	if (!_xarc.open(archiveName, dataCache)) {
 		error("Unable to open archive '%s'", archiveName.c_str());
 	}
 }
@@ -49,6 +53,10 @@ void ArchiveLoader::LoadedArchive::importResources() {
 	_root = Formats::XRCReader::importTree(&_xarc);
 }
 
+ArchiveLoader::ArchiveLoader() :
+		_archiveData(kArchiveDataCacheSize) {
+}
+
 ArchiveLoader::~ArchiveLoader() {
 	for (LoadedArchiveList::iterator it = _archives.begin(); it != _archives.end(); it++) {
 		delete *it;
@@ -61,7 +69,7 @@ bool ArchiveLoader::load(const Common::String &archiveName) {
 		return false;
 	}
 
-	LoadedArchive *archive = new LoadedArchive(archiveName);
+	LoadedArchive *archive = new LoadedArchive(archiveName, &_archiveData);
 	_archives.push_back(archive);
 
 	archive->importResources();
@@ -133,12 +141,62 @@ Common::String ArchiveLoader::buildArchiveName(Resources::Level *level, Resource
 			error("Unknown level type %d", level->getSubType());
 		}
 	} else {
-		archive = Common::String::format("%02x/%02x/%02x.xarc", level->getIndex(), location->getIndex(), location->getIndex());
+		archive = buildLocationArchiveName(level->getIndex(), location->getIndex());
 	}
 
 	return archive;
 }
 
+Common::String ArchiveLoader::buildLocationArchiveName(uint levelIndex, uint locationIndex) const {
+	return Common::String::format("%02x/%02x/%02x.xarc", levelIndex, locationIndex, locationIndex);
+}
+
+void ArchiveLoader::queuePrefetch(const Common::String &archiveName) {
+	_prefetchQueue.push_back(archiveName);
+}
+
+void ArchiveLoader::clearPrefetchQueue() {
+	_prefetchQueue.clear();
+}
+
+void ArchiveLoader::prefetchNext() {
+	while (!_prefetchQueue.empty()) {
+		Common::String archiveName = _prefetchQueue.front();
+		_prefetchQueue.remove_at(0);
+
+		if (hasArchive(archiveName)) {
+			continue; // Already loaded
+		}
+
+		Common::SeekableReadStream *cached = _archiveData.createReadStream(archiveName);
+		if (cached) {
+			delete cached;
+			continue; // Already prefetched
+		}
+
+		Common::File file;
+		if (!file.open(archiveName)) {
+			continue;
+		}
+
+		uint32 size = file.size();
+		if (size > kArchiveDataCacheSize / 4) {
+			continue; // Too large to be kept in the cache
+		}
+
+		byte *data = (byte *)malloc(size);
+		if (!data || file.read(data, size) != size) {
+			free(data);
+			continue;
+		}
+
+		delete _archiveData.add(archiveName, data, size);
+
+		// Read at most one archive per frame
+		return;
+	}
+}
+
 Common::String ArchiveLoader::getExternalFilePath(const Common::String &fileName, const Common::String &archiveName) const {
 	static const char separator = '/';
 
@@ -23,7 +23,9 @@
 #ifndef STARK_SERVICES_ARCHIVE_LOADER_H
 #define STARK_SERVICES_ARCHIVE_LOADER_H
 
+#include "common/array.h"
 #include "common/list.h"
+#include "common/membercache.h"
 #include "common/str.h"
 #include "common/substream.h"
 #include "common/util.h"
@@ -65,6 +67,7 @@ public:
 class ArchiveLoader {
 
 public:
+	ArchiveLoader();
 	~ArchiveLoader();
 
 	/** Load a Xarc archive, and add it to the managed archives list */
@@ -85,6 +88,21 @@ public:
 
 	/** Build the archive filename for a level or a location */
 	Common::String buildArchiveName(Resources::Level *level, Resources::Location *location = nullptr) const;
+	Common::String buildLocationArchiveName(uint levelIndex, uint locationIndex) const;
+
+	/**
+	 * Queue an archive to be read into memory ahead of being loaded
+	 *
+	 * Used for the locations the player is likely to go to next, so that
+	 * their resources do not have to be read from disk member by member.
+	 */
+	void queuePrefetch(const Common::String &archiveName);
+
+	/** Forget the archives queued for prefetching */
+	void clearPrefetchQueue();
+
+	/** Read the next queued archive into memory, to be called once per frame */
+	void prefetchNext();
 
 	/** Retrieve a file relative to a specified archive */
 	Common::SeekableReadStream *getExternalFile(const Common::String &fileName, const Common::String &archiveName) const;
@@ -93,7 +111,7 @@ public:
 private:
 	class LoadedArchive {
 	public:
-		explicit LoadedArchive(const Common::String &archiveName);
+		LoadedArchive(const Common::String &archiveName, Common::ArchiveMemberCache *dataCache);
 		~LoadedArchive();
 
 		const Common::String &getFilename() const { return _filename; }
@@ -119,6 +137,10 @@ private:
 	LoadedArchive *findArchive(const Common::String &archiveName) const;
 
 	LoadedArchiveList _archives;
+
+	/** Contents of the prefetched archive files */
+	Common::ArchiveMemberCache _archiveData;
+	Common::Array<Common::String> _prefetchQueue;
 };
 
 template <class T>
@@ -24,6 +24,7 @@
 
 #include "engines/stark/resources/bookmark.h"
 #include "engines/stark/resources/camera.h"
+#include "engines/stark/resources/command.h"
 #include "engines/stark/resources/floor.h"
 #include "engines/stark/resources/item.h"
 #include "engines/stark/resources/knowledgeset.h"
@@ -255,6 +256,7 @@ void ResourceProvider::performLocationChange() {
 
 	current->getLocation()->resetAnimationBlending();
 	purgeOldLocations();
+	prefetchNeighbourLocations(current);
 
 	_locationChangeRequest = false;
 }
@@ -333,6 +335,30 @@ void ResourceProvider::purgeOldLocations() {
 	_archiveLoader->unloadUnused();
 }
 
+void ResourceProvider::prefetchNeighbourLocations(Current *current) {
+	_archiveLoader->clearPrefetchQueue();
+
+	// The locations the player can go to next are the targets
+	// of the location change commands in the current location
+	Common::Array<Resources::Command *> commands = current->getLocation()->listChildrenRecursive<Resources::Command>();
+	for (uint i = 0; i < commands.size(); i++) {
+		uint32 subType = commands[i]->getSubType();
+		if (subType != Resources::Command::kLocationGoTo && subType != Resources::Command::kLocationGoToNewCD) {
+			continue;
+		}
+
+		Common::Array<Resources::Command::Argument> arguments = commands[i]->getArguments();
+		uint levelIndex = strtol(arguments[0].stringValue.c_str(), nullptr, 16);
+		uint locationIndex = strtol(arguments[1].stringValue.c_str(), nullptr, 16);
+
+		if (levelIndex != current->getLevel()->getIndex()) {
+			continue; // Only the locations of the current level are prefetched
+		}
+
+		_archiveLoader->queuePrefetch(_archiveLoader->buildLocationArchiveName(levelIndex, locationIndex));
+	}
+}
+
 void ResourceProvider::commitActiveLocationsState() {
 	// Save active location states
 	for (CurrentList::const_iterator it = _locations.begin(); it != _locations.end(); it++) {
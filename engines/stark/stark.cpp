@@ -43,7 +43,6 @@
 #include "engines/stark/services/gamechapter.h"
 #include "engines/stark/services/gamemessage.h"
 #include "engines/stark/gfx/driver.h"
-#include "engines/stark/gfx/framelimiter.h"
 
 #include "audio/mixer.h"
 #include "common/config-manager.h"
@@ -54,6 +53,7 @@
 #include "common/savefile.h"
 #include "common/system.h"
 #include "common/translation.h"
+#include "graphics/framelimiter.h"
 #include "gui/message.h"
 
 namespace Stark {
@@ -92,7 +92,7 @@ StarkEngine::~StarkEngine() {
 
 Common::Error StarkEngine::run() {
 	setDebugger(new Console());
-	_frameLimiter = new Gfx::FrameLimiter(_system, ConfMan.getInt("engine_speed"));
+	_frameLimiter = new Graphics::FrameLimiter(_system, CLIP<int>(ConfMan.getInt("engine_speed"), 0, 100));
 
 	// Get the screen prepared
 	Gfx::Driver *gfx = Gfx::Driver::create();
@@ -166,9 +166,13 @@ void StarkEngine::mainLoop() {
 
 		updateDisplayScene();
 
+		// Read the archive of one of the nearby locations ahead of time
+		StarkArchiveLoader->prefetchNext();
+
 		// Swap buffers
 		_frameLimiter->delayBeforeSwap();
 		StarkGfx->flipBuffer();
+		_frameLimiter->framePresented();
 	}
 }
 
@@ -22,14 +22,35 @@
 
 #include "sword25/console.h"
 #include "sword25/sword25.h"
+#include "sword25/kernel/kernel.h"
+#include "sword25/script/luascript.h"
 
 namespace Sword25 {
 
 Sword25Console::Sword25Console(Sword25Engine *vm) : GUI::Debugger(), _vm(vm) {
 	assert(_vm);
+
+	registerCmd("lua_gc", WRAP_METHOD(Sword25Console, Cmd_LuaGC));
 }
 
 Sword25Console::~Sword25Console() {
 }
 
+bool Sword25Console::Cmd_LuaGC(int argc, const char **argv) {
+	LuaScriptEngine *script = static_cast<LuaScriptEngine *>(Kernel::getInstance()->getScript());
+	if (!script) {
+		debugPrintf("The script engine is not running\n");
+		return true;
+	}
+
+	lua_State *L = static_cast<lua_State *>(script->getScriptObject());
+	const luaL_GCStats &stats = script->getGCStats();
+	debugPrintf("Lua memory in use: %d KB\n", L ? lua_gc(L, LUA_GCCOUNT, 0) : 0);
+	debugPrintf("Collector steps: %lu, finished cycles: %lu\n", stats.steps, stats.cycles);
+	debugPrintf("Pause per step: %lu us average, %lu us longest\n",
+		stats.steps ? stats.totalMicros / stats.steps : 0, stats.maxMicros);
+	debugPrintf("Freed by the steps: %lu KB\n", stats.bytesFreed / 1024);
+	return true;
+}
+
 } // End of namespace Sword25
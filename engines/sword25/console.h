@@ -36,6 +36,8 @@ public:
 
 private:
 	Sword25Engine *_vm;
+
+	bool Cmd_LuaGC(int argc, const char **argv);
 };
 
 } // End of namespace Sword25
@@ -44,6 +44,7 @@
 #include "sword25/package/packagemanager.h"
 #include "sword25/kernel/inputpersistenceblock.h"
 #include "sword25/kernel/outputpersistenceblock.h"
+#include "sword25/script/script.h"
 
 
 #include "sword25/gfx/graphicengine.h"
@@ -137,6 +138,9 @@ bool GraphicEngine::startFrame(bool updateAll) {
 }
 
 bool GraphicEngine::endFrame() {
+	// Spread the garbage collection of the scripts over the frames
+	Kernel::getInstance()->getScript()->collectGarbageStep();
+
 #ifndef THEORA_INDIRECT_RENDERING
 	if (Kernel::getInstance()->getFMV()->isMovieLoaded())
 		return true;
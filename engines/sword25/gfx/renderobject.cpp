@@ -136,12 +136,22 @@ bool RenderObject::render(RectangleList *updateRects, const Common::Array<int> &
 
 	// Objekt zeichnen.
 	bool needRender = false;
+	bool touchesUpdate = false;
 	int index = 0;
 
 	// Only draw if the bounding box intersects any update rectangle and
 	// the object is in front of the minimum Z value.
-	for (RectangleList::iterator rectIt = updateRects->begin(); !needRender && rectIt != updateRects->end(); ++rectIt, ++index)
-		needRender = (_bbox.contains(*rectIt) || _bbox.intersects(*rectIt)) && getAbsoluteZ() >= updateRectsMinZ[index];
+	for (RectangleList::iterator rectIt = updateRects->begin(); !needRender && rectIt != updateRects->end(); ++rectIt, ++index) {
+		if (_bbox.contains(*rectIt) || _bbox.intersects(*rectIt)) {
+			touchesUpdate = true;
+			needRender = getAbsoluteZ() >= updateRectsMinZ[index];
+		}
+	}
+
+	// The bounding boxes of the children are clipped to this one, so
+	// if it touches no update rectangle, neither does any child
+	if (!touchesUpdate)
+		return true;
 
 	if (needRender)
 		doRender(updateRects);
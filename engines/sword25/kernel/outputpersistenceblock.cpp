@@ -99,9 +99,36 @@ void OutputPersistenceBlock::writeMarker(byte marker) {
 void OutputPersistenceBlock::rawWrite(const void *dataPtr, size_t size) {
 	if (size > 0) {
 		uint oldSize = _data.size();
+
+		// resize() only reserves what is needed, so grow the buffer
+		// geometrically to keep many small writes cheap
+		if (oldSize + size > _data.capacity())
+			_data.reserve(MAX<uint>(_data.capacity() * 2, oldSize + size));
+
 		_data.resize(oldSize + size);
 		memcpy(&_data[oldSize], dataPtr, size);
 	}
 }
 
+PersistenceBlockWriteStream::PersistenceBlockWriteStream(OutputPersistenceBlock &block) : _block(block) {
+	_block.writeMarker(OutputPersistenceBlock::BLOCK_MARKER);
+
+	// The size is patched in once all the data has been written
+	_block.write((uint32)0);
+	_start = _block._data.size();
+}
+
+PersistenceBlockWriteStream::~PersistenceBlockWriteStream() {
+	WRITE_LE_UINT32(&_block._data[_start - 4], _block._data.size() - _start);
+}
+
+uint32 PersistenceBlockWriteStream::write(const void *dataPtr, uint32 dataSize) {
+	_block.rawWrite(dataPtr, dataSize);
+	return dataSize;
+}
+
+int64 PersistenceBlockWriteStream::pos() const {
+	return _block._data.size() - _start;
+}
+
 } // End of namespace Sword25
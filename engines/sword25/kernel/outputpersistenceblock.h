@@ -32,12 +32,15 @@
 #ifndef SWORD25_OUTPUTPERSISTENCEBLOCK_H
 #define SWORD25_OUTPUTPERSISTENCEBLOCK_H
 
+#include "common/stream.h"
 #include "sword25/kernel/common.h"
 #include "sword25/kernel/persistenceblock.h"
 
 namespace Sword25 {
 
 class OutputPersistenceBlock : public PersistenceBlock {
+	friend class PersistenceBlockWriteStream;
+
 public:
 	OutputPersistenceBlock();
 
@@ -63,6 +66,25 @@ private:
 	Common::Array<byte> _data;
 };
 
+/**
+ * Writes a block of data whose size is not known in advance, such as the
+ * Lua state, straight into an OutputPersistenceBlock. The block size is
+ * filled in when the stream is destroyed, so nothing else may be written
+ * to the persistence block while the stream exists.
+ */
+class PersistenceBlockWriteStream : public Common::WriteStream {
+public:
+	PersistenceBlockWriteStream(OutputPersistenceBlock &block);
+	~PersistenceBlockWriteStream() override;
+
+	uint32 write(const void *dataPtr, uint32 dataSize) override;
+	int64 pos() const override;
+
+private:
+	OutputPersistenceBlock &_block;
+	uint _start;
+};
+
 } // End of namespace Sword25
 
 #endif
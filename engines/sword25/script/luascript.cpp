@@ -30,6 +30,7 @@
  */
 
 #include "common/memstream.h"
+#include "common/memtrack.h"
 #include "common/debug-channels.h"
 
 #include "sword25/sword25.h"
@@ -47,10 +48,14 @@
 
 namespace Sword25 {
 
+// Kilobytes of allocations the garbage collector catches up with per frame
+static const int GC_STEP_BUDGET = 8;
+
 LuaScriptEngine::LuaScriptEngine(Kernel *KernelPtr) :
 	ScriptEngine(KernelPtr),
 	_state(0),
 	_pcallErrorhandlerRegistryIndex(0) {
+	memset(&_gcStats, 0, sizeof(_gcStats));
 }
 
 LuaScriptEngine::~LuaScriptEngine() {
@@ -75,6 +80,7 @@ void debugHook(lua_State *L, lua_Debug *ar) {
 
 bool LuaScriptEngine::init() {
 	// Lua-State initialisation, as well as standard libaries initialisation
+	MEMORY_TAG("sword25 lua");
 	_state = luaL_newstate();
 	if (!_state || ! registerStandardLibs() || !registerStandardLibExtensions()) {
 		error("Lua could not be initialized.");
@@ -240,6 +246,11 @@ void LuaScriptEngine::setCommandLine(const Common::StringArray &commandLineParam
 	lua_setglobal(_state, "CommandLine");
 }
 
+void LuaScriptEngine::collectGarbageStep() {
+	if (_state)
+		luaL_gcstep(_state, GC_STEP_BUDGET, &_gcStats);
+}
+
 namespace {
 const char *PERMANENTS_TABLE_NAME = "Permanents";
 
@@ -394,12 +405,11 @@ bool LuaScriptEngine::persist(OutputPersistenceBlock &writer) {
 	pushPermanentsTable(_state, PTT_PERSIST);
 	lua_getglobal(_state, "_G");
 
-	// Lua persists and stores the data in a WriteStream
-	Common::MemoryWriteStreamDynamic writeStream(DisposeAfterUse::YES);
-	Lua::persistLua(_state, &writeStream);
-
-	// Persistenzdaten in den Writer schreiben.
-	writer.write(writeStream.getData(), writeStream.size());
+	// Lua persists and stores the data directly in the writer
+	{
+		PersistenceBlockWriteStream writeStream(writer);
+		Lua::persistLua(_state, &writeStream);
+	}
 
 	// Die beiden Tabellen vom Stack nehmen.
 	lua_pop(_state, 2);
@@ -37,7 +37,7 @@
 #include "sword25/kernel/common.h"
 #include "sword25/script/script.h"
 
-struct lua_State;
+#include "common/lua/lauxlib.h"
 
 namespace Sword25 {
 
@@ -84,6 +84,15 @@ public:
 	 */
 	void setCommandLine(const Common::StringArray &commandLineParameters) override;
 
+	void collectGarbageStep() override;
+
+	/**
+	 * Returns the statistics of the garbage collection steps done by collectGarbageStep()
+	 */
+	const luaL_GCStats &getGCStats() const {
+		return _gcStats;
+	}
+
 	/**
 	 * @remark              The Lua stack is cleared by this method
 	 */
@@ -96,6 +105,7 @@ public:
 private:
 	lua_State *_state;
 	int _pcallErrorhandlerRegistryIndex;
+	luaL_GCStats _gcStats;
 
 	bool registerStandardLibs();
 	bool registerStandardLibExtensions();
@@ -84,6 +84,12 @@ public:
 	*/
 	virtual void setCommandLine(const Common::Array<Common::String> &commandLineParameters) = 0;
 
+	/**
+	 * Does a part of the garbage collection of the script environment.
+	 * It is called once per frame, so that the collection does not stall single frames.
+	 */
+	virtual void collectGarbageStep() = 0;
+
 	bool persist(OutputPersistenceBlock &writer) override = 0;
 	bool unpersist(InputPersistenceBlock &reader) override = 0;
 };
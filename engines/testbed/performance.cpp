@@ -0,0 +1,370 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "audio/mididrv.h"
+#include "audio/mixer.h"
+#include "audio/softsynth/pcspk.h"
+
+#include "common/archive.h"
+#include "common/config-manager.h"
+#include "common/fs.h"
+#include "common/stream.h"
+
+#include "engines/engine.h"
+
+#include "graphics/palette.h"
+#include "graphics/scalerplugin.h"
+#include "graphics/surface.h"
+
+#include "video/avi_decoder.h"
+#include "video/bink_decoder.h"
+#include "video/dxa_decoder.h"
+#include "video/flic_decoder.h"
+#include "video/mve_decoder.h"
+#include "video/qt_decoder.h"
+#include "video/smk_decoder.h"
+#ifdef USE_THEORADEC
+#include "video/theora_decoder.h"
+#endif
+
+#include "testbed/performance.h"
+
+namespace Testbed {
+
+// The time each measurement lasts, in milliseconds
+static const uint32 kMeasureTime = 1000;
+
+/**
+ * Measure how many full screens per second copyRectToScreen() and
+ * updateScreen() manage in the current graphics mode. Updates may be
+ * limited by vsync, in which case the rate is the refresh rate.
+ */
+bool PerformanceTests::measureScreenUpdates(const Common::String &mode) {
+	const int width = g_system->getWidth();
+	const int height = g_system->getHeight();
+	const Graphics::PixelFormat format = g_system->getScreenFormat();
+
+	if (format.bytesPerPixel == 1) {
+		byte palette[256 * 3];
+		for (int i = 0; i < 256 * 3; ++i)
+			palette[i] = i / 3;
+		g_system->getPaletteManager()->setPalette(palette, 0, 256);
+	}
+
+	// Two different screens, so that no update can be skipped
+	Graphics::Surface screens[2];
+	for (int i = 0; i < 2; ++i) {
+		screens[i].create(width, height, format);
+		for (int y = 0; y < height; ++y)
+			memset(screens[i].getBasePtr(0, y), (y + i * 128) & 0xFF, width * format.bytesPerPixel);
+	}
+
+	uint32 frames = 0;
+	uint32 elapsed;
+	const uint32 start = g_system->getMillis();
+	do {
+		const Graphics::Surface &screen = screens[frames & 1];
+		g_system->copyRectToScreen(screen.getPixels(), screen.pitch, 0, 0, width, height);
+		g_system->updateScreen();
+		++frames;
+		elapsed = g_system->getMillis() - start;
+	} while (elapsed < kMeasureTime && !Engine::shouldQuit());
+
+	screens[0].free();
+	screens[1].free();
+
+	if (Engine::shouldQuit())
+		return false;
+
+	elapsed = MAX<uint32>(elapsed, 1);
+	Testsuite::logPrintf("Info! %s, %dx%d: %.1f screen updates/s, %.2f Mpixel/s\n", mode.c_str(), width, height,
+		frames * 1000.0 / elapsed, (double)frames * width * height / elapsed / 1000.0);
+	return true;
+}
+
+/**
+ * Measures the screen update rates for every pixel format the backend
+ * supports, and for every scaler and scale factor in CLUT8.
+ */
+TestExitStatus PerformanceTests::screenUpdates() {
+	Testsuite::clearScreen();
+	Common::Point pt(0, 100);
+	Testsuite::writeOnScreen("Measuring the screen update rates, the screen will flicker", pt);
+	g_system->delayMillis(1000);
+
+	bool passed = true;
+	Common::List<Graphics::PixelFormat> formats = g_system->getSupportedFormats();
+	formats.push_front(Graphics::PixelFormat::createFormatCLUT8());
+
+	for (Common::List<Graphics::PixelFormat>::const_iterator format = formats.begin(); format != formats.end(); ++format) {
+		if (format != formats.begin() && format->bytesPerPixel == 1)
+			continue;
+
+		g_system->beginGFXTransaction();
+		g_system->initSize(320, 200, &*format);
+		if (g_system->endGFXTransaction() != OSystem::kTransactionSuccess) {
+			Testsuite::logDetailedPrintf("Switching to pixel format %s failed\n", format->toString().c_str());
+			passed = false;
+			continue;
+		}
+
+		if (!measureScreenUpdates(format->toString()))
+			return kTestSkipped;
+	}
+
+	if (g_system->hasFeature(OSystem::kFeatureScalers)) {
+		const PluginList &scalerPlugins = ScalerMan.getPlugins();
+		for (uint scaler = 0; scaler < scalerPlugins.size(); ++scaler) {
+			const ScalerPluginObject &plugin = scalerPlugins[scaler]->get<ScalerPluginObject>();
+			const Common::Array<uint> &factors = plugin.getFactors();
+
+			for (uint i = 0; i < factors.size(); ++i) {
+				g_system->beginGFXTransaction();
+				const bool isScalerSet = g_system->setScaler(scaler, factors[i]);
+				g_system->initSize(320, 200);
+				if (g_system->endGFXTransaction() != OSystem::kTransactionSuccess || !isScalerSet) {
+					Testsuite::logDetailedPrintf("Switching to scaler %s %dx failed\n", plugin.getName(), factors[i]);
+					passed = false;
+					continue;
+				}
+
+				if (!measureScreenUpdates(Common::String::format("CLUT8, scaler %s %dx", plugin.getName(), factors[i])))
+					return kTestSkipped;
+			}
+		}
+	}
+
+	// Restore the default state
+	g_system->beginGFXTransaction();
+	g_system->setScaler(g_system->getDefaultScaler(), g_system->getDefaultScaleFactor());
+	g_system->initSize(320, 200);
+	g_system->endGFXTransaction();
+	Testsuite::clearScreen();
+
+	return passed ? kTestPassed : kTestFailed;
+}
+
+/**
+ * Measures the share of the audio time the mixer callback needs for a
+ * growing number of channels, which all need rate conversion.
+ */
+TestExitStatus PerformanceTests::mixerHeadroom() {
+	Audio::Mixer *mixer = g_system->getMixer();
+	const bool statsEnabled = mixer->isStatisticsEnabled();
+
+	static const int channelCounts[] = { 1, 8, 16, 32 };
+	TestExitStatus status = kTestPassed;
+
+	for (int i = 0; i < ARRAYSIZE(channelCounts) && status == kTestPassed; ++i) {
+		Common::Array<Audio::SoundHandle> handles;
+		handles.resize(channelCounts[i]);
+		for (int channel = 0; channel < channelCounts[i]; ++channel) {
+			Audio::PCSpeaker *speaker = new Audio::PCSpeaker(22050);
+			speaker->play(Audio::PCSpeaker::kWaveFormSine, 500 + channel * 50, -1);
+			// Barely audible, the mixing costs the same at any volume
+			mixer->playStream(Audio::Mixer::kPlainSoundType, &handles[channel], speaker, -1, 1);
+		}
+
+		mixer->enableStatistics(true);
+		g_system->delayMillis(kMeasureTime);
+
+		Audio::Mixer::Statistics stats;
+		if (!mixer->getStatistics(stats) || !stats.audioMicros) {
+			Testsuite::logDetailedPrintf("The mixer does not report its statistics\n");
+			status = kTestSkipped;
+		} else {
+			const double load = stats.mixMicros * 100.0 / stats.audioMicros;
+			Testsuite::logPrintf("Info! %d channels at %d Hz: mixing takes %.2f%% of the audio time, %.2f%% headroom, longest callback %u us, %u overruns\n",
+				channelCounts[i], mixer->getOutputRate(), load, 100.0 - load, stats.maxMixMicros, stats.overruns);
+		}
+
+		for (int channel = 0; channel < channelCounts[i]; ++channel)
+			mixer->stopHandle(handles[channel]);
+	}
+
+	mixer->enableStatistics(statsEnabled);
+	return status;
+}
+
+/**
+ * Measures how long the MIDI driver takes to open and to accept messages.
+ * Any latency added by the device after that cannot be measured here.
+ */
+TestExitStatus PerformanceTests::midiLatency() {
+	MidiDriver::DeviceHandle dev = MidiDriver::detectDevice(MDT_MIDI | MDT_ADLIB);
+	MidiDriver *driver = MidiDriver::createMidi(dev);
+	if (!driver) {
+		Testsuite::logDetailedPrintf("No MIDI driver could be created\n");
+		return kTestSkipped;
+	}
+
+	uint32 start = g_system->getMillis();
+	const int errCode = driver->open();
+	const uint32 openTime = g_system->getMillis() - start;
+	if (errCode) {
+		Testsuite::logDetailedPrintf("Error! %s\n", MidiDriver::getErrorName(errCode));
+		delete driver;
+		return kTestFailed;
+	}
+
+	// Silent notes on every channel but the percussion one
+	const int messages = 2000;
+	start = g_system->getMillis();
+	for (int i = 0; i < messages / 2; ++i) {
+		const int channel = i % 15;
+		const int note = 36 + i % 48;
+		driver->send(0x90 | channel, note, 1);
+		driver->send(0x80 | channel, note, 0);
+	}
+	const uint32 sendTime = g_system->getMillis() - start;
+
+	Testsuite::logPrintf("Info! MIDI driver %s: opened in %u ms, %.1f us per message\n",
+		MidiDriver::getDeviceString(dev, MidiDriver::kDriverName).c_str(), openTime, sendTime * 1000.0 / messages);
+
+	driver->close();
+	delete driver;
+	return kTestPassed;
+}
+
+/**
+ * Measures how fast the files in the game path are read.
+ */
+TestExitStatus PerformanceTests::fileReadThroughput() {
+	Common::FSDirectory gameRoot(ConfMan.get("path"), 4, true, true);
+	Common::ArchiveMemberList files;
+	gameRoot.listMembers(files);
+	if (files.empty()) {
+		Testsuite::logDetailedPrintf("No files found in the game path\n");
+		return kTestSkipped;
+	}
+
+	// Read at most 64 MB, in the chunks a buffered stream would use
+	const uint32 maxTotal = 64 * 1024 * 1024;
+	const uint32 chunkSize = 64 * 1024;
+	byte *buffer = new byte[chunkSize];
+	uint32 total = 0;
+	int fileCount = 0;
+
+	const uint32 start = g_system->getMillis();
+	for (Common::ArchiveMemberList::const_iterator file = files.begin(); file != files.end() && total < maxTotal; ++file) {
+		Common::SeekableReadStream *stream = (*file)->createReadStream();
+		if (!stream)
+			continue;
+
+		uint32 bytesRead;
+		while ((bytesRead = stream->read(buffer, chunkSize)) > 0)
+			total += bytesRead;
+
+		delete stream;
+		++fileCount;
+	}
+	const uint32 elapsed = MAX<uint32>(g_system->getMillis() - start, 1);
+
+	delete[] buffer;
+
+	Testsuite::logPrintf("Info! Read %d files, %u KB, in %u ms: %.2f MB/s\n", fileCount, total / 1024, elapsed, (double)total / elapsed / 1000.0);
+	return kTestPassed;
+}
+
+/**
+ * Measures how fast each video in the game path is decoded, for the
+ * decoders which can be told apart by the file extension.
+ */
+TestExitStatus PerformanceTests::videoDecoding() {
+	Common::FSDirectory gameRoot(ConfMan.get("path"), 4, true, true);
+
+	static const char *const patterns[] = {
+		"*.avi", "*.bik", "*.dxa", "*.fli", "*.flc", "*.mov", "*.mve", "*.smk", "*.ogv"
+	};
+
+	int videoCount = 0;
+	for (int i = 0; i < ARRAYSIZE(patterns); ++i) {
+		Common::ArchiveMemberList files;
+		gameRoot.listMatchingMembers(files, patterns[i]);
+
+		for (Common::ArchiveMemberList::const_iterator file = files.begin(); file != files.end(); ++file) {
+			Video::VideoDecoder *video = nullptr;
+			switch (i) {
+			case 0: video = new Video::AVIDecoder(); break;
+#ifdef USE_BINK
+			case 1: video = new Video::BinkDecoder(); break;
+#endif
+			case 2: video = new Video::DXADecoder(); break;
+			case 3:
+			case 4: video = new Video::FlicDecoder(); break;
+			case 5: video = new Video::QuickTimeDecoder(); break;
+			case 6: video = new Video::MveDecoder(); break;
+			case 7: video = new Video::SmackerDecoder(); break;
+#ifdef USE_THEORADEC
+			case 8: video = new Video::TheoraDecoder(); break;
+#endif
+			default: break;
+			}
+			if (!video)
+				continue;
+
+			const Common::String name = (*file)->getName();
+			if (!video->loadStream((*file)->createReadStream())) {
+				Testsuite::logDetailedPrintf("Cannot open video %s\n", name.c_str());
+				delete video;
+				continue;
+			}
+
+			// Decode as fast as possible, for at most twice the measuring time
+			uint32 frames = 0;
+			uint32 elapsed;
+			const uint32 start = g_system->getMillis();
+			do {
+				if (!video->decodeNextFrame())
+					break;
+				++frames;
+				elapsed = g_system->getMillis() - start;
+			} while (!video->endOfVideo() && elapsed < 2 * kMeasureTime && !Engine::shouldQuit());
+			elapsed = MAX<uint32>(g_system->getMillis() - start, 1);
+
+			Testsuite::logPrintf("Info! %s, %dx%d: decoded %u frames at %.1f frames/s\n",
+				name.c_str(), video->getWidth(), video->getHeight(), frames, frames * 1000.0 / elapsed);
+
+			delete video;
+			++videoCount;
+
+			if (Engine::shouldQuit())
+				return kTestSkipped;
+		}
+	}
+
+	if (!videoCount) {
+		Testsuite::logDetailedPrintf("No video found in the game path\n");
+		return kTestSkipped;
+	}
+	return kTestPassed;
+}
+
+PerformanceTestSuite::PerformanceTestSuite() {
+	addTest("ScreenUpdates", &PerformanceTests::screenUpdates, false);
+	addTest("MixerHeadroom", &PerformanceTests::mixerHeadroom, false);
+	addTest("MidiLatency", &PerformanceTests::midiLatency, false);
+	addTest("FileReadThroughput", &PerformanceTests::fileReadThroughput, false);
+	addTest("VideoDecoding", &PerformanceTests::videoDecoding, false);
+}
+
+} // End of namespace Testbed
@@ -0,0 +1,67 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef TESTBED_PERFORMANCE_H
+#define TESTBED_PERFORMANCE_H
+
+#include "testbed/testsuite.h"
+
+namespace Testbed {
+
+namespace PerformanceTests {
+
+// Helper functions for Performance tests
+bool measureScreenUpdates(const Common::String &mode);
+
+// will contain function declarations for Performance tests
+TestExitStatus screenUpdates();
+TestExitStatus mixerHeadroom();
+TestExitStatus midiLatency();
+TestExitStatus fileReadThroughput();
+TestExitStatus videoDecoding();
+// add more here
+
+} // End of namespace PerformanceTests
+
+class PerformanceTestSuite : public Testsuite {
+public:
+	/**
+	 * The constructor for the PerformanceTestSuite
+	 * For every test to be executed one must:
+	 * 1) Create a function that would invoke the test
+	 * 2) Add that test to list by executing addTest()
+	 *
+	 * @see addTest()
+	 */
+	PerformanceTestSuite();
+	~PerformanceTestSuite() override {}
+	const char *getName() const override {
+		return "Performance";
+	}
+	const char *getDescription() const override {
+		return "Performance: Screen updates/Mixer/MIDI/File reading/Video decoding";
+	}
+};
+
+} // End of namespace Testbed
+
+#endif // TESTBED_PERFORMANCE_H
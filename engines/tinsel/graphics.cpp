@@ -538,6 +538,26 @@ static void t2WrtNonZero(DRAWOBJECT *pObj, uint8 *srcP, uint8 *destP, bool apply
 	}
 
 	for (int y = 0; y < pObj->height; ++y) {
+		int x = 0;
+
+		if (yClip > 0) {
+			// Row is clipped off the top, so just step over its data
+			while (x < pObj->width) {
+				numBytes = *srcP++;
+				if (numBytes & 0x80) {
+					numBytes &= 0x7f;
+					++srcP;
+				} else {
+					srcP += numBytes;
+				}
+				x += numBytes;
+			}
+			assert(x == pObj->width);
+
+			--yClip;
+			continue;
+		}
+
 		// Get the position to start writing out from
 		uint8 *tempP = !horizFlipped ? destP :
 			destP + (pObj->width - pObj->leftClip - pObj->rightClip) - 1;
@@ -546,7 +566,6 @@ static void t2WrtNonZero(DRAWOBJECT *pObj, uint8 *srcP, uint8 *destP, bool apply
 		if (horizFlipped)
 			SWAP(leftClip, rightClip);
 
-		int x = 0;
 		while (x < pObj->width) {
 			// Get the next opcode
 			numBytes = *srcP++;
@@ -560,7 +579,7 @@ static void t2WrtNonZero(DRAWOBJECT *pObj, uint8 *srcP, uint8 *destP, bool apply
 				int runLength = numBytes - clipAmount;
 				uint8 color = *srcP++;
 
-				if ((yClip == 0) && (runLength > 0) && (color != 0)) {
+				if ((runLength > 0) && (color != 0)) {
 					runLength = MIN(runLength, pObj->width - rightClip - x);
 
 					if (runLength > 0) {
@@ -586,25 +605,25 @@ static void t2WrtNonZero(DRAWOBJECT *pObj, uint8 *srcP, uint8 *destP, bool apply
 				leftClip -= clipAmount;
 				srcP += clipAmount;
 				int runLength = numBytes - clipAmount;
-				x += numBytes - runLength;
+				x += clipAmount;
 
-				for (int xp = 0; xp < runLength; ++xp) {
-					if ((yClip > 0) || (x >= (pObj->width - rightClip)))
-						++srcP;
-					else if (horizFlipped)
+				// Only the start of the run can be visible, up to the right clip edge
+				int visible = CLIP(pObj->width - rightClip - x, 0, runLength);
+				if (horizFlipped) {
+					for (int xp = 0; xp < visible; ++xp)
 						*tempP-- = pObj->constant + *srcP++;
-					else
+				} else {
+					for (int xp = 0; xp < visible; ++xp)
 						*tempP++ = pObj->constant + *srcP++;
-					++x;
 				}
+
+				srcP += runLength - visible;
+				x += runLength;
 			}
 		}
 		assert(x == pObj->width);
 
-		if (yClip > 0)
-			--yClip;
-		else
-			destP += SCREEN_WIDTH;
+		destP += SCREEN_WIDTH;
 	}
 }
 
@@ -315,13 +315,21 @@ void Renderer::applyRotation(IMatrix3x3 *targetMatrix, const IMatrix3x3 *current
 }
 
 void Renderer::applyPointsRotation(const Common::Array<BodyVertex> &vertices, int32 firstPoint, int32 numPoints, I16Vec3 *destPoints, const IMatrix3x3 *rotationMatrix) {
-	for (int32 i = 0; i < numPoints; ++i) {
-		const BodyVertex &vertex = vertices[i + firstPoint];
-		destPoints->x = ((rotationMatrix->row1.x * vertex.x + rotationMatrix->row1.y * vertex.y + rotationMatrix->row1.z * vertex.z) / SCENE_SIZE_HALF) + destPos.x;
-		destPoints->y = ((rotationMatrix->row2.x * vertex.x + rotationMatrix->row2.y * vertex.y + rotationMatrix->row2.z * vertex.z) / SCENE_SIZE_HALF) + destPos.y;
-		destPoints->z = ((rotationMatrix->row3.x * vertex.x + rotationMatrix->row3.y * vertex.y + rotationMatrix->row3.z * vertex.z) / SCENE_SIZE_HALF) + destPos.z;
-
-		destPoints++;
+	if (numPoints <= 0) {
+		return;
+	}
+	// keep the matrix and the translation in locals - the compiler can't prove
+	// that writing destPoints doesn't alias them
+	const IMatrix3x3 m = *rotationMatrix;
+	const IVec3 pos = destPos;
+	const BodyVertex *vertex = &vertices[firstPoint];
+	for (int32 i = 0; i < numPoints; ++i, ++vertex, ++destPoints) {
+		const int32 x = vertex->x;
+		const int32 y = vertex->y;
+		const int32 z = vertex->z;
+		destPoints->x = ((m.row1.x * x + m.row1.y * y + m.row1.z * z) / SCENE_SIZE_HALF) + pos.x;
+		destPoints->y = ((m.row2.x * x + m.row2.y * y + m.row2.z * z) / SCENE_SIZE_HALF) + pos.y;
+		destPoints->z = ((m.row3.x * x + m.row3.y * y + m.row3.z * z) / SCENE_SIZE_HALF) + pos.z;
 	}
 }
 
@@ -357,17 +365,20 @@ void Renderer::processRotatedElement(IMatrix3x3 *targetMatrix, const Common::Arr
 }
 
 void Renderer::applyPointsTranslation(const Common::Array<BodyVertex> &vertices, int32 firstPoint, int32 numPoints, I16Vec3 *destPoints, const IMatrix3x3 *translationMatrix, const IVec3 &angleVec) {
-	for (int32 i = 0; i < numPoints; ++i) {
-		const BodyVertex &vertex = vertices[i + firstPoint];
-		const int32 tmpX = vertex.x + angleVec.z;
-		const int32 tmpY = vertex.y + angleVec.y;
-		const int32 tmpZ = vertex.z + angleVec.x;
-
-		destPoints->x = ((translationMatrix->row1.x * tmpX + translationMatrix->row1.y * tmpY + translationMatrix->row1.z * tmpZ) / SCENE_SIZE_HALF) + destPos.x;
-		destPoints->y = ((translationMatrix->row2.x * tmpX + translationMatrix->row2.y * tmpY + translationMatrix->row2.z * tmpZ) / SCENE_SIZE_HALF) + destPos.y;
-		destPoints->z = ((translationMatrix->row3.x * tmpX + translationMatrix->row3.y * tmpY + translationMatrix->row3.z * tmpZ) / SCENE_SIZE_HALF) + destPos.z;
-
-		destPoints++;
+	if (numPoints <= 0) {
+		return;
+	}
+	const IMatrix3x3 m = *translationMatrix;
+	const IVec3 pos = destPos;
+	const BodyVertex *vertex = &vertices[firstPoint];
+	for (int32 i = 0; i < numPoints; ++i, ++vertex, ++destPoints) {
+		const int32 tmpX = vertex->x + angleVec.z;
+		const int32 tmpY = vertex->y + angleVec.y;
+		const int32 tmpZ = vertex->z + angleVec.x;
+
+		destPoints->x = ((m.row1.x * tmpX + m.row1.y * tmpY + m.row1.z * tmpZ) / SCENE_SIZE_HALF) + pos.x;
+		destPoints->y = ((m.row2.x * tmpX + m.row2.y * tmpY + m.row2.z * tmpZ) / SCENE_SIZE_HALF) + pos.y;
+		destPoints->z = ((m.row3.x * tmpX + m.row3.y * tmpY + m.row3.z * tmpZ) / SCENE_SIZE_HALF) + pos.z;
 	}
 }
 
@@ -579,14 +590,11 @@ void Renderer::renderPolygonsFlat(int vtop, int32 vsize, uint8 color) const {
 		const int16 start = ptr1[0];
 		const int16 stop = ptr1[screenHeight];
 		ptr1++;
-		const int32 hsize = stop - start;
-
-		if (hsize >= 0) {
-			for (int32 j = start; j <= hsize + start; j++) {
-				if (j >= 0 && j < screenWidth) {
-					out[j] = color;
-				}
-			}
+		// clip the span once and fill it in one go
+		const int32 x0 = MAX<int32>(start, 0);
+		const int32 x1 = MIN<int32>(stop, screenWidth - 1);
+		if (x1 >= x0) {
+			memset(out + x0, color, x1 - x0 + 1);
 		}
 		out += screenWidth;
 	}
@@ -770,8 +778,6 @@ void Renderer::renderPolygonsGouraud(int vtop, int32 vsize) const {
 		uint16 startColor = ptr2[0];
 		uint16 stopColor = ptr2[screenHeight];
 
-		int16 colorSize = stopColor - startColor;
-
 		int16 stop = ptr1[screenHeight]; // stop
 		int16 start = ptr1[0];           // start
 
@@ -812,40 +818,13 @@ void Renderer::renderPolygonsGouraud(int vtop, int32 vsize) const {
 					*(out2) = startColor / 256;
 				}
 			} else {
-				int32 currentXPos = start;
-				colorSize /= hsize;
-				hsize++;
-
-				const uint8 startColorByte = startColor / 256;
-
-				if (hsize % 2) {
-					hsize /= 2;
-					if (currentXPos >= 0 && currentXPos < screenWidth) {
-						*out2 = startColorByte;
-					}
-					out2++;
-					currentXPos++;
-					startColor += colorSize;
-				} else {
-					hsize /= 2;
+				// longer spans are drawn with the start color only (as the
+				// original did), so clip them and fill them in one go
+				const int32 x0 = MAX<int32>(start, 0);
+				const int32 x1 = MIN<int32>(stop, screenWidth - 1);
+				if (x1 >= x0) {
+					memset(out + x0, startColor / 256, x1 - x0 + 1);
 				}
-
-				do {
-					if (currentXPos >= 0 && currentXPos < screenWidth) {
-						*out2 = startColorByte;
-					}
-
-					currentXPos++;
-					startColor += colorSize;
-
-					if (currentXPos >= 0 && currentXPos < screenWidth) {
-						*(out2 + 1) = startColorByte;
-					}
-
-					currentXPos++;
-					out2 += 2;
-					startColor += colorSize;
-				} while (--hsize);
 			}
 		}
 		out += screenWidth;
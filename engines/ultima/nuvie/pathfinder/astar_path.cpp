@@ -29,7 +29,15 @@ namespace Ultima {
 namespace Nuvie {
 
 AStarPath::AStarPath() : final_node(0) {
-} void AStarPath::create_path() {
+}
+
+AStarPath::~AStarPath() {
+	delete_nodes();
+	for (uint32 i = 0; i < node_pool.size(); i++)
+		delete node_pool[i];
+}
+
+void AStarPath::create_path() {
 	astar_node *i = final_node; // iterator through steps, from back
 	delete_path();
 	Std::vector<astar_node *> reverse_list;
@@ -52,7 +60,7 @@ bool AStarPath::score_to_neighbor(sint8 dir, astar_node *nnode, astar_node *neig
 	neighbor->loc = nnode->loc.abs_coords(sx, sy);
 	nnode_to_neighbor = step_cost(nnode->loc, neighbor->loc);
 	if (nnode_to_neighbor == -1) {
-		delete neighbor; // this neighbor is blocked
+		free_node(neighbor); // this neighbor is blocked
 		return false;
 	}
 	return true;
@@ -64,7 +72,7 @@ bool AStarPath::compare_neighbors(astar_node *nnode, astar_node *neighbor,
 	// ignore this neighbor if already checked and closer to start
 	if ((in_open && in_open->to_start <= neighbor->to_start)
 	        || (in_closed && in_closed->to_start <= neighbor->to_start)) {
-		delete neighbor;
+		free_node(neighbor);
 		return false;
 	}
 	return true;
@@ -72,7 +80,7 @@ bool AStarPath::compare_neighbors(astar_node *nnode, astar_node *neighbor,
 bool AStarPath::search_node_neighbors(astar_node *nnode, MapCoord &goal,
 									  const uint32 max_score) {
 	for (uint32 dir = 1; dir < 8; dir += 2) {
-		astar_node *neighbor = new astar_node;
+		astar_node *neighbor = new_node();
 		sint32 nnode_to_neighbor = -1;
 		if (!score_to_neighbor(dir, nnode, neighbor, nnode_to_neighbor))
 			continue; // this neighbor is blocked
@@ -85,7 +93,7 @@ bool AStarPath::search_node_neighbors(astar_node *nnode, MapCoord &goal,
 		neighbor->score = neighbor->to_start + neighbor->to_goal;
 		neighbor->len = nnode->len + 1;
 		if (neighbor->score > max_score) {
-			delete neighbor; // too far away
+			free_node(neighbor); // too far away
 			continue;
 		}
 		// take neighbor out of closed list and put into open list
@@ -93,6 +101,8 @@ bool AStarPath::search_node_neighbors(astar_node *nnode, MapCoord &goal,
 			remove_closed_node(in_closed);
 		if (!in_open)
 			push_open_node(neighbor);
+		else
+			free_node(neighbor);
 	}
 	return true;
 }/* Do A* search of tiles to create a path from `start' to `goal'.
@@ -102,7 +112,7 @@ bool AStarPath::search_node_neighbors(astar_node *nnode, MapCoord &goal,
  * Returns true if a path is created
  */bool AStarPath::path_search(MapCoord &start, MapCoord &goal) {
 	//DEBUG(0,LEVEL_DEBUGGING,"SEARCH: %d: %d,%d -> %d,%d\n",actor->get_actor_num(),start.x,start.y,goal.x,goal.y);
-	astar_node *start_node = new astar_node;
+	astar_node *start_node = new_node();
 	start_node->loc = start;
 	start_node->to_start = 0;
 	start_node->to_goal = path_cost_est(start, goal);
@@ -120,12 +130,14 @@ bool AStarPath::search_node_neighbors(astar_node *nnode, MapCoord &goal,
 			final_node = nnode;
 			create_path();
 			delete_nodes();
+			free_node(final_node);
+			final_node = NULL;
 			return (true); // reached goal - success
 		}
 		// check cardinal neighbors (starting at top going clockwise)
 		search_node_neighbors(nnode, goal, max_score);
 		// node and neighbors checked, put into closed
-		closed_nodes.push_back(nnode);
+		push_closed_node(nnode);
 	}
 //DEBUG(0,LEVEL_DEBUGGING,"FAIL\n");
 	delete_nodes();
@@ -140,21 +152,14 @@ sint32 AStarPath::step_cost(MapCoord &c1, MapCoord &c2) {
 	return (1);
 }/* Return an item in the list of closed nodes whose location matches `ncmp'.
  */astar_node *AStarPath::find_closed_node(astar_node *ncmp) {
-	Std::list<astar_node *>::iterator n;
-	for (n = closed_nodes.begin(); n != closed_nodes.end(); n++)
-		if ((*n)->loc == ncmp->loc)
-			return (*n);
-	return (NULL);
+	return closed_map.getValOrDefault(node_key(ncmp->loc), NULL);
 }/* Return an item in the list of closed nodes whose location matches `ncmp'.
  */astar_node *AStarPath::find_open_node(astar_node *ncmp) {
-	Std::list<astar_node *>::iterator n;
-	for (n = open_nodes.begin(); n != open_nodes.end(); n++)
-		if ((*n)->loc == ncmp->loc)
-			return (*n);
-	return (NULL);
+	return open_map.getValOrDefault(node_key(ncmp->loc), NULL);
 }/* Add new node pointer to the list of open nodes (sorting by score).
  */void AStarPath::push_open_node(astar_node *node) {
 	Std::list<astar_node *>::iterator n, next;
+	open_map[node_key(node->loc)] = node;
 	if (open_nodes.empty()) {
 		open_nodes.push_front(node);
 		return;
@@ -168,6 +173,7 @@ sint32 AStarPath::step_cost(MapCoord &c1, MapCoord &c2) {
  */astar_node *AStarPath::pop_open_node() {
 	astar_node *best = open_nodes.front();
 	open_nodes.pop_front(); // remove it
+	open_map.erase(node_key(best->loc));
 	return (best);
 }
 
@@ -175,27 +181,44 @@ sint32 AStarPath::step_cost(MapCoord &c1, MapCoord &c2) {
  * remove it from the list.
  */
 void AStarPath::remove_closed_node(astar_node *ncmp) {
-	Std::list<astar_node *>::iterator n;
-	for (n = closed_nodes.begin(); n != closed_nodes.end(); n++)
-		if ((*n)->loc == ncmp->loc) {
-			closed_nodes.erase(n);
-			return;
-		}
+	closed_map.erase(node_key(ncmp->loc));
+}
+
+/* Add node pointer to the list of closed nodes.
+ */
+void AStarPath::push_closed_node(astar_node *node) {
+	closed_map[node_key(node->loc)] = node;
 }
 
-/* Delete nodes dereferenced from pointers in the lists.
+/* Return nodes dereferenced from pointers in the lists to the pool.
  */
 void AStarPath::delete_nodes() {
 	while (!open_nodes.empty()) {
-		astar_node *delnode = open_nodes.front();
+		free_node(open_nodes.front());
 		open_nodes.pop_front();
-		delete delnode;
-	}
-	while (!closed_nodes.empty()) {
-		astar_node *delnode = closed_nodes.front();
-		closed_nodes.pop_front();
-		delete delnode;
 	}
+	Common::HashMap<uint32, astar_node *>::iterator n;
+	for (n = closed_map.begin(); n != closed_map.end(); n++)
+		free_node(n->_value);
+	open_map.clear(true);
+	closed_map.clear(true);
+}
+
+/* Get a cleared node from the pool, or a new one if it is empty.
+ */
+astar_node *AStarPath::new_node() {
+	if (node_pool.empty())
+		return new astar_node;
+	astar_node *node = node_pool.back();
+	node_pool.pop_back();
+	*node = astar_node();
+	return node;
+}
+
+/* Return a node to the pool.
+ */
+void AStarPath::free_node(astar_node *node) {
+	node_pool.push_back(node);
 }
 
 } // End of namespace Nuvie
@@ -25,6 +25,7 @@
 
 #include "ultima/nuvie/core/map.h"
 #include "ultima/nuvie/pathfinder/path.h"
+#include "common/hashmap.h"
 
 namespace Ultima {
 namespace Nuvie {
@@ -42,7 +43,10 @@ typedef struct astar_node_s {
 /* Provides A* search and cost methods for PathFinder and subclasses.
  */class AStarPath: public Path {
 protected:
-	Std::list<astar_node *> open_nodes, closed_nodes; // nodes seen
+	Std::list<astar_node *> open_nodes; // nodes seen, sorted by score
+	// nodes seen, by location, so they can be found without walking the lists
+	Common::HashMap<uint32, astar_node *> open_map, closed_map;
+	Std::vector<astar_node *> node_pool; // unused nodes, kept between searches
 	astar_node *final_node; // last node in path search, used by create_path()
 	/* Forms a usable path from results of a search. */
 	void create_path();
@@ -55,7 +59,7 @@ protected:
 	                       sint32 &nnode_to_neighbor);
 public:
 	AStarPath();
-	~AStarPath() override { }
+	~AStarPath() override;
 	bool path_search(MapCoord &start, MapCoord &goal) override;
 	uint32 path_cost_est(MapCoord &s, MapCoord &g) override  {
 		return (Path::path_cost_est(s, g));
@@ -74,7 +78,13 @@ protected:
 	astar_node *pop_open_node();
 	astar_node *find_closed_node(astar_node *ncmp);
 	void remove_closed_node(astar_node *ncmp);
+	void push_closed_node(astar_node *node);
 	void delete_nodes();
+	astar_node *new_node();
+	void free_node(astar_node *node);
+	static uint32 node_key(const MapCoord &loc) {
+		return (loc.z << 24) | ((loc.y & 0xfff) << 12) | (loc.x & 0xfff);
+	}
 };
 
 } // End of namespace Nuvie
@@ -48,12 +48,6 @@
 //
 // Macros defined by this file:
 //
-// NOT_CLIPPED_Y - Does Y Clipping check per line
-//
-// NOT_CLIPPED_X - Does X Clipping check per Pixel
-//
-// LINE_END_ASSIGN - Calcuates the line_end pointer required for X clipping
-//
 // XNEG - Negates X values if doing shape flipping
 //
 // USE_XFORM_FUNC - Checks to see if we want to use XForm Blending for this pixel
@@ -103,9 +97,6 @@ const int32 neg = (FLIP_CONDITIONAL)?-1:0;
 //
 #ifdef NO_CLIPPING
 
-#define LINE_END_ASSIGN //
-#define NOT_CLIPPED_X (1)
-#define NOT_CLIPPED_Y (1)
 #define OFFSET_PIXELS (_pixels)
 
 //
@@ -116,9 +107,6 @@ const int32 neg = (FLIP_CONDITIONAL)?-1:0;
 	const int		scrn_width = _clipWindow.width();
 	const int		scrn_height = _clipWindow.height();
 
-#define LINE_END_ASSIGN const uintX *dst_line_end = dst_line_start + scrn_width
-#define NOT_CLIPPED_X (dstpix >= dst_line_start && dstpix < dst_line_end)
-#define NOT_CLIPPED_Y (line >= 0 && line < scrn_height)
 #define OFFSET_PIXELS (off_pixels)
 
 	uint8			*off_pixels  = _pixels + _clipWindow.left * sizeof(uintX) + _clipWindow.top * _pitch;
@@ -193,32 +181,48 @@ const int32 neg = (FLIP_CONDITIONAL)?-1:0;
 
 	assert(_pixels00 && _pixels && srcpixels && srcmask);
 
-	for (int i = 0; i < height_; i++)  {
+	//
+	// Work out the visible part of the frame once, instead of clipping
+	// every line and every pixel
+	//
+	int32 xstart = 0, xend = width_;
+	int32 ystart = 0, yend = height_;
+
+#ifndef NO_CLIPPING
+	if (XNEG(1) < 0) {
+		xstart = MAX<int32>(xstart, x - scrn_width + 1);
+		xend = MIN<int32>(xend, x + 1);
+	} else {
+		xstart = MAX<int32>(xstart, -x);
+		xend = MIN<int32>(xend, scrn_width - x);
+	}
+	ystart = MAX<int32>(ystart, -y);
+	yend = MIN<int32>(yend, scrn_height - y);
+#endif
+
+	for (int i = ystart; i < yend; i++)  {
 		const int line = y + i;
 
-		if (NOT_CLIPPED_Y) {
-			const uint8	*srcline = srcpixels + i * width_;
-			const uint8	*srcmaskline = srcmask + i * width_;
-			uintX *dst_line_start = reinterpret_cast<uintX *>(OFFSET_PIXELS + _pitch * line);
-			LINE_END_ASSIGN;
-
-			for (int xpos = 0; xpos < width_; xpos++) {
-				if (srcmaskline[xpos] == 0)
-					continue;
-
-				uintX *dstpix = dst_line_start + x + XNEG(xpos);
-
-				if (NOT_CLIPPED_X && NOT_DESTINATION_MASKED) {
-					const uint8 *srcpix = srcline + xpos;
-					#ifdef XFORM_SHAPES
-					if (USE_XFORM_FUNC) {
-						*dstpix = CUSTOM_BLEND(BlendPreModulated(xform_pal[*srcpix], *dstpix));
-					}
-					else
-					#endif
-					{
-						*dstpix = CUSTOM_BLEND(pal[*srcpix]);
-					}
+		const uint8	*srcline = srcpixels + i * width_;
+		const uint8	*srcmaskline = srcmask + i * width_;
+		uintX *dst_line_start = reinterpret_cast<uintX *>(OFFSET_PIXELS + _pitch * line);
+
+		for (int xpos = xstart; xpos < xend; xpos++) {
+			if (srcmaskline[xpos] == 0)
+				continue;
+
+			uintX *dstpix = dst_line_start + x + XNEG(xpos);
+
+			if (NOT_DESTINATION_MASKED) {
+				const uint8 *srcpix = srcline + xpos;
+				#ifdef XFORM_SHAPES
+				if (USE_XFORM_FUNC) {
+					*dstpix = CUSTOM_BLEND(BlendPreModulated(xform_pal[*srcpix], *dstpix));
+				}
+				else
+				#endif
+				{
+					*dstpix = CUSTOM_BLEND(pal[*srcpix]);
 				}
 			}
 		}
@@ -227,8 +231,5 @@ const int32 neg = (FLIP_CONDITIONAL)?-1:0;
 #undef NOT_DESTINATION_MASKED
 #undef OFFSET_PIXELS
 #undef CUSTOM_BLEND
-#undef LINE_END_ASSIGN
-#undef NOT_CLIPPED_X
-#undef NOT_CLIPPED_Y
 #undef XNEG
 #undef USE_XFORM_FUNC
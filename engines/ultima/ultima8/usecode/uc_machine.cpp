@@ -20,7 +20,6 @@
  *
  */
 
-#include "common/memstream.h"
 
 #include "ultima/ultima8/misc/pent_include.h"
 #include "ultima/ultima8/usecode/uc_machine.h"
@@ -66,6 +65,59 @@ static const char *print_sp(const int16 offset) {
 }
 #endif
 
+// Reads the code of the running class. This is used instead of a
+// MemoryReadStream so that fetching an opcode or an operand doesn't go
+// through a virtual call. Reads past the end return 0, like the stream did.
+class UCCodeStream {
+public:
+	UCCodeStream(const uint8 *data, uint32 size) : _data(data), _size(size), _pos(0) { }
+
+	uint8 readByte() {
+		if (_pos >= _size)
+			return 0;
+		return _data[_pos++];
+	}
+	int8 readSByte() {
+		return static_cast<int8>(readByte());
+	}
+	uint16 readUint16LE() {
+		if (_pos + 2 > _size) {
+			_pos = _size;
+			return 0;
+		}
+		const uint16 val = READ_LE_UINT16(_data + _pos);
+		_pos += 2;
+		return val;
+	}
+	uint32 readUint32LE() {
+		if (_pos + 4 > _size) {
+			_pos = _size;
+			return 0;
+		}
+		const uint32 val = READ_LE_UINT32(_data + _pos);
+		_pos += 4;
+		return val;
+	}
+	uint32 read(void *dataPtr, uint32 dataSize) {
+		dataSize = MIN(dataSize, _size - _pos);
+		memcpy(dataPtr, _data + _pos, dataSize);
+		_pos += dataSize;
+		return dataSize;
+	}
+
+	uint32 pos() const {
+		return _pos;
+	}
+	void seek(uint32 offset) {
+		_pos = MIN(offset, _size);
+	}
+
+private:
+	const uint8 *_data;
+	uint32 _size;
+	uint32 _pos;
+};
+
 
 //#define DUMPHEAP
 
@@ -156,8 +208,9 @@ void UCMachine::execProcess(UCProcess *p) {
 	assert(p);
 
 	uint32 base = p->_usecode->get_class_base_offset(p->_classId);
-	Common::SeekableReadStream *cs = new Common::MemoryReadStream(p->_usecode->get_class(p->_classId) + base,
-																  p->_usecode->get_class_size(p->_classId) - base);
+	UCCodeStream codeStream(p->_usecode->get_class(p->_classId) + base,
+	                        p->_usecode->get_class_size(p->_classId) - base);
+	UCCodeStream *cs = &codeStream;
 	cs->seek(p->_ip);
 
 #ifdef DEBUG
@@ -442,9 +495,8 @@ void UCMachine::execProcess(UCProcess *p) {
 
 			// Update the code segment
 			uint32 base_ = p->_usecode->get_class_base_offset(p->_classId);
-			delete cs;
-			cs = new Common::MemoryReadStream(p->_usecode->get_class(p->_classId) + base_,
-											  p->_usecode->get_class_size(p->_classId) - base_);
+			codeStream = UCCodeStream(p->_usecode->get_class(p->_classId) + base_,
+			                          p->_usecode->get_class_size(p->_classId) - base_);
 			cs->seek(p->_ip);
 
 			// Resume execution
@@ -1272,9 +1324,8 @@ void UCMachine::execProcess(UCProcess *p) {
 				// Update the code segment
 				uint32 base_ = p->_usecode->get_class_base_offset(p->_classId);
 
-				delete cs;
-				cs = new Common::MemoryReadStream(p->_usecode->get_class(p->_classId) + base_,
-												  p->_usecode->get_class_size(p->_classId) - base_);
+				codeStream = UCCodeStream(p->_usecode->get_class(p->_classId) + base_,
+				                          p->_usecode->get_class_size(p->_classId) - base_);
 				cs->seek(p->_ip);
 			}
 
@@ -2031,8 +2082,6 @@ void UCMachine::execProcess(UCProcess *p) {
 			cede = true;
 	} // while(!cede && !error && !p->terminated && !p->terminate_deferred)
 
-	delete cs;
-
 	if (error) {
 		perr.Print("Process %d caused an error at %04X:%04X (item %d). Killing process.\n",
 		            p->_pid, p->_classId, p->_ip, p->_itemNum);
@@ -566,9 +566,12 @@ void CurrentMap::areaSearch(UCList *itemlist, const uint8 *loopscript,
 
 	const Rect searchrange(x - xd - range, y - yd - range, x + range, y + range);
 
-	int minx = ((x - xd - range) / _mapChunkSize) - 1;
+	// Items are stored in the chunk of their far corner, which has to be
+	// past the left and top of the search range for them to intersect it.
+	// So there is no need to look at the chunks before it.
+	int minx = ((x - xd - range) / _mapChunkSize);
 	int maxx = ((x + range) / _mapChunkSize) + 1;
-	int miny = ((y - yd - range) / _mapChunkSize) - 1;
+	int miny = ((y - yd - range) / _mapChunkSize);
 	int maxy = ((y + range) / _mapChunkSize) + 1;
 	clipMapChunks(minx, maxx, miny, maxy);
 
@@ -640,9 +643,10 @@ void CurrentMap::surfaceSearch(UCList *itemlist, const uint8 *loopscript,
 	const Rect searchrange(origin[0] - dims[0], origin[1] - dims[1],
 	                       origin[0], origin[1]);
 
-	int minx = ((origin[0] - dims[0]) / _mapChunkSize) - 1;
+	// See areaSearch for the range of chunks
+	int minx = ((origin[0] - dims[0]) / _mapChunkSize);
 	int maxx = ((origin[0]) / _mapChunkSize) + 1;
-	int miny = ((origin[1] - dims[1]) / _mapChunkSize) - 1;
+	int miny = ((origin[1] - dims[1]) / _mapChunkSize);
 	int maxy = ((origin[1]) / _mapChunkSize) + 1;
 	clipMapChunks(minx, maxx, miny, maxy);
 
@@ -1067,6 +1071,16 @@ bool CurrentMap::sweepTest(const int32 start[3], const int32 end[3],
 	// Z is opposite direction to x and y..
 	centre[2] = start[2] + ext[2];
 
+	// Area swept in x and y, used to reject the items which can't be hit
+	// before the full test. The margin covers the rounding of the hit times
+	// for long sweeps.
+	int32 sweepMin[2], sweepMax[2];
+	for (int i = 0; i < 2; i++) {
+		const int32 margin = 2 + ABS(vel[i]) / 0x2000;
+		sweepMin[i] = MIN(start[i], end[i]) - dims[i] - margin;
+		sweepMax[i] = MAX(start[i], end[i]) + margin;
+	}
+
 //	pout << "Sweeping from (" << -ext[0] << ", " << -ext[1] << ", " << -ext[2] << ")" << Std::endl;
 //	pout << "              (" << ext[0] << ", " << ext[1] << ", " << ext[2] << ")" << Std::endl;
 //	pout << "Sweeping to   (" << vel[0]-ext[0] << ", " << vel[1]-ext[1] << ", " << vel[2]-ext[2] << ")" << Std::endl;
@@ -1099,6 +1113,10 @@ bool CurrentMap::sweepTest(const int32 start[3], const int32 end[3],
 				other_item->getLocation(other[0], other[1], other[2]);
 				other_item->getFootpadWorld(oext[0], oext[1], oext[2]);
 
+				if (other[0] < sweepMin[0] || other[0] - oext[0] > sweepMax[0] ||
+				        other[1] < sweepMin[1] || other[1] - oext[1] > sweepMax[1])
+					continue;
+
 				// If the objects overlapped at the start, ignore collision.
 				// The -1 and +1 portions are to still consider collisions
 				// for items which were merely touching at the start for all
@@ -44,7 +44,8 @@ namespace Ultima8 {
 
 ItemSorter::ItemSorter() :
 	_shapes(nullptr), _surf(nullptr), _items(nullptr), _itemsTail(nullptr),
-	_itemsUnused(nullptr), _sortLimit(0), _camSx(0), _camSy(0), _orderCounter(0) {
+	_itemsUnused(nullptr), _sortLimit(0), _camSx(0), _camSy(0), _orderCounter(0),
+	_columnsLeft(0), _addCounter(0) {
 	int i = 2048;
 	while (i--) _itemsUnused = new SortItem(_itemsUnused);
 }
@@ -88,6 +89,24 @@ void ItemSorter::BeginDisplayList(RenderSurface *rs,
 	_camSx = (camx - camy) / 4;
 	// Screenspace bounding box bottom extent  (RNB y coord)
 	_camSy = (camx + camy) / 8 - camz;
+
+	// Reset the columns, keeping their storage for the next frame
+	Rect clipWindow;
+	_surf->GetClippingRect(clipWindow);
+	_columnsLeft = clipWindow.left;
+	uint32 numColumns = MAX<int32>(clipWindow.right - clipWindow.left, 0) / COLUMN_WIDTH + 1;
+	if (_columns.size() < numColumns)
+		_columns.resize(numColumns);
+	for (uint32 i = 0; i < _columns.size(); i++)
+		_columns[i].resize(0);
+}
+
+void ItemSorter::GetColumnRange(const SortItem *si, int32 &first, int32 &last) const {
+	// Items outside of the clipping window go to the outer columns. Two
+	// items whose bounding boxes overlap horizontally always share a column.
+	const int32 maxColumn = _columns.size() - 1;
+	first = CLIP<int32>((si->_sxLeft - _columnsLeft) / COLUMN_WIDTH, 0, maxColumn);
+	last = CLIP<int32>((MAX(si->_sxRight - 1, si->_sxLeft) - _columnsLeft) / COLUMN_WIDTH, 0, maxColumn);
 }
 
 void ItemSorter::AddItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 frame_num, uint32 flags, uint32 ext_flags, uint16 itemNum) {
@@ -179,6 +198,23 @@ void ItemSorter::AddItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 fram
 	// are never deleted
 	si->_depends.clear();
 
+	// Only the items sharing a column with us can overlap us. Mark them
+	// first, the list is still walked so they are compared in list order.
+	int32 firstColumn, lastColumn;
+	GetColumnRange(si, firstColumn, lastColumn);
+
+	const uint32 stamp = ++_addCounter;
+	int32 candidates = 0;
+	for (int32 i = firstColumn; i <= lastColumn; i++) {
+		const Std::vector<SortItem *> &column = _columns[i];
+		for (uint32 j = 0; j < column.size(); j++) {
+			if (column[j]->_addStamp != stamp) {
+				column[j]->_addStamp = stamp;
+				candidates++;
+			}
+		}
+	}
+
 	// Iterate the list and compare _shapes
 
 	// Ok,
@@ -188,6 +224,13 @@ void ItemSorter::AddItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 fram
 		if (!addpoint && si->ListLessThan(si2))
 			addpoint = si2;
 
+		if (si2->_addStamp != stamp) {
+			if (addpoint && !candidates)
+				break;
+			continue;
+		}
+		candidates--;
+
 		// Doesn't overlap
 		if (si2->_occluded || !si->overlap(*si2))
 			continue;
@@ -216,6 +259,12 @@ void ItemSorter::AddItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 fram
 	// Add it to the list
 	_itemsUnused = _itemsUnused->_next;
 
+	// Items occluded when added are never compared again
+	if (!si->_occluded) {
+		for (int32 i = firstColumn; i <= lastColumn; i++)
+			_columns[i].push_back(si);
+	}
+
 	// have a position
 	//addpoint = 0;
 	if (addpoint) {
@@ -23,6 +23,8 @@
 #ifndef ULTIMA8_WORLD_ITEMSORTER_H
 #define ULTIMA8_WORLD_ITEMSORTER_H
 
+#include "ultima/shared/std/containers.h"
+
 namespace Ultima {
 namespace Ultima8 {
 
@@ -44,6 +46,13 @@ class ItemSorter {
 
 	int32       _camSx, _camSy;
 
+	// Items bucketed by the screen columns their bounding box covers, so an
+	// added item is only tested against the items sharing a column with it
+	static const int32 COLUMN_WIDTH = 32;
+	Std::vector<Std::vector<SortItem *> > _columns;
+	int32       _columnsLeft;
+	uint32      _addCounter;
+
 public:
 	ItemSorter();
 	~ItemSorter();
@@ -69,6 +78,7 @@ public:
 
 private:
 	bool PaintSortItem(SortItem *);
+	void GetColumnRange(const SortItem *si, int32 &first, int32 &last) const;
 	bool NullPaintSortItem(SortItem *);
 };
 
@@ -47,7 +47,7 @@ struct SortItem {
 			_occl(false), _solid(false), _draw(false), _roof(false),
 			_noisy(false), _anim(false), _trans(false), _fixed(false),
 			_land(false), _occluded(false), _clipped(false), _sprite(false),
-			_invitem(false) { }
+			_invitem(false), _addStamp(0) { }
 
 	SortItem                *_next;
 	SortItem                *_prev;
@@ -113,6 +113,8 @@ struct SortItem {
 
 	int32   _order;      // Rendering _order. -1 is not yet drawn
 
+	uint32  _addStamp;   // Marks the items sharing a screen column with the item being added
+
 	// Note that Std::priority_queue could be used here, BUT there is no guarentee that it's implementation
 	// will be friendly to insertions
 	// Alternatively i could use Std::list, BUT there is no guarentee that it will keep wont delete
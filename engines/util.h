@@ -79,5 +79,19 @@ void initGraphics(int width, int height, const Common::List<Graphics::PixelForma
  * @overload
  */
 void initGraphics3d(int width, int height);
+
+/**
+ * Return the memory the resource caches of the running game may use.
+ *
+ * This is the "resource_memory_budget" setting, in MB, of the game or of the
+ * global domain. Without it, the budget is a share of the physical memory
+ * reported by the backend, so that handhelds and desktops both get caches
+ * suited to them.
+ *
+ * @param engineDefault  Budget used when the physical memory is unknown.
+ *
+ * @return Budget in bytes.
+ */
+uint32 getResourceMemoryBudget(uint32 engineDefault);
 /** @} */
 #endif
@@ -46,10 +46,16 @@
 #include "common/file.h"
 #include "common/savefile.h"
 #include "common/fs.h"
+#include "common/memstream.h"
 #include "common/unzip.h"
 
 namespace Wintermute {
 
+// Package files up to this size are kept in memory once opened twice,
+// until all of them together would exceed the total budget.
+static const uint32 kSmallFileMaxSize = 64 * 1024;
+static const uint32 kSmallFilesBudget = 4 * 1024 * 1024;
+
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
@@ -59,6 +65,7 @@ BaseFileManager::BaseFileManager(Common::Language lang, bool detectionMode) {
 	_detectionMode = detectionMode;
 	_language = lang;
 	_resources = nullptr;
+	_smallFilesSize = 0;
 	initResources();
 	initPaths();
 	registerPackages();
@@ -82,8 +89,15 @@ bool BaseFileManager::cleanup() {
 	_openFiles.clear();
 
 	// delete packages
+	_packageIndex.clear();
 	_packages.clear();
 
+	for (Common::HashMap<Common::String, SmallFileEntry>::iterator it = _smallFiles.begin(); it != _smallFiles.end(); ++it) {
+		free(it->_value._data);
+	}
+	_smallFiles.clear();
+	_smallFilesSize = 0;
+
 	// get rid of the resources:
 	delete _resources;
 	_resources = NULL;
@@ -329,8 +343,14 @@ bool BaseFileManager::registerPackages() {
 
 bool BaseFileManager::registerPackage(Common::FSNode file, const Common::String &filename, bool searchSignature) {
 	PackageSet *pack = new PackageSet(file, filename, searchSignature);
-	_packages.add(filename, pack, pack->getPriority() , true);
-	_versions[filename] = pack->getVersion();
+	int priority = pack->getPriority();
+	uint32 version = pack->getVersion();
+	bool duplicate = _packages.hasArchive(filename);
+	_packages.add(filename, pack, priority, true);
+	if (!duplicate) {
+		indexPackage(pack, priority);
+	}
+	_versions[filename] = version;
 
 	return STATUS_OK;
 }
@@ -348,25 +368,86 @@ void BaseFileManager::initResources() {
 }
 
 //////////////////////////////////////////////////////////////////////////
-Common::SeekableReadStream *BaseFileManager::openPkgFile(const Common::String &filename) {
+void BaseFileManager::indexPackage(const Common::Archive *package, int priority) {
+	Common::ArchiveMemberList members;
+	package->listMembers(members);
+
+	for (Common::ArchiveMemberList::const_iterator it = members.begin(); it != members.end(); ++it) {
+		Common::String name = normalizePkgPath((*it)->getName());
+		Common::HashMap<Common::String, PackageIndexEntry>::iterator entry = _packageIndex.find(name);
+
+		// same as the search order of _packages: on equal priority,
+		// the package registered first wins
+		if (entry == _packageIndex.end() || entry->_value._priority < priority) {
+			PackageIndexEntry &indexEntry = _packageIndex[name];
+			indexEntry._member = *it;
+			indexEntry._priority = priority;
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+Common::String BaseFileManager::normalizePkgPath(const Common::String &filename) {
 	Common::String upcName = filename;
 	upcName.toUppercase();
-	Common::SeekableReadStream *file = nullptr;
 
 	// correct slashes
-	for (uint32 i = 0; i < upcName.size(); i++) {
-		if (upcName[(int32)i] == '/') {
-			upcName.setChar('\\', (uint32)i);
-		}
+	Common::replace(upcName.begin(), upcName.end(), '/', '\\');
+	return upcName;
+}
+
+//////////////////////////////////////////////////////////////////////////
+Common::SeekableReadStream *BaseFileManager::openPkgFile(const Common::String &filename) {
+	Common::String upcName = normalizePkgPath(filename);
+
+	Common::HashMap<Common::String, SmallFileEntry>::iterator cached = _smallFiles.find(upcName);
+	if (cached != _smallFiles.end() && cached->_value._data) {
+		byte *data = (byte *)malloc(cached->_value._size);
+		memcpy(data, cached->_value._data, cached->_value._size);
+		return new Common::MemoryReadStream(data, cached->_value._size, DisposeAfterUse::YES);
 	}
-	Common::ArchiveMemberPtr entry = _packages.getMember(upcName);
-	if (!entry) {
+
+	Common::HashMap<Common::String, PackageIndexEntry>::const_iterator entry = _packageIndex.find(upcName);
+	if (entry == _packageIndex.end()) {
 		return nullptr;
 	}
-	file = entry->createReadStream();
+
+	Common::SeekableReadStream *file = entry->_value._member->createReadStream();
+	if (file) {
+		file = readSmallPkgFile(upcName, file);
+	}
 	return file;
 }
 
+//////////////////////////////////////////////////////////////////////////
+Common::SeekableReadStream *BaseFileManager::readSmallPkgFile(const Common::String &name, Common::SeekableReadStream *file) {
+	int64 size = file->size();
+	if (size <= 0 || size > (int64)kSmallFileMaxSize || _smallFilesSize + size > kSmallFilesBudget) {
+		return file;
+	}
+
+	SmallFileEntry &entry = _smallFiles.getOrCreateVal(name);
+	if (++entry._opened < 2) {
+		return file;
+	}
+
+	byte *data = (byte *)malloc(size);
+	if (file->read(data, size) != (uint32)size) {
+		free(data);
+		file->seek(0);
+		return file;
+	}
+	delete file;
+
+	entry._data = data;
+	entry._size = size;
+	_smallFilesSize += size;
+
+	byte *copy = (byte *)malloc(size);
+	memcpy(copy, data, size);
+	return new Common::MemoryReadStream(copy, size, DisposeAfterUse::YES);
+}
+
 //////////////////////////////////////////////////////////////////////////
 uint32 BaseFileManager::getPackageVersion(const Common::String &filename) {
 	Common::HashMap<Common::String, uint32>::iterator it = _versions.find(filename);
@@ -378,10 +459,6 @@ uint32 BaseFileManager::getPackageVersion(const Common::String &filename) {
 
 //////////////////////////////////////////////////////////////////////////
 bool BaseFileManager::hasFile(const Common::String &filename) {
-	Common::String backwardSlashesPath = filename;
-	// correct slashes
-	Common::replace(backwardSlashesPath.begin(), backwardSlashesPath.end(), '/', '\\');
-
 	if (scumm_strnicmp(filename.c_str(), "savegame:", 9) == 0) {
 		BasePersistenceManager pm(BaseEngine::instance().getGameTargetName());
 		if (filename.size() <= 9) {
@@ -396,7 +473,7 @@ bool BaseFileManager::hasFile(const Common::String &filename) {
 	if (diskFileExists(filename)) {
 		return true;
 	}
-	if (_packages.hasFile(backwardSlashesPath)) {
+	if (_packageIndex.contains(normalizePkgPath(filename))) {
 		return true;    // We don't bother checking if the file can actually be opened, something bigger is wrong if that is the case.
 	}
 	if (!_detectionMode && _resources->hasFile(filename)) {
@@ -34,6 +34,7 @@
 #include "common/str-array.h"
 #include "common/fs.h"
 #include "common/file.h"
+#include "common/hashmap.h"
 #include "common/language.h"
 
 namespace Wintermute {
@@ -68,6 +69,9 @@ private:
 	Common::SeekableReadStream *openFileRaw(const Common::String &filename);
 	Common::WriteStream *openFileForWriteRaw(const Common::String &filename);
 	Common::SeekableReadStream *openPkgFile(const Common::String &filename);
+	static Common::String normalizePkgPath(const Common::String &filename);
+	void indexPackage(const Common::Archive *package, int priority);
+	Common::SeekableReadStream *readSmallPkgFile(const Common::String &name, Common::SeekableReadStream *file);
 	Common::FSList _packagePaths;
 	bool registerPackage(Common::FSNode package, const Common::String &filename = "", bool searchSignature = false);
 	bool _detectionMode;
@@ -77,6 +81,24 @@ private:
 	Common::Archive *_resources;
 	Common::HashMap<Common::String, uint32> _versions;
 
+	// Merged view of all registered packages, keyed by normalized path and
+	// holding the member of the package with the highest priority.
+	struct PackageIndexEntry {
+		Common::ArchiveMemberPtr _member;
+		int _priority;
+	};
+	Common::HashMap<Common::String, PackageIndexEntry> _packageIndex;
+
+	// Contents of small package files that are opened repeatedly
+	// (scripts, definitions, small sprites), kept until cleanup().
+	struct SmallFileEntry {
+		byte *_data;
+		uint32 _size;
+		uint32 _opened;
+	};
+	Common::HashMap<Common::String, SmallFileEntry> _smallFiles;
+	uint32 _smallFilesSize;
+
 	// This class is intentionally not a subclass of Base, as it needs to be used by
 	// the detector too, without launching the entire engine:
 };
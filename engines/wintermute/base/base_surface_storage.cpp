@@ -33,6 +33,7 @@
 #include "engines/wintermute/base/base_engine.h"
 #include "engines/wintermute/base/base_file_manager.h"
 #include "engines/wintermute/platform_osystem.h"
+#include "common/config-manager.h"
 #include "common/str.h"
 
 namespace Wintermute {
@@ -42,6 +43,13 @@ namespace Wintermute {
 //////////////////////////////////////////////////////////////////////
 BaseSurfaceStorage::BaseSurfaceStorage(BaseGame *inGame) : BaseClass(inGame) {
 	_lastCleanupTime = 0;
+
+	// Budget for the decoded surfaces, in megabytes; 0 means unlimited
+	_budget = 256;
+	if (ConfMan.hasKey("surface_cache_size")) {
+		_budget = ConfMan.getInt("surface_cache_size");
+	}
+	_budget *= 1024 * 1024;
 }
 
 
@@ -67,8 +75,12 @@ bool BaseSurfaceStorage::cleanup(bool warn) {
 
 //////////////////////////////////////////////////////////////////////////
 bool BaseSurfaceStorage::initLoop() {
-	if (_gameRef->_smartCache && _gameRef->getLiveTimer()->getTime() - _lastCleanupTime >= _gameRef->_surfaceGCCycleTime) {
-		_lastCleanupTime = _gameRef->getLiveTimer()->getTime();
+	if (_gameRef->getLiveTimer()->getTime() - _lastCleanupTime < _gameRef->_surfaceGCCycleTime) {
+		return STATUS_OK;
+	}
+	_lastCleanupTime = _gameRef->getLiveTimer()->getTime();
+
+	if (_gameRef->_smartCache) {
 		sortSurfaces();
 		for (uint32 i = 0; i < _surfaces.size(); i++) {
 			if (_surfaces[i]->_lifeTime <= 0) {
@@ -81,9 +93,57 @@ bool BaseSurfaceStorage::initLoop() {
 			}
 		}
 	}
+
+	if (_budget > 0) {
+		enforceBudget();
+	}
 	return STATUS_OK;
 }
 
+//////////////////////////////////////////////////////////////////////////
+uint32 BaseSurfaceStorage::getLoadedSize() const {
+	uint32 size = 0;
+	for (uint32 i = 0; i < _surfaces.size(); i++) {
+		size += _surfaces[i]->getLoadedSize();
+	}
+	return size;
+}
+
+//////////////////////////////////////////////////////////////////////////
+static bool surfaceUseCB(const BaseSurface *s1, const BaseSurface *s2) {
+	return s1->_lastUsedTime < s2->_lastUsedTime;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void BaseSurfaceStorage::enforceBudget() {
+	uint32 size = getLoadedSize();
+	if (size <= _budget) {
+		return;
+	}
+
+	Common::Array<BaseSurface *> loaded;
+	for (uint32 i = 0; i < _surfaces.size(); i++) {
+		if (_surfaces[i]->getLoadedSize() > 0) {
+			loaded.push_back(_surfaces[i]);
+		}
+	}
+	Common::sort(loaded.begin(), loaded.end(), surfaceUseCB);
+
+	// Never unload what was drawn during the last cycle, reloading it
+	// would only make the next frames stutter
+	uint32 now = _gameRef->getLiveTimer()->getTime();
+	for (uint32 i = 0; i < loaded.size() && size > _budget; i++) {
+		if (now - loaded[i]->_lastUsedTime < _gameRef->_surfaceGCCycleTime) {
+			break;
+		}
+		uint32 surfaceSize = loaded[i]->getLoadedSize();
+		if (DID_SUCCEED(loaded[i]->invalidate())) {
+			size -= surfaceSize;
+			_stats._evictions++;
+		}
+	}
+}
+
 
 //////////////////////////////////////////////////////////////////////
 bool BaseSurfaceStorage::removeSurface(BaseSurface *surface) {
@@ -106,6 +166,7 @@ BaseSurface *BaseSurfaceStorage::addSurface(const Common::String &filename, bool
 	for (uint32 i = 0; i < _surfaces.size(); i++) {
 		if (scumm_stricmp(_surfaces[i]->getFileName(), filename.c_str()) == 0) {
 			_surfaces[i]->_referenceCount++;
+			_stats._hits++;
 			return _surfaces[i];
 		}
 	}
@@ -134,6 +195,7 @@ BaseSurface *BaseSurfaceStorage::addSurface(const Common::String &filename, bool
 	} else {
 		surface->_referenceCount = 1;
 		_surfaces.push_back(surface);
+		_stats._misses++;
 		return surface;
 	}
 }
@@ -49,7 +49,24 @@ public:
 	BaseSurfaceStorage(BaseGame *inGame);
 	~BaseSurfaceStorage() override;
 
+	struct Stats {
+		uint32 _hits = 0;      // surface requests served by an existing surface
+		uint32 _misses = 0;    // surface requests that created a new surface
+		uint32 _evictions = 0; // surfaces unloaded to stay within the budget
+	};
+	const Stats &getStats() const { return _stats; }
+	void resetStats() { _stats = Stats(); }
+	// Total memory taken by the decoded surfaces
+	uint32 getLoadedSize() const;
+	uint32 getBudget() const { return _budget; }
+
 	Common::Array<BaseSurface *> _surfaces;
+private:
+	// Unloads the least recently used surfaces until they fit in the budget
+	void enforceBudget();
+
+	uint32 _budget;
+	Stats _stats;
 };
 
 } // End of namespace Wintermute
@@ -77,6 +77,8 @@ public:
 	virtual int getHeight() {
 		return _height;
 	}
+	// Memory taken by the decoded pixels, or 0 when the surface is not loaded
+	uint32 getLoadedSize() const { return _valid ? _width * _height * 4 : 0; }
 	Common::String getFileNameStr() { return _filename; }
 	const char* getFileName() { return _filename.c_str(); }
 	//void SetWidth(int Width) { _width = Width;    }
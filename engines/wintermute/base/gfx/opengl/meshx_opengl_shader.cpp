@@ -127,8 +127,11 @@ bool MeshXOpenGLShader::renderFlatShadowModel() {
 bool MeshXOpenGLShader::update(FrameNode *parentFrame) {
 	MeshX::update(parentFrame);
 
-	glBindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
-	glBufferSubData(GL_ARRAY_BUFFER, 0, 4 * kVertexComponentCount * _vertexCount, _vertexData);
+	if (_vertexDataDirty) {
+		glBindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, 4 * kVertexComponentCount * _vertexCount, _vertexData);
+		_vertexDataDirty = false;
+	}
 
 	return true;
 }
@@ -68,12 +68,7 @@ BaseRenderOSystem::BaseRenderOSystem(BaseGame *inGame) : BaseRenderer(inGame) {
 
 //////////////////////////////////////////////////////////////////////////
 BaseRenderOSystem::~BaseRenderOSystem() {
-	RenderQueueIterator it = _renderQueue.begin();
-	while (it != _renderQueue.end()) {
-		RenderTicket *ticket = *it;
-		it = _renderQueue.erase(it);
-		delete ticket;
-	}
+	clearRenderQueue();
 
 	delete _dirtyRect;
 
@@ -177,19 +172,6 @@ bool BaseRenderOSystem::flip() {
 	}
 	if (!_disableDirtyRects) {
 		drawTickets();
-	} else {
-		// Clear the scale-buffered tickets that wasn't reused.
-		RenderQueueIterator it = _renderQueue.begin();
-		while (it != _renderQueue.end()) {
-			if ((*it)->_wantsDraw == false) {
-				RenderTicket *ticket = *it;
-				it = _renderQueue.erase(it);
-				delete ticket;
-			} else {
-				(*it)->_wantsDraw = false;
-				++it;
-			}
-		}
 	}
 
 	int oldScreenChangeID = _lastScreenChangeID;
@@ -290,10 +272,10 @@ Graphics::PixelFormat BaseRenderOSystem::getPixelFormat() const {
 void BaseRenderOSystem::drawSurface(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct &transform) {
 
 	if (_disableDirtyRects) {
-		RenderTicket *ticket = new RenderTicket(owner, surf, srcRect, dstRect, transform);
-		ticket->_wantsDraw = true;
-		_renderQueue.push_back(ticket);
-		drawFromSurface(ticket);
+		// Everything is redrawn each frame, so nothing has to be queued; and as
+		// the ticket is drawn right away it may use the source pixels directly.
+		RenderTicket ticket(owner, surf, srcRect, dstRect, transform, false);
+		drawFromSurface(&ticket);
 		return;
 	}
 
@@ -304,32 +286,35 @@ void BaseRenderOSystem::drawSurface(BaseSurfaceOSystem *owner, const Graphics::S
 
 	if (owner) { // Fade-tickets are owner-less
 		RenderTicket compare(owner, nullptr, srcRect, dstRect, transform);
-		RenderQueueIterator it = _lastFrameIter;
-		++it;
-		// Avoid calling end() and operator* every time, when potentially going through
-		// LOTS of tickets.
-		RenderQueueIterator endIterator = _renderQueue.end();
-		RenderTicket *compareTicket = nullptr;
-		for (; it != endIterator; ++it) {
-			compareTicket = *it;
-			if (*(compareTicket) == compare && compareTicket->_isValid) {
-				if (_disableDirtyRects) {
-					drawFromSurface(compareTicket);
-				} else {
-					drawFromQueuedTicket(it);
+		TicketIndex::const_iterator bucket = _ticketIndex.find(hashTicket(compare));
+		if (bucket != _ticketIndex.end()) {
+			// Tickets from last frame that were not drawn yet are the ones
+			// after _lastFrameIter, which is where the undrawn ones live.
+			// Prefer the one that keeps the draw order.
+			RenderQueueIterator next = _lastFrameIter;
+			++next;
+			const RenderTicket *nextTicket = (next != _renderQueue.end()) ? *next : nullptr;
+			bool found = false;
+			RenderQueueIterator match;
+			for (uint i = 0; i < bucket->_value.size(); ++i) {
+				const RenderTicket *ticket = *bucket->_value[i];
+				if (ticket->_wantsDraw || !ticket->_isValid || !(*ticket == compare))
+					continue;
+				if (!found || ticket == nextTicket) {
+					match = bucket->_value[i];
+					found = true;
 				}
+				if (ticket == nextTicket)
+					break;
+			}
+			if (found) {
+				drawFromQueuedTicket(match);
 				return;
 			}
 		}
 	}
 	RenderTicket *ticket = new RenderTicket(owner, surf, srcRect, dstRect, transform);
-	if (!_disableDirtyRects) {
-		drawFromTicket(ticket);
-	} else {
-		ticket->_wantsDraw = true;
-		_renderQueue.push_back(ticket);
-		drawFromSurface(ticket);
-	}
+	drawFromTicket(ticket);
 }
 
 void BaseRenderOSystem::invalidateTicket(RenderTicket *renderTicket) {
@@ -354,13 +339,13 @@ void BaseRenderOSystem::drawFromTicket(RenderTicket *renderTicket) {
 	// In-order
 	if (_renderQueue.empty() || _lastFrameIter == _renderQueue.end()) {
 		_lastFrameIter--;
-		_renderQueue.push_back(renderTicket);
+		queueTicket(_renderQueue.end(), renderTicket);
 		++_lastFrameIter;
 		addDirtyRect(renderTicket->_dstRect);
 	} else {
 		// Before something
 		RenderQueueIterator pos = _lastFrameIter;
-		_renderQueue.insert(pos, renderTicket);
+		queueTicket(pos, renderTicket);
 		--_lastFrameIter;
 		addDirtyRect(renderTicket->_dstRect);
 	}
@@ -377,12 +362,53 @@ void BaseRenderOSystem::drawFromQueuedTicket(const RenderQueueIterator &ticket)
 		--_lastFrameIter;
 		// Remove the ticket from the list
 		assert(*_lastFrameIter != renderTicket);
-		_renderQueue.erase(ticket);
+		dequeueTicket(ticket);
 		// Is not in order, so readd it as if it was a new ticket
 		drawFromTicket(renderTicket);
 	}
 }
 
+void BaseRenderOSystem::queueTicket(RenderQueueIterator pos, RenderTicket *ticket) {
+	_renderQueue.insert(pos, ticket);
+	--pos;
+	_ticketIndex[hashTicket(*ticket)].push_back(pos);
+}
+
+BaseRenderOSystem::RenderQueueIterator BaseRenderOSystem::dequeueTicket(RenderQueueIterator it) {
+	TicketIndex::iterator bucket = _ticketIndex.find(hashTicket(**it));
+	assert(bucket != _ticketIndex.end());
+	Common::Array<RenderQueueIterator> &entries = bucket->_value;
+	for (uint i = 0; i < entries.size(); ++i) {
+		if (entries[i] == it) {
+			entries.remove_at(i);
+			break;
+		}
+	}
+	if (entries.empty())
+		_ticketIndex.erase(bucket);
+	return _renderQueue.erase(it);
+}
+
+void BaseRenderOSystem::clearRenderQueue() {
+	RenderQueueIterator it = _renderQueue.begin();
+	while (it != _renderQueue.end()) {
+		RenderTicket *ticket = *it;
+		it = _renderQueue.erase(it);
+		delete ticket;
+	}
+	_ticketIndex.clear();
+}
+
+uint32 BaseRenderOSystem::hashTicket(const RenderTicket &ticket) {
+	const Common::Rect &src = *ticket.getSrcRect();
+	const Common::Rect &dst = ticket._dstRect;
+	uint32 hash = (uint32)(uintptr)ticket._owner;
+	hash = hash * 31 + ((src.left << 16) ^ src.top);
+	hash = hash * 31 + ((src.right << 16) ^ src.bottom);
+	hash = hash * 31 + ((dst.left << 16) ^ dst.top);
+	return hash * 31 + ((dst.right << 16) ^ dst.bottom);
+}
+
 void BaseRenderOSystem::addDirtyRect(const Common::Rect &rect) {
 	if (!_dirtyRect) {
 		_dirtyRect = new Common::Rect(rect);
@@ -402,7 +428,7 @@ void BaseRenderOSystem::drawTickets() {
 		if ((*it)->_wantsDraw == false) {
 			RenderTicket *ticket = *it;
 			addDirtyRect((*it)->_dstRect);
-			it = _renderQueue.erase(it);
+			it = dequeueTicket(it);
 			delete ticket;
 		} else {
 			++it;
@@ -462,7 +488,7 @@ void BaseRenderOSystem::drawTickets() {
 		if ((*it)->_isValid == false) {
 			RenderTicket *ticket = *it;
 			addDirtyRect((*it)->_dstRect);
-			it = _renderQueue.erase(it);
+			it = dequeueTicket(it);
 			delete ticket;
 		} else {
 			++it;
@@ -584,12 +610,7 @@ void BaseRenderOSystem::endSaveLoad() {
 	BaseRenderer::endSaveLoad();
 
 	// Clear the scale-buffered tickets as we just loaded.
-	RenderQueueIterator it = _renderQueue.begin();
-	while (it != _renderQueue.end()) {
-		RenderTicket *ticket = *it;
-		it = _renderQueue.erase(it);
-		delete ticket;
-	}
+	clearRenderQueue();
 	// HACK: After a save the buffer will be drawn before the scripts get to update it,
 	// so just skip this single frame.
 	_skipThisFrame = true;
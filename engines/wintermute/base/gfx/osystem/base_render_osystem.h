@@ -32,6 +32,8 @@
 #include "engines/wintermute/base/gfx/base_renderer.h"
 #include "common/rect.h"
 #include "graphics/surface.h"
+#include "common/array.h"
+#include "common/hashmap.h"
 #include "common/list.h"
 #include "graphics/transform_struct.h"
 
@@ -129,8 +131,23 @@ private:
 	void drawFromSurface(RenderTicket *ticket);
 	// Dirty-rects:
 	void drawFromSurface(RenderTicket *ticket, Common::Rect *dstRect, Common::Rect *clipRect);
+	/**
+	 * Insert a ticket into the render queue before the given position
+	 */
+	void queueTicket(RenderQueueIterator pos, RenderTicket *ticket);
+	/**
+	 * Remove a ticket from the render queue, returns the following position
+	 */
+	RenderQueueIterator dequeueTicket(RenderQueueIterator it);
+	void clearRenderQueue();
+	static uint32 hashTicket(const RenderTicket &ticket);
+
 	Common::Rect *_dirtyRect;
 	Common::List<RenderTicket *> _renderQueue;
+	// The queued tickets by the hash of their draw parameters, so that the ticket
+	// matching a draw call can be found without scanning the whole queue
+	typedef Common::HashMap<uint32, Common::Array<RenderQueueIterator> > TicketIndex;
+	TicketIndex _ticketIndex;
 
 	bool _needsFlip;
 	RenderQueueIterator _lastFrameIter;
@@ -313,6 +313,25 @@ bool BaseSurfaceOSystem::create(int width, int height) {
 	return STATUS_OK;
 }
 
+//////////////////////////////////////////////////////////////////////////
+bool BaseSurfaceOSystem::invalidate() {
+	// Only surfaces loaded from a file can be reloaded when needed again
+	if (!_loaded || _keepLoaded || _filename.empty() || _pixelOpReady) {
+		return STATUS_FAILED;
+	}
+
+	BaseRenderOSystem *renderer = static_cast<BaseRenderOSystem *>(_gameRef->_renderer);
+	renderer->invalidateTicketsFromSurface(this);
+
+	_surface->free();
+	_gameRef->addMem(-_width * _height * 4);
+	_width = _height = 0;
+	_loaded = false;
+	_valid = false;
+
+	return STATUS_OK;
+}
+
 //////////////////////////////////////////////////////////////////////////
 bool BaseSurfaceOSystem::isTransparentAt(int x, int y) {
 	return isTransparentAtLite(x, y);
@@ -320,6 +339,10 @@ bool BaseSurfaceOSystem::isTransparentAt(int x, int y) {
 
 //////////////////////////////////////////////////////////////////////////
 bool BaseSurfaceOSystem::isTransparentAtLite(int x, int y) {
+	if (!_loaded) {
+		finishLoad();
+	}
+
 	if (x < 0 || x >= _surface->w || y < 0 || y >= _surface->h) {
 		return true;
 	}
@@ -43,6 +43,7 @@ public:
 
 	bool create(const Common::String &filename, bool defaultCK, byte ckRed, byte ckGreen, byte ckBlue, int lifeTime = -1, bool keepLoaded = false) override;
 	bool create(int width, int height) override;
+	bool invalidate() override;
 
 	bool isTransparentAt(int x, int y) override;
 	bool isTransparentAtLite(int x, int y) override;
@@ -37,10 +37,11 @@
 namespace Wintermute {
 
 //////////////////////////////////////////////////////////////////////////
-FrameNode::FrameNode(BaseGame *inGame) : BaseNamedObject(inGame) {
+FrameNode::FrameNode(BaseGame *inGame) : BaseNamedObject(inGame), _combinedDirty(true) {
 	_transformationMatrix.setToIdentity();
 	_originalMatrix.setToIdentity();
 	_combinedMatrix.setToIdentity();
+	_parentMatrix.setToIdentity();
 
 	for (int i = 0; i < 2; i++) {
 		_transPos[i] = Math::Vector3d(0.0f, 0.0f, 0.0f);
@@ -82,6 +83,7 @@ Math::Matrix4 *FrameNode::getOriginalMatrix() {
 //////////////////////////////////////////////////////////////////////////
 void FrameNode::setTransformationMatrix(Math::Matrix4 *mat) {
 	_transformationMatrix = *mat;
+	_combinedDirty = true;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -276,8 +278,6 @@ bool FrameNode::updateMatrices(Math::Matrix4 &parentMat) {
 		}
 
 		// prepare local transformation matrix
-		_transformationMatrix.setToIdentity();
-
 		Math::Matrix4 scaleMat;
 		scaleMat.setToIdentity();
 		scaleMat(0, 0) = transScale.x();
@@ -289,13 +289,21 @@ bool FrameNode::updateMatrices(Math::Matrix4 &parentMat) {
 		posMat.setToIdentity();
 		posMat.translate(transPos);
 
-		_transformationMatrix = posMat * rotMat * scaleMat;
+		Math::Matrix4 transformationMatrix = posMat * rotMat * scaleMat;
+		if (transformationMatrix != _transformationMatrix) {
+			_transformationMatrix = transformationMatrix;
+			_combinedDirty = true;
+		}
 	}
 
 	_transUsed[0] = _transUsed[1] = false;
 
-	// multiply by parent transformation
-	_combinedMatrix = parentMat * _transformationMatrix;
+	// multiply by parent transformation, unless neither side changed
+	if (_combinedDirty || parentMat != _parentMatrix) {
+		_parentMatrix = parentMat;
+		_combinedMatrix = parentMat * _transformationMatrix;
+		_combinedDirty = false;
+	}
 
 	// update child frames
 	for (uint32 i = 0; i < _frames.size(); i++) {
@@ -330,6 +338,7 @@ bool FrameNode::updateMeshes() {
 //////////////////////////////////////////////////////////////////////////
 bool FrameNode::resetMatrices() {
 	_transformationMatrix = _originalMatrix;
+	_combinedDirty = true;
 
 	// update child frames
 	for (uint32 i = 0; i < _frames.size(); i++) {
@@ -82,6 +82,10 @@ protected:
 	Math::Matrix4 _transformationMatrix;
 	Math::Matrix4 _originalMatrix;
 	Math::Matrix4 _combinedMatrix;
+	// parent matrix _combinedMatrix was last computed from, so static
+	// parts of the hierarchy don't need to be multiplied out every frame
+	Math::Matrix4 _parentMatrix;
+	bool _combinedDirty;
 
 	Math::Vector3d _transPos[2];
 	Math::Vector3d _transScale[2];
@@ -42,7 +42,7 @@ const uint32 MeshX::kNullIndex;
 MeshX::MeshX(Wintermute::BaseGame *inGame) : BaseNamedObject(inGame),
 	_BBoxStart(0.0f, 0.0f, 0.0f), _BBoxEnd(0.0f, 0.0f, 0.0f),
 	_vertexData(nullptr), _vertexPositionData(nullptr), _vertexNormalData(nullptr),
-	_vertexCount(0), _numAttrs(0), _skinnedMesh(false) {
+	_vertexCount(0), _numAttrs(0), _skinnedMesh(false), _skinnedValid(false), _vertexDataDirty(true) {
 }
 
 MeshX::~MeshX() {
@@ -197,6 +197,7 @@ bool MeshX::findBones(FrameNode *rootFrame) {
 	}
 
 	_boneMatrices.resize(skinWeightsList.size());
+	_skinnedValid = false;
 
 	for (uint i = 0; i < skinWeightsList.size(); ++i) {
 		FrameNode *frame = rootFrame->findFrame(skinWeightsList[i]._boneName.c_str());
@@ -217,9 +218,13 @@ bool MeshX::update(FrameNode *parentFrame) {
 		return false;
 	}
 
+	if (!poseChanged(parentFrame)) {
+		return true;
+	}
+
 	// update skinned mesh
 	if (_skinnedMesh) {
-		BaseArray<Math::Matrix4> finalBoneMatrices;
+		BaseArray<Math::Matrix4> &finalBoneMatrices = _finalBoneMatrices;
 		finalBoneMatrices.resize(_boneMatrices.size());
 
 		for (uint i = 0; i < skinWeightsList.size(); ++i) {
@@ -282,9 +287,10 @@ bool MeshX::update(FrameNode *parentFrame) {
 
 //		updateNormals();
 	} else { // update static
+		const Math::Matrix4 &combinedMatrix = *parentFrame->getCombinedMatrix();
 		for (uint32 i = 0; i < _vertexCount; ++i) {
 			Math::Vector3d pos(_vertexPositionData + 3 * i);
-			parentFrame->getCombinedMatrix()->transform(&pos, true);
+			combinedMatrix.transform(&pos, true);
 
 			for (uint j = 0; j < 3; ++j) {
 				_vertexData[i * kVertexComponentCount + kPositionOffset + j] = pos.getData()[j];
@@ -293,10 +299,43 @@ bool MeshX::update(FrameNode *parentFrame) {
 	}
 
 	updateBoundingBox();
+	_vertexDataDirty = true;
 
 	return true;
 }
 
+//////////////////////////////////////////////////////////////////////////
+bool MeshX::poseChanged(FrameNode *parentFrame) {
+	bool changed = !_skinnedValid;
+
+	if (_skinnedMesh) {
+		if (_skinnedMatrices.size() != _boneMatrices.size()) {
+			_skinnedMatrices.resize(_boneMatrices.size());
+			changed = true;
+		}
+
+		for (uint i = 0; i < _boneMatrices.size(); ++i) {
+			if (changed || _skinnedMatrices[i] != *_boneMatrices[i]) {
+				_skinnedMatrices[i] = *_boneMatrices[i];
+				changed = true;
+			}
+		}
+	} else {
+		if (_skinnedMatrices.size() != 1) {
+			_skinnedMatrices.resize(1);
+			changed = true;
+		}
+
+		if (changed || _skinnedMatrices[0] != *parentFrame->getCombinedMatrix()) {
+			_skinnedMatrices[0] = *parentFrame->getCombinedMatrix();
+			changed = true;
+		}
+	}
+
+	_skinnedValid = true;
+	return changed;
+}
+
 //////////////////////////////////////////////////////////////////////////
 bool MeshX::updateShadowVol(ShadowVolume *shadow, Math::Matrix4 &modelMat, const Math::Vector3d &light, float extrusionDepth) {
 	if (_vertexData == nullptr) {
@@ -452,6 +491,8 @@ bool MeshX::restoreDeviceObjects() {
 		_materials[i]->restoreDeviceObjects();
 	}
 
+	_skinnedValid = false;
+
 	if (_skinnedMesh) {
 		return generateAdjacency();
 	} else {
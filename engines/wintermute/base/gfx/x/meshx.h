@@ -93,6 +93,7 @@ protected:
 	bool parseVertexDeclaration(XFileLexer &lexer);
 
 	void updateBoundingBox();
+	bool poseChanged(FrameNode *parentFrame);
 
 	bool generateAdjacency();
 	bool adjacentEdge(uint16 index1, uint16 index2, uint16 index3, uint16 index4);
@@ -104,6 +105,14 @@ protected:
 	Common::Array<uint16> _indexData;
 
 	BaseArray<Math::Matrix4 *> _boneMatrices;
+	// bone (or parent frame) matrices the vertex data was last computed from,
+	// used to skip skinning when the pose did not change since the last update
+	BaseArray<Math::Matrix4> _skinnedMatrices;
+	BaseArray<Math::Matrix4> _finalBoneMatrices;
+	bool _skinnedValid;
+	// set whenever update() rewrote _vertexData, so renderers keeping a copy
+	// of the vertices on the GPU know when to upload them again
+	bool _vertexDataDirty;
 	BaseArray<SkinWeights> skinWeightsList;
 
 	Common::Array<uint32> _adjacency;
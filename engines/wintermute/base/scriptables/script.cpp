@@ -57,6 +57,7 @@ ScScript::ScScript(BaseGame *inGame, ScEngine *engine) : BaseClass(inGame) {
 	_currentLine = 0;
 
 	_symbols = nullptr;
+	_symbolNames = nullptr;
 	_numSymbols = 0;
 
 	_engine = engine;
@@ -188,6 +189,10 @@ bool ScScript::initTables() {
 		uint32 index = getDWORD();
 		_symbols[index] = getString();
 	}
+	_symbolNames = new Common::String[_numSymbols];
+	for (uint32 i = 0; i < _numSymbols; i++) {
+		_symbolNames[i] = _symbols[i];
+	}
 
 	// load functions table
 	_iP = _header.funcTable;
@@ -409,6 +414,8 @@ void ScScript::cleanup() {
 		delete[] _symbols;
 	}
 	_symbols = nullptr;
+	delete[] _symbolNames;
+	_symbolNames = nullptr;
 	_numSymbols = 0;
 
 	if (_globals && !_thread) {
@@ -556,6 +563,22 @@ uint32 ScScript::decodeAltOpcodes(uint32 inst) {
 }
 #endif
 
+//////////////////////////////////////////////////////////////////////////
+// Operands that hold a number by value, not through a reference or a native
+// object, let arithmetic and comparisons skip the generic ScValue conversions
+static inline bool isPlainInt(const ScValue *val) {
+	return val && val->_type == VAL_INT;
+}
+
+static inline bool isPlainFloat(const ScValue *val) {
+	return val && val->_type == VAL_FLOAT;
+}
+
+// Same ordering as ScValue::compare() gives for floats
+static inline int compareFloats(double val1, double val2) {
+	return (val1 < val2) ? -1 : (val1 > val2) ? 1 : 0;
+}
+
 //////////////////////////////////////////////////////////////////////////
 bool ScScript::executeInstruction() {
 	bool ret = STATUS_OK;
@@ -755,7 +778,7 @@ bool ScScript::executeInstruction() {
 		break;
 
 	case II_PUSH_VAR: {
-		ScValue *var = getVar(_symbols[getDWORD()]);
+		ScValue *var = getVar(_symbolNames[getDWORD()]);
 		if (false && /*var->_type==VAL_OBJECT ||*/ var->_type == VAL_NATIVE) {
 			_operand->setReference(var);
 			_stack->push(_operand);
@@ -766,15 +789,14 @@ bool ScScript::executeInstruction() {
 	}
 
 	case II_PUSH_VAR_REF: {
-		ScValue *var = getVar(_symbols[getDWORD()]);
+		ScValue *var = getVar(_symbolNames[getDWORD()]);
 		_operand->setReference(var);
 		_stack->push(_operand);
 		break;
 	}
 
 	case II_POP_VAR: {
-		char *varName = _symbols[getDWORD()];
-		ScValue *var = getVar(varName);
+		ScValue *var = getVar(_symbolNames[getDWORD()]);
 		if (var) {
 			ScValue *val = _stack->pop();
 			if (!val) {
@@ -827,7 +849,7 @@ bool ScScript::executeInstruction() {
 		break;
 
 	case II_PUSH_THIS:
-		_operand->setReference(getVar(_symbols[getDWORD()]));
+		_operand->setReference(getVar(_symbolNames[getDWORD()]));
 		_thisStack->push(_operand);
 		break;
 
@@ -892,6 +914,15 @@ bool ScScript::executeInstruction() {
 		op2 = _stack->pop();
 		op1 = _stack->pop();
 
+		if (isPlainInt(op1) && isPlainInt(op2)) {
+			_stack->pushInt(op1->getInt() + op2->getInt());
+			break;
+		}
+		if (isPlainFloat(op1) && isPlainFloat(op2)) {
+			_stack->pushFloat(op1->getFloat() + op2->getFloat());
+			break;
+		}
+
 		if (op1->isNULL() || op2->isNULL()) {
 			_operand->setNULL();
 		} else if (op1->getType() == VAL_STRING || op2->getType() == VAL_STRING) {
@@ -914,6 +945,15 @@ bool ScScript::executeInstruction() {
 		op2 = _stack->pop();
 		op1 = _stack->pop();
 
+		if (isPlainInt(op1) && isPlainInt(op2)) {
+			_stack->pushInt(op1->getInt() - op2->getInt());
+			break;
+		}
+		if (isPlainFloat(op1) && isPlainFloat(op2)) {
+			_stack->pushFloat(op1->getFloat() - op2->getFloat());
+			break;
+		}
+
 		if (op1->isNULL() || op2->isNULL()) {
 			_operand->setNULL();
 		} else if (op1->getType() == VAL_INT && op2->getType() == VAL_INT) {
@@ -930,6 +970,15 @@ bool ScScript::executeInstruction() {
 		op2 = _stack->pop();
 		op1 = _stack->pop();
 
+		if (isPlainInt(op1) && isPlainInt(op2)) {
+			_stack->pushInt(op1->getInt() * op2->getInt());
+			break;
+		}
+		if (isPlainFloat(op1) && isPlainFloat(op2)) {
+			_stack->pushFloat(op1->getFloat() * op2->getFloat());
+			break;
+		}
+
 		if (op1->isNULL() || op2->isNULL()) {
 			_operand->setNULL();
 		} else if (op1->getType() == VAL_INT && op2->getType() == VAL_INT) {
@@ -1018,6 +1067,15 @@ bool ScScript::executeInstruction() {
 		op2 = _stack->pop();
 		op1 = _stack->pop();
 
+		if (isPlainInt(op1) && isPlainInt(op2)) {
+			_stack->pushBool(op1->getInt() == op2->getInt());
+			break;
+		}
+		if (isPlainFloat(op1) && isPlainFloat(op2)) {
+			_stack->pushBool(compareFloats(op1->getFloat(), op2->getFloat()) == 0);
+			break;
+		}
+
 		/*
 		if ((op1->isNULL() && !op2->isNULL()) || (!op1->isNULL() && op2->isNULL())) _operand->setBool(false);
 		else if (op1->isNative() && op2->isNative()) {
@@ -1042,6 +1100,15 @@ bool ScScript::executeInstruction() {
 		op2 = _stack->pop();
 		op1 = _stack->pop();
 
+		if (isPlainInt(op1) && isPlainInt(op2)) {
+			_stack->pushBool(op1->getInt() != op2->getInt());
+			break;
+		}
+		if (isPlainFloat(op1) && isPlainFloat(op2)) {
+			_stack->pushBool(compareFloats(op1->getFloat(), op2->getFloat()) != 0);
+			break;
+		}
+
 		/*
 		if ((op1->isNULL() && !op2->isNULL()) || (!op1->isNULL() && op2->isNULL())) _operand->setBool(true);
 		else if (op1->isNative() && op2->isNative()) {
@@ -1066,6 +1133,15 @@ bool ScScript::executeInstruction() {
 		op2 = _stack->pop();
 		op1 = _stack->pop();
 
+		if (isPlainInt(op1) && isPlainInt(op2)) {
+			_stack->pushBool(op1->getInt() < op2->getInt());
+			break;
+		}
+		if (isPlainFloat(op1) && isPlainFloat(op2)) {
+			_stack->pushBool(compareFloats(op1->getFloat(), op2->getFloat()) < 0);
+			break;
+		}
+
 		/*
 		if (op1->getType()==VAL_FLOAT && op2->getType()==VAL_FLOAT) {
 		    _operand->setBool(op1->getFloat() < op2->getFloat());
@@ -1081,6 +1157,15 @@ bool ScScript::executeInstruction() {
 		op2 = _stack->pop();
 		op1 = _stack->pop();
 
+		if (isPlainInt(op1) && isPlainInt(op2)) {
+			_stack->pushBool(op1->getInt() > op2->getInt());
+			break;
+		}
+		if (isPlainFloat(op1) && isPlainFloat(op2)) {
+			_stack->pushBool(compareFloats(op1->getFloat(), op2->getFloat()) > 0);
+			break;
+		}
+
 		/*
 		if (op1->getType()==VAL_FLOAT && op2->getType()==VAL_FLOAT) {
 		    _operand->setBool(op1->getFloat() > op2->getFloat());
@@ -1096,6 +1181,15 @@ bool ScScript::executeInstruction() {
 		op2 = _stack->pop();
 		op1 = _stack->pop();
 
+		if (isPlainInt(op1) && isPlainInt(op2)) {
+			_stack->pushBool(op1->getInt() <= op2->getInt());
+			break;
+		}
+		if (isPlainFloat(op1) && isPlainFloat(op2)) {
+			_stack->pushBool(compareFloats(op1->getFloat(), op2->getFloat()) <= 0);
+			break;
+		}
+
 		/*
 		if (op1->getType()==VAL_FLOAT && op2->getType()==VAL_FLOAT) {
 		    _operand->setBool(op1->getFloat() <= op2->getFloat());
@@ -1111,6 +1205,15 @@ bool ScScript::executeInstruction() {
 		op2 = _stack->pop();
 		op1 = _stack->pop();
 
+		if (isPlainInt(op1) && isPlainInt(op2)) {
+			_stack->pushBool(op1->getInt() >= op2->getInt());
+			break;
+		}
+		if (isPlainFloat(op1) && isPlainFloat(op2)) {
+			_stack->pushBool(compareFloats(op1->getFloat(), op2->getFloat()) >= 0);
+			break;
+		}
+
 		/*
 		if (op1->getType()==VAL_FLOAT && op2->getType()==VAL_FLOAT) {
 		    _operand->setBool(op1->getFloat() >= op2->getFloat());
@@ -1186,40 +1289,38 @@ uint32 ScScript::getMethodPos(const Common::String &name) const {
 
 //////////////////////////////////////////////////////////////////////////
 ScValue *ScScript::getVar(char *name) {
+	return getVar(Common::String(name));
+}
+
+ScValue *ScScript::getVar(const Common::String &name) {
 	ScValue *ret = nullptr;
 
 	// scope locals
 	if (_scopeStack->_sP >= 0) {
-		if (_scopeStack->getTop()->propExists(name)) {
-			ret = _scopeStack->getTop()->getProp(name);
-		}
+		ret = _scopeStack->getTop()->findProp(name);
 	}
 
 	// script globals
 	if (ret == nullptr) {
-		if (_globals->propExists(name)) {
-			ret = _globals->getProp(name);
-		}
+		ret = _globals->findProp(name);
 	}
 
 	// engine globals
 	if (ret == nullptr) {
-		if (_engine->_globals->propExists(name)) {
-			ret = _engine->_globals->getProp(name);
-		}
+		ret = _engine->_globals->findProp(name);
 	}
 
 	if (ret == nullptr) {
 		//RuntimeError("Variable '%s' is inaccessible in the current block. Consider changing the script.", name);
-		_gameRef->LOG(0, "Warning: variable '%s' is inaccessible in the current block. Consider changing the script (script:%s, line:%d)", name, _filename, _currentLine);
+		_gameRef->LOG(0, "Warning: variable '%s' is inaccessible in the current block. Consider changing the script (script:%s, line:%d)", name.c_str(), _filename, _currentLine);
 		ScValue *val = new ScValue(_gameRef);
 		ScValue *scope = _scopeStack->getTop();
 		if (scope) {
-			scope->setProp(name, val);
-			ret = _scopeStack->getTop()->getProp(name);
+			scope->setProp(name.c_str(), val);
+			ret = _scopeStack->getTop()->getProp(name.c_str());
 		} else {
-			_globals->setProp(name, val);
-			ret = _globals->getProp(name);
+			_globals->setProp(name.c_str(), val);
+			ret = _globals->getProp(name.c_str());
 		}
 		delete val;
 	}
@@ -83,6 +83,9 @@ public:
 	bool isObject();
 	bool setProp(const char *name, ScValue *val, bool copyWhole = false, bool setAsConst = false);
 	ScValue *getProp(const char *name);
+	// Returns an existing property of an object value, or nullptr; unlike getProp,
+	// this does not look at native object or string properties
+	ScValue *findProp(const Common::String &name);
 	BaseScriptable *_valNative;
 	ScValue *_valRef;
 private:
@@ -23,6 +23,8 @@
 #include "engines/wintermute/debugger.h"
 #include "engines/wintermute/base/base_engine.h"
 #include "engines/wintermute/base/base_file_manager.h"
+#include "engines/wintermute/base/base_game.h"
+#include "engines/wintermute/base/base_surface_storage.h"
 #include "engines/wintermute/base/scriptables/script_value.h"
 #include "engines/wintermute/debugger/debugger_controller.h"
 #include "engines/wintermute/wintermute.h"
@@ -34,6 +36,7 @@ namespace Wintermute {
 Console::Console(WintermuteEngine *vm) : GUI::Debugger(), _engineRef(vm) {
 	registerCmd("show_fps", WRAP_METHOD(Console, Cmd_ShowFps));
 	registerCmd("dump_file", WRAP_METHOD(Console, Cmd_DumpFile));
+	registerCmd("surface_cache", WRAP_METHOD(Console, Cmd_SurfaceCache));
 	registerCmd("show_fps", WRAP_METHOD(Console, Cmd_ShowFps));
 	registerCmd("dump_file", WRAP_METHOD(Console, Cmd_DumpFile));
 	registerCmd("help", WRAP_METHOD(Console, Cmd_Help));
@@ -308,6 +311,28 @@ bool Console::Cmd_ShowFps(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::Cmd_SurfaceCache(int argc, const char **argv) {
+	BaseGame *game = BaseEngine::instance().getGameRef();
+	if (!game || !game->_surfaceStorage) {
+		debugPrintf("No game is running\n");
+		return true;
+	}
+
+	BaseSurfaceStorage *storage = game->_surfaceStorage;
+	if (argc == 2 && Common::String(argv[1]) == "reset") {
+		storage->resetStats();
+	} else if (argc != 1) {
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	const BaseSurfaceStorage::Stats &stats = storage->getStats();
+	debugPrintf("Surfaces: %d, loaded: %d KB, budget: %d KB\n", storage->_surfaces.size(),
+	            storage->getLoadedSize() / 1024, storage->getBudget() / 1024);
+	debugPrintf("Hits: %d, misses: %d, evictions: %d\n", stats._hits, stats._misses, stats._evictions);
+	return true;
+}
+
 bool Console::Cmd_DumpFile(int argc, const char **argv) {
 	if (argc != 3) {
 		debugPrintf("Usage: %s <file path> <output file name>\n", argv[0]);
@@ -33,6 +33,14 @@
 #include "common/math.h"
 #include "common/rect.h"
 
+#if defined(__SSE2__)
+#define USE_CONVERSION_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define USE_CONVERSION_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Graphics {
 
 // TODO: YUV to RGB conversion function
@@ -170,6 +178,225 @@ inline void crossBlitLogic3BppSource(byte *dst, const byte *src, const uint w, c
 	}
 }
 
+#if defined(USE_CONVERSION_SSE2) || defined(USE_CONVERSION_NEON)
+
+/**
+ * Converts one color component the way colorToARGB and ARGBToColor do,
+ * without branching on the number of bits, so that it can be vectorised.
+ *
+ * Expanding an n bit component to 8 bits by repeating its bits is the same
+ * as multiplying it, and then shifting it right for less than 4 bits.
+ */
+struct ComponentConversion {
+	uint32 shift;      ///< Shift of the component in the source format
+	uint32 mask;       ///< Mask of the component, after shifting it down
+	uint32 multiplier; ///< Factor repeating the component's bits
+	uint32 reduce;     ///< Right shift dropping the repeated bits beyond 8, and the bits the destination lacks
+	uint32 dstShift;   ///< Shift of the component in the destination format
+};
+
+struct FormatConversion {
+	ComponentConversion components[4];
+	uint count;
+	uint32 constant;   ///< Opaque alpha, for a source without alpha
+};
+
+void setupFormatConversion(FormatConversion &conv, const PixelFormat &srcFmt, const PixelFormat &dstFmt) {
+	static const uint32 multipliers[8] = { 0xFF, 0x55, 0x49, 0x11, 0x21, 0x41, 0x81, 0x01 };
+	static const uint32 shifts[8] = { 0, 0, 1, 0, 2, 4, 6, 0 };
+
+	const byte srcBits[4] = { srcFmt.aBits(), srcFmt.rBits(), srcFmt.gBits(), srcFmt.bBits() };
+	const byte srcShifts[4] = { srcFmt.aShift, srcFmt.rShift, srcFmt.gShift, srcFmt.bShift };
+	const byte dstLoss[4] = { dstFmt.aLoss, dstFmt.rLoss, dstFmt.gLoss, dstFmt.bLoss };
+	const byte dstShifts[4] = { dstFmt.aShift, dstFmt.rShift, dstFmt.gShift, dstFmt.bShift };
+
+	conv.count = 0;
+	conv.constant = 0;
+	for (int i = 0; i < 4; ++i) {
+		// Components missing in the destination are dropped
+		if (dstLoss[i] >= 8)
+			continue;
+
+		// Missing alpha is opaque, missing colors are black
+		if (!srcBits[i]) {
+			if (i == 0)
+				conv.constant |= (0xFF >> dstLoss[i]) << dstShifts[i];
+			continue;
+		}
+
+		ComponentConversion &comp = conv.components[conv.count++];
+		comp.shift = srcShifts[i];
+		comp.mask = (1 << srcBits[i]) - 1;
+		comp.multiplier = multipliers[srcBits[i] - 1];
+		comp.reduce = shifts[srcBits[i] - 1] + dstLoss[i];
+		comp.dstShift = dstShifts[i];
+	}
+}
+
+inline uint32 convertColor(const FormatConversion &conv, uint32 color) {
+	uint32 result = conv.constant;
+	for (uint i = 0; i < conv.count; ++i) {
+		const ComponentConversion &comp = conv.components[i];
+		result |= ((((color >> comp.shift) & comp.mask) * comp.multiplier) >> comp.reduce) << comp.dstShift;
+	}
+	return result;
+}
+
+#ifdef USE_CONVERSION_SSE2
+
+typedef __m128i ColorVector;
+
+/** The parameters of a FormatConversion, prepared for the vector unit. */
+struct VectorConversion {
+	__m128i shift[4], mask[4], multiplier[4], reduce[4], dstShift[4];
+	__m128i constant;
+	uint count;
+
+	explicit VectorConversion(const FormatConversion &conv) : count(conv.count) {
+		for (uint i = 0; i < count; ++i) {
+			shift[i] = _mm_cvtsi32_si128(conv.components[i].shift);
+			mask[i] = _mm_set1_epi32(conv.components[i].mask);
+			multiplier[i] = _mm_set1_epi32(conv.components[i].multiplier);
+			reduce[i] = _mm_cvtsi32_si128(conv.components[i].reduce);
+			dstShift[i] = _mm_cvtsi32_si128(conv.components[i].dstShift);
+		}
+		constant = _mm_set1_epi32(conv.constant);
+	}
+
+	inline __m128i convert(__m128i colors) const {
+		__m128i result = constant;
+		for (uint i = 0; i < count; ++i) {
+			__m128i comp = _mm_and_si128(_mm_srl_epi32(colors, shift[i]), mask[i]);
+			// The product fits into 16 bits, so a 16 bit multiplication suffices
+			comp = _mm_mullo_epi16(comp, multiplier[i]);
+			comp = _mm_sll_epi32(_mm_srl_epi32(comp, reduce[i]), dstShift[i]);
+			result = _mm_or_si128(result, comp);
+		}
+		return result;
+	}
+};
+
+inline void loadColors(const uint32 *src, __m128i &lo, __m128i &hi) {
+	lo = _mm_loadu_si128((const __m128i *)src);
+	hi = _mm_loadu_si128((const __m128i *)(src + 4));
+}
+
+inline void loadColors(const uint16 *src, __m128i &lo, __m128i &hi) {
+	const __m128i in = _mm_loadu_si128((const __m128i *)src);
+	lo = _mm_unpacklo_epi16(in, _mm_setzero_si128());
+	hi = _mm_unpackhi_epi16(in, _mm_setzero_si128());
+}
+
+inline void storeColors(uint32 *dst, __m128i lo, __m128i hi) {
+	_mm_storeu_si128((__m128i *)dst, lo);
+	_mm_storeu_si128((__m128i *)(dst + 4), hi);
+}
+
+inline void storeColors(uint16 *dst, __m128i lo, __m128i hi) {
+	// Sign extend, so that the saturating pack keeps all 16 bits
+	lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+	hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+	_mm_storeu_si128((__m128i *)dst, _mm_packs_epi32(lo, hi));
+}
+
+#else
+
+typedef uint32x4_t ColorVector;
+
+/** The parameters of a FormatConversion, prepared for the vector unit. */
+struct VectorConversion {
+	int32x4_t shift[4], reduce[4], dstShift[4];
+	uint32x4_t mask[4], multiplier[4];
+	uint32x4_t constant;
+	uint count;
+
+	explicit VectorConversion(const FormatConversion &conv) : count(conv.count) {
+		for (uint i = 0; i < count; ++i) {
+			// NEON shifts right by shifting left by a negative amount
+			shift[i] = vdupq_n_s32(-(int32)conv.components[i].shift);
+			mask[i] = vdupq_n_u32(conv.components[i].mask);
+			multiplier[i] = vdupq_n_u32(conv.components[i].multiplier);
+			reduce[i] = vdupq_n_s32(-(int32)conv.components[i].reduce);
+			dstShift[i] = vdupq_n_s32(conv.components[i].dstShift);
+		}
+		constant = vdupq_n_u32(conv.constant);
+	}
+
+	inline uint32x4_t convert(uint32x4_t colors) const {
+		uint32x4_t result = constant;
+		for (uint i = 0; i < count; ++i) {
+			uint32x4_t comp = vandq_u32(vshlq_u32(colors, shift[i]), mask[i]);
+			comp = vmulq_u32(comp, multiplier[i]);
+			comp = vshlq_u32(vshlq_u32(comp, reduce[i]), dstShift[i]);
+			result = vorrq_u32(result, comp);
+		}
+		return result;
+	}
+};
+
+inline void loadColors(const uint32 *src, uint32x4_t &lo, uint32x4_t &hi) {
+	lo = vld1q_u32(src);
+	hi = vld1q_u32(src + 4);
+}
+
+inline void loadColors(const uint16 *src, uint32x4_t &lo, uint32x4_t &hi) {
+	const uint16x8_t in = vld1q_u16(src);
+	lo = vmovl_u16(vget_low_u16(in));
+	hi = vmovl_u16(vget_high_u16(in));
+}
+
+inline void storeColors(uint32 *dst, uint32x4_t lo, uint32x4_t hi) {
+	vst1q_u32(dst, lo);
+	vst1q_u32(dst + 4, hi);
+}
+
+inline void storeColors(uint16 *dst, uint32x4_t lo, uint32x4_t hi) {
+	vst1q_u16(dst, vcombine_u16(vmovn_u32(lo), vmovn_u32(hi)));
+}
+
+#endif
+
+/**
+ * Converts rows of 2 and 4 byte pixels eight at a time. Going backward,
+ * i.e. from the last row and pixel to the first, the pixels still to be
+ * read are never overwritten when converting in place to a bigger format.
+ */
+template<typename SrcColor, typename DstColor, bool backward>
+void crossBlitLogicVector(byte *dst, const byte *src, const uint w, const uint h,
+						  const PixelFormat &srcFmt, const PixelFormat &dstFmt,
+						  const uint srcPitch, const uint dstPitch) {
+	FormatConversion conv;
+	setupFormatConversion(conv, srcFmt, dstFmt);
+	const VectorConversion vconv(conv);
+
+	const uint vectorW = w & ~7;
+
+	for (uint i = 0; i < h; ++i) {
+		const uint y = backward ? h - 1 - i : i;
+		const SrcColor *srcRow = (const SrcColor *)(src + y * srcPitch);
+		DstColor *dstRow = (DstColor *)(dst + y * dstPitch);
+
+		if (backward) {
+			for (uint x = w; x > vectorW; --x)
+				dstRow[x - 1] = convertColor(conv, srcRow[x - 1]);
+		}
+
+		for (uint j = 0; j < vectorW; j += 8) {
+			const uint x = backward ? vectorW - 8 - j : j;
+			ColorVector lo, hi;
+			loadColors(srcRow + x, lo, hi);
+			storeColors(dstRow + x, vconv.convert(lo), vconv.convert(hi));
+		}
+
+		if (!backward) {
+			for (uint x = vectorW; x < w; ++x)
+				dstRow[x] = convertColor(conv, srcRow[x]);
+		}
+	}
+}
+
+#endif
+
 } // End of anonymous namespace
 
 // Function to blit a rect from one color format to another
@@ -189,6 +416,23 @@ bool crossBlit(byte *dst, const byte *src,
 		return true;
 	}
 
+#if defined(USE_CONVERSION_SSE2) || defined(USE_CONVERSION_NEON)
+	// Convert eight pixels at a time, except for the rare 3Bpp source
+	if (srcFmt.bytesPerPixel == 2 && dstFmt.bytesPerPixel == 2) {
+		crossBlitLogicVector<uint16, uint16, false>(dst, src, w, h, srcFmt, dstFmt, srcPitch, dstPitch);
+		return true;
+	} else if (srcFmt.bytesPerPixel == 2 && dstFmt.bytesPerPixel == 4) {
+		crossBlitLogicVector<uint16, uint32, true>(dst, src, w, h, srcFmt, dstFmt, srcPitch, dstPitch);
+		return true;
+	} else if (srcFmt.bytesPerPixel == 4 && dstFmt.bytesPerPixel == 2) {
+		crossBlitLogicVector<uint32, uint16, false>(dst, src, w, h, srcFmt, dstFmt, srcPitch, dstPitch);
+		return true;
+	} else if (srcFmt.bytesPerPixel == 4 && dstFmt.bytesPerPixel == 4) {
+		crossBlitLogicVector<uint32, uint32, false>(dst, src, w, h, srcFmt, dstFmt, srcPitch, dstPitch);
+		return true;
+	}
+#endif
+
 	// Faster, but larger, to provide optimized handling for each case.
 	const uint srcDelta = (srcPitch - w * srcFmt.bytesPerPixel);
 	const uint dstDelta = (dstPitch - w * dstFmt.bytesPerPixel);
@@ -232,6 +476,98 @@ bool crossBlit(byte *dst, const byte *src,
 
 namespace {
 
+template<typename DstColor, bool backward>
+inline void crossBlitMapLogic(byte *dst, const byte *src, const uint w, const uint h,
+							  const uint srcDelta, const uint dstDelta, const uint32 *map) {
+	for (uint y = 0; y < h; ++y) {
+		for (uint x = 0; x < w; ++x) {
+			*(DstColor *)dst = map[*src];
+
+			if (backward) {
+				src -= 1;
+				dst -= sizeof(DstColor);
+			} else {
+				src += 1;
+				dst += sizeof(DstColor);
+			}
+		}
+
+		if (backward) {
+			src -= srcDelta;
+			dst -= dstDelta;
+		} else {
+			src += srcDelta;
+			dst += dstDelta;
+		}
+	}
+}
+
+template<bool backward>
+inline void crossBlitMapLogic3BppDest(byte *dst, const byte *src, const uint w, const uint h,
+									  const uint srcDelta, const uint dstDelta, const uint32 *map) {
+	for (uint y = 0; y < h; ++y) {
+		for (uint x = 0; x < w; ++x) {
+			WRITE_UINT24(dst, map[*src]);
+
+			if (backward) {
+				src -= 1;
+				dst -= 3;
+			} else {
+				src += 1;
+				dst += 3;
+			}
+		}
+
+		if (backward) {
+			src -= srcDelta;
+			dst -= dstDelta;
+		} else {
+			src += srcDelta;
+			dst += dstDelta;
+		}
+	}
+}
+
+} // End of anonymous namespace
+
+void convertPaletteToMap(uint32 *dst, const byte *src, uint colors, const Graphics::PixelFormat &format) {
+	for (uint i = 0; i < colors; ++i, src += 3)
+		dst[i] = format.RGBToColor(src[0], src[1], src[2]);
+}
+
+// Function to blit a rect from a palette based format to another
+bool crossBlitMap(byte *dst, const byte *src,
+				  const uint dstPitch, const uint srcPitch,
+				  const uint w, const uint h,
+				  const uint bytesPerPixel, const uint32 *map) {
+	// Faster, but larger, to provide optimized handling for each case.
+	const uint srcDelta = (srcPitch - w);
+	const uint dstDelta = (dstPitch - w * bytesPerPixel);
+
+	if (bytesPerPixel == 1) {
+		crossBlitMapLogic<uint8, false>(dst, src, w, h, srcDelta, dstDelta, map);
+		return true;
+	}
+
+	// We need to blit the surface from bottom right to top left here, so
+	// that converting within the same buffer does not overwrite the source.
+	dst += h * dstPitch - dstDelta - bytesPerPixel;
+	src += h * srcPitch - srcDelta - 1;
+
+	if (bytesPerPixel == 2) {
+		crossBlitMapLogic<uint16, true>(dst, src, w, h, srcDelta, dstDelta, map);
+	} else if (bytesPerPixel == 3) {
+		crossBlitMapLogic3BppDest<true>(dst, src, w, h, srcDelta, dstDelta, map);
+	} else if (bytesPerPixel == 4) {
+		crossBlitMapLogic<uint32, true>(dst, src, w, h, srcDelta, dstDelta, map);
+	} else {
+		return false;
+	}
+	return true;
+}
+
+namespace {
+
 template <typename Size>
 void scaleNN(byte *dst, const byte *src,
 			   const uint dstPitch, const uint srcPitch,
@@ -242,7 +578,15 @@ void scaleNN(byte *dst, const byte *src,
 	const uint dstDelta = (dstPitch - dstW * sizeof(Size));
 
 	for (uint y = 0; y < dstH; y++) {
-		const Size *srcP = (const Size *)(src + ((y * srcH) / dstH) * srcPitch);
+		const uint srcY = (y * srcH) / dstH;
+		// When enlarging, repeat the line drawn from the same source line
+		if (y > 0 && srcY == ((y - 1) * srcH) / dstH) {
+			memcpy(dst, dst - dstPitch, dstW * sizeof(Size));
+			dst += dstPitch;
+			continue;
+		}
+
+		const Size *srcP = (const Size *)(src + srcY * srcPitch);
 		for (uint x = 0; x < dstW; x++) {
 			int val = srcP[scaleCacheX[x]];
 			*(Size *)dst = val;
@@ -252,6 +596,17 @@ void scaleNN(byte *dst, const byte *src,
 	}
 }
 
+void copyScaleBlit(byte *dst, const byte *src,
+				   const uint dstPitch, const uint srcPitch,
+				   const uint w, const uint h,
+				   const uint bytesPerPixel) {
+	for (uint y = 0; y < h; y++) {
+		memcpy(dst, src, w * bytesPerPixel);
+		dst += dstPitch;
+		src += srcPitch;
+	}
+}
+
 } // End of anonymous namespace
 
 bool scaleBlit(byte *dst, const byte *src,
@@ -260,6 +615,11 @@ bool scaleBlit(byte *dst, const byte *src,
 			   const uint srcW, const uint srcH,
 			   const Graphics::PixelFormat &fmt) {
 
+	if (dstW == srcW && dstH == srcH && fmt.bytesPerPixel >= 1 && fmt.bytesPerPixel <= 4) {
+		copyScaleBlit(dst, src, dstPitch, srcPitch, dstW, dstH, fmt.bytesPerPixel);
+		return true;
+	}
+
 	int *scaleCacheX = new int[dstW];
 	for (uint x = 0; x < dstW; x++) {
 		scaleCacheX[x] = (x * srcW) / dstW;
@@ -355,6 +715,70 @@ Size scaleBlitBilinearInterpolate(Size c01, Size c00, Size c11, Size c10, int ex
 	return fmt.ARGBToColorT<ColorMask>(dp_a, dp_r, dp_g, dp_b);
 }
 
+#if defined(USE_CONVERSION_SSE2) || defined(USE_CONVERSION_NEON)
+
+/**
+ * Stands for 32 bit formats with four 8 bit components, which are
+ * interpolated byte by byte with vector instructions.
+ */
+struct ByteComponents {};
+
+inline bool hasByteComponents(const Graphics::PixelFormat &fmt) {
+	return fmt.bytesPerPixel == 4 && fmt.aBits() == 8 && fmt.rBits() == 8 && fmt.gBits() == 8 && fmt.bBits() == 8;
+}
+
+#ifdef USE_CONVERSION_SSE2
+
+/** (d * e) >> 16 for signed d and unsigned e, from the signed high half. */
+inline __m128i mulFix16(__m128i d, __m128i e) {
+	return _mm_add_epi16(_mm_mulhi_epi16(d, e), _mm_and_si128(d, _mm_srai_epi16(e, 15)));
+}
+
+template <>
+uint32 scaleBlitBilinearInterpolate<ByteComponents, uint32>(uint32 c01, uint32 c00, uint32 c11, uint32 c10, int ex, int ey,
+															const Graphics::PixelFormat &fmt) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i mask = _mm_set1_epi16(0xff);
+
+	// The top line in the low half, the bottom line in the high half, so
+	// that both are interpolated horizontally at once
+	const __m128i left = _mm_unpacklo_epi8(_mm_unpacklo_epi32(_mm_cvtsi32_si128(c00), _mm_cvtsi32_si128(c10)), zero);
+	const __m128i right = _mm_unpacklo_epi8(_mm_unpacklo_epi32(_mm_cvtsi32_si128(c01), _mm_cvtsi32_si128(c11)), zero);
+	const __m128i t = _mm_and_si128(_mm_add_epi16(mulFix16(_mm_sub_epi16(right, left), _mm_set1_epi16((int16)ex)), left), mask);
+
+	const __m128i t2 = _mm_srli_si128(t, 8);
+	const __m128i dp = _mm_and_si128(_mm_add_epi16(mulFix16(_mm_sub_epi16(t2, t), _mm_set1_epi16((int16)ey)), t), mask);
+	return _mm_cvtsi128_si32(_mm_packus_epi16(dp, dp));
+}
+
+#else
+
+/** (d * e) >> 16 for signed d and unsigned e, in 32 bit lanes. */
+inline int16x4_t mulFix16(int16x4_t d, int e) {
+	return vmovn_s32(vshrq_n_s32(vmulq_s32(vmovl_s16(d), vdupq_n_s32(e)), 16));
+}
+
+template <>
+uint32 scaleBlitBilinearInterpolate<ByteComponents, uint32>(uint32 c01, uint32 c00, uint32 c11, uint32 c10, int ex, int ey,
+															const Graphics::PixelFormat &fmt) {
+	const int16x8_t mask = vdupq_n_s16(0xff);
+
+	// The top line in the low half, the bottom line in the high half, so
+	// that both are interpolated horizontally at once
+	const int16x8_t left = vreinterpretq_s16_u16(vmovl_u8(vcreate_u8(c00 | ((uint64)c10 << 32))));
+	const int16x8_t right = vreinterpretq_s16_u16(vmovl_u8(vcreate_u8(c01 | ((uint64)c11 << 32))));
+	const int16x8_t d = vsubq_s16(right, left);
+	const int16x8_t t = vandq_s16(vaddq_s16(vcombine_s16(mulFix16(vget_low_s16(d), ex), mulFix16(vget_high_s16(d), ex)), left), mask);
+
+	const int16x4_t t1 = vget_low_s16(t);
+	const int16x4_t dp = vand_s16(vadd_s16(mulFix16(vsub_s16(vget_high_s16(t), t1), ey), t1), vget_low_s16(mask));
+	return vget_lane_u32(vreinterpret_u32_u8(vmovn_u16(vreinterpretq_u16_s16(vcombine_s16(dp, dp)))), 0);
+}
+
+#endif
+
+#endif
+
 template <typename ColorMask, typename Size, bool flipx, bool flipy> // TODO: See mirroring comment in RenderTicket ctor
 void scaleBlitBilinearLogic(byte *dst, const byte *src,
 							const uint dstPitch, const uint srcPitch,
@@ -545,6 +969,12 @@ bool scaleBlitBilinear(byte *dst, const byte *src,
 	if (fmt.bytesPerPixel != 2 && fmt.bytesPerPixel != 4)
 		return false;
 
+	// The interpolation weights would all be 0
+	if (dstW == srcW && dstH == srcH) {
+		copyScaleBlit(dst, src, dstPitch, srcPitch, dstW, dstH, fmt.bytesPerPixel);
+		return true;
+	}
+
 	int *sax = new int[dstW + 1];
 	int *say = new int[dstH + 1];
 	assert(sax && say);
@@ -589,6 +1019,11 @@ bool scaleBlitBilinear(byte *dst, const byte *src,
 		}
 	}
 
+#if defined(USE_CONVERSION_SSE2) || defined(USE_CONVERSION_NEON)
+	if (hasByteComponents(fmt)) {
+		scaleBlitBilinearLogic<ByteComponents, uint32, false, false>(dst, src, dstPitch, srcPitch, dstW, dstH, srcW, srcH, fmt, sax, say);
+	} else
+#endif
 	if (fmt == createPixelFormat<8888>()) {
 		scaleBlitBilinearLogic<ColorMasks<8888>, uint32, false, false>(dst, src, dstPitch, srcPitch, dstW, dstH, srcW, srcH, fmt, sax, say);
 	} else if (fmt == createPixelFormat<888>()) {
@@ -642,6 +1077,11 @@ bool rotoscaleBlitBilinear(byte *dst, const byte *src,
 						   const Graphics::PixelFormat &fmt,
 						   const TransformStruct &transform,
 						   const Common::Point &newHotspot) {
+#if defined(USE_CONVERSION_SSE2) || defined(USE_CONVERSION_NEON)
+	if (hasByteComponents(fmt)) {
+		rotoscaleBlitLogic<ByteComponents, uint32, true, false, false>(dst, src, dstPitch, srcPitch, dstW, dstH, srcW, srcH, fmt, transform, newHotspot);
+	} else
+#endif
 	if (fmt == createPixelFormat<8888>()) {
 		rotoscaleBlitLogic<ColorMasks<8888>, uint32, true, false, false>(dst, src, dstPitch, srcPitch, dstW, dstH, srcW, srcH, fmt, transform, newHotspot);
 	} else if (fmt == createPixelFormat<888>()) {
@@ -118,6 +118,38 @@ bool crossBlit(byte *dst, const byte *src,
 			   const uint w, const uint h,
 			   const Graphics::PixelFormat &dstFmt, const Graphics::PixelFormat &srcFmt);
 
+/**
+ * Converts a palette to colors of a pixel format, e.g. for crossBlitMap.
+ *
+ * @param dst		the buffer which will recieve the colors
+ * @param src		the palette, with three bytes for red, green and blue per color
+ * @param colors	the number of colors to convert
+ * @param format	the pixel format of the colors
+ */
+void convertPaletteToMap(uint32 *dst, const byte *src, uint colors, const Graphics::PixelFormat &format);
+
+/**
+ * Blits a rectangle from a palette based format to another format, by
+ * looking up each source pixel in a map.
+ *
+ * @param dst			the buffer which will recieve the converted graphics data
+ * @param src			the buffer containing the original, 1Bpp graphics data
+ * @param dstPitch		width in bytes of one full line of the dest buffer
+ * @param srcPitch		width in bytes of one full line of the source buffer
+ * @param w				the width of the graphics data
+ * @param h				the height of the graphics data
+ * @param bytesPerPixel	the number of bytes per pixel of the destination
+ * @param map			the color in the destination format for each of the 256 source values
+ * @return				true if conversion completes successfully,
+ *						false if there is an error.
+ *
+ * @note Like crossBlit, this can convert a surface in place.
+ */
+bool crossBlitMap(byte *dst, const byte *src,
+				  const uint dstPitch, const uint srcPitch,
+				  const uint w, const uint h,
+				  const uint bytesPerPixel, const uint32 *map);
+
 bool scaleBlit(byte *dst, const byte *src,
 			   const uint dstPitch, const uint srcPitch,
 			   const uint dstW, const uint dstH,
@@ -0,0 +1,137 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "graphics/dirty_region.h"
+
+#include "common/algorithm.h"
+#include "common/util.h"
+
+namespace Graphics {
+
+DirtyRegion::DirtyRegion(int16 tileWidth, int16 tileHeight) :
+		_tileWidth(MAX<int16>(tileWidth, 1)), _tileHeight(MAX<int16>(tileHeight, 1)),
+		_fullUpdateThreshold(0), _columns(0), _rows(0), _dirtyTiles(0) {
+}
+
+void DirtyRegion::setBounds(const Common::Rect &bounds) {
+	if (bounds == _bounds)
+		return;
+
+	_bounds = bounds;
+	resize();
+}
+
+void DirtyRegion::setTileSize(int16 tileWidth, int16 tileHeight) {
+	_tileWidth = MAX<int16>(tileWidth, 1);
+	_tileHeight = MAX<int16>(tileHeight, 1);
+	resize();
+}
+
+void DirtyRegion::resize() {
+	_columns = (_bounds.width() + _tileWidth - 1) / _tileWidth;
+	_rows = (_bounds.height() + _tileHeight - 1) / _tileHeight;
+	_tiles.resize(_columns * _rows);
+	clear();
+}
+
+void DirtyRegion::clear() {
+	if (_dirtyTiles)
+		Common::fill(_tiles.begin(), _tiles.end(), 0);
+	_dirtyTiles = 0;
+}
+
+void DirtyRegion::addRect(const Common::Rect &r) {
+	Common::Rect area = r;
+	area.clip(_bounds);
+	if (area.isEmpty())
+		return;
+
+	const int left = (area.left - _bounds.left) / _tileWidth;
+	const int right = (area.right - _bounds.left + _tileWidth - 1) / _tileWidth;
+	const int top = (area.top - _bounds.top) / _tileHeight;
+	const int bottom = (area.bottom - _bounds.top + _tileHeight - 1) / _tileHeight;
+
+	for (int y = top; y < bottom; ++y) {
+		byte *tile = &_tiles[y * _columns + left];
+		for (int x = left; x < right; ++x, ++tile) {
+			_dirtyTiles += !*tile;
+			*tile = 1;
+		}
+	}
+}
+
+void DirtyRegion::getRects(Common::List<Common::Rect> &rects) const {
+	if (!_dirtyTiles)
+		return;
+
+	if (_fullUpdateThreshold && _dirtyTiles * 100 >= _fullUpdateThreshold * _columns * _rows) {
+		rects.push_back(_bounds);
+		return;
+	}
+
+	// Runs of dirty tiles, in tiles. The runs of the previous line are
+	// extended downwards as long as the same run is found on the next lines.
+	Common::Array<Common::Rect> done, open, next;
+
+	for (int y = 0; y <= _rows; ++y) {
+		const byte *line = y < _rows ? &_tiles[y * _columns] : nullptr;
+		uint prev = 0;
+		int x = 0;
+
+		while (line && x < _columns) {
+			if (!line[x]) {
+				++x;
+				continue;
+			}
+
+			const int start = x;
+			while (x < _columns && line[x])
+				++x;
+
+			// Both lines of runs are sorted by their left side
+			while (prev < open.size() && open[prev].left < start)
+				done.push_back(open[prev++]);
+
+			if (prev < open.size() && open[prev].left == start && open[prev].right == x) {
+				next.push_back(open[prev++]);
+				next.back().bottom = y + 1;
+			} else {
+				next.push_back(Common::Rect(start, y, x, y + 1));
+			}
+		}
+
+		while (prev < open.size())
+			done.push_back(open[prev++]);
+
+		open = next;
+		next.clear();
+	}
+
+	for (uint i = 0; i < done.size(); ++i) {
+		const Common::Rect &r = done[i];
+		rects.push_back(Common::Rect(_bounds.left + r.left * _tileWidth, _bounds.top + r.top * _tileHeight,
+		                             MIN<int>(_bounds.left + r.right * _tileWidth, _bounds.right),
+		                             MIN<int>(_bounds.top + r.bottom * _tileHeight, _bounds.bottom)));
+	}
+}
+
+} // End of namespace Graphics
@@ -0,0 +1,113 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef GRAPHICS_DIRTY_REGION_H
+#define GRAPHICS_DIRTY_REGION_H
+
+#include "common/array.h"
+#include "common/list.h"
+#include "common/rect.h"
+
+namespace Graphics {
+
+/**
+ * @defgroup graphics_dirty_region Dirty region
+ * @ingroup graphics
+ *
+ * @brief DirtyRegion class for coalescing dirty rectangles.
+ *
+ * @{
+ */
+
+/**
+ * Tracks the modified areas of a surface in a bitmap of tiles, so that any
+ * number of overlapping or adjacent rectangles can be turned into a small
+ * set of non-overlapping rectangles covering them.
+ *
+ * The rectangles returned cover whole tiles, clipped to the bounds, so they
+ * may include a few pixels around the areas marked dirty.
+ */
+class DirtyRegion {
+public:
+	DirtyRegion(int16 tileWidth = 8, int16 tileHeight = 8);
+
+	/**
+	 * Set the area covered by the region. This also clears the region,
+	 * unless the bounds are unchanged.
+	 */
+	void setBounds(const Common::Rect &bounds);
+	const Common::Rect &getBounds() const { return _bounds; }
+
+	/**
+	 * Set the size of the tiles. Smaller tiles follow the dirty areas more
+	 * closely, at the cost of more work when adding and returning rects.
+	 * This clears the region.
+	 */
+	void setTileSize(int16 tileWidth, int16 tileHeight);
+
+	/**
+	 * Set how many percent of the bounds must be dirty for getRects to
+	 * return a single rectangle covering the bounds. 0 disables this.
+	 */
+	void setFullUpdateThreshold(uint percent) { _fullUpdateThreshold = percent; }
+
+	/**
+	 * Mark an area as dirty. It is clipped to the bounds.
+	 */
+	void addRect(const Common::Rect &r);
+
+	/**
+	 * Mark the whole region as clean.
+	 */
+	void clear();
+
+	/**
+	 * Returns true if no area is marked dirty.
+	 */
+	bool empty() const { return _dirtyTiles == 0; }
+
+	/**
+	 * Append non-overlapping rectangles covering all dirty areas to a list.
+	 * Horizontal runs of dirty tiles are joined with identical runs on the
+	 * lines of tiles below them.
+	 */
+	void getRects(Common::List<Common::Rect> &rects) const;
+
+private:
+	void resize();
+
+	Common::Rect _bounds;
+	int16 _tileWidth, _tileHeight;
+	uint _fullUpdateThreshold;
+
+	/** Size of the bitmap, in tiles. */
+	int _columns, _rows;
+	/** One byte per tile, non-zero if it is dirty. */
+	Common::Array<byte> _tiles;
+	uint _dirtyTiles;
+};
+
+/** @} */
+
+} // End of namespace Graphics
+
+#endif
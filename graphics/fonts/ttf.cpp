@@ -39,6 +39,8 @@
 #include "common/stream.h"
 #include "common/memstream.h"
 #include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/list.h"
 #include "common/ptr.h"
 #include "common/unzip.h"
 
@@ -88,8 +90,23 @@ inline int divRoundToNearest(int dividend, int divisor) {
 	return (dividend + (divisor / 2)) / divisor;
 }
 
+// FNV-1a, to tell font files apart in the glyph cache
+uint32 hashFontFile(const uint8 *file, uint32 size) {
+	uint32 hash = 2166136261u;
+	for (uint32 i = 0; i < size; ++i)
+		hash = (hash ^ file[i]) * 16777619u;
+	return hash;
+}
+
 } // End of anonymous namespace
 
+struct TTFGlyph {
+	Surface image;
+	int xOffset, yOffset;
+	int advance;
+	FT_UInt slot;
+};
+
 class TTFLibrary : public Common::Singleton<TTFLibrary> {
 public:
 	TTFLibrary();
@@ -102,9 +119,41 @@ public:
 
 	bool loadFont(const uint8 *file, const int32 face_index, const uint32 size, FT_Face &face);
 	void closeFont(FT_Face &face);
+
+	/**
+	 * Look up a glyph rendered before by any font with the same face and
+	 * settings, and copy it into 'glyph'.
+	 */
+	bool findGlyph(const Common::String &key, TTFGlyph &glyph);
+
+	/**
+	 * Keep a copy of a rendered glyph, evicting the least recently used
+	 * glyphs when the "ttf_glyph_cache_size" budget is exceeded.
+	 */
+	void addGlyph(const Common::String &key, const TTFGlyph &glyph);
+
 private:
 	FT_Library _library;
 	bool _initialized;
+
+	struct CachedGlyph {
+		Common::String key;
+		TTFGlyph glyph;
+	};
+
+	typedef Common::List<CachedGlyph> GlyphList;
+	typedef Common::HashMap<Common::String, GlyphList::iterator> GlyphMap;
+
+	static void copyGlyph(TTFGlyph &dst, const TTFGlyph &src);
+	static uint32 getGlyphSize(const TTFGlyph &glyph);
+	void removeGlyph(GlyphMap::iterator it);
+
+	/** All cached glyphs, the most recently used first. */
+	GlyphList _glyphs;
+	GlyphMap _glyphIndex;
+
+	uint32 _glyphCacheSize;
+	const uint32 _maxGlyphCacheSize;
 };
 
 void shutdownTTF() {
@@ -113,12 +162,17 @@ void shutdownTTF() {
 
 #define g_ttf ::Graphics::TTFLibrary::instance()
 
-TTFLibrary::TTFLibrary() : _library(), _initialized(false) {
+TTFLibrary::TTFLibrary()
+	: _library(), _initialized(false), _glyphCacheSize(0),
+	  _maxGlyphCacheSize(MAX(ConfMan.getInt("ttf_glyph_cache_size"), 0) * 1024) {
 	if (!FT_Init_FreeType(&_library))
 		_initialized = true;
 }
 
 TTFLibrary::~TTFLibrary() {
+	for (GlyphList::iterator it = _glyphs.begin(); it != _glyphs.end(); ++it)
+		it->glyph.image.free();
+
 	if (_initialized) {
 		FT_Done_FreeType(_library);
 		_initialized = false;
@@ -137,6 +191,60 @@ void TTFLibrary::closeFont(FT_Face &face) {
 	FT_Done_Face(face);
 }
 
+bool TTFLibrary::findGlyph(const Common::String &key, TTFGlyph &glyph) {
+	GlyphMap::iterator it = _glyphIndex.find(key);
+	if (it == _glyphIndex.end())
+		return false;
+
+	// Mark the glyph as the most recently used
+	const CachedGlyph entry = *it->_value;
+	_glyphs.erase(it->_value);
+	_glyphs.push_front(entry);
+	it->_value = _glyphs.begin();
+
+	copyGlyph(glyph, entry.glyph);
+	return true;
+}
+
+void TTFLibrary::addGlyph(const Common::String &key, const TTFGlyph &glyph) {
+	const uint32 size = getGlyphSize(glyph);
+	if (size > _maxGlyphCacheSize)
+		return;
+
+	GlyphMap::iterator it = _glyphIndex.find(key);
+	if (it != _glyphIndex.end())
+		removeGlyph(it);
+
+	while (!_glyphs.empty() && _glyphCacheSize + size > _maxGlyphCacheSize)
+		removeGlyph(_glyphIndex.find(_glyphs.back().key));
+
+	CachedGlyph entry;
+	entry.key = key;
+	copyGlyph(entry.glyph, glyph);
+	_glyphs.push_front(entry);
+	_glyphIndex[key] = _glyphs.begin();
+	_glyphCacheSize += size;
+}
+
+void TTFLibrary::copyGlyph(TTFGlyph &dst, const TTFGlyph &src) {
+	dst.image.copyFrom(src.image);
+	dst.xOffset = src.xOffset;
+	dst.yOffset = src.yOffset;
+	dst.advance = src.advance;
+	dst.slot = src.slot;
+}
+
+uint32 TTFLibrary::getGlyphSize(const TTFGlyph &glyph) {
+	return glyph.image.pitch * glyph.image.h + sizeof(CachedGlyph);
+}
+
+void TTFLibrary::removeGlyph(GlyphMap::iterator it) {
+	_glyphCacheSize -= getGlyphSize(it->_value->glyph);
+	it->_value->glyph.image.free();
+	_glyphs.erase(it->_value);
+	_glyphIndex.erase(it);
+}
+
 class TTFFont : public Font {
 public:
 	TTFFont();
@@ -172,12 +280,7 @@ private:
 	int _width, _height;
 	int _ascent, _descent;
 
-	struct Glyph {
-		Surface image;
-		int xOffset, yOffset;
-		int advance;
-		FT_UInt slot;
-	};
+	typedef TTFGlyph Glyph;
 
 	bool cacheGlyph(Glyph &glyph, uint32 chr) const;
 	typedef Common::HashMap<uint32, Glyph> GlyphCache;
@@ -199,6 +302,9 @@ private:
 
 	bool _fakeBold;
 	bool _fakeItalic;
+
+	/** Identifies the face and settings in the glyph cache shared by all fonts. */
+	Common::String _glyphCacheKey;
 };
 
 TTFFont::TTFFont()
@@ -268,9 +374,11 @@ bool TTFFont::load(uint8 *ttfFile, uint32 sizeFile, int32 faceIndex, bool bold,
 		return false;
 	}
 
+	const int pointSize = computePointSize(size, sizeMode);
+
 	// Check if the fixed font has the requested size
 	if (!FT_IS_SCALABLE(_face)) {
-		FT_Pos reqsize = computePointSize(size, sizeMode) * 64;
+		FT_Pos reqsize = pointSize * 64;
 		bool found = false;
 
 		for (int i = 0; i < _face->num_fixed_sizes; i++)
@@ -304,7 +412,7 @@ bool TTFFont::load(uint8 *ttfFile, uint32 sizeFile, int32 faceIndex, bool bold,
 	// Check whether we have kerning support
 	_hasKerning = (FT_HAS_KERNING(_face) != 0);
 
-	if (FT_Set_Char_Size(_face, 0, computePointSize(size, sizeMode) * 64, dpi, dpi)) {
+	if (FT_Set_Char_Size(_face, 0, pointSize * 64, dpi, dpi)) {
 		g_ttf.closeFont(_face);
 
 		// Don't delete ttfFile as we return fail
@@ -368,6 +476,10 @@ bool TTFFont::load(uint8 *ttfFile, uint32 sizeFile, int32 faceIndex, bool bold,
 		_loadFlags |= FT_LOAD_NO_BITMAP;
 	}
 
+	_glyphCacheKey = Common::String::format("%08x:%u:%d:%d:%u:%x:%d:%d:%d:%d", hashFontFile(_ttfFile, _size), _size, faceIndex,
+	                                        pointSize, dpi, (uint)_loadFlags, (int)_renderMode,
+	                                        _fakeBold, _fakeItalic, stemDarkening);
+
 	if (!mapping) {
 		// Allow loading of all unicode characters.
 		_allowLateCaching = true;
@@ -750,6 +862,10 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 
 	glyph.slot = slot;
 
+	const Common::String key = Common::String::format("%s:%u", _glyphCacheKey.c_str(), slot);
+	if (g_ttf.findGlyph(key, glyph))
+		return true;
+
 	// We use the light target and render mode to improve the looks of the
 	// glyphs. It is most noticable in FreeSansBold.ttf, where otherwise the
 	// 't' glyph looks like it is cut off on the right side.
@@ -861,6 +977,7 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 	}
 #endif
 
+	g_ttf.addGlyph(key, glyph);
 	return true;
 }
 
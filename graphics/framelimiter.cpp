@@ -0,0 +1,168 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "graphics/framelimiter.h"
+
+#include "common/algorithm.h"
+#include "common/debug.h"
+#include "common/system.h"
+
+namespace Graphics {
+
+void FrameHistory::add(uint32 value) {
+	_values[_next] = value;
+	_next = (_next + 1) % kSize;
+	if (_count < kSize)
+		_count++;
+}
+
+uint32 FrameHistory::getPercentile(uint percentile) const {
+	if (!_count)
+		return 0;
+
+	uint32 sorted[kSize];
+	Common::copy(_values, _values + _count, sorted);
+	Common::sort(sorted, sorted + _count);
+
+	const uint rank = (MIN<uint>(percentile, 100) * _count + 99) / 100;
+	return sorted[MAX<uint>(rank, 1) - 1];
+}
+
+uint32 FrameHistory::getRecent(uint age) const {
+	assert(age < _count);
+	return _values[(_next + kSize - 1 - age) % kSize];
+}
+
+FrameLimiter::FrameLimiter(OSystem *system, uint framerate, bool deferToVsync) :
+		_system(system),
+		_deferToVsync(deferToVsync),
+		_isObserver(false),
+		_targetFrameDuration(framerate ? 1000 / framerate : 0),
+		_startFrameTime(0),
+		_lastFrameDuration(_targetFrameDuration),
+		_lastPresentTime(0),
+		_inputPending(false),
+		_inputTime(0),
+		_framesSinceLog(0) {
+	// Watch the input events to measure how long they take to be presented
+	Common::EventManager *eventMan = _system->getEventManager();
+	if (eventMan) {
+		eventMan->getEventDispatcher()->registerObserver(this, 2, false);
+		_isObserver = true;
+	}
+}
+
+FrameLimiter::~FrameLimiter() {
+	if (_isObserver)
+		_system->getEventManager()->getEventDispatcher()->unregisterObserver(this);
+}
+
+void FrameLimiter::startFrame() {
+	const uint32 currentTime = _system->getMillis();
+
+	if (_startFrameTime != 0) {
+		_lastFrameDuration = currentTime - _startFrameTime;
+	}
+
+	_startFrameTime = currentTime;
+}
+
+void FrameLimiter::delayBeforeSwap() {
+	if (!_targetFrameDuration)
+		return;
+
+	// With vsync, presenting the frame already waits for the display
+	if (_deferToVsync && _system->getFeatureState(OSystem::kFeatureVSync))
+		return;
+
+	const uint32 frameDuration = _system->getMillis() - _startFrameTime;
+	if (frameDuration < _targetFrameDuration) {
+		_system->delayMillis(_targetFrameDuration - frameDuration);
+	}
+}
+
+void FrameLimiter::present() {
+	delayBeforeSwap();
+	_system->updateScreen();
+	framePresented();
+}
+
+void FrameLimiter::framePresented() {
+	const uint32 currentTime = _system->getMillis(true);
+
+	if (_lastPresentTime != 0) {
+		_frameTimes.add(currentTime - _lastPresentTime);
+	}
+	_lastPresentTime = currentTime;
+
+	if (_inputPending) {
+		_inputLatencies.add(currentTime - _inputTime);
+		_inputPending = false;
+	}
+
+	if (++_framesSinceLog == FrameHistory::kSize) {
+		logStatistics();
+		_framesSinceLog = 0;
+	}
+}
+
+void FrameLimiter::pause(bool pause) {
+	if (!pause) {
+		// Make sure the frame durations are consistent when resuming
+		_startFrameTime = 0;
+		_lastPresentTime = 0;
+		_inputPending = false;
+	}
+}
+
+bool FrameLimiter::notifyEvent(const Common::Event &event) {
+	switch (event.type) {
+	case Common::EVENT_KEYDOWN:
+	case Common::EVENT_MOUSEMOVE:
+	case Common::EVENT_LBUTTONDOWN:
+	case Common::EVENT_RBUTTONDOWN:
+	case Common::EVENT_MBUTTONDOWN:
+	case Common::EVENT_WHEELUP:
+	case Common::EVENT_WHEELDOWN:
+	case Common::EVENT_JOYBUTTON_DOWN:
+	case Common::EVENT_CUSTOM_ENGINE_ACTION_START:
+		// Only the first input event of a frame waits the longest
+		if (!_inputPending) {
+			_inputPending = true;
+			_inputTime = _system->getMillis(true);
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	return false;
+}
+
+void FrameLimiter::logStatistics() const {
+	debug(5, "FrameLimiter: Frame time %u/%u/%u ms, input latency %u/%u/%u ms (50th/90th/99th percentiles)",
+	      _frameTimes.getPercentile(50), _frameTimes.getPercentile(90), _frameTimes.getPercentile(99),
+	      _inputLatencies.getPercentile(50), _inputLatencies.getPercentile(90), _inputLatencies.getPercentile(99));
+}
+
+} // End of namespace Graphics
@@ -0,0 +1,164 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef GRAPHICS_FRAMELIMITER_H
+#define GRAPHICS_FRAMELIMITER_H
+
+#include "common/events.h"
+
+class OSystem;
+
+namespace Graphics {
+
+/**
+ * @defgroup graphics_framelimiter Frame limiter
+ * @ingroup graphics
+ *
+ * @brief FrameLimiter class for pacing and measuring the frames of an engine.
+ *
+ * @{
+ */
+
+/**
+ * Keeps the most recent measurements of a frame statistic, in milliseconds,
+ * and reports percentiles over them.
+ */
+class FrameHistory {
+public:
+	/** Number of measurements kept. */
+	static const uint kSize = 128;
+
+	FrameHistory() : _next(0), _count(0) {}
+
+	void add(uint32 value);
+	void clear() { _next = _count = 0; }
+
+	/** Number of measurements currently kept, at most kSize. */
+	uint size() const { return _count; }
+
+	/**
+	 * Return the smallest kept measurement which is greater than or equal
+	 * to the given percentage of them, or 0 when there are none.
+	 * getPercentile(50) is the median, getPercentile(100) the maximum.
+	 */
+	uint32 getPercentile(uint percentile) const;
+
+	/**
+	 * Return a kept measurement by age, 0 being the most recent one and
+	 * size() - 1 the oldest one.
+	 */
+	uint32 getRecent(uint age) const;
+
+private:
+	uint32 _values[kSize];
+	uint _next, _count;
+};
+
+/**
+ * A frame rate limiter shared by engines.
+ *
+ * It makes sure the frame rate does not exceed the specified value by
+ * delaying until the time slot allocated to each frame is used up, which
+ * curbs CPU usage and gives a stable frame rate. When vsync is enabled,
+ * the delay is left to the backend presenting the frame.
+ *
+ * It also measures the time between presented frames, and the time from the
+ * first input event after a frame to the presentation of the next frame.
+ * These are reported as percentiles, and logged at debug level 5.
+ *
+ * A frame goes like this:
+ * @code
+ * limiter.startFrame();
+ * // Handle events and draw
+ * limiter.present(); // or delayBeforeSwap(), present another way, then framePresented()
+ * @endcode
+ */
+class FrameLimiter : public Common::EventObserver {
+public:
+	/**
+	 * @param system       The system used for timing and presenting.
+	 * @param framerate    The frame rate to limit to, 0 to not limit it.
+	 * @param deferToVsync Do not delay frames while vsync is enabled.
+	 */
+	FrameLimiter(OSystem *system, uint framerate, bool deferToVsync = true);
+	~FrameLimiter();
+
+	/** Mark the start of a frame. */
+	void startFrame();
+
+	/** Delay until the time slot of the current frame is used up. */
+	void delayBeforeSwap();
+
+	/** Delay as needed, update the screen and record its presentation. */
+	void present();
+
+	/** Record the presentation of a frame the engine updated itself. */
+	void framePresented();
+
+	/**
+	 * Pause or resume the measurements, so that the time spent paused
+	 * is not counted as the duration of a frame.
+	 */
+	void pause(bool pause);
+
+	/** Duration of a frame at the target frame rate, 0 when not limited. */
+	uint getTargetFrameDuration() const { return _targetFrameDuration; }
+
+	/** Time between the starts of the last two frames. */
+	uint getLastFrameDuration() const { return _lastFrameDuration; }
+
+	/** System time, in milliseconds, at which the last frame was presented. */
+	uint32 getLastPresentTime() const { return _lastPresentTime; }
+
+	/** Times between presented frames. */
+	const FrameHistory &getFrameTimes() const { return _frameTimes; }
+
+	/** Times from the first input event of a frame to its presentation. */
+	const FrameHistory &getInputLatencies() const { return _inputLatencies; }
+
+	bool notifyEvent(const Common::Event &event) override;
+
+private:
+	void logStatistics() const;
+
+	OSystem *_system;
+	bool _deferToVsync;
+	bool _isObserver;
+
+	uint _targetFrameDuration;
+	uint32 _startFrameTime;
+	uint _lastFrameDuration;
+	uint32 _lastPresentTime;
+
+	bool _inputPending;
+	uint32 _inputTime;
+
+	FrameHistory _frameTimes;
+	FrameHistory _inputLatencies;
+	uint _framesSinceLog;
+};
+
+/** @} */
+
+} // End of namespace Graphics
+
+#endif
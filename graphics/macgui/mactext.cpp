@@ -428,6 +428,10 @@ void MacText::setTextChunks(int start, int end, int param, void (*callback)(MacF
 		endCol++;
 	}
 
+	Common::Array<int> oldHeights;
+	for (uint i = startRow; i <= endRow; i++)
+		oldHeights.push_back(getLineHeight(i));
+
 	for (uint i = startRow; i <= endRow; i++) {
 		uint from, to;
 		if (i == startRow && i == endRow) {
@@ -448,8 +452,23 @@ void MacText::setTextChunks(int start, int end, int param, void (*callback)(MacF
 		}
 	}
 
-	_fullRefresh = true;
-	render();
+	// Only relayout the touched lines. As long as none of them changed
+	// height, the lines below keep their positions and we can redraw
+	// just this range instead of the whole text
+	bool sameHeights = true;
+	for (uint i = startRow; i <= endRow; i++) {
+		_textMaxWidth = MAX(_textMaxWidth, getLineWidth(i, true));
+		if (getLineHeight(i) != oldHeights[i - startRow])
+			sameHeights = false;
+	}
+
+	if (sameHeights && !_fullRefresh) {
+		render(startRow, endRow);
+	} else {
+		_fullRefresh = true;
+		recalcDims();
+		render();
+	}
 	_contentIsDirty = true;
 }
 
@@ -24,22 +24,43 @@
 #include "common/algorithm.h"
 #include "common/textconsole.h"
 #include "common/endian.h"
+#include "common/array.h"
 
 namespace Graphics {
 
+struct TransparentSpans {
+	struct Span {
+		uint16 x;
+		uint16 length;
+	};
+
+	/** The transparent color the spans were built for */
+	uint transColor;
+	/** Whether any pixels are partially transparent, so must be blended */
+	bool blended;
+	/** Whether any pixels are skipped for having zero alpha */
+	bool alphaSkipped;
+
+	Common::Array<Span> spans;
+	/** Index of the first span of each line, and the end of the last one */
+	Common::Array<uint32> lines;
+};
+
 const int SCALE_THRESHOLD = 0x100;
 
 ManagedSurface::ManagedSurface() :
 		w(_innerSurface.w), h(_innerSurface.h), pitch(_innerSurface.pitch), format(_innerSurface.format),
 		_disposeAfterUse(DisposeAfterUse::NO), _owner(nullptr),
-		_transparentColor(0),_transparentColorSet(false), _paletteSet(false) {
+		_transparentColor(0),_transparentColorSet(false), _paletteSet(false),
+		_transparentSpans(nullptr), _spanCaching(false) {
 	Common::fill(&_palette[0], &_palette[256], 0);
 }
 
 ManagedSurface::ManagedSurface(const ManagedSurface &surf) :
 		w(_innerSurface.w), h(_innerSurface.h), pitch(_innerSurface.pitch), format(_innerSurface.format),
 		_disposeAfterUse(DisposeAfterUse::NO), _owner(nullptr),
-		_transparentColor(0), _transparentColorSet(false), _paletteSet(false) {
+		_transparentColor(0), _transparentColorSet(false), _paletteSet(false),
+		_transparentSpans(nullptr), _spanCaching(false) {
 	Common::fill(&_palette[0], &_palette[256], 0);
 	*this = surf;
 }
@@ -47,7 +68,8 @@ ManagedSurface::ManagedSurface(const ManagedSurface &surf) :
 ManagedSurface::ManagedSurface(int width, int height) :
 		w(_innerSurface.w), h(_innerSurface.h), pitch(_innerSurface.pitch), format(_innerSurface.format),
 		_disposeAfterUse(DisposeAfterUse::NO), _owner(nullptr),
-		_transparentColor(0), _transparentColorSet(false), _paletteSet(false) {
+		_transparentColor(0), _transparentColorSet(false), _paletteSet(false),
+		_transparentSpans(nullptr), _spanCaching(false) {
 	Common::fill(&_palette[0], &_palette[256], 0);
 	create(width, height);
 }
@@ -55,7 +77,8 @@ ManagedSurface::ManagedSurface(int width, int height) :
 ManagedSurface::ManagedSurface(int width, int height, const Graphics::PixelFormat &pixelFormat) :
 		w(_innerSurface.w), h(_innerSurface.h), pitch(_innerSurface.pitch), format(_innerSurface.format),
 		_disposeAfterUse(DisposeAfterUse::NO), _owner(nullptr),
-		_transparentColor(0), _transparentColorSet(false), _paletteSet(false) {
+		_transparentColor(0), _transparentColorSet(false), _paletteSet(false),
+		_transparentSpans(nullptr), _spanCaching(false) {
 	Common::fill(&_palette[0], &_palette[256], 0);
 	create(width, height, pixelFormat);
 }
@@ -63,14 +86,16 @@ ManagedSurface::ManagedSurface(int width, int height, const Graphics::PixelForma
 ManagedSurface::ManagedSurface(ManagedSurface &surf, const Common::Rect &bounds) :
 		w(_innerSurface.w), h(_innerSurface.h), pitch(_innerSurface.pitch), format(_innerSurface.format),
 		_disposeAfterUse(DisposeAfterUse::NO), _owner(nullptr),
-		_transparentColor(0), _transparentColorSet(false), _paletteSet(false) {
+		_transparentColor(0), _transparentColorSet(false), _paletteSet(false),
+		_transparentSpans(nullptr), _spanCaching(false) {
 	Common::fill(&_palette[0], &_palette[256], 0);
 	create(surf, bounds);
 }
 
 ManagedSurface::ManagedSurface(Surface *surf, DisposeAfterUse::Flag disposeAfterUse) :
 		w(_innerSurface.w), h(_innerSurface.h), pitch(_innerSurface.pitch), format(_innerSurface.format),
-		_owner(nullptr), _transparentColor(0), _transparentColorSet(false), _paletteSet(false) {
+		_owner(nullptr), _transparentColor(0), _transparentColorSet(false), _paletteSet(false),
+		_transparentSpans(nullptr), _spanCaching(false) {
 	if (!surf) {
 		_disposeAfterUse = DisposeAfterUse::YES;
 
@@ -94,7 +119,8 @@ ManagedSurface::ManagedSurface(Surface *surf, DisposeAfterUse::Flag disposeAfter
 
 ManagedSurface::ManagedSurface(const Surface *surf) :
 		w(_innerSurface.w), h(_innerSurface.h), pitch(_innerSurface.pitch), format(_innerSurface.format),
-		_owner(nullptr), _transparentColor(0), _transparentColorSet(false), _paletteSet(false) {
+		_owner(nullptr), _transparentColor(0), _transparentColorSet(false), _paletteSet(false),
+		_transparentSpans(nullptr), _spanCaching(false) {
 	if (!surf)  {
 		_disposeAfterUse = DisposeAfterUse::YES;
 
@@ -181,6 +207,8 @@ void ManagedSurface::create(ManagedSurface &surf, const Common::Rect &bounds) {
 }
 
 void ManagedSurface::free() {
+	invalidateSpans();
+
 	if (_disposeAfterUse == DisposeAfterUse::YES)
 		_innerSurface.free();
 
@@ -491,10 +519,145 @@ void ManagedSurface::transBlitFrom(const ManagedSurface &src, const Common::Rect
 	const uint32 *srcPalette = src._paletteSet ? src._palette : nullptr;
 	const uint32 *dstPalette = _paletteSet ? _palette : nullptr;
 
+	// The spans only hold pixels which are copied as they are
+	if (src._spanCaching && !flipped && !overrideColor && srcAlpha == 0xff && !mask && !maskOnly &&
+			(!srcPalette || !dstPalette || !memcmp(srcPalette, dstPalette, sizeof(_palette))) &&
+			transBlitFromSpans(src, srcRect, destRect, transColor))
+		return;
+
 	transBlitFromInner(src._innerSurface, srcRect, destRect, transColor, flipped, overrideColor,
 		srcAlpha, srcPalette, dstPalette, mask, maskOnly);
 }
 
+void ManagedSurface::setSpanCaching(bool enable) {
+	_spanCaching = enable;
+	if (!enable)
+		invalidateSpans();
+}
+
+void ManagedSurface::freeSpans() {
+	delete _transparentSpans;
+	_transparentSpans = nullptr;
+}
+
+/**
+ * Find the runs of pixels that transBlit copies unchanged, skipping the
+ * same pixels it skips.
+ */
+template<typename TSRC>
+static TransparentSpans *buildTransparentSpans(const Surface &src, TSRC transColor) {
+	TransparentSpans *spans = new TransparentSpans();
+	spans->transColor = transColor;
+	spans->blended = false;
+	spans->alphaSkipped = false;
+	spans->lines.reserve(src.h + 1);
+
+	byte rst = 0, gst = 0, bst = 0;
+	const bool isSrcTrans32 = src.format.aBits() != 0 && transColor != (uint32)-1 && transColor > 0;
+	if (isSrcTrans32)
+		src.format.colorToRGB(transColor, rst, gst, bst);
+
+	for (int y = 0; y < src.h; ++y) {
+		spans->lines.push_back(spans->spans.size());
+		const TSRC *line = (const TSRC *)src.getBasePtr(0, y);
+		int start = -1;
+
+		for (int x = 0; x <= src.w; ++x) {
+			bool opaque = false;
+
+			if (x < src.w) {
+				const TSRC srcVal = line[x];
+				byte a, r, g, b;
+
+				if (isSrcTrans32) {
+					src.format.colorToRGB(srcVal, r, g, b);
+					opaque = rst != r || gst != g || bst != b;
+				} else {
+					opaque = srcVal != transColor;
+				}
+
+				if (opaque && src.format.bytesPerPixel != 1) {
+					src.format.colorToARGB(srcVal, a, r, g, b);
+					if (a == 0) {
+						// transBlitPixel skips these, but only after clearing
+						// transparent destination pixels
+						spans->alphaSkipped = true;
+						opaque = false;
+					} else if (a != 0xff || src.format.ARGBToColor(a, r, g, b) != srcVal) {
+						spans->blended = true;
+						return spans;
+					}
+				}
+			}
+
+			if (opaque && start < 0) {
+				start = x;
+			} else if (!opaque && start >= 0) {
+				TransparentSpans::Span span;
+				span.x = start;
+				span.length = x - start;
+				spans->spans.push_back(span);
+				start = -1;
+			}
+		}
+	}
+
+	spans->lines.push_back(spans->spans.size());
+	return spans;
+}
+
+bool ManagedSurface::transBlitFromSpans(const ManagedSurface &src, const Common::Rect &srcRect,
+		const Common::Rect &destRect, uint transColor) {
+	if (src.format != format || src.w == 0 || src.h == 0 || destRect.isEmpty() ||
+			srcRect.width() != destRect.width() || srcRect.height() != destRect.height() ||
+			!Common::Rect(src.w, src.h).contains(srcRect))
+		return false;
+
+	if (!src._transparentSpans || src._transparentSpans->transColor != transColor) {
+		delete src._transparentSpans;
+		switch (format.bytesPerPixel) {
+		case 1:
+			src._transparentSpans = buildTransparentSpans<byte>(src._innerSurface, transColor);
+			break;
+		case 2:
+			src._transparentSpans = buildTransparentSpans<uint16>(src._innerSurface, transColor);
+			break;
+		case 4:
+			src._transparentSpans = buildTransparentSpans<uint32>(src._innerSurface, transColor);
+			break;
+		default:
+			src._transparentSpans = nullptr;
+			return false;
+		}
+	}
+
+	const TransparentSpans &spans = *src._transparentSpans;
+	if (spans.blended || (spans.alphaSkipped && hasTransparentColor()))
+		return false;
+
+	// The visible part of the source rect
+	const int bpp = format.bytesPerPixel;
+	const int left = srcRect.left + MAX(0, -destRect.left);
+	const int right = srcRect.right - MAX(0, destRect.right - this->w);
+	const int top = srcRect.top + MAX(0, -destRect.top);
+	const int bottom = srcRect.bottom - MAX(0, destRect.bottom - this->h);
+
+	for (int y = top; y < bottom; ++y) {
+		const int destY = destRect.top + y - srcRect.top;
+
+		for (uint i = spans.lines[y]; i < spans.lines[y + 1]; ++i) {
+			const int x0 = MAX<int>(spans.spans[i].x, left);
+			const int x1 = MIN<int>(spans.spans[i].x + spans.spans[i].length, right);
+			if (x0 < x1)
+				memcpy(getBasePtr(destRect.left + x0 - srcRect.left, destY), src.getBasePtr(x0, y), (x1 - x0) * bpp);
+		}
+	}
+
+	// Mark the affected area
+	addDirtyRect(destRect);
+	return true;
+}
+
 static uint findBestColor(const uint32 *palette, byte cr, byte cg, byte cb) {
 	uint bestColor = 0;
 	double min = 0xFFFFFFFF;
@@ -716,6 +879,8 @@ void ManagedSurface::markAllDirty() {
 }
 
 void ManagedSurface::addDirtyRect(const Common::Rect &r) {
+	invalidateSpans();
+
 	if (_owner) {
 		Common::Rect bounds = r;
 		bounds.clip(Common::Rect(0, 0, this->w, this->h));
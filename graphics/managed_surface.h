@@ -30,6 +30,8 @@
 
 namespace Graphics {
 
+struct TransparentSpans;
+
 /**
  * @defgroup graphics_managed_surface Managed surface
  * @ingroup graphics
@@ -80,6 +82,30 @@ private:
 	 */
 	uint32 _palette[256];
 	bool _paletteSet;
+
+	/**
+	 * Runs of opaque pixels for transBlitFrom, when span caching is enabled.
+	 * Built on the first transparent blit and dropped on any change.
+	 */
+	mutable TransparentSpans *_transparentSpans;
+	bool _spanCaching;
+
+	/**
+	 * Drop the cached runs of opaque pixels.
+	 */
+	void invalidateSpans() {
+		if (_transparentSpans)
+			freeSpans();
+	}
+	void freeSpans();
+
+	/**
+	 * Copy another surface into this one using its cached runs of opaque pixels.
+	 * Returns false if the blit needs more than copying pixels, or the source
+	 * has no up to date spans.
+	 */
+	bool transBlitFromSpans(const ManagedSurface &src, const Common::Rect &srcRect,
+		const Common::Rect &destRect, uint transColor);
 protected:
 	/**
 	 * Inner method for blitting.
@@ -207,7 +233,8 @@ public:
 	 * @param pixel The value of the pixel.
 	 */
 	inline void setPixel(int x, int y, uint32 pixel) {
-		return _innerSurface.setPixel(x, y, pixel);
+		_innerSurface.setPixel(x, y, pixel);
+		invalidateSpans();
 	}
 
 	/**
@@ -494,6 +521,20 @@ public:
 		uint transColor = 0, bool flipped = false, uint overrideColor = 0, uint srcAlpha = 0xff,
 		const Surface *mask = nullptr, bool maskOnly = false);
 
+	/**
+	 * Enable or disable caching the runs of opaque pixels of this surface,
+	 * for sprites that are drawn with transBlitFrom often but rarely change.
+	 *
+	 * When this surface is the source of an unscaled, unflipped transBlitFrom
+	 * of the same pixel format, without override color, alpha or mask, the
+	 * runs are then copied with memcpy rather than testing every pixel.
+	 *
+	 * The cache is dropped when drawing to the surface and by addDirtyRect.
+	 * Code changing the pixels directly, or through another surface sharing
+	 * them, must call markAllDirty afterwards.
+	 */
+	void setSpanCaching(bool enable);
+
 	/**
 	 * Does a blitFrom ignoring any transparency settings
 	 */
@@ -520,6 +561,7 @@ public:
 	 */
 	void copyRectToSurface(const void *buffer, int srcPitch, int destX, int destY, int width, int height) {
 		_innerSurface.copyRectToSurface(buffer, srcPitch, destX, destY, width, height);
+		invalidateSpans();
 	}
 
 	/**
@@ -529,6 +571,7 @@ public:
 	 */
 	void copyRectToSurface(const Graphics::Surface &srcSurface, int destX, int destY, const Common::Rect subRect) {
 		_innerSurface.copyRectToSurface(srcSurface, destX, destY, subRect);
+		invalidateSpans();
 	}
 
 	/**
@@ -612,6 +655,7 @@ public:
 	 */
 	void convertToInPlace(const PixelFormat &dstFormat, const byte *palette = nullptr) {
 		_innerSurface.convertToInPlace(dstFormat, palette);
+		invalidateSpans();
 	}
 
 	/**
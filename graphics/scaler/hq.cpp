@@ -5013,6 +5013,15 @@ void HQPlugin::deinitialize() {
 	RGBtoYUV = 0;
 }
 
+bool HQPlugin::canScaleInBands() const {
+#ifdef USE_NASM
+	// The assembly versions keep their variables in static memory
+	return _format.bytesPerPixel != 2;
+#else
+	return true;
+#endif
+}
+
 void HQPlugin::scaleIntern(const uint8 *srcPtr, uint32 srcPitch,
 							uint8 *dstPtr, uint32 dstPitch, int width, int height, int x, int y) {
 	if (_format.bytesPerPixel == 2) {
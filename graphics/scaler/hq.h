@@ -33,6 +33,7 @@ public:
 	virtual uint decreaseFactor() override;
 	virtual bool canDrawCursor() const override { return false; }
 	virtual uint extraPixels() const override { return 1; }
+	virtual bool canScaleInBands() const override;
 	virtual const char *getName() const override;
 	virtual const char *getPrettyName() const override;
 protected:
@@ -25,6 +25,7 @@
 #include "common/system.h"
 
 #include "graphics/colormasks.h"
+#include "graphics/conversion.h"
 #include "graphics/scaler.h"
 #include "graphics/scaler/intern.h"
 #include "graphics/palette.h"
@@ -180,36 +181,19 @@ static bool grabScreen565(Graphics::Surface *surf) {
 
 	surf->create(screen->w, screen->h, Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
 
-	byte *palette = 0;
 	if (screenFormat.bytesPerPixel == 1) {
-		palette = new byte[256 * 3];
-		assert(palette);
+		byte palette[256 * 3];
 		g_system->getPaletteManager()->grabPalette(palette, 0, 256);
-	}
-
-	for (int y = 0; y < screen->h; ++y) {
-		for (int x = 0; x < screen->w; ++x) {
-			byte r = 0, g = 0, b = 0;
-
-			if (screenFormat.bytesPerPixel == 1) {
-				uint8 pixel = *(uint8 *)screen->getBasePtr(x, y);
-				r = palette[pixel * 3 + 0];
-				g = palette[pixel * 3 + 1];
-				b = palette[pixel * 3 + 2];
-			} else if (screenFormat.bytesPerPixel == 2) {
-				uint16 col = READ_UINT16(screen->getBasePtr(x, y));
-				screenFormat.colorToRGB(col, r, g, b);
-			} else if (screenFormat.bytesPerPixel == 4) {
-				uint32 col = READ_UINT32(screen->getBasePtr(x, y));
-				screenFormat.colorToRGB(col, r, g, b);
-			}
 
-			*((uint16 *)surf->getBasePtr(x, y)) = surf->format.RGBToColor(r, g, b);
-		}
+		uint32 map[256];
+		Graphics::convertPaletteToMap(map, palette, 256, surf->format);
+		Graphics::crossBlitMap((byte *)surf->getPixels(), (const byte *)screen->getPixels(), surf->pitch, screen->pitch,
+		                       screen->w, screen->h, surf->format.bytesPerPixel, map);
+	} else {
+		Graphics::crossBlit((byte *)surf->getPixels(), (const byte *)screen->getPixels(), surf->pitch, screen->pitch,
+		                    screen->w, screen->h, surf->format, screenFormat);
 	}
 
-	delete[] palette;
-
 	g_system->unlockScreen();
 	return true;
 }
@@ -246,16 +230,9 @@ bool createThumbnail(Graphics::Surface *surf, const uint8 *pixels, int w, int h,
 	Graphics::Surface screen;
 	screen.create(w, h, Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
 
-	for (int y = 0; y < screen.h; ++y) {
-		for (int x = 0; x < screen.w; ++x) {
-			byte r, g, b;
-			r = palette[pixels[y * w + x] * 3];
-			g = palette[pixels[y * w + x] * 3 + 1];
-			b = palette[pixels[y * w + x] * 3 + 2];
-
-			*((uint16 *)screen.getBasePtr(x, y)) = screen.format.RGBToColor(r, g, b);
-		}
-	}
+	uint32 map[256];
+	Graphics::convertPaletteToMap(map, palette, 256, screen.format);
+	Graphics::crossBlitMap((byte *)screen.getPixels(), pixels, screen.pitch, w, w, h, screen.format.bytesPerPixel, map);
 
 	return createThumbnail(*surf, screen);
 }
@@ -274,14 +251,8 @@ bool createScreenShot(Graphics::Surface &surf) {
 			return false;
 		}
 		surf.create(screen->w, screen->h, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
-		for (int y = 0; y < screen->h; ++y) {
-			for (int x = 0; x < screen->w; ++x) {
-				byte r = 0, g = 0, b = 0, a = 0;
-				uint32 col = READ_UINT32(screen->getBasePtr(x, y));
-				screenFormat.colorToARGB(col, a, r, g, b);
-				*((uint32 *)surf.getBasePtr(x, y)) = surf.format.ARGBToColor(a, r, g, b);
-			}
-		}
+		Graphics::crossBlit((byte *)surf.getPixels(), (const byte *)screen->getPixels(), surf.pitch, screen->pitch,
+		                    screen->w, screen->h, surf.format, screenFormat);
 		g_system->unlockScreen();
 		return true;
 	}
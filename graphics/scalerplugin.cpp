@@ -47,6 +47,29 @@ void Normal1x(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPit
 }
 } // End of anonymous namespace
 
+struct ScalerPluginObject::Bands {
+	ScalerPluginObject *scaler;
+	const uint8 *srcPtr;
+	uint32 srcPitch;
+	uint8 *dstPtr;
+	uint32 dstPitch;
+	int width, height, x, y;
+	uint count;
+};
+
+void ScalerPluginObject::scaleBand(void *data, uint band) {
+	const Bands &bands = *(const Bands *)data;
+
+	// Each band starts on a line of its own, so that no destination
+	// pixel is written by two bands
+	const int top = bands.height * band / bands.count;
+	const int bottom = bands.height * (band + 1) / bands.count;
+
+	bands.scaler->scaleIntern(bands.srcPtr + top * bands.srcPitch, bands.srcPitch,
+	                          bands.dstPtr + top * bands.scaler->_factor * bands.dstPitch, bands.dstPitch,
+	                          bands.width, bottom - top, bands.x, bands.y + top);
+}
+
 void ScalerPluginObject::scale(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
 	                           uint32 dstPitch, int width, int height, int x, int y) {
 	if (_factor == 1) {
@@ -55,6 +78,19 @@ void ScalerPluginObject::scale(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstP
 		} else {
 			Normal1x<uint32>(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
 		}
+	} else if (_threadPool && _threadPool->getThreadCount() > 1 && height >= 2 * kMinBandHeight && canScaleInBands()) {
+		Bands bands;
+		bands.scaler = this;
+		bands.srcPtr = srcPtr;
+		bands.srcPitch = srcPitch;
+		bands.dstPtr = dstPtr;
+		bands.dstPitch = dstPitch;
+		bands.width = width;
+		bands.height = height;
+		bands.x = x;
+		bands.y = y;
+		bands.count = MIN<uint>(_threadPool->getThreadCount(), height / kMinBandHeight);
+		_threadPool->run(&scaleBand, &bands, bands.count);
 	} else {
 		scaleIntern(srcPtr, srcPitch, dstPtr, dstPitch, width, height, x, y);
 	}
@@ -23,12 +23,14 @@
 #define GRAPHICS_SCALERPLUGIN_H
 
 #include "base/plugins.h"
+#include "common/threadpool.h"
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 
 class ScalerPluginObject : public PluginObject {
 public:
 
+	ScalerPluginObject() : _threadPool(nullptr) {}
 	virtual ~ScalerPluginObject() {}
 
 	/**
@@ -59,6 +61,20 @@ public:
 	void scale(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
 	           uint32 dstPitch, int width, int height, int x, int y);
 
+	/**
+	 * Set the thread pool scale uses for areas of at least
+	 * 2 * kMinBandHeight lines, or nullptr to always scale on the calling
+	 * thread.
+	 */
+	void setThreadPool(Common::ThreadPool *threadPool) { _threadPool = threadPool; }
+
+	/**
+	 * Whether an area can be scaled as several bands of lines at once.
+	 * Scalers keeping state while scaling must return false. Each band
+	 * reads the lines around it, as given by extraPixels, from the source.
+	 */
+	virtual bool canScaleInBands() const { return true; }
+
 	/**
 	 * Increase the factor of scaling.
 	 * @return The new factor
@@ -155,9 +171,18 @@ protected:
 	virtual void scaleIntern(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
 	                         uint32 dstPitch, int width, int height, int x, int y) = 0;
 
+	/** The smallest number of lines scaled as a separate band. */
+	static const int kMinBandHeight = 16;
+
 	uint _factor;
 	Common::Array<uint> _factors;
 	Graphics::PixelFormat _format;
+
+private:
+	struct Bands;
+	static void scaleBand(void *data, uint band);
+
+	Common::ThreadPool *_threadPool;
 };
 
 /**
@@ -179,6 +204,12 @@ public:
 
 	virtual uint setFactor(uint factor) final;
 
+	/**
+	 * Scaling updates the old source and buffered output for the whole area,
+	 * which the bands around it read from.
+	 */
+	virtual bool canScaleInBands() const override { return false; }
+
 protected:
 
 	virtual void scaleIntern(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
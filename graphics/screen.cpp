@@ -28,14 +28,17 @@
 namespace Graphics {
 
 Screen::Screen(): ManagedSurface() {
+	_dirtyRegion.setFullUpdateThreshold(75);
 	create(g_system->getWidth(), g_system->getHeight(), g_system->getScreenFormat());
 }
 
 Screen::Screen(int width, int height): ManagedSurface() {
+	_dirtyRegion.setFullUpdateThreshold(75);
 	create(width, height);
 }
 
 Screen::Screen(int width, int height, PixelFormat pixelFormat): ManagedSurface() {
+	_dirtyRegion.setFullUpdateThreshold(75);
 	create(width, height, pixelFormat);
 }
 
@@ -77,25 +80,19 @@ void Screen::makeAllDirty() {
 }
 
 void Screen::mergeDirtyRects() {
-	Common::List<Common::Rect>::iterator rOuter, rInner;
+	if (_dirtyRects.size() <= 1)
+		return;
 
-	// Process the dirty rect list to find any rects to merge
-	for (rOuter = _dirtyRects.begin(); rOuter != _dirtyRects.end(); ++rOuter) {
-		rInner = rOuter;
-		while (++rInner != _dirtyRects.end()) {
+	const Common::Point offset = getOffsetFromOwner();
+	_dirtyRegion.setBounds(Common::Rect(offset.x, offset.y, offset.x + this->w, offset.y + this->h));
 
-			if ((*rOuter).intersects(*rInner)) {
-				// These two rectangles overlap, so merge them
-				unionRectangle(*rOuter, *rOuter, *rInner);
-
-				// remove the inner rect from the list
-				_dirtyRects.erase(rInner);
+	Common::List<Common::Rect>::iterator i;
+	for (i = _dirtyRects.begin(); i != _dirtyRects.end(); ++i)
+		_dirtyRegion.addRect(*i);
 
-				// move back to beginning of list
-				rInner = rOuter;
-			}
-		}
-	}
+	_dirtyRects.clear();
+	_dirtyRegion.getRects(_dirtyRects);
+	_dirtyRegion.clear();
 }
 
 bool Screen::unionRectangle(Common::Rect &destRect, const Common::Rect &src1, const Common::Rect &src2) {
@@ -23,6 +23,7 @@
 #ifndef GRAPHICS_SCREEN_H
 #define GRAPHICS_SCREEN_H
 
+#include "graphics/dirty_region.h"
 #include "graphics/managed_surface.h"
 #include "graphics/pixelformat.h"
 #include "common/list.h"
@@ -54,9 +55,15 @@ protected:
 	 * List of affected areas of the screen
 	 */
 	Common::List<Common::Rect> _dirtyRects;
+
+	/**
+	 * Used for merging the affected areas
+	 */
+	DirtyRegion _dirtyRegion;
 protected:
 	/**
-	 * Merges together overlapping dirty areas of the screen
+	 * Replaces the dirty areas of the screen with a small set of
+	 * non-overlapping rectangles covering them
 	 */
 	void mergeDirtyRects();
 
@@ -91,6 +98,18 @@ public:
 	 */
 	virtual void addDirtyRect(const Common::Rect &r);
 
+	/**
+	 * Sets the size of the tiles dirty areas are rounded up to when they
+	 * are merged. The default is 8x8 pixels.
+	 */
+	void setDirtyTileSize(int16 tileWidth, int16 tileHeight) { _dirtyRegion.setTileSize(tileWidth, tileHeight); }
+
+	/**
+	 * Sets how many percent of the screen must be dirty for update to copy
+	 * the whole screen at once. The default is 75, and 0 disables this.
+	 */
+	void setFullUpdateThreshold(uint percent) { _dirtyRegion.setFullUpdateThreshold(percent); }
+
 	/**
 	 * Updates the screen by copying any affected areas to the system
 	 */
@@ -372,34 +372,52 @@ void Surface::flipVertical(const Common::Rect &r) {
 
 Graphics::Surface *Surface::scale(int16 newWidth, int16 newHeight, bool filtering) const {
 	Graphics::Surface *target = new Graphics::Surface();
+	scale(*target, newWidth, newHeight, filtering);
+	return target;
+}
 
-	target->create(newWidth, newHeight, format);
+void Surface::scale(Surface &target, int16 newWidth, int16 newHeight, bool filtering) const {
+	if (target.w != newWidth || target.h != newHeight || target.format != format || !target.getPixels())
+		target.create(newWidth, newHeight, format);
 
 	if (filtering) {
-		scaleBlitBilinear((byte *)target->getPixels(), (const byte *)getPixels(), target->pitch, pitch, target->w, target->h, w, h, format);
+		scaleBlitBilinear((byte *)target.getPixels(), (const byte *)getPixels(), target.pitch, pitch, target.w, target.h, w, h, format);
 	} else {
-		scaleBlit((byte *)target->getPixels(), (const byte *)getPixels(), target->pitch, pitch, target->w, target->h, w, h, format);
+		scaleBlit((byte *)target.getPixels(), (const byte *)getPixels(), target.pitch, pitch, target.w, target.h, w, h, format);
 	}
+}
 
+Graphics::Surface *Surface::rotoscale(const TransformStruct &transform, bool filtering) const {
+	Graphics::Surface *target = new Graphics::Surface();
+	rotoscale(*target, transform, filtering);
 	return target;
 }
 
-Graphics::Surface *Surface::rotoscale(const TransformStruct &transform, bool filtering) const {
+void Surface::rotoscale(Surface &target, const TransformStruct &transform, bool filtering) const {
 
 	Common::Point newHotspot;
 	Common::Rect rect = TransformTools::newRect(Common::Rect((int16)w, (int16)h), transform, &newHotspot);
 
-	Graphics::Surface *target = new Graphics::Surface();
+	if (transform._angle % 360 == 0) {
+		scale(target, rect.width(), rect.height(), filtering);
+		return;
+	}
 
-	target->create((uint16)rect.right - rect.left, (uint16)rect.bottom - rect.top, this->format);
+	const int16 newWidth = (uint16)rect.right - rect.left;
+	const int16 newHeight = (uint16)rect.bottom - rect.top;
+	if (target.w != newWidth || target.h != newHeight || target.format != format || !target.getPixels()) {
+		target.create(newWidth, newHeight, format);
+	} else {
+		// The corners outside of the rotated image are left untouched
+		for (int y = 0; y < target.h; ++y)
+			memset(target.getBasePtr(0, y), 0, target.w * format.bytesPerPixel);
+	}
 
 	if (filtering) {
-		rotoscaleBlitBilinear((byte *)target->getPixels(), (const byte *)getPixels(), target->pitch, pitch, target->w, target->h, w, h, format, transform, newHotspot);
+		rotoscaleBlitBilinear((byte *)target.getPixels(), (const byte *)getPixels(), target.pitch, pitch, target.w, target.h, w, h, format, transform, newHotspot);
 	} else {
-		rotoscaleBlit((byte *)target->getPixels(), (const byte *)getPixels(), target->pitch, pitch, target->w, target->h, w, h, format, transform, newHotspot);
+		rotoscaleBlit((byte *)target.getPixels(), (const byte *)getPixels(), target.pitch, pitch, target.w, target.h, w, h, format, transform, newHotspot);
 	}
-
-	return target;
 }
 
 void Surface::convertToInPlace(const PixelFormat &dstFormat, const byte *palette) {
@@ -430,26 +448,9 @@ void Surface::convertToInPlace(const PixelFormat &dstFormat, const byte *palette
 	if (format.bytesPerPixel == 1) {
 		assert(palette);
 
-		for (int y = h; y > 0; --y) {
-			const byte *srcRow = (const byte *)pixels + y * pitch - 1;
-			byte *dstRow = (byte *)pixels + y * w * dstFormat.bytesPerPixel - dstFormat.bytesPerPixel;
-
-			for (int x = 0; x < w; x++) {
-				byte index = *srcRow--;
-				byte r = palette[index * 3];
-				byte g = palette[index * 3 + 1];
-				byte b = palette[index * 3 + 2];
-
-				uint32 color = dstFormat.RGBToColor(r, g, b);
-
-				if (dstFormat.bytesPerPixel == 2)
-					*((uint16 *)dstRow) = color;
-				else
-					*((uint32 *)dstRow) = color;
-
-				dstRow -= dstFormat.bytesPerPixel;
-			}
-		}
+		uint32 map[256];
+		convertPaletteToMap(map, palette, 256, dstFormat);
+		crossBlitMap((byte *)pixels, (const byte *)pixels, w * dstFormat.bytesPerPixel, pitch, w, h, dstFormat.bytesPerPixel, map);
 	} else {
 		crossBlit((byte *)pixels, (const byte *)pixels, w * dstFormat.bytesPerPixel, pitch, w, h, dstFormat, format);
 	}
@@ -469,14 +470,22 @@ void Surface::convertToInPlace(const PixelFormat &dstFormat, const byte *palette
 }
 
 Graphics::Surface *Surface::convertTo(const PixelFormat &dstFormat, const byte *palette) const {
+	Graphics::Surface *surface = new Graphics::Surface();
+	convertTo(*surface, dstFormat, palette);
+	return surface;
+}
+
+void Surface::convertTo(Surface &target, const PixelFormat &dstFormat, const byte *palette) const {
 	assert(pixels);
 
-	Graphics::Surface *surface = new Graphics::Surface();
+	Graphics::Surface *surface = &target;
+	if (surface->w != w || surface->h != h || surface->format != dstFormat || !surface->getPixels())
+		surface->create(w, h, dstFormat);
 
 	// If the target format is the same, just copy
 	if (format == dstFormat) {
-		surface->copyFrom(*this);
-		return surface;
+		surface->copyRectToSurface(*this, 0, 0, Common::Rect(w, h));
+		return;
 	}
 
 	if (format.bytesPerPixel == 0 || format.bytesPerPixel > 4)
@@ -485,36 +494,18 @@ Graphics::Surface *Surface::convertTo(const PixelFormat &dstFormat, const byte *
 	if (dstFormat.bytesPerPixel < 2 || dstFormat.bytesPerPixel > 4)
 		error("Surface::convertTo(): Can only convert to 2Bpp, 3Bpp and 4Bpp");
 
-	surface->create(w, h, dstFormat);
-
 	if (format.bytesPerPixel == 1) {
 		// Converting from paletted to high color
 		assert(palette);
 
-		for (int y = 0; y < h; y++) {
-			const byte *srcRow = (const byte *)getBasePtr(0, y);
-			byte *dstRow = (byte *)surface->getBasePtr(0, y);
-
-			for (int x = 0; x < w; x++) {
-				byte index = *srcRow++;
-				byte r = palette[index * 3];
-				byte g = palette[index * 3 + 1];
-				byte b = palette[index * 3 + 2];
-
-				uint32 color = dstFormat.RGBToColor(r, g, b);
-
-				if (dstFormat.bytesPerPixel == 2)
-					*((uint16 *)dstRow) = color;
-				else if (dstFormat.bytesPerPixel == 3)
-					WRITE_UINT24(dstRow, color);
-				else
-					*((uint32 *)dstRow) = color;
-
-				dstRow += dstFormat.bytesPerPixel;
-			}
-		}
-	} else {
+		uint32 map[256];
+		convertPaletteToMap(map, palette, 256, dstFormat);
+		crossBlitMap((byte *)surface->getPixels(), (const byte *)getPixels(), surface->pitch, pitch, w, h, dstFormat.bytesPerPixel, map);
+	} else if (dstFormat.bytesPerPixel != 3) {
 		// Converting from high color to high color
+		crossBlit((byte *)surface->getPixels(), (const byte *)getPixels(), surface->pitch, pitch, w, h, dstFormat, format);
+	} else {
+		// Converting from high color to 3Bpp, which crossBlit does not support
 		for (int y = 0; y < h; y++) {
 			const byte *srcRow = (const byte *)getBasePtr(0, y);
 			byte *dstRow = (byte *)surface->getBasePtr(0, y);
@@ -546,8 +537,6 @@ Graphics::Surface *Surface::convertTo(const PixelFormat &dstFormat, const byte *
 			}
 		}
 	}
-
-	return surface;
 }
 
 void Surface::debugPrint(int debuglevel, int width, int height, int x, int y, int scale, int maxwidth, const byte *palette) const {
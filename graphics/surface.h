@@ -311,6 +311,18 @@ public:
 	 */
 	Graphics::Surface *convertTo(const PixelFormat &dstFormat, const byte *palette = 0) const;
 
+	/**
+	 * Convert the data to another pixel format, into an existing surface.
+	 *
+	 * The target is only (re)created when its size or format differ, so that
+	 * converting into the same surface over and over again does not allocate.
+	 *
+	 * @param target     The surface receiving the result.
+	 * @param dstFormat  The desired format.
+	 * @param palette    The palette (in RGB888), if the source format has a bpp of 1.
+	 */
+	void convertTo(Surface &target, const PixelFormat &dstFormat, const byte *palette = 0) const;
+
 	/**
 	 * Draw a line.
 	 *
@@ -404,6 +416,19 @@ public:
 	 */
 	Graphics::Surface *scale(int16 newWidth, int16 newHeight, bool filtering = false) const;
 
+	/**
+	 * Scale the data to the given size, into an existing surface.
+	 *
+	 * The target is only (re)created when its size or format differ, so that
+	 * scaling into the same surface over and over again does not allocate.
+	 *
+	 * @param target     The surface receiving the result.
+	 * @param newWidth   The resulting width.
+	 * @param newHeight  The resulting height.
+	 * @param filtering  Whether or not to use bilinear filtering.
+	 */
+	void scale(Surface &target, int16 newWidth, int16 newHeight, bool filtering = false) const;
+
 	/**
 	 * @brief Rotoscale function; this returns a transformed version of this surface after rotation and
 	 * scaling. Please do not use this if angle == 0, use plain old scaling function.
@@ -417,6 +442,18 @@ public:
 	 */
 	Graphics::Surface *rotoscale(const TransformStruct &transform, bool filtering = false) const;
 
+	/**
+	 * Rotate and scale the data into an existing surface, which is only
+	 * (re)created when its size or format differ.
+	 *
+	 * Transforms without rotation are passed on to scale().
+	 *
+	 * @param target    The surface receiving the result.
+	 * @param transform a TransformStruct wrapping the required info. @see TransformStruct
+	 * @param filtering Whether or not to use bilinear filtering.
+	 */
+	void rotoscale(Surface &target, const TransformStruct &transform, bool filtering = false) const;
+
 	/**
 	 * Print surface content on console in pseudographics
 	 *
@@ -179,19 +179,23 @@ bool loadThumbnail(Common::SeekableReadStream &in, Graphics::Surface *&thumbnail
 	thumbnail = new Graphics::Surface();
 	thumbnail->create(header.width, header.height, header.format);
 
+	// Read each line at once, then bring it to the native byte order
 	for (int y = 0; y < thumbnail->h; ++y) {
+		byte *line = (byte *)thumbnail->getBasePtr(0, y);
+		in.read(line, thumbnail->w * header.format.bytesPerPixel);
+
 		switch (header.format.bytesPerPixel) {
 		case 2: {
-			uint16 *pixels = (uint16 *)thumbnail->getBasePtr(0, y);
-			for (int x = 0; x < thumbnail->w; ++x) {
-				*pixels++ = in.readUint16BE();
+			uint16 *pixels = (uint16 *)line;
+			for (int x = 0; x < thumbnail->w; ++x, ++pixels) {
+				*pixels = FROM_BE_16(*pixels);
 			}
 			} break;
 
 		case 4: {
-			uint32 *pixels = (uint32 *)thumbnail->getBasePtr(0, y);
-			for (int x = 0; x < thumbnail->w; ++x) {
-				*pixels++ = in.readUint32BE();
+			uint32 *pixels = (uint32 *)line;
+			for (int x = 0; x < thumbnail->w; ++x, ++pixels) {
+				*pixels = FROM_BE_32(*pixels);
 			}
 			} break;
 
@@ -246,27 +250,31 @@ bool saveThumbnail(Common::WriteStream &out, const Graphics::Surface &thumb) {
 	out.writeByte(thumb.format.bShift);
 	out.writeByte(thumb.format.aShift);
 
-	// Serialize the pixel data
+	// Serialize the pixel data, one line at a time
+	byte *line = new byte[thumb.w * thumb.format.bytesPerPixel];
 	for (int y = 0; y < thumb.h; ++y) {
 		switch (thumb.format.bytesPerPixel) {
 		case 2: {
 			const uint16 *pixels = (const uint16 *)thumb.getBasePtr(0, y);
 			for (int x = 0; x < thumb.w; ++x) {
-				out.writeUint16BE(*pixels++);
+				WRITE_BE_UINT16(line + x * 2, *pixels++);
 			}
 			} break;
 
 		case 4: {
 			const uint32 *pixels = (const uint32 *)thumb.getBasePtr(0, y);
 			for (int x = 0; x < thumb.w; ++x) {
-				out.writeUint32BE(*pixels++);
+				WRITE_BE_UINT32(line + x * 4, *pixels++);
 			}
 			} break;
 
 		default:
 			assert(0);
 		}
+
+		out.write(line, thumb.w * thumb.format.bytesPerPixel);
 	}
+	delete[] line;
 
 	return true;
 }
@@ -29,6 +29,8 @@
 #include "graphics/tinygl/zgl.h"
 #include "graphics/tinygl/zblit.h"
 #include "graphics/tinygl/zdirtyrect.h"
+#include "common/system.h"
+#include "common/threadpool.h"
 
 namespace TinyGL {
 
@@ -234,6 +236,7 @@ void glInit(void *zbuffer1, int textureSize) {
 	c->_drawCallAllocator[0].initialize(kDrawCallMemory);
 	c->_drawCallAllocator[1].initialize(kDrawCallMemory);
 	c->_enableDirtyRectangles = true;
+	c->_threadPool = g_system->createThreadPool(0);
 
 	Graphics::Internal::tglBlitResetScissorRect();
 }
@@ -249,6 +252,7 @@ void glClose() {
 		gl_free(c->matrix_stack[i]);
 	endSharedState(c);
 	gl_free(c->vertex);
+	delete c->_threadPool;
 
 	delete c;
 }
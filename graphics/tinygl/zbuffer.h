@@ -509,6 +509,13 @@ private:
 	template <bool kEnableScissor>
 	FORCEINLINE void putPixel(unsigned int pixelOffset, int color, int x, int y);
 
+	// Fill the start of a span with vector instructions, returning how many
+	// pixels were drawn. Only usable without scissor, alpha test and blending.
+	template <int kDrawLogic, bool kDepthWrite>
+	FORCEINLINE int fillSpanVector(int pixel, int count, unsigned int &z, int dzdx,
+	                               unsigned int &r, unsigned int &g, unsigned int &b, unsigned int &a,
+	                               int drdx, int dgdx, int dbdx, int dadx);
+
 	template <bool kInterpRGB, bool kInterpZ, bool kDepthWrite>
 	void drawLine(const ZBufferPoint *p1, const ZBufferPoint *p2);
 
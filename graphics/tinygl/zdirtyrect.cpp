@@ -27,10 +27,12 @@
  */
 
 #include "graphics/tinygl/zdirtyrect.h"
+#include "graphics/dirty_region.h"
 #include "graphics/tinygl/zgl.h"
 #include "graphics/tinygl/gl.h"
 #include "common/debug.h"
 #include "common/math.h"
+#include "common/threadpool.h"
 
 namespace TinyGL {
 
@@ -65,20 +67,13 @@ static void tglDrawRectangle(Common::Rect rect, int r, int g, int b) {
 }
 #endif
 
-struct DirtyRectangle {
-	Common::Rect rectangle;
-	int r, g, b;
-
-	DirtyRectangle() { }
-	DirtyRectangle(Common::Rect rect, int red, int green, int blue) {
-		this->rectangle = rect;
-		this->r = red;
-		this->g = green;
-		this->b = blue;
-	}
+enum {
+	/** Size of the screen tiles the dirty regions of draw calls are binned in */
+	kDirtyTileSize = 32,
+	/** How many percent of the screen must be dirty to redraw it as a whole */
+	kDirtyFullUpdateThreshold = 75
 };
 
-
 void tglDisposeResources(TinyGL::GLContext *c) {
 	// Dispose textures and resources.
 	bool allDisposed = true;
@@ -113,17 +108,35 @@ void tglDisposeDrawCallLists(TinyGL::GLContext *c) {
 	c->_drawCallsQueue.clear();
 }
 
-static inline void _appendDirtyRectangle(const Graphics::DrawCall &call, Common::List<DirtyRectangle> &rectangles, int r, int g, int b) {
-	Common::Rect dirty_region = call.getDirtyRegion();
-	if (rectangles.empty() || dirty_region != rectangles.back().rectangle)
-		rectangles.push_back(DirtyRectangle(dirty_region, r, g, b));
+enum {
+	// Minimum number of draw calls compared by one thread
+	kDrawCallCompareChunk = 32
+};
+
+struct DrawCallPairs {
+	Common::Array<const Graphics::DrawCall *> current;
+	Common::Array<const Graphics::DrawCall *> previous;
+	Common::Array<byte> changed;
+};
+
+// Comparing draw calls only reads the state they captured, so unlike
+// executing them, it can be split across threads.
+static void compareDrawCalls(void *data, uint begin, uint end) {
+	DrawCallPairs &pairs = *(DrawCallPairs *)data;
+	for (uint i = begin; i < end; ++i)
+		pairs.changed[i] = *pairs.previous[i] != *pairs.current[i];
 }
 
 static void tglPresentBufferDirtyRects(TinyGL::GLContext *c) {
 	typedef Common::List<Graphics::DrawCall *>::const_iterator DrawCallIterator;
-	typedef Common::List<TinyGL::DirtyRectangle>::iterator RectangleIterator;
+	typedef Common::List<Common::Rect>::const_iterator RectangleIterator;
 
-	Common::List<DirtyRectangle> rectangles;
+	// Bin the regions of all draw calls that differ from the previous frame
+	// into screen tiles, which turns any number of overlapping regions into
+	// a few non-overlapping rectangles.
+	Graphics::DirtyRegion region(kDirtyTileSize, kDirtyTileSize);
+	region.setBounds(c->renderRect);
+	region.setFullUpdateThreshold(kDirtyFullUpdateThreshold);
 
 	DrawCallIterator itFrame = c->_drawCallsQueue.begin();
 	DrawCallIterator endFrame = c->_drawCallsQueue.end();
@@ -131,74 +144,40 @@ static void tglPresentBufferDirtyRects(TinyGL::GLContext *c) {
 	DrawCallIterator endPrevFrame = c->_previousFrameDrawCallsQueue.end();
 
 	// Compare draw calls.
+	DrawCallPairs pairs;
 	for ( ; itPrevFrame != endPrevFrame && itFrame != endFrame;
 		++itPrevFrame, ++itFrame) {
-			const Graphics::DrawCall &currentCall = **itFrame;
-			const Graphics::DrawCall &previousCall = **itPrevFrame;
-
-			if (previousCall != currentCall) {
-				_appendDirtyRectangle(previousCall, rectangles, 255, 255, 255);
-				_appendDirtyRectangle(currentCall, rectangles, 255, 0, 0);
-			}
+			pairs.current.push_back(*itFrame);
+			pairs.previous.push_back(*itPrevFrame);
 	}
 
-	for ( ; itPrevFrame != endPrevFrame; ++itPrevFrame) {
-		_appendDirtyRectangle(**itPrevFrame, rectangles, 255, 255, 255);
-	}
+	pairs.changed.resize(pairs.current.size());
+	c->_threadPool->runRange(&compareDrawCalls, &pairs, pairs.current.size(), kDrawCallCompareChunk);
 
-	for ( ; itFrame != endFrame; ++itFrame) {
-		_appendDirtyRectangle(**itFrame, rectangles, 255, 0, 0);
+	for (uint i = 0; i < pairs.current.size(); ++i) {
+		if (pairs.changed[i]) {
+			region.addRect(pairs.previous[i]->getDirtyRegion());
+			region.addRect(pairs.current[i]->getDirtyRegion());
+		}
 	}
 
-	// This loop increases outer rectangle coordinates to favor merging of adjacent rectangles.
-	for (RectangleIterator it = rectangles.begin(); it != rectangles.end(); ++it) {
-		(*it).rectangle.right++;
-		(*it).rectangle.bottom++;
+	for ( ; itPrevFrame != endPrevFrame; ++itPrevFrame) {
+		region.addRect((*itPrevFrame)->getDirtyRegion());
 	}
 
-	// Merge coalesce dirty rects.
-	bool restartMerge;
-	do {
-		restartMerge = false;
-		for (RectangleIterator it1 = rectangles.begin(); it1 != rectangles.end(); ++it1) {
-			for (RectangleIterator it2 = rectangles.begin(); it2 != rectangles.end();) {
-				if (it1 != it2) {
-					if ((*it1).rectangle.intersects((*it2).rectangle)) {
-						(*it1).rectangle.extend((*it2).rectangle);
-						it2 = rectangles.erase(it2);
-						restartMerge = true;
-					} else {
-						++it2;
-					}
-				} else {
-					++it2;
-				}
-			}
-		}
-	} while(restartMerge);
-
-	for (RectangleIterator it1 = rectangles.begin(); it1 != rectangles.end(); ++it1) {
-		RectangleIterator it2 = it1;
-		it2++;
-		while (it2 != rectangles.end()) {
-			if ((*it1).rectangle.contains((*it2).rectangle)) {
-				it2 = rectangles.erase(it2);
-			} else {
-				++it2;
-			}
-		}
+	for ( ; itFrame != endFrame; ++itFrame) {
+		region.addRect((*itFrame)->getDirtyRegion());
 	}
 
-	for (RectangleIterator it1 = rectangles.begin(); it1 != rectangles.end(); ++it1) {
-		(*it1).rectangle.clip(c->renderRect);
-	}
+	Common::List<Common::Rect> rectangles;
+	region.getRects(rectangles);
 
 	if (!rectangles.empty()) {
 		// Execute draw calls.
 		for (DrawCallIterator it = c->_drawCallsQueue.begin(); it != c->_drawCallsQueue.end(); ++it) {
 			Common::Rect drawCallRegion = (*it)->getDirtyRegion();
 			for (RectangleIterator itRect = rectangles.begin(); itRect != rectangles.end(); ++itRect) {
-				Common::Rect dirtyRegion = (*itRect).rectangle;
+				const Common::Rect &dirtyRegion = *itRect;
 				if (dirtyRegion.intersects(drawCallRegion)) {
 					(*it)->execute(dirtyRegion, true);
 				}
@@ -206,9 +185,6 @@ static void tglPresentBufferDirtyRects(TinyGL::GLContext *c) {
 		}
 #if TGL_DIRTY_RECT_SHOW
 		// Draw debug rectangles.
-		// Note: white rectangles are rectangle that contained other rectangles
-		// blue rectangles are rectangle merged from other rectangles
-		// red rectangles are original dirty rects
 
 		bool blendingEnabled = c->fb->isBlendingEnabled();
 		bool alphaTestEnabled = c->fb->isAlphaTestEnabled();
@@ -216,7 +192,7 @@ static void tglPresentBufferDirtyRects(TinyGL::GLContext *c) {
 		c->fb->enableAlphaTest(false);
 
 		for (RectangleIterator it = rectangles.begin(); it != rectangles.end(); ++it) {
-			tglDrawRectangle((*it).rectangle, (*it).r, (*it).g, (*it).b);
+			tglDrawRectangle(*it, 255, 0, 0);
 		}
 
 		c->fb->enableBlending(blendingEnabled);
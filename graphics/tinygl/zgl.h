@@ -42,6 +42,10 @@
 #include "graphics/tinygl/zdirtyrect.h"
 #include "graphics/tinygl/texelbuffer.h"
 
+namespace Common {
+class ThreadPool;
+}
+
 namespace TinyGL {
 
 enum {
@@ -396,6 +400,9 @@ struct GLContext {
 	Common::List<Graphics::DrawCall *> _previousFrameDrawCallsQueue;
 	int _currentAllocatorIndex;
 	LinearAllocator _drawCallAllocator[2];
+
+	// Compares the draw calls of two frames
+	Common::ThreadPool *_threadPool;
 };
 
 extern GLContext *gl_ctx;
@@ -31,10 +31,176 @@
 #include "graphics/tinygl/zbuffer.h"
 #include "graphics/tinygl/zgl.h"
 
+#if defined(__SSE2__)
+#define USE_TINYGL_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define USE_TINYGL_NEON
+#include <arm_neon.h>
+#endif
+
 namespace TinyGL {
 
 static const int NB_INTERP = 8;
 
+#if defined(USE_TINYGL_SSE2) || defined(USE_TINYGL_NEON)
+
+namespace {
+
+// Four 32 bit lanes, holding depths, color components or pixels
+
+#ifdef USE_TINYGL_SSE2
+typedef __m128i Vec;
+
+FORCEINLINE Vec vecSet(uint32 v) { return _mm_set1_epi32(v); }
+FORCEINLINE Vec vecRamp(uint32 step) { return _mm_set_epi32(step * 3, step * 2, step, 0); }
+FORCEINLINE Vec vecAdd(Vec a, Vec b) { return _mm_add_epi32(a, b); }
+FORCEINLINE Vec vecAnd(Vec a, Vec b) { return _mm_and_si128(a, b); }
+FORCEINLINE Vec vecOr(Vec a, Vec b) { return _mm_or_si128(a, b); }
+FORCEINLINE Vec vecNot(Vec a) { return _mm_xor_si128(a, _mm_set1_epi32(-1)); }
+FORCEINLINE Vec vecShiftLeft(Vec a, int n) { return _mm_sll_epi32(a, _mm_cvtsi32_si128(n)); }
+FORCEINLINE Vec vecShiftRight(Vec a, int n) { return _mm_srl_epi32(a, _mm_cvtsi32_si128(n)); }
+FORCEINLINE Vec vecEqual(Vec a, Vec b) { return _mm_cmpeq_epi32(a, b); }
+// SSE2 only compares signed, so move the unsigned range over
+FORCEINLINE Vec vecGreater(Vec a, Vec b) {
+	const Vec bias = _mm_set1_epi32((int)0x80000000);
+	return _mm_cmpgt_epi32(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+}
+// Lanes of 'a' where 'mask' is set, lanes of 'b' elsewhere
+FORCEINLINE Vec vecSelect(Vec mask, Vec a, Vec b) { return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b)); }
+FORCEINLINE Vec vecLoad(const uint32 *src) { return _mm_loadu_si128((const __m128i *)src); }
+FORCEINLINE void vecStore(uint32 *dst, Vec v) { _mm_storeu_si128((__m128i *)dst, v); }
+FORCEINLINE Vec vecLoad(const uint16 *src) { return _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i *)src), _mm_setzero_si128()); }
+// Sign extend the low halves, so that the saturating pack keeps them
+FORCEINLINE void vecStore(uint16 *dst, Vec v) {
+	v = _mm_srai_epi32(_mm_slli_epi32(v, 16), 16);
+	_mm_storel_epi64((__m128i *)dst, _mm_packs_epi32(v, v));
+}
+#else
+typedef uint32x4_t Vec;
+
+FORCEINLINE Vec vecSet(uint32 v) { return vdupq_n_u32(v); }
+FORCEINLINE Vec vecRamp(uint32 step) {
+	const uint32 ramp[4] = { 0, step, step * 2, step * 3 };
+	return vld1q_u32(ramp);
+}
+FORCEINLINE Vec vecAdd(Vec a, Vec b) { return vaddq_u32(a, b); }
+FORCEINLINE Vec vecAnd(Vec a, Vec b) { return vandq_u32(a, b); }
+FORCEINLINE Vec vecOr(Vec a, Vec b) { return vorrq_u32(a, b); }
+FORCEINLINE Vec vecNot(Vec a) { return vmvnq_u32(a); }
+FORCEINLINE Vec vecShiftLeft(Vec a, int n) { return vshlq_u32(a, vdupq_n_s32(n)); }
+FORCEINLINE Vec vecShiftRight(Vec a, int n) { return vshlq_u32(a, vdupq_n_s32(-n)); }
+FORCEINLINE Vec vecEqual(Vec a, Vec b) { return vceqq_u32(a, b); }
+FORCEINLINE Vec vecGreater(Vec a, Vec b) { return vcgtq_u32(a, b); }
+FORCEINLINE Vec vecSelect(Vec mask, Vec a, Vec b) { return vbslq_u32(mask, a, b); }
+FORCEINLINE Vec vecLoad(const uint32 *src) { return vld1q_u32(src); }
+FORCEINLINE void vecStore(uint32 *dst, Vec v) { vst1q_u32(dst, v); }
+FORCEINLINE Vec vecLoad(const uint16 *src) { return vmovl_u16(vld1_u16(src)); }
+FORCEINLINE void vecStore(uint16 *dst, Vec v) { vst1_u16(dst, vmovn_u32(v)); }
+#endif
+
+// The lanes passing the depth test, as FrameBuffer::compareDepth() does it
+FORCEINLINE Vec vecCompareDepth(int depthFunc, Vec zSrc, Vec zDst) {
+	switch (depthFunc) {
+	case TGL_LESS:
+		return vecGreater(zSrc, zDst);
+	case TGL_EQUAL:
+		return vecEqual(zDst, zSrc);
+	case TGL_LEQUAL:
+		return vecNot(vecGreater(zDst, zSrc));
+	case TGL_GREATER:
+		return vecGreater(zDst, zSrc);
+	case TGL_NOTEQUAL:
+		return vecNot(vecEqual(zDst, zSrc));
+	case TGL_GEQUAL:
+		return vecNot(vecGreater(zSrc, zDst));
+	case TGL_ALWAYS:
+		return vecSet(0xFFFFFFFF);
+	default:
+		return vecSet(0);
+	}
+}
+
+// Gouraud interpolated components in the given pixel format
+FORCEINLINE Vec vecPackComponent(Vec c, int interpBits, int loss, int shift) {
+	return vecShiftLeft(vecShiftRight(vecAnd(vecShiftRight(c, interpBits - 8), vecSet(0xFF)), loss), shift);
+}
+
+template <typename Pixel, int kDrawLogic, bool kDepthWrite>
+int fillSpanVectorT(Pixel *dst, uint32 *pz, int count, bool depthTest, int depthFunc, const Graphics::PixelFormat &format,
+					unsigned int &z, int dzdx, unsigned int &r, unsigned int &g, unsigned int &b, unsigned int &a,
+					int drdx, int dgdx, int dbdx, int dadx) {
+	const int done = count & ~3;
+	Vec vz = vecAdd(vecSet(z), vecRamp(dzdx));
+	Vec vr = vecAdd(vecSet(r), vecRamp(drdx));
+	Vec vg = vecAdd(vecSet(g), vecRamp(dgdx));
+	Vec vb = vecAdd(vecSet(b), vecRamp(dbdx));
+	Vec va = vecAdd(vecSet(a), vecRamp(dadx));
+	const Vec stepZ = vecSet(dzdx * 4u), stepR = vecSet(drdx * 4u), stepG = vecSet(dgdx * 4u);
+	const Vec stepB = vecSet(dbdx * 4u), stepA = vecSet(dadx * 4u);
+	const Vec flatColor = vecSet(format.ARGBToColor(a >> (ZB_POINT_ALPHA_BITS - 8), r >> (ZB_POINT_RED_BITS - 8),
+	                                                g >> (ZB_POINT_GREEN_BITS - 8), b >> (ZB_POINT_BLUE_BITS - 8)));
+
+	for (int i = 0; i < done; i += 4) {
+		const Vec zDst = vecLoad(pz + i);
+		const Vec mask = depthTest ? vecCompareDepth(depthFunc, vz, zDst) : vecSet(0xFFFFFFFF);
+		if (kDepthWrite)
+			vecStore(pz + i, vecSelect(mask, vz, zDst));
+
+		if (kDrawLogic == DRAW_FLAT) {
+			vecStore(dst + i, vecSelect(mask, flatColor, vecLoad(dst + i)));
+		} else if (kDrawLogic == DRAW_SMOOTH) {
+			const Vec color = vecOr(vecOr(vecPackComponent(va, ZB_POINT_ALPHA_BITS, format.aLoss, format.aShift),
+			                              vecPackComponent(vr, ZB_POINT_RED_BITS, format.rLoss, format.rShift)),
+			                        vecOr(vecPackComponent(vg, ZB_POINT_GREEN_BITS, format.gLoss, format.gShift),
+			                              vecPackComponent(vb, ZB_POINT_BLUE_BITS, format.bLoss, format.bShift)));
+			vecStore(dst + i, vecSelect(mask, color, vecLoad(dst + i)));
+			vr = vecAdd(vr, stepR);
+			vg = vecAdd(vg, stepG);
+			vb = vecAdd(vb, stepB);
+			va = vecAdd(va, stepA);
+		}
+		vz = vecAdd(vz, stepZ);
+	}
+
+	z += (unsigned int)dzdx * done;
+	if (kDrawLogic == DRAW_SMOOTH) {
+		r += (unsigned int)drdx * done;
+		g += (unsigned int)dgdx * done;
+		b += (unsigned int)dbdx * done;
+		a += (unsigned int)dadx * done;
+	}
+	return done;
+}
+
+} // End of anonymous namespace
+
+template <int kDrawLogic, bool kDepthWrite>
+FORCEINLINE int FrameBuffer::fillSpanVector(int pixel, int count, unsigned int &z, int dzdx,
+											unsigned int &r, unsigned int &g, unsigned int &b, unsigned int &a,
+											int drdx, int dgdx, int dbdx, int dadx) {
+	const Graphics::PixelFormat &format = pbuf.getFormat();
+	if (kDrawLogic == DRAW_DEPTH_ONLY || format.bytesPerPixel == 4) {
+		return fillSpanVectorT<uint32, kDrawLogic, kDepthWrite>((uint32 *)pbuf.getRawBuffer(pixel), _zbuf + pixel, count, _depthTestEnabled, _depthFunc,
+		                                                        format, z, dzdx, r, g, b, a, drdx, dgdx, dbdx, dadx);
+	} else if (format.bytesPerPixel == 2) {
+		return fillSpanVectorT<uint16, kDrawLogic, kDepthWrite>((uint16 *)pbuf.getRawBuffer(pixel), _zbuf + pixel, count, _depthTestEnabled, _depthFunc,
+		                                                        format, z, dzdx, r, g, b, a, drdx, dgdx, dbdx, dadx);
+	}
+	return 0;
+}
+
+#else
+
+template <int kDrawLogic, bool kDepthWrite>
+FORCEINLINE int FrameBuffer::fillSpanVector(int pixel, int count, unsigned int &z, int dzdx,
+											unsigned int &r, unsigned int &g, unsigned int &b, unsigned int &a,
+											int drdx, int dgdx, int dbdx, int dadx) {
+	return 0;
+}
+
+#endif
+
 template <bool kDepthWrite, bool kEnableAlphaTest, bool kEnableScissor, bool kEnableBlending>
 FORCEINLINE static void putPixelFlat(FrameBuffer *buffer, int buf, unsigned int *pz, int _a,
 									 int x, int y, unsigned int &z, unsigned int &r, unsigned int &g, unsigned int &b, unsigned int &a, int &dzdx) {
@@ -381,6 +547,14 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 					if (kDrawLogic == DRAW_FLAT) {
 						a = a1;
 					}
+					if (!kEnableScissor && !kAlphaTestEnabled && !kBlendingEnabled) {
+						const int done = fillSpanVector<kDrawLogic, kDepthWrite>(pp, n + 1, z, dzdx, r, g, b, a, 0, 0, 0, 0);
+						pz += done;
+						pp += done;
+						buf += done;
+						n -= done;
+						x += done;
+					}
 					while (n >= 3) {
 						if (kDrawLogic == DRAW_DEPTH_ONLY) {
 							putPixelDepth<kDepthWrite, kEnableScissor>(this, buf, pz, 0, x, y, z, dzdx);
@@ -392,7 +566,7 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 						if (kDrawLogic == DRAW_FLAT) {
 							putPixelFlat<kDepthWrite, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled>(this, pp, pz, 0, x, y, z, r, g, b, a, dzdx);
 							putPixelFlat<kDepthWrite, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled>(this, pp, pz, 1, x, y, z, r, g, b, a, dzdx);
-							putPixelFlat<kDepthWrite, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled>(this, pp, pz, 2, x, y, z, r, g, g, a, dzdx);
+							putPixelFlat<kDepthWrite, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled>(this, pp, pz, 2, x, y, z, r, g, b, a, dzdx);
 							putPixelFlat<kDepthWrite, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled>(this, pp, pz, 3, x, y, z, r, g, b, a, dzdx);
 						}
 						if (kInterpZ) {
@@ -485,6 +659,13 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 					g = g1;
 					b = b1;
 					a = a1;
+					if (!kEnableScissor && !kAlphaTestEnabled && !kBlendingEnabled) {
+						const int done = fillSpanVector<kDrawLogic, kDepthWrite>(buf, n + 1, z, dzdx, r, g, b, a, drdx, dgdx, dbdx, dadx);
+						pz += done;
+						buf += done;
+						n -= done;
+						x += done;
+					}
 					while (n >= 3) {
 						putPixelSmooth<kDepthWrite, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled>(this, buf, pz, 0, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx);
 						putPixelSmooth<kDepthWrite, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled>(this, buf, pz, 1, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx);
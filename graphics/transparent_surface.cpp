@@ -33,6 +33,14 @@
 #include "graphics/transparent_surface.h"
 #include "graphics/transform_tools.h"
 
+#if defined(__SSE2__)
+#define USE_BLIT_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define USE_BLIT_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Graphics {
 
 static const int kBModShift = 8;//img->format.bShift;
@@ -53,6 +61,244 @@ static const int kGIndex = 1;
 static const int kRIndex = 0;
 #endif
 
+#if defined(USE_BLIT_SSE2) || defined(USE_BLIT_NEON)
+
+namespace {
+
+/*
+ * Vectorised versions of the inner loops of doBlitOpaqueFast,
+ * doBlitBinaryFast and doBlitAlphaBlend, handling four pixels at a time.
+ * They give exactly the same results as the scalar loops, which still
+ * handle the pixels left over at the end of each line.
+ *
+ * The alpha component is always the lowest byte of a pixel read as a
+ * native uint32, and the color modulation uses the same layout.
+ */
+
+#ifdef USE_BLIT_SSE2
+
+typedef __m128i PixelVector;
+
+template<bool flipH>
+inline PixelVector loadPixels(const byte *in) {
+	// Pixels to the left of 'in' are drawn first when flipping
+	if (flipH)
+		return _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)(in - 12)), _MM_SHUFFLE(0, 1, 2, 3));
+	return _mm_loadu_si128((const __m128i *)in);
+}
+
+inline void storePixels(byte *out, PixelVector pixels) {
+	_mm_storeu_si128((__m128i *)out, pixels);
+}
+
+/** Pick the pixels of 'a' where 'mask' is set, and those of 'b' elsewhere. */
+inline PixelVector selectPixels(PixelVector mask, PixelVector a, PixelVector b) {
+	return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+struct OpaqueBlit {
+	PixelVector operator()(PixelVector src, PixelVector dst) const {
+		return _mm_or_si128(src, _mm_set1_epi32(0xFF));
+	}
+};
+
+struct BinaryBlit {
+	PixelVector operator()(PixelVector src, PixelVector dst) const {
+		const __m128i alphaMask = _mm_set1_epi32(0xFF);
+		const __m128i transparent = _mm_cmpeq_epi32(_mm_and_si128(src, alphaMask), _mm_setzero_si128());
+		return selectPixels(transparent, dst, _mm_or_si128(src, alphaMask));
+	}
+};
+
+struct AlphaBlendBlit {
+	static __m128i blend(__m128i src, __m128i dst) {
+		const __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src, 0), 0);
+		const __m128i sum = _mm_add_epi16(_mm_mullo_epi16(src, alpha),
+		                                  _mm_mullo_epi16(dst, _mm_sub_epi16(_mm_set1_epi16(255), alpha)));
+		return _mm_srli_epi16(sum, 8);
+	}
+
+	PixelVector operator()(PixelVector src, PixelVector dst) const {
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i alphaMask = _mm_set1_epi32(0xFF);
+		const __m128i lo = blend(_mm_unpacklo_epi8(src, zero), _mm_unpacklo_epi8(dst, zero));
+		const __m128i hi = blend(_mm_unpackhi_epi8(src, zero), _mm_unpackhi_epi8(dst, zero));
+
+		const __m128i transparent = _mm_cmpeq_epi32(_mm_and_si128(src, alphaMask), zero);
+		return selectPixels(transparent, dst, _mm_or_si128(_mm_packus_epi16(lo, hi), alphaMask));
+	}
+};
+
+struct ModulatedAlphaBlendBlit {
+	explicit ModulatedAlphaBlendBlit(uint32 color)
+		: _alphaMod(_mm_set1_epi16(color & 0xFF)),
+		  _colorMod(_mm_unpacklo_epi8(_mm_set1_epi32(color), _mm_setzero_si128())) {}
+
+	/** The effective alpha of the two pixels, in all of their components */
+	__m128i alpha(__m128i src) const {
+		const __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src, 0), 0);
+		return _mm_srli_epi16(_mm_mullo_epi16(alpha, _alphaMod), 8);
+	}
+
+	__m128i blend(__m128i src, __m128i dst, __m128i alpha) const {
+		const __m128i faded = _mm_srli_epi16(_mm_mullo_epi16(dst, _mm_sub_epi16(_mm_set1_epi16(255), alpha)), 8);
+		// (src * alpha * mod) >> 16, with the first product fitting into 16 bits
+		return _mm_add_epi16(faded, _mm_mulhi_epu16(_mm_mullo_epi16(src, alpha), _colorMod));
+	}
+
+	PixelVector operator()(PixelVector src, PixelVector dst) const {
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i srcLo = _mm_unpacklo_epi8(src, zero);
+		const __m128i srcHi = _mm_unpackhi_epi8(src, zero);
+		const __m128i alphaLo = alpha(srcLo);
+		const __m128i alphaHi = alpha(srcHi);
+
+		const __m128i lo = blend(srcLo, _mm_unpacklo_epi8(dst, zero), alphaLo);
+		const __m128i hi = blend(srcHi, _mm_unpackhi_epi8(dst, zero), alphaHi);
+
+		const __m128i transparent = _mm_cmpeq_epi32(_mm_packus_epi16(alphaLo, alphaHi), zero);
+		return selectPixels(transparent, dst, _mm_or_si128(_mm_packus_epi16(lo, hi), _mm_set1_epi32(0xFF)));
+	}
+
+	const __m128i _alphaMod;
+	const __m128i _colorMod;
+};
+
+#else
+
+typedef uint32x4_t PixelVector;
+
+template<bool flipH>
+inline PixelVector loadPixels(const byte *in) {
+	// Pixels to the left of 'in' are drawn first when flipping
+	if (flipH) {
+		const uint32x4_t pixels = vrev64q_u32(vld1q_u32((const uint32 *)(in - 12)));
+		return vcombine_u32(vget_high_u32(pixels), vget_low_u32(pixels));
+	}
+	return vld1q_u32((const uint32 *)in);
+}
+
+inline void storePixels(byte *out, PixelVector pixels) {
+	vst1q_u32((uint32 *)out, pixels);
+}
+
+/** Repeat the lowest byte of each pixel in all of its bytes. */
+inline uint8x16_t spreadAlpha(uint32x4_t alpha) {
+	return vreinterpretq_u8_u32(vmulq_n_u32(alpha, 0x01010101));
+}
+
+struct OpaqueBlit {
+	PixelVector operator()(PixelVector src, PixelVector dst) const {
+		return vorrq_u32(src, vdupq_n_u32(0xFF));
+	}
+};
+
+struct BinaryBlit {
+	PixelVector operator()(PixelVector src, PixelVector dst) const {
+		const uint32x4_t alphaMask = vdupq_n_u32(0xFF);
+		const uint32x4_t transparent = vceqq_u32(vandq_u32(src, alphaMask), vdupq_n_u32(0));
+		return vbslq_u32(transparent, dst, vorrq_u32(src, alphaMask));
+	}
+};
+
+struct AlphaBlendBlit {
+	PixelVector operator()(PixelVector src, PixelVector dst) const {
+		const uint32x4_t alphaMask = vdupq_n_u32(0xFF);
+		const uint8x16_t src8 = vreinterpretq_u8_u32(src);
+		const uint8x16_t dst8 = vreinterpretq_u8_u32(dst);
+		const uint8x16_t alpha = spreadAlpha(vandq_u32(src, alphaMask));
+		const uint8x16_t invAlpha = vmvnq_u8(alpha);
+
+		const uint16x8_t lo = vmlal_u8(vmull_u8(vget_low_u8(src8), vget_low_u8(alpha)), vget_low_u8(dst8), vget_low_u8(invAlpha));
+		const uint16x8_t hi = vmlal_u8(vmull_u8(vget_high_u8(src8), vget_high_u8(alpha)), vget_high_u8(dst8), vget_high_u8(invAlpha));
+		const uint32x4_t result = vreinterpretq_u32_u8(vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8)));
+
+		const uint32x4_t transparent = vceqq_u32(vandq_u32(src, alphaMask), vdupq_n_u32(0));
+		return vbslq_u32(transparent, dst, vorrq_u32(result, alphaMask));
+	}
+};
+
+struct ModulatedAlphaBlendBlit {
+	explicit ModulatedAlphaBlendBlit(uint32 color)
+		: _alphaMod(color & 0xFF), _colorMod(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(color)))) {}
+
+	/** (src * alpha * mod) >> 16 for two pixels, with the first product fitting into 16 bits */
+	uint8x8_t modulate(uint8x8_t src, uint8x8_t alpha) const {
+		const uint16x8_t product = vmull_u8(src, alpha);
+		const uint16x4_t lo = vshrn_n_u32(vmull_u16(vget_low_u16(product), vget_low_u16(_colorMod)), 16);
+		const uint16x4_t hi = vshrn_n_u32(vmull_u16(vget_high_u16(product), vget_high_u16(_colorMod)), 16);
+		return vmovn_u16(vcombine_u16(lo, hi));
+	}
+
+	PixelVector operator()(PixelVector src, PixelVector dst) const {
+		const uint32x4_t alphaMask = vdupq_n_u32(0xFF);
+		const uint32x4_t alpha32 = vshrq_n_u32(vmulq_n_u32(vandq_u32(src, alphaMask), _alphaMod), 8);
+		const uint8x16_t src8 = vreinterpretq_u8_u32(src);
+		const uint8x16_t dst8 = vreinterpretq_u8_u32(dst);
+		const uint8x16_t alpha = spreadAlpha(alpha32);
+		const uint8x16_t invAlpha = vmvnq_u8(alpha);
+
+		const uint8x8_t lo = vadd_u8(vshrn_n_u16(vmull_u8(vget_low_u8(dst8), vget_low_u8(invAlpha)), 8),
+		                             modulate(vget_low_u8(src8), vget_low_u8(alpha)));
+		const uint8x8_t hi = vadd_u8(vshrn_n_u16(vmull_u8(vget_high_u8(dst8), vget_high_u8(invAlpha)), 8),
+		                             modulate(vget_high_u8(src8), vget_high_u8(alpha)));
+		const uint32x4_t result = vreinterpretq_u32_u8(vcombine_u8(lo, hi));
+
+		const uint32x4_t transparent = vceqq_u32(alpha32, vdupq_n_u32(0));
+		return vbslq_u32(transparent, dst, vorrq_u32(result, alphaMask));
+	}
+
+	const uint32 _alphaMod;
+	const uint16x8_t _colorMod;
+};
+
+#endif
+
+template<bool flipH, class Blit>
+uint32 blitPixels(const byte *in, byte *out, uint32 width, const Blit &blit) {
+	uint32 j = 0;
+	for (; j + 4 <= width; j += 4) {
+		storePixels(out, blit(loadPixels<flipH>(in), loadPixels<false>(out)));
+		in += flipH ? -16 : 16;
+		out += 16;
+	}
+	return j;
+}
+
+/**
+ * Blit as many pixels of a line as possible four at a time, returning how
+ * many were done. The flipping is resolved here, once per line.
+ */
+template<class Blit>
+inline uint32 blitLine(const byte *in, byte *out, uint32 width, int32 inStep, const Blit &blit) {
+	if (inStep < 0)
+		return blitPixels<true>(in, out, width, blit);
+	return blitPixels<false>(in, out, width, blit);
+}
+
+} // End of anonymous namespace
+
+#else
+
+namespace {
+
+struct OpaqueBlit {};
+struct BinaryBlit {};
+struct AlphaBlendBlit {};
+struct ModulatedAlphaBlendBlit {
+	explicit ModulatedAlphaBlendBlit(uint32 color) {}
+};
+
+/** Without SIMD support all pixels are blitted by the scalar loops. */
+template<class Blit>
+inline uint32 blitLine(const byte *in, byte *out, uint32 width, int32 inStep, const Blit &blit) {
+	return 0;
+}
+
+} // End of anonymous namespace
+
+#endif
+
 void doBlitOpaqueFast(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep);
 void doBlitBinaryFast(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep);
 void doBlitAlphaBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color);
@@ -88,10 +334,14 @@ void doBlitOpaqueFast(byte *ino, byte *outo, uint32 width, uint32 height, uint32
 	for (uint32 i = 0; i < height; i++) {
 		out = outo;
 		in = ino;
-		memcpy(out, in, width * 4);
-		for (uint32 j = 0; j < width; j++) {
+		uint32 j = blitLine(in, out, width, inStep, OpaqueBlit());
+		in += (int32)j * inStep;
+		out += j * 4;
+		for (; j < width; j++) {
+			*(uint32 *)out = *(uint32 *)in;
 			out[kAIndex] = 0xFF;
 			out += 4;
+			in += inStep;
 		}
 		outo += pitch;
 		ino += inoStep;
@@ -109,7 +359,10 @@ void doBlitBinaryFast(byte *ino, byte *outo, uint32 width, uint32 height, uint32
 	for (uint32 i = 0; i < height; i++) {
 		out = outo;
 		in = ino;
-		for (uint32 j = 0; j < width; j++) {
+		uint32 j = blitLine(in, out, width, inStep, BinaryBlit());
+		in += (int32)j * inStep;
+		out += j * 4;
+		for (; j < width; j++) {
 			uint32 pix = *(uint32 *)in;
 			int a = in[kAIndex];
 
@@ -145,7 +398,10 @@ void doBlitAlphaBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			uint32 j = blitLine(in, out, width, inStep, AlphaBlendBlit());
+			in += (int32)j * inStep;
+			out += j * 4;
+			for (; j < width; j++) {
 
 				if (in[kAIndex] != 0) {
 					out[kAIndex] = 255;
@@ -166,11 +422,15 @@ void doBlitAlphaBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32
 		byte cr = (color >> kRModShift) & 0xFF;
 		byte cg = (color >> kGModShift) & 0xFF;
 		byte cb = (color >> kBModShift) & 0xFF;
+		const ModulatedAlphaBlendBlit blit(color);
 
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			uint32 j = blitLine(in, out, width, inStep, blit);
+			in += (int32)j * inStep;
+			out += j * 4;
+			for (; j < width; j++) {
 
 				uint32 ina = in[kAIndex] * ca >> 8;
 
@@ -740,35 +1000,14 @@ void TransparentSurface::setAlphaMode(AlphaType mode) {
 }
 
 TransparentSurface *TransparentSurface::scale(int16 newWidth, int16 newHeight, bool filtering) const {
-
 	TransparentSurface *target = new TransparentSurface();
-
-	target->create(newWidth, newHeight, format);
-
-	if (filtering) {
-		scaleBlitBilinear((byte *)target->getPixels(), (const byte *)getPixels(), target->pitch, pitch, target->w, target->h, w, h, format);
-	} else {
-		scaleBlit((byte *)target->getPixels(), (const byte *)getPixels(), target->pitch, pitch, target->w, target->h, w, h, format);
-	}
-
+	Surface::scale(*target, newWidth, newHeight, filtering);
 	return target;
 }
 
 TransparentSurface *TransparentSurface::rotoscale(const TransformStruct &transform, bool filtering) const {
-
-	Common::Point newHotspot;
-	Common::Rect rect = TransformTools::newRect(Common::Rect((int16)w, (int16)h), transform, &newHotspot);
-
 	TransparentSurface *target = new TransparentSurface();
-
-	target->create((uint16)rect.right - rect.left, (uint16)rect.bottom - rect.top, this->format);
-
-	if (filtering) {
-		rotoscaleBlitBilinear((byte *)target->getPixels(), (const byte *)getPixels(), target->pitch, pitch, target->w, target->h, w, h, format, transform, newHotspot);
-	} else {
-		rotoscaleBlit((byte *)target->getPixels(), (const byte *)getPixels(), target->pitch, pitch, target->w, target->h, w, h, format, transform, newHotspot);
-	}
-
+	Surface::rotoscale(*target, transform, filtering);
 	return target;
 }
 
@@ -145,6 +145,7 @@ struct TransparentSurface : public Graphics::Surface {
 	 * @see TransformStruct
 	 */
 	TransparentSurface *scale(int16 newWidth, int16 newHeight, bool filtering = false) const;
+	using Surface::scale;
 
 	/**
 	 * @brief Rotoscale function; this returns a transformed version of this surface after rotation and
@@ -155,6 +156,7 @@ struct TransparentSurface : public Graphics::Surface {
 	 *
 	 */
 	TransparentSurface *rotoscale(const TransformStruct &transform, bool filtering = false) const;
+	using Surface::rotoscale;
 
 	TransparentSurface *convertTo(const PixelFormat &dstFormat, const byte *palette = 0) const;
 
@@ -86,6 +86,17 @@
 #include "graphics/surface.h"
 #include "graphics/yuv_to_rgb.h"
 
+#include "common/endian.h"
+#include "common/threadpool.h"
+
+#if defined(__SSE2__)
+#define USE_YUV_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define USE_YUV_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Common {
 DECLARE_SINGLETON(Graphics::YUVToRGBManager);
 }
@@ -203,6 +214,304 @@ const YUVToRGBLookup *YUVToRGBManager::getLookup(Graphics::PixelFormat format, Y
 	return _lookup;
 }
 
+#if defined(USE_YUV_SSE2) || defined(USE_YUV_NEON)
+
+namespace {
+
+#ifdef USE_YUV_SSE2
+
+typedef __m128i YUVVector;
+
+inline YUVVector vecSet(int16 value) { return _mm_set1_epi16(value); }
+inline YUVVector vecSetHalves(int16 lo, int16 hi) { return _mm_unpacklo_epi64(_mm_set1_epi16(lo), _mm_set1_epi16(hi)); }
+inline YUVVector vecSetQuarters() { return _mm_set_epi16(3, 2, 1, 0, 3, 2, 1, 0); }
+inline YUVVector vecAdd(YUVVector a, YUVVector b) { return _mm_add_epi16(a, b); }
+inline YUVVector vecSub(YUVVector a, YUVVector b) { return _mm_sub_epi16(a, b); }
+inline YUVVector vecMul(YUVVector a, YUVVector b) { return _mm_mullo_epi16(a, b); }
+inline YUVVector vecMin(YUVVector a, YUVVector b) { return _mm_min_epi16(a, b); }
+inline YUVVector vecMax(YUVVector a, YUVVector b) { return _mm_max_epi16(a, b); }
+inline YUVVector vecXor(YUVVector a, YUVVector b) { return _mm_xor_si128(a, b); }
+inline YUVVector vecShiftRight4(YUVVector a) { return _mm_srai_epi16(a, 4); }
+/** Return -1 for negative values, and 0 otherwise. */
+inline YUVVector vecSign(YUVVector a) { return _mm_srai_epi16(a, 15); }
+
+/** Load 8 bytes, widened to 16 bits. */
+inline YUVVector vecLoad8(const byte *src) {
+	return _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)src), _mm_setzero_si128());
+}
+
+/** Load 4 bytes, each repeated once and widened to 16 bits. */
+inline YUVVector vecLoad4Doubled(const byte *src) {
+	const __m128i in = _mm_cvtsi32_si128((int)READ_UINT32(src));
+	return _mm_unpacklo_epi8(_mm_unpacklo_epi8(in, in), _mm_setzero_si128());
+}
+
+/** Return the high 16 bits of (a << 2) * b, with a in [0, 128]. */
+inline YUVVector vecMulHigh4(YUVVector a, YUVVector b) {
+	return _mm_mulhi_epi16(_mm_slli_epi16(a, 2), b);
+}
+
+/** Return a * 255 / 219 for a in [0, 219], which (a << 3) * 9539 >> 16 is exact for. */
+inline YUVVector vecExpandITU(YUVVector a) {
+	return _mm_mulhi_epi16(_mm_slli_epi16(a, 3), _mm_set1_epi16(9539));
+}
+
+/** The shifts placing 8 bit color components into a pixel format. */
+struct YUVVectorFormat {
+	__m128i rLoss, gLoss, bLoss;
+	__m128i rShift, gShift, bShift;
+	__m128i alpha16, alpha32;
+
+	explicit YUVVectorFormat(const PixelFormat &format) {
+		rLoss = _mm_cvtsi32_si128(format.rLoss);
+		gLoss = _mm_cvtsi32_si128(format.gLoss);
+		bLoss = _mm_cvtsi32_si128(format.bLoss);
+		rShift = _mm_cvtsi32_si128(format.rShift);
+		gShift = _mm_cvtsi32_si128(format.gShift);
+		bShift = _mm_cvtsi32_si128(format.bShift);
+		alpha16 = _mm_set1_epi16((int16)format.ARGBToColor(255, 0, 0, 0));
+		alpha32 = _mm_set1_epi32(format.ARGBToColor(255, 0, 0, 0));
+	}
+
+	inline void store(uint16 *dst, YUVVector r, YUVVector g, YUVVector b) const {
+		__m128i pixels = _mm_or_si128(alpha16, _mm_sll_epi16(_mm_srl_epi16(r, rLoss), rShift));
+		pixels = _mm_or_si128(pixels, _mm_sll_epi16(_mm_srl_epi16(g, gLoss), gShift));
+		pixels = _mm_or_si128(pixels, _mm_sll_epi16(_mm_srl_epi16(b, bLoss), bShift));
+		_mm_storeu_si128((__m128i *)dst, pixels);
+	}
+
+	inline void store(uint32 *dst, YUVVector r, YUVVector g, YUVVector b) const {
+		const __m128i zero = _mm_setzero_si128();
+		r = _mm_srl_epi16(r, rLoss);
+		g = _mm_srl_epi16(g, gLoss);
+		b = _mm_srl_epi16(b, bLoss);
+
+		__m128i lo = _mm_or_si128(alpha32, _mm_sll_epi32(_mm_unpacklo_epi16(r, zero), rShift));
+		lo = _mm_or_si128(lo, _mm_sll_epi32(_mm_unpacklo_epi16(g, zero), gShift));
+		lo = _mm_or_si128(lo, _mm_sll_epi32(_mm_unpacklo_epi16(b, zero), bShift));
+		__m128i hi = _mm_or_si128(alpha32, _mm_sll_epi32(_mm_unpackhi_epi16(r, zero), rShift));
+		hi = _mm_or_si128(hi, _mm_sll_epi32(_mm_unpackhi_epi16(g, zero), gShift));
+		hi = _mm_or_si128(hi, _mm_sll_epi32(_mm_unpackhi_epi16(b, zero), bShift));
+
+		_mm_storeu_si128((__m128i *)dst, lo);
+		_mm_storeu_si128((__m128i *)(dst + 4), hi);
+	}
+};
+
+#else
+
+typedef int16x8_t YUVVector;
+
+inline YUVVector vecSet(int16 value) { return vdupq_n_s16(value); }
+inline YUVVector vecSetHalves(int16 lo, int16 hi) { return vcombine_s16(vdup_n_s16(lo), vdup_n_s16(hi)); }
+inline YUVVector vecSetQuarters() {
+	static const int16 quarters[8] = { 0, 1, 2, 3, 0, 1, 2, 3 };
+	return vld1q_s16(quarters);
+}
+inline YUVVector vecAdd(YUVVector a, YUVVector b) { return vaddq_s16(a, b); }
+inline YUVVector vecSub(YUVVector a, YUVVector b) { return vsubq_s16(a, b); }
+inline YUVVector vecMul(YUVVector a, YUVVector b) { return vmulq_s16(a, b); }
+inline YUVVector vecMin(YUVVector a, YUVVector b) { return vminq_s16(a, b); }
+inline YUVVector vecMax(YUVVector a, YUVVector b) { return vmaxq_s16(a, b); }
+inline YUVVector vecXor(YUVVector a, YUVVector b) { return veorq_s16(a, b); }
+inline YUVVector vecShiftRight4(YUVVector a) { return vshrq_n_s16(a, 4); }
+/** Return -1 for negative values, and 0 otherwise. */
+inline YUVVector vecSign(YUVVector a) { return vshrq_n_s16(a, 15); }
+
+/** Load 8 bytes, widened to 16 bits. */
+inline YUVVector vecLoad8(const byte *src) {
+	return vreinterpretq_s16_u16(vmovl_u8(vld1_u8(src)));
+}
+
+/** Load 4 bytes, each repeated once and widened to 16 bits. */
+inline YUVVector vecLoad4Doubled(const byte *src) {
+	const uint8x8_t in = vreinterpret_u8_u32(vdup_n_u32(READ_UINT32(src)));
+	return vreinterpretq_s16_u16(vmovl_u8(vzip_u8(in, in).val[0]));
+}
+
+/** Return the high 16 bits of (a << 2) * b, with a in [0, 128]. */
+inline YUVVector vecMulHigh4(YUVVector a, YUVVector b) {
+	// The doubling multiplication does not saturate for these values
+	return vqdmulhq_s16(vshlq_n_s16(a, 1), b);
+}
+
+/** Return a * 255 / 219 for a in [0, 219], which (a << 3) * 9539 >> 16 is exact for. */
+inline YUVVector vecExpandITU(YUVVector a) {
+	return vqdmulhq_s16(vshlq_n_s16(a, 2), vdupq_n_s16(9539));
+}
+
+/** The shifts placing 8 bit color components into a pixel format. */
+struct YUVVectorFormat {
+	// NEON shifts right by shifting left by a negative amount
+	int16x8_t rLoss, gLoss, bLoss;
+	int16x8_t rShift16, gShift16, bShift16;
+	int32x4_t rShift32, gShift32, bShift32;
+	uint16x8_t alpha16;
+	uint32x4_t alpha32;
+
+	explicit YUVVectorFormat(const PixelFormat &format) {
+		rLoss = vdupq_n_s16(-(int16)format.rLoss);
+		gLoss = vdupq_n_s16(-(int16)format.gLoss);
+		bLoss = vdupq_n_s16(-(int16)format.bLoss);
+		rShift16 = vdupq_n_s16(format.rShift);
+		gShift16 = vdupq_n_s16(format.gShift);
+		bShift16 = vdupq_n_s16(format.bShift);
+		rShift32 = vdupq_n_s32(format.rShift);
+		gShift32 = vdupq_n_s32(format.gShift);
+		bShift32 = vdupq_n_s32(format.bShift);
+		alpha16 = vdupq_n_u16((uint16)format.ARGBToColor(255, 0, 0, 0));
+		alpha32 = vdupq_n_u32(format.ARGBToColor(255, 0, 0, 0));
+	}
+
+	inline void store(uint16 *dst, YUVVector r, YUVVector g, YUVVector b) const {
+		uint16x8_t pixels = vorrq_u16(alpha16, vshlq_u16(vshlq_u16(vreinterpretq_u16_s16(r), rLoss), rShift16));
+		pixels = vorrq_u16(pixels, vshlq_u16(vshlq_u16(vreinterpretq_u16_s16(g), gLoss), gShift16));
+		pixels = vorrq_u16(pixels, vshlq_u16(vshlq_u16(vreinterpretq_u16_s16(b), bLoss), bShift16));
+		vst1q_u16(dst, pixels);
+	}
+
+	inline void store(uint32 *dst, YUVVector r, YUVVector g, YUVVector b) const {
+		const uint16x8_t r16 = vshlq_u16(vreinterpretq_u16_s16(r), rLoss);
+		const uint16x8_t g16 = vshlq_u16(vreinterpretq_u16_s16(g), gLoss);
+		const uint16x8_t b16 = vshlq_u16(vreinterpretq_u16_s16(b), bLoss);
+
+		uint32x4_t lo = vorrq_u32(alpha32, vshlq_u32(vmovl_u16(vget_low_u16(r16)), rShift32));
+		lo = vorrq_u32(lo, vshlq_u32(vmovl_u16(vget_low_u16(g16)), gShift32));
+		lo = vorrq_u32(lo, vshlq_u32(vmovl_u16(vget_low_u16(b16)), bShift32));
+		uint32x4_t hi = vorrq_u32(alpha32, vshlq_u32(vmovl_u16(vget_high_u16(r16)), rShift32));
+		hi = vorrq_u32(hi, vshlq_u32(vmovl_u16(vget_high_u16(g16)), gShift32));
+		hi = vorrq_u32(hi, vshlq_u32(vmovl_u16(vget_high_u16(b16)), bShift32));
+
+		vst1q_u32(dst, lo);
+		vst1q_u32(dst + 4, hi);
+	}
+};
+
+#endif
+
+/**
+ * Converts YUV to RGB eight pixels at a time, with the same results as the
+ * lookup tables.
+ *
+ * The color table entries are the chroma value times a constant, with the
+ * fraction dropped. This is computed on the magnitude of the chroma value
+ * with 14 bits of fraction, which is exact for all 256 values.
+ */
+class YUVVectorConverter {
+public:
+	YUVVectorConverter(const PixelFormat &format, YUVToRGBManager::LuminanceScale scale)
+		: _format(format), _itu(scale == YUVToRGBManager::kScaleITU) {
+	}
+
+	struct Chroma {
+		YUVVector r, g, b;
+	};
+
+	/**
+	 * Compute what Cr_r_tab and Cb_b_tab add to the luminance, and what
+	 * Cr_g_tab and Cb_g_tab subtract from it.
+	 */
+	inline void setChroma(YUVVector u, YUVVector v, Chroma &chroma) const {
+		const YUVVector cb = vecSub(u, vecSet(128));
+		const YUVVector cr = vecSub(v, vecSet(128));
+
+		// The constants are the factors of the tables, times 1 << 14
+		chroma.r = scale(cr, vecSet(22959));
+		chroma.g = vecAdd(scale(cr, vecSet(11691)), scale(cb, vecSet(5642)));
+		chroma.b = scale(cb, vecSet(29055));
+	}
+
+	template<typename PixelInt>
+	inline void put(PixelInt *dst, const byte *ySrc, const Chroma &chroma) const {
+		const YUVVector y = vecLoad8(ySrc);
+		_format.store(dst, expand(vecAdd(y, chroma.r)), expand(vecSub(y, chroma.g)), expand(vecAdd(y, chroma.b)));
+	}
+
+private:
+	/** Multiply by a constant with 14 bits of fraction, rounding towards zero. */
+	static inline YUVVector scale(YUVVector value, YUVVector constant) {
+		const YUVVector sign = vecSign(value);
+		const YUVVector magnitude = vecSub(vecXor(value, sign), sign);
+		const YUVVector product = vecMulHigh4(magnitude, constant);
+		return vecSub(vecXor(product, sign), sign);
+	}
+
+	/** Clamp a color component, and stretch it to full range for ITU luminance. */
+	inline YUVVector expand(YUVVector value) const {
+		if (!_itu)
+			return vecMax(vecMin(value, vecSet(255)), vecSet(0));
+
+		value = vecMax(vecMin(value, vecSet(235)), vecSet(16));
+		return vecExpandITU(vecSub(value, vecSet(16)));
+	}
+
+	const YUVVectorFormat _format;
+	const bool _itu;
+};
+
+/** Convert a row of 444 pixels, returning how many were converted. */
+template<typename PixelInt>
+int convertYUV444RowVector(const YUVVectorConverter &conv, PixelInt *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width) {
+	const int vectorWidth = width & ~7;
+	YUVVectorConverter::Chroma chroma;
+
+	for (int x = 0; x < vectorWidth; x += 8) {
+		conv.setChroma(vecLoad8(uSrc + x), vecLoad8(vSrc + x), chroma);
+		conv.put(dst + x, ySrc + x, chroma);
+	}
+	return vectorWidth;
+}
+
+/**
+ * Convert two rows of 420 pixels, returning for how many chroma samples
+ * they were converted.
+ */
+template<typename PixelInt>
+int convertYUV420RowsVector(const YUVVectorConverter &conv, PixelInt *dst, int dstPitch, const byte *ySrc, int yPitch, const byte *uSrc, const byte *vSrc, int halfWidth) {
+	const int vectorWidth = halfWidth & ~3;
+	PixelInt *dst2 = (PixelInt *)((byte *)dst + dstPitch);
+	YUVVectorConverter::Chroma chroma;
+
+	for (int x = 0; x < vectorWidth; x += 4) {
+		conv.setChroma(vecLoad4Doubled(uSrc + x), vecLoad4Doubled(vSrc + x), chroma);
+		conv.put(dst + x * 2, ySrc + x * 2, chroma);
+		conv.put(dst2 + x * 2, ySrc + yPitch + x * 2, chroma);
+	}
+	return vectorWidth;
+}
+
+/**
+ * Bilinearly interpolate the chroma of eight 410 pixels, from chroma
+ * columns x to x + 2 of the rows above and below.
+ */
+inline YUVVector interpolateYUV410(const byte *src, int uvPitch, int yDiff, YUVVector xDiff) {
+	const int col0 = src[0] * (4 - yDiff) + src[uvPitch] * yDiff;
+	const int col1 = src[1] * (4 - yDiff) + src[uvPitch + 1] * yDiff;
+	const int col2 = src[2] * (4 - yDiff) + src[uvPitch + 2] * yDiff;
+
+	const YUVVector left = vecMul(vecSetHalves(col0, col1), vecSub(vecSet(4), xDiff));
+	const YUVVector right = vecMul(vecSetHalves(col1, col2), xDiff);
+	return vecShiftRight4(vecAdd(left, right));
+}
+
+/** Convert a row of 410 pixels, returning for how many chroma samples it was converted. */
+template<typename PixelInt>
+int convertYUV410RowVector(const YUVVectorConverter &conv, PixelInt *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int uvPitch, int yDiff, int quarterWidth) {
+	const int vectorWidth = quarterWidth & ~1;
+	const YUVVector xDiff = vecSetQuarters();
+	YUVVectorConverter::Chroma chroma;
+
+	for (int x = 0; x < vectorWidth; x += 2) {
+		conv.setChroma(interpolateYUV410(uSrc + x, uvPitch, yDiff, xDiff), interpolateYUV410(vSrc + x, uvPitch, yDiff, xDiff), chroma);
+		conv.put(dst + x * 4, ySrc + x * 4, chroma);
+	}
+	return vectorWidth;
+}
+
+} // End of anonymous namespace
+
+#endif
+
 #define PUT_PIXEL(s, d) \
 	L = &rgbToPix[(s)]; \
 	*((PixelInt *)(d)) = (L[cr_r] | L[crb_g] | L[cb_b])
@@ -215,9 +524,21 @@ void convertYUV444ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 	const int16 *Cb_g_tab = Cr_g_tab + 256;
 	const int16 *Cb_b_tab = Cb_g_tab + 256;
 	const uint32 *rgbToPix = lookup->getRGBToPix();
+#if defined(USE_YUV_SSE2) || defined(USE_YUV_NEON)
+	const YUVVectorConverter conv(lookup->getFormat(), lookup->getScale());
+#endif
 
 	for (int h = 0; h < yHeight; h++) {
-		for (int w = 0; w < yWidth; w++) {
+		int w = 0;
+#if defined(USE_YUV_SSE2) || defined(USE_YUV_NEON)
+		w = convertYUV444RowVector(conv, (PixelInt *)dstPtr, ySrc, uSrc, vSrc, yWidth);
+		ySrc += w;
+		uSrc += w;
+		vSrc += w;
+		dstPtr += w * sizeof(PixelInt);
+#endif
+
+		for (; w < yWidth; w++) {
 			const uint32 *L;
 
 			int16 cr_r  = Cr_r_tab[*vSrc];
@@ -264,9 +585,21 @@ void convertYUV420ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 	const int16 *Cb_g_tab = Cr_g_tab + 256;
 	const int16 *Cb_b_tab = Cb_g_tab + 256;
 	const uint32 *rgbToPix = lookup->getRGBToPix();
+#if defined(USE_YUV_SSE2) || defined(USE_YUV_NEON)
+	const YUVVectorConverter conv(lookup->getFormat(), lookup->getScale());
+#endif
 
 	for (int h = 0; h < halfHeight; h++) {
-		for (int w = 0; w < halfWidth; w++) {
+		int w = 0;
+#if defined(USE_YUV_SSE2) || defined(USE_YUV_NEON)
+		w = convertYUV420RowsVector(conv, (PixelInt *)dstPtr, dstPitch, ySrc, yPitch, uSrc, vSrc, halfWidth);
+		ySrc += w * 2;
+		uSrc += w;
+		vSrc += w;
+		dstPtr += w * 2 * sizeof(PixelInt);
+#endif
+
+		for (; w < halfWidth; w++) {
 			const uint32 *L;
 
 			int16 cr_r  = Cr_r_tab[*vSrc];
@@ -292,7 +625,30 @@ void convertYUV420ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 	}
 }
 
-void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+namespace {
+
+struct YUV420Rows {
+	byte *dstPtr;
+	int dstPitch;
+	const YUVToRGBLookup *lookup;
+	int16 *colorTab;
+	const byte *ySrc, *uSrc, *vSrc;
+	int yWidth, yPitch, uvPitch;
+};
+
+template<typename PixelInt>
+void convertYUV420Rows(void *data, uint begin, uint end) {
+	const YUV420Rows &rows = *(const YUV420Rows *)data;
+
+	// begin and end count pairs of rows
+	convertYUV420ToRGB<PixelInt>(rows.dstPtr + begin * 2 * rows.dstPitch, rows.dstPitch, rows.lookup, rows.colorTab,
+		rows.ySrc + begin * 2 * rows.yPitch, rows.uSrc + begin * rows.uvPitch, rows.vSrc + begin * rows.uvPitch,
+		rows.yWidth, (end - begin) * 2, rows.yPitch, rows.uvPitch);
+}
+
+} // End of anonymous namespace
+
+void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch, Common::ThreadPool *pool) {
 	// Sanity checks
 	assert(dst && dst->getPixels());
 	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
@@ -302,6 +658,17 @@ void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::Lumina
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
+	if (pool && pool->getThreadCount() > 1) {
+		YUV420Rows rows = { (byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yPitch, uvPitch };
+
+		// Each job converts whole pairs of rows, which share their chroma
+		if (dst->format.bytesPerPixel == 2)
+			pool->runRange(&convertYUV420Rows<uint16>, &rows, yHeight >> 1, 16);
+		else
+			pool->runRange(&convertYUV420Rows<uint32>, &rows, yHeight >> 1, 16);
+		return;
+	}
+
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
 		convertYUV420ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
@@ -407,9 +774,19 @@ void convertYUV410ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 	const uint32 *rgbToPix = lookup->getRGBToPix();
 
 	int quarterWidth = yWidth >> 2;
+#if defined(USE_YUV_SSE2) || defined(USE_YUV_NEON)
+	const YUVVectorConverter conv(lookup->getFormat(), lookup->getScale());
+#endif
 
 	for (int y = 0; y < yHeight; y++) {
-		for (int x = 0; x < quarterWidth; x++) {
+		int x = 0;
+#if defined(USE_YUV_SSE2) || defined(USE_YUV_NEON)
+		x = convertYUV410RowVector(conv, (PixelInt *)dstPtr, ySrc, uSrc + (y >> 2) * uvPitch, vSrc + (y >> 2) * uvPitch, uvPitch, y & 3, quarterWidth);
+		ySrc += x * 4;
+		dstPtr += x * 4 * sizeof(PixelInt);
+#endif
+
+		for (; x < quarterWidth; x++) {
 			// Perform bilinear interpolation on the the chroma values
 			// Based on the algorithm found here: http://tech-algorithm.com/articles/bilinear-image-scaling/
 			// Feel free to optimize further
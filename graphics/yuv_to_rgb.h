@@ -42,6 +42,10 @@
 #include "common/singleton.h"
 #include "graphics/surface.h"
 
+namespace Common {
+class ThreadPool;
+}
+
 namespace Graphics {
 
 class YUVToRGBLookup;
@@ -81,8 +85,9 @@ public:
 	 * @param yHeight the height of the y surface (must be divisible by 2)
 	 * @param yPitch  the pitch of the y surface
 	 * @param uvPitch the pitch of the u and v surfaces
+	 * @param pool    if not null, the rows are split across the threads of this pool
 	 */
-	void convert420(Graphics::Surface *dst, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
+	void convert420(Graphics::Surface *dst, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch, Common::ThreadPool *pool = nullptr);
 
 	/**
 	 * Convert a YUV420 image with Alpha component to an ARGB surface
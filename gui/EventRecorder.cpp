@@ -21,10 +21,16 @@
  */
 
 
+#define FORBIDDEN_SYMBOL_EXCEPTION_printf
+
 #include "gui/EventRecorder.h"
 
 #ifdef ENABLE_EVENTRECORDER
 
+#if defined(POSIX)
+#include <sys/resource.h>
+#endif
+
 namespace Common {
 DECLARE_SINGLETON(GUI::EventRecorder);
 }
@@ -33,6 +39,7 @@ DECLARE_SINGLETON(GUI::EventRecorder);
 #include "backends/timer/sdl/sdl-timer.h"
 #include "backends/mixer/mixer.h"
 #include "common/config-manager.h"
+#include "common/algorithm.h"
 #include "common/md5.h"
 #include "gui/gui-manager.h"
 #include "gui/widget.h"
@@ -96,6 +103,9 @@ EventRecorder::EventRecorder() {
 	_lastScreenshotTime = 0;
 	_screenshotPeriod = 0;
 	_playbackFile = nullptr;
+	_benchmark = false;
+	_benchmarkStart = 0;
+	_lastFrameTime = 0;
 }
 
 EventRecorder::~EventRecorder() {
@@ -348,6 +358,12 @@ void EventRecorder::init(const Common::String &recordFileName, RecordMode mode)
 		applyPlaybackSettings();
 		_nextEvent = _playbackFile->getNextEvent();
 	}
+	if (_benchmark) {
+		// Do not wait for the recorded delays, the clock is replayed anyway
+		_fastPlayback = true;
+		_frameTimes.clear();
+		_benchmarkStart = _lastFrameTime = g_system->getMicros();
+	}
 	if (_recordMode == kRecorderRecord) {
 		getConfig();
 	}
@@ -470,12 +486,24 @@ void EventRecorder::registerTimerManager(DefaultTimerManager *timerManager) {
 	_timerManager = timerManager;
 }
 
+/**
+ * The timer manager used while recording or playing back. The recorder runs
+ * its handler from processMillis(), and the timer procs are scheduled on the
+ * recorded getMillis(), so that they fire at the same times on playback.
+ */
+class RecorderTimerManager : public DefaultTimerManager {
+protected:
+	uint64 getMicros() override {
+		return (uint64)g_system->getMillis(true) * 1000;
+	}
+};
+
 void EventRecorder::switchTimerManagers() {
 	delete _timerManager;
 	if (_recordMode == kPassthrough) {
 		_timerManager = new SdlTimerManager();
 	} else {
-		_timerManager = new DefaultTimerManager();
+		_timerManager = new RecorderTimerManager();
 	}
 }
 
@@ -602,6 +630,11 @@ Common::SaveFileManager *EventRecorder::getSaveManager(Common::SaveFileManager *
 }
 
 void EventRecorder::preDrawOverlayGui() {
+	if (_benchmark && _initialized) {
+		// Only count the frames. Drawing the control panel would be measured too.
+		countBenchmarkFrame();
+		return;
+	}
 	if ((_initialized) || (_needRedraw)) {
 		RecordMode oldMode = _recordMode;
 		_recordMode = kPassthrough;
@@ -618,6 +651,8 @@ void EventRecorder::preDrawOverlayGui() {
 }
 
 void EventRecorder::postDrawOverlayGui() {
+	if (_benchmark && _initialized)
+		return;
 	if ((_initialized) || (_needRedraw)) {
 		RecordMode oldMode = _recordMode;
 		_recordMode = kPassthrough;
@@ -704,6 +739,67 @@ bool EventRecorder::switchMode() {
 	return true;
 }
 
+void EventRecorder::countBenchmarkFrame() {
+	const uint64 now = g_system->getMicros();
+	_frameTimes.push_back((uint32)MIN<uint64>(now - _lastFrameTime, 0xFFFFFFFF));
+	_lastFrameTime = now;
+}
+
+static uint64 getPeakMemoryUsage() {
+#if defined(POSIX)
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(MACOSX)
+		return usage.ru_maxrss;
+#else
+		return (uint64)usage.ru_maxrss * 1024;
+#endif
+	}
+#endif
+	return 0;
+}
+
+bool EventRecorder::finishBenchmark() {
+	if (!_benchmark || _recordMode != kRecorderPlayback)
+		return true;
+	_benchmark = false;
+	_fastPlayback = false;
+
+	const uint64 elapsed = g_system->getMicros() - _benchmarkStart;
+	const uint mismatches = _playbackFile->getScreenshotMismatches();
+	// A game which quits while there are recorded input events left went
+	// another way than the recorded one
+	const bool eventsLeft = _nextEvent.recordedtype == Common::kRecorderEventTypeNormal && _nextEvent.type != Common::EVENT_INVALID;
+
+	Common::sort(_frameTimes.begin(), _frameTimes.end());
+	const uint frames = _frameTimes.size();
+
+	printf("Benchmark: %s\n", _playbackFile->getHeader().fileName.c_str());
+	printf("  Wall-clock time: %u.%03u s\n", (uint)(elapsed / 1000000), (uint)(elapsed / 1000 % 1000));
+	printf("  Replayed time:   %u.%03u s\n", _fakeTimer / 1000, _fakeTimer % 1000);
+	printf("  Frames:          %u", frames);
+	if (elapsed > 0)
+		printf(" (%u fps)", (uint)((uint64)frames * 1000000 / elapsed));
+	printf("\n");
+	if (frames > 0) {
+		printf("  Frame time (us): min %u, median %u, 90%% %u, 99%% %u, max %u\n",
+		       _frameTimes[0], _frameTimes[frames / 2], _frameTimes[frames * 9 / 10],
+		       _frameTimes[frames * 99 / 100], _frameTimes[frames - 1]);
+	}
+	const uint64 peakMemory = getPeakMemoryUsage();
+	if (peakMemory)
+		printf("  Peak memory:     %u KiB\n", (uint)(peakMemory / 1024));
+	printf("  Screenshots differing from the recording: %u\n", mismatches);
+	if (eventsLeft)
+		printf("  The game ended before the end of the recording\n");
+
+	_frameTimes.clear();
+
+	const bool diverged = mismatches > 0 || eventsLeft;
+	printf("  Result: %s\n", diverged ? "diverged" : "ok");
+	return !diverged;
+}
+
 bool EventRecorder::checkForContinueGame() {
 	bool result = _needcontinueGame;
 	_needcontinueGame = false;
@@ -174,6 +174,23 @@ public:
 	bool switchMode();
 	void switchFastMode();
 
+	/**
+	 * Replay the next recording as a benchmark: as fast as possible, with
+	 * no control panel, and with a report of the time spent at the end.
+	 * Must be called before init().
+	 */
+	void setBenchmark(bool benchmark) {
+		_benchmark = benchmark;
+	}
+
+	/**
+	 * Print the report of the benchmark, if one is running. This happens
+	 * when either the recording or the game ends.
+	 *
+	 * @return false if the playback diverged from the recording
+	 */
+	bool finishBenchmark();
+
 private:
 	bool pollEvent(Common::Event &ev) override;
 	bool notifyEvent(const Common::Event &event) override;
@@ -233,6 +250,14 @@ private:
 	bool _fastPlayback;
 	bool _needRedraw;
 	bool _processingMillis;
+
+	void countBenchmarkFrame();
+
+	bool _benchmark;
+	uint64 _benchmarkStart;
+	uint64 _lastFrameTime;
+	/** The wall-clock time between two screen updates, in microseconds. */
+	Common::Array<uint32> _frameTimes;
 };
 
 } // End of namespace GUI
@@ -0,0 +1,622 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#include "common/config-manager.h"
+#include "common/debug.h"
+#include "common/fs.h"
+#include "common/memstream.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+
+#include "graphics/VectorRenderer.h"
+
+#include "gui/ThemeCache.h"
+#include "gui/ThemeEval.h"
+#include "gui/ThemeParser.h"
+
+namespace GUI {
+
+static const uint32 kThemeCacheTag = MKTAG('S', 'V', 'T', 'C');
+static const uint32 kThemeCacheVersion = 1;
+
+// Enough for a couple of themes at a couple of resolutions each
+static const uint kThemeCacheMaxRecords = 4;
+
+enum ThemeCacheOpcode {
+	kOpEnd,
+	kOpStoreFontNames,
+	kOpAddFont,
+	kOpAddTextColor,
+	kOpCreateCursor,
+	kOpAddBitmap,
+	kOpAddTextData,
+	kOpAddDrawData,
+	kOpAddDrawStep,
+	kOpSetVar,
+	kOpAddDialog,
+	kOpAddLayout,
+	kOpAddWidget,
+	kOpAddImportedLayout,
+	kOpAddSpace,
+	kOpAddPadding,
+	kOpCloseLayout,
+	kOpCloseDialog
+};
+
+static void writeCacheString(Common::WriteStream &stream, const Common::String &str) {
+	stream.writeUint16LE(str.size());
+	stream.write(str.c_str(), str.size());
+}
+
+static bool readCacheString(Common::ReadStream &stream, Common::String &str) {
+	uint16 size = stream.readUint16LE();
+	str = stream.readString(0, size);
+	return !stream.eos() && !stream.err() && str.size() == size;
+}
+
+static void writeCacheColor(Common::WriteStream &stream, const Graphics::DrawStep::Color &color) {
+	stream.writeByte(color.r);
+	stream.writeByte(color.g);
+	stream.writeByte(color.b);
+	stream.writeByte(color.set);
+}
+
+static void readCacheColor(Common::ReadStream &stream, Graphics::DrawStep::Color &color) {
+	color.r = stream.readByte();
+	color.g = stream.readByte();
+	color.b = stream.readByte();
+	color.set = stream.readByte() != 0;
+}
+
+static void writeCacheRect(Common::WriteStream &stream, const Common::Rect &rect) {
+	stream.writeSint16LE(rect.left);
+	stream.writeSint16LE(rect.top);
+	stream.writeSint16LE(rect.right);
+	stream.writeSint16LE(rect.bottom);
+}
+
+static void readCacheRect(Common::ReadStream &stream, Common::Rect &rect) {
+	rect.left = stream.readSint16LE();
+	rect.top = stream.readSint16LE();
+	rect.right = stream.readSint16LE();
+	rect.bottom = stream.readSint16LE();
+}
+
+ThemeCache::ThemeCache() : _record(nullptr) {
+}
+
+ThemeCache::~ThemeCache() {
+	clear();
+}
+
+bool ThemeCache::addStamp(Common::String &stamp, const Common::FSNode &node) {
+	int64 size, modificationTime;
+	if (!node.getFileStats(size, modificationTime))
+		return false;
+
+	stamp += Common::String::format("%lld/%lld;", (long long)size, (long long)modificationTime);
+	return true;
+}
+
+void ThemeCache::clear() {
+	delete _record;
+	_record = nullptr;
+}
+
+void ThemeCache::beginRecording() {
+	clear();
+	_record = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::YES);
+}
+
+Common::String ThemeCache::getFileName() const {
+	Common::String configFileName = ConfMan.getCustomConfigFileName();
+	if (configFileName.empty())
+		configFileName = g_system->getDefaultConfigFileName();
+
+	Common::FSNode dir = Common::FSNode(configFileName).getParent();
+	if (!dir.isDirectory())
+		return Common::String();
+
+	return dir.getChild("theme.cache").getPath();
+}
+
+bool ThemeCache::load(const Common::String &key, const Common::String &stamp) {
+	clear();
+
+	Common::String fileName = getFileName();
+	if (fileName.empty())
+		return false;
+
+	Common::FSNode file(fileName);
+	if (!file.exists())
+		return false;
+
+	Common::SeekableReadStream *stream = file.createReadStream();
+	if (!stream)
+		return false;
+
+	if (stream->readUint32BE() != kThemeCacheTag || stream->readUint32LE() != kThemeCacheVersion) {
+		delete stream;
+		return false;
+	}
+
+	uint32 count = stream->readUint32LE();
+	for (uint32 i = 0; i < count; i++) {
+		Common::String recordKey, recordStamp;
+		if (!readCacheString(*stream, recordKey) || !readCacheString(*stream, recordStamp))
+			break;
+
+		uint32 size = stream->readUint32LE();
+		if (stream->eos() || stream->err() || size > stream->size() - stream->pos())
+			break;
+
+		if (recordKey != key || recordStamp != stamp) {
+			stream->skip(size);
+			continue;
+		}
+
+		byte *data = (byte *)malloc(size);
+		if (!data || stream->read(data, size) != size) {
+			free(data);
+			break;
+		}
+
+		_record = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::YES);
+		_record->write(data, size);
+		free(data);
+		break;
+	}
+
+	delete stream;
+
+	if (_record)
+		debug(3, "Loaded theme '%s' from the theme cache '%s'", key.c_str(), fileName.c_str());
+	return _record != nullptr;
+}
+
+void ThemeCache::save(const Common::String &key, const Common::String &stamp) {
+	if (!_record)
+		return;
+
+	Common::String fileName = getFileName();
+	if (fileName.empty())
+		return;
+
+	_record->writeByte(kOpEnd);
+
+	// Keep the most recent records of the other keys
+	Common::MemoryWriteStreamDynamic others(DisposeAfterUse::YES);
+	uint32 otherCount = 0;
+
+	Common::FSNode file(fileName);
+	Common::SeekableReadStream *in = file.exists() ? file.createReadStream() : nullptr;
+	if (in && in->readUint32BE() == kThemeCacheTag && in->readUint32LE() == kThemeCacheVersion) {
+		uint32 count = in->readUint32LE();
+		for (uint32 i = 0; i < count && otherCount + 1 < kThemeCacheMaxRecords; i++) {
+			Common::String recordKey, recordStamp;
+			if (!readCacheString(*in, recordKey) || !readCacheString(*in, recordStamp))
+				break;
+
+			uint32 size = in->readUint32LE();
+			if (in->eos() || in->err() || size > in->size() - in->pos())
+				break;
+
+			if (recordKey == key) {
+				in->skip(size);
+				continue;
+			}
+
+			byte *data = (byte *)malloc(size);
+			if (!data || in->read(data, size) != size) {
+				free(data);
+				break;
+			}
+
+			writeCacheString(others, recordKey);
+			writeCacheString(others, recordStamp);
+			others.writeUint32LE(size);
+			others.write(data, size);
+			free(data);
+			otherCount++;
+		}
+	}
+	delete in;
+
+	Common::WriteStream *stream = file.createWriteStream();
+	if (!stream) {
+		warning("Could not write the theme cache '%s'", fileName.c_str());
+		return;
+	}
+
+	stream->writeUint32BE(kThemeCacheTag);
+	stream->writeUint32LE(kThemeCacheVersion);
+	stream->writeUint32LE(otherCount + 1);
+	writeCacheString(*stream, key);
+	writeCacheString(*stream, stamp);
+	stream->writeUint32LE(_record->size());
+	stream->write(_record->getData(), _record->size());
+	stream->write(others.getData(), others.size());
+
+	stream->finalize();
+	if (stream->err())
+		warning("Could not write the theme cache '%s'", fileName.c_str());
+	delete stream;
+}
+
+bool ThemeCache::replay(ThemeEngine *theme) {
+	if (!_record)
+		return false;
+
+	Common::MemoryReadStream stream(_record->getData(), _record->size());
+	ThemeEval *eval = theme->getEvaluator();
+
+	while (!stream.eos() && !stream.err()) {
+		byte opcode = stream.readByte();
+		Common::String str1, str2, str3;
+		bool ok = true;
+
+		switch (opcode) {
+		case kOpEnd:
+			return true;
+
+		case kOpStoreFontNames:
+		case kOpAddFont: {
+			TextData textId = (TextData)stream.readByte();
+			ok = readCacheString(stream, str1) && readCacheString(stream, str2) && readCacheString(stream, str3);
+			int pointsize = stream.readSint32LE();
+			if (!ok || textId >= kTextDataMAX)
+				return false;
+
+			if (opcode == kOpStoreFontNames)
+				theme->storeFontNames(textId, str1, str2, str3, pointsize);
+			else
+				ok = theme->addFont(textId, str1, str2, str3, pointsize);
+			break;
+		}
+
+		case kOpAddTextColor: {
+			TextColor colorId = (TextColor)stream.readByte();
+			int r = stream.readByte();
+			int g = stream.readByte();
+			int b = stream.readByte();
+			if (colorId >= kTextColorMAX)
+				return false;
+
+			ok = theme->addTextColor(colorId, r, g, b);
+			break;
+		}
+
+		case kOpCreateCursor: {
+			if (!readCacheString(stream, str1))
+				return false;
+			int hotspotX = stream.readSint32LE();
+			int hotspotY = stream.readSint32LE();
+
+			ok = theme->createCursor(str1, hotspotX, hotspotY);
+			break;
+		}
+
+		case kOpAddBitmap: {
+			if (!readCacheString(stream, str1) || !readCacheString(stream, str2))
+				return false;
+			int width = stream.readSint32LE();
+			int height = stream.readSint32LE();
+
+			ok = theme->addBitmap(str1, str2, width, height);
+			break;
+		}
+
+		case kOpAddTextData: {
+			if (!readCacheString(stream, str1))
+				return false;
+			TextData textId = (TextData)stream.readByte();
+			TextColor colorId = (TextColor)stream.readByte();
+			Graphics::TextAlign alignH = (Graphics::TextAlign)stream.readSByte();
+			ThemeEngine::TextAlignVertical alignV = (ThemeEngine::TextAlignVertical)stream.readSByte();
+
+			ok = theme->addTextData(str1, textId, colorId, alignH, alignV);
+			break;
+		}
+
+		case kOpAddDrawData: {
+			if (!readCacheString(stream, str1))
+				return false;
+			bool cached = stream.readByte() != 0;
+
+			ok = theme->addDrawData(str1, cached);
+			break;
+		}
+
+		case kOpAddDrawStep: {
+			if (!readCacheString(stream, str1) || !readCacheString(stream, str2) || !readCacheString(stream, str3))
+				return false;
+
+			Graphics::DrawStep step;
+			step.drawingCall = ThemeParser::getDrawingFunctionCallback(str2);
+			if (!step.drawingCall)
+				return false;
+
+			if (!str3.empty()) {
+				step.blitSrc = theme->getImageSurface(str3);
+				if (!step.blitSrc)
+					return false;
+			}
+
+			readCacheColor(stream, step.fgColor);
+			readCacheColor(stream, step.bgColor);
+			readCacheColor(stream, step.gradColor1);
+			readCacheColor(stream, step.gradColor2);
+			readCacheColor(stream, step.bevelColor);
+			step.autoWidth = stream.readByte() != 0;
+			step.autoHeight = stream.readByte() != 0;
+			step.x = stream.readSint16LE();
+			step.y = stream.readSint16LE();
+			step.w = stream.readSint16LE();
+			step.h = stream.readSint16LE();
+			readCacheRect(stream, step.padding);
+			readCacheRect(stream, step.clip);
+			step.xAlign = (Graphics::DrawStep::VectorAlignment)stream.readByte();
+			step.yAlign = (Graphics::DrawStep::VectorAlignment)stream.readByte();
+			step.shadow = stream.readByte();
+			step.stroke = stream.readByte();
+			step.factor = stream.readByte();
+			step.radius = stream.readByte();
+			step.bevel = stream.readByte();
+			step.fillMode = stream.readByte();
+			step.shadowFillMode = stream.readByte();
+			step.extraData = stream.readUint32LE();
+			step.scale = stream.readUint32LE();
+			step.autoscale = (ThemeEngine::AutoScaleMode)stream.readByte();
+
+			theme->addDrawStep(str1, step);
+			break;
+		}
+
+		case kOpSetVar: {
+			if (!readCacheString(stream, str1))
+				return false;
+
+			eval->setVar(str1, stream.readSint32LE());
+			break;
+		}
+
+		case kOpAddDialog: {
+			if (!readCacheString(stream, str1) || !readCacheString(stream, str2))
+				return false;
+			int16 maxWidth = stream.readSint16LE();
+			int16 maxHeight = stream.readSint16LE();
+			int inset = stream.readSint32LE();
+
+			eval->addDialog(str1, str2, maxWidth, maxHeight, inset);
+			break;
+		}
+
+		case kOpAddLayout: {
+			ThemeLayout::LayoutType type = (ThemeLayout::LayoutType)stream.readByte();
+			int spacing = stream.readSint32LE();
+			ThemeLayout::ItemAlign itemAlign = (ThemeLayout::ItemAlign)stream.readByte();
+
+			eval->addLayout(type, spacing, itemAlign);
+			break;
+		}
+
+		case kOpAddWidget: {
+			if (!readCacheString(stream, str1) || !readCacheString(stream, str2))
+				return false;
+			int w = stream.readSint32LE();
+			int h = stream.readSint32LE();
+			Graphics::TextAlign align = (Graphics::TextAlign)stream.readSByte();
+			bool useRTL = stream.readByte() != 0;
+
+			eval->addWidget(str1, str2, w, h, align, useRTL);
+			break;
+		}
+
+		case kOpAddImportedLayout:
+			if (!readCacheString(stream, str1) || !eval->hasDialog(str1))
+				return false;
+
+			eval->addImportedLayout(str1);
+			break;
+
+		case kOpAddSpace:
+			eval->addSpace(stream.readSint32LE());
+			break;
+
+		case kOpAddPadding: {
+			int16 l = stream.readSint16LE();
+			int16 r = stream.readSint16LE();
+			int16 t = stream.readSint16LE();
+			int16 b = stream.readSint16LE();
+
+			eval->addPadding(l, r, t, b);
+			break;
+		}
+
+		case kOpCloseLayout:
+			eval->closeLayout();
+			break;
+
+		case kOpCloseDialog:
+			eval->closeDialog();
+			break;
+
+		default:
+			return false;
+		}
+
+		if (!ok)
+			return false;
+	}
+
+	// The record ended without a kOpEnd
+	return false;
+}
+
+void ThemeCache::storeFontNames(TextData textId, const Common::String &language, const Common::String &file, const Common::String &scalableFile, int pointsize) {
+	_record->writeByte(kOpStoreFontNames);
+	_record->writeByte(textId);
+	writeCacheString(*_record, language);
+	writeCacheString(*_record, file);
+	writeCacheString(*_record, scalableFile);
+	_record->writeSint32LE(pointsize);
+}
+
+void ThemeCache::addFont(TextData textId, const Common::String &language, const Common::String &file, const Common::String &scalableFile, int pointsize) {
+	_record->writeByte(kOpAddFont);
+	_record->writeByte(textId);
+	writeCacheString(*_record, language);
+	writeCacheString(*_record, file);
+	writeCacheString(*_record, scalableFile);
+	_record->writeSint32LE(pointsize);
+}
+
+void ThemeCache::addTextColor(TextColor colorId, int r, int g, int b) {
+	_record->writeByte(kOpAddTextColor);
+	_record->writeByte(colorId);
+	_record->writeByte(r);
+	_record->writeByte(g);
+	_record->writeByte(b);
+}
+
+void ThemeCache::createCursor(const Common::String &filename, int hotspotX, int hotspotY) {
+	_record->writeByte(kOpCreateCursor);
+	writeCacheString(*_record, filename);
+	_record->writeSint32LE(hotspotX);
+	_record->writeSint32LE(hotspotY);
+}
+
+void ThemeCache::addBitmap(const Common::String &filename, const Common::String &scalableFile, int width, int height) {
+	_record->writeByte(kOpAddBitmap);
+	writeCacheString(*_record, filename);
+	writeCacheString(*_record, scalableFile);
+	_record->writeSint32LE(width);
+	_record->writeSint32LE(height);
+}
+
+void ThemeCache::addTextData(const Common::String &drawDataId, TextData textId, TextColor colorId, Graphics::TextAlign alignH, ThemeEngine::TextAlignVertical alignV) {
+	_record->writeByte(kOpAddTextData);
+	writeCacheString(*_record, drawDataId);
+	_record->writeByte(textId);
+	_record->writeByte(colorId);
+	_record->writeSByte(alignH);
+	_record->writeSByte(alignV);
+}
+
+void ThemeCache::addDrawData(const Common::String &drawDataId, bool cached) {
+	_record->writeByte(kOpAddDrawData);
+	writeCacheString(*_record, drawDataId);
+	_record->writeByte(cached);
+}
+
+void ThemeCache::addDrawStep(const Common::String &drawDataId, const Common::String &function, const Common::String &bitmap, const Graphics::DrawStep &step) {
+	_record->writeByte(kOpAddDrawStep);
+	writeCacheString(*_record, drawDataId);
+	writeCacheString(*_record, function);
+	writeCacheString(*_record, bitmap);
+	writeCacheColor(*_record, step.fgColor);
+	writeCacheColor(*_record, step.bgColor);
+	writeCacheColor(*_record, step.gradColor1);
+	writeCacheColor(*_record, step.gradColor2);
+	writeCacheColor(*_record, step.bevelColor);
+	_record->writeByte(step.autoWidth);
+	_record->writeByte(step.autoHeight);
+	_record->writeSint16LE(step.x);
+	_record->writeSint16LE(step.y);
+	_record->writeSint16LE(step.w);
+	_record->writeSint16LE(step.h);
+	writeCacheRect(*_record, step.padding);
+	writeCacheRect(*_record, step.clip);
+	_record->writeByte(step.xAlign);
+	_record->writeByte(step.yAlign);
+	_record->writeByte(step.shadow);
+	_record->writeByte(step.stroke);
+	_record->writeByte(step.factor);
+	_record->writeByte(step.radius);
+	_record->writeByte(step.bevel);
+	_record->writeByte(step.fillMode);
+	_record->writeByte(step.shadowFillMode);
+	_record->writeUint32LE(step.extraData);
+	_record->writeUint32LE(step.scale);
+	_record->writeByte(step.autoscale);
+}
+
+void ThemeCache::setVar(const Common::String &name, int val) {
+	_record->writeByte(kOpSetVar);
+	writeCacheString(*_record, name);
+	_record->writeSint32LE(val);
+}
+
+void ThemeCache::addDialog(const Common::String &name, const Common::String &overlays, int16 maxWidth, int16 maxHeight, int inset) {
+	_record->writeByte(kOpAddDialog);
+	writeCacheString(*_record, name);
+	writeCacheString(*_record, overlays);
+	_record->writeSint16LE(maxWidth);
+	_record->writeSint16LE(maxHeight);
+	_record->writeSint32LE(inset);
+}
+
+void ThemeCache::addLayout(ThemeLayout::LayoutType type, int spacing, ThemeLayout::ItemAlign itemAlign) {
+	_record->writeByte(kOpAddLayout);
+	_record->writeByte(type);
+	_record->writeSint32LE(spacing);
+	_record->writeByte(itemAlign);
+}
+
+void ThemeCache::addWidget(const Common::String &name, const Common::String &type, int w, int h, Graphics::TextAlign align, bool useRTL) {
+	_record->writeByte(kOpAddWidget);
+	writeCacheString(*_record, name);
+	writeCacheString(*_record, type);
+	_record->writeSint32LE(w);
+	_record->writeSint32LE(h);
+	_record->writeSByte(align);
+	_record->writeByte(useRTL);
+}
+
+void ThemeCache::addImportedLayout(const Common::String &name) {
+	_record->writeByte(kOpAddImportedLayout);
+	writeCacheString(*_record, name);
+}
+
+void ThemeCache::addSpace(int size) {
+	_record->writeByte(kOpAddSpace);
+	_record->writeSint32LE(size);
+}
+
+void ThemeCache::addPadding(int16 l, int16 r, int16 t, int16 b) {
+	_record->writeByte(kOpAddPadding);
+	_record->writeSint16LE(l);
+	_record->writeSint16LE(r);
+	_record->writeSint16LE(t);
+	_record->writeSint16LE(b);
+}
+
+void ThemeCache::closeLayout() {
+	_record->writeByte(kOpCloseLayout);
+}
+
+void ThemeCache::closeDialog() {
+	_record->writeByte(kOpCloseDialog);
+}
+
+} // End of namespace GUI
@@ -0,0 +1,130 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#ifndef GUI_THEMECACHE_H
+#define GUI_THEMECACHE_H
+
+#include "common/scummsys.h"
+#include "common/str.h"
+
+#include "gui/ThemeEngine.h"
+#include "gui/ThemeLayout.h"
+
+namespace Common {
+class FSNode;
+class MemoryWriteStreamDynamic;
+}
+
+namespace Graphics {
+struct DrawStep;
+}
+
+namespace GUI {
+
+/**
+ * Cache of the parsed themes, kept on disk between runs.
+ *
+ * Parsing the STX files of a theme and evaluating its layouts can take a
+ * noticeable time on slow devices. While a theme is parsed, ThemeParser
+ * records in this cache every call it makes to the ThemeEngine and to the
+ * ThemeEval, with their arguments fully resolved. On the next startup,
+ * the calls are replayed instead of parsing the theme again.
+ *
+ * Fonts and bitmaps are still loaded from the theme files when replaying,
+ * since they depend on the current language and overlay format.
+ *
+ * Each record is stored under a key naming the theme and the resolution it
+ * was parsed for, together with a stamp describing the theme files. A record
+ * is only reused while its stamp is unchanged. The cache is stored next to
+ * the configuration file.
+ */
+class ThemeCache {
+public:
+	ThemeCache();
+	~ThemeCache();
+
+	/**
+	 * Append the stamp of @p node to @p stamp.
+	 *
+	 * @return False if the backend cannot tell when the file was modified.
+	 */
+	static bool addStamp(Common::String &stamp, const Common::FSNode &node);
+
+	/**
+	 * Load the record stored under @p key with the given @p stamp.
+	 *
+	 * @return True if such a record was found.
+	 */
+	bool load(const Common::String &key, const Common::String &stamp);
+
+	/**
+	 * Replay the calls of the loaded record on @p theme.
+	 *
+	 * @return False if the record is corrupted, or one of the calls failed.
+	 */
+	bool replay(ThemeEngine *theme);
+
+	/** Discard the current record, and start recording a new one. */
+	void beginRecording();
+
+	/** Store the recorded calls on disk under @p key and @p stamp. */
+	void save(const Common::String &key, const Common::String &stamp);
+
+	/** Discard the current record. */
+	void clear();
+
+	/**
+	 * @name Recording
+	 * These mirror the builder methods of ThemeEngine and ThemeEval.
+	 * @{
+	 */
+	void storeFontNames(TextData textId, const Common::String &language, const Common::String &file, const Common::String &scalableFile, int pointsize);
+	void addFont(TextData textId, const Common::String &language, const Common::String &file, const Common::String &scalableFile, int pointsize);
+	void addTextColor(TextColor colorId, int r, int g, int b);
+	void createCursor(const Common::String &filename, int hotspotX, int hotspotY);
+	void addBitmap(const Common::String &filename, const Common::String &scalableFile, int width, int height);
+	void addTextData(const Common::String &drawDataId, TextData textId, TextColor colorId, Graphics::TextAlign alignH, ThemeEngine::TextAlignVertical alignV);
+	void addDrawData(const Common::String &drawDataId, bool cached);
+	/** @p function and @p bitmap are the names the drawing call and the blit source were resolved from. */
+	void addDrawStep(const Common::String &drawDataId, const Common::String &function, const Common::String &bitmap, const Graphics::DrawStep &step);
+
+	void setVar(const Common::String &name, int val);
+	void addDialog(const Common::String &name, const Common::String &overlays, int16 maxWidth, int16 maxHeight, int inset);
+	void addLayout(ThemeLayout::LayoutType type, int spacing, ThemeLayout::ItemAlign itemAlign);
+	void addWidget(const Common::String &name, const Common::String &type, int w, int h, Graphics::TextAlign align, bool useRTL);
+	void addImportedLayout(const Common::String &name);
+	void addSpace(int size);
+	void addPadding(int16 l, int16 r, int16 t, int16 b);
+	void closeLayout();
+	void closeDialog();
+	/** @} */
+
+private:
+	Common::String getFileName() const;
+
+	Common::MemoryWriteStreamDynamic *_record;
+};
+
+} // End of namespace GUI
+
+#endif
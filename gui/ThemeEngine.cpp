@@ -20,12 +20,15 @@
  *
  */
 
+#include "base/version.h"
+
 #include "common/system.h"
 #include "common/config-manager.h"
 #include "common/file.h"
 #include "common/fs.h"
 #include "common/unzip.h"
 #include "common/tokenizer.h"
+#include "common/trace.h"
 #include "common/translation.h"
 #include "common/unicode-bidi.h"
 
@@ -42,6 +45,7 @@
 #include "image/png.h"
 
 #include "gui/widget.h"
+#include "gui/ThemeCache.h"
 #include "gui/ThemeEngine.h"
 #include "gui/ThemeEval.h"
 #include "gui/ThemeParser.h"
@@ -64,6 +68,9 @@ const char *const ThemeEngine::kImageEditSmallButton = "editbtn_small.bmp";
 const char *const ThemeEngine::kImageSwitchModeSmallButton = "switchbtn_small.bmp";
 const char *const ThemeEngine::kImageFastReplaySmallButton = "fastreplay_small.bmp";
 
+/** Total size of the pixels kept by the draw cache of ThemeEngine. */
+static const uint32 kDrawCacheMaxSize = 4 * 1024 * 1024;
+
 struct TextDrawData {
 	const Graphics::Font *_fontPtr;
 };
@@ -187,7 +194,7 @@ static const DrawDataInfo kDrawDataDefaults[] = {
  * ThemeEngine class
  *********************************************************/
 ThemeEngine::ThemeEngine(Common::String id, GraphicsMode mode) :
-	_system(nullptr), _vectorRenderer(nullptr),
+	_system(nullptr), _vectorRenderer(nullptr), _drawCacheSize(0), _drawCacheClock(0),
 	_layerToDraw(kDrawLayerBackground), _bytesPerPixel(0),  _graphicsMode(kGfxDisabled),
 	_font(nullptr), _initOk(false), _themeOk(false), _enabled(false), _themeFiles(),
 	_cursor(nullptr), _scaleFactor(1.0f) {
@@ -241,6 +248,7 @@ ThemeEngine::ThemeEngine(Common::String id, GraphicsMode mode) :
 }
 
 ThemeEngine::~ThemeEngine() {
+	clearDrawCache();
 	delete _vectorRenderer;
 	_vectorRenderer = nullptr;
 	_screen.free();
@@ -318,6 +326,8 @@ void ThemeEngine::setBaseResolution(int w, int h, float s) {
  * Theme setup/initialization
  *********************************************************/
 bool ThemeEngine::init() {
+	Common::TraceScope trace("ThemeEngine::init");
+
 	// reset everything and reload the graphics
 	_initOk = false;
 	_overlayFormat = _system->getOverlayFormat();
@@ -455,6 +465,7 @@ void ThemeEngine::setGraphicsMode(GraphicsMode mode) {
 	_screen.free();
 	_screen.create(width, height, _overlayFormat);
 
+	clearDrawCache();
 	delete _vectorRenderer;
 	_vectorRenderer = Graphics::createRenderer(mode);
 	_vectorRenderer->setSurface(&_screen);
@@ -786,6 +797,7 @@ bool ThemeEngine::addDrawData(const Common::String &data, bool cached) {
  * Theme XML loading
  *********************************************************/
 void ThemeEngine::loadTheme(const Common::String &themeId) {
+	Common::TraceScope trace("ThemeEngine::loadTheme", themeId);
 	unloadTheme();
 
 	debug(6, "Loading theme %s", themeId.c_str());
@@ -812,6 +824,8 @@ void ThemeEngine::loadTheme(const Common::String &themeId) {
 }
 
 void ThemeEngine::unloadTheme() {
+	clearDrawCache();
+
 	if (!_themeOk)
 		return;
 
@@ -842,6 +856,27 @@ void ThemeEngine::unloadExtraFont() {
 	_texts[kTextDataExtraLang] = nullptr;
 }
 
+Common::String ThemeEngine::getThemeCacheKey(const Common::String &themeId) const {
+	return Common::String::format("%s:%dx%d:%g", themeId.c_str(), _baseWidth, _baseHeight, _scaleFactor);
+}
+
+bool ThemeEngine::loadThemeFromCache(ThemeCache &cache, const Common::String &key, const Common::String &stamp) {
+	if (!cache.load(key, stamp))
+		return false;
+
+	bool result = cache.replay(this);
+	cache.clear();
+	if (result)
+		return true;
+
+	warning("Discarding the theme cache record of '%s'", key.c_str());
+
+	// Drop whatever was replayed before the theme files are parsed
+	_themeOk = true;
+	unloadTheme();
+	return false;
+}
+
 bool ThemeEngine::loadDefaultXML() {
 
 	// The default XML theme is included on runtime from a pregenerated
@@ -850,6 +885,17 @@ bool ThemeEngine::loadDefaultXML() {
 	// into the "default.inc" file, which is ready to be included in the code.
 #ifndef DISABLE_GUI_BUILTIN_THEME
 #include "themes/default.inc"
+	_themeName = "ScummVM Classic Theme (Builtin Version)";
+	_themeId = "builtin";
+	_themeFile.clear();
+
+	// The builtin theme only changes with the executable
+	ThemeCache cache;
+	Common::String cacheKey = getThemeCacheKey(_themeId);
+	Common::String cacheStamp = gScummVMFullVersion;
+	if (loadThemeFromCache(cache, cacheKey, cacheStamp))
+		return true;
+
 	int xmllen = 0;
 
 	for (int i = 0; i < ARRAYSIZE(defaultXML); i++)
@@ -867,15 +913,17 @@ bool ThemeEngine::loadDefaultXML() {
 		return false;
 	}
 
-	_themeName = "ScummVM Classic Theme (Builtin Version)";
-	_themeId = "builtin";
-	_themeFile.clear();
-
+	cache.beginRecording();
+	_parser->setCache(&cache);
 	bool result = _parser->parse();
+	_parser->setCache(nullptr);
 	_parser->close();
 
 	free(tmpXML);
 
+	if (result)
+		cache.save(cacheKey, cacheStamp);
+
 	return result;
 #else
 	warning("The built-in theme is not enabled in the current build. Please load an external theme");
@@ -912,6 +960,32 @@ bool ThemeEngine::loadThemeXML(const Common::String &themeId) {
 		return false;
 	}
 
+	//
+	// Try the theme cache when the theme files can be stamped: all the
+	// STX files of a theme directory, or the zip file
+	//
+	ThemeCache cache;
+	Common::String cacheKey = getThemeCacheKey(themeId);
+	Common::String cacheStamp = gScummVMFullVersion;
+	bool useCache = false;
+
+	Common::FSNode themeNode(_themeFile);
+	if (themeNode.isDirectory()) {
+		useCache = true;
+		for (Common::ArchiveMemberList::iterator i = members.begin(); i != members.end() && useCache; ++i)
+			useCache = ThemeCache::addStamp(cacheStamp, themeNode.getChild((*i)->getName()));
+	} else if (!_themeFile.empty()) {
+		useCache = ThemeCache::addStamp(cacheStamp, themeNode);
+	}
+
+	if (useCache) {
+		if (loadThemeFromCache(cache, cacheKey, cacheStamp))
+			return true;
+
+		cache.beginRecording();
+		_parser->setCache(&cache);
+	}
+
 	//
 	// Loop over all STX files, load and parse them
 	//
@@ -920,12 +994,14 @@ bool ThemeEngine::loadThemeXML(const Common::String &themeId) {
 
 		if (_parser->loadStream((*i)->createReadStream()) == false) {
 			warning("Failed to load STX file '%s'", (*i)->getDisplayName().c_str());
+			_parser->setCache(nullptr);
 			_parser->close();
 			return false;
 		}
 
 		if (_parser->parse() == false) {
 			warning("Failed to parse STX file '%s'", (*i)->getDisplayName().c_str());
+			_parser->setCache(nullptr);
 			_parser->close();
 			return false;
 		}
@@ -933,6 +1009,10 @@ bool ThemeEngine::loadThemeXML(const Common::String &themeId) {
 		_parser->close();
 	}
 
+	_parser->setCache(nullptr);
+	if (useCache)
+		cache.save(cacheKey, cacheStamp);
+
 	assert(!_themeName.empty());
 	return true;
 }
@@ -974,13 +1054,99 @@ void ThemeEngine::drawDD(DrawData type, const Common::Rect &r, uint32 dynamic, b
 		restoreBackground(extendedRect);
 
 	if (drawData->_layer == _layerToDraw) {
-		Common::List<Graphics::DrawStep>::const_iterator step;
-		for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step) {
-			_vectorRenderer->drawStep(area, _clip, *step, dynamic);
+		drawStepsCached(type, *drawData, area, extendedRect, dynamic);
+		addDirtyRect(extendedRect);
+	}
+}
+
+void ThemeEngine::drawStepsCached(DrawData type, const WidgetDrawData &drawData, const Common::Rect &area, const Common::Rect &extendedRect, uint32 dynamic) {
+	Graphics::ManagedSurface *surface = _vectorRenderer->getActiveSurface();
+
+	Common::Rect rect = extendedRect;
+	rect.clip(surface->w, surface->h);
+
+	const uint32 lineSize = rect.width() * surface->format.bytesPerPixel;
+	const uint32 size = lineSize * rect.height();
+
+	// Small DrawData are cached, the dialog backgrounds are not worth it
+	const bool cacheable = !rect.isEmpty() && size <= kDrawCacheMaxSize / 8;
+
+	if (cacheable) {
+		for (uint i = 0; i < _drawCache.size(); ++i) {
+			DrawCacheEntry *entry = _drawCache[i];
+			if (entry->type != type || entry->dynamic != dynamic || entry->surface != surface
+			    || entry->area != area || entry->clip != _clip || entry->rect != rect)
+				continue;
+
+			bool sameBackground = true;
+			for (int y = 0; sameBackground && y < rect.height(); ++y)
+				sameBackground = !memcmp(surface->getBasePtr(rect.left, rect.top + y), entry->before + y * lineSize, lineSize);
+			if (!sameBackground)
+				continue;
+
+			for (int y = 0; y < rect.height(); ++y)
+				memcpy(surface->getBasePtr(rect.left, rect.top + y), entry->after + y * lineSize, lineSize);
+			entry->lastUse = ++_drawCacheClock;
+			return;
 		}
+	}
 
-		addDirtyRect(extendedRect);
+	byte *before = nullptr;
+	if (cacheable) {
+		before = (byte *)malloc(size * 2);
+		if (before) {
+			for (int y = 0; y < rect.height(); ++y)
+				memcpy(before + y * lineSize, surface->getBasePtr(rect.left, rect.top + y), lineSize);
+		}
+	}
+
+	Common::List<Graphics::DrawStep>::const_iterator step;
+	for (step = drawData._steps.begin(); step != drawData._steps.end(); ++step) {
+		_vectorRenderer->drawStep(area, _clip, *step, dynamic);
+	}
+
+	if (!before)
+		return;
+
+	DrawCacheEntry *entry = new DrawCacheEntry();
+	entry->type = type;
+	entry->dynamic = dynamic;
+	entry->surface = surface;
+	entry->area = area;
+	entry->clip = _clip;
+	entry->rect = rect;
+	entry->before = before;
+	entry->after = before + size;
+	entry->size = size;
+	entry->lastUse = ++_drawCacheClock;
+	for (int y = 0; y < rect.height(); ++y)
+		memcpy(entry->after + y * lineSize, surface->getBasePtr(rect.left, rect.top + y), lineSize);
+
+	// Make room by dropping the least recently used entries
+	_drawCacheSize += size * 2;
+	while (_drawCacheSize > kDrawCacheMaxSize && !_drawCache.empty()) {
+		uint oldest = 0;
+		for (uint i = 1; i < _drawCache.size(); ++i) {
+			if (_drawCache[i]->lastUse < _drawCache[oldest]->lastUse)
+				oldest = i;
+		}
+
+		_drawCacheSize -= _drawCache[oldest]->size * 2;
+		free(_drawCache[oldest]->before);
+		delete _drawCache[oldest];
+		_drawCache.remove_at(oldest);
+	}
+
+	_drawCache.push_back(entry);
+}
+
+void ThemeEngine::clearDrawCache() {
+	for (uint i = 0; i < _drawCache.size(); ++i) {
+		free(_drawCache[i]->before);
+		delete _drawCache[i];
 	}
+	_drawCache.clear();
+	_drawCacheSize = 0;
 }
 
 void ThemeEngine::drawDDText(TextData type, TextColor color, const Common::Rect &r, const Common::U32String &text,
@@ -1730,6 +1896,7 @@ const Graphics::Font *ThemeEngine::loadFont(const Common::String &filename, Comm
 }
 
 const Graphics::Font *ThemeEngine::loadFont(const Common::String &filename, const Common::String &scalableFilename, const Common::String &charset, const int pointsize, const bool makeLocalizedFont) {
+	Common::TraceScope trace("ThemeEngine::loadFont", scalableFilename.empty() ? filename : scalableFilename);
 	Common::String fontName;
 
 	const Graphics::Font *font = nullptr;
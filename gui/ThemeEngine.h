@@ -53,6 +53,7 @@ struct TextDrawData;
 struct TextColorData;
 class Dialog;
 class GuiObject;
+class ThemeCache;
 class ThemeEval;
 class ThemeParser;
 
@@ -661,6 +662,17 @@ protected:
 	 */
 	bool loadDefaultXML();
 
+	/**
+	 * Replays the record of the theme cache stored under @p key and @p stamp.
+	 *
+	 * @returns true if the theme was loaded from the cache, false if it
+	 *          must be parsed.
+	 */
+	bool loadThemeFromCache(ThemeCache &cache, const Common::String &key, const Common::String &stamp);
+
+	/** Returns the key of the theme cache record of @p themeId at the current resolution. */
+	Common::String getThemeCacheKey(const Common::String &themeId) const;
+
 	/**
 	 * Unloads the currently loaded theme so another one can
 	 * be loaded.
@@ -692,6 +704,12 @@ protected:
 	 * These functions are called from all the Widget drawing methods.
 	 */
 	void drawDD(DrawData type, const Common::Rect &r, uint32 dynamic = 0, bool forceRestore = false);
+
+	/** Draw the steps of a DrawData, going through the draw cache when possible. */
+	void drawStepsCached(DrawData type, const WidgetDrawData &drawData, const Common::Rect &area, const Common::Rect &extendedRect, uint32 dynamic);
+
+	/** Empty the cache of rendered DrawData, when the theme or the surfaces change. */
+	void clearDrawCache();
 	void drawDDText(TextData type, TextColor color, const Common::Rect &r, const Common::U32String &text, bool restoreBg,
 	                bool elipsis, Graphics::TextAlign alignH = Graphics::kTextAlignLeft,
 	                TextAlignVertical alignV = kTextAlignVTop, int deltax = 0,
@@ -741,6 +759,30 @@ protected:
 	/** Backbuffer surface. Stores previous states of the screen to blit back */
 	Graphics::ManagedSurface _backBuffer;
 
+	/**
+	 * The result of drawing the steps of a DrawData, together with the
+	 * pixels it was drawn over. Drawing the same DrawData at the same place
+	 * over the same pixels again, as happens when the mouse hovers a widget,
+	 * only copies the result back instead of rendering the steps.
+	 */
+	struct DrawCacheEntry {
+		DrawData type;
+		uint32 dynamic;
+		const Graphics::ManagedSurface *surface;
+		Common::Rect area;
+		Common::Rect clip;
+		Common::Rect rect;   ///< The area of the surface which was saved
+		byte *before;        ///< Pixels of rect before drawing
+		byte *after;         ///< Pixels of rect after drawing
+		uint32 size;         ///< Size of each of the pixel buffers
+		uint32 lastUse;
+	};
+
+	/** Cache of rendered DrawData, see drawStepsCached(). */
+	Common::Array<DrawCacheEntry *> _drawCache;
+	uint32 _drawCacheSize;
+	uint32 _drawCacheClock;
+
 	/**
 	 * Filter the submitted DrawData descriptors according to their layer attribute
 	 *
@@ -20,6 +20,7 @@
  *
  */
 
+#include "gui/ThemeCache.h"
 #include "gui/ThemeEngine.h"
 #include "gui/ThemeEval.h"
 #include "gui/ThemeParser.h"
@@ -128,6 +129,7 @@ ThemeParser::ThemeParser(ThemeEngine *parent) : XMLParser() {
 	_defaultStepGlobal = defaultDrawStep();
 	_defaultStepLocal = nullptr;
 	_theme = parent;
+	_cache = nullptr;
 
 	_baseWidth = _baseHeight = 0;
 	_scaleFactor = 1.0f;
@@ -245,6 +247,11 @@ bool ThemeParser::parserCallback_language(ParserNode *node) {
 	}
 
 
+	if (_cache) {
+		_cache->storeFontNames(textDataId, node->values["id"], file, scalableFile, pointsize);
+		_cache->addFont(textDataId, node->values["id"], file, scalableFile, pointsize);
+	}
+
 	_theme->storeFontNames(textDataId, node->values["id"], file, scalableFile, pointsize);
 
 	if (!_theme->addFont(textDataId, node->values["id"], file, scalableFile, pointsize))
@@ -265,6 +272,9 @@ bool ThemeParser::parserCallback_text_color(ParserNode *node) {
 	else if (!parseIntegerKey(node->values["color"], 3, &red, &green, &blue))
 		return parserError("Error parsing color value for text color definition.");
 
+	if (_cache)
+		_cache->addTextColor(colorId, red, green, blue);
+
 	if (!_theme->addTextColor(colorId, red, green, blue))
 		return parserError("Error while adding text color information.");
 
@@ -286,6 +296,9 @@ bool ThemeParser::parserCallback_cursor(ParserNode *node) {
 	if (!parseIntegerKey(node->values["hotspot"], 2, &spotx, &spoty))
 		return parserError("Error parsing cursor Hot Spot coordinates.");
 
+	if (_cache)
+		_cache->createCursor(node->values["file"], spotx, spoty);
+
 	if (!_theme->createCursor(node->values["file"], spotx, spoty))
 		return parserError("Error creating Bitmap Cursor.");
 
@@ -318,6 +331,9 @@ bool ThemeParser::parserCallback_bitmap(ParserNode *node) {
 			return parserError("Error parsing width height");
 	}
 
+	if (_cache)
+		_cache->addBitmap(node->values["filename"], scalableFile, width, height);
+
 	if (!_theme->addBitmap(node->values["filename"], scalableFile, width, height))
 		return parserError("Error loading Bitmap file '" + node->values["filename"] + "'");
 
@@ -338,6 +354,9 @@ bool ThemeParser::parserCallback_text(ParserNode *node) {
 	TextData textDataId = parseTextDataId(node->values["font"]);
 	TextColor textColorId = parseTextColorId(node->values["text_color"]);
 
+	if (_cache)
+		_cache->addTextData(id, textDataId, textColorId, alignH, alignV);
+
 	if (!_theme->addTextData(id, textDataId, textColorId, alignH, alignV))
 		return parserError("Error adding Text Data for '" + id + "'.");
 
@@ -382,7 +401,7 @@ bool ThemeParser::parserCallback_color(ParserNode *node) {
 }
 
 
-static Graphics::DrawingFunctionCallback getDrawingFunctionCallback(const Common::String &name) {
+Graphics::DrawingFunctionCallback ThemeParser::getDrawingFunctionCallback(const Common::String &name) {
 
 	if (name == "circle")
 		return &Graphics::VectorRenderer::drawCallback_CIRCLE;
@@ -428,6 +447,11 @@ bool ThemeParser::parserCallback_drawstep(ParserNode *node) {
 		return false;
 	}
 
+	if (_cache) {
+		Common::String bitmap = drawstep->blitSrc ? node->values["file"] : Common::String();
+		_cache->addDrawStep(getParentNode(node)->values["id"], functionName, bitmap, *drawstep);
+	}
+
 	_theme->addDrawStep(getParentNode(node)->values["id"], *drawstep);
 	delete drawstep;
 
@@ -447,6 +471,9 @@ bool ThemeParser::parserCallback_drawdata(ParserNode *node) {
 			return parserError("'Parsed' value must be either true or false.");
 	}
 
+	if (_cache)
+		_cache->addDrawData(node->values["id"], cached);
+
 	if (_theme->addDrawData(node->values["id"], cached) == false)
 		return parserError("Error adding Draw Data set: Invalid DrawData name.");
 
@@ -691,7 +718,7 @@ bool ThemeParser::parserCallback_def(ParserNode *node) {
 	if (scalable)
 		value = SCALEVALUE(value);
 
-	_theme->getEvaluator()->setVar(var, value);
+	setVar(var, value);
 	return true;
 }
 
@@ -746,6 +773,8 @@ bool ThemeParser::parserCallback_widget(ParserNode *node) {
 		if (node->values.contains("rtl"))
 			useRTL = parseBoolean(node->values["rtl"]);
 
+		if (_cache)
+			_cache->addWidget(var, node->values["type"], width, height, alignH, useRTL);
 		_theme->getEvaluator()->addWidget(var, node->values["type"], width, height, alignH, useRTL);
 	}
 
@@ -783,6 +812,8 @@ bool ThemeParser::parserCallback_dialog(ParserNode *node) {
 			return false;
 	}
 
+	if (_cache)
+		_cache->addDialog(name, overlays, SCALEVALUE(width), SCALEVALUE(height), inset);
 	_theme->getEvaluator()->addDialog(name, overlays, SCALEVALUE(width), SCALEVALUE(height), inset);
 
 	if (node->values.contains("shading")) {
@@ -793,7 +824,7 @@ bool ThemeParser::parserCallback_dialog(ParserNode *node) {
 			shading = 2;
 		else return parserError("Invalid value for Dialog background shading.");
 
-		_theme->getEvaluator()->setVar("Dialog." + name + ".Shading", shading);
+		setVar("Dialog." + name + ".Shading", shading);
 	}
 
 	return true;
@@ -805,6 +836,8 @@ bool ThemeParser::parserCallback_import(ParserNode *node) {
 	if (!_theme->getEvaluator()->hasDialog(importedName))
 		return parserError("Imported layout was not found: " + importedName);
 
+	if (_cache)
+		_cache->addImportedLayout(importedName);
 	_theme->getEvaluator()->addImportedLayout(importedName);
 
 	return true;
@@ -837,13 +870,18 @@ bool ThemeParser::parserCallback_layout(ParserNode *node) {
 		}
 	}
 
+	GUI::ThemeLayout::LayoutType type;
 	if (node->values["type"] == "vertical")
-		_theme->getEvaluator()->addLayout(GUI::ThemeLayout::kLayoutVertical, spacing, itemAlign);
+		type = GUI::ThemeLayout::kLayoutVertical;
 	else if (node->values["type"] == "horizontal")
-		_theme->getEvaluator()->addLayout(GUI::ThemeLayout::kLayoutHorizontal, spacing, itemAlign);
+		type = GUI::ThemeLayout::kLayoutHorizontal;
 	else
 		return parserError("Invalid layout type. Only 'horizontal' and 'vertical' layouts allowed.");
 
+	if (_cache)
+		_cache->addLayout(type, spacing, itemAlign);
+	_theme->getEvaluator()->addLayout(type, spacing, itemAlign);
+
 	if (node->values.contains("padding")) {
 		int paddingL, paddingR, paddingT, paddingB;
 
@@ -851,6 +889,8 @@ bool ThemeParser::parserCallback_layout(ParserNode *node) {
 			return false;
 
 		// values are scaled inside this method
+		if (_cache)
+			_cache->addPadding(paddingL, paddingR, paddingT, paddingB);
 		_theme->getEvaluator()->addPadding(paddingL, paddingR, paddingT, paddingB);
 	}
 
@@ -870,15 +910,22 @@ bool ThemeParser::parserCallback_space(ParserNode *node) {
 			return parserError("Invalid value for Spacing size.");
 	}
 
+	if (_cache)
+		_cache->addSpace(size);
 	_theme->getEvaluator()->addSpace(size);
 	return true;
 }
 
 bool ThemeParser::closedKeyCallback(ParserNode *node) {
-	if (node->name == "layout")
+	if (node->name == "layout") {
+		if (_cache)
+			_cache->closeLayout();
 		_theme->getEvaluator()->closeLayout();
-	else if (node->name == "dialog")
+	} else if (node->name == "dialog") {
+		if (_cache)
+			_cache->closeDialog();
 		_theme->getEvaluator()->closeDialog();
+	}
 
 	return true;
 }
@@ -931,8 +978,8 @@ bool ThemeParser::parseCommonLayoutProps(ParserNode *node, const Common::String
 				return false;
 		}
 
-		_theme->getEvaluator()->setVar(var + "Width", width);
-		_theme->getEvaluator()->setVar(var + "Height", height);
+		setVar(var + "Width", width);
+		setVar(var + "Height", height);
 	}
 
 	if (node->values.contains("pos")) {
@@ -992,8 +1039,8 @@ bool ThemeParser::parseCommonLayoutProps(ParserNode *node, const Common::String
 				return false;
 		}
 
-		_theme->getEvaluator()->setVar(var + "X", x);
-		_theme->getEvaluator()->setVar(var + "Y", y);
+		setVar(var + "X", x);
+		setVar(var + "Y", y);
 	}
 
 	if (node->values.contains("padding")) {
@@ -1002,10 +1049,10 @@ bool ThemeParser::parseCommonLayoutProps(ParserNode *node, const Common::String
 		if (!parseIntegerKey(node->values["padding"], 4, &paddingL, &paddingR, &paddingT, &paddingB))
 			return false;
 
-		_theme->getEvaluator()->setVar(var + "Padding.Left", SCALEVALUE(paddingL));
-		_theme->getEvaluator()->setVar(var + "Padding.Right", SCALEVALUE(paddingR));
-		_theme->getEvaluator()->setVar(var + "Padding.Top", SCALEVALUE(paddingT));
-		_theme->getEvaluator()->setVar(var + "Padding.Bottom", SCALEVALUE(paddingB));
+		setVar(var + "Padding.Left", SCALEVALUE(paddingL));
+		setVar(var + "Padding.Right", SCALEVALUE(paddingR));
+		setVar(var + "Padding.Top", SCALEVALUE(paddingT));
+		setVar(var + "Padding.Bottom", SCALEVALUE(paddingB));
 	}
 
 
@@ -1015,11 +1062,17 @@ bool ThemeParser::parseCommonLayoutProps(ParserNode *node, const Common::String
 		if ((alignH = parseTextHAlign(node->values["textalign"])) == Graphics::kTextAlignInvalid)
 			return parserError("Invalid value for text alignment.");
 
-		_theme->getEvaluator()->setVar(var + "Align", alignH);
+		setVar(var + "Align", alignH);
 	}
 	return true;
 }
 
+void ThemeParser::setVar(const Common::String &name, int val) {
+	if (_cache)
+		_cache->setVar(name, val);
+	_theme->getEvaluator()->setVar(name, val);
+}
+
 bool ThemeParser::resolutionCheck(const Common::String &resolution) {
 	if (resolution.empty())
 		return true;
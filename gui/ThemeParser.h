@@ -26,8 +26,11 @@
 #include "common/scummsys.h"
 #include "common/xmlparser.h"
 
+#include "graphics/VectorRenderer.h"
+
 namespace GUI {
 
+class ThemeCache;
 class ThemeEngine;
 
 class ThemeParser : public Common::XMLParser {
@@ -53,8 +56,18 @@ public:
 		return true;
 	}
 
+	/**
+	 * Record the calls made to the theme engine while parsing into @p cache,
+	 * or stop recording when it is null.
+	 */
+	void setCache(ThemeCache *cache) { _cache = cache; }
+
+	/** Return the drawing function called @p name in the theme files, or null. */
+	static Graphics::DrawingFunctionCallback getDrawingFunctionCallback(const Common::String &name);
+
 protected:
 	ThemeEngine *_theme;
+	ThemeCache *_cache;
 
 	CUSTOM_XML_PARSER(ThemeParser) {
 		XML_KEY(render_info)
@@ -267,6 +280,7 @@ protected:
 	Graphics::DrawStep *defaultDrawStep();
 	bool parseDrawStep(ParserNode *stepNode, Graphics::DrawStep *drawstep, bool functionSpecific);
 	bool parseCommonLayoutProps(ParserNode *node, const Common::String &var);
+	void setVar(const Common::String &name, int val);
 
 	Graphics::DrawStep *_defaultStepGlobal;
 	Graphics::DrawStep *_defaultStepLocal;
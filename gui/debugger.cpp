@@ -26,6 +26,9 @@
 #include "common/file.h"
 #include "common/debug.h"
 #include "common/debug-channels.h"
+#include "common/memtrack.h"
+#include "common/mutex.h"
+#include "common/profiler.h"
 #include "common/system.h"
 
 #ifndef DISABLE_MD5
@@ -36,6 +39,9 @@
 #endif
 
 #include "engines/engine.h"
+#include "engines/snapshots.h"
+
+#include "audio/mixer.h"
 
 #include "gui/debugger.h"
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
@@ -79,6 +85,13 @@ Debugger::Debugger() {
 	registerCmd("debugflag_list",		WRAP_METHOD(Debugger, cmdDebugFlagsList));
 	registerCmd("debugflag_enable",	WRAP_METHOD(Debugger, cmdDebugFlagEnable));
 	registerCmd("debugflag_disable",	WRAP_METHOD(Debugger, cmdDebugFlagDisable));
+
+	registerCmd("mixer_stats",		WRAP_METHOD(Debugger, cmdMixerStats));
+	registerCmd("profile",			WRAP_METHOD(Debugger, cmdProfile));
+	registerCmd("mem",				WRAP_METHOD(Debugger, cmdMem));
+	registerCmd("mutex_stats",		WRAP_METHOD(Debugger, cmdMutexStats));
+	registerCmd("snapshot",			WRAP_METHOD(Debugger, cmdSnapshot));
+	registerCmd("rewind",			WRAP_METHOD(Debugger, cmdRewind));
 }
 
 Debugger::~Debugger() {
@@ -804,6 +817,219 @@ bool Debugger::cmdDebugFlagDisable(int argc, const char **argv) {
 	return true;
 }
 
+bool Debugger::cmdMixerStats(int argc, const char **argv) {
+	Audio::Mixer *mixer = g_system->getMixer();
+	if (!mixer) {
+		debugPrintf("No mixer available\n");
+		return true;
+	}
+
+	if (argc == 2) {
+		if (!scumm_stricmp(argv[1], "on")) {
+			mixer->enableStatistics(true);
+			debugPrintf("Mixer statistics enabled\n");
+		} else if (!scumm_stricmp(argv[1], "off")) {
+			mixer->enableStatistics(false);
+			debugPrintf("Mixer statistics disabled\n");
+		} else if (!scumm_stricmp(argv[1], "reset")) {
+			mixer->resetStatistics();
+			debugPrintf("Mixer statistics reset\n");
+		} else {
+			debugPrintf("Usage: %s [on|off|reset]\n", argv[0]);
+		}
+		return true;
+	}
+
+	Audio::Mixer::Statistics stats;
+	if (!mixer->getStatistics(stats)) {
+		debugPrintf("The mixer does not support statistics\n");
+		return true;
+	}
+	if (!mixer->isStatisticsEnabled()) {
+		debugPrintf("Mixer statistics are disabled, use '%s on' to enable them\n", argv[0]);
+		return true;
+	}
+
+	// The load is the share of the audio's duration spent mixing it
+	const double load = stats.audioMicros ? (100.0 * stats.mixMicros) / stats.audioMicros : 0.0;
+	debugPrintf("Callbacks: %u, overruns: %u, longest: %u us, load: %.2f%%\n",
+		stats.callbacks, stats.overruns, stats.maxMixMicros, load);
+
+	static const char *const typeNames[] = { "plain", "music", "sfx", "speech" };
+	debugPrintf("ID     Type   Rate   Ch Converter Samples    Load    Longest\n");
+	for (uint i = 0; i < stats.channels.size(); ++i) {
+		const Audio::Mixer::ChannelStatistics &chan = stats.channels[i];
+		const double channelLoad = stats.audioMicros ? (100.0 * chan.mixMicros) / stats.audioMicros : 0.0;
+		debugPrintf("%-6d %-6s %-6u %-2d %-9s %-10u %6.2f%% %6u us\n",
+			chan.id, typeNames[chan.type], chan.inputRate, chan.stereo ? 2 : 1,
+			chan.converter, (uint)chan.samples, channelLoad, chan.maxMixMicros);
+	}
+
+	return true;
+}
+
+bool Debugger::cmdProfile(int argc, const char **argv) {
+#ifdef ENABLE_PROFILER
+	Common::Profiler &profiler = Common::Profiler::instance();
+	uint frames = 60;
+
+	if (argc == 2) {
+		if (!scumm_stricmp(argv[1], "reset")) {
+			profiler.reset();
+			debugPrintf("Profiler reset\n");
+			return true;
+		}
+		frames = atoi(argv[1]);
+	}
+	if (argc > 2 || frames == 0) {
+		debugPrintf("Usage: %s [frames|reset]\n", argv[0]);
+		return true;
+	}
+
+	frames = MIN(frames, profiler.getFrameCount());
+	if (frames == 0) {
+		debugPrintf("No frame was profiled. The engine may not support the profiler.\n");
+		return true;
+	}
+
+	Common::Array<Common::Profiler::ZoneStats> stats;
+	profiler.getStats(frames, stats);
+
+	// The times are the averages over the frames
+	debugPrintf("Zones over the last %u frames, per frame:\n", frames);
+	debugPrintf("%-40s %10s %10s %8s\n", "Zone", "Total us", "Self us", "Calls");
+	for (uint i = 0; i < stats.size(); ++i) {
+		const Common::Profiler::ZoneStats &zone = stats[i];
+		Common::String name = Common::String::format("%*s%s", (int)MIN<uint>(zone.depth * 2, 20), "", zone.name);
+		debugPrintf("%-40s %10u %10u %8.1f\n", name.c_str(),
+			(uint)(zone.totalMicros / frames), (uint)(zone.selfMicros / frames),
+			(double)zone.calls / frames);
+	}
+#else
+	debugPrintf("The profiler is not available. Configure ScummVM with --enable-profiler to build it.\n");
+#endif
+	return true;
+}
+
+bool Debugger::cmdMem(int argc, const char **argv) {
+#ifdef ENABLE_PROFILER
+	Common::MemoryTracker &tracker = Common::MemoryTracker::instance();
+
+	if (argc == 2 && !scumm_stricmp(argv[1], "reset")) {
+		tracker.resetPeaks();
+		debugPrintf("Memory peaks reset\n");
+		return true;
+	}
+	if (argc > 1) {
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	Common::Array<Common::MemoryTracker::TagStats> stats;
+	tracker.getStats(stats);
+	if (stats.empty()) {
+		debugPrintf("No memory was reported. The engine may not support the memory tracker.\n");
+		return true;
+	}
+
+	debugPrintf("%-32s %12s %12s\n", "Tag", "Current KB", "Peak KB");
+	for (uint i = 0; i < stats.size(); ++i) {
+		debugPrintf("%-32s %12u %12u\n", stats[i].name,
+		            (uint)((stats[i].current + 1023) / 1024), (uint)((stats[i].peak + 1023) / 1024));
+	}
+	debugPrintf("%-32s %12u %12u\n", "Total",
+	            (uint)((tracker.getTotal() + 1023) / 1024), (uint)((tracker.getPeakTotal() + 1023) / 1024));
+#else
+	debugPrintf("The memory tracker is not available. Configure ScummVM with --enable-profiler to build it.\n");
+#endif
+	return true;
+}
+
+bool Debugger::cmdMutexStats(int argc, const char **argv) {
+#ifdef ENABLE_PROFILER
+	Common::Array<Common::MutexStats> stats;
+	Common::getMutexStats(stats);
+
+	debugPrintf("%-32s %10s %10s %10s %10s\n", "Mutex", "Locks", "Contended", "Wait us", "Max hold us");
+	for (uint i = 0; i < stats.size(); ++i) {
+		debugPrintf("%-32s %10u %10u %10u %10u\n", stats[i].name, (uint)stats[i].acquisitions,
+		            (uint)stats[i].contended, (uint)stats[i].waitMicros, (uint)stats[i].maxHoldMicros);
+	}
+#else
+	debugPrintf("The mutex statistics are not available. Configure ScummVM with --enable-profiler to build them.\n");
+#endif
+	return true;
+}
+
+bool Debugger::cmdSnapshot(int argc, const char **argv) {
+	if (argc > 2 || (argc == 2 && scumm_stricmp(argv[1], "clear"))) {
+		debugPrintf("Usage: %s [clear]\n", argv[0]);
+		return true;
+	}
+
+	if (!g_engine) {
+		debugPrintf("No game is running\n");
+		return true;
+	}
+
+	SnapshotManager *snapshots = g_engine->getSnapshotManager();
+	if (argc == 2) {
+		snapshots->clear();
+		debugPrintf("Snapshots cleared\n");
+		return true;
+	}
+
+	if (!g_engine->canSaveGameStateCurrently()) {
+		debugPrintf("The game cannot be saved at the moment\n");
+		return true;
+	}
+
+	const uint32 start = g_system->getMillis();
+	Common::Error error = snapshots->takeSnapshot();
+	if (error.getCode() != Common::kNoError) {
+		debugPrintf("Taking the snapshot failed: %s\n", error.getDesc().c_str());
+		return true;
+	}
+
+	debugPrintf("Took snapshot %u in %u ms, %u KB used by all of them\n", snapshots->getSnapshotCount(),
+	            g_system->getMillis() - start, (snapshots->getMemoryUsage() + 1023) / 1024);
+	return true;
+}
+
+bool Debugger::cmdRewind(int argc, const char **argv) {
+	if (argc > 2) {
+		debugPrintf("Usage: %s [steps back]\n", argv[0]);
+		return true;
+	}
+
+	if (!g_engine) {
+		debugPrintf("No game is running\n");
+		return true;
+	}
+
+	SnapshotManager *snapshots = g_engine->getSnapshotManager();
+	const uint stepsBack = (argc == 2) ? atoi(argv[1]) : 0;
+	if (stepsBack >= snapshots->getSnapshotCount()) {
+		debugPrintf("There are only %u snapshots\n", snapshots->getSnapshotCount());
+		return true;
+	}
+
+	if (!g_engine->canLoadGameStateCurrently()) {
+		debugPrintf("The game cannot be loaded at the moment\n");
+		return true;
+	}
+
+	const uint32 start = g_system->getMillis();
+	Common::Error error = snapshots->restoreSnapshot(stepsBack);
+	if (error.getCode() != Common::kNoError) {
+		debugPrintf("Restoring the snapshot failed: %s\n", error.getDesc().c_str());
+		return true;
+	}
+
+	debugPrintf("Restored snapshot %u in %u ms\n", snapshots->getSnapshotCount(), g_system->getMillis() - start);
+	return true;
+}
+
 // Console handler
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 bool Debugger::debuggerInputCallback(GUI::ConsoleDialog *console, const char *input, void *refCon) {
@@ -243,6 +243,12 @@ protected:
 	bool cmdDebugFlagEnable(int argc, const char **argv);
 	bool cmdDebugFlagDisable(int argc, const char **argv);
 	bool cmdExecFile(int argc, const char **argv);
+	bool cmdMixerStats(int argc, const char **argv);
+	bool cmdProfile(int argc, const char **argv);
+	bool cmdMem(int argc, const char **argv);
+	bool cmdMutexStats(int argc, const char **argv);
+	bool cmdSnapshot(int argc, const char **argv);
+	bool cmdRewind(int argc, const char **argv);
 
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 private:
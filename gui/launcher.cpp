@@ -92,10 +92,13 @@ enum {
 	kCmdSavePathClear = 'PSAC'
 };
 
+/** Number of game paths checked by LauncherDialog::handleTickle() on each tick. */
+static const int kDomainsScannedPerTick = 32;
+
 #pragma mark -
 
 LauncherDialog::LauncherDialog()
-	: Dialog("Launcher") {
+	: Dialog("Launcher"), _nextDomainToScan(-1) {
 
 	_backgroundType = GUI::ThemeEngine::kDialogBackgroundMain;
 
@@ -270,8 +273,6 @@ struct LauncherEntryComparator {
 
 void LauncherDialog::updateListing() {
 	U32StringArray l;
-	ListWidget::ColorList colors;
-	ThemeEngine::FontColor color;
 	int numEntries = ConfMan.getInt("gui_list_max_scan_entries");
 
 	// Retrieve a list of all games defined in the config file
@@ -280,7 +281,8 @@ void LauncherDialog::updateListing() {
 	bool scanEntries = numEntries == -1 ? true : ((int)domains.size() <= numEntries);
 
 	// Turn it into a list of pointers
-	Common::List<LauncherEntry> domainList;
+	Common::Array<LauncherEntry> domainList;
+	domainList.reserve(domains.size());
 	for (ConfigManager::DomainMap::const_iterator iter = domains.begin(); iter != domains.end(); ++iter) {
 		// Do not list temporary targets added when starting a game from the command line
 		if (iter->_value.contains("id_came_from_command_line"))
@@ -310,29 +312,19 @@ void LauncherDialog::updateListing() {
 	// Now sort the list in dictionary order
 	Common::sort(domainList.begin(), domainList.end(), LauncherEntryComparator());
 
-	// And fill out our structures
-	for (Common::List<LauncherEntry>::const_iterator iter = domainList.begin(); iter != domainList.end(); ++iter) {
-		color = ThemeEngine::kFontColorNormal;
-
-		if (scanEntries) {
-			Common::FSNode path(iter->domain->getVal("path"));
-			if (!path.isDirectory()) {
-				color = ThemeEngine::kFontColorAlternate;
-				// If more conditions which grey out entries are added we should consider
-				// enabling this so that it is easy to spot why a certain game entry cannot
-				// be started.
-
-				// description += Common::String::format(" (%s)", _("Not found"));
-			}
-		}
-
+	// And fill out our structures. The paths of the games are checked later
+	// on, a few at a time, by handleTickle(), so that the list shows up right
+	// away even with a huge number of games.
+	l.reserve(domainList.size());
+	_domains.reserve(domainList.size());
+	for (Common::Array<LauncherEntry>::const_iterator iter = domainList.begin(); iter != domainList.end(); ++iter) {
 		l.push_back(iter->description);
-		colors.push_back(color);
 		_domains.push_back(iter->key);
 	}
+	_nextDomainToScan = scanEntries ? 0 : -1;
 
 	const int oldSel = _list->getSelected();
-	_list->setList(l, &colors);
+	_list->setList(l);
 	if (oldSel < (int)l.size())
 		_list->setSelected(oldSel);	// Restore the old selection
 	else if (oldSel != -1)
@@ -538,6 +530,32 @@ void LauncherDialog::handleKeyUp(Common::KeyState state) {
 	updateButtons();
 }
 
+void LauncherDialog::handleTickle() {
+	// Grey out the games whose directory is missing, a few games per tick.
+	for (int i = 0; _nextDomainToScan != -1 && i < kDomainsScannedPerTick; ++i) {
+		if (_nextDomainToScan >= (int)_domains.size()) {
+			_nextDomainToScan = -1;
+			break;
+		}
+
+		const ConfigManager::Domain *domain = ConfMan.getDomain(_domains[_nextDomainToScan]);
+		if (domain) {
+			Common::FSNode path(domain->getVal("path"));
+			if (!path.isDirectory()) {
+				_list->setItemColor(_nextDomainToScan, ThemeEngine::kFontColorAlternate);
+				// If more conditions which grey out entries are added we should consider
+				// enabling this so that it is easy to spot why a certain game entry cannot
+				// be started.
+
+				// description += Common::String::format(" (%s)", _("Not found"));
+			}
+		}
+		++_nextDomainToScan;
+	}
+
+	Dialog::handleTickle();
+}
+
 void LauncherDialog::handleOtherEvent(const Common::Event &evt) {
 	Dialog::handleOtherEvent(evt);
 	if (evt.type == Common::EVENT_DROP_FILE) {
@@ -55,6 +55,7 @@ public:
 	void handleKeyDown(Common::KeyState state) override;
 	void handleKeyUp(Common::KeyState state) override;
 	void handleOtherEvent(const Common::Event &evt) override;
+	void handleTickle() override;
 	bool doGameDetection(const Common::String &path);
 protected:
 	EditTextWidget  *_searchWidget;
@@ -70,6 +71,11 @@ protected:
 	StaticTextWidget	*_searchDesc;
 	ButtonWidget	*_searchClearButton;
 	StringArray		_domains;
+	/**
+	 * Index in _domains of the next target whose path handleTickle() checks,
+	 * or -1 if no path is to be checked.
+	 */
+	int				_nextDomainToScan;
 	BrowserDialog	*_browser;
 	SaveLoadChooser	*_loadDialog;
 
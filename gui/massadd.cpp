@@ -26,6 +26,7 @@
 #include "common/debug.h"
 #include "common/system.h"
 #include "common/taskbar.h"
+#include "common/timer.h"
 #include "common/translation.h"
 
 #include "gui/massadd.h"
@@ -45,9 +46,20 @@ enum {
 	// Upper bound (im milliseconds) we want to spend in handleTickle.
 	// Setting this low makes the GUI more responsive but also slows
 	// down the scanning.
-	kMaxScanTime = 50
+	kMaxScanTime = 50,
+
+	// Upper bound (in milliseconds) the timer callback spends listing
+	// directories each time it is called.
+	kMaxListTime = 20,
+
+	// How many listed directories may wait for detection before the
+	// scanner pauses.
+	kMaxScannedDirs = 64
 };
 
+// Interval (in microseconds) of the timer callback listing directories
+#define MASS_ADD_SCAN_INTERVAL 10000
+
 enum {
 	kOkCmd = 'OK  ',
 	kCancelCmd = 'CNCL'
@@ -60,6 +72,8 @@ MassAddDialog::MassAddDialog(const Common::FSNode &startDir)
 	_dirsScanned(0),
 	_oldGamesCount(0),
 	_dirTotal(0),
+	_dirsListing(0),
+	_scannerInstalled(false),
 	_okButton(nullptr),
 	_dirProgressText(nullptr),
 	_gameProgressText(nullptr) {
@@ -105,6 +119,61 @@ MassAddDialog::MassAddDialog(const Common::FSNode &startDir)
 		if (!path.empty())
 			_pathToTargets[path].push_back(iter->_key);
 	}
+
+	// List the directories ahead of the detection, which runs on the GUI
+	// thread as it relies on state shared with the rest of the program
+	_scannerInstalled = g_system->getTimerManager()->installTimerProc(&scannerProc, MASS_ADD_SCAN_INTERVAL, this, "massAddScanner");
+}
+
+MassAddDialog::~MassAddDialog() {
+	stopScanner();
+}
+
+void MassAddDialog::stopScanner() {
+	if (_scannerInstalled) {
+		g_system->getTimerManager()->removeTimerProc(&scannerProc);
+		_scannerInstalled = false;
+	}
+}
+
+void MassAddDialog::scannerProc(void *refCon) {
+	((MassAddDialog *)refCon)->scanDirectories(kMaxListTime);
+}
+
+void MassAddDialog::scanDirectories(uint32 maxTime) {
+	uint32 t = g_system->getMillis();
+
+	// Perform a breadth-first scan of the filesystem.
+	while (g_system->getMillis() - t < maxTime) {
+		ScannedDir scanned;
+		{
+			Common::StackLock lock(_scanMutex);
+			if (_scanStack.empty() || _scannedDirs.size() >= kMaxScannedDirs)
+				return;
+
+			scanned.dir = _scanStack.pop();
+			_dirsListing++;
+		}
+
+		// Listing may be slow, so do it without holding the lock
+		bool listed = scanned.dir.getChildren(scanned.files, Common::FSNode::kListAll);
+
+		Common::StackLock lock(_scanMutex);
+		_dirsListing--;
+		if (!listed)
+			continue;
+
+		// Recurse into all subdirs
+		for (Common::FSList::const_iterator file = scanned.files.begin(); file != scanned.files.end(); ++file) {
+			if (file->isDirectory()) {
+				_scanStack.push(*file);
+
+				_dirTotal++;
+			}
+		}
+
+		_scannedDirs.push(scanned);
+	}
 }
 
 struct GameTargetLess {
@@ -129,6 +198,8 @@ void MassAddDialog::handleCommand(CommandSender *sender, uint32 cmd, uint32 data
 
 	// FIXME: It's a really bad thing that we use two arbitrary constants
 	if (cmd == kOkCmd) {
+		stopScanner();
+
 		// Sort the detected games. This is not strictly necessary, but nice for
 		// people who want to edit their config file by hand after a mass add.
 		Common::sort(_games.begin(), _games.end(), GameTargetLess());
@@ -152,6 +223,7 @@ void MassAddDialog::handleCommand(CommandSender *sender, uint32 cmd, uint32 data
 		close();
 	} else if (cmd == kCancelCmd) {
 		// User cancelled, so we don't do anything and just leave.
+		stopScanner();
 		_games.clear();
 		close();
 	} else {
@@ -160,20 +232,27 @@ void MassAddDialog::handleCommand(CommandSender *sender, uint32 cmd, uint32 data
 }
 
 void MassAddDialog::handleTickle() {
-	if (_scanStack.empty())
+	if (_okButton->isEnabled())
 		return;	// We have finished scanning
 
-	uint32 t = g_system->getMillis();
+	// Without a timer, the directories are listed here as well
+	if (!_scannerInstalled)
+		scanDirectories(kMaxScanTime / 2);
 
-	// Perform a breadth-first scan of the filesystem.
-	while (!_scanStack.empty() && (g_system->getMillis() - t) < kMaxScanTime) {
-		Common::FSNode dir = _scanStack.pop();
+	uint32 t = g_system->getMillis();
 
-		Common::FSList files;
-		if (!dir.getChildren(files, Common::FSNode::kListAll)) {
-			continue;
+	while ((g_system->getMillis() - t) < kMaxScanTime) {
+		ScannedDir scanned;
+		{
+			Common::StackLock lock(_scanMutex);
+			if (_scannedDirs.empty())
+				break;
+			scanned = _scannedDirs.pop();
 		}
 
+		const Common::FSNode &dir = scanned.dir;
+		const Common::FSList &files = scanned.files;
+
 		// Run the detector on the dir
 		DetectionResults detectionResults = EngineMan.detectGames(files);
 
@@ -228,29 +307,33 @@ void MassAddDialog::handleTickle() {
 			_list->append(result.description);
 		}
 
-
-		// Recurse into all subdirs
-		for (Common::FSList::const_iterator file = files.begin(); file != files.end(); ++file) {
-			if (file->isDirectory()) {
-				_scanStack.push(*file);
-
-				_dirTotal++;
-			}
-		}
-
 		_dirsScanned++;
 
 #if defined(USE_TASKBAR)
-		g_system->getTaskbarManager()->setProgressValue(_dirsScanned, _dirTotal);
+		int dirTotal;
+		{
+			Common::StackLock lock(_scanMutex);
+			dirTotal = _dirTotal;
+		}
+		g_system->getTaskbarManager()->setProgressValue(_dirsScanned, dirTotal);
 		g_system->getTaskbarManager()->setCount(_games.size());
 #endif
 	}
 
 
+	bool finished;
+	{
+		Common::StackLock lock(_scanMutex);
+		finished = _scanStack.empty() && _scannedDirs.empty() && _dirsListing == 0;
+	}
+
 	// Update the dialog
 	Common::U32String buf;
 
-	if (_scanStack.empty()) {
+	if (finished) {
+		stopScanner();
+
+
 		// Enable the OK button
 		_okButton->setEnabled(true);
 
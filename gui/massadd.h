@@ -27,6 +27,8 @@
 #include "gui/widgets/list.h"
 #include "common/fs.h"
 #include "common/hashmap.h"
+#include "common/mutex.h"
+#include "common/queue.h"
 #include "common/stack.h"
 #include "common/str.h"
 
@@ -39,6 +41,7 @@ class MassAddDialog : public Dialog {
 	typedef Common::Array<Common::U32String> U32StringArray;
 public:
 	MassAddDialog(const Common::FSNode &startDir);
+	~MassAddDialog() override;
 
 	//void open();
 	void handleCommand(CommandSender *sender, uint32 cmd, uint32 data) override;
@@ -51,7 +54,31 @@ public:
 	}
 
 private:
+	/** A directory listed by the scanner, waiting for detection. */
+	struct ScannedDir {
+		Common::FSNode dir;
+		Common::FSList files;
+	};
+
+	/**
+	 * List the directories waiting in _scanStack for at most @p maxTime
+	 * milliseconds, and queue them in _scannedDirs, unless enough of them
+	 * are already waiting for detection.
+	 */
+	void scanDirectories(uint32 maxTime);
+	static void scannerProc(void *refCon);
+	void stopScanner();
+
+	/**
+	 * The directories are listed from a timer callback while the detection
+	 * runs in handleTickle. This mutex guards the members shared by both.
+	 */
+	Common::Mutex _scanMutex;
 	Common::Stack<Common::FSNode>  _scanStack;
+	Common::Queue<ScannedDir> _scannedDirs;
+	int _dirsListing;
+	bool _scannerInstalled;
+
 	DetectedGames _games;
 
 	/**
@@ -758,7 +758,7 @@ enum {
 
 SaveLoadChooserGrid::SaveLoadChooserGrid(const Common::U32String &title, bool saveMode)
 	: SaveLoadChooserDialog("SaveLoadChooser", saveMode), _lines(0), _columns(0), _entriesPerPage(0),
-	_curPage(0), _newSaveContainer(nullptr), _nextFreeSaveSlot(0), _buttons() {
+	_curPage(0), _newSaveContainer(nullptr), _nextFreeSaveSlot(0), _buttons(), _nextButtonToLoad(0) {
 	_backgroundType = ThemeEngine::kDialogBackgroundSpecial;
 
 	_pageTitle = new StaticTextWidget(this, "SaveLoadChooser.Title", title);
@@ -846,6 +846,16 @@ void SaveLoadChooserGrid::handleMouseWheel(int x, int y, int direction) {
 	}
 }
 
+void SaveLoadChooserGrid::handleTickle() {
+	const uint firstEntry = _curPage * _entriesPerPage;
+	if (_nextButtonToLoad < _entriesPerPage && firstEntry + _nextButtonToLoad < _saveList.size() && _nextButtonToLoad < _buttons.size()) {
+		loadSaveButton(_nextButtonToLoad);
+		++_nextButtonToLoad;
+	}
+
+	SaveLoadChooserDialog::handleTickle();
+}
+
 void SaveLoadChooserGrid::updateSaveList() {
 	SaveLoadChooserDialog::updateSaveList();
 	updateSaves();
@@ -1092,61 +1102,83 @@ void SaveLoadChooserGrid::hideButtons() {
 	}
 }
 
-void SaveLoadChooserGrid::updateSaves() {
-	hideButtons();
+void SaveLoadChooserGrid::loadSaveButton(uint curNum) {
+	const SaveStateDescriptor &entry = _saveList[_curPage * _entriesPerPage + curNum];
+	const int saveSlot = entry.getSaveSlot();
+	SaveStateDescriptor desc = (entry.getLocked() ? entry : _metaEngine->querySaveMetaInfos(_target.c_str(), saveSlot));
+	SlotButton &curButton = _buttons[curNum];
+	const Graphics::Surface *thumbnail = desc.getThumbnail();
+	if (thumbnail) {
+		curButton.button->setGfx(desc.getThumbnail());
+	} else {
+		curButton.button->setGfx(kThumbnailWidth, kThumbnailHeight2, 0, 0, 0);
+	}
+	curButton.description->setLabel(Common::U32String(Common::String::format("%d. ", saveSlot)) + desc.getDescription());
 
-	for (uint i = _curPage * _entriesPerPage, curNum = 0; i < _saveList.size() && curNum < _entriesPerPage; ++i, ++curNum) {
-		const uint saveSlot = _saveList[i].getSaveSlot();
+	Common::U32String tooltip(_("Name: "));
+	tooltip += desc.getDescription();
 
-		SaveStateDescriptor desc =  (_saveList[i].getLocked() ? _saveList[i] : _metaEngine->querySaveMetaInfos(_target.c_str(), saveSlot));
-		SlotButton &curButton = _buttons[curNum];
-		curButton.setVisible(true);
-		const Graphics::Surface *thumbnail = desc.getThumbnail();
-		if (thumbnail) {
-			curButton.button->setGfx(desc.getThumbnail());
-		} else {
-			curButton.button->setGfx(kThumbnailWidth, kThumbnailHeight2, 0, 0, 0);
+	if (_saveDateSupport) {
+		const Common::U32String &saveDate = desc.getSaveDate();
+		if (!saveDate.empty()) {
+			tooltip += Common::U32String("\n");
+			tooltip +=  _("Date: ") + saveDate;
 		}
-		curButton.description->setLabel(Common::U32String(Common::String::format("%d. ", saveSlot)) + desc.getDescription());
-
-		Common::U32String tooltip(_("Name: "));
-		tooltip += desc.getDescription();
-
-		if (_saveDateSupport) {
-			const Common::U32String &saveDate = desc.getSaveDate();
-			if (!saveDate.empty()) {
-				tooltip += Common::U32String("\n");
-				tooltip +=  _("Date: ") + saveDate;
-			}
 
-			const Common::U32String &saveTime = desc.getSaveTime();
-			if (!saveTime.empty()) {
-				tooltip += Common::U32String("\n");
-				tooltip += _("Time: ") + saveTime;
-			}
+		const Common::U32String &saveTime = desc.getSaveTime();
+		if (!saveTime.empty()) {
+			tooltip += Common::U32String("\n");
+			tooltip += _("Time: ") + saveTime;
 		}
+	}
 
-		if (_playTimeSupport) {
-			const Common::U32String &playTime = desc.getPlayTime();
-			if (!playTime.empty()) {
-				tooltip += Common::U32String("\n");
-				tooltip += _("Playtime: ") + playTime;
-			}
+	if (_playTimeSupport) {
+		const Common::U32String &playTime = desc.getPlayTime();
+		if (!playTime.empty()) {
+			tooltip += Common::U32String("\n");
+			tooltip += _("Playtime: ") + playTime;
 		}
+	}
 
-		curButton.button->setTooltip(tooltip);
+	curButton.button->setTooltip(tooltip);
 
-		// In save mode we disable the button, when it's write protected.
-		// TODO: Maybe we should not display it at all then?
-		// We also disable and description the button if slot is locked
-		if ((_saveMode && desc.getWriteProtectedFlag()) || desc.getLocked()) {
-			curButton.button->setEnabled(false);
-		} else {
-			curButton.button->setEnabled(true);
-		}
+	// In save mode we disable the button, when it's write protected.
+	// TODO: Maybe we should not display it at all then?
+	// We also disable and description the button if slot is locked
+	if ((_saveMode && desc.getWriteProtectedFlag()) || desc.getLocked()) {
+		curButton.button->setEnabled(false);
+	} else {
+		curButton.button->setEnabled(true);
+	}
+	curButton.description->setEnabled(!desc.getLocked());
+
+	curButton.button->markAsDirty();
+	curButton.description->markAsDirty();
+}
+
+void SaveLoadChooserGrid::updateSaves() {
+	hideButtons();
+
+	// Only the descriptions from the save list are shown right away. The
+	// meta infos, which hold the thumbnails, are loaded from handleTickle(),
+	// one entry at a time, so that the page shows up instantly.
+	for (uint i = _curPage * _entriesPerPage, curNum = 0; i < _saveList.size() && curNum < _entriesPerPage; ++i, ++curNum) {
+		const SaveStateDescriptor &desc = _saveList[i];
+		SlotButton &curButton = _buttons[curNum];
+		curButton.setVisible(true);
+		curButton.button->setGfx(kThumbnailWidth, kThumbnailHeight2, 0, 0, 0);
+		curButton.description->setLabel(Common::U32String(Common::String::format("%d. ", desc.getSaveSlot())) + desc.getDescription());
+		curButton.button->setTooltip(Common::U32String());
+
+		// In save mode, the button stays disabled until we know whether the
+		// slot is write protected.
+		curButton.button->setEnabled(!_saveMode && !desc.getLocked());
 		curButton.description->setEnabled(!desc.getLocked());
 	}
 
+	_nextButtonToLoad = 0;
+
+
 	const uint numPages = (_entriesPerPage != 0 && !_saveList.empty()) ? ((_saveList.size() + _entriesPerPage - 1) / _entriesPerPage) : 1;
 	_pageDisplay->setLabel(Common::String::format("%u/%u", _curPage + 1, numPages));
 
@@ -211,6 +211,7 @@ public:
 protected:
 	void handleCommand(CommandSender *sender, uint32 cmd, uint32 data) override;
 	void handleMouseWheel(int x, int y, int direction) override;
+	void handleTickle() override;
 	void updateSaveList() override;
 private:
 	int runIntern() override;
@@ -249,6 +250,10 @@ private:
 	void destroyButtons();
 	void hideButtons();
 	void updateSaves();
+
+	/** Index in _buttons of the next button whose meta infos are loaded by handleTickle(). */
+	uint _nextButtonToLoad;
+	void loadSaveButton(uint curNum);
 };
 
 #endif // !DISABLE_SAVELOADCHOOSER_GRID
@@ -172,6 +172,11 @@ void ListWidget::setList(const U32StringArray &list, const ColorList *colors) {
 	// Copy everything
 	_dataList = list;
 	_list = list;
+	_lowercaseList.resize(list.size());
+	for (uint i = 0; i < list.size(); ++i) {
+		_lowercaseList[i] = list[i];
+		_lowercaseList[i].toLowercase();
+	}
 	_filter.clear();
 	_listIndex.clear();
 	_listColors.clear();
@@ -207,12 +212,31 @@ void ListWidget::append(const String &s, ThemeEngine::FontColor color) {
 
 	_dataList.push_back(s);
 	_list.push_back(s);
+	_lowercaseList.push_back(_dataList.back());
+	_lowercaseList.back().toLowercase();
 
 	setFilter(_filter, false);
 
 	scrollBarRecalc();
 }
 
+void ListWidget::setItemColor(int item, ThemeEngine::FontColor color) {
+	assert(item >= 0 && item < (int)_dataList.size());
+
+	if (_listColors.empty()) {
+		if (color == ThemeEngine::kFontColorNormal)
+			return;
+		_listColors.resize(_dataList.size());
+		for (uint i = 0; i < _listColors.size(); ++i)
+			_listColors[i] = ThemeEngine::kFontColorNormal;
+	}
+
+	if (_listColors[item] != color) {
+		_listColors[item] = color;
+		markAsDirty();
+	}
+}
+
 void ListWidget::scrollTo(int item) {
 	int size = _list.size();
 	if (item >= size)
@@ -750,6 +774,11 @@ void ListWidget::setFilter(const U32String &filter, bool redraw) {
 	if (_filter == filt) // Filter was not changed
 		return;
 
+	// When characters are appended to the filter, only the items which
+	// matched the previous filter can still match.
+	bool narrowing = !_filter.empty() && filt.size() > _filter.size() && _listIndex.size() == _list.size();
+	for (uint i = 0; narrowing && i < _filter.size(); ++i)
+		narrowing = (filt[i] == _filter[i]);
 	_filter = filt;
 
 	if (_filter.empty()) {
@@ -761,26 +790,35 @@ void ListWidget::setFilter(const U32String &filter, bool redraw) {
 		// as substrings, ignoring case.
 
 		Common::U32StringTokenizer tok(_filter);
-		U32String tmp;
-		int n = 0;
+		Common::Array<U32String> tokens;
+		while (!tok.empty())
+			tokens.push_back(tok.nextToken());
+
+		Common::Array<int> candidates;
+		if (narrowing) {
+			candidates = _listIndex;
+		} else {
+			candidates.resize(_dataList.size());
+			for (uint i = 0; i < candidates.size(); ++i)
+				candidates[i] = i;
+		}
 
 		_list.clear();
 		_listIndex.clear();
 
-		for (U32StringArray::iterator i = _dataList.begin(); i != _dataList.end(); ++i, ++n) {
-			tmp = *i;
-			tmp.toLowercase();
+		for (uint i = 0; i < candidates.size(); ++i) {
+			const int n = candidates[i];
+			const U32String &item = _lowercaseList[n];
 			bool matches = true;
-			tok.reset();
-			while (!tok.empty()) {
-				if (!tmp.contains(tok.nextToken())) {
+			for (uint t = 0; t < tokens.size(); ++t) {
+				if (!item.contains(tokens[t])) {
 					matches = false;
 					break;
 				}
 			}
 
 			if (matches) {
-				_list.push_back(*i);
+				_list.push_back(_dataList[n]);
 				_listIndex.push_back(n);
 			}
 		}
@@ -59,6 +59,7 @@ public:
 protected:
 	U32StringArray	_list;
 	U32StringArray		_dataList;
+	U32StringArray		_lowercaseList;	///< _dataList in lowercase, which the filter is matched against
 	ColorList		_listColors;
 	Common::Array<int>		_listIndex;
 	bool			_editable;
@@ -103,6 +104,9 @@ public:
 
 	void append(const String &s, ThemeEngine::FontColor color = ThemeEngine::kFontColorNormal);
 
+	/** Change the color of the item at index @p item of the unfiltered list. */
+	void setItemColor(int item, ThemeEngine::FontColor color);
+
 	void setSelected(int item);
 	int getSelected() const						{ return (_filter.empty() || _selectedItem == -1) ? _selectedItem : _listIndex[_selectedItem]; }
 
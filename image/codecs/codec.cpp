@@ -20,7 +20,7 @@
  *
  */
 
-#include "common/list.h"
+#include "common/array.h"
 #include "common/scummsys.h"
 
 #include "image/codecs/codec.h"
@@ -55,7 +55,7 @@ namespace {
 /**
  * Add a color to the QuickTime dither table check queue if it hasn't already been found.
  */
-inline void addColorToQueue(uint16 color, uint16 index, byte *checkBuffer, Common::List<uint16> &checkQueue) {
+inline void addColorToQueue(uint16 color, uint16 index, byte *checkBuffer, Common::Array<uint16> &checkQueue) {
 	if ((READ_UINT16(checkBuffer + color * 2) & 0xFF) == 0) {
 		// Previously unfound color
 		WRITE_UINT16(checkBuffer + color * 2, index);
@@ -78,7 +78,9 @@ byte *Codec::createQuickTimeDitherTable(const byte *palette, uint colorCount) {
 	byte *buf = new byte[0x10000];
 	memset(buf, 0, 0x10000);
 
-	Common::List<uint16> checkQueue;
+	// Each color is added at most once, so a plain array serves as the queue
+	Common::Array<uint16> checkQueue;
+	checkQueue.reserve(0x4000);
 
 	bool foundBlack = false;
 	bool foundWhite = false;
@@ -113,17 +115,16 @@ byte *Codec::createQuickTimeDitherTable(const byte *palette, uint colorCount) {
 
 	// More special handling for white
 	if (foundWhite)
-		checkQueue.push_front(0x3FFF);
+		checkQueue.insert_at(0, 0x3FFF);
 
 	// More special handling for black
 	if (foundBlack)
-		checkQueue.push_front(0);
+		checkQueue.insert_at(0, 0);
 
 	// Go through the list of colors we have and match up similar colors
 	// to fill in the table as best as we can.
-	while (!checkQueue.empty()) {
-		uint16 col = checkQueue.front();
-		checkQueue.pop_front();
+	for (uint head = 0; head < checkQueue.size(); head++) {
+		uint16 col = checkQueue[head];
 		uint16 index = READ_UINT16(buf + col * 2);
 
 		uint32 x = col << 4;
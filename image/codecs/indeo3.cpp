@@ -185,6 +185,23 @@ void Indeo3Decoder::allocFrames() {
 	}
 }
 
+template<typename PixelInt>
+static void upscaleSurface(Graphics::Surface &dst, const Graphics::Surface &src, uint32 scaleWidth, uint32 scaleHeight) {
+	for (int y = 0; y < dst.h; y++) {
+		PixelInt *dstRow = (PixelInt *)dst.getBasePtr(0, y);
+
+		if (y % scaleHeight) {
+			// Same source row as the one above
+			memcpy(dstRow, dst.getBasePtr(0, y - 1), dst.w * sizeof(PixelInt));
+			continue;
+		}
+
+		const PixelInt *srcRow = (const PixelInt *)src.getBasePtr(0, y / scaleHeight);
+		for (int x = 0; x < dst.w; x++)
+			dstRow[x] = srcRow[x / scaleWidth];
+	}
+}
+
 const Graphics::Surface *Indeo3Decoder::decodeFrame(Common::SeekableReadStream &stream) {
 	// Not Indeo 3? Fail
 	if (!isIndeo3(stream))
@@ -319,16 +336,12 @@ const Graphics::Surface *Indeo3Decoder::decodeFrame(Common::SeekableReadStream &
 				fWidth, fHeight, fWidth, chromaWidth + 1);
 
 		// Upscale
-		for (int y = 0; y < _surface->h; y++) {
-			for (int x = 0; x < _surface->w; x++) {
-				if (_surface->format.bytesPerPixel == 1)
-					*((byte *)_surface->getBasePtr(x, y)) = *((byte *)tempSurface.getBasePtr(x / scaleWidth, y / scaleHeight));
-				else if (_surface->format.bytesPerPixel == 2)
-					*((uint16 *)_surface->getBasePtr(x, y)) = *((uint16 *)tempSurface.getBasePtr(x / scaleWidth, y / scaleHeight));
-				else if (_surface->format.bytesPerPixel == 4)
-					*((uint32 *)_surface->getBasePtr(x, y)) = *((uint32 *)tempSurface.getBasePtr(x / scaleWidth, y / scaleHeight));
- 			}
-		}
+		if (_surface->format.bytesPerPixel == 1)
+			upscaleSurface<byte>(*_surface, tempSurface, scaleWidth, scaleHeight);
+		else if (_surface->format.bytesPerPixel == 2)
+			upscaleSurface<uint16>(*_surface, tempSurface, scaleWidth, scaleHeight);
+		else if (_surface->format.bytesPerPixel == 4)
+			upscaleSurface<uint32>(*_surface, tempSurface, scaleWidth, scaleHeight);
 
 		tempSurface.free();
 	}
@@ -27,6 +27,7 @@
  */
 
 #include "common/memstream.h"
+#include "common/span.h"
 #include "common/textconsole.h"
 #include "graphics/yuv_to_rgb.h"
 #include "image/codecs/indeo5.h"
@@ -78,11 +79,12 @@ const Graphics::Surface *Indeo5Decoder::decodeFrame(Common::SeekableReadStream &
 	if (!isIndeo5(stream))
 		return nullptr;
 
-	// Set up the frame data buffer
-	byte *frameData = new byte[stream.size()];
-	stream.read(frameData, stream.size());
-	_ctx._frameData = frameData;
-	_ctx._frameSize = stream.size();
+	// Set up the frame data buffer. Frames read from a memory stream
+	// are decoded in place.
+	Common::SpanOwner<Common::Span<byte> > frameBuffer;
+	Common::Span<const byte> frameData = Common::readSpan(stream, stream.size(), frameBuffer);
+	_ctx._frameData = frameData.data();
+	_ctx._frameSize = frameData.size();
 
 	// Set up the GetBits instance for reading the data
 	_ctx._gb = new GetBits(_ctx._frameData, _ctx._frameSize);
@@ -93,7 +95,6 @@ const Graphics::Surface *Indeo5Decoder::decodeFrame(Common::SeekableReadStream &
 	// Free the bit reader and frame buffer
 	delete _ctx._gb;
 	_ctx._gb = nullptr;
-	delete[] frameData;
 	_ctx._frameData = nullptr;
 	_ctx._frameSize = 0;
 
@@ -20,17 +20,12 @@
  *
  */
 
-#ifdef USE_MPEG2
-
 #ifndef IMAGE_CODECS_MPEG_H
 #define IMAGE_CODECS_MPEG_H
 
 #include "image/codecs/codec.h"
 #include "graphics/pixelformat.h"
 
-typedef struct mpeg2dec_s mpeg2dec_t;
-typedef struct mpeg2_info_s mpeg2_info_t;
-
 namespace Common {
 class SeekableReadStream;
 }
@@ -42,11 +37,45 @@ struct Surface;
 namespace Image {
 
 /**
- * MPEG 1/2 video decoder.
+ * Decoder for the packets of an MPEG 1/2 video stream.
+ *
+ * Used by MPEGPSDecoder. This is implemented by MPEGDecoder, and by
+ * backends which decode MPEG video in hardware.
+ *
+ * @see OSystem::createMPEGDecoder()
+ */
+class MPEGPacketDecoder {
+public:
+	virtual ~MPEGPacketDecoder() {}
+
+	/**
+	 * Decode the given packet of the video stream.
+	 *
+	 * @param packet      The packet to decode.
+	 * @param framePeriod Set to the duration of the decoded pictures, in
+	 *                    ticks of a 27 MHz clock.
+	 * @param dst         The surface to convert a completed picture into.
+	 *
+	 * @return Whether a picture was completed.
+	 */
+	virtual bool decodePacket(Common::SeekableReadStream &packet, uint32 &framePeriod, Graphics::Surface *dst) = 0;
+};
+
+} // End of namespace Image
+
+#ifdef USE_MPEG2
+
+typedef struct mpeg2dec_s mpeg2dec_t;
+typedef struct mpeg2_info_s mpeg2_info_t;
+
+namespace Image {
+
+/**
+ * MPEG 1/2 video decoder, based on libmpeg2.
  *
  * Used by BMP/AVI.
  */
-class MPEGDecoder : public Codec {
+class MPEGDecoder : public Codec, public MPEGPacketDecoder {
 public:
 	MPEGDecoder();
 	~MPEGDecoder();
@@ -73,6 +102,6 @@ private:
 
 } // End of namespace Image
 
-#endif // IMAGE_CODECS_MPEG_H
-
 #endif // USE_MPEG2
+
+#endif // IMAGE_CODECS_MPEG_H
@@ -48,7 +48,8 @@ namespace Image {
 JPEGDecoder::JPEGDecoder() :
 		_surface(),
 		_colorSpace(kColorSpaceRGB),
-		_requestedPixelFormat(getByteOrderRgbPixelFormat()) {
+		_requestedPixelFormat(getByteOrderRgbPixelFormat()),
+		_scaleDenom(1) {
 }
 
 JPEGDecoder::~JPEGDecoder() {
@@ -250,6 +251,11 @@ bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	// Read the file header
 	jpeg_read_header(&cinfo, TRUE);
 
+	// Downscaling happens during the IDCT, the output size is known
+	// once decompression is started
+	cinfo.scale_num = 1;
+	cinfo.scale_denom = _scaleDenom;
+
 	// We can request YUV output because Groovie requires it
 	switch (_colorSpace) {
 	case kColorSpaceRGB: {
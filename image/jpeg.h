@@ -102,10 +102,22 @@ public:
 	 */
 	void setOutputPixelFormat(const Graphics::PixelFormat &format) { _requestedPixelFormat = format; }
 
+	/**
+	 * Request a downscaled image. libjpeg scales while performing the inverse
+	 * DCT, which is a lot faster than decoding at full size and scaling the
+	 * result afterwards. This is meant for thumbnails and previews.
+	 *
+	 * The decoder itself defaults to full size.
+	 *
+	 * @param denom The size divisor, one of 1, 2, 4 or 8.
+	 */
+	void setOutputScale(uint denom) { assert(denom == 1 || denom == 2 || denom == 4 || denom == 8); _scaleDenom = denom; }
+
 private:
 	Graphics::Surface _surface;
 	ColorSpace _colorSpace;
 	Graphics::PixelFormat _requestedPixelFormat;
+	uint _scaleDenom;
 
 	Graphics::PixelFormat getByteOrderRgbPixelFormat() const;
 };
@@ -46,7 +46,8 @@ PNGDecoder::PNGDecoder() :
 		_paletteColorCount(0),
 		_skipSignature(false),
 		_keepTransparencyPaletted(false),
-		_transparentColor(-1) {
+		_transparentColor(-1),
+		_outputPixelFormat() {
 }
 
 PNGDecoder::~PNGDecoder() {
@@ -71,6 +72,38 @@ Graphics::PixelFormat PNGDecoder::getByteOrderRgbaPixelFormat(bool isAlpha) cons
 #endif
 }
 
+bool PNGDecoder::getRgbaTransforms(const Graphics::PixelFormat &format, bool isAlpha, bool &bgr, bool &alphaFirst) const {
+	// libpng outputs R, G, B, A bytes and can swap them to B, G, R and/or
+	// move the alpha (or filler) byte to the front.
+	if (format.bytesPerPixel != 4 || format.rLoss != 0 || format.gLoss != 0 || format.bLoss != 0)
+		return false;
+	if (format.aLoss != 0 && (isAlpha || format.aLoss != 8))
+		return false;
+	if ((format.rShift | format.gShift | format.bShift | format.aShift) & 7)
+		return false;
+
+#ifdef SCUMM_BIG_ENDIAN
+	const int r = 3 - format.rShift / 8, g = 3 - format.gShift / 8, b = 3 - format.bShift / 8, a = 3 - format.aShift / 8;
+#else
+	const int r = format.rShift / 8, g = format.gShift / 8, b = format.bShift / 8, a = format.aShift / 8;
+#endif
+	if (g != 1 && g != 2)
+		return false;
+
+	alphaFirst = (g == 2);
+	const int first = alphaFirst ? 1 : 0;
+	if (r == first && b == first + 2) {
+		bgr = false;
+	} else if (b == first && r == first + 2) {
+		bgr = true;
+	} else {
+		return false;
+	}
+
+	// The position of the alpha bits only matters when there are any
+	return format.aLoss != 0 || a == (alphaFirst ? 0 : 3);
+}
+
 #ifdef USE_PNG
 // libpng-error-handling:
 void pngError(png_structp pngptr, png_const_charp errorMsg) {
@@ -200,8 +233,11 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 			}
 		}
 
-		_outputSurface->create(width, height,
-			hasRgbaPalette ? getByteOrderRgbaPixelFormat(true) : Graphics::PixelFormat::createFormatCLUT8());
+		Graphics::PixelFormat format = Graphics::PixelFormat::createFormatCLUT8();
+		if (hasRgbaPalette)
+			format = (_outputPixelFormat.bytesPerPixel == 4) ? _outputPixelFormat : getByteOrderRgbaPixelFormat(true);
+
+		_outputSurface->create(width, height, format);
 		png_set_packing(pngPtr);
 
 		if (hasRgbaPalette) {
@@ -225,7 +261,13 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 			png_set_expand(pngPtr);
 		}
 
-		_outputSurface->create(width, height, getByteOrderRgbaPixelFormat(isAlpha));
+		// Let libpng produce the requested format directly when possible
+		Graphics::PixelFormat format = getByteOrderRgbaPixelFormat(isAlpha);
+		bool bgr = false, alphaFirst = false;
+		if (_outputPixelFormat.bytesPerPixel != 0 && getRgbaTransforms(_outputPixelFormat, isAlpha, bgr, alphaFirst))
+			format = _outputPixelFormat;
+
+		_outputSurface->create(width, height, format);
 		if (!_outputSurface->getPixels()) {
 			error("Could not allocate memory for output image.");
 		}
@@ -238,7 +280,11 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 			png_set_gray_to_rgb(pngPtr);
 
 		if (colorType != PNG_COLOR_TYPE_RGB_ALPHA)
-			png_set_filler(pngPtr, 0xff, PNG_FILLER_AFTER);
+			png_set_filler(pngPtr, 0xff, alphaFirst ? PNG_FILLER_BEFORE : PNG_FILLER_AFTER);
+		if (bgr)
+			png_set_bgr(pngPtr);
+		if (alphaFirst)
+			png_set_swap_alpha(pngPtr);
 	}
 
 	// After the transformations have been registered, the image data is read again.
@@ -295,6 +341,11 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	// Destroy libpng structures
 	png_destroy_read_struct(&pngPtr, &infoPtr, NULL);
 
+	if (_outputPixelFormat.bytesPerPixel != 0 && _outputSurface->format.bytesPerPixel != 1 &&
+		_outputSurface->format != _outputPixelFormat) {
+		_outputSurface->convertToInPlace(_outputPixelFormat); // Slow path
+	}
+
 	return true;
 #else
 	return false;
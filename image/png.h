@@ -66,8 +66,19 @@ public:
 	int getTransparentColor() const { return _transparentColor; }
 	void setSkipSignature(bool skip) { _skipSignature = skip; }
 	void setKeepTransparencyPaletted(bool keep) { _keepTransparencyPaletted = keep; }
+
+	/**
+	 * Request the output pixel format for true color images. Byte order
+	 * permutations of 32bpp RGBA are handled by libpng while decoding, which
+	 * avoids a costly color conversion of the whole image afterwards. Other
+	 * formats are converted once decoding is done.
+	 *
+	 * Paletted images are still returned as CLUT8 surfaces.
+	 */
+	void setOutputPixelFormat(const Graphics::PixelFormat &format) { _outputPixelFormat = format; }
 private:
 	Graphics::PixelFormat getByteOrderRgbaPixelFormat(bool isAlpha) const;
+	bool getRgbaTransforms(const Graphics::PixelFormat &format, bool isAlpha, bool &bgr, bool &alphaFirst) const;
 
 	byte *_palette;
 	uint16 _paletteColorCount;
@@ -79,6 +90,9 @@ private:
 	bool _keepTransparencyPaletted;
 	int _transparentColor;
 
+	// Requested format of true color output, if any
+	Graphics::PixelFormat _outputPixelFormat;
+
 	Graphics::Surface *_outputSurface;
 };
 
@@ -0,0 +1,128 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/decoders/raw.h"
+#include "audio/audiostream.h"
+#include "audio/decodeahead.h"
+
+#include "common/endian.h"
+#include "common/stream.h"
+
+#include "../null_osystem.h"
+
+class DecodeAheadTestSuite : public CxxTest::TestSuite
+{
+private:
+	static int16 sampleAt(int i) {
+		return (int16)(i * 7919);
+	}
+
+	static Audio::SeekableAudioStream *createStream(int count, int rate, bool isStereo) {
+		byte *data = (byte *)malloc(count * 2);
+		for (int i = 0; i < count; ++i)
+			WRITE_LE_UINT16(data + i * 2, sampleAt(i));
+
+		Common::SeekableReadStream *s = new Common::MemoryReadStream(data, count * 2, DisposeAfterUse::YES);
+		return Audio::makeRawStream(s, rate, Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN | (isStereo ? Audio::FLAG_STEREO : 0));
+	}
+
+	// Read the stream in chunks of varying size, checking it yields the
+	// samples from 'start' on
+	static bool checkSamples(Audio::AudioStream *stream, int start, int count) {
+		int16 buffer[1024];
+		int pos = start;
+		int chunk = 0;
+		while (!stream->endOfData()) {
+			chunk = (chunk + 334) % 1024 & ~1;
+			const int len = stream->readBuffer(buffer, chunk);
+			if (len < 0 || len > chunk)
+				return false;
+			for (int i = 0; i < len; ++i) {
+				if (buffer[i] != sampleAt(pos++))
+					return false;
+			}
+		}
+		return pos == count;
+	}
+
+	// An endless stream, like a software synthesizer
+	class CountingStream : public Audio::AudioStream {
+	public:
+		CountingStream() : _pos(0) {}
+		int readBuffer(int16 *buffer, const int numSamples) {
+			for (int i = 0; i < numSamples; ++i)
+				buffer[i] = sampleAt(_pos++);
+			return numSamples;
+		}
+		bool isStereo() const { return true; }
+		int getRate() const { return 32000; }
+		bool endOfData() const { return false; }
+
+		int _pos;
+	};
+
+public:
+	void test_read() {
+		Common::install_null_g_system();
+		// Longer than the ring buffer, so that it wraps around
+		const int count = 100000;
+		Audio::SeekableAudioStream *stream = Audio::makeDecodeAheadStream(createStream(count, 22050, true), 200);
+
+		TS_ASSERT(stream->isStereo());
+		TS_ASSERT_EQUALS(stream->getRate(), 22050);
+		TS_ASSERT_EQUALS(stream->getLength().totalNumberOfFrames(), count / 2);
+		TS_ASSERT(!stream->endOfData());
+		TS_ASSERT(checkSamples(stream, 0, count));
+		TS_ASSERT(stream->endOfData());
+
+		int16 sample;
+		TS_ASSERT_EQUALS(stream->readBuffer(&sample, 1), 0);
+		delete stream;
+	}
+
+	void test_seek() {
+		Common::install_null_g_system();
+		const int count = 30000;
+		Audio::SeekableAudioStream *stream = Audio::makeDecodeAheadStream(createStream(count, 11025, false), 1000);
+
+		int16 buffer[100];
+		TS_ASSERT_EQUALS(stream->readBuffer(buffer, 100), 100);
+
+		TS_ASSERT(stream->seek(Audio::Timestamp(0, 20000, 11025)));
+		TS_ASSERT(checkSamples(stream, 20000, count));
+
+		TS_ASSERT(stream->rewind());
+		TS_ASSERT(!stream->endOfData());
+		TS_ASSERT(checkSamples(stream, 0, count));
+		delete stream;
+	}
+
+	void test_endless() {
+		Common::install_null_g_system();
+		CountingStream source;
+		Audio::AudioStream *stream = Audio::makeDecodeAheadStream(&source, 50, DisposeAfterUse::NO);
+
+		TS_ASSERT(stream->isStereo());
+		TS_ASSERT_EQUALS(stream->getRate(), 32000);
+
+		int16 buffer[1000];
+		int pos = 0;
+		for (int chunk = 0; chunk < 100; ++chunk) {
+			TS_ASSERT_EQUALS(stream->readBuffer(buffer, 1000), 1000);
+			for (int i = 0; i < 1000; ++i)
+				TS_ASSERT_EQUALS(buffer[i], sampleAt(pos++));
+		}
+		TS_ASSERT(!stream->endOfData());
+
+		// Never more than 50ms at 32000Hz stereo are rendered ahead
+		TS_ASSERT_LESS_THAN_EQUALS(source._pos - pos, 3200);
+		delete stream;
+	}
+
+	void test_no_lookahead() {
+		Common::install_null_g_system();
+		Audio::SeekableAudioStream *source = createStream(100, 11025, false);
+		Audio::SeekableAudioStream *stream = Audio::makeDecodeAheadStream(source, 0);
+		TS_ASSERT_EQUALS(stream, source);
+		delete stream;
+	}
+};
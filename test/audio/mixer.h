@@ -0,0 +1,131 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/audiostream.h"
+#include "audio/mixer_intern.h"
+
+namespace {
+
+/** Silent mono stream playing for a given number of samples. */
+class CountedStream : public Audio::AudioStream {
+public:
+	CountedStream(int samples, bool *deleted) : _samples(samples), _deleted(deleted) {}
+	~CountedStream() { *_deleted = true; }
+
+	int readBuffer(int16 *buffer, const int numSamples) override {
+		const int count = MIN(numSamples, _samples);
+		memset(buffer, 0, count * sizeof(int16));
+		_samples -= count;
+		return count;
+	}
+
+	bool isStereo() const override { return false; }
+	int getRate() const override { return 22050; }
+	bool endOfData() const override { return _samples == 0; }
+
+private:
+	int _samples;
+	bool *_deleted;
+};
+
+} // End of anonymous namespace
+
+class MixerTestSuite : public CxxTest::TestSuite {
+public:
+	void test_play_and_stop() {
+		Audio::MixerImpl impl(22050);
+		Audio::Mixer &mixer = impl;
+		impl.setReady(true);
+
+		bool deleted = false;
+		Audio::SoundHandle handle;
+		mixer.playStream(Audio::Mixer::kSFXSoundType, &handle, new CountedStream(100000, &deleted), 42, 100, -20);
+
+		TS_ASSERT(mixer.isSoundHandleActive(handle));
+		TS_ASSERT(mixer.isSoundIDActive(42));
+		TS_ASSERT_EQUALS(mixer.getSoundID(handle), 42);
+		TS_ASSERT(mixer.hasActiveChannelOfType(Audio::Mixer::kSFXSoundType));
+		TS_ASSERT_EQUALS(mixer.getChannelVolume(handle), 100);
+		TS_ASSERT_EQUALS(mixer.getChannelBalance(handle), -20);
+
+		mixer.setChannelVolume(handle, 50);
+		mixer.setChannelBalance(handle, 10);
+		TS_ASSERT_EQUALS(mixer.getChannelVolume(handle), 50);
+		TS_ASSERT_EQUALS(mixer.getChannelBalance(handle), 10);
+
+		// A sound with the same id is not played
+		bool duplicateDeleted = false;
+		Audio::SoundHandle duplicate;
+		mixer.playStream(Audio::Mixer::kSFXSoundType, &duplicate, new CountedStream(100, &duplicateDeleted), 42);
+		TS_ASSERT(duplicateDeleted);
+		TS_ASSERT(!mixer.isSoundHandleActive(duplicate));
+
+		byte samples[512];
+		impl.mixCallback(samples, sizeof(samples));
+		TS_ASSERT(!deleted);
+
+		// Stopping is complete once the call returns
+		mixer.stopHandle(handle);
+		TS_ASSERT(deleted);
+		TS_ASSERT(!mixer.isSoundHandleActive(handle));
+		TS_ASSERT(!mixer.isSoundIDActive(42));
+		TS_ASSERT_EQUALS(mixer.getChannelVolume(handle), 0);
+	}
+
+	void test_finished_channel() {
+		Audio::MixerImpl impl(22050);
+		Audio::Mixer &mixer = impl;
+		impl.setReady(true);
+
+		bool deleted = false;
+		Audio::SoundHandle handle;
+		mixer.playStream(Audio::Mixer::kPlainSoundType, &handle, new CountedStream(10, &deleted));
+		TS_ASSERT(mixer.isSoundHandleActive(handle));
+
+		byte samples[512];
+		impl.mixCallback(samples, sizeof(samples));
+		impl.mixCallback(samples, sizeof(samples));
+		TS_ASSERT(deleted);
+		TS_ASSERT(!mixer.isSoundHandleActive(handle));
+
+		// The slot can be reused
+		deleted = false;
+		Audio::SoundHandle handle2;
+		mixer.playStream(Audio::Mixer::kPlainSoundType, &handle2, new CountedStream(10, &deleted));
+		TS_ASSERT(mixer.isSoundHandleActive(handle2));
+		TS_ASSERT(!mixer.isSoundHandleActive(handle));
+		mixer.stopAll();
+		TS_ASSERT(deleted);
+	}
+
+	void test_full_command_queue() {
+		Audio::MixerImpl impl(22050);
+		Audio::Mixer &mixer = impl;
+		impl.setReady(true);
+
+		// Without the mixer callback running, the queue is drained by the
+		// engine thread once full
+		bool deleted[40];
+		Audio::SoundHandle handles[40];
+		for (int i = 0; i < 40; ++i) {
+			deleted[i] = false;
+			mixer.playStream(Audio::Mixer::kPlainSoundType, &handles[i], new CountedStream(100000, &deleted[i]));
+		}
+
+		// Only 32 channels can play at once
+		for (int i = 0; i < 40; ++i)
+			TS_ASSERT_EQUALS(mixer.isSoundHandleActive(handles[i]), i < 32);
+		for (int i = 32; i < 40; ++i)
+			TS_ASSERT(deleted[i]);
+
+		for (int volume = 0; volume < 1000; ++volume)
+			mixer.setChannelVolume(handles[0], volume & 0xFF);
+		TS_ASSERT_EQUALS(mixer.getChannelVolume(handles[0]), 999 & 0xFF);
+
+		mixer.pauseAll(true);
+		mixer.stopID(-1);
+		for (int i = 0; i < 32; ++i) {
+			TS_ASSERT(deleted[i]);
+			TS_ASSERT(!mixer.isSoundHandleActive(handles[i]));
+		}
+	}
+};
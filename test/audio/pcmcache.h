@@ -0,0 +1,146 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/decoders/raw.h"
+#include "audio/audiostream.h"
+#include "audio/pcmcache.h"
+
+#include "common/endian.h"
+#include "common/stream.h"
+
+#include "../null_osystem.h"
+
+class PCMCacheTestSuite : public CxxTest::TestSuite
+{
+private:
+	static int16 sampleAt(int i) {
+		return (int16)(i * 331);
+	}
+
+	static Audio::SeekableAudioStream *createStream(int count, int rate, bool isStereo) {
+		byte *data = (byte *)malloc(count * 2);
+		for (int i = 0; i < count; ++i)
+			WRITE_LE_UINT16(data + i * 2, sampleAt(i));
+
+		Common::SeekableReadStream *s = new Common::MemoryReadStream(data, count * 2, DisposeAfterUse::YES);
+		return Audio::makeRawStream(s, rate, Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN | (isStereo ? Audio::FLAG_STEREO : 0));
+	}
+
+	static bool checkSamples(Audio::AudioStream *stream, int count) {
+		int16 *buffer = new int16[count + 16];
+		const int len = stream->readBuffer(buffer, count + 16);
+		bool ok = (len == count) && stream->endOfData();
+		for (int i = 0; ok && i < count; ++i)
+			ok = (buffer[i] == sampleAt(i));
+		delete[] buffer;
+		return ok;
+	}
+
+public:
+	void test_add_and_find() {
+		Common::install_null_g_system();
+		Audio::PCMCache cache(100000, 1000);
+
+		TS_ASSERT(!cache.find("sfx.dat", 100));
+
+		Audio::RewindableAudioStream *added = cache.add("sfx.dat", 100, createStream(2000, 11025, true));
+		TS_ASSERT(added);
+		TS_ASSERT(checkSamples(added, 2000));
+		TS_ASSERT(added->rewind());
+		TS_ASSERT(checkSamples(added, 2000));
+		delete added;
+
+		TS_ASSERT_EQUALS(cache.getCount(), 1u);
+		TS_ASSERT_EQUALS(cache.getSize(), 4000u);
+		TS_ASSERT(!cache.find("sfx.dat", 0));
+		TS_ASSERT(!cache.find("other.dat", 100));
+
+		Audio::SeekableAudioStream *found = cache.find("sfx.dat", 100);
+		TS_ASSERT(found);
+		TS_ASSERT(found->isStereo());
+		TS_ASSERT_EQUALS(found->getRate(), 11025);
+		TS_ASSERT_EQUALS(found->getLength().totalNumberOfFrames(), 1000);
+		TS_ASSERT(checkSamples(found, 2000));
+
+		int16 sample[2];
+		TS_ASSERT(found->seek(Audio::Timestamp(0, 500, 11025)));
+		TS_ASSERT_EQUALS(found->readBuffer(sample, 2), 2);
+		TS_ASSERT_EQUALS(sample[0], sampleAt(1000));
+		TS_ASSERT_EQUALS(sample[1], sampleAt(1001));
+		delete found;
+	}
+
+	void test_too_long() {
+		Common::install_null_g_system();
+		// 100ms at 11025Hz are 1102 frames
+		Audio::PCMCache cache(100000, 100);
+
+		Audio::SeekableAudioStream *stream = createStream(1103, 11025, false);
+		Audio::RewindableAudioStream *added = cache.add("music.dat", 0, stream);
+		TS_ASSERT_EQUALS(added, (Audio::RewindableAudioStream *)stream);
+		TS_ASSERT(checkSamples(added, 1103));
+		TS_ASSERT_EQUALS(cache.getCount(), 0u);
+		delete added;
+
+		// Returned right away, based on the length of the stream
+		stream = createStream(4410, 11025, false);
+		added = cache.add("music.dat", 0, stream);
+		TS_ASSERT_EQUALS(added, (Audio::RewindableAudioStream *)stream);
+		TS_ASSERT(checkSamples(added, 4410));
+		delete added;
+
+		added = cache.add("music.dat", 0, createStream(1102, 11025, false));
+		TS_ASSERT(checkSamples(added, 1102));
+		TS_ASSERT_EQUALS(cache.getCount(), 1u);
+		delete added;
+	}
+
+	void test_disabled() {
+		Common::install_null_g_system();
+		Audio::PCMCache cache(0, 1000);
+
+		Audio::SeekableAudioStream *stream = createStream(100, 22050, false);
+		TS_ASSERT_EQUALS(cache.add("sfx.dat", 0, stream), (Audio::RewindableAudioStream *)stream);
+		TS_ASSERT_EQUALS(cache.getCount(), 0u);
+		delete stream;
+	}
+
+	void test_lru_eviction() {
+		Common::install_null_g_system();
+		// Room for two sounds of 1000 samples
+		Audio::PCMCache cache(4000, 1000);
+
+		delete cache.add("a", 0, createStream(1000, 22050, false));
+		delete cache.add("b", 0, createStream(1000, 22050, false));
+		TS_ASSERT_EQUALS(cache.getCount(), 2u);
+
+		// Use 'a', so 'b' is evicted first
+		delete cache.find("a", 0);
+		delete cache.add("c", 0, createStream(1000, 22050, false));
+
+		TS_ASSERT_EQUALS(cache.getCount(), 2u);
+		TS_ASSERT_EQUALS(cache.getSize(), 4000u);
+		Audio::SeekableAudioStream *a = cache.find("a", 0);
+		Audio::SeekableAudioStream *b = cache.find("b", 0);
+		Audio::SeekableAudioStream *c = cache.find("c", 0);
+		TS_ASSERT(a);
+		TS_ASSERT(!b);
+		TS_ASSERT(c);
+		delete a;
+		delete c;
+	}
+
+	void test_stream_outlives_cache() {
+		Common::install_null_g_system();
+		Audio::SeekableAudioStream *found;
+		{
+			Audio::PCMCache cache(100000, 1000);
+			delete cache.add("sfx.dat", 0, createStream(500, 22050, false));
+			found = cache.find("sfx.dat", 0);
+			cache.clear();
+			TS_ASSERT_EQUALS(cache.getCount(), 0u);
+			TS_ASSERT_EQUALS(cache.getSize(), 0u);
+		}
+		TS_ASSERT(checkSamples(found, 500));
+		delete found;
+	}
+};
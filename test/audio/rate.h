@@ -0,0 +1,249 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/decoders/raw.h"
+#include "audio/audiostream.h"
+#include "audio/mixer.h"
+#include "audio/rate.h"
+
+#include "common/endian.h"
+#include "common/stream.h"
+
+class RateConverterTestSuite : public CxxTest::TestSuite
+{
+private:
+	static Audio::AudioStream *createStream(const int16 *samples, int count, int rate, bool isStereo) {
+		byte *data = (byte *)malloc(count * 2);
+		for (int i = 0; i < count; ++i)
+			WRITE_LE_UINT16(data + i * 2, samples[i]);
+
+		Common::SeekableReadStream *s = new Common::MemoryReadStream(data, count * 2, DisposeAfterUse::YES);
+		return Audio::makeRawStream(s, rate, Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN | (isStereo ? Audio::FLAG_STEREO : 0));
+	}
+
+	static int16 *createSamples(int count) {
+		int16 *samples = new int16[count];
+		// Cover the full range, including the extreme values
+		for (int i = 0; i < count; ++i)
+			samples[i] = (int16)((i * 7919) ^ (i << 11));
+		samples[0] = -32768;
+		samples[1] = 32767;
+		return samples;
+	}
+
+	static int16 *createOutput(int frames) {
+		int16 *out = new int16[frames * 2];
+		for (int i = 0; i < frames * 2; ++i)
+			out[i] = (int16)(i * 3001);
+		return out;
+	}
+
+	static int16 mixReference(int16 out, int16 in, int vol) {
+		int val = out + (in * vol) / Audio::Mixer::kMaxMixerVolume;
+		return (int16)CLIP<int>(val, -32768, 32767);
+	}
+
+	// Mixes a stream with rate 'inRate' into a 22050Hz output, where the last
+	// of every 'step' input frames is used, and compares against the scalar
+	// formula.
+	void mixTestTemplate(const int inRate, const int step, const bool isStereo, const bool reverseStereo, const int volL, const int volR) {
+		const int frames = 1000;
+		const int channels = isStereo ? 2 : 1;
+		const int inCount = frames * step * channels;
+
+		int16 *samples = createSamples(inCount);
+		int16 *out = createOutput(frames);
+		int16 *expected = createOutput(frames);
+
+		for (int i = 0; i < frames; ++i) {
+			const int16 *in = samples + (i * step + step - 1) * channels;
+			const int16 in0 = in[0];
+			const int16 in1 = isStereo ? in[1] : in[0];
+			expected[i * 2 + (reverseStereo ? 1 : 0)] = mixReference(expected[i * 2 + (reverseStereo ? 1 : 0)], in0, volL);
+			expected[i * 2 + (reverseStereo ? 0 : 1)] = mixReference(expected[i * 2 + (reverseStereo ? 0 : 1)], in1, volR);
+		}
+
+		Audio::AudioStream *s = createStream(samples, inCount, inRate, isStereo);
+		Audio::RateConverter *converter = Audio::makeRateConverter(inRate, 22050, isStereo, reverseStereo);
+
+		// Request more than is available to check the end of stream handling
+		TS_ASSERT_EQUALS(converter->flow(*s, out, frames + 100, volL, volR), frames);
+		TS_ASSERT_EQUALS(memcmp(out, expected, frames * 2 * sizeof(int16)), 0);
+
+		delete converter;
+		delete s;
+		delete[] samples;
+		delete[] out;
+		delete[] expected;
+	}
+
+	// Like mixTestTemplate, but accumulates into a 32-bit mix bus, which must
+	// not be clamped.
+	void mixBusTestTemplate(const int inRate, const int step, const bool isStereo, const bool reverseStereo, const int volL, const int volR) {
+		const int frames = 1000;
+		const int channels = isStereo ? 2 : 1;
+		const int inCount = frames * step * channels;
+
+		int16 *samples = createSamples(inCount);
+		int32 *out = new int32[frames * 2];
+		int32 *expected = new int32[frames * 2];
+		for (int i = 0; i < frames * 2; ++i)
+			out[i] = expected[i] = (i * 3001) % 100000;
+
+		for (int i = 0; i < frames; ++i) {
+			const int16 *in = samples + (i * step + step - 1) * channels;
+			const int16 in0 = in[0];
+			const int16 in1 = isStereo ? in[1] : in[0];
+			expected[i * 2 + (reverseStereo ? 1 : 0)] += (in0 * volL) / Audio::Mixer::kMaxMixerVolume;
+			expected[i * 2 + (reverseStereo ? 0 : 1)] += (in1 * volR) / Audio::Mixer::kMaxMixerVolume;
+		}
+
+		Audio::AudioStream *s = createStream(samples, inCount, inRate, isStereo);
+		Audio::RateConverter *converter = Audio::makeRateConverter(inRate, 22050, isStereo, reverseStereo);
+
+		TS_ASSERT_EQUALS(converter->flowMix(*s, out, frames + 100, volL, volR), frames);
+		TS_ASSERT_EQUALS(memcmp(out, expected, frames * 2 * sizeof(int32)), 0);
+
+		delete converter;
+		delete s;
+		delete[] samples;
+		delete[] out;
+		delete[] expected;
+	}
+
+	// Feeds a constant signal through the windowed-sinc converter, which has
+	// to pass through unchanged once the filter history is filled.
+	void sincConstantTestTemplate(const int inRate, const int outRate, const bool isStereo, const Audio::RateConverterQuality quality) {
+		const int inFrames = 2000;
+		const int channels = isStereo ? 2 : 1;
+		const int outFrames = (int)((int64)inFrames * outRate / inRate);
+		// Generously skip the filter's warm up
+		const int skip = (32 * outRate) / inRate + 1;
+
+		int16 *samples = new int16[inFrames * channels];
+		for (int i = 0; i < inFrames * channels; ++i)
+			samples[i] = (i & 1) && isStereo ? -20000 : 10000;
+
+		int16 *out = new int16[outFrames * 2];
+		memset(out, 0, outFrames * 2 * sizeof(int16));
+
+		Audio::AudioStream *s = createStream(samples, inFrames * channels, inRate, isStereo);
+		Audio::RateConverter *converter = Audio::makeRateConverter(inRate, outRate, isStereo, false, quality);
+
+		const int len = converter->flow(*s, out, outFrames, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume);
+		TS_ASSERT(len >= outFrames - 2);
+
+		bool constant = true;
+		for (int i = skip; i < len; ++i) {
+			if (out[i * 2] != 10000 || out[i * 2 + 1] != (isStereo ? -20000 : 10000))
+				constant = false;
+		}
+		TS_ASSERT(constant);
+
+		delete converter;
+		delete s;
+		delete[] samples;
+		delete[] out;
+	}
+
+public:
+	void test_copy_mono() {
+		mixTestTemplate(22050, 1, false, false, 256, 128);
+	}
+
+	void test_copy_stereo() {
+		mixTestTemplate(22050, 1, true, false, 200, 17);
+	}
+
+	void test_copy_stereo_reverse() {
+		mixTestTemplate(22050, 1, true, true, 255, 1);
+	}
+
+	void test_simple_mono() {
+		mixTestTemplate(44100, 2, false, false, 99, 256);
+	}
+
+	void test_simple_stereo() {
+		mixTestTemplate(44100, 2, true, false, 256, 0);
+	}
+
+	void test_simple_stereo_reverse() {
+		mixTestTemplate(44100, 2, true, true, 3, 250);
+	}
+
+	void test_mix_bus_copy_stereo_reverse() {
+		mixBusTestTemplate(22050, 1, true, true, 255, 3);
+	}
+
+	void test_mix_bus_simple_mono() {
+		mixBusTestTemplate(44100, 2, false, false, 256, 40);
+	}
+
+	void test_mix_bus_simple_stereo() {
+		mixBusTestTemplate(44100, 2, true, false, 128, 256);
+	}
+
+	void test_clamp_mix_bus() {
+		const int count = 37;
+		int32 bus[count];
+		int16 out[count];
+		for (int i = 0; i < count; ++i)
+			bus[i] = (i - count / 2) * 4000;
+		bus[0] = -70000;
+		bus[1] = 70000;
+		bus[2] = -32768;
+		bus[3] = 32767;
+
+		Audio::clampMixBus(out, bus, count);
+		for (int i = 0; i < count; ++i) {
+			int16 expected = (int16)CLIP<int32>(bus[i], -32768, 32767);
+#ifdef OUTPUT_UNSIGNED_AUDIO
+			expected ^= 0x8000;
+#endif
+			TS_ASSERT_EQUALS(out[i], expected);
+		}
+	}
+
+	void test_sinc_low_upsample_mono() {
+		sincConstantTestTemplate(11025, 48000, false, Audio::kRateConverterSincLow);
+	}
+
+	void test_sinc_medium_upsample_stereo() {
+		sincConstantTestTemplate(22050, 44100, true, Audio::kRateConverterSincMedium);
+	}
+
+	void test_sinc_high_downsample_stereo() {
+		sincConstantTestTemplate(48000, 22050, true, Audio::kRateConverterSincHigh);
+	}
+
+	void test_linear_stereo_matches_mono() {
+		const int frames = 700;
+		const int inCount = 300;
+
+		int16 *samples = createSamples(inCount);
+		int16 *stereoSamples = new int16[inCount * 2];
+		for (int i = 0; i < inCount; ++i)
+			stereoSamples[i * 2] = stereoSamples[i * 2 + 1] = samples[i];
+
+		int16 *monoOut = createOutput(frames);
+		int16 *stereoOut = createOutput(frames);
+
+		Audio::AudioStream *monoStream = createStream(samples, inCount, 11025, false);
+		Audio::AudioStream *stereoStream = createStream(stereoSamples, inCount * 2, 11025, true);
+		Audio::RateConverter *monoConv = Audio::makeRateConverter(11025, 22050, false);
+		Audio::RateConverter *stereoConv = Audio::makeRateConverter(11025, 22050, true);
+
+		const int monoLen = monoConv->flow(*monoStream, monoOut, frames, 180, 77);
+		TS_ASSERT_EQUALS(stereoConv->flow(*stereoStream, stereoOut, frames, 180, 77), monoLen);
+		TS_ASSERT(monoLen >= inCount * 2 - 2);
+		TS_ASSERT_EQUALS(memcmp(monoOut, stereoOut, frames * 2 * sizeof(int16)), 0);
+
+		delete monoConv;
+		delete stereoConv;
+		delete monoStream;
+		delete stereoStream;
+		delete[] samples;
+		delete[] stereoSamples;
+		delete[] monoOut;
+		delete[] stereoOut;
+	}
+};
@@ -0,0 +1,52 @@
+#include <cxxtest/TestSuite.h>
+
+#include <stdio.h>
+
+#include "../null_osystem.h"
+
+#include "common/fs.h"
+#include "common/stream.h"
+
+class FSNodeTestSuite : public CxxTest::TestSuite {
+	static bool writeFile(const Common::FSNode &node, const char *text) {
+		Common::WriteStream *stream = node.createWriteStream();
+		if (!stream)
+			return false;
+		stream->writeString(text);
+		stream->finalize();
+		const bool success = !stream->err();
+		delete stream;
+		return success;
+	}
+
+	static Common::String readFile(const Common::FSNode &node) {
+		Common::SeekableReadStream *stream = node.createReadStream();
+		if (!stream)
+			return Common::String();
+		Common::String text = stream->readString(0, stream->size());
+		delete stream;
+		return text;
+	}
+
+public:
+	void test_rename_replace() {
+		Common::install_null_g_system();
+		const Common::FSNode source("fsnode-rename-source.tmp");
+		const Common::FSNode target("fsnode-rename-target.tmp");
+		TS_ASSERT(source.canRename());
+
+		TS_ASSERT(writeFile(source, "new"));
+		TS_ASSERT(writeFile(target, "old"));
+
+		// The existing target is replaced
+		TS_ASSERT(source.renameTo(target));
+		TS_ASSERT(!Common::FSNode(source.getPath()).exists());
+		TS_ASSERT_EQUALS(readFile(Common::FSNode(target.getPath())), "new");
+
+		// A missing source leaves the target alone
+		TS_ASSERT(!source.renameTo(target));
+		TS_ASSERT_EQUALS(readFile(Common::FSNode(target.getPath())), "new");
+
+		remove(target.getPath().c_str());
+	}
+};
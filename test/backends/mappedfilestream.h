@@ -0,0 +1,63 @@
+#include <cxxtest/TestSuite.h>
+
+#include "backends/fs/mappedfilestream.h"
+#include "backends/fs/stdiostream.h"
+
+#include "common/ptr.h"
+
+// The file copied next to the test runner by the copy-dat target
+static const char *const kMappedTestFile = "test/engine-data/encoding.dat";
+
+class MappedFileStreamTestSuite : public CxxTest::TestSuite {
+public:
+	void tearDown() {
+		MappedFileStream::setEnabled(false);
+	}
+
+	void test_disabled() {
+		MappedFileStream::setEnabled(false);
+		TS_ASSERT(!MappedFileStream::makeFromPath(kMappedTestFile, 0));
+	}
+
+	void test_min_size() {
+		MappedFileStream::setEnabled(true);
+		// The file is smaller than the default minimum
+		TS_ASSERT(!MappedFileStream::makeFromPath(kMappedTestFile));
+		TS_ASSERT(!MappedFileStream::makeFromPath("test/engine-data/missing.dat", 0));
+	}
+
+	void test_read() {
+#if defined(WIN32) || defined(HAS_MMAP)
+		MappedFileStream::setEnabled(true);
+		Common::ScopedPtr<MappedFileStream> mapped(MappedFileStream::makeFromPath(kMappedTestFile, 0));
+		Common::ScopedPtr<StdioStream> file(StdioStream::makeFromPath(kMappedTestFile, false));
+		TS_ASSERT(mapped);
+		TS_ASSERT(file);
+		if (!mapped || !file)
+			return;
+
+		const int64 size = file->size();
+		TS_ASSERT_EQUALS(mapped->size(), size);
+
+		byte *expected = new byte[size];
+		TS_ASSERT_EQUALS(file->read(expected, size), (uint32)size);
+
+		// The contents can be read in place, without a copy
+		const byte *data = mapped->readInPlace(size);
+		TS_ASSERT(data);
+		if (data)
+			TS_ASSERT_EQUALS(memcmp(data, expected, size), 0);
+		TS_ASSERT(!mapped->eos());
+
+		// And like with any other stream
+		byte buffer[64];
+		TS_ASSERT(mapped->seek(-64, SEEK_END));
+		TS_ASSERT_EQUALS(mapped->read(buffer, sizeof(buffer)), sizeof(buffer));
+		TS_ASSERT_EQUALS(memcmp(buffer, expected + size - 64, sizeof(buffer)), 0);
+		TS_ASSERT_EQUALS(mapped->read(buffer, 1), 0u);
+		TS_ASSERT(mapped->eos());
+
+		delete[] expected;
+#endif
+	}
+};
@@ -0,0 +1,75 @@
+#include <cxxtest/TestSuite.h>
+
+#include "../null_osystem.h"
+
+#include "backends/timer/default/default-timer.h"
+#include "common/system.h"
+
+namespace {
+
+/** Schedules the timer procs on a millisecond clock, like the event recorder. */
+class FakeClockTimerManager : public DefaultTimerManager {
+public:
+	uint32 _millis;
+
+	FakeClockTimerManager() : _millis(0) {}
+
+	void advance(uint32 millis) {
+		_millis += millis;
+		handler();
+	}
+
+protected:
+	uint64 getMicros() override {
+		return (uint64)_millis * 1000;
+	}
+};
+
+void countSlowProc(void *refCon) {
+	((uint *)refCon)[0]++;
+}
+
+void countFastProc(void *refCon) {
+	((uint *)refCon)[1]++;
+}
+
+} // End of anonymous namespace
+
+class TimerTestSuite : public CxxTest::TestSuite {
+public:
+	void test_fake_clock() {
+		Common::install_null_g_system();
+		FakeClockTimerManager timer;
+		uint counts[2] = { 0, 0 };
+
+		timer.installTimerProc(&countSlowProc, 10000, counts, "slow");
+		timer.installTimerProc(&countFastProc, 2500, counts, "fast");
+		TS_ASSERT_EQUALS(timer.getTimeToNextTimer(10000), 2500u);
+
+		// The procs follow the fake clock, not the real time
+		g_system->delayMillis(15);
+		timer.advance(0);
+		TS_ASSERT_EQUALS(counts[0], 0u);
+		TS_ASSERT_EQUALS(counts[1], 0u);
+
+		timer.advance(2);
+		TS_ASSERT_EQUALS(counts[1], 0u);
+		TS_ASSERT_EQUALS(timer.getTimeToNextTimer(10000), 500u);
+
+		// The intervals do not accumulate the millisecond steps
+		for (uint i = 0; i < 8; ++i)
+			timer.advance(1);
+		TS_ASSERT_EQUALS(counts[0], 1u);
+		TS_ASSERT_EQUALS(counts[1], 4u);
+
+		// A late handler call catches up with every missed interval
+		timer.advance(15);
+		TS_ASSERT_EQUALS(counts[0], 2u);
+		TS_ASSERT_EQUALS(counts[1], 10u);
+
+		timer.removeTimerProc(&countFastProc);
+		timer.advance(10);
+		TS_ASSERT_EQUALS(counts[0], 3u);
+		TS_ASSERT_EQUALS(counts[1], 10u);
+	}
+};
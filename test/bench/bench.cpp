@@ -0,0 +1,132 @@
+/*
+ * Micro-benchmarks for performance critical code, run with "make bench".
+ *
+ * Every harness lives in its own header in this directory and reports its
+ * results through Bench::report(). With "--json <file>", or
+ * "make bench BENCH_JSON=<file>", the results are also written as JSON,
+ * so that they can be compared between builds and platforms.
+ */
+
+#define FORBIDDEN_SYMBOL_EXCEPTION_printf
+
+#include "common/array.h"
+#include "common/file.h"
+#include "common/fs.h"
+#include "common/scummsys.h"
+#include "common/str.h"
+#include "common/system.h"
+
+#include "test/null_osystem.h"
+
+namespace Bench {
+
+struct Result {
+	const char *suite;
+	Common::String name;
+	double value;
+	const char *unit;
+};
+
+static Common::Array<Result> results;
+
+static void report(const char *suite, const Common::String &name, double value, const char *unit) {
+	printf("%-8s %-40s %10.3f %s\n", suite, name.c_str(), value, unit);
+
+	Result result;
+	result.suite = suite;
+	result.name = name;
+	result.value = value;
+	result.unit = unit;
+	results.push_back(result);
+}
+
+static Common::String jsonString(const Common::String &str) {
+	Common::String quoted("\"");
+	for (uint i = 0; i < str.size(); ++i) {
+		if (str[i] == '"' || str[i] == '\\')
+			quoted += '\\';
+		quoted += str[i];
+	}
+	return quoted + "\"";
+}
+
+static bool writeJSON(const char *path) {
+	Common::DumpFile file;
+	if (!file.open(Common::FSNode(path)))
+		return false;
+
+#ifdef __VERSION__
+	const char *compiler = __VERSION__;
+#else
+	const char *compiler = "unknown";
+#endif
+#ifdef SCUMM_BIG_ENDIAN
+	const char *endianness = "big";
+#else
+	const char *endianness = "little";
+#endif
+
+	file.writeString("{\n");
+	file.writeString(Common::String::format("\t\"compiler\": %s,\n", jsonString(compiler).c_str()));
+	file.writeString(Common::String::format("\t\"pointerBits\": %d,\n", (int)sizeof(void *) * 8));
+	file.writeString(Common::String::format("\t\"endianness\": \"%s\",\n", endianness));
+	file.writeString("\t\"results\": [\n");
+	for (uint i = 0; i < results.size(); ++i) {
+		file.writeString(Common::String::format("\t\t{ \"suite\": %s, \"name\": %s, \"value\": %.3f, \"unit\": %s }%s\n",
+			jsonString(results[i].suite).c_str(), jsonString(results[i].name).c_str(), results[i].value,
+			jsonString(results[i].unit).c_str(), i + 1 < results.size() ? "," : ""));
+	}
+	file.writeString("\t]\n}\n");
+
+	return file.flush() && !file.err();
+}
+
+} // End of namespace Bench
+
+#include "test/bench/bitstream.h"
+#include "test/bench/blit.h"
+#include "test/bench/hashmap.h"
+#include "test/bench/huffman.h"
+#include "test/bench/md5.h"
+#include "test/bench/opl.h"
+#include "test/bench/rate.h"
+#include "test/bench/scaler.h"
+#include "test/bench/str.h"
+#include "test/bench/tinygl.h"
+#include "test/bench/yuv.h"
+#include "test/bench/zlib.h"
+
+int main(int argc, char *argv[]) {
+	const char *jsonPath = nullptr;
+	if (argc == 3 && !strcmp(argv[1], "--json")) {
+		jsonPath = argv[2];
+	} else if (argc != 1) {
+		printf("Usage: %s [--json <file>]\n", argv[0]);
+		return 1;
+	}
+
+	Common::install_null_g_system();
+
+	Bench::benchRateConverters();
+	Bench::benchOPLEmulators();
+	Bench::benchTransparentBlit();
+	Bench::benchTransBlit();
+	Bench::benchCrossBlit();
+	Bench::benchScalers();
+	Bench::benchYUVToRGB();
+	Bench::benchTinyGLTriangles();
+	Bench::benchHashMapLookups();
+	Bench::benchIgnoreCaseLookups();
+	Bench::benchBitStream();
+	Bench::benchHuffman();
+	Bench::benchStrings();
+	Bench::benchInflate();
+	Bench::benchMD5();
+
+	if (jsonPath && !Bench::writeJSON(jsonPath)) {
+		printf("Could not write the results to %s\n", jsonPath);
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,51 @@
+#include "common/array.h"
+#include "common/bitstream.h"
+
+namespace Bench {
+
+template<class BITSTREAM>
+static void benchBitStreamLayout(const char *name, const Common::Array<byte> &data) {
+	const int rounds = 50;
+
+	uint32 sum = 0;
+	uint32 reads = 0;
+	uint32 start = g_system->getMillis();
+	for (int round = 0; round < rounds; ++round) {
+		Common::BitStreamMemoryStream stream(data.data(), data.size());
+		BITSTREAM bits(stream);
+
+		// Mix of peeks, single bits and wider reads, as in entropy decoders
+		const uint32 totalBits = bits.size() - 64;
+		while (bits.pos() < totalBits) {
+			uint32 n = 1 + (bits.peekBits(8) & 15);
+			sum += bits.getBits(n);
+			sum += bits.getBit();
+			reads += 2;
+		}
+	}
+	uint32 elapsed = g_system->getMillis() - start;
+
+	// Keep the compiler from dropping the loop
+	if (sum == 0xFFFFFFFF)
+		report("bitstrm", "unlikely", 0, "");
+	report("bitstrm", name, reads / (MAX<uint32>(elapsed, 1) * 1000.0), "Mreads/s");
+}
+
+/**
+ * Measure bit reading from memory for the layouts the entropy decoders use.
+ */
+static void benchBitStream() {
+	Common::Array<byte> data;
+	uint32 seed = 1;
+	for (int i = 0; i < (1 << 20); ++i) {
+		seed = seed * 1103515245 + 12345;
+		data.push_back(seed >> 24);
+	}
+
+	benchBitStreamLayout<Common::BitStreamMemory8MSB>("8-bit MSB", data);
+	benchBitStreamLayout<Common::BitStreamMemory8LSB>("8-bit LSB", data);
+	benchBitStreamLayout<Common::BitStreamMemory16LEMSB>("16-bit LE MSB", data);
+	benchBitStreamLayout<Common::BitStreamMemory32LELSB>("32-bit LE LSB", data);
+}
+
+} // End of namespace Bench
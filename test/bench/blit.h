@@ -0,0 +1,131 @@
+#include "graphics/conversion.h"
+#include "graphics/managed_surface.h"
+#include "graphics/transparent_surface.h"
+
+namespace Bench {
+
+/**
+ * Measure how many pixels per second TransparentSurface::blit draws for
+ * the cases sprite heavy engines like WinterMute hit most.
+ */
+static void benchTransparentBlit() {
+	const int frames = 500;
+	const Graphics::PixelFormat format(4, 8, 8, 8, 8, 24, 16, 8, 0);
+
+	Graphics::TransparentSurface sprite;
+	sprite.create(320, 240, format);
+	for (int y = 0; y < sprite.h; ++y) {
+		for (int x = 0; x < sprite.w; ++x)
+			*(uint32 *)sprite.getBasePtr(x, y) = (x * 0x01030507) ^ (y * 0x0B0D1113);
+	}
+
+	Graphics::Surface screen;
+	screen.create(640, 480, format);
+
+	static const struct {
+		const char *name;
+		Graphics::AlphaType alphaMode;
+		uint32 color;
+	} cases[] = {
+		{ "opaque", Graphics::ALPHA_OPAQUE, 0xFFFFFFFF },
+		{ "binary", Graphics::ALPHA_BINARY, 0xFFFFFFFF },
+		{ "alpha", Graphics::ALPHA_FULL, 0xFFFFFFFF },
+		{ "alpha colormod", Graphics::ALPHA_FULL, 0xC0E0FF80 }
+	};
+
+	for (int i = 0; i < ARRAYSIZE(cases); ++i) {
+		for (int flipping = 0; flipping < 2; ++flipping) {
+			sprite.setAlphaMode(cases[i].alphaMode);
+
+			const uint32 start = g_system->getMillis();
+			for (int frame = 0; frame < frames; ++frame)
+				sprite.blit(screen, frame % 64, frame % 48, flipping ? Graphics::FLIP_H : Graphics::FLIP_NONE, nullptr, cases[i].color);
+			const uint32 elapsed = MAX<uint32>(g_system->getMillis() - start, 1);
+
+			report("blit", Common::String::format("%s%s", cases[i].name, flipping ? " flipped" : ""),
+			       (double)sprite.w * sprite.h * frames / elapsed / 1000.0, "Mpixel/s");
+		}
+	}
+
+	sprite.free();
+	screen.free();
+}
+
+/**
+ * Measure ManagedSurface::transBlitFrom of a paletted sprite with a
+ * transparent color, with and without span caching.
+ */
+static void benchTransBlit() {
+	const int frames = 2000;
+
+	Graphics::ManagedSurface sprite(160, 120);
+	for (int y = 0; y < sprite.h; ++y) {
+		for (int x = 0; x < sprite.w; ++x) {
+			// Opaque runs of varying length, in a transparent frame
+			const int dx = x - sprite.w / 2, dy = y - sprite.h / 2;
+			sprite.setPixel(x, y, (dx * dx + dy * dy < 55 * 55 && (x + y) % 29) ? 1 + (x ^ y) % 255 : 0);
+		}
+	}
+
+	Graphics::ManagedSurface screen(640, 480);
+
+	for (int caching = 0; caching < 2; ++caching) {
+		sprite.setSpanCaching(caching != 0);
+
+		const uint32 start = g_system->getMillis();
+		for (int frame = 0; frame < frames; ++frame)
+			screen.transBlitFrom(sprite, Common::Point(frame % 480, frame % 360), 0);
+		const uint32 elapsed = MAX<uint32>(g_system->getMillis() - start, 1);
+
+		report("blit", caching ? "transBlitFrom clut8 span cache" : "transBlitFrom clut8",
+		       (double)sprite.w * sprite.h * frames / elapsed / 1000.0, "Mpixel/s");
+	}
+}
+
+/**
+ * Measure Graphics::crossBlit for the conversions backends and video
+ * decoders do every frame.
+ */
+static void benchCrossBlit() {
+	const int frames = 200;
+	const int width = 640;
+	const int height = 480;
+
+	static const struct {
+		const char *name;
+		Graphics::PixelFormat format;
+	} formats[] = {
+		{ "rgb565", Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0) },
+		{ "rgba8888", Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0) },
+		{ "abgr8888", Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24) }
+	};
+
+	byte *src = new byte[width * height * 4];
+	byte *dst = new byte[width * height * 4];
+	for (int i = 0; i < width * height * 4; ++i)
+		src[i] = (i * 13) ^ (i >> 7);
+
+	for (int from = 0; from < ARRAYSIZE(formats); ++from) {
+		for (int to = 0; to < ARRAYSIZE(formats); ++to) {
+			if (from == to)
+				continue;
+
+			const Graphics::PixelFormat &srcFormat = formats[from].format;
+			const Graphics::PixelFormat &dstFormat = formats[to].format;
+			const uint32 start = g_system->getMillis();
+			for (int frame = 0; frame < frames; ++frame) {
+				Graphics::crossBlit(dst, src, width * dstFormat.bytesPerPixel, width * srcFormat.bytesPerPixel,
+				                    width, height, dstFormat, srcFormat);
+			}
+			const uint32 elapsed = MAX<uint32>(g_system->getMillis() - start, 1);
+
+			report("blit", Common::String::format("crossBlit %s to %s", formats[from].name, formats[to].name),
+			       (double)width * height * frames / elapsed / 1000.0, "Mpixel/s");
+		}
+	}
+
+	delete[] src;
+	delete[] dst;
+}
+
+} // End of namespace Bench
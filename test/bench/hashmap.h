@@ -0,0 +1,106 @@
+#include "common/array.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+
+namespace Bench {
+
+/**
+ * Measure HashMap lookups with String keys, hits and misses, the way the
+ * resource and script tables of the engines use them.
+ */
+static void benchHashMapLookups() {
+	const int entries = 4096;
+	const int rounds = 200;
+
+	Common::Array<Common::String> keys;
+	Common::Array<Common::String> missingKeys;
+	for (int i = 0; i < entries; ++i) {
+		keys.push_back(Common::String::format("resource_%d.dat", i));
+		missingKeys.push_back(Common::String::format("missing_%d.dat", i));
+	}
+
+	uint32 start = g_system->getMillis();
+	for (int round = 0; round < rounds / 10; ++round) {
+		Common::HashMap<Common::String, int> map;
+		for (int i = 0; i < entries; ++i)
+			map[keys[i]] = i;
+	}
+	uint32 elapsed = g_system->getMillis() - start;
+	report("hashmap", "String insert", elapsed * 1000000.0 / (rounds / 10 * entries), "ns per key");
+
+	Common::HashMap<Common::String, int> map;
+	for (int i = 0; i < entries; ++i)
+		map[keys[i]] = i;
+
+	int found = 0;
+	start = g_system->getMillis();
+	for (int round = 0; round < rounds; ++round) {
+		for (int i = 0; i < entries; ++i)
+			found += map.contains(keys[i]);
+	}
+	elapsed = g_system->getMillis() - start;
+	report("hashmap", "String lookup hit", elapsed * 1000000.0 / (rounds * entries), "ns per key");
+
+	start = g_system->getMillis();
+	for (int round = 0; round < rounds; ++round) {
+		for (int i = 0; i < entries; ++i)
+			found += map.contains(missingKeys[i]);
+	}
+	elapsed = g_system->getMillis() - start;
+	report("hashmap", "String lookup miss", elapsed * 1000000.0 / (rounds * entries), "ns per key");
+
+	assert(found == rounds * entries);
+}
+
+/**
+ * Measure case insensitive lookups, the way SearchSet and the resource maps
+ * of the engines look up file names, with and without a precomputed hash.
+ */
+static void benchIgnoreCaseLookups() {
+	typedef Common::HashMap<Common::String, int, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> FileMap;
+
+	const int entries = 4096;
+	const int rounds = 200;
+	const int maps = 4;
+
+	Common::Array<Common::String> keys;
+	FileMap fileMaps[maps];
+	for (int i = 0; i < entries; ++i) {
+		keys.push_back(Common::String::format("RESOURCE_%d.DAT", i));
+		fileMaps[i % maps][Common::String::format("Resource_%d.dat", i)] = i;
+	}
+
+	int found = 0;
+	uint32 start = g_system->getMillis();
+	for (int round = 0; round < rounds; ++round) {
+		for (int i = 0; i < entries; ++i)
+			found += Common::hashit_lower(keys[i]) & 1;
+	}
+	uint32 elapsed = g_system->getMillis() - start;
+	report("hashmap", "hashit_lower", elapsed * 1000000.0 / (rounds * entries), "ns per key");
+
+	start = g_system->getMillis();
+	for (int round = 0; round < rounds; ++round) {
+		for (int i = 0; i < entries; ++i) {
+			for (int m = 0; m < maps; ++m)
+				found += fileMaps[m].contains(keys[i]);
+		}
+	}
+	elapsed = g_system->getMillis() - start;
+	report("hashmap", "IgnoreCase lookup in 4 maps", elapsed * 1000000.0 / (rounds * entries), "ns per key");
+
+	start = g_system->getMillis();
+	for (int round = 0; round < rounds; ++round) {
+		for (int i = 0; i < entries; ++i) {
+			const uint hash = Common::IgnoreCase_Hash()(keys[i]);
+			for (int m = 0; m < maps; ++m)
+				found += fileMaps[m].contains(keys[i], hash);
+		}
+	}
+	elapsed = g_system->getMillis() - start;
+	report("hashmap", "IgnoreCase prehashed lookup in 4 maps", elapsed * 1000000.0 / (rounds * entries), "ns per key");
+
+	assert(found >= 2 * rounds * entries);
+}
+
+} // End of namespace Bench
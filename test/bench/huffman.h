@@ -0,0 +1,72 @@
+#include "common/array.h"
+#include "common/bitstream.h"
+#include "common/huffman.h"
+
+namespace Bench {
+
+/**
+ * Measure Huffman symbol decoding for a code where most symbols fit in the
+ * prefix table and the rest need the long code lookup, like the WMA and
+ * SVQ1 tables.
+ */
+static void benchHuffman() {
+	const int symbolCount = 64 + 256 + 1024;
+	const int streamSymbols = 1 << 16;
+	const int rounds = 20;
+
+	// Canonical code: 64 symbols of 7 bits, 256 of 10 bits and 1024 of 13 bits
+	Common::Array<uint32> codes;
+	Common::Array<uint8> lengths;
+	uint32 code = 0;
+	uint8 length = 7;
+	for (int i = 0; i < symbolCount; ++i) {
+		uint8 newLength = (i < 64) ? 7 : (i < 64 + 256) ? 10 : 13;
+		code <<= newLength - length;
+		length = newLength;
+
+		codes.push_back(code++);
+		lengths.push_back(length);
+	}
+
+	Common::Huffman<Common::BitStreamMemory8MSB> huffman(0, symbolCount, codes.data(), lengths.data());
+
+	// Encode a pseudo-random stream where a quarter of the symbols are long
+	Common::Array<byte> data;
+	Common::Array<uint32> expected;
+	uint32 bitBuffer = 0;
+	int bitCount = 0;
+	uint32 seed = 1;
+	for (int i = 0; i < streamSymbols; ++i) {
+		seed = seed * 1103515245 + 12345;
+		uint32 r = seed >> 16;
+		uint32 symbol = (r & 3) ? (r >> 2) % 64 : 64 + (r >> 2) % (256 + 1024);
+		expected.push_back(symbol);
+
+		bitBuffer = (bitBuffer << lengths[symbol]) | codes[symbol];
+		bitCount += lengths[symbol];
+		while (bitCount >= 8) {
+			bitCount -= 8;
+			data.push_back((bitBuffer >> bitCount) & 0xFF);
+		}
+	}
+	data.push_back((bitBuffer << (8 - bitCount)) & 0xFF);
+	// Padding so that peeking at the end of the stream stays in bounds
+	for (int i = 0; i < 4; ++i)
+		data.push_back(0);
+
+	uint32 errors = 0;
+	uint32 start = g_system->getMillis();
+	for (int round = 0; round < rounds; ++round) {
+		Common::BitStreamMemoryStream stream(data.data(), data.size());
+		Common::BitStreamMemory8MSB bits(stream);
+
+		for (int i = 0; i < streamSymbols; ++i)
+			errors += huffman.getSymbol(bits) != expected[i];
+	}
+	uint32 elapsed = g_system->getMillis() - start;
+
+	assert(errors == 0);
+	report("huffman", "mixed 7/10/13 bit codes", rounds * streamSymbols / (MAX<uint32>(elapsed, 1) * 1000.0), "Msymbols/s");
+}
+
+} // End of namespace Bench
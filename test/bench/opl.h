@@ -0,0 +1,86 @@
+#include "audio/fmopl.h"
+
+namespace Bench {
+
+/**
+ * Start a sustained note with the same bright FM patch on all 9 (or, for
+ * OPL3, 18) melodic channels, so that every operator is busy.
+ */
+static void startOPLNotes(OPL::OPL *opl, bool opl3) {
+	static const int opOffsets[9] = { 0, 1, 2, 8, 9, 10, 16, 17, 18 };
+
+	opl->writeReg(0x01, 0x20);
+	opl->writeReg(0xBD, 0xC0);
+	if (opl3)
+		opl->writeReg(0x105, 0x01);
+
+	for (int bank = 0; bank < (opl3 ? 2 : 1); ++bank) {
+		const int base = bank ? 0x100 : 0;
+		for (int channel = 0; channel < 9; ++channel) {
+			for (int op = 0; op < 2; ++op) {
+				const int offset = base + opOffsets[channel] + op * 3;
+				opl->writeReg(0x20 + offset, 0xE1);
+				opl->writeReg(0x40 + offset, op ? 0x00 : 0x12);
+				opl->writeReg(0x60 + offset, 0xF4);
+				opl->writeReg(0x80 + offset, 0x56);
+				opl->writeReg(0xE0 + offset, op ? 0x00 : 0x01);
+			}
+
+			const int fnum = 0x16B + channel * 23;
+			opl->writeReg(base + 0xC0 + channel, 0x0E | (opl3 ? 0x30 : 0));
+			opl->writeReg(base + 0xA0 + channel, fnum & 0xFF);
+			opl->writeReg(base + 0xB0 + channel, 0x20 | (4 << 2) | (fnum >> 8));
+		}
+	}
+}
+
+/**
+ * Measure how much faster than real time each software OPL emulator runs,
+ * so users can pick one that suits their CPU.
+ */
+static void benchOPLEmulators() {
+	const int seconds = 10;
+	const int frames = 1024;
+
+	int16 *buffer = new int16[frames * 2];
+
+	static const char *const emulators[] = { "mame", "db", "nuked" };
+
+	for (int i = 0; i < ARRAYSIZE(emulators); ++i) {
+		const OPL::Config::EmulatorDescription *desc = OPL::Config::findDriver(OPL::Config::parse(emulators[i]));
+		if (!desc)
+			continue;
+
+		for (int opl3 = 0; opl3 < 2; ++opl3) {
+			if (opl3 && !(desc->flags & OPL::Config::kFlagOpl3))
+				continue;
+
+			OPL::OPL *opl = OPL::Config::create(desc->id, opl3 ? OPL::Config::kOpl3 : OPL::Config::kOpl2);
+			if (!opl || !opl->init()) {
+				delete opl;
+				continue;
+			}
+
+			OPL::EmulatedOPL *emulated = (OPL::EmulatedOPL *)opl;
+			emulated->setCallbackFrequency(250);
+			startOPLNotes(opl, opl3 != 0);
+
+			const int rate = emulated->getRate();
+			const int samples = frames * (opl3 ? 2 : 1);
+
+			const uint32 start = g_system->getMillis();
+			for (int done = 0; done < rate * seconds; done += frames)
+				emulated->readBuffer(buffer, samples);
+			const uint32 elapsed = MAX<uint32>(g_system->getMillis() - start, 1);
+
+			report("opl", Common::String::format("%s %s %d Hz", desc->name, opl3 ? "opl3" : "opl2", rate),
+			       seconds * 1000.0 / elapsed, "x realtime");
+
+			delete opl;
+		}
+	}
+
+	delete[] buffer;
+}
+
+} // End of namespace Bench
@@ -0,0 +1,71 @@
+#include "audio/audiostream.h"
+#include "audio/mixer.h"
+#include "audio/rate.h"
+
+namespace Bench {
+
+/**
+ * Endless stream producing a sawtooth. It is as cheap as possible, so that
+ * the rate converter benchmark measures the converters only.
+ */
+class SawtoothStream : public Audio::AudioStream {
+public:
+	SawtoothStream(int rate, bool stereo) : _rate(rate), _stereo(stereo), _value(0) {}
+
+	virtual int readBuffer(int16 *buffer, const int numSamples) {
+		for (int i = 0; i < numSamples; ++i)
+			buffer[i] = (_value += 331);
+		return numSamples;
+	}
+
+	virtual bool isStereo() const { return _stereo; }
+	virtual int getRate() const { return _rate; }
+	virtual bool endOfData() const { return false; }
+
+private:
+	const int _rate;
+	const bool _stereo;
+	int16 _value;
+};
+
+/**
+ * Measure the cost of a single mixer channel for every rate converter
+ * quality, mixing into a 48kHz output like most desktop backends do.
+ */
+static void benchRateConverters() {
+	const int outRate = 48000;
+	const int seconds = 10;
+	const int frames = 1024;
+
+	static const int inRates[] = { 11025, 22050, 44100 };
+	static const char *const qualityNames[] = { "linear", "sinc_low", "sinc_medium", "sinc_high" };
+
+	int32 *buffer = new int32[frames * 2];
+
+	for (int quality = Audio::kRateConverterLinear; quality <= Audio::kRateConverterSincHigh; ++quality) {
+		for (int rate = 0; rate < ARRAYSIZE(inRates); ++rate) {
+			for (int stereo = 0; stereo < 2; ++stereo) {
+				SawtoothStream stream(inRates[rate], stereo != 0);
+				Audio::RateConverter *converter = Audio::makeRateConverter(inRates[rate], outRate, stereo != 0, false, (Audio::RateConverterQuality)quality);
+
+				const uint32 start = g_system->getMillis();
+				for (int done = 0; done < outRate * seconds; done += frames) {
+					memset(buffer, 0, frames * 2 * sizeof(int32));
+					converter->flowMix(stream, buffer, frames, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume / 2);
+				}
+				const uint32 elapsed = g_system->getMillis() - start;
+
+				// Milliseconds per 10 seconds of audio, divided by 100, gives
+				// the share of one CPU core used by a playing channel.
+				report("rate", Common::String::format("%s %s %d -> %d", qualityNames[quality], stereo ? "stereo" : "mono", inRates[rate], outRate),
+				       elapsed / (seconds * 10.0), "% cpu per channel");
+
+				delete converter;
+			}
+		}
+	}
+
+	delete[] buffer;
+}
+
+} // End of namespace Bench
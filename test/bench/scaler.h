@@ -0,0 +1,93 @@
+#include "graphics/scalerplugin.h"
+#include "graphics/scaler/normal.h"
+#ifdef USE_SCALERS
+#include "graphics/scaler/dotmatrix.h"
+#include "graphics/scaler/pm.h"
+#include "graphics/scaler/sai.h"
+#include "graphics/scaler/scalebit.h"
+#include "graphics/scaler/tv.h"
+#ifdef USE_HQ_SCALERS
+#include "graphics/scaler/hq.h"
+#endif
+#ifdef USE_EDGE_SCALERS
+#include "graphics/scaler/edge.h"
+#endif
+#endif
+
+namespace Bench {
+
+static void benchScaler(ScalerPluginObject &scaler) {
+	const int frames = 100;
+	const int width = 320;
+	const int height = 200;
+	const Graphics::PixelFormat format(2, 5, 6, 5, 0, 11, 5, 0, 0);
+
+	scaler.initialize(format);
+
+	// Blocks of a few colors, so that the scalers see edges to blend
+	const int border = scaler.extraPixels();
+	Graphics::Surface src;
+	src.create(width + 2 * border, height + 2 * border, format);
+	for (int y = 0; y < src.h; ++y) {
+		for (int x = 0; x < src.w; ++x)
+			*(uint16 *)src.getBasePtr(x, y) = ((x / 7) ^ (y / 5)) & 1 ? 0xF81F : (x * 0x0841) ^ (y * 0x1003);
+	}
+	const uint8 *srcPtr = (const uint8 *)src.getBasePtr(border, border);
+
+	const Common::Array<uint> &factors = scaler.getFactors();
+	for (uint i = 0; i < factors.size(); ++i) {
+		scaler.setFactor(factors[i]);
+
+		Graphics::Surface dst;
+		dst.create(width * factors[i], height * factors[i], format);
+
+		const uint32 start = g_system->getMillis();
+		for (int frame = 0; frame < frames; ++frame)
+			scaler.scale(srcPtr, src.pitch, (uint8 *)dst.getPixels(), dst.pitch, width, height, 0, 0);
+		const uint32 elapsed = MAX<uint32>(g_system->getMillis() - start, 1);
+
+		report("scaler", Common::String::format("%s %ux rgb565 320x200", scaler.getName(), factors[i]),
+		       frames * 1000.0 / elapsed, "fps");
+
+		dst.free();
+	}
+
+	src.free();
+	scaler.deinitialize();
+}
+
+/**
+ * Measure how many 320x200 frames per second each scaler plugin scales on
+ * the calling thread, for all of its factors.
+ */
+static void benchScalers() {
+	NormalPlugin normal;
+	benchScaler(normal);
+
+#ifdef USE_SCALERS
+	AdvMamePlugin advMame;
+	benchScaler(advMame);
+	SAIPlugin sai;
+	benchScaler(sai);
+	SuperSAIPlugin superSai;
+	benchScaler(superSai);
+	SuperEaglePlugin superEagle;
+	benchScaler(superEagle);
+	PMPlugin pm;
+	benchScaler(pm);
+	DotMatrixPlugin dotMatrix;
+	benchScaler(dotMatrix);
+	TVPlugin tv;
+	benchScaler(tv);
+#ifdef USE_HQ_SCALERS
+	HQPlugin hq;
+	benchScaler(hq);
+#endif
+#ifdef USE_EDGE_SCALERS
+	EdgePlugin edge;
+	benchScaler(edge);
+#endif
+#endif
+}
+
+} // End of namespace Bench
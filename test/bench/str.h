@@ -0,0 +1,79 @@
+#include "common/array.h"
+#include "common/str.h"
+
+namespace Bench {
+
+/**
+ * Measure the common String operations, for strings in the internal
+ * storage, just above it, and far above it.
+ */
+static void benchStrings() {
+	const int count = 1024;
+	const int rounds = 1000;
+
+	static const struct {
+		const char *name;
+		uint length;
+	} sizes[] = {
+		{ "short", 16 },
+		{ "medium", 48 },
+		{ "long", 400 }
+	};
+
+	char filler[400];
+	memset(filler, 'x', sizeof(filler));
+
+	for (int s = 0; s < ARRAYSIZE(sizes); ++s) {
+		Common::Array<Common::String> sources;
+		for (int i = 0; i < count; ++i)
+			sources.push_back(Common::String::format("%d", i) + Common::String(filler, sizes[s].length));
+
+		Common::Array<Common::String> copies;
+		copies.resize(count);
+
+		uint32 start = g_system->getMillis();
+		for (int round = 0; round < rounds; ++round) {
+			for (int i = 0; i < count; ++i)
+				copies[i] = sources[i];
+			for (int i = 0; i < count; ++i)
+				copies[i].clear();
+		}
+		uint32 elapsed = g_system->getMillis() - start;
+		report("str", Common::String::format("%s copy", sizes[s].name), elapsed * 1000000.0 / (rounds * count), "ns per string");
+
+		start = g_system->getMillis();
+		for (int round = 0; round < rounds; ++round) {
+			for (int i = 0; i < count; ++i) {
+				// Copy and modify, which unshares shared storage
+				copies[i] = sources[i];
+				copies[i].setChar('y', 0);
+			}
+		}
+		elapsed = g_system->getMillis() - start;
+		report("str", Common::String::format("%s copy and modify", sizes[s].name), elapsed * 1000000.0 / (rounds * count), "ns per string");
+
+		start = g_system->getMillis();
+		for (int round = 0; round < rounds / 10; ++round) {
+			for (int i = 0; i < count; ++i) {
+				Common::String str;
+				for (uint c = 0; c < sizes[s].length; c += 8)
+					str += "abcdefgh";
+				copies[i] = str;
+			}
+		}
+		elapsed = g_system->getMillis() - start;
+		report("str", Common::String::format("%s append", sizes[s].name), elapsed * 1000000.0 / (rounds / 10 * count), "ns per string");
+	}
+
+	Common::String a = Common::String(filler, 200) + "a";
+	Common::String b = Common::String(filler, 200) + "b";
+	int different = 0;
+	uint32 start = g_system->getMillis();
+	for (int round = 0; round < rounds * 100; ++round)
+		different += (a != b) + (a.hash() & 1);
+	uint32 elapsed = g_system->getMillis() - start;
+	report("str", "compare and hash", elapsed * 1000000.0 / (rounds * 100), "ns per pair");
+	assert(different >= rounds * 100);
+}
+
+} // End of namespace Bench
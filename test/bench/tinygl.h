@@ -0,0 +1,60 @@
+#include "graphics/tinygl/zbuffer.h"
+
+namespace Bench {
+
+/**
+ * Measure how many screen sized, depth tested triangles per second the
+ * TinyGL rasterizer fills, with flat and with Gouraud shading.
+ */
+static void benchTinyGLTriangles() {
+#ifdef USE_TINYGL
+	const int triangles = 1000;
+	const int width = 640;
+	const int height = 480;
+
+	static const struct {
+		const char *name;
+		Graphics::PixelFormat format;
+	} formats[] = {
+		{ "rgb565", Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0) },
+		{ "rgba8888", Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0) }
+	};
+
+	for (int i = 0; i < ARRAYSIZE(formats); ++i) {
+		TinyGL::FrameBuffer *zb = new TinyGL::FrameBuffer(width, height, formats[i].format);
+		zb->enableDepthTest(true);
+		zb->setDepthFunc(TGL_LESS);
+
+		for (int mode = 0; mode < 2; ++mode) {
+			zb->clear(1, 0, 1, 0, 0, 0);
+			const uint32 start = g_system->getMillis();
+			for (int tri = 0; tri < triangles; ++tri) {
+				// Nearer each time, so that every pixel passes the depth test
+				TinyGL::ZBufferPoint p[3];
+				for (int j = 0; j < 3; ++j) {
+					p[j].x = (j == 1) ? width - 1 : 0;
+					p[j].y = (j == 2) ? height - 1 : 0;
+					p[j].z = (tri + 1) << 16;
+					p[j].r = (j == 0) ? 0xFFFF : 0x1000;
+					p[j].g = (j == 1) ? 0xFFFF : 0x1000;
+					p[j].b = (j == 2) ? 0xFFFF : 0x1000;
+					p[j].a = 0xFFFF;
+				}
+				if (mode == 0)
+					zb->fillTriangleFlat(&p[0], &p[1], &p[2]);
+				else
+					zb->fillTriangleSmooth(&p[0], &p[1], &p[2]);
+			}
+			const uint32 elapsed = MAX<uint32>(g_system->getMillis() - start, 1);
+
+			static const char *const modes[] = { "flat", "smooth" };
+			report("tinygl", Common::String::format("%s triangles %s 640x480", modes[mode], formats[i].name),
+			       triangles * 1000.0 / elapsed, "tri/s");
+		}
+
+		delete zb;
+	}
+#endif
+}
+
+} // End of namespace Bench
@@ -0,0 +1,64 @@
+#include "graphics/yuv_to_rgb.h"
+
+namespace Bench {
+
+/**
+ * Measure how many 1080p frames per second YUVToRGBManager converts, for
+ * the subsampling modes the video decoders use.
+ */
+static void benchYUVToRGB() {
+	const int frames = 30;
+	const int width = 1920;
+	const int height = 1080;
+
+	// 410 reads one extra row and column of chroma
+	const int uvPitch = width + 1;
+	byte *ySrc = new byte[width * height];
+	byte *uSrc = new byte[uvPitch * (height + 1)];
+	byte *vSrc = new byte[uvPitch * (height + 1)];
+	for (int i = 0; i < width * height; ++i)
+		ySrc[i] = (i * 7) ^ (i >> 11);
+	for (int i = 0; i < uvPitch * (height + 1); ++i) {
+		uSrc[i] = (i * 3) ^ (i >> 9);
+		vSrc[i] = (i * 5) ^ (i >> 10);
+	}
+
+	static const struct {
+		const char *name;
+		Graphics::PixelFormat format;
+	} formats[] = {
+		{ "rgb565", Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0) },
+		{ "rgba8888", Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0) }
+	};
+
+	for (int i = 0; i < ARRAYSIZE(formats); ++i) {
+		Graphics::Surface dst;
+		dst.create(width, height, formats[i].format);
+
+		for (int mode = 0; mode < 3; ++mode) {
+			const uint32 start = g_system->getMillis();
+			for (int frame = 0; frame < frames; ++frame) {
+				const Graphics::YUVToRGBManager::LuminanceScale scale = (frame & 1) ? Graphics::YUVToRGBManager::kScaleITU : Graphics::YUVToRGBManager::kScaleFull;
+				if (mode == 0)
+					YUVToRGBMan.convert444(&dst, scale, ySrc, uSrc, vSrc, width, height, width, uvPitch);
+				else if (mode == 1)
+					YUVToRGBMan.convert420(&dst, scale, ySrc, uSrc, vSrc, width, height, width, uvPitch);
+				else
+					YUVToRGBMan.convert410(&dst, scale, ySrc, uSrc, vSrc, width, height, width, uvPitch);
+			}
+			const uint32 elapsed = MAX<uint32>(g_system->getMillis() - start, 1);
+
+			static const char *const modes[] = { "444", "420", "410" };
+			report("yuv", Common::String::format("%s to %s 1920x1080", modes[mode], formats[i].name),
+			       frames * 1000.0 / elapsed, "fps");
+		}
+
+		dst.free();
+	}
+
+	delete[] ySrc;
+	delete[] uSrc;
+	delete[] vSrc;
+}
+
+} // End of namespace Bench
@@ -0,0 +1,48 @@
+#include "common/memstream.h"
+#include "common/zlib.h"
+
+namespace Bench {
+
+/**
+ * Measure how fast gzip data is inflated through the stream wrapper that
+ * compressed saves and game archives are read with.
+ */
+static void benchInflate() {
+#ifdef USE_ZLIB
+	const int rounds = 20;
+	const uint32 size = 4 * 1024 * 1024;
+
+	// Text like data, which compresses about as well as game scripts
+	Common::MemoryWriteStreamDynamic *compressed = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+	Common::WriteStream *deflater = Common::wrapCompressedWriteStream(compressed);
+	uint32 seed = 1;
+	for (uint32 i = 0; i < size; ++i) {
+		seed = seed * 1103515245 + 12345;
+		deflater->writeByte("etaoin shrdlu\n"[(seed >> 16) % 14]);
+	}
+	deflater->finalize();
+	const uint32 compressedSize = compressed->size();
+	byte *compressedData = compressed->getData();
+	delete deflater;
+
+	byte *buffer = new byte[64 * 1024];
+	uint32 total = 0;
+	const uint32 start = g_system->getMillis();
+	for (int round = 0; round < rounds; ++round) {
+		Common::SeekableReadStream *stream = Common::wrapCompressedReadStream(
+			new Common::MemoryReadStream(compressedData, compressedSize));
+		while (!stream->eos())
+			total += stream->read(buffer, 64 * 1024);
+		delete stream;
+	}
+	const uint32 elapsed = MAX<uint32>(g_system->getMillis() - start, 1);
+
+	assert(total == rounds * size);
+	report("zlib", "inflate gzip stream", (double)total / elapsed / 1000.0, "MB/s");
+
+	delete[] buffer;
+	free(compressedData);
+#endif
+}
+
+} // End of namespace Bench
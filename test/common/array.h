@@ -420,6 +420,73 @@ class ArrayTestSuite : public CxxTest::TestSuite
 		TS_ASSERT_EQUALS(array[1], 163);
 	}
 
+	void test_capacity() {
+		Common::Array<int> array;
+		TS_ASSERT_EQUALS(array.capacity(), (unsigned int)0);
+
+		array.reserve(64);
+		TS_ASSERT_EQUALS(array.capacity(), (unsigned int)64);
+		TS_ASSERT_EQUALS(array.size(), (unsigned int)0);
+
+		// Shrinking keeps the storage
+		array.resize(10);
+		array.resize(1);
+		TS_ASSERT_EQUALS(array.capacity(), (unsigned int)64);
+
+		array.reserve(16);
+		TS_ASSERT_EQUALS(array.capacity(), (unsigned int)64);
+	}
+
+#ifdef USE_CXX11
+	struct MoveOnly {
+		int value;
+
+		explicit MoveOnly(int v) : value(v) {}
+		MoveOnly(MoveOnly &&old) : value(old.value) { old.value = -1; }
+		MoveOnly &operator=(MoveOnly &&old) { value = old.value; old.value = -1; return *this; }
+		MoveOnly(const MoveOnly &) = delete;
+		MoveOnly &operator=(const MoveOnly &) = delete;
+	};
+#endif
+
+	void test_emplace() {
+#ifdef USE_CXX11
+		// This will fail at compile time if growing the array copies the
+		// elements
+		Common::Array<MoveOnly> array;
+		for (int i = 0; i < 20; ++i)
+			array.emplace_back(i);
+		array.emplace(array.begin() + 5, 100);
+		array.push_back(MoveOnly(200));
+		array.emplace(array.begin(), 300);
+
+		TS_ASSERT_EQUALS(array.size(), 23U);
+		TS_ASSERT_EQUALS(array[0].value, 300);
+		TS_ASSERT_EQUALS(array[5].value, 4);
+		TS_ASSERT_EQUALS(array[6].value, 100);
+		TS_ASSERT_EQUALS(array[7].value, 5);
+		TS_ASSERT_EQUALS(array[21].value, 19);
+		TS_ASSERT_EQUALS(array[22].value, 200);
+#endif
+	}
+
+	void test_grow_strings() {
+		// Growing and inserting moves the strings around, their content has
+		// to stay intact, as well as the content of the inserted copies
+		Common::Array<Common::String> array;
+		for (int i = 0; i < 40; ++i)
+			array.push_back(Common::String::format("a string too long for the internal storage %d", i));
+		array.insert_at(3, array[30]);
+		array.push_back(Common::String("short"));
+
+		TS_ASSERT_EQUALS(array.size(), 42U);
+		TS_ASSERT_EQUALS(array[2], "a string too long for the internal storage 2");
+		TS_ASSERT_EQUALS(array[3], "a string too long for the internal storage 30");
+		TS_ASSERT_EQUALS(array[4], "a string too long for the internal storage 3");
+		TS_ASSERT_EQUALS(array[40], "a string too long for the internal storage 39");
+		TS_ASSERT_EQUALS(array[41], "short");
+	}
+
 };
 
 struct ListElement {
@@ -0,0 +1,76 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "common/events.h"
+
+class UnmappedEventSource : public Common::ArtificialEventSource {
+public:
+	bool allowMapping() const override { return false; }
+};
+
+class RecordingEventObserver : public Common::EventObserver {
+public:
+	Common::Array<Common::Event> events;
+
+	bool notifyEvent(const Common::Event &event) override {
+		events.push_back(event);
+		return true;
+	}
+};
+
+class EventDispatcherTestSuite : public CxxTest::TestSuite {
+	static Common::Event mouseMove(int16 x, int16 y, int16 relX, int16 relY) {
+		Common::Event event;
+		event.type = Common::EVENT_MOUSEMOVE;
+		event.mouse = Common::Point(x, y);
+		event.relMouse = Common::Point(relX, relY);
+		return event;
+	}
+
+	static Common::Event joyAxis(byte axis, int16 position) {
+		Common::Event event;
+		event.type = Common::EVENT_JOYAXIS_MOTION;
+		event.joystick.axis = axis;
+		event.joystick.position = position;
+		return event;
+	}
+
+public:
+	void test_coalesce_motion() {
+		Common::EventDispatcher dispatcher;
+		UnmappedEventSource source;
+		RecordingEventObserver observer;
+		dispatcher.registerSource(&source, false);
+		dispatcher.registerObserver(&observer, 0, false);
+
+		Common::Event keyDown;
+		keyDown.type = Common::EVENT_KEYDOWN;
+		keyDown.kbd = Common::KeyState(Common::KEYCODE_a);
+
+		source.addEvent(mouseMove(10, 10, 1, 1));
+		source.addEvent(mouseMove(12, 11, 2, 1));
+		source.addEvent(mouseMove(15, 13, 3, 2));
+		source.addEvent(keyDown);
+		source.addEvent(mouseMove(16, 13, 1, 0));
+		source.addEvent(joyAxis(0, 100));
+		source.addEvent(joyAxis(0, 200));
+		source.addEvent(joyAxis(1, 300));
+		dispatcher.dispatch();
+
+		// Consecutive motions are merged, the other events keep their order
+		TS_ASSERT_EQUALS(observer.events.size(), 5u);
+		TS_ASSERT_EQUALS(observer.events[0].type, Common::EVENT_MOUSEMOVE);
+		TS_ASSERT_EQUALS(observer.events[0].mouse, Common::Point(15, 13));
+		TS_ASSERT_EQUALS(observer.events[0].relMouse, Common::Point(6, 4));
+		TS_ASSERT_EQUALS(observer.events[1].type, Common::EVENT_KEYDOWN);
+		TS_ASSERT_EQUALS(observer.events[2].mouse, Common::Point(16, 13));
+		TS_ASSERT_EQUALS(observer.events[3].type, Common::EVENT_JOYAXIS_MOTION);
+		TS_ASSERT_EQUALS(observer.events[3].joystick.axis, 0);
+		TS_ASSERT_EQUALS(observer.events[3].joystick.position, 200);
+		TS_ASSERT_EQUALS(observer.events[4].joystick.axis, 1);
+		TS_ASSERT_EQUALS(observer.events[4].joystick.position, 300);
+
+		dispatcher.unregisterObserver(&observer);
+		dispatcher.unregisterSource(&source);
+	}
+};
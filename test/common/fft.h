@@ -0,0 +1,66 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/fft.h"
+#include "common/mdct.h"
+
+#include <math.h>
+
+class FFTTestSuite : public CxxTest::TestSuite {
+public:
+	void test_fft() {
+		for (int bits = 2; bits <= 10; bits++) {
+			const int n = 1 << bits;
+			Common::Complex *input = new Common::Complex[n];
+			Common::Complex *output = new Common::Complex[n];
+			for (int i = 0; i < n; i++) {
+				input[i].re = sin(i * 0.37) + 0.1 * i / n;
+				input[i].im = cos(i * 1.3) * 0.5;
+			}
+
+			for (int inverse = 0; inverse < 2; inverse++) {
+				memcpy(output, input, n * sizeof(Common::Complex));
+				Common::FFT fft(bits, inverse);
+				fft.permute(output);
+				fft.calc(output);
+
+				// Compare with the discrete Fourier transform
+				for (int k = 0; k < n; k++) {
+					double re = 0, im = 0;
+					for (int j = 0; j < n; j++) {
+						const double angle = (inverse ? 2 : -2) * M_PI * j * k / n;
+						re += input[j].re * cos(angle) - input[j].im * sin(angle);
+						im += input[j].re * sin(angle) + input[j].im * cos(angle);
+					}
+					TS_ASSERT_DELTA(output[k].re, re, 1e-4);
+					TS_ASSERT_DELTA(output[k].im, im, 1e-4);
+				}
+			}
+
+			delete[] output;
+			delete[] input;
+		}
+	}
+
+	void test_imdct() {
+		for (int bits = 4; bits <= 10; bits++) {
+			const int n = 1 << bits;
+			float *input = new float[n / 2];
+			float *output = new float[n];
+			for (int k = 0; k < n / 2; k++)
+				input[k] = sin(k * 0.7) + 0.3;
+
+			Common::MDCT mdct(bits, true, 1.0);
+			mdct.calcIMDCT(output, input);
+
+			for (int i = 0; i < n; i++) {
+				double sum = 0;
+				for (int k = 0; k < n / 2; k++)
+					sum -= input[k] * cos(2 * M_PI / n * (i + 0.5 + n / 4.0) * (k + 0.5));
+				TS_ASSERT_DELTA(output[i], sum, 1e-4);
+			}
+
+			delete[] output;
+			delete[] input;
+		}
+	}
+};
@@ -0,0 +1,71 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/framearena.h"
+#include "common/str.h"
+
+class FrameArenaTestSuite : public CxxTest::TestSuite {
+public:
+	void test_allocate() {
+		Common::FrameArena arena(256);
+
+		byte *a = (byte *)arena.allocate(10, 1);
+		byte *b = (byte *)arena.allocate(10, 1);
+		TS_ASSERT_EQUALS(b, a + 10);
+		TS_ASSERT_EQUALS(arena.getUsed(), 20U);
+
+		uint32 *c = (uint32 *)arena.allocate(sizeof(uint32) * 4, 16);
+		TS_ASSERT_EQUALS((size_t)c % 16, 0U);
+		TS_ASSERT_EQUALS(arena.getBlockAllocations(), 1U);
+	}
+
+	void test_reset_merges_blocks() {
+		Common::FrameArena arena(64);
+
+		// The first frame needs more than the first block
+		for (int i = 0; i < 10; ++i)
+			memset(arena.allocate(50), i, 50);
+		const uint32 blocks = arena.getBlockAllocations();
+		TS_ASSERT(blocks > 1);
+		const size_t used = arena.getUsed();
+		arena.reset();
+		TS_ASSERT_EQUALS(arena.getUsed(), 0U);
+		TS_ASSERT_EQUALS(arena.getHighWaterMark(), used);
+		TS_ASSERT_EQUALS(arena.getBlockAllocations(), blocks + 1);
+
+		// The same frame again fits in the merged block
+		for (int frame = 0; frame < 3; ++frame) {
+			for (int i = 0; i < 10; ++i)
+				memset(arena.allocate(50), i, 50);
+			arena.reset();
+		}
+		TS_ASSERT_EQUALS(arena.getBlockAllocations(), blocks + 1);
+	}
+
+	void test_large_allocation() {
+		Common::FrameArena arena(64);
+		byte *big = (byte *)arena.allocate(1000);
+		memset(big, 0, 1000);
+		TS_ASSERT(arena.getCapacity() >= 1000U);
+	}
+
+	void test_arena_array() {
+		Common::FrameArena arena(128);
+		{
+			Common::ArenaArray<Common::String> array(arena);
+			for (int i = 0; i < 40; ++i)
+				array.push_back(Common::String::format("a string too long for the internal storage %d", i));
+			TS_ASSERT_EQUALS(array.size(), 40U);
+			TS_ASSERT_EQUALS(array[0], "a string too long for the internal storage 0");
+			TS_ASSERT_EQUALS(array[39], "a string too long for the internal storage 39");
+
+			int count = 0;
+			for (Common::ArenaArray<Common::String>::const_iterator i = array.begin(); i != array.end(); ++i)
+				count++;
+			TS_ASSERT_EQUALS(count, 40);
+
+			array.pop_back();
+			TS_ASSERT_EQUALS(array.size(), 39U);
+		}
+		arena.reset();
+	}
+};
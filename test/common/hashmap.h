@@ -230,5 +230,58 @@ class HashMapTestSuite : public CxxTest::TestSuite
 		TS_ASSERT(found == 16+8+4);
 }
 
+	struct CollidingHash {
+		uint operator()(int x) const { return x & 3; }
+	};
+
+	void test_colliding_hashes() {
+		// Many keys share the same hash, so the keys themselves have to be
+		// compared when the cached hashes match
+		Common::HashMap<int, int, CollidingHash> container;
+		for (int i = 0; i < 100; ++i)
+			container[i] = i * 2;
+		TS_ASSERT_EQUALS(container.size(), 100u);
+
+		for (int i = 0; i < 100; i += 3)
+			container.erase(i);
+		for (int i = 0; i < 100; ++i) {
+			TS_ASSERT_EQUALS(container.contains(i), (i % 3) != 0);
+			if (i % 3)
+				TS_ASSERT_EQUALS(container[i], i * 2);
+		}
+
+		Common::HashMap<int, int, CollidingHash> copy(container);
+		for (int i = 100; i < 200; ++i)
+			copy[i] = i * 2;
+		for (int i = 0; i < 200; ++i)
+			TS_ASSERT_EQUALS(copy.contains(i), i >= 100 || (i % 3) != 0);
+		TS_ASSERT(!container.contains(150));
+	}
+
+	void test_hashit_lower() {
+		// Only ASCII letters are folded, other characters hash unchanged
+		TS_ASSERT_EQUALS(Common::hashit_lower("Resource.MAP"), Common::hashit("resource.map"));
+		TS_ASSERT_EQUALS(Common::hashit_lower("@[`{09_"), Common::hashit("@[`{09_"));
+		TS_ASSERT_EQUALS(Common::hashit_lower("\xC4\xD6x"), Common::hashit("\xC4\xD6x"));
+		TS_ASSERT_EQUALS(Common::hashit_lower(""), Common::hashit(""));
+	}
+
+	void test_prehashed_lookup() {
+		Common::HashMap<Common::String, int, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> first, second;
+		first["Intro.VMD"] = 1;
+		second["intro.vmd"] = 2;
+		second["other.vmd"] = 3;
+
+		const Common::String name("INTRO.vmd");
+		const uint hash = Common::IgnoreCase_Hash()(name);
+		TS_ASSERT(first.contains(name, hash));
+		TS_ASSERT_EQUALS(first.find(name, hash)->_value, 1);
+		TS_ASSERT_EQUALS(second.find(name, hash)->_value, 2);
+
+		const Common::String missing("missing.vmd");
+		TS_ASSERT(!second.contains(missing, Common::IgnoreCase_Hash()(missing)));
+		TS_ASSERT(second.find(missing, Common::IgnoreCase_Hash()(missing)) == second.end());
+	}
+
 	// TODO: Add test cases for iterators, find, ...
 };
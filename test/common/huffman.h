@@ -94,4 +94,41 @@ class HuffmanTestSuite : public CxxTest::TestSuite {
 		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[5]);
 		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[6]);
 	}
+
+	void test_get_long_codes() {
+
+		/*
+		 * Codes longer than the 8 bit prefix table are looked up
+		 * separately, so use a unary-like code that goes past it:
+		 *
+		 * 0-7 = 0, 10, 110, ..., 11111110
+		 * 8   = 111111110
+		 * 9   = 11111111100
+		 * 10  = 11111111101
+		 * 11  = 11111111110
+		 * 12  = 11111111111
+		 *
+		 * The 11 bit codes are given out of order on purpose.
+		 */
+
+		uint32 codeCount = 13;
+		const uint8 lengths[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 11, 11, 11, 11};
+		const uint32 codes[]  = {0x0, 0x2, 0x6, 0xE, 0x1E, 0x3E, 0x7E, 0xFE, 0x1FE, 0x7FF, 0x7FE, 0x7FD, 0x7FC};
+		const uint32 symbols[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 11, 10, 9};
+
+		Common::Huffman<Common::BitStream8MSB> h(0, codeCount, codes, lengths, symbols);
+
+		/*
+		 * 11111111111 111111110 11111111100 0 11111111110 11111111101 10
+		 * = 12 8 9 0 11 10 1
+		 */
+		byte input[] = {0xFF, 0xFF, 0xEF, 0xF8, 0xFF, 0xDF, 0xF6};
+		uint32 expected[] = {12, 8, 9, 0, 11, 10, 1};
+
+		Common::MemoryReadStream ms(input, sizeof(input));
+		Common::BitStream8MSB bs(ms);
+
+		for (int i = 0; i < ARRAYSIZE(expected); i++)
+			TS_ASSERT_EQUALS(h.getSymbol(bs), expected[i]);
+	}
 };
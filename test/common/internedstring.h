@@ -0,0 +1,60 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/internedstring.h"
+
+class InternedStringTestSuite : public CxxTest::TestSuite {
+	public:
+	void test_identity() {
+		Common::InternedStringPool pool;
+		Common::InternedString a = pool.intern("actor");
+		Common::InternedString b = pool.intern(Common::String("act") + "or");
+		Common::InternedString c = pool.intern("Actor");
+
+		TS_ASSERT(a == b);
+		TS_ASSERT(a != c);
+		TS_ASSERT_EQUALS(a.c_str(), b.c_str());
+		TS_ASSERT_EQUALS(a.toString(), "actor");
+		TS_ASSERT_EQUALS(a.hash(), Common::String("actor").hash());
+		TS_ASSERT_EQUALS(pool.size(), 2U);
+	}
+
+	void test_empty() {
+		Common::InternedStringPool pool;
+		Common::InternedString empty;
+
+		TS_ASSERT(empty.empty());
+		TS_ASSERT(pool.intern("") == empty);
+		TS_ASSERT_EQUALS(empty.toString(), "");
+		TS_ASSERT_EQUALS(empty.hash(), Common::String().hash());
+		TS_ASSERT_EQUALS(pool.size(), 0U);
+	}
+
+	void test_find() {
+		Common::InternedStringPool pool;
+		Common::InternedString a = pool.intern("room");
+
+		TS_ASSERT(pool.find("room") == a);
+		TS_ASSERT(pool.find("door").empty());
+		TS_ASSERT_EQUALS(pool.size(), 1U);
+	}
+
+	void test_global_pool() {
+		Common::InternedString a("music_volume");
+		Common::InternedString b(Common::String("music_volume"));
+
+		TS_ASSERT(a == b);
+		TS_ASSERT(Common::InternedStringPool::global().find("music_volume") == a);
+	}
+
+	void test_hashmap_key() {
+		Common::InternedStringPool pool;
+		Common::HashMap<Common::InternedString, int> map;
+
+		map[pool.intern("x")] = 1;
+		map[pool.intern("y")] = 2;
+
+		TS_ASSERT_EQUALS(map[pool.intern("x")], 1);
+		TS_ASSERT_EQUALS(map[pool.intern("y")], 2);
+		TS_ASSERT(!map.contains(pool.intern("z")));
+	}
+};
@@ -0,0 +1,89 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/intrusivelist.h"
+
+struct OtherListTag {};
+
+struct IntrusiveItem : public Common::IntrusiveListNode<>, public Common::IntrusiveListNode<OtherListTag> {
+	int _value;
+
+	IntrusiveItem(int value) : _value(value) {}
+};
+
+class IntrusiveListTestSuite : public CxxTest::TestSuite
+{
+	public:
+	void test_push_pop() {
+		Common::IntrusiveList<IntrusiveItem> list;
+		IntrusiveItem a(1), b(2), c(3);
+
+		TS_ASSERT(list.empty());
+		list.push_back(b);
+		list.push_back(c);
+		list.push_front(a);
+		TS_ASSERT_EQUALS(list.size(), 3u);
+		TS_ASSERT_EQUALS(list.front()._value, 1);
+		TS_ASSERT_EQUALS(list.back()._value, 3);
+
+		list.pop_front();
+		TS_ASSERT(!a.Common::IntrusiveListNode<>::isLinked());
+		list.pop_back();
+		TS_ASSERT_EQUALS(list.size(), 1u);
+		TS_ASSERT_EQUALS(list.front()._value, 2);
+	}
+
+	void test_iterate_erase() {
+		Common::IntrusiveList<IntrusiveItem> list;
+		IntrusiveItem a(1), b(2), c(3);
+		list.push_back(a);
+		list.push_back(b);
+		list.push_back(c);
+
+		int sum = 0;
+		for (Common::IntrusiveList<IntrusiveItem>::const_iterator i = list.begin(); i != list.end(); ++i)
+			sum += i->_value;
+		TS_ASSERT_EQUALS(sum, 6);
+
+		Common::IntrusiveList<IntrusiveItem>::iterator i = list.begin();
+		++i;
+		i = list.erase(i);
+		TS_ASSERT_EQUALS(i->_value, 3);
+		TS_ASSERT_EQUALS(list.size(), 2u);
+
+		list.remove(a);
+		TS_ASSERT_EQUALS(list.front()._value, 3);
+	}
+
+	void test_self_unlink() {
+		Common::IntrusiveList<IntrusiveItem> list;
+		IntrusiveItem a(1);
+		{
+			IntrusiveItem b(2);
+			list.push_back(a);
+			list.push_back(b);
+		}
+		// b unlinked itself when it went out of scope
+		TS_ASSERT_EQUALS(list.size(), 1u);
+		TS_ASSERT_EQUALS(list.back()._value, 1);
+
+		list.clear();
+		TS_ASSERT(list.empty());
+		TS_ASSERT(!a.Common::IntrusiveListNode<>::isLinked());
+	}
+
+	void test_several_lists() {
+		Common::IntrusiveList<IntrusiveItem> list;
+		Common::IntrusiveList<IntrusiveItem, OtherListTag> otherList;
+		IntrusiveItem a(1), b(2);
+
+		list.push_back(a);
+		list.push_back(b);
+		otherList.push_back(b);
+
+		TS_ASSERT_EQUALS(list.size(), 2u);
+		TS_ASSERT_EQUALS(otherList.size(), 1u);
+
+		list.remove(b);
+		TS_ASSERT_EQUALS(otherList.front()._value, 2);
+	}
+};
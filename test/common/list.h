@@ -272,4 +272,31 @@ class ListTestSuite : public CxxTest::TestSuite
 		TS_ASSERT_EQUALS(container.front(), 99);
 		TS_ASSERT_EQUALS(container.back(),  99);
 	}
+
+	void test_node_reuse() {
+		Common::List<Common::List<int> > container;
+		Common::List<int> element;
+		element.push_back(17);
+
+		container.push_back(element);
+		container.push_back(element);
+		container.pop_front();
+		container.clear();
+
+		// Nodes kept from the erased elements must hold fresh values
+		element.push_back(33);
+		container.push_back(element);
+		element.clear();
+		container.push_back(element);
+		container.push_back(element);
+		TS_ASSERT_EQUALS(container.size(), 3u);
+		TS_ASSERT_EQUALS(container.front().size(), 2u);
+		TS_ASSERT_EQUALS(container.front().back(), 33);
+		TS_ASSERT(container.back().empty());
+
+		container.freeUnusedNodes();
+		container.pop_front();
+		container.freeUnusedNodes();
+		TS_ASSERT_EQUALS(container.size(), 2u);
+	}
 };
@@ -0,0 +1,155 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/macresman.h"
+#include "common/memstream.h"
+
+namespace {
+
+/** An archive holding a raw resource fork with two types of resources. */
+class ResForkArchive : public Common::Archive {
+public:
+	mutable Common::MemoryWriteStreamDynamic _fork;
+
+	ResForkArchive() : _fork(DisposeAfterUse::YES) {
+		// Header
+		_fork.writeUint32BE(16); // data offset
+		_fork.writeUint32BE(36); // map offset
+		_fork.writeUint32BE(20); // data length
+		_fork.writeUint32BE(94); // map length
+
+		// Data
+		writeData("abc");
+		writeData("de");
+		writeData("xyz");
+
+		// Map header, with the type list at 28 and the name list at 82
+		for (int i = 0; i < 22; i++)
+			_fork.writeByte(0);
+		_fork.writeUint16BE(0);
+		_fork.writeUint16BE(28);
+		_fork.writeUint16BE(82);
+		_fork.writeUint16BE(1); // two types
+
+		// Types, with their references at 46 and 70
+		_fork.writeUint32BE(MKTAG('T', 'E', 'S', 'T'));
+		_fork.writeUint16BE(1); // two resources
+		_fork.writeUint16BE(18);
+		_fork.writeUint32BE(MKTAG('S', 'T', 'R', ' '));
+		_fork.writeUint16BE(0); // one resource
+		_fork.writeUint16BE(42);
+
+		// References
+		writeReference(128, 0, 0);
+		writeReference(129, 0xFFFF, 7);
+		writeReference(128, 6, 13);
+
+		// Names
+		writeName("First");
+		writeName("First");
+	}
+
+	void writeData(const char *data) {
+		_fork.writeUint32BE(strlen(data));
+		_fork.write(data, strlen(data));
+	}
+
+	void writeReference(uint16 id, uint16 nameOffset, uint32 dataOffset) {
+		_fork.writeUint16BE(id);
+		_fork.writeUint16BE(nameOffset);
+		_fork.writeUint32BE(dataOffset);
+		_fork.writeUint32BE(0);
+	}
+
+	void writeName(const char *name) {
+		_fork.writeByte(strlen(name));
+		_fork.write(name, strlen(name));
+	}
+
+	bool hasFile(const Common::String &name) const override {
+		return name.equalsIgnoreCase("test.rsrc");
+	}
+
+	int listMembers(Common::ArchiveMemberList &list) const override {
+		list.push_back(getMember("test.rsrc"));
+		return 1;
+	}
+
+	const Common::ArchiveMemberPtr getMember(const Common::String &name) const override {
+		return Common::ArchiveMemberPtr(new Common::GenericArchiveMember(name, this));
+	}
+
+	Common::SeekableReadStream *createReadStreamForMember(const Common::String &name) const override {
+		if (!hasFile(name))
+			return nullptr;
+		return new Common::MemoryReadStream(_fork.getData(), _fork.size());
+	}
+};
+
+Common::String readResource(Common::SeekableReadStream *stream) {
+	if (!stream)
+		return "<none>";
+
+	Common::String str = stream->readString(0, stream->size());
+	delete stream;
+	return str;
+}
+
+} // End of anonymous namespace
+
+class MacResManagerTestSuite : public CxxTest::TestSuite {
+public:
+	void test_lookups() {
+		ResForkArchive archive;
+		Common::MacResManager resMan;
+		TS_ASSERT(resMan.open("test", archive));
+		TS_ASSERT(resMan.hasResFork());
+
+		TS_ASSERT_EQUALS(readResource(resMan.getResource(MKTAG('T', 'E', 'S', 'T'), 128)), "abc");
+		TS_ASSERT_EQUALS(readResource(resMan.getResource(MKTAG('T', 'E', 'S', 'T'), 129)), "de");
+		TS_ASSERT_EQUALS(readResource(resMan.getResource(MKTAG('S', 'T', 'R', ' '), 128)), "xyz");
+		TS_ASSERT(!resMan.getResource(MKTAG('S', 'T', 'R', ' '), 129));
+		TS_ASSERT(!resMan.getResource(MKTAG('N', 'O', 'N', 'E'), 128));
+
+		TS_ASSERT_EQUALS(resMan.getResName(MKTAG('T', 'E', 'S', 'T'), 128), "First");
+		TS_ASSERT_EQUALS(resMan.getResName(MKTAG('T', 'E', 'S', 'T'), 130), "");
+
+		Common::MacResIDArray ids = resMan.getResIDArray(MKTAG('T', 'E', 'S', 'T'));
+		TS_ASSERT_EQUALS(ids.size(), 2U);
+		TS_ASSERT_EQUALS(ids[0], 128);
+		TS_ASSERT_EQUALS(ids[1], 129);
+		TS_ASSERT_EQUALS(resMan.getResTagArray().size(), 2U);
+	}
+
+	void test_name_lookups() {
+		ResForkArchive archive;
+		Common::MacResManager resMan;
+		TS_ASSERT(resMan.open("test", archive));
+
+		// Without a type, the first resource with the name is found
+		TS_ASSERT_EQUALS(readResource(resMan.getResource("first")), "abc");
+		TS_ASSERT_EQUALS(readResource(resMan.getResource(MKTAG('S', 'T', 'R', ' '), "FIRST")), "xyz");
+		TS_ASSERT(!resMan.getResource("second"));
+		TS_ASSERT(!resMan.getResource(MKTAG('N', 'O', 'N', 'E'), "First"));
+	}
+
+	void test_shared_map() {
+		ResForkArchive archive;
+		Common::MacResManager::clearMapCache();
+
+		Common::MacResManager *first = new Common::MacResManager();
+		Common::MacResManager second;
+		TS_ASSERT(first->open("test", archive));
+		TS_ASSERT(second.open("test", archive));
+
+		// The second manager keeps working with the map after the first closes
+		delete first;
+		TS_ASSERT_EQUALS(readResource(second.getResource(MKTAG('T', 'E', 'S', 'T'), 129)), "de");
+
+		Common::MacResManager::setMapCacheEnabled(false);
+		Common::MacResManager third;
+		TS_ASSERT(third.open("test", archive));
+		TS_ASSERT_EQUALS(readResource(third.getResource("First")), "abc");
+		Common::MacResManager::setMapCacheEnabled(true);
+	}
+};
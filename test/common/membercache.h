@@ -0,0 +1,91 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/membercache.h"
+#include "common/stream.h"
+
+class ArchiveMemberCacheTestSuite : public CxxTest::TestSuite {
+	static byte *makeData(uint32 size, byte value) {
+		byte *data = (byte *)malloc(size);
+		memset(data, value, size);
+		return data;
+	}
+
+public:
+	void test_lookup() {
+		Common::ArchiveMemberCache cache(1024);
+
+		TS_ASSERT(!cache.createReadStream("a.bin"));
+
+		Common::SeekableReadStream *added = cache.add("a.bin", makeData(100, 1), 100);
+		TS_ASSERT_EQUALS(added->size(), 100);
+		TS_ASSERT_EQUALS(added->readByte(), 1);
+		delete added;
+		TS_ASSERT_EQUALS(cache.size(), 100U);
+
+		// The names are not case sensitive, as in the archives
+		Common::SeekableReadStream *cached = cache.createReadStream("A.BIN");
+		TS_ASSERT(cached);
+		TS_ASSERT_EQUALS(cached->size(), 100);
+		cached->seek(99);
+		TS_ASSERT_EQUALS(cached->readByte(), 1);
+		delete cached;
+	}
+
+	void test_eviction() {
+		Common::ArchiveMemberCache cache(800);
+
+		delete cache.add("a", makeData(200, 1), 200);
+		delete cache.add("b", makeData(200, 2), 200);
+		delete cache.add("c", makeData(200, 3), 200);
+		delete cache.add("d", makeData(200, 4), 200);
+
+		// Using "a" makes "b" the least recently used member
+		delete cache.createReadStream("a");
+
+		// A stream keeps the data of an evicted member alive
+		Common::SeekableReadStream *b = cache.createReadStream("b");
+		delete cache.createReadStream("a");
+		delete cache.createReadStream("c");
+		delete cache.createReadStream("d");
+
+		delete cache.add("e", makeData(200, 5), 200);
+		TS_ASSERT(!cache.createReadStream("b"));
+		TS_ASSERT_EQUALS(cache.size(), 800U);
+		TS_ASSERT_EQUALS(b->readByte(), 2);
+		delete b;
+
+		Common::SeekableReadStream *a = cache.createReadStream("a");
+		TS_ASSERT(a);
+		TS_ASSERT_EQUALS(a->readByte(), 1);
+		delete a;
+	}
+
+	void test_large_member() {
+		Common::ArchiveMemberCache cache(1024);
+
+		Common::SeekableReadStream *stream = cache.add("big", makeData(512, 7), 512);
+		TS_ASSERT_EQUALS(stream->size(), 512);
+		TS_ASSERT_EQUALS(stream->readByte(), 7);
+		delete stream;
+
+		TS_ASSERT(!cache.createReadStream("big"));
+		TS_ASSERT_EQUALS(cache.size(), 0U);
+	}
+
+	void test_replace() {
+		Common::ArchiveMemberCache cache(1024);
+
+		delete cache.add("a", makeData(100, 1), 100);
+		delete cache.add("a", makeData(50, 2), 50);
+		TS_ASSERT_EQUALS(cache.size(), 50U);
+
+		Common::SeekableReadStream *a = cache.createReadStream("a");
+		TS_ASSERT_EQUALS(a->size(), 50);
+		TS_ASSERT_EQUALS(a->readByte(), 2);
+		delete a;
+
+		cache.clear();
+		TS_ASSERT(!cache.createReadStream("a"));
+		TS_ASSERT_EQUALS(cache.size(), 0U);
+	}
+};
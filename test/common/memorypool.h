@@ -0,0 +1,90 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memorypool.h"
+
+class MemoryPoolTestSuite : public CxxTest::TestSuite {
+public:
+	void test_object_pool() {
+		Common::ObjectPool<int, 2> pool;
+		int *a = new (pool) int(1);
+		int *b = new (pool) int(2);
+		int *c = new (pool) int(3);
+		TS_ASSERT_EQUALS(*a + *b + *c, 6);
+
+		pool.deleteChunk(b);
+		int *d = new (pool) int(4);
+		// The last freed chunk is reused first
+		TS_ASSERT_EQUALS(d, b);
+
+		pool.deleteChunk(a);
+		pool.deleteChunk(c);
+		pool.deleteChunk(d);
+		pool.freeUnusedPages();
+	}
+
+	void test_small_object_allocator() {
+		Common::SmallObjectAllocator allocator;
+
+		void *small = allocator.allocate(1);
+		void *medium = allocator.allocate(Common::SmallObjectAllocator::kGranularity + 1);
+		void *medium2 = allocator.allocate(2 * Common::SmallObjectAllocator::kGranularity);
+		void *large = allocator.allocate(Common::SmallObjectAllocator::kMaxChunkSize + 1);
+		TS_ASSERT(small && medium && medium2 && large);
+		TS_ASSERT_EQUALS((size_t)medium2 % Common::SmallObjectAllocator::kGranularity, 0U);
+		memset(large, 0, Common::SmallObjectAllocator::kMaxChunkSize + 1);
+
+		Common::SmallObjectAllocator::Stats stats = allocator.getStats(1);
+		TS_ASSERT_EQUALS(stats.chunkSize, 2U * Common::SmallObjectAllocator::kGranularity);
+		TS_ASSERT_EQUALS(stats.allocations, 2U);
+		TS_ASSERT_EQUALS(stats.live, 2U);
+
+		allocator.deallocate(medium, Common::SmallObjectAllocator::kGranularity + 1);
+		allocator.deallocate(large, Common::SmallObjectAllocator::kMaxChunkSize + 1);
+		void *medium3 = allocator.allocate(20);
+		TS_ASSERT_EQUALS(medium3, medium);
+
+		stats = allocator.getStats(1);
+		TS_ASSERT_EQUALS(stats.allocations, 3U);
+		TS_ASSERT_EQUALS(stats.live, 2U);
+		TS_ASSERT_EQUALS(stats.peak, 2U);
+
+		stats = allocator.getStats(Common::SmallObjectAllocator::kNumSizeClasses);
+		TS_ASSERT_EQUALS(stats.chunkSize, 0U);
+		TS_ASSERT_EQUALS(stats.allocations, 1U);
+		TS_ASSERT_EQUALS(stats.live, 0U);
+
+		allocator.deallocate(small, 1);
+		allocator.deallocate(medium2, 2 * Common::SmallObjectAllocator::kGranularity);
+		allocator.deallocate(medium3, 20);
+		allocator.freeUnusedPages();
+		TS_ASSERT_EQUALS(allocator.getStats(0).live, 0U);
+	}
+
+	struct Base : public Common::SmallObject {
+		virtual ~Base() {}
+		int _value;
+	};
+
+	struct Derived : public Base {
+		byte _padding[100];
+	};
+
+	void test_small_object() {
+		Common::SmallObjectAllocator &shared = Common::SmallObjectAllocator::getShared();
+		const uint baseClass = (sizeof(Base) - 1) / Common::SmallObjectAllocator::kGranularity;
+		const uint derivedClass = (sizeof(Derived) - 1) / Common::SmallObjectAllocator::kGranularity;
+		const uint32 baseLive = shared.getStats(baseClass).live;
+		const uint32 derivedLive = shared.getStats(derivedClass).live;
+
+		Base *base = new Base();
+		Base *derived = new Derived();
+		TS_ASSERT_EQUALS(shared.getStats(derivedClass).live, derivedLive + (baseClass == derivedClass ? 2 : 1));
+
+		// Deleting through the base class returns the block to the class
+		// of the real object
+		delete derived;
+		delete base;
+		TS_ASSERT_EQUALS(shared.getStats(baseClass).live, baseLive);
+		TS_ASSERT_EQUALS(shared.getStats(derivedClass).live, derivedLive);
+	}
+};
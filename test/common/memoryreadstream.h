@@ -104,4 +104,19 @@ class MemoryReadStreamTestSuite : public CxxTest::TestSuite {
 		ms.seek(0, SEEK_SET);
 		TS_ASSERT(!ms.eos());
 	}
+
+	void test_read_in_place() {
+		byte contents[] = { 'a', 'b', 'c', 'd', 'e' };
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+
+		ms.seek(1);
+		const byte *data = ms.readInPlace(3);
+		TS_ASSERT_EQUALS(data, contents + 1);
+		TS_ASSERT_EQUALS(ms.pos(), 4);
+
+		// Not enough data left: the stream must not move
+		TS_ASSERT(!ms.readInPlace(2));
+		TS_ASSERT_EQUALS(ms.pos(), 4);
+		TS_ASSERT(!ms.eos());
+	}
 };
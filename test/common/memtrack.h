@@ -0,0 +1,57 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memtrack.h"
+
+static const char *const kMemTrackTestLua = "lua";
+static const char *const kMemTrackTestResources = "resources";
+
+class MemoryTrackerTestSuite : public CxxTest::TestSuite {
+public:
+	void test_current_and_peak() {
+		Common::MemoryTracker tracker;
+		const int lua = tracker.getTag(kMemTrackTestLua);
+		const int resources = tracker.getTag(kMemTrackTestResources);
+		TS_ASSERT_EQUALS(tracker.getTag(kMemTrackTestLua), lua);
+
+		tracker.allocated(lua, 1000);
+		tracker.allocated(lua, 500);
+		tracker.freed(lua, 1000);
+		tracker.setUsage(resources, 4000);
+		tracker.setUsage(resources, 3000);
+
+		TS_ASSERT_EQUALS(tracker.getTotal(), 3500u);
+		TS_ASSERT_EQUALS(tracker.getPeakTotal(), 4500u);
+
+		// The largest current amount comes first
+		Common::Array<Common::MemoryTracker::TagStats> stats;
+		tracker.getStats(stats);
+		TS_ASSERT_EQUALS(stats.size(), 2u);
+		TS_ASSERT_EQUALS(stats[0].name, kMemTrackTestResources);
+		TS_ASSERT_EQUALS(stats[0].current, 3000u);
+		TS_ASSERT_EQUALS(stats[0].peak, 4000u);
+		TS_ASSERT_EQUALS(stats[1].name, kMemTrackTestLua);
+		TS_ASSERT_EQUALS(stats[1].current, 500u);
+		TS_ASSERT_EQUALS(stats[1].peak, 1500u);
+
+		tracker.resetPeaks();
+		TS_ASSERT_EQUALS(tracker.getPeakTotal(), 3500u);
+	}
+
+	void test_scopes() {
+		Common::MemoryTracker &tracker = Common::MemoryTracker::instance();
+		const int lua = tracker.getTag(kMemTrackTestLua);
+		const int resources = tracker.getTag(kMemTrackTestResources);
+
+		TS_ASSERT_EQUALS(tracker.getCurrentTag(kMemTrackTestLua), lua);
+		{
+			Common::MemoryTag outer(kMemTrackTestResources);
+			TS_ASSERT_EQUALS(tracker.getCurrentTag(kMemTrackTestLua), resources);
+			{
+				Common::MemoryTag inner(kMemTrackTestLua);
+				TS_ASSERT_EQUALS(tracker.getCurrentTag(kMemTrackTestResources), lua);
+			}
+			TS_ASSERT_EQUALS(tracker.getCurrentTag(kMemTrackTestLua), resources);
+		}
+		TS_ASSERT_EQUALS(tracker.getCurrentTag(kMemTrackTestResources), resources);
+	}
+};
@@ -0,0 +1,74 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/profiler.h"
+
+static const char *const kProfilerTestFrame = "frame";
+static const char *const kProfilerTestDraw = "draw";
+static const char *const kProfilerTestScripts = "scripts";
+
+class ProfilerTestSuite : public CxxTest::TestSuite {
+public:
+	void test_hierarchy() {
+		Common::Profiler profiler;
+
+		for (int i = 0; i < 2; ++i) {
+			profiler.enterZone(kProfilerTestFrame);
+			profiler.enterZone(kProfilerTestScripts);
+			profiler.leaveZone(100);
+			profiler.enterZone(kProfilerTestDraw);
+			profiler.leaveZone(300);
+			profiler.enterZone(kProfilerTestDraw);
+			profiler.leaveZone(200);
+			profiler.leaveZone(1000);
+			profiler.endFrame();
+		}
+
+		Common::Array<Common::Profiler::ZoneStats> stats;
+		profiler.getStats(10, stats);
+		TS_ASSERT_EQUALS(profiler.getFrameCount(), 2u);
+		TS_ASSERT_EQUALS(stats.size(), 3u);
+
+		TS_ASSERT_EQUALS(stats[0].name, kProfilerTestFrame);
+		TS_ASSERT_EQUALS(stats[0].depth, 0u);
+		TS_ASSERT_EQUALS(stats[0].totalMicros, 2000u);
+		TS_ASSERT_EQUALS(stats[0].selfMicros, 800u);
+		TS_ASSERT_EQUALS(stats[0].calls, 2u);
+
+		// The slowest child comes first
+		TS_ASSERT_EQUALS(stats[1].name, kProfilerTestDraw);
+		TS_ASSERT_EQUALS(stats[1].depth, 1u);
+		TS_ASSERT_EQUALS(stats[1].totalMicros, 1000u);
+		TS_ASSERT_EQUALS(stats[1].calls, 4u);
+		TS_ASSERT_EQUALS(stats[2].name, kProfilerTestScripts);
+		TS_ASSERT_EQUALS(stats[2].totalMicros, 200u);
+	}
+
+	void test_last_frames() {
+		Common::Profiler profiler;
+
+		profiler.enterZone(kProfilerTestDraw);
+		profiler.leaveZone(500);
+		profiler.endFrame();
+
+		profiler.enterZone(kProfilerTestScripts);
+		profiler.leaveZone(50);
+		profiler.endFrame();
+
+		// Only the zones of the last frame are counted
+		Common::Array<Common::Profiler::ZoneStats> stats;
+		profiler.getStats(1, stats);
+		TS_ASSERT_EQUALS(stats.size(), 1u);
+		TS_ASSERT_EQUALS(stats[0].name, kProfilerTestScripts);
+		TS_ASSERT_EQUALS(stats[0].totalMicros, 50u);
+
+		// The oldest frames are forgotten
+		for (uint i = 0; i < Common::Profiler::kMaxFrames; ++i)
+			profiler.endFrame();
+		profiler.getStats(Common::Profiler::kMaxFrames * 2, stats);
+		TS_ASSERT_EQUALS(profiler.getFrameCount(), (uint)Common::Profiler::kMaxFrames);
+		TS_ASSERT(stats.empty());
+
+		profiler.reset();
+		TS_ASSERT_EQUALS(profiler.getFrameCount(), 0u);
+	}
+};
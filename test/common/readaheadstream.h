@@ -0,0 +1,106 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/bufferedstream.h"
+
+#include "../null_osystem.h"
+
+class ReadAheadStreamTestSuite : public CxxTest::TestSuite {
+	public:
+	void test_traverse() {
+		Common::install_null_g_system();
+
+		byte contents[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		Common::MemoryReadStream ms(contents, 10);
+
+		Common::SeekableReadStream &rs
+			= *Common::wrapReadAheadSeekableReadStream(&ms, 4, 2, DisposeAfterUse::NO);
+
+		byte i, b;
+		for (i = 0; i < 10; ++i) {
+			TS_ASSERT(!rs.eos());
+
+			TS_ASSERT_EQUALS(i, rs.pos());
+
+			rs.read(&b, 1);
+			TS_ASSERT_EQUALS(i, b);
+		}
+
+		TS_ASSERT(!rs.eos());
+
+		TS_ASSERT_EQUALS((uint)0, rs.read(&b, 1));
+		TS_ASSERT(rs.eos());
+
+		delete &rs;
+	}
+
+	void test_large_reads() {
+		Common::install_null_g_system();
+
+		byte contents[1000];
+		for (int i = 0; i < 1000; ++i)
+			contents[i] = (byte)(i * 7);
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+
+		Common::ReadStream *rs = Common::wrapReadAheadReadStream(&ms, 64, 3, DisposeAfterUse::NO);
+
+		byte buf[300];
+		TS_ASSERT_EQUALS(rs->read(buf, 300), 300U);
+		TS_ASSERT_EQUALS(memcmp(buf, contents, 300), 0);
+		TS_ASSERT_EQUALS(rs->read(buf, 300), 300U);
+		TS_ASSERT_EQUALS(memcmp(buf, contents + 300, 300), 0);
+		TS_ASSERT_EQUALS(rs->read(buf, 300), 300U);
+		TS_ASSERT_EQUALS(memcmp(buf, contents + 600, 300), 0);
+		TS_ASSERT_EQUALS(rs->read(buf, 300), 100U);
+		TS_ASSERT_EQUALS(memcmp(buf, contents + 900, 100), 0);
+		TS_ASSERT(rs->eos());
+
+		delete rs;
+	}
+
+	void test_seek() {
+		Common::install_null_g_system();
+
+		byte contents[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		Common::MemoryReadStream ms(contents, 10);
+
+		Common::SeekableReadStream &rs
+			= *Common::wrapReadAheadSeekableReadStream(&ms, 4, 4, DisposeAfterUse::NO);
+		byte b;
+
+		TS_ASSERT_EQUALS(rs.pos(), 0);
+
+		rs.seek(1, SEEK_SET);
+		TS_ASSERT_EQUALS(rs.pos(), 1);
+		b = rs.readByte();
+		TS_ASSERT_EQUALS(b, 1);
+
+		rs.seek(5, SEEK_CUR);
+		TS_ASSERT_EQUALS(rs.pos(), 7);
+		b = rs.readByte();
+		TS_ASSERT_EQUALS(b, 7);
+
+		rs.seek(-3, SEEK_CUR);
+		TS_ASSERT_EQUALS(rs.pos(), 5);
+		b = rs.readByte();
+		TS_ASSERT_EQUALS(b, 5);
+
+		rs.seek(0, SEEK_END);
+		TS_ASSERT_EQUALS(rs.pos(), 10);
+		TS_ASSERT(!rs.eos());
+		b = rs.readByte();
+		TS_ASSERT(rs.eos());
+
+		rs.seek(-8, SEEK_END);
+		TS_ASSERT_EQUALS(rs.pos(), 2);
+		b = rs.readByte();
+		TS_ASSERT_EQUALS(b, 2);
+
+		rs.seek(0, SEEK_SET);
+		TS_ASSERT_EQUALS(rs.pos(), 0);
+		b = rs.readByte();
+		TS_ASSERT_EQUALS(b, 0);
+
+		delete &rs;
+	}
+};
@@ -0,0 +1,131 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/memstream.h"
+
+namespace {
+
+/** An archive holding a fixed set of empty files, which counts its lookups. */
+class CountingArchive : public Common::Archive {
+public:
+	Common::StringArray _files;
+	mutable int _lookups;
+
+	CountingArchive() : _lookups(0) {}
+
+	bool hasFile(const Common::String &name) const override {
+		++_lookups;
+		for (uint i = 0; i < _files.size(); ++i) {
+			if (_files[i].equalsIgnoreCase(name))
+				return true;
+		}
+		return false;
+	}
+
+	int listMembers(Common::ArchiveMemberList &list) const override {
+		for (uint i = 0; i < _files.size(); ++i)
+			list.push_back(Common::ArchiveMemberPtr(new Common::GenericArchiveMember(_files[i], this)));
+		return _files.size();
+	}
+
+	const Common::ArchiveMemberPtr getMember(const Common::String &name) const override {
+		return Common::ArchiveMemberPtr(new Common::GenericArchiveMember(name, this));
+	}
+
+	Common::SeekableReadStream *createReadStreamForMember(const Common::String &name) const override {
+		if (!hasFile(name))
+			return nullptr;
+		return new Common::MemoryReadStream(nullptr, 0);
+	}
+};
+
+} // End of anonymous namespace
+
+class SearchSetTestSuite : public CxxTest::TestSuite {
+	public:
+	void test_uncached() {
+		Common::SearchSet set;
+		CountingArchive *a = new CountingArchive();
+		a->_files.push_back("a.dat");
+		set.add("a", a);
+
+		TS_ASSERT(set.hasFile("a.dat"));
+		TS_ASSERT(set.hasFile("a.dat"));
+		TS_ASSERT(!set.hasFile("b.dat"));
+		TS_ASSERT(!set.hasFile("b.dat"));
+		TS_ASSERT_EQUALS(a->_lookups, 4);
+	}
+
+	void test_negative_lookups() {
+		Common::SearchSet set;
+		set.setLookupCache(true);
+		CountingArchive *a = new CountingArchive();
+		CountingArchive *b = new CountingArchive();
+		set.add("a", a);
+		set.add("b", b);
+
+		TS_ASSERT(!set.hasFile("missing.dat"));
+		TS_ASSERT(!set.hasFile("missing.dat"));
+		TS_ASSERT(!set.createReadStreamForMember("missing.dat"));
+		TS_ASSERT_EQUALS(a->_lookups, 1);
+		TS_ASSERT_EQUALS(b->_lookups, 1);
+	}
+
+	void test_positive_lookups() {
+		Common::SearchSet set;
+		set.setLookupCache(true);
+		CountingArchive *a = new CountingArchive();
+		CountingArchive *b = new CountingArchive();
+		b->_files.push_back("b.dat");
+		set.add("a", a, 1);
+		set.add("b", b);
+
+		TS_ASSERT(set.hasFile("b.dat"));
+		TS_ASSERT(set.hasFile("b.dat"));
+		Common::SeekableReadStream *stream = set.createReadStreamForMember("b.dat");
+		TS_ASSERT(stream);
+		delete stream;
+
+		// Only the archive which holds the file is asked again
+		TS_ASSERT_EQUALS(a->_lookups, 1);
+
+		// A file that disappears is looked up again
+		b->_files.clear();
+		TS_ASSERT(!set.hasFile("b.dat"));
+		TS_ASSERT_EQUALS(a->_lookups, 2);
+	}
+
+	void test_invalidation() {
+		Common::SearchSet set;
+		set.setLookupCache(true);
+		CountingArchive *a = new CountingArchive();
+		set.add("a", a);
+		TS_ASSERT(!set.hasFile("c.dat"));
+
+		CountingArchive *c = new CountingArchive();
+		c->_files.push_back("c.dat");
+		set.add("c", c);
+		TS_ASSERT(set.hasFile("c.dat"));
+
+		set.remove("c");
+		TS_ASSERT(!set.hasFile("c.dat"));
+
+		a->_files.push_back("c.dat");
+		TS_ASSERT(!set.hasFile("c.dat"));
+		Common::SearchSet::invalidateLookupCache();
+		TS_ASSERT(set.hasFile("c.dat"));
+	}
+
+	void test_nested_invalidation() {
+		Common::SearchSet set;
+		set.setLookupCache(true);
+		Common::SearchSet *inner = new Common::SearchSet();
+		set.add("inner", inner);
+		TS_ASSERT(!set.hasFile("d.dat"));
+
+		CountingArchive *d = new CountingArchive();
+		d->_files.push_back("d.dat");
+		inner->add("d", d);
+		TS_ASSERT(set.hasFile("d.dat"));
+	}
+};
@@ -70,4 +70,20 @@ class SeekableSubReadStreamTestSuite : public CxxTest::TestSuite {
 		b = ssrs.readByte();
 		TS_ASSERT_EQUALS(b, 1);
 	}
+
+	void test_read_in_place() {
+		byte contents[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		Common::MemoryReadStream ms(contents, 10);
+		Common::SeekableSubReadStream ssrs(&ms, 2, 8);
+
+		ssrs.seek(1);
+		const byte *data = ssrs.readInPlace(4);
+		TS_ASSERT_EQUALS(data, contents + 3);
+		TS_ASSERT_EQUALS(ssrs.pos(), 5);
+
+		// The substream ends before the parent stream does
+		TS_ASSERT(!ssrs.readInPlace(2));
+		TS_ASSERT_EQUALS(ssrs.pos(), 5);
+		TS_ASSERT_EQUALS(ssrs.readByte(), 7);
+	}
 };
@@ -1,5 +1,6 @@
 #include <cxxtest/TestSuite.h>
 
+#include "common/memstream.h"
 #include "common/serializer.h"
 #include "common/stream.h"
 
@@ -108,4 +109,45 @@ public:
 	void test_read_v2_as_v2() {
 		readVersioned_v2(_inStreamV2, 2);
 	}
+
+	void test_sync_arrays() {
+		// More entries than fit in one chunk, in types the entries are converted from
+		int32 values[300];
+		for (int i = 0; i < ARRAYSIZE(values); ++i)
+			values[i] = (int32)((uint32)i * 0x01020305u) ^ -(i & 1);
+
+		// The arrays are written as if each entry was synced on its own
+		Common::MemoryWriteStreamDynamic bulk(DisposeAfterUse::YES), single(DisposeAfterUse::YES);
+		Common::Serializer bulkSer(nullptr, &bulk), singleSer(nullptr, &single);
+		bulkSer.syncArray(values, ARRAYSIZE(values), Common::Serializer::Sint16BE);
+		bulkSer.syncArrayAsUint32LE(values, ARRAYSIZE(values));
+		bulkSer.syncArrayAsByte(values, ARRAYSIZE(values));
+		bulkSer.syncArrayAsSint32BE(values, ARRAYSIZE(values), 2);
+		for (int i = 0; i < ARRAYSIZE(values); ++i)
+			singleSer.syncAsSint16BE(values[i]);
+		for (int i = 0; i < ARRAYSIZE(values); ++i)
+			singleSer.syncAsUint32LE(values[i]);
+		for (int i = 0; i < ARRAYSIZE(values); ++i)
+			singleSer.syncAsByte(values[i]);
+
+		TS_ASSERT_EQUALS(bulkSer.bytesSynced(), singleSer.bytesSynced());
+		TS_ASSERT_EQUALS(bulk.size(), single.size());
+		TS_ASSERT(!memcmp(bulk.getData(), single.getData(), single.size()));
+
+		// And read back with the same conversions
+		Common::MemoryReadStream in(bulk.getData(), bulk.size());
+		Common::Serializer inSer(&in, nullptr);
+		int32 shorts[300], longs[300];
+		uint16 bytes[300];
+		inSer.syncArray(shorts, ARRAYSIZE(shorts), Common::Serializer::Sint16BE);
+		inSer.syncArrayAsUint32LE(longs, ARRAYSIZE(longs));
+		inSer.syncArrayAsByte(bytes, ARRAYSIZE(bytes));
+		for (int i = 0; i < ARRAYSIZE(values); ++i) {
+			TS_ASSERT_EQUALS(shorts[i], (int16)values[i]);
+			TS_ASSERT_EQUALS(longs[i], values[i]);
+			TS_ASSERT_EQUALS(bytes[i], (byte)values[i]);
+		}
+		TS_ASSERT(!inSer.err());
+		TS_ASSERT_EQUALS(in.pos(), in.size());
+	}
 };
@@ -0,0 +1,132 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/smallarray.h"
+#include "common/str.h"
+
+class SmallArrayTestSuite : public CxxTest::TestSuite
+{
+	public:
+	void test_inline_and_heap() {
+		Common::SmallArray<int, 4> array;
+		TS_ASSERT(array.empty());
+		TS_ASSERT(array.isInline());
+
+		for (int i = 0; i < 4; ++i)
+			array.push_back(i);
+		TS_ASSERT(array.isInline());
+		TS_ASSERT_EQUALS(array.size(), 4U);
+
+		// One element too many spills the array to the heap
+		array.push_back(4);
+		TS_ASSERT(!array.isInline());
+		for (int i = 0; i < 5; ++i)
+			TS_ASSERT_EQUALS(array[i], i);
+
+		array.clear();
+		TS_ASSERT(array.empty());
+		TS_ASSERT(array.isInline());
+	}
+
+	void test_insert_erase() {
+		Common::SmallArray<Common::String, 3> array;
+		array.push_back("a");
+		array.push_back("c");
+		array.insert_at(1, "b");
+		TS_ASSERT(array.isInline());
+		array.insert(array.begin(), "0");
+		TS_ASSERT(!array.isInline());
+		TS_ASSERT_EQUALS(array.size(), 4U);
+		TS_ASSERT_EQUALS(array[0], "0");
+		TS_ASSERT_EQUALS(array[1], "a");
+		TS_ASSERT_EQUALS(array[2], "b");
+		TS_ASSERT_EQUALS(array[3], "c");
+
+		TS_ASSERT_EQUALS(array.remove_at(1), "a");
+		array.erase(array.begin());
+		TS_ASSERT_EQUALS(array.size(), 2U);
+		TS_ASSERT_EQUALS(array.front(), "b");
+		TS_ASSERT_EQUALS(array.back(), "c");
+	}
+
+	void test_self_insert() {
+		Common::SmallArray<Common::String, 8> array;
+		array.push_back("x");
+		array.push_back("y");
+		array.push_back(array);
+		TS_ASSERT_EQUALS(array.size(), 4U);
+		TS_ASSERT_EQUALS(array[2], "x");
+		TS_ASSERT_EQUALS(array[3], "y");
+
+		// The element comes from the array itself, which has to grow
+		Common::SmallArray<Common::String, 2> full;
+		full.push_back("first");
+		full.push_back("second");
+		full.push_back(full[0]);
+		TS_ASSERT_EQUALS(full.size(), 3U);
+		TS_ASSERT_EQUALS(full[2], "first");
+	}
+
+	void test_copy_and_assign() {
+		Common::SmallArray<Common::String, 2> small;
+		small.push_back("one");
+
+		Common::SmallArray<Common::String, 2> big;
+		for (int i = 0; i < 5; ++i)
+			big.push_back(Common::String::format("%d", i));
+
+		Common::SmallArray<Common::String, 2> copy(big);
+		TS_ASSERT(copy == big);
+		TS_ASSERT(!copy.isInline());
+
+		copy = small;
+		TS_ASSERT(copy == small);
+		TS_ASSERT(copy.isInline());
+		TS_ASSERT(copy != big);
+	}
+
+	void test_move() {
+		Common::SmallArray<Common::String, 2> small;
+		small.push_back("one");
+		Common::SmallArray<Common::String, 2> movedSmall(Common::move(small));
+		TS_ASSERT(small.empty());
+		TS_ASSERT_EQUALS(movedSmall.size(), 1U);
+		TS_ASSERT_EQUALS(movedSmall[0], "one");
+
+		Common::SmallArray<Common::String, 2> big;
+		for (int i = 0; i < 5; ++i)
+			big.push_back(Common::String::format("%d", i));
+		const Common::String *data = big.data();
+		movedSmall = Common::move(big);
+		TS_ASSERT(big.empty());
+		TS_ASSERT(big.isInline());
+		TS_ASSERT_EQUALS(movedSmall.data(), data);
+		TS_ASSERT_EQUALS(movedSmall[4], "4");
+
+		movedSmall.emplace_back("5");
+		movedSmall.emplace(movedSmall.begin(), "-1");
+		TS_ASSERT_EQUALS(movedSmall.size(), 7U);
+		TS_ASSERT_EQUALS(movedSmall.front(), "-1");
+		TS_ASSERT_EQUALS(movedSmall.back(), "5");
+	}
+
+	void test_resize_reserve() {
+		Common::SmallArray<int, 4> array(3, 7);
+		TS_ASSERT(array.isInline());
+		array.resize(2);
+		TS_ASSERT_EQUALS(array.size(), 2U);
+		array.reserve(4);
+		TS_ASSERT(array.isInline());
+		array.reserve(16);
+		TS_ASSERT(!array.isInline());
+		TS_ASSERT_EQUALS(array[1], 7);
+
+		int values[] = { 1, 2, 3, 4, 5, 6 };
+		Common::SmallArray<int, 4> fromValues(values, 6);
+		TS_ASSERT_EQUALS(fromValues.size(), 6U);
+		TS_ASSERT_EQUALS(fromValues[5], 6);
+
+		array.assign(fromValues.begin() + 1, fromValues.begin() + 3);
+		TS_ASSERT_EQUALS(array.size(), 2U);
+		TS_ASSERT_EQUALS(array[0], 2);
+	}
+};
@@ -2,6 +2,8 @@
 
 class SpanTestSuite;
 
+#include "common/bufferedstream.h"
+#include "common/ptr.h"
 #include "common/span.h"
 #include "common/str.h"
 
@@ -805,4 +807,32 @@ public:
 			}
 		}
 	}
+
+	void test_read_span() {
+		byte data[] = { 'h', 'e', 'l', 'l', 'o' };
+
+		{
+			Common::MemoryReadStream stream(data, sizeof(data));
+			Common::SpanOwner<Common::Span<byte> > buffer;
+			Common::Span<const byte> span = Common::readSpan(stream, 4, buffer);
+			TS_ASSERT_EQUALS(span.data(), data);
+			TS_ASSERT_EQUALS(span.size(), 4U);
+			TS_ASSERT(!buffer);
+			TS_ASSERT_EQUALS(stream.pos(), 4);
+		}
+
+		{
+			// Buffered streams do not give access to their data
+			Common::MemoryReadStream *stream = new Common::MemoryReadStream(data, sizeof(data));
+			Common::ScopedPtr<Common::SeekableReadStream> buffered(Common::wrapBufferedSeekableReadStream(stream, 2, DisposeAfterUse::YES));
+			buffered->seek(1);
+			Common::SpanOwner<Common::Span<byte> > buffer;
+			Common::Span<const byte> span = Common::readSpan(*buffered, 8, buffer);
+			TS_ASSERT(buffer);
+			TS_ASSERT_EQUALS(span.data(), buffer->data());
+			TS_ASSERT_EQUALS(span.size(), 4U);
+			TS_ASSERT_EQUALS(span[0], 'e');
+			TS_ASSERT_EQUALS(span[3], 'o');
+		}
+	}
 };
@@ -17,6 +17,66 @@ class StringTestSuite : public CxxTest::TestSuite
 		TS_ASSERT_EQUALS(str, "str");
 	}
 
+	void test_move() {
+#ifdef USE_CXX11
+		Common::String longStr("a string too long for the internal storage");
+		Common::String shortStr("short");
+
+		Common::String moved(Common::move(longStr));
+		TS_ASSERT_EQUALS(moved, "a string too long for the internal storage");
+		TS_ASSERT(longStr.empty());
+
+		Common::String moved2(Common::move(shortStr));
+		TS_ASSERT_EQUALS(moved2, "short");
+		TS_ASSERT(shortStr.empty());
+
+		moved2 = Common::move(moved);
+		TS_ASSERT_EQUALS(moved2, "a string too long for the internal storage");
+		TS_ASSERT(moved.empty());
+
+		// Moving a shared string keeps the other references intact
+		Common::String copy = moved2;
+		moved = Common::move(copy);
+		TS_ASSERT_EQUALS(moved, moved2);
+		moved.setChar('A', 0);
+		TS_ASSERT_EQUALS(moved2, "a string too long for the internal storage");
+
+		Common::U32String u32Str("a string too long for the internal storage");
+		Common::U32String u32Moved(Common::move(u32Str));
+		TS_ASSERT_EQUALS(u32Moved, "a string too long for the internal storage");
+		TS_ASSERT(u32Str.empty());
+#endif
+	}
+
+	void test_copy_storage() {
+		// Short heap strings are copied, long ones are shared until modified
+		Common::String medium("a string a bit too long for the internal storage");
+		Common::String mediumCopy(medium);
+		TS_ASSERT_DIFFERS(medium.c_str(), mediumCopy.c_str());
+		mediumCopy.setChar('A', 0);
+		TS_ASSERT_EQUALS(medium, "a string a bit too long for the internal storage");
+
+		Common::String longStr;
+		for (int i = 0; i < 10; ++i)
+			longStr += "0123456789";
+		Common::String longCopy(longStr);
+		TS_ASSERT_EQUALS(longStr.c_str(), longCopy.c_str());
+		longCopy.setChar('x', 0);
+		TS_ASSERT_DIFFERS(longStr.c_str(), longCopy.c_str());
+		TS_ASSERT_EQUALS(longStr.firstChar(), '0');
+
+		// Assigning a short heap string reuses the storage of the target
+		const char *storage = mediumCopy.c_str();
+		mediumCopy = medium;
+		TS_ASSERT_EQUALS(mediumCopy.c_str(), storage);
+		TS_ASSERT_EQUALS(mediumCopy, medium);
+
+		longCopy = longStr;
+		TS_ASSERT_EQUALS(longCopy.c_str(), longStr.c_str());
+		mediumCopy = longStr;
+		TS_ASSERT_EQUALS(mediumCopy.c_str(), longStr.c_str());
+	}
+
 	void test_trim() {
 		Common::String str("  This is a s tring with spaces  ");
 		Common::String str2 = str;
@@ -0,0 +1,91 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "common/threadpool.h"
+
+class ThreadPoolTestSuite : public CxxTest::TestSuite {
+private:
+	// Pretends to have several threads, and runs the jobs last job first
+	class ReversePool : public Common::ThreadPool {
+	public:
+		ReversePool(uint threads) : _threads(threads), _runs(0) {}
+
+		uint getThreadCount() const override { return _threads; }
+		void run(void (*proc)(void *data, uint job), void *data, uint count) override {
+			++_runs;
+			for (uint job = count; job-- > 0;)
+				proc(data, job);
+		}
+
+		uint _threads;
+		uint _runs;
+	};
+
+	struct Ranges {
+		Common::Array<uint> hits;
+		uint chunks;
+	};
+
+	static void markJob(void *data, uint job) {
+		Common::Array<uint> *hits = (Common::Array<uint> *)data;
+		(*hits)[job]++;
+	}
+
+	static void markRange(void *data, uint begin, uint end) {
+		Ranges *ranges = (Ranges *)data;
+		ranges->chunks++;
+		for (uint i = begin; i < end; ++i)
+			ranges->hits[i]++;
+	}
+
+	static bool allHitOnce(const Common::Array<uint> &hits) {
+		for (uint i = 0; i < hits.size(); ++i) {
+			if (hits[i] != 1)
+				return false;
+		}
+		return true;
+	}
+
+public:
+	void test_inline_run() {
+		Common::InlineThreadPool pool;
+		TS_ASSERT_EQUALS(pool.getThreadCount(), 1u);
+
+		Common::Array<uint> hits(10, 0);
+		pool.run(&markJob, &hits, hits.size());
+		TS_ASSERT(allHitOnce(hits));
+	}
+
+	void test_run_range_chunks() {
+		ReversePool pool(4);
+
+		Ranges ranges;
+		ranges.hits.resize(103);
+		ranges.chunks = 0;
+		pool.runRange(&markRange, &ranges, ranges.hits.size());
+		TS_ASSERT(allHitOnce(ranges.hits));
+		TS_ASSERT_EQUALS(ranges.chunks, 4u);
+		TS_ASSERT_EQUALS(pool._runs, 1u);
+	}
+
+	void test_run_range_min_chunk() {
+		ReversePool pool(8);
+
+		// Only two chunks of at least 40 items fit
+		Ranges ranges;
+		ranges.hits.resize(100);
+		ranges.chunks = 0;
+		pool.runRange(&markRange, &ranges, ranges.hits.size(), 40);
+		TS_ASSERT(allHitOnce(ranges.hits));
+		TS_ASSERT_EQUALS(ranges.chunks, 2u);
+
+		// Too small to split, run on the calling thread
+		ranges.hits.clear();
+		ranges.hits.resize(30);
+		ranges.chunks = 0;
+		pool.runRange(&markRange, &ranges, ranges.hits.size(), 40);
+		TS_ASSERT(allHitOnce(ranges.hits));
+		TS_ASSERT_EQUALS(ranges.chunks, 1u);
+		TS_ASSERT_EQUALS(pool._runs, 1u);
+	}
+};
@@ -0,0 +1,130 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/zlib.h"
+
+#if defined(USE_ZLIB)
+
+namespace {
+
+/** The phrase below repeated 40 times (1800 bytes) */
+const char zlibPhrase[] = "The quick brown fox jumps over the lazy dog. ";
+const uint zlibTextSize = 1800;
+
+bool isZlibText(const byte *data, uint size) {
+	if (size != zlibTextSize)
+		return false;
+	for (uint i = 0; i < size; ++i) {
+		if (data[i] != (byte)zlibPhrase[i % (sizeof(zlibPhrase) - 1)])
+			return false;
+	}
+	return true;
+}
+
+/** The text, compressed with a zlib header */
+const byte zlibData[] = {
+	0x78, 0xda, 0x0b, 0xc9, 0x48, 0x55, 0x28, 0x2c, 0xcd, 0x4c, 0xce, 0x56, 0x48, 0x2a, 0xca, 0x2f,
+	0xcf, 0x53, 0x48, 0xcb, 0xaf, 0x50, 0xc8, 0x2a, 0xcd, 0x2d, 0x28, 0x56, 0xc8, 0x2f, 0x4b, 0x2d,
+	0x52, 0x28, 0x01, 0x4a, 0xe7, 0x24, 0x56, 0x55, 0x2a, 0xa4, 0xe4, 0xa7, 0xeb, 0x29, 0x84, 0x8c,
+	0x2a, 0x1e, 0x55, 0x3c, 0xaa, 0x78, 0x54, 0xf1, 0xa8, 0xe2, 0x51, 0xc5, 0xc3, 0x4b, 0x31, 0x00,
+	0x88, 0x0a, 0x86, 0x37,
+};
+
+/** The text, compressed without a header */
+const byte deflateData[] = {
+	0x0b, 0xc9, 0x48, 0x55, 0x28, 0x2c, 0xcd, 0x4c, 0xce, 0x56, 0x48, 0x2a, 0xca, 0x2f, 0xcf, 0x53,
+	0x48, 0xcb, 0xaf, 0x50, 0xc8, 0x2a, 0xcd, 0x2d, 0x28, 0x56, 0xc8, 0x2f, 0x4b, 0x2d, 0x52, 0x28,
+	0x01, 0x4a, 0xe7, 0x24, 0x56, 0x55, 0x2a, 0xa4, 0xe4, 0xa7, 0xeb, 0x29, 0x84, 0x8c, 0x2a, 0x1e,
+	0x55, 0x3c, 0xaa, 0x78, 0x54, 0xf1, 0xa8, 0xe2, 0x51, 0xc5, 0xc3, 0x4b, 0x31, 0x00,
+};
+
+/** The text, compressed with a gzip header */
+const byte gzipData[] = {
+	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x0b, 0xc9, 0x48, 0x55, 0x28, 0x2c,
+	0xcd, 0x4c, 0xce, 0x56, 0x48, 0x2a, 0xca, 0x2f, 0xcf, 0x53, 0x48, 0xcb, 0xaf, 0x50, 0xc8, 0x2a,
+	0xcd, 0x2d, 0x28, 0x56, 0xc8, 0x2f, 0x4b, 0x2d, 0x52, 0x28, 0x01, 0x4a, 0xe7, 0x24, 0x56, 0x55,
+	0x2a, 0xa4, 0xe4, 0xa7, 0xeb, 0x29, 0x84, 0x8c, 0x2a, 0x1e, 0x55, 0x3c, 0xaa, 0x78, 0x54, 0xf1,
+	0xa8, 0xe2, 0x51, 0xc5, 0xc3, 0x4b, 0x31, 0x00, 0xe6, 0xc3, 0x95, 0x64, 0x08, 0x07, 0x00, 0x00,
+};
+
+} // End of anonymous namespace
+
+class ZlibTestSuite : public CxxTest::TestSuite {
+public:
+	void test_uncompress() {
+		byte dst[zlibTextSize + 100];
+		unsigned long dstLen = sizeof(dst);
+		TS_ASSERT(Common::uncompress(dst, &dstLen, zlibData, sizeof(zlibData)));
+		TS_ASSERT(isZlibText(dst, dstLen));
+
+		// The output does not fit
+		dstLen = zlibTextSize / 2;
+		TS_ASSERT(!Common::uncompress(dst, &dstLen, zlibData, sizeof(zlibData)));
+
+		// Corrupted data
+		byte corrupted[sizeof(zlibData)];
+		memcpy(corrupted, zlibData, sizeof(zlibData));
+		corrupted[sizeof(corrupted) - 1] ^= 0xFF;
+		dstLen = sizeof(dst);
+		TS_ASSERT(!Common::uncompress(dst, &dstLen, corrupted, sizeof(corrupted)));
+	}
+
+	void test_inflate_headerless() {
+		byte dst[zlibTextSize];
+		TS_ASSERT(Common::inflateZlibHeaderless(dst, sizeof(dst), deflateData, sizeof(deflateData)));
+		TS_ASSERT(isZlibText(dst, sizeof(dst)));
+
+		// A short destination buffer is filled with the start of the data
+		byte part[zlibTextSize / 2];
+		TS_ASSERT(Common::inflateZlibHeaderless(part, sizeof(part), deflateData, sizeof(deflateData)));
+		TS_ASSERT_SAME_DATA(part, dst, sizeof(part));
+	}
+
+	void test_wrap_gzip() {
+		Common::SeekableReadStream *stream = Common::wrapCompressedReadStream(
+			new Common::MemoryReadStream(gzipData, sizeof(gzipData)));
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(stream->size(), (int64)zlibTextSize);
+
+		byte dst[zlibTextSize];
+		TS_ASSERT_EQUALS(stream->read(dst, sizeof(dst)), zlibTextSize);
+		TS_ASSERT(isZlibText(dst, sizeof(dst)));
+
+		// The decompressed stream is seekable
+		TS_ASSERT(stream->seek(45, SEEK_SET));
+		TS_ASSERT_EQUALS(stream->readByte(), 'T');
+		TS_ASSERT(!stream->eos());
+		delete stream;
+	}
+
+	void test_wrap_zlib() {
+		// Zlib data needs its size to be known
+		Common::SeekableReadStream *stream = Common::wrapCompressedReadStream(
+			new Common::MemoryReadStream(zlibData, sizeof(zlibData)), zlibTextSize);
+		TS_ASSERT(stream);
+
+		byte dst[zlibTextSize];
+		TS_ASSERT_EQUALS(stream->read(dst, sizeof(dst)), zlibTextSize);
+		TS_ASSERT(isZlibText(dst, sizeof(dst)));
+		delete stream;
+
+		// A wrong size falls back to decompressing on the fly
+		stream = Common::wrapCompressedReadStream(
+			new Common::MemoryReadStream(zlibData, sizeof(zlibData)), zlibTextSize + 10);
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(stream->read(dst, sizeof(dst)), zlibTextSize);
+		TS_ASSERT(isZlibText(dst, sizeof(dst)));
+		delete stream;
+	}
+
+	void test_wrap_uncompressed() {
+		Common::SeekableReadStream *stream = Common::wrapCompressedReadStream(
+			new Common::MemoryReadStream((const byte *)zlibPhrase, sizeof(zlibPhrase) - 1));
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(stream->size(), (int64)(sizeof(zlibPhrase) - 1));
+		TS_ASSERT_EQUALS(stream->readByte(), 'T');
+		delete stream;
+	}
+};
+
+#endif
@@ -0,0 +1,142 @@
+#include <cxxtest/TestSuite.h>
+
+#include "engines/snapshots.h"
+
+#include "common/stream.h"
+
+namespace {
+
+/** Keeps snapshots of a byte array instead of an engine. */
+class ArraySnapshotManager : public SnapshotManager {
+public:
+	Common::Array<byte> _state;
+
+	ArraySnapshotManager(uint32 maxMemory) : SnapshotManager(nullptr, maxMemory) {}
+
+protected:
+	Common::Error saveState(Common::WriteStream *stream) override {
+		stream->write(_state.data(), _state.size());
+		return Common::kNoError;
+	}
+
+	Common::Error loadState(Common::SeekableReadStream *stream) override {
+		_state.resize(stream->size());
+		stream->read(_state.data(), _state.size());
+		return Common::kNoError;
+	}
+};
+
+Common::Array<byte> makeState(uint32 size, uint32 seed) {
+	Common::Array<byte> state;
+	state.resize(size);
+	for (uint32 i = 0; i < size; ++i)
+		state[i] = (byte)((i * 7 + seed) >> 3);
+	return state;
+}
+
+} // End of anonymous namespace
+
+class SnapshotsTestSuite : public CxxTest::TestSuite {
+public:
+	void test_delta_roundtrip() {
+		Common::Array<byte> a = makeState(1000, 0);
+		Common::Array<byte> b = a;
+		// A single changed byte, a short run and a long run of changes
+		b[3] ^= 0x55;
+		for (uint i = 100; i < 104; ++i)
+			b[i] ^= 0xFF;
+		for (uint i = 500; i < 700; ++i)
+			b[i] = (byte)i;
+
+		Common::Array<byte> delta;
+		SnapshotManager::encodeDelta(delta, a.data(), a.size(), b.data(), b.size());
+		TS_ASSERT_LESS_THAN(delta.size(), 300u);
+
+		Common::Array<byte> result = a;
+		SnapshotManager::applyDelta(result.data(), delta);
+		TS_ASSERT(result == b);
+
+		// The delta works both ways
+		SnapshotManager::applyDelta(result.data(), delta);
+		TS_ASSERT(result == a);
+	}
+
+	void test_delta_sizes() {
+		Common::Array<byte> shorter = makeState(300, 1);
+		Common::Array<byte> longer = makeState(1000, 2);
+
+		// The shorter state is padded with zeros
+		Common::Array<byte> delta;
+		SnapshotManager::encodeDelta(delta, shorter.data(), shorter.size(), longer.data(), longer.size());
+		Common::Array<byte> result = shorter;
+		result.resize(longer.size());
+		for (uint i = shorter.size(); i < result.size(); ++i)
+			result[i] = 0;
+		SnapshotManager::applyDelta(result.data(), delta);
+		TS_ASSERT(result == longer);
+
+		delta.clear();
+		SnapshotManager::encodeDelta(delta, longer.data(), longer.size(), shorter.data(), shorter.size());
+		result = longer;
+		SnapshotManager::applyDelta(result.data(), delta);
+		for (uint i = 0; i < shorter.size(); ++i)
+			TS_ASSERT_EQUALS(result[i], shorter[i]);
+		for (uint i = shorter.size(); i < result.size(); ++i)
+			TS_ASSERT_EQUALS(result[i], 0);
+
+		// Equal states give an empty delta
+		delta.clear();
+		SnapshotManager::encodeDelta(delta, longer.data(), longer.size(), longer.data(), longer.size());
+		TS_ASSERT(delta.empty());
+	}
+
+	void test_restore() {
+		ArraySnapshotManager snapshots(16 * 1024 * 1024);
+
+		Common::Array<byte> states[4];
+		for (uint i = 0; i < ARRAYSIZE(states); ++i) {
+			states[i] = makeState(2000 + i * 100, i);
+			snapshots._state = states[i];
+			TS_ASSERT_EQUALS(snapshots.takeSnapshot().getCode(), Common::kNoError);
+		}
+		TS_ASSERT_EQUALS(snapshots.getSnapshotCount(), 4u);
+
+		snapshots._state.clear();
+		TS_ASSERT_EQUALS(snapshots.restoreSnapshot(2).getCode(), Common::kNoError);
+		TS_ASSERT(snapshots._state == states[1]);
+		// The later snapshots are dropped
+		TS_ASSERT_EQUALS(snapshots.getSnapshotCount(), 2u);
+
+		TS_ASSERT_EQUALS(snapshots.restoreSnapshot(0).getCode(), Common::kNoError);
+		TS_ASSERT(snapshots._state == states[1]);
+		TS_ASSERT_EQUALS(snapshots.restoreSnapshot(1).getCode(), Common::kNoError);
+		TS_ASSERT(snapshots._state == states[0]);
+		TS_ASSERT_EQUALS(snapshots.getSnapshotCount(), 1u);
+
+		TS_ASSERT_DIFFERS(snapshots.restoreSnapshot(1).getCode(), Common::kNoError);
+	}
+
+	void test_memory_limit() {
+		ArraySnapshotManager snapshots(10000);
+
+		// Each state differs completely from the one before it
+		for (uint i = 0; i < 10; ++i) {
+			snapshots._state = makeState(4000, i * 8);
+			snapshots.takeSnapshot();
+			TS_ASSERT_LESS_THAN_EQUALS(snapshots.getMemoryUsage(), 10000u);
+		}
+
+		// The oldest snapshots were dropped, and the newest still restore
+		TS_ASSERT_LESS_THAN(snapshots.getSnapshotCount(), 3u);
+		TS_ASSERT_LESS_THAN(0u, snapshots.getSnapshotCount());
+		const uint count = snapshots.getSnapshotCount();
+		TS_ASSERT_EQUALS(snapshots.restoreSnapshot(count - 1).getCode(), Common::kNoError);
+		TS_ASSERT(snapshots._state == makeState(4000, (10 - count) * 8));
+
+		// The latest snapshot is kept even when it exceeds the limit
+		snapshots._state = makeState(20000, 1);
+		snapshots.takeSnapshot();
+		TS_ASSERT_EQUALS(snapshots.getSnapshotCount(), 1u);
+		TS_ASSERT_EQUALS(snapshots.getMemoryUsage(), 20000u);
+	}
+};
@@ -0,0 +1,119 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/conversion.h"
+#include "graphics/pixelformat.h"
+
+#include "common/endian.h"
+
+class ConversionTestSuite : public CxxTest::TestSuite
+{
+private:
+	static uint32 readColor(const byte *src, uint bytesPerPixel) {
+		if (bytesPerPixel == 2)
+			return READ_UINT16(src);
+		else if (bytesPerPixel == 3)
+			return READ_UINT24(src);
+		return READ_UINT32(src);
+	}
+
+	static void writeColor(byte *dst, uint bytesPerPixel, uint32 color) {
+		if (bytesPerPixel == 2)
+			WRITE_UINT16(dst, color);
+		else if (bytesPerPixel == 3)
+			WRITE_UINT24(dst, color);
+		else
+			WRITE_UINT32(dst, color);
+	}
+
+	// Convert a rectangle with padded lines both into a separate buffer
+	// and in place, the way Surface::convertToInPlace does, and check each
+	// pixel against colorToARGB/ARGBToColor
+	static bool checkCrossBlit(const Graphics::PixelFormat &srcFmt, const Graphics::PixelFormat &dstFmt) {
+		const uint w = 37, h = 5;
+		const uint srcPitch = (w + 3) * srcFmt.bytesPerPixel;
+		const uint dstPitch = (w + 3) * dstFmt.bytesPerPixel;
+
+		byte *src = new byte[srcPitch * h];
+		byte *dst = new byte[dstPitch * h];
+		byte *inPlace = new byte[MAX(srcPitch, dstPitch) * h];
+
+		uint32 seed = 0x12345678;
+		for (uint i = 0; i < srcPitch * h; ++i) {
+			seed = seed * 1103515245 + 12345;
+			src[i] = seed >> 16;
+		}
+		memcpy(inPlace, src, srcPitch * h);
+
+		bool ok = Graphics::crossBlit(dst, src, dstPitch, srcPitch, w, h, dstFmt, srcFmt);
+		ok = ok && Graphics::crossBlit(inPlace, inPlace, dstPitch, srcPitch, w, h, dstFmt, srcFmt);
+
+		for (uint y = 0; ok && y < h; ++y) {
+			for (uint x = 0; ok && x < w; ++x) {
+				const uint32 color = readColor(src + y * srcPitch + x * srcFmt.bytesPerPixel, srcFmt.bytesPerPixel);
+				byte a, r, g, b;
+				srcFmt.colorToARGB(color, a, r, g, b);
+
+				// Identical formats are copied as they are, unused bits included
+				byte expected[4];
+				writeColor(expected, dstFmt.bytesPerPixel, srcFmt == dstFmt ? color : dstFmt.ARGBToColor(a, r, g, b));
+				ok = !memcmp(dst + y * dstPitch + x * dstFmt.bytesPerPixel, expected, dstFmt.bytesPerPixel) &&
+				     !memcmp(inPlace + y * dstPitch + x * dstFmt.bytesPerPixel, expected, dstFmt.bytesPerPixel);
+			}
+		}
+
+		delete[] src;
+		delete[] dst;
+		delete[] inPlace;
+		return ok;
+	}
+
+public:
+	void test_cross_blit() {
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),    // RGB565
+			Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0),    // RGB555
+			Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15),   // ARGB1555
+			Graphics::PixelFormat(2, 4, 4, 4, 4, 8, 4, 0, 12),    // ARGB4444
+			Graphics::PixelFormat(2, 3, 3, 2, 0, 5, 2, 0, 0),     // RGB332 in 16 bits
+			Graphics::PixelFormat(3, 8, 8, 8, 0, 16, 8, 0, 0),    // RGB888
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0),   // RGBA8888
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24),   // ABGR8888
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0),    // XRGB8888
+			Graphics::PixelFormat(4, 6, 6, 6, 2, 18, 12, 6, 0)    // Unusual 32 bit format
+		};
+
+		for (int i = 0; i < ARRAYSIZE(formats); ++i) {
+			for (int j = 0; j < ARRAYSIZE(formats); ++j) {
+				if (formats[j].bytesPerPixel == 3)
+					continue;
+				TSM_ASSERT(Common::String::format("%s to %s", formats[i].toString().c_str(), formats[j].toString().c_str()).c_str(),
+				           checkCrossBlit(formats[i], formats[j]));
+			}
+		}
+	}
+
+	void test_cross_blit_map() {
+		const uint w = 9, h = 3;
+		byte palette[256 * 3];
+		for (int i = 0; i < 256 * 3; ++i)
+			palette[i] = i * 7;
+
+		const Graphics::PixelFormat format(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		uint32 map[256];
+		Graphics::convertPaletteToMap(map, palette, 256, format);
+		TS_ASSERT_EQUALS(map[3], format.RGBToColor(palette[9], palette[10], palette[11]));
+
+		// Convert in place, with padded source lines
+		byte buffer[w * h * 2];
+		for (uint i = 0; i < sizeof(buffer); ++i)
+			buffer[i] = i * 13;
+		byte src[sizeof(buffer)];
+		memcpy(src, buffer, sizeof(buffer));
+
+		TS_ASSERT(Graphics::crossBlitMap(buffer, buffer, w * 2, w + 1, w, h, 2, map));
+		for (uint y = 0; y < h; ++y) {
+			for (uint x = 0; x < w; ++x)
+				TS_ASSERT_EQUALS(READ_UINT16(buffer + y * w * 2 + x * 2), map[src[y * (w + 1) + x]]);
+		}
+	}
+};
@@ -0,0 +1,90 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/dirty_region.h"
+
+class DirtyRegionTestSuite : public CxxTest::TestSuite
+{
+private:
+	static Common::Array<Common::Rect> getRects(const Graphics::DirtyRegion &region) {
+		Common::List<Common::Rect> list;
+		region.getRects(list);
+
+		Common::Array<Common::Rect> rects;
+		for (Common::List<Common::Rect>::const_iterator i = list.begin(); i != list.end(); ++i)
+			rects.push_back(*i);
+		return rects;
+	}
+
+	static uint area(const Common::Array<Common::Rect> &rects) {
+		uint total = 0;
+		for (uint i = 0; i < rects.size(); ++i)
+			total += rects[i].width() * rects[i].height();
+		return total;
+	}
+
+public:
+	void test_merge() {
+		Graphics::DirtyRegion region(1, 1);
+		region.setBounds(Common::Rect(320, 200));
+		TS_ASSERT(region.empty());
+		TS_ASSERT(getRects(region).empty());
+
+		// Overlapping rects
+		region.addRect(Common::Rect(10, 10, 30, 20));
+		region.addRect(Common::Rect(20, 10, 40, 20));
+		region.addRect(Common::Rect(12, 12, 18, 18));
+		Common::Array<Common::Rect> rects = getRects(region);
+		TS_ASSERT_EQUALS(rects.size(), 1u);
+		TS_ASSERT_EQUALS(rects[0], Common::Rect(10, 10, 40, 20));
+
+		// Adjacent rects below
+		region.addRect(Common::Rect(10, 20, 40, 25));
+		rects = getRects(region);
+		TS_ASSERT_EQUALS(rects.size(), 1u);
+		TS_ASSERT_EQUALS(rects[0], Common::Rect(10, 10, 40, 25));
+
+		// An L shape needs two rects, and no area is covered twice
+		region.addRect(Common::Rect(10, 25, 20, 40));
+		rects = getRects(region);
+		TS_ASSERT_EQUALS(rects.size(), 2u);
+		TS_ASSERT_EQUALS(area(rects), 30u * 15u + 10u * 15u);
+
+		region.clear();
+		TS_ASSERT(region.empty());
+		TS_ASSERT(getRects(region).empty());
+	}
+
+	void test_tiles() {
+		Graphics::DirtyRegion region(8, 8);
+		region.setBounds(Common::Rect(5, 5, 101, 101));
+
+		// Rounded up to whole tiles, relative to the bounds
+		region.addRect(Common::Rect(14, 14, 15, 15));
+		Common::Array<Common::Rect> rects = getRects(region);
+		TS_ASSERT_EQUALS(rects.size(), 1u);
+		TS_ASSERT_EQUALS(rects[0], Common::Rect(13, 13, 21, 21));
+
+		// Clipped to the bounds
+		region.clear();
+		region.addRect(Common::Rect(0, 90, 200, 200));
+		rects = getRects(region);
+		TS_ASSERT_EQUALS(rects.size(), 1u);
+		TS_ASSERT_EQUALS(rects[0], Common::Rect(5, 85, 101, 101));
+	}
+
+	void test_full_update_threshold() {
+		Graphics::DirtyRegion region(10, 10);
+		region.setBounds(Common::Rect(100, 100));
+		region.setFullUpdateThreshold(50);
+
+		region.addRect(Common::Rect(0, 0, 100, 20));
+		region.addRect(Common::Rect(0, 50, 40, 60));
+		TS_ASSERT_EQUALS(getRects(region).size(), 2u);
+
+		region.addRect(Common::Rect(0, 20, 100, 40));
+		region.addRect(Common::Rect(0, 80, 100, 90));
+		Common::Array<Common::Rect> rects = getRects(region);
+		TS_ASSERT_EQUALS(rects.size(), 1u);
+		TS_ASSERT_EQUALS(rects[0], Common::Rect(100, 100));
+	}
+};
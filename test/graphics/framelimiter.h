@@ -0,0 +1,48 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/framelimiter.h"
+
+class FrameLimiterTestSuite : public CxxTest::TestSuite
+{
+public:
+	void test_percentile_empty() {
+		Graphics::FrameHistory history;
+		TS_ASSERT_EQUALS(history.size(), 0U);
+		TS_ASSERT_EQUALS(history.getPercentile(50), 0U);
+	}
+
+	void test_percentile() {
+		Graphics::FrameHistory history;
+		// Added out of order, 1 to 100
+		for (uint32 i = 0; i < 100; ++i)
+			history.add((i * 37) % 100 + 1);
+
+		TS_ASSERT_EQUALS(history.size(), 100U);
+		TS_ASSERT_EQUALS(history.getPercentile(0), 1U);
+		TS_ASSERT_EQUALS(history.getPercentile(50), 50U);
+		TS_ASSERT_EQUALS(history.getPercentile(90), 90U);
+		TS_ASSERT_EQUALS(history.getPercentile(99), 99U);
+		TS_ASSERT_EQUALS(history.getPercentile(100), 100U);
+	}
+
+	void test_history_wraps() {
+		Graphics::FrameHistory history;
+		// Only the most recent measurements are kept
+		for (uint i = 0; i < Graphics::FrameHistory::kSize; ++i)
+			history.add(1000);
+		for (uint i = 0; i < Graphics::FrameHistory::kSize; ++i)
+			history.add(16);
+
+		TS_ASSERT_EQUALS(history.size(), Graphics::FrameHistory::kSize);
+		TS_ASSERT_EQUALS(history.getPercentile(100), 16U);
+		TS_ASSERT_EQUALS(history.getRecent(0), 16U);
+		TS_ASSERT_EQUALS(history.getRecent(Graphics::FrameHistory::kSize - 1), 16U);
+
+		history.add(33);
+		TS_ASSERT_EQUALS(history.getRecent(0), 33U);
+		TS_ASSERT_EQUALS(history.getRecent(1), 16U);
+
+		history.clear();
+		TS_ASSERT_EQUALS(history.size(), 0U);
+	}
+};
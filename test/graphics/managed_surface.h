@@ -0,0 +1,89 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/managed_surface.h"
+
+class ManagedSurfaceTestSuite : public CxxTest::TestSuite
+{
+private:
+	static uint32 nextRandom(uint32 &seed) {
+		seed = seed * 1103515245 + 12345;
+		return seed >> 8;
+	}
+
+	static void fillSprite(Graphics::ManagedSurface &sprite, uint32 seed, uint32 transColor) {
+		for (int y = 0; y < sprite.h; ++y) {
+			for (int x = 0; x < sprite.w; ++x) {
+				uint32 color = nextRandom(seed);
+				if (sprite.format.bytesPerPixel == 1)
+					color &= 0xFF;
+				else
+					color = sprite.format.ARGBToColor(0xFF, color, color >> 8, color >> 16);
+				if (nextRandom(seed) % 3 == 0)
+					color = transColor;
+				sprite.setPixel(x, y, color);
+			}
+		}
+	}
+
+	// Blit the sprite at a few positions, partly off the surface, with and
+	// without span caching, and check that both give the same result
+	static bool checkBlits(Graphics::ManagedSurface &sprite, uint transColor, bool destTransparent = false) {
+		static const int positions[][2] = { { 3, 2 }, { -4, -3 }, { 30, 20 }, { -40, 0 } };
+		const Common::Rect srcRects[] = { Common::Rect(sprite.w, sprite.h), Common::Rect(2, 1, sprite.w - 3, sprite.h - 1) };
+
+		Graphics::ManagedSurface plain(36, 24, sprite.format), cached(36, 24, sprite.format);
+		fillSprite(plain, 7, 0);
+		cached.blitFrom(plain);
+		if (destTransparent) {
+			plain.setTransparentColor(plain.getPixel(0, 0));
+			cached.setTransparentColor(plain.getPixel(0, 0));
+		}
+
+		for (int i = 0; i < ARRAYSIZE(positions); ++i) {
+			for (int j = 0; j < ARRAYSIZE(srcRects); ++j) {
+				const Common::Point pos(positions[i][0], positions[i][1]);
+				sprite.setSpanCaching(false);
+				plain.transBlitFrom(sprite, srcRects[j], pos, transColor);
+				sprite.setSpanCaching(true);
+				cached.transBlitFrom(sprite, srcRects[j], pos, transColor);
+			}
+		}
+
+		for (int y = 0; y < plain.h; ++y) {
+			if (memcmp(plain.getBasePtr(0, y), cached.getBasePtr(0, y), plain.w * plain.format.bytesPerPixel))
+				return false;
+		}
+		return true;
+	}
+
+public:
+	void test_span_cache_clut8() {
+		Graphics::ManagedSurface sprite(17, 11);
+		fillSprite(sprite, 1, 0);
+		TS_ASSERT(checkBlits(sprite, 0));
+		TS_ASSERT(checkBlits(sprite, 3));
+
+		// Drawing to the sprite drops its spans
+		sprite.setSpanCaching(true);
+		TS_ASSERT(checkBlits(sprite, 0));
+		sprite.fillRect(Common::Rect(2, 2, 9, 6), 0);
+		TS_ASSERT(checkBlits(sprite, 0));
+	}
+
+	void test_span_cache_rgba() {
+		const Graphics::PixelFormat format(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		Graphics::ManagedSurface sprite(17, 11, format);
+		const uint32 transColor = format.ARGBToColor(0xFF, 0xFF, 0x00, 0xFF);
+		fillSprite(sprite, 2, transColor);
+		TS_ASSERT(checkBlits(sprite, transColor));
+		TS_ASSERT(checkBlits(sprite, transColor, true));
+
+		// Pixels with zero or partial alpha
+		sprite.setPixel(3, 3, format.ARGBToColor(0x00, 0x10, 0x20, 0x30));
+		TS_ASSERT(checkBlits(sprite, transColor));
+		TS_ASSERT(checkBlits(sprite, transColor, true));
+		sprite.setPixel(4, 3, format.ARGBToColor(0x80, 0x10, 0x20, 0x30));
+		sprite.markAllDirty();
+		TS_ASSERT(checkBlits(sprite, transColor));
+	}
+};
@@ -0,0 +1,125 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/scalerplugin.h"
+#include "graphics/scaler/normal.h"
+#ifdef USE_HQ_SCALERS
+#include "graphics/scaler/hq.h"
+#endif
+
+class ScalerPluginTestSuite : public CxxTest::TestSuite
+{
+private:
+	// Runs the jobs one after the other, last job first
+	class ReversePool : public Common::ThreadPool {
+	public:
+		ReversePool(uint threads) : _threads(threads), _runs(0), _jobs(0) {}
+
+		uint getThreadCount() const { return _threads; }
+		void run(void (*proc)(void *data, uint job), void *data, uint count) {
+			++_runs;
+			_jobs += count;
+			for (uint job = count; job-- > 0;)
+				proc(data, job);
+		}
+
+		uint _threads;
+		uint _runs;
+		uint _jobs;
+	};
+
+	static uint32 nextRandom(uint32 &seed) {
+		seed = seed * 1103515245 + 12345;
+		return seed >> 8;
+	}
+
+	// Scale a random source with and without the pool, and check that both
+	// give the same result
+	static bool checkScale(ScalerPluginObject &scaler, ReversePool &pool, int width, int height) {
+		const Graphics::PixelFormat format(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		const int border = scaler.extraPixels();
+		const int factor = scaler.getFactor();
+
+		Graphics::Surface src, plain, banded;
+		src.create(width + border * 2, height + border * 2, format);
+		plain.create(width * factor, height * factor, format);
+		banded.create(width * factor, height * factor, format);
+
+		uint32 seed = width * height;
+		for (int y = 0; y < src.h; ++y) {
+			for (int x = 0; x < src.w; ++x) {
+				// Few different colors, so that the scalers blend edges
+				src.setPixel(x, y, (nextRandom(seed) % 4) * 0x4208);
+			}
+		}
+
+		const uint8 *srcPtr = (const uint8 *)src.getBasePtr(border, border);
+
+		scaler.setThreadPool(nullptr);
+		scaler.scale(srcPtr, src.pitch, (uint8 *)plain.getPixels(), plain.pitch, width, height, 0, 0);
+		scaler.setThreadPool(&pool);
+		scaler.scale(srcPtr, src.pitch, (uint8 *)banded.getPixels(), banded.pitch, width, height, 0, 0);
+		scaler.setThreadPool(nullptr);
+
+		bool equal = true;
+		for (int y = 0; y < plain.h && equal; ++y)
+			equal = !memcmp(plain.getBasePtr(0, y), banded.getBasePtr(0, y), plain.w * format.bytesPerPixel);
+
+		src.free();
+		plain.free();
+		banded.free();
+		return equal;
+	}
+
+public:
+	void test_normal_bands() {
+		NormalPlugin normal;
+		normal.initialize(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+		normal.setFactor(3);
+
+		ReversePool pool(4);
+		TS_ASSERT(checkScale(normal, pool, 320, 200));
+		TS_ASSERT_EQUALS(pool._runs, 1u);
+		TS_ASSERT_EQUALS(pool._jobs, 4u);
+
+		// Too few lines for more than two bands
+		TS_ASSERT(checkScale(normal, pool, 17, 37));
+		TS_ASSERT_EQUALS(pool._runs, 2u);
+		TS_ASSERT_EQUALS(pool._jobs, 6u);
+
+		// Too few lines for bands at all
+		TS_ASSERT(checkScale(normal, pool, 320, 31));
+		TS_ASSERT_EQUALS(pool._runs, 2u);
+
+		normal.deinitialize();
+	}
+
+	void test_single_thread() {
+		NormalPlugin normal;
+		normal.initialize(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+		normal.setFactor(2);
+
+		ReversePool pool(1);
+		TS_ASSERT(checkScale(normal, pool, 320, 200));
+		TS_ASSERT_EQUALS(pool._runs, 0u);
+
+		normal.deinitialize();
+	}
+
+	void test_hq_bands() {
+#ifdef USE_HQ_SCALERS
+		HQPlugin hq;
+		hq.initialize(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+
+		for (uint factor = 2; factor <= 3; ++factor) {
+			hq.setFactor(factor);
+
+			// Bands read the lines next to them for the edges
+			ReversePool pool(3);
+			TS_ASSERT(checkScale(hq, pool, 64, 100));
+			TS_ASSERT_EQUALS(pool._runs, hq.canScaleInBands() ? 1u : 0u);
+		}
+
+		hq.deinitialize();
+#endif
+	}
+};
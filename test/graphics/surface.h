@@ -0,0 +1,145 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/surface.h"
+#include "graphics/transform_struct.h"
+
+class SurfaceTestSuite : public CxxTest::TestSuite
+{
+private:
+	static void fillRandom(Graphics::Surface &surface, uint32 seed) {
+		for (int y = 0; y < surface.h; ++y) {
+			byte *line = (byte *)surface.getBasePtr(0, y);
+			for (int x = 0; x < surface.w * surface.format.bytesPerPixel; ++x) {
+				seed = seed * 1103515245 + 12345;
+				line[x] = seed >> 16;
+			}
+		}
+	}
+
+	static bool equalSurfaces(const Graphics::Surface &a, const Graphics::Surface &b) {
+		if (a.w != b.w || a.h != b.h || a.format != b.format)
+			return false;
+		for (int y = 0; y < a.h; ++y) {
+			if (memcmp(a.getBasePtr(0, y), b.getBasePtr(0, y), a.w * a.format.bytesPerPixel))
+				return false;
+		}
+		return true;
+	}
+
+	static byte interpolate(byte c01, byte c00, byte c11, byte c10, int ex, int ey) {
+		int t1 = ((((c01 - c00) * ex) >> 16) + c00) & 0xff;
+		int t2 = ((((c11 - c10) * ex) >> 16) + c10) & 0xff;
+		return (((t2 - t1) * ey) >> 16) + t1;
+	}
+
+	// The source position of each destination pixel in 16.16 fixed point,
+	// the way scaleBlitBilinear steps through them
+	static int sourcePosition(int dst, int srcSize, int dstSize) {
+		const int step = (int)(65536.0f * (float)(srcSize - 1) / (float)(dstSize - 1));
+		return MIN(dst * step, (srcSize << 16) - 1);
+	}
+
+	// Scale with filtering, and compare each component with the
+	// interpolation of its neighbours
+	static bool checkBilinear(const Graphics::PixelFormat &format, int srcW, int srcH, int dstW, int dstH) {
+		Graphics::Surface src, dst;
+		src.create(srcW, srcH, format);
+		fillRandom(src, srcW * srcH);
+		src.scale(dst, dstW, dstH, true);
+
+		bool equal = dst.w == dstW && dst.h == dstH;
+		for (int y = 0; y < dstH && equal; ++y) {
+			const int sy = sourcePosition(y, srcH, dstH);
+			const int cy = sy >> 16;
+			const int ny = MIN(cy + 1, srcH - 1);
+			for (int x = 0; x < dstW && equal; ++x) {
+				const int sx = sourcePosition(x, srcW, dstW);
+				const int cx = sx >> 16;
+				const int nx = MIN(cx + 1, srcW - 1);
+
+				byte c00[4], c01[4], c10[4], c11[4], expected[4];
+				format.colorToARGB(src.getPixel(cx, cy), c00[0], c00[1], c00[2], c00[3]);
+				format.colorToARGB(src.getPixel(nx, cy), c01[0], c01[1], c01[2], c01[3]);
+				format.colorToARGB(src.getPixel(cx, ny), c10[0], c10[1], c10[2], c10[3]);
+				format.colorToARGB(src.getPixel(nx, ny), c11[0], c11[1], c11[2], c11[3]);
+				for (int i = 0; i < 4; ++i)
+					expected[i] = interpolate(c01[i], c00[i], c11[i], c10[i], sx & 0xffff, sy & 0xffff);
+				equal = dst.getPixel(x, y) == format.ARGBToColor(expected[0], expected[1], expected[2], expected[3]);
+			}
+		}
+
+		src.free();
+		dst.free();
+		return equal;
+	}
+
+public:
+	void test_scale_bilinear() {
+		const Graphics::PixelFormat rgba(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		const Graphics::PixelFormat abgr(4, 8, 8, 8, 8, 0, 8, 16, 24);
+		TS_ASSERT(checkBilinear(rgba, 17, 13, 40, 29));
+		TS_ASSERT(checkBilinear(rgba, 40, 29, 17, 13));
+		TS_ASSERT(checkBilinear(abgr, 31, 7, 32, 9));
+	}
+
+	void test_scale_nearest() {
+		const Graphics::PixelFormat format(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		Graphics::Surface src, dst;
+		src.create(13, 7, format);
+		fillRandom(src, 1);
+
+		src.scale(dst, 30, 20);
+		for (int y = 0; y < dst.h; ++y) {
+			for (int x = 0; x < dst.w; ++x)
+				TS_ASSERT_EQUALS(dst.getPixel(x, y), src.getPixel(x * src.w / dst.w, y * src.h / dst.h));
+		}
+
+		// Scaling into a surface of the right size reuses it
+		const void *pixels = dst.getPixels();
+		fillRandom(src, 2);
+		src.scale(dst, 30, 20);
+		TS_ASSERT_EQUALS(dst.getPixels(), pixels);
+		TS_ASSERT_EQUALS(dst.getPixel(29, 19), src.getPixel(12, 6));
+
+		src.free();
+		dst.free();
+	}
+
+	void test_scale_identity() {
+		const Graphics::PixelFormat format(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		Graphics::Surface src, nearest, bilinear;
+		src.create(21, 11, format);
+		fillRandom(src, 3);
+
+		src.scale(nearest, 21, 11);
+		src.scale(bilinear, 21, 11, true);
+		TS_ASSERT(equalSurfaces(src, nearest));
+		TS_ASSERT(equalSurfaces(src, bilinear));
+
+		src.free();
+		nearest.free();
+		bilinear.free();
+	}
+
+	void test_rotoscale_reuse() {
+		const Graphics::PixelFormat format(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		Graphics::Surface src, reused;
+		src.create(24, 16, format);
+		fillRandom(src, 4);
+
+		Graphics::TransformStruct transform(120, 80, 30);
+		for (int filtering = 0; filtering < 2; ++filtering) {
+			// The corners of the reused surface are cleared like fresh ones
+			if (reused.getPixels())
+				memset(reused.getPixels(), 0xff, reused.pitch * reused.h);
+			src.rotoscale(reused, transform, filtering);
+			Graphics::Surface *fresh = src.rotoscale(transform, filtering);
+			TS_ASSERT(equalSurfaces(*fresh, reused));
+			fresh->free();
+			delete fresh;
+		}
+
+		src.free();
+		reused.free();
+	}
+};
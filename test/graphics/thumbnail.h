@@ -0,0 +1,48 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/surface.h"
+#include "graphics/thumbnail.h"
+
+#include "common/memstream.h"
+
+class ThumbnailTestSuite : public CxxTest::TestSuite
+{
+	static void roundTrip(const Graphics::PixelFormat &format) {
+		Graphics::Surface thumb;
+		thumb.create(5, 3, format);
+		for (int y = 0; y < thumb.h; ++y) {
+			for (int x = 0; x < thumb.w; ++x)
+				thumb.setPixel(x, y, format.RGBToColor(x * 40, y * 80, (x + y) * 20));
+		}
+
+		Common::MemoryWriteStreamDynamic out(DisposeAfterUse::YES);
+		TS_ASSERT(Graphics::saveThumbnail(out, thumb));
+
+		Common::MemoryReadStream in(out.getData(), out.size());
+		Graphics::Surface *loaded = nullptr;
+		TS_ASSERT(Graphics::loadThumbnail(in, loaded));
+		TS_ASSERT(loaded);
+		TS_ASSERT_EQUALS(in.pos(), (int64)out.size());
+
+		TS_ASSERT_EQUALS(loaded->w, thumb.w);
+		TS_ASSERT_EQUALS(loaded->h, thumb.h);
+		TS_ASSERT(loaded->format == format);
+		for (int y = 0; y < thumb.h; ++y) {
+			for (int x = 0; x < thumb.w; ++x)
+				TS_ASSERT_EQUALS(loaded->getPixel(x, y), thumb.getPixel(x, y));
+		}
+
+		loaded->free();
+		delete loaded;
+		thumb.free();
+	}
+
+public:
+	void test_round_trip_16bpp() {
+		roundTrip(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+	}
+
+	void test_round_trip_32bpp() {
+		roundTrip(Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+	}
+};
@@ -0,0 +1,152 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/tinygl/zgl.h"
+#include "graphics/tinygl/zbuffer.h"
+
+class TinyGLTestSuite : public CxxTest::TestSuite
+{
+private:
+#ifdef USE_TINYGL
+	static const int kWidth = 96;
+	static const int kHeight = 72;
+	static const int kFrames = 8;
+
+	static void drawTriangle(float x, float y, float size, float r, float g, float b) {
+		tglColor3f(r, g, b);
+		tglBegin(TGL_TRIANGLES);
+		tglVertex3f(x, y, 0.0f);
+		tglVertex3f(x + size, y, 0.0f);
+		tglVertex3f(x, y + size, 0.0f);
+		tglEnd();
+	}
+
+	// A static background, a triangle moving across it, and one blinking
+	static void drawFrame(int frame) {
+		tglClearColor(0.0f, 0.0f, 0.25f, 1.0f);
+		tglClear(TGL_COLOR_BUFFER_BIT | TGL_DEPTH_BUFFER_BIT);
+
+		drawTriangle(-0.9f, -0.9f, 1.5f, 0.2f, 0.6f, 0.2f);
+		drawTriangle(-1.0f + frame * 0.2f, -0.2f, 0.4f, 1.0f, 0.0f, 0.0f);
+		if (frame & 2)
+			drawTriangle(0.5f, 0.6f, 0.3f, 1.0f, 1.0f, 0.0f);
+		drawTriangle(0.1f, -0.8f, 0.2f + (frame == 5 ? 0.3f : 0.0f), 0.0f, 1.0f, 1.0f);
+
+		TinyGL::tglPresentBuffer();
+	}
+
+	// Render all frames, keeping a copy of each
+	static void renderFrames(bool dirtyRects, byte *frames) {
+		TinyGL::FrameBuffer *zb = new TinyGL::FrameBuffer(kWidth, kHeight, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+		TinyGL::glInit(zb, 256);
+		tglEnableDirtyRects(dirtyRects);
+		tglViewport(0, 0, kWidth, kHeight);
+		tglDisable(TGL_DEPTH_TEST);
+		tglShadeModel(TGL_FLAT);
+
+		for (int frame = 0; frame < kFrames; ++frame) {
+			drawFrame(frame);
+			memcpy(frames + frame * kWidth * kHeight * 4, zb->getPixelBuffer(), kWidth * kHeight * 4);
+		}
+
+		TinyGL::glClose();
+		delete zb;
+	}
+
+	static uint32 nextRandom(uint32 &seed) {
+		seed = seed * 1103515245 + 12345;
+		return seed >> 8;
+	}
+
+	static void fillTriangles(TinyGL::FrameBuffer *zb, int mode, uint32 seed) {
+		for (int i = 0; i < 16; ++i) {
+			TinyGL::ZBufferPoint p[3];
+			for (int j = 0; j < 3; ++j) {
+				p[j].x = nextRandom(seed) % kWidth;
+				p[j].y = nextRandom(seed) % kHeight;
+				p[j].z = nextRandom(seed) % (1 << 24);
+				p[j].r = nextRandom(seed) % (1 << 16);
+				p[j].g = nextRandom(seed) % (1 << 16);
+				p[j].b = nextRandom(seed) % (1 << 16);
+				p[j].a = nextRandom(seed) % (1 << 16);
+			}
+
+			// Twice, so that the equal depth functions have something to pass
+			for (int pass = 0; pass < 2; ++pass) {
+				if (mode == 0)
+					zb->fillTriangleFlat(&p[0], &p[1], &p[2]);
+				else if (mode == 1)
+					zb->fillTriangleSmooth(&p[0], &p[1], &p[2]);
+				else
+					zb->fillTriangleDepthOnly(&p[0], &p[1], &p[2]);
+				p[0].r = p[1].g = p[2].b = 0;
+			}
+		}
+	}
+
+	// Fill triangles with and without a scissor rectangle covering the
+	// screen, which takes the per pixel path, and compare the buffers
+	static bool checkTriangles(const Graphics::PixelFormat &format, int depthFunc, bool depthWrite) {
+		TinyGL::FrameBuffer *buffers[2];
+		for (int i = 0; i < 2; ++i) {
+			TinyGL::FrameBuffer *zb = new TinyGL::FrameBuffer(kWidth, kHeight, format);
+			zb->clear(0, 0, 1, 20, 40, 60);
+			uint32 seed = 1;
+			for (int pixel = 0; pixel < kWidth * kHeight; ++pixel)
+				zb->getZBuffer()[pixel] = nextRandom(seed) % (1 << 24);
+			zb->enableDepthTest(depthFunc != 0);
+			zb->setDepthFunc(depthFunc);
+			zb->enableDepthWrite(depthWrite);
+			if (i == 1)
+				zb->setScissorRectangle(Common::Rect(kWidth, kHeight));
+
+			for (int mode = 0; mode < 3; ++mode)
+				fillTriangles(zb, mode, mode + 2);
+			buffers[i] = zb;
+		}
+
+		const bool equal = !memcmp(buffers[0]->getPixelBuffer(), buffers[1]->getPixelBuffer(), kWidth * kHeight * format.bytesPerPixel) &&
+		                   !memcmp(buffers[0]->getZBuffer(), buffers[1]->getZBuffer(), kWidth * kHeight * sizeof(unsigned int));
+		delete buffers[0];
+		delete buffers[1];
+		return equal;
+	}
+#endif
+
+public:
+	void test_dirty_rects() {
+#ifdef USE_TINYGL
+		// Redrawing only the dirty rectangles gives the same frames as
+		// redrawing everything
+		byte *dirty = new byte[kFrames * kWidth * kHeight * 4];
+		byte *full = new byte[kFrames * kWidth * kHeight * 4];
+		renderFrames(true, dirty);
+		renderFrames(false, full);
+
+		for (int frame = 0; frame < kFrames; ++frame)
+			TS_ASSERT(!memcmp(dirty + frame * kWidth * kHeight * 4, full + frame * kWidth * kHeight * 4, kWidth * kHeight * 4));
+
+		delete[] dirty;
+		delete[] full;
+#endif
+	}
+
+	void test_fill_triangles() {
+#ifdef USE_TINYGL
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 0, 8, 16, 0)
+		};
+		const int depthFuncs[] = {
+			0, TGL_NEVER, TGL_LESS, TGL_EQUAL, TGL_LEQUAL, TGL_GREATER, TGL_NOTEQUAL, TGL_GEQUAL, TGL_ALWAYS
+		};
+
+		for (int format = 0; format < ARRAYSIZE(formats); ++format) {
+			for (int func = 0; func < ARRAYSIZE(depthFuncs); ++func) {
+				TS_ASSERT(checkTriangles(formats[format], depthFuncs[func], true));
+				TS_ASSERT(checkTriangles(formats[format], depthFuncs[func], false));
+			}
+		}
+#endif
+	}
+};
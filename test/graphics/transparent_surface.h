@@ -0,0 +1,113 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/transparent_surface.h"
+
+class TransparentSurfaceTestSuite : public CxxTest::TestSuite
+{
+private:
+	enum {
+		kAlpha = 0, kBlue = 8, kGreen = 16, kRed = 24
+	};
+
+	static uint32 component(uint32 color, int shift) {
+		return (color >> shift) & 0xFF;
+	}
+
+	// The color of a pixel after blitting, following the formulas of
+	// the unoptimized blitting code
+	static uint32 blendPixel(uint32 src, uint32 dst, Graphics::AlphaType alphaMode, uint32 color) {
+		const uint32 a = component(src, kAlpha);
+		static const int shifts[3] = { kBlue, kGreen, kRed };
+
+		if (color == 0xFFFFFFFF && alphaMode == Graphics::ALPHA_OPAQUE)
+			return src | 0xFF;
+		if (color == 0xFFFFFFFF && alphaMode == Graphics::ALPHA_BINARY)
+			return a ? src | 0xFF : dst;
+
+		uint32 result = 0xFF;
+		if (color == 0xFFFFFFFF) {
+			if (!a)
+				return dst;
+			for (int i = 0; i < 3; ++i)
+				result |= ((component(src, shifts[i]) * a + component(dst, shifts[i]) * (255 - a)) >> 8) << shifts[i];
+		} else {
+			const uint32 ina = a * component(color, kAlpha) >> 8;
+			if (!ina)
+				return dst;
+			for (int i = 0; i < 3; ++i) {
+				const uint32 faded = component(dst, shifts[i]) * (255 - ina) >> 8;
+				result |= (faded + (component(src, shifts[i]) * ina * component(color, shifts[i]) >> 16)) << shifts[i];
+			}
+		}
+		return result;
+	}
+
+	static uint32 nextRandom(uint32 &seed) {
+		seed = seed * 1103515245 + 12345;
+		return (seed >> 16) | (seed << 16);
+	}
+
+	static bool checkBlit(Graphics::AlphaType alphaMode, int flipping, uint32 color) {
+		const Graphics::PixelFormat format(4, 8, 8, 8, 8, kRed, kGreen, kBlue, kAlpha);
+		const int w = 23, h = 4, posX = 2, posY = 1;
+		uint32 seed = 1;
+
+		Graphics::TransparentSurface src;
+		src.create(w, h, format);
+		src.setAlphaMode(alphaMode);
+		for (int y = 0; y < h; ++y) {
+			for (int x = 0; x < w; ++x) {
+				uint32 pixel = nextRandom(seed);
+				// Make fully transparent and opaque pixels common
+				if (x % 3 == 0)
+					pixel &= ~0xFF;
+				else if (x % 3 == 1)
+					pixel |= 0xFF;
+				*(uint32 *)src.getBasePtr(x, y) = pixel;
+			}
+		}
+
+		Graphics::Surface dst;
+		dst.create(w + 5, h + 2, format);
+		for (int y = 0; y < dst.h; ++y) {
+			for (int x = 0; x < dst.w; ++x)
+				*(uint32 *)dst.getBasePtr(x, y) = nextRandom(seed);
+		}
+
+		Graphics::Surface expected;
+		expected.copyFrom(dst);
+		for (int y = 0; y < h; ++y) {
+			for (int x = 0; x < w; ++x) {
+				const int srcX = (flipping & Graphics::FLIP_H) ? w - 1 - x : x;
+				const int srcY = (flipping & Graphics::FLIP_V) ? h - 1 - y : y;
+				uint32 *pixel = (uint32 *)expected.getBasePtr(posX + x, posY + y);
+				*pixel = blendPixel(*(const uint32 *)src.getBasePtr(srcX, srcY), *pixel, alphaMode, color);
+			}
+		}
+
+		src.blit(dst, posX, posY, flipping, nullptr, color);
+		const bool ok = !memcmp(dst.getPixels(), expected.getPixels(), dst.pitch * dst.h);
+
+		src.free();
+		dst.free();
+		expected.free();
+		return ok;
+	}
+
+public:
+	void test_blit() {
+		static const Graphics::AlphaType alphaModes[3] = {
+			Graphics::ALPHA_OPAQUE, Graphics::ALPHA_BINARY, Graphics::ALPHA_FULL
+		};
+		static const uint32 colors[3] = { 0xFFFFFFFF, 0xC0FF40FF, 0x80A0F0C0 };
+
+		for (int mode = 0; mode < 3; ++mode) {
+			for (int flipping = 0; flipping < 4; ++flipping) {
+				for (int color = 0; color < 3; ++color) {
+					TSM_ASSERT(Common::String::format("alpha mode %d, flipping %d, color %08x", mode, flipping, colors[color]).c_str(),
+					           checkBlit(alphaModes[mode], flipping, colors[color]));
+				}
+			}
+		}
+	}
+};
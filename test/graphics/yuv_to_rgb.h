@@ -0,0 +1,108 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/yuv_to_rgb.h"
+
+class YUVToRGBTestSuite : public CxxTest::TestSuite
+{
+private:
+	static uint32 nextRandom(uint32 &seed) {
+		seed = seed * 1103515245 + 12345;
+		return seed >> 8;
+	}
+
+	static int clampComponent(int value, Graphics::YUVToRGBManager::LuminanceScale scale) {
+		if (scale == Graphics::YUVToRGBManager::kScaleFull)
+			return CLIP(value, 0, 255);
+		return (CLIP(value, 16, 235) - 16) * 255 / 219;
+	}
+
+	// The conversion the lookup tables implement
+	static uint32 convertPixel(const Graphics::PixelFormat &format, Graphics::YUVToRGBManager::LuminanceScale scale, int y, int u, int v) {
+		const int16 cr = v - 128, cb = u - 128;
+		const int r = y + (int16)((0.419 / 0.299) * cr);
+		const int g = y + (int16)(-(0.299 / 0.419) * cr) + (int16)(-(0.114 / 0.331) * cb);
+		const int b = y + (int16)((0.587 / 0.331) * cb);
+		return format.ARGBToColor(255, clampComponent(r, scale), clampComponent(g, scale), clampComponent(b, scale));
+	}
+
+	static uint32 getPixel(const Graphics::Surface &surface, int x, int y) {
+		if (surface.format.bytesPerPixel == 2)
+			return *(const uint16 *)surface.getBasePtr(x, y);
+		return *(const uint32 *)surface.getBasePtr(x, y);
+	}
+
+	static void fillPlane(byte *plane, int size, uint32 seed) {
+		for (int i = 0; i < size; ++i)
+			plane[i] = nextRandom(seed);
+		// Extremes, where clamping sets in
+		plane[0] = 0;
+		plane[1] = 255;
+	}
+
+	// Convert random planes of each subsampling mode, and compare each
+	// pixel with the reference conversion
+	static bool checkConversions(const Graphics::PixelFormat &format, Graphics::YUVToRGBManager::LuminanceScale scale) {
+		// Not a multiple of the vector width, and with padding in the pitches
+		const int width = 44, height = 8;
+		const int yPitch = width + 5, uvPitch = width + 3;
+
+		byte ySrc[yPitch * height], uSrc[uvPitch * (height + 1)], vSrc[uvPitch * (height + 1)];
+		fillPlane(ySrc, sizeof(ySrc), 1);
+		fillPlane(uSrc, sizeof(uSrc), 2);
+		fillPlane(vSrc, sizeof(vSrc), 3);
+
+		Graphics::Surface dst;
+		dst.create(width, height, format);
+
+		bool equal = true;
+		for (int mode = 0; mode < 3; ++mode) {
+			memset(dst.getPixels(), 0, dst.pitch * dst.h);
+			if (mode == 0)
+				YUVToRGBMan.convert444(&dst, scale, ySrc, uSrc, vSrc, width, height, yPitch, uvPitch);
+			else if (mode == 1)
+				YUVToRGBMan.convert420(&dst, scale, ySrc, uSrc, vSrc, width, height, yPitch, uvPitch);
+			else
+				YUVToRGBMan.convert410(&dst, scale, ySrc, uSrc, vSrc, width, height, yPitch, uvPitch);
+
+			for (int y = 0; y < height; ++y) {
+				for (int x = 0; x < width; ++x) {
+					int u, v;
+					if (mode == 0) {
+						u = uSrc[y * uvPitch + x];
+						v = vSrc[y * uvPitch + x];
+					} else if (mode == 1) {
+						u = uSrc[(y / 2) * uvPitch + x / 2];
+						v = vSrc[(y / 2) * uvPitch + x / 2];
+					} else {
+						const int index = (y / 4) * uvPitch + x / 4;
+						const int xDiff = x & 3, yDiff = y & 3;
+						u = (uSrc[index] * (4 - xDiff) * (4 - yDiff) + uSrc[index + 1] * xDiff * (4 - yDiff) +
+						     uSrc[index + uvPitch] * yDiff * (4 - xDiff) + uSrc[index + uvPitch + 1] * xDiff * yDiff) >> 4;
+						v = (vSrc[index] * (4 - xDiff) * (4 - yDiff) + vSrc[index + 1] * xDiff * (4 - yDiff) +
+						     vSrc[index + uvPitch] * yDiff * (4 - xDiff) + vSrc[index + uvPitch + 1] * xDiff * yDiff) >> 4;
+					}
+
+					if (getPixel(dst, x, y) != convertPixel(format, scale, ySrc[y * yPitch + x], u, v))
+						equal = false;
+				}
+			}
+		}
+
+		dst.free();
+		return equal;
+	}
+
+public:
+	void test_full_range() {
+		TS_ASSERT(checkConversions(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0), Graphics::YUVToRGBManager::kScaleFull));
+		TS_ASSERT(checkConversions(Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15), Graphics::YUVToRGBManager::kScaleFull));
+		TS_ASSERT(checkConversions(Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0), Graphics::YUVToRGBManager::kScaleFull));
+		TS_ASSERT(checkConversions(Graphics::PixelFormat(4, 8, 8, 8, 0, 0, 8, 16, 0), Graphics::YUVToRGBManager::kScaleFull));
+	}
+
+	void test_itu_range() {
+		TS_ASSERT(checkConversions(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0), Graphics::YUVToRGBManager::kScaleITU));
+		TS_ASSERT(checkConversions(Graphics::PixelFormat(2, 4, 4, 4, 4, 0, 4, 8, 12), Graphics::YUVToRGBManager::kScaleITU));
+		TS_ASSERT(checkConversions(Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24), Graphics::YUVToRGBManager::kScaleITU));
+	}
+};
@@ -0,0 +1,64 @@
+#include <cxxtest/TestSuite.h>
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#include "common/memstream.h"
+#include "image/png.h"
+#include "graphics/surface.h"
+
+class PNGDecoderTestSuite : public CxxTest::TestSuite {
+public:
+	void test_output_pixel_format() {
+#ifdef USE_PNG
+		const Graphics::PixelFormat inputFormat(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		const uint32 colors[4] = { 0x11223344, 0x55667788, 0x99AABBCC, 0xDDEEFF00 };
+
+		Graphics::Surface input;
+		input.create(2, 2, inputFormat);
+		for (int i = 0; i < 4; ++i)
+			*(uint32 *)input.getBasePtr(i % 2, i / 2) = colors[i];
+
+		Common::MemoryWriteStreamDynamic png(DisposeAfterUse::YES);
+		TS_ASSERT(Image::writePNG(png, input));
+		input.free();
+
+		// Formats handled by libpng, one converted afterwards and one without alpha
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 8, 16, 24, 0),
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+		};
+
+		for (int f = 0; f < ARRAYSIZE(formats); ++f) {
+			Image::PNGDecoder decoder;
+			decoder.setOutputPixelFormat(formats[f]);
+
+			Common::MemoryReadStream stream(png.getData(), png.size());
+			TS_ASSERT(decoder.loadStream(stream));
+
+			const Graphics::Surface *surface = decoder.getSurface();
+			TS_ASSERT_EQUALS(surface->format, formats[f]);
+
+			for (int i = 0; i < 4; ++i) {
+				uint32 color = surface->format.bytesPerPixel == 2 ?
+					*(const uint16 *)surface->getBasePtr(i % 2, i / 2) :
+					*(const uint32 *)surface->getBasePtr(i % 2, i / 2);
+				byte a, r, g, b;
+				surface->format.colorToARGB(color, a, r, g, b);
+
+				byte ea, er, eg, eb;
+				inputFormat.colorToARGB(colors[i], ea, er, eg, eb);
+				if (surface->format.aLoss != 8)
+					TS_ASSERT_EQUALS(a, ea);
+				TS_ASSERT_EQUALS(r >> surface->format.rLoss, er >> surface->format.rLoss);
+				TS_ASSERT_EQUALS(g >> surface->format.gLoss, eg >> surface->format.gLoss);
+				TS_ASSERT_EQUALS(b >> surface->format.bLoss, eb >> surface->format.bLoss);
+			}
+		}
+#endif
+	}
+};
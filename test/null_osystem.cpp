@@ -2,9 +2,12 @@
 #define NULL_DRIVER_USE_FOR_TEST 1
 #include "null_osystem.h"
 #include "../backends/platform/null/null.cpp"
+#include "../backends/mixer/null/null-mixer.cpp"
 
 void Common::install_null_g_system() {
-	g_system = OSystem_NULL_create();
+	OSystem_NULL *system = new OSystem_NULL();
+	g_system = system;
+	system->initTestBackend();
 }
 
 bool BaseBackend::setScaler(const char *name, int factor) {
@@ -462,6 +462,7 @@ bool AVIDecoder::loadStream(Common::SeekableReadStream *stream) {
 		status.track = *it;
 		status.index = index;
 		status.chunkSearchOffset = _movieListStart;
+		buildChunkIndex(status);
 
 		if ((*it)->getTrackType() == Track::kTrackTypeAudio) {
 			_audioTracks.push_back(status);
@@ -695,45 +696,64 @@ bool AVIDecoder::seekIntern(const Audio::Timestamp &time) {
 	int frameIndex = -1;
 	uint curFrame = 0;
 
-	// Go through and figure out where we should be
-	// If there's a palette, we need to find the palette too
-	for (uint32 i = 0; i < _indexEntries.size(); i++) {
-		const OldIndex &index = _indexEntries[i];
+	const TrackStatus &videoStatus = _videoTracks[0];
+	if (!videoStatus.hasPaletteChanges) {
+		// Look up the frame and the last keyframe before it in the chunk index
+		if (frame < videoStatus.chunks.size()) {
+			uint32 lo = 0, hi = videoStatus.keyFrames.size();
+			while (lo < hi) {
+				uint32 mid = (lo + hi) / 2;
+				if (videoStatus.keyFrames[mid] <= frame)
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
 
-		// We don't care about RECs
-		if (index.id == ID_REC)
-			continue;
+			assert(lo > 0);
+			lastKeyFrame = videoStatus.chunks[videoStatus.keyFrames[lo - 1]];
+			frameIndex = videoStatus.chunks[frame];
+		}
+	} else {
+		// Go through and figure out where we should be
+		// If there's a palette, we need to find the palette too
+		for (uint32 i = 0; i < _indexEntries.size(); i++) {
+			const OldIndex &index = _indexEntries[i];
 
-		// We're only looking at entries for this track
-		if (getStreamIndex(index.id) != videoIndex)
-			continue;
+			// We don't care about RECs
+			if (index.id == ID_REC)
+				continue;
 
-		uint16 streamType = getStreamType(index.id);
+			// We're only looking at entries for this track
+			if (getStreamIndex(index.id) != videoIndex)
+				continue;
 
-		if (streamType == kStreamTypePaletteChange) {
-			// We need to handle any palette change we see since there's no
-			// flag to tell if this is a "key" palette.
-			// Decode the palette
-			_fileStream->seek(_indexEntries[i].offset + 8);
-			Common::SeekableReadStream *chunk = 0;
+			uint16 streamType = getStreamType(index.id);
 
-			if (_indexEntries[i].size != 0)
-				chunk = _fileStream->readStream(_indexEntries[i].size);
+			if (streamType == kStreamTypePaletteChange) {
+				// We need to handle any palette change we see since there's no
+				// flag to tell if this is a "key" palette.
+				// Decode the palette
+				_fileStream->seek(_indexEntries[i].offset + 8);
+				Common::SeekableReadStream *chunk = 0;
 
-			videoTrack->loadPaletteFromChunk(chunk);
-		} else {
-			// Check to see if this is a keyframe
-			// The first frame has to be a keyframe
-			if ((_indexEntries[i].flags & AVIIF_INDEX) || curFrame == 0)
-				lastKeyFrame = i;
-
-			// Did we find the target frame?
-			if (frame == curFrame) {
-				frameIndex = i;
-				break;
-			}
+				if (_indexEntries[i].size != 0)
+					chunk = _fileStream->readStream(_indexEntries[i].size);
 
-			curFrame++;
+				videoTrack->loadPaletteFromChunk(chunk);
+			} else {
+				// Check to see if this is a keyframe
+				// The first frame has to be a keyframe
+				if ((_indexEntries[i].flags & AVIIF_INDEX) || curFrame == 0)
+					lastKeyFrame = i;
+
+				// Did we find the target frame?
+				if (frame == curFrame) {
+					frameIndex = i;
+					break;
+				}
+
+				curFrame++;
+			}
 		}
 	}
 
@@ -750,25 +770,15 @@ bool AVIDecoder::seekIntern(const Audio::Timestamp &time) {
 		// Set the chunk index for the track
 		audioTrack->setCurChunk(frame);
 
-		uint32 chunksFound = 0;
-		for (uint32 j = 0; j < _indexEntries.size(); j++) {
+		const Common::Array<uint32> &chunks = _audioTracks[i].chunks;
+		if (frame < chunks.size()) {
+			uint32 j = chunks[frame];
 			const OldIndex &index = _indexEntries[j];
 
-			// Continue ignoring RECs
-			if (index.id == ID_REC)
-				continue;
-
-			if (getStreamIndex(index.id) == _audioTracks[i].index) {
-				if (chunksFound == frame) {
-					_fileStream->seek(index.offset + 8);
-					Common::SeekableReadStream *audioChunk = _fileStream->readStream(index.size);
-					audioTrack->queueSound(audioChunk);
-					_audioTracks[i].chunkSearchOffset = (j == _indexEntries.size() - 1) ? _movieListEnd : _indexEntries[j + 1].offset;
-					break;
-				}
-
-				chunksFound++;
-			}
+			_fileStream->seek(index.offset + 8);
+			Common::SeekableReadStream *audioChunk = _fileStream->readStream(index.size);
+			audioTrack->queueSound(audioChunk);
+			_audioTracks[i].chunkSearchOffset = (j == _indexEntries.size() - 1) ? _movieListEnd : _indexEntries[j + 1].offset;
 		}
 
 		// Skip any audio to bring us to the right time
@@ -899,6 +909,26 @@ void AVIDecoder::readOldIndex(uint32 size) {
 	}
 }
 
+void AVIDecoder::buildChunkIndex(TrackStatus &status) const {
+	for (uint32 i = 0; i < _indexEntries.size(); i++) {
+		const OldIndex &index = _indexEntries[i];
+
+		if (index.id == ID_REC || getStreamIndex(index.id) != status.index)
+			continue;
+
+		if (getStreamType(index.id) == kStreamTypePaletteChange) {
+			status.hasPaletteChanges = true;
+			continue;
+		}
+
+		// The first frame has to be a keyframe
+		if ((index.flags & AVIIF_INDEX) || status.chunks.empty())
+			status.keyFrames.push_back(status.chunks.size());
+
+		status.chunks.push_back(i);
+	}
+}
+
 void AVIDecoder::checkTruemotion1() {
 	// If we got here from loadStream(), we know the track is valid
 	assert(!_videoTracks.empty());
@@ -1187,7 +1217,7 @@ void AVIDecoder::AVIAudioTrack::createAudioStream() {
 		_audioStream = Audio::makeNullAudioStream();
 }
 
-AVIDecoder::TrackStatus::TrackStatus() : track(0), chunkSearchOffset(0) {
+AVIDecoder::TrackStatus::TrackStatus() : track(0), chunkSearchOffset(0), hasPaletteChanges(false) {
 }
 
 AVIDecoder::OldIndex *AVIDecoder::IndexEntries::find(uint index, uint frameNumber) {
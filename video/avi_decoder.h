@@ -310,6 +310,12 @@ protected:
 		Track *track;
 		uint32 index;
 		uint32 chunkSearchOffset;
+
+		// Positions in the index of the track's chunks, excluding palette changes
+		Common::Array<uint32> chunks;
+		// Chunk numbers of the keyframes, in ascending order
+		Common::Array<uint32> keyFrames;
+		bool hasPaletteChanges;
 	};
 
 	class IndexEntries : public Common::Array<OldIndex> {
@@ -320,6 +326,7 @@ protected:
 	AVIHeader _header;
 
 	void readOldIndex(uint32 size);
+	void buildChunkIndex(TrackStatus &status) const;
 	IndexEntries _indexEntries;
 
 	Common::SeekableReadStream *_fileStream;
@@ -1474,15 +1474,26 @@ static inline void IDCTCol(int32 *dest, const int32 *src) {
 	}
 }
 
+template<typename T>
+static inline void IDCTRow(T *dest, const int32 *src) {
+	if ((src[1] | src[2] | src[3] | src[4] | src[5] | src[6] | src[7]) == 0) {
+		// Only the DC coefficient is set, which transforms to a flat row
+		const T value = MUNGE_ROW(src[0]);
+		for (int i = 0; i < 8; i++)
+			dest[i] = value;
+	} else {
+		IDCT_ROW(dest, src);
+	}
+}
+
 void BinkDecoder::BinkVideoTrack::IDCT(int32 *block) {
 	int i;
 	int32 temp[64];
 
 	for (i = 0; i < 8; i++)
 		IDCTCol(&temp[i], &block[i]);
-	for (i = 0; i < 8; i++) {
-		IDCT_ROW( (&block[8*i]), (&temp[8*i]) );
-	}
+	for (i = 0; i < 8; i++)
+		IDCTRow(&block[8*i], &temp[8*i]);
 }
 
 void BinkDecoder::BinkVideoTrack::IDCTAdd(DecodeContext &ctx, int32 *block) {
@@ -1500,9 +1511,8 @@ void BinkDecoder::BinkVideoTrack::IDCTPut(DecodeContext &ctx, int32 *block) {
 	int32 temp[64];
 	for (i = 0; i < 8; i++)
 		IDCTCol(&temp[i], &block[i]);
-	for (i = 0; i < 8; i++) {
-		IDCT_ROW( (&ctx.dest[i*ctx.pitch]), (&temp[8*i]) );
-	}
+	for (i = 0; i < 8; i++)
+		IDCTRow(&ctx.dest[i*ctx.pitch], &temp[8*i]);
 }
 
 BinkDecoder::BinkAudioTrack::BinkAudioTrack(BinkDecoder::AudioInfo &audio, Audio::Mixer::SoundType soundType) :
@@ -594,15 +594,17 @@ MPEGPSDecoder::MPEGVideoTrack::MPEGVideoTrack(Common::SeekableReadStream *firstP
 
 	findDimensions(firstPacket, format);
 
+	// Prefer the video decoding hardware of the platform
+	_mpegDecoder = g_system->createMPEGDecoder(_surface->w, _surface->h, _surface->format);
+
 #ifdef USE_MPEG2
-	_mpegDecoder = new Image::MPEGDecoder();
+	if (!_mpegDecoder)
+		_mpegDecoder = new Image::MPEGDecoder();
 #endif
 }
 
 MPEGPSDecoder::MPEGVideoTrack::~MPEGVideoTrack() {
-#ifdef USE_MPEG2
 	delete _mpegDecoder;
-#endif
 
 	if (_surface) {
 		_surface->free();
@@ -630,7 +632,11 @@ const Graphics::Surface *MPEGPSDecoder::MPEGVideoTrack::decodeNextFrame() {
 }
 
 bool MPEGPSDecoder::MPEGVideoTrack::sendPacket(Common::SeekableReadStream *packet, uint32 pts, uint32 dts) {
-#ifdef USE_MPEG2
+	if (!_mpegDecoder) {
+		delete packet;
+		return true;
+	}
+
 	if (pts != 0xFFFFFFFF) {
 		_framePts = pts;
 	}
@@ -653,15 +659,9 @@ bool MPEGPSDecoder::MPEGVideoTrack::sendPacket(Common::SeekableReadStream *packe
 
 		_framePts = 0xFFFFFFFF;
 	}
-#endif
 
 	delete packet;
-
-#ifdef USE_MPEG2
 	return foundFrame;
-#else
-	return true;
-#endif
 }
 
 void MPEGPSDecoder::MPEGVideoTrack::findDimensions(Common::SeekableReadStream *firstPacket, const Graphics::PixelFormat &format) {
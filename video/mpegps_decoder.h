@@ -41,7 +41,7 @@ struct PixelFormat;
 }
 
 namespace Image {
-class MPEGDecoder;
+class MPEGPacketDecoder;
 }
 
 namespace Video {
@@ -139,9 +139,8 @@ private:
 
 		void findDimensions(Common::SeekableReadStream *firstPacket, const Graphics::PixelFormat &format);
 
-#ifdef USE_MPEG2
-		Image::MPEGDecoder *_mpegDecoder;
-#endif
+		/** The backend decoder if there is one, otherwise libmpeg2, if available. */
+		Image::MPEGPacketDecoder *_mpegDecoder;
 	};
 
 #ifdef USE_MAD
@@ -681,9 +681,19 @@ uint32 QuickTimeDecoder::VideoTrackHandler::getFrameDuration() {
 }
 
 uint32 QuickTimeDecoder::VideoTrackHandler::findKeyFrame(uint32 frame) const {
-	for (int i = _parent->keyframeCount - 1; i >= 0; i--)
-		if (_parent->keyframes[i] <= frame)
-			return _parent->keyframes[i];
+	// The sync sample table is in ascending order, so look for the
+	// last keyframe not after the requested frame
+	uint32 lo = 0, hi = _parent->keyframeCount;
+	while (lo < hi) {
+		uint32 mid = (lo + hi) / 2;
+		if (_parent->keyframes[mid] <= frame)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	if (lo > 0)
+		return _parent->keyframes[lo - 1];
 
 	// If none found, we'll assume the requested frame is a key frame
 	return frame;
@@ -38,9 +38,11 @@
 
 #include "audio/audiostream.h"
 #include "audio/decoders/raw.h"
+#include "common/debug.h"
 #include "common/stream.h"
 #include "common/system.h"
 #include "common/textconsole.h"
+#include "common/threadpool.h"
 #include "common/util.h"
 #include "graphics/pixelformat.h"
 #include "graphics/yuv_to_rgb.h"
@@ -53,6 +55,7 @@ TheoraDecoder::TheoraDecoder() {
 	_videoTrack = 0;
 	_audioTrack = 0;
 	_hasVideo = _hasAudio = false;
+	_adaptivePostProcessing = false;
 }
 
 TheoraDecoder::~TheoraDecoder() {
@@ -168,7 +171,7 @@ bool TheoraDecoder::loadStream(Common::SeekableReadStream *stream) {
 
 	// And now we have it all. Initialize decoders next
 	if (_hasVideo) {
-		_videoTrack = new TheoraVideoTrack(getDefaultHighColorFormat(), theoraInfo, theoraSetup);
+		_videoTrack = new TheoraVideoTrack(getDefaultHighColorFormat(), theoraInfo, theoraSetup, _adaptivePostProcessing);
 		addTrack(_videoTrack);
 	}
 
@@ -249,15 +252,14 @@ void TheoraDecoder::readNextPacket() {
 	ensureAudioBufferSize();
 }
 
-TheoraDecoder::TheoraVideoTrack::TheoraVideoTrack(const Graphics::PixelFormat &format, th_info &theoraInfo, th_setup_info *theoraSetup) {
+TheoraDecoder::TheoraVideoTrack::TheoraVideoTrack(const Graphics::PixelFormat &format, th_info &theoraInfo, th_setup_info *theoraSetup, bool adaptivePostProcessing) {
 	_theoraDecode = th_decode_alloc(&theoraInfo, theoraSetup);
 
 	if (theoraInfo.pixel_fmt != TH_PF_420)
 		error("Only theora YUV420 is supported");
 
-	int postProcessingMax;
-	th_decode_ctl(_theoraDecode, TH_DECCTL_GET_PPLEVEL_MAX, &postProcessingMax, sizeof(postProcessingMax));
-	th_decode_ctl(_theoraDecode, TH_DECCTL_SET_PPLEVEL, &postProcessingMax, sizeof(postProcessingMax));
+	th_decode_ctl(_theoraDecode, TH_DECCTL_GET_PPLEVEL_MAX, &_postProcessingLevel, sizeof(_postProcessingLevel));
+	th_decode_ctl(_theoraDecode, TH_DECCTL_SET_PPLEVEL, &_postProcessingLevel, sizeof(_postProcessingLevel));
 
 	_surface.create(theoraInfo.frame_width, theoraInfo.frame_height, format);
 
@@ -267,6 +269,12 @@ TheoraDecoder::TheoraVideoTrack::TheoraVideoTrack(const Graphics::PixelFormat &f
 
 	// Set the frame rate
 	_frameRate = Common::Rational(theoraInfo.fps_numerator, theoraInfo.fps_denominator);
+	_frameTime = (_frameRate.getInverse() * 1000000).toInt();
+	_slowFrames = 0;
+	_adaptivePostProcessing = adaptivePostProcessing;
+
+	// Each frame is converted by all cores at once
+	_threadPool = g_system->createThreadPool(0);
 
 	_endOfVideo = false;
 	_nextFrameStartTime = 0.0;
@@ -275,19 +283,39 @@ TheoraDecoder::TheoraVideoTrack::TheoraVideoTrack(const Graphics::PixelFormat &f
 
 TheoraDecoder::TheoraVideoTrack::~TheoraVideoTrack() {
 	th_decode_free(_theoraDecode);
+	delete _threadPool;
 
 	_surface.free();
 	_displaySurface.setPixels(0);
 }
 
 bool TheoraDecoder::TheoraVideoTrack::decodePacket(ogg_packet &oggPacket) {
+	uint64 startTime = g_system->getMicros();
+
 	if (th_decode_packetin(_theoraDecode, &oggPacket, 0) == 0) {
 		_curFrame++;
 
 		// Convert YUV data to RGB data
 		th_ycbcr_buffer yuv;
 		th_decode_ycbcr_out(_theoraDecode, yuv);
+		uint32 decodeTime = (uint32)(g_system->getMicros() - startTime);
 		translateYUVtoRGBA(yuv);
+		uint32 convertTime = (uint32)(g_system->getMicros() - startTime) - decodeTime;
+
+		debug(8, "Theora frame %d: decoded in %u us, converted in %u us", _curFrame, decodeTime, convertTime);
+
+		// Post-processing is the most expensive part of decoding that can be left out.
+		// If allowed, turn it down if frames keep taking longer than they are shown for
+		if (_adaptivePostProcessing && _postProcessingLevel > 0 && decodeTime + convertTime > _frameTime) {
+			if (++_slowFrames >= 4) {
+				_postProcessingLevel--;
+				th_decode_ctl(_theoraDecode, TH_DECCTL_SET_PPLEVEL, &_postProcessingLevel, sizeof(_postProcessingLevel));
+				debug(3, "Theora decoding is too slow, lowering post-processing level to %d", _postProcessingLevel);
+				_slowFrames = 0;
+			}
+		} else {
+			_slowFrames = 0;
+		}
 
 		double time = th_granule_time(_theoraDecode, oggPacket.granulepos);
 
@@ -325,7 +353,7 @@ void TheoraDecoder::TheoraVideoTrack::translateYUVtoRGBA(th_ycbcr_buffer &YUVBuf
 	assert(YUVBuffer[kBufferU].height == YUVBuffer[kBufferY].height >> 1);
 	assert(YUVBuffer[kBufferV].height == YUVBuffer[kBufferY].height >> 1);
 
-	YUVToRGBMan.convert420(&_surface, Graphics::YUVToRGBManager::kScaleITU, YUVBuffer[kBufferY].data, YUVBuffer[kBufferU].data, YUVBuffer[kBufferV].data, YUVBuffer[kBufferY].width, YUVBuffer[kBufferY].height, YUVBuffer[kBufferY].stride, YUVBuffer[kBufferU].stride);
+	YUVToRGBMan.convert420(&_surface, Graphics::YUVToRGBManager::kScaleITU, YUVBuffer[kBufferY].data, YUVBuffer[kBufferU].data, YUVBuffer[kBufferV].data, YUVBuffer[kBufferY].width, YUVBuffer[kBufferY].height, YUVBuffer[kBufferY].stride, YUVBuffer[kBufferU].stride, _threadPool);
 }
 
 static vorbis_info *info = 0;
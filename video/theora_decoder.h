@@ -42,6 +42,7 @@
 
 namespace Common {
 class SeekableReadStream;
+class ThreadPool;
 }
 
 namespace Audio {
@@ -71,13 +72,21 @@ public:
 	bool loadStream(Common::SeekableReadStream *stream);
 	void close();
 
+	/**
+	 * Lower libtheora's post-processing level, one step at a time, when
+	 * decoding keeps taking longer than the frames are shown for. This
+	 * trades picture quality for speed on slow machines, and is off by
+	 * default. It applies to videos loaded afterwards.
+	 */
+	void setAdaptivePostProcessing(bool enable) { _adaptivePostProcessing = enable; }
+
 protected:
 	void readNextPacket();
 
 private:
 	class TheoraVideoTrack : public VideoTrack {
 	public:
-		TheoraVideoTrack(const Graphics::PixelFormat &format, th_info &theoraInfo, th_setup_info *theoraSetup);
+		TheoraVideoTrack(const Graphics::PixelFormat &format, th_info &theoraInfo, th_setup_info *theoraSetup, bool adaptivePostProcessing);
 		~TheoraVideoTrack();
 
 		bool endOfTrack() const { return _endOfVideo; }
@@ -102,6 +111,13 @@ private:
 
 		th_dec_ctx *_theoraDecode;
 
+		Common::ThreadPool *_threadPool; ///< Runs the YUV to RGB conversion
+
+		bool _adaptivePostProcessing;
+		int _postProcessingLevel;
+		uint32 _frameTime;  ///< Time between frames, in microseconds
+		uint _slowFrames;   ///< Number of consecutive frames that took longer than _frameTime
+
 		void translateYUVtoRGBA(th_ycbcr_buffer &YUVBuffer);
 	};
 
@@ -145,6 +161,7 @@ private:
 
 	ogg_stream_state _theoraOut, _vorbisOut;
 	bool _hasVideo, _hasAudio;
+	bool _adaptivePostProcessing;
 
 	vorbis_info _vorbisInfo;
 
@@ -25,14 +25,315 @@
 #include "audio/audiostream.h"
 #include "audio/mixer.h" // for kMaxChannelVolume
 
+#include "common/bufferedstream.h"
 #include "common/rational.h"
 #include "common/file.h"
+#include "common/fs.h"
+#include "common/list.h"
+#include "common/mutex.h"
+#include "common/queue.h"
+#include "common/singleton.h"
+#include "common/spscqueue.h"
 #include "common/system.h"
+#include "common/threadpool.h"
 
 #include "graphics/palette.h"
+#include "graphics/surface.h"
 
 namespace Video {
 
+/**
+ * The frames of a video track decoded ahead of time, see
+ * VideoDecoder::setDecodeAhead().
+ *
+ * The track and the stream of the decoder are only used while holding
+ * _decodeMutex, by the decode-ahead job or by nextFrame() when no frame is
+ * ready. The main thread learns about the state of the track from the
+ * queued frames instead.
+ */
+class DecodeAheadQueue {
+public:
+	DecodeAheadQueue(VideoDecoder *decoder, VideoDecoder::VideoTrack *track, uint maxFrames);
+	~DecodeAheadQueue();
+
+	/** Decode frames until the queue is full. Called by the decode-ahead job. */
+	void fill();
+
+	/**
+	 * Return the next frame, waiting for it or decoding it right away if
+	 * none is ready. The surface stays valid until the next call.
+	 */
+	const Graphics::Surface *nextFrame();
+
+	/** The palette of the last returned frame, if it changed with that frame. */
+	const byte *getDirtyPalette() const { return _shown.palette; }
+
+	const VideoDecoder::VideoTrack *getTrack() const { return _track; }
+
+	/** The number of the last returned frame. */
+	int getCurFrame() const { return _shown.frameNum; }
+	uint32 getNextFrameStartTime() const;
+	bool endOfTrack() const;
+
+private:
+	struct Frame {
+		Frame() : surface(nullptr), palette(nullptr), frameNum(-1), startTime(0) {}
+
+		Graphics::Surface *surface;
+		/** A copy of the palette, if it changed with this frame. */
+		byte *palette;
+		int frameNum;
+		uint32 startTime;
+	};
+
+	/** Decode the next frame. Needs _decodeMutex. */
+	bool decodeFrame(Frame &frame);
+	void freeFrame(Frame &frame);
+
+	VideoDecoder *_decoder;
+	VideoDecoder::VideoTrack *_track;
+	const uint _maxFrames;
+
+	/** Held while decoding, serialises all use of the track and the stream. */
+	Common::Mutex _decodeMutex;
+	/** Protects _frames, _nextStartTime and _endOfTrack. */
+	mutable Common::Mutex _queueMutex;
+
+	Common::Queue<Frame> _frames;
+	/** The start time of the frame after the last decoded one. */
+	uint32 _nextStartTime;
+	/** Whether the track has no frames left to decode. */
+	bool _endOfTrack;
+
+	/** The frame last returned by nextFrame(). */
+	Frame _shown;
+};
+
+/**
+ * Runs the decode-ahead queues from a background job of a thread pool.
+ * The queues start the job whenever a frame was taken out of them and it
+ * is not running, so that the freed slot is filled right away.
+ */
+class DecodeAheadScheduler : public Common::Singleton<DecodeAheadScheduler> {
+public:
+	void add(DecodeAheadQueue *queue);
+	void remove(DecodeAheadQueue *queue);
+
+	/** Start a decode-ahead job, unless one is queued or running. */
+	void wakeUp();
+
+private:
+	friend class Common::Singleton<SingletonBaseType>;
+	DecodeAheadScheduler() : _pool(nullptr), _jobRunning(0) {}
+
+	static void jobProc(void *refCon);
+	void fillAll();
+
+	/** Serialises add() and remove(), and with it creating the pool. */
+	Common::Mutex _registryMutex;
+	/** Protects _queues, held by the decode-ahead job while decoding. */
+	Common::Mutex _queuesMutex;
+
+	Common::List<DecodeAheadQueue *> _queues;
+	/** The pool providing the worker thread, while there are queues and it has one. */
+	Common::ThreadPool *_pool;
+	/** Whether a decode-ahead job is queued or running. */
+	volatile uint32 _jobRunning;
+};
+
+#pragma mark -
+
+DecodeAheadQueue::DecodeAheadQueue(VideoDecoder *decoder, VideoDecoder::VideoTrack *track, uint maxFrames)
+	: _decoder(decoder), _track(track), _maxFrames(maxFrames),
+	  _nextStartTime(track->getNextFrameStartTime()), _endOfTrack(track->endOfTrack()) {
+
+	_shown.frameNum = track->getCurFrame();
+	DecodeAheadScheduler::instance().add(this);
+}
+
+DecodeAheadQueue::~DecodeAheadQueue() {
+	// This waits for a running job to finish
+	DecodeAheadScheduler::instance().remove(this);
+
+	while (!_frames.empty()) {
+		Frame frame = _frames.pop();
+		freeFrame(frame);
+	}
+	freeFrame(_shown);
+}
+
+void DecodeAheadQueue::fill() {
+	for (;;) {
+		Common::StackLock decodeLock(_decodeMutex);
+		{
+			Common::StackLock lock(_queueMutex);
+			if (_endOfTrack || _frames.size() >= (int)_maxFrames)
+				return;
+		}
+
+		Frame frame;
+		const bool decoded = decodeFrame(frame);
+
+		Common::StackLock lock(_queueMutex);
+		if (decoded)
+			_frames.push(frame);
+		_nextStartTime = _track->getNextFrameStartTime();
+		_endOfTrack = _track->endOfTrack();
+	}
+}
+
+const Graphics::Surface *DecodeAheadQueue::nextFrame() {
+	Frame frame;
+	bool found = false;
+
+	{
+		Common::StackLock lock(_queueMutex);
+		if (!_frames.empty()) {
+			frame = _frames.pop();
+			found = true;
+		}
+	}
+
+	if (!found) {
+		// Nothing is ready. Wait for the frame being decoded, if any, and
+		// otherwise decode it right now.
+		Common::StackLock decodeLock(_decodeMutex);
+		Common::StackLock lock(_queueMutex);
+		if (!_frames.empty()) {
+			frame = _frames.pop();
+			found = true;
+		} else if (!_endOfTrack) {
+			// Keep the queue mutex, so that nobody sees the decoded
+			// frame both queued and shown
+			found = decodeFrame(frame);
+			_nextStartTime = _track->getNextFrameStartTime();
+			_endOfTrack = _track->endOfTrack();
+		}
+	}
+
+	if (!found)
+		return nullptr;
+
+	// Decode a frame for the slot just freed
+	DecodeAheadScheduler::instance().wakeUp();
+
+	freeFrame(_shown);
+	_shown = frame;
+	return _shown.surface;
+}
+
+uint32 DecodeAheadQueue::getNextFrameStartTime() const {
+	Common::StackLock lock(_queueMutex);
+	return _frames.empty() ? _nextStartTime : _frames.front().startTime;
+}
+
+bool DecodeAheadQueue::endOfTrack() const {
+	Common::StackLock lock(_queueMutex);
+	return _frames.empty() && _endOfTrack;
+}
+
+bool DecodeAheadQueue::decodeFrame(Frame &frame) {
+	if (_track->endOfTrack())
+		return false;
+
+	// The same steps as VideoDecoder::decodeNextFrame()
+	frame.startTime = _track->getNextFrameStartTime();
+	_decoder->readNextPacket();
+
+	const Graphics::Surface *surface = _track->decodeNextFrame();
+	if (surface) {
+		frame.surface = new Graphics::Surface();
+		frame.surface->copyFrom(*surface);
+	}
+
+	if (_track->hasDirtyPalette()) {
+		frame.palette = new byte[256 * 3];
+		memcpy(frame.palette, _track->getPalette(), 256 * 3);
+	}
+
+	frame.frameNum = _track->getCurFrame();
+	return true;
+}
+
+void DecodeAheadQueue::freeFrame(Frame &frame) {
+	if (frame.surface) {
+		frame.surface->free();
+		delete frame.surface;
+		frame.surface = nullptr;
+	}
+
+	delete[] frame.palette;
+	frame.palette = nullptr;
+}
+
+#pragma mark -
+
+void DecodeAheadScheduler::add(DecodeAheadQueue *queue) {
+	Common::StackLock registryLock(_registryMutex);
+
+	{
+		Common::StackLock lock(_queuesMutex);
+		_queues.push_back(queue);
+	}
+
+	if (!_pool) {
+		// One worker thread, and the calling thread which is not used
+		_pool = g_system->createThreadPool(2);
+		if (_pool->getThreadCount() < 2) {
+			delete _pool;
+			_pool = nullptr;
+		}
+	}
+
+	wakeUp();
+}
+
+void DecodeAheadScheduler::remove(DecodeAheadQueue *queue) {
+	Common::StackLock registryLock(_registryMutex);
+
+	bool empty;
+	{
+		// This waits for a running job to finish with this queue
+		Common::StackLock lock(_queuesMutex);
+		_queues.remove(queue);
+		empty = _queues.empty();
+	}
+
+	if (!empty || !_pool)
+		return;
+
+	// This waits for a running job to finish, which needs _queuesMutex,
+	// so this must not be held here.
+	delete _pool;
+	_pool = nullptr;
+	Common::storeRelease(_jobRunning, (uint32)0);
+}
+
+void DecodeAheadScheduler::wakeUp() {
+	// Only queues call this, so the pool is not deleted meanwhile
+	if (!_pool || Common::loadAcquire(_jobRunning))
+		return;
+
+	Common::storeRelease(_jobRunning, (uint32)1);
+	if (!_pool->startBackgroundJob(&jobProc, this))
+		Common::storeRelease(_jobRunning, (uint32)0);
+}
+
+void DecodeAheadScheduler::jobProc(void *refCon) {
+	DecodeAheadScheduler *scheduler = (DecodeAheadScheduler *)refCon;
+	scheduler->fillAll();
+	Common::storeRelease(scheduler->_jobRunning, (uint32)0);
+}
+
+void DecodeAheadScheduler::fillAll() {
+	Common::StackLock lock(_queuesMutex);
+
+	for (Common::List<DecodeAheadQueue *>::iterator it = _queues.begin(); it != _queues.end(); ++it)
+		(*it)->fill();
+}
+
+#pragma mark -
+
 VideoDecoder::VideoDecoder() {
 	_startTime = 0;
 	_dirtyPalette = false;
@@ -49,6 +350,9 @@ VideoDecoder::VideoDecoder() {
 	_nextVideoTrack = 0;
 	_mainAudioTrack = 0;
 	_canSetDither = true;
+	_readAheadBuffers = 0;
+	_decodeAheadFrames = 0;
+	_decodeAhead = nullptr;
 
 	// Find the best format for output
 	_defaultHighColorFormat = g_system->getScreenFormat();
@@ -57,7 +361,13 @@ VideoDecoder::VideoDecoder() {
 		_defaultHighColorFormat = Graphics::PixelFormat(4, 8, 8, 8, 8, 8, 16, 24, 0);
 }
 
+VideoDecoder::~VideoDecoder() {
+	stopDecodeAhead();
+}
+
 void VideoDecoder::close() {
+	stopDecodeAhead();
+
 	if (isPlaying())
 		stop();
 
@@ -83,6 +393,16 @@ void VideoDecoder::close() {
 }
 
 bool VideoDecoder::loadFile(const Common::String &filename) {
+	if (_readAheadBuffers > 0) {
+		// Only files with a handle of their own can be read from another
+		// thread. Archive members share the handle of their archive.
+		Common::ArchiveMemberPtr member = SearchMan.getMember(filename);
+		const Common::FSNode *node = dynamic_cast<const Common::FSNode *>(member.get());
+		Common::SeekableReadStream *stream = node ? node->createReadStream() : nullptr;
+		if (stream)
+			return loadStream(Common::wrapReadAheadSeekableReadStream(stream, 64 * 1024, _readAheadBuffers, DisposeAfterUse::YES));
+	}
+
 	Common::File *file = new Common::File();
 
 	if (!file->open(filename)) {
@@ -188,6 +508,21 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 	_needsUpdate = false;
 	_canSetDither = false;
 
+	if (_decodeAheadFrames > 0 && !_decodeAhead)
+		startDecodeAhead();
+
+	if (_decodeAhead) {
+		const Graphics::Surface *frame = _decodeAhead->nextFrame();
+
+		if (_decodeAhead->getDirtyPalette()) {
+			_palette = _decodeAhead->getDirtyPalette();
+			_dirtyPalette = true;
+		}
+
+		findNextVideoTrack();
+		return frame;
+	}
+
 	readNextPacket();
 
 	// If we have no next video track at this point, there shouldn't be
@@ -213,6 +548,10 @@ bool VideoDecoder::setReverse(bool reverse) {
 	if (reverse && hasAudio())
 		return false;
 
+	// The frames are decoded ahead in forward order
+	if (reverse && _decodeAhead)
+		return false;
+
 	// Attempt to make sure all the tracks are in the requested direction
 	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++) {
 		if ((*it)->getTrackType() == Track::kTrackTypeVideo && ((VideoTrack *)*it)->isReversed() != reverse) {
@@ -237,7 +576,7 @@ int VideoDecoder::getCurFrame() const {
 
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++)
 		if ((*it)->getTrackType() == Track::kTrackTypeVideo)
-			frame += ((VideoTrack *)*it)->getCurFrame() + 1;
+			frame += getTrackCurFrame((const VideoTrack *)*it) + 1;
 
 	return frame;
 }
@@ -278,7 +617,7 @@ uint32 VideoDecoder::getTimeToNextFrame() const {
 		return 0;
 
 	uint32 currentTime = getTime();
-	uint32 nextFrameStartTime = _nextVideoTrack->getNextFrameStartTime();
+	uint32 nextFrameStartTime = getTrackNextFrameStartTime(_nextVideoTrack);
 
 	if (_nextVideoTrack->isReversed()) {
 		// For reversed videos, we need to handle the time difference the opposite way.
@@ -299,8 +638,8 @@ bool VideoDecoder::endOfVideo() const {
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++) {
 		const Track *track = *it;
 
-		bool videoEndTimeReached = _endTimeSet && track->getTrackType() == Track::kTrackTypeVideo && ((const VideoTrack *)track)->getNextFrameStartTime() >= (uint)_endTime.msecs();
-		bool endReached = track->endOfTrack() || (isPlaying() && videoEndTimeReached);
+		bool videoEndTimeReached = _endTimeSet && track->getTrackType() == Track::kTrackTypeVideo && getTrackNextFrameStartTime((const VideoTrack *)track) >= (uint)_endTime.msecs();
+		bool endReached = isTrackEnded(track) || (isPlaying() && videoEndTimeReached);
 		if (!endReached)
 			return false;
 	}
@@ -323,6 +662,9 @@ bool VideoDecoder::rewind() {
 	if (!isRewindable())
 		return false;
 
+	// Drop the frames decoded ahead
+	stopDecodeAhead();
+
 	// Stop all tracks so they can be rewound
 	if (isPlaying())
 		stopAudio();
@@ -357,6 +699,9 @@ bool VideoDecoder::seek(const Audio::Timestamp &time) {
 	if (!isSeekable())
 		return false;
 
+	// Drop the frames decoded ahead
+	stopDecodeAhead();
+
 	// Stop all tracks so they can be seeked
 	if (isPlaying())
 		stopAudio();
@@ -864,7 +1209,7 @@ const VideoDecoder::Track *VideoDecoder::getTrack(uint track) const {
 
 bool VideoDecoder::endOfVideoTracks() const {
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++)
-		if ((*it)->getTrackType() == Track::kTrackTypeVideo && !(*it)->endOfTrack())
+		if ((*it)->getTrackType() == Track::kTrackTypeVideo && !isTrackEnded(*it))
 			return false;
 
 	return true;
@@ -875,9 +1220,9 @@ VideoDecoder::VideoTrack *VideoDecoder::findNextVideoTrack() {
 	uint32 bestTime = 0xFFFFFFFF;
 
 	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++) {
-		if ((*it)->getTrackType() == Track::kTrackTypeVideo && !(*it)->endOfTrack()) {
+		if ((*it)->getTrackType() == Track::kTrackTypeVideo && !isTrackEnded(*it)) {
 			VideoTrack *track = (VideoTrack *)*it;
-			uint32 time = track->getNextFrameStartTime();
+			uint32 time = getTrackNextFrameStartTime(track);
 
 			if (time < bestTime) {
 				bestTime = time;
@@ -924,8 +1269,8 @@ bool VideoDecoder::hasFramesLeft() const {
 
 		const VideoTrack *track = (const VideoTrack *)*it;
 
-		bool videoEndTimeReached = _endTimeSet && track->getNextFrameStartTime() >= (uint)_endTime.msecs();
-		bool endReached = track->endOfTrack() || (isPlaying() && videoEndTimeReached);
+		bool videoEndTimeReached = _endTimeSet && getTrackNextFrameStartTime(track) >= (uint)_endTime.msecs();
+		bool endReached = isTrackEnded(track) || (isPlaying() && videoEndTimeReached);
 		if (!endReached)
 			return true;
 	}
@@ -933,6 +1278,53 @@ bool VideoDecoder::hasFramesLeft() const {
 	return false;
 }
 
+void VideoDecoder::startDecodeAhead() {
+	VideoTrack *track = nullptr;
+
+	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++) {
+		if ((*it)->getTrackType() == Track::kTrackTypeVideo) {
+			// Only a single video track is decoded ahead
+			if (track)
+				return;
+
+			track = (VideoTrack *)*it;
+		}
+	}
+
+	if (!track || track->isReversed())
+		return;
+
+	_decodeAhead = new DecodeAheadQueue(this, track, _decodeAheadFrames);
+}
+
+void VideoDecoder::stopDecodeAhead() {
+	// The track stays ahead of the shown frame. This is only called before
+	// the track is repositioned or deleted.
+	delete _decodeAhead;
+	_decodeAhead = nullptr;
+}
+
+int VideoDecoder::getTrackCurFrame(const VideoTrack *track) const {
+	if (_decodeAhead && _decodeAhead->getTrack() == track)
+		return _decodeAhead->getCurFrame();
+
+	return track->getCurFrame();
+}
+
+uint32 VideoDecoder::getTrackNextFrameStartTime(const VideoTrack *track) const {
+	if (_decodeAhead && _decodeAhead->getTrack() == track)
+		return _decodeAhead->getNextFrameStartTime();
+
+	return track->getNextFrameStartTime();
+}
+
+bool VideoDecoder::isTrackEnded(const Track *track) const {
+	if (_decodeAhead && _decodeAhead->getTrack() == track)
+		return _decodeAhead->endOfTrack();
+
+	return track->endOfTrack();
+}
+
 bool VideoDecoder::hasAudio() const {
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++)
 		if ((*it)->getTrackType() == Track::kTrackTypeAudio)
@@ -959,3 +1351,7 @@ void VideoDecoder::eraseTrack(Track *track) {
 }
 
 } // End of namespace Video
+
+namespace Common {
+DECLARE_SINGLETON(Video::DecodeAheadScheduler);
+}
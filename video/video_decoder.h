@@ -46,13 +46,15 @@ struct Surface;
 
 namespace Video {
 
+class DecodeAheadQueue;
+
 /**
  * Generic interface for video decoder classes.
  */
 class VideoDecoder {
 public:
 	VideoDecoder();
-	virtual ~VideoDecoder() {}
+	virtual ~VideoDecoder();
 
 	/////////////////////////////////////////
 	// Opening/Closing a Video
@@ -365,6 +367,39 @@ public:
 	 */
 	void setDefaultHighColorFormat(const Graphics::PixelFormat &format) { _defaultHighColorFormat = format; }
 
+	/**
+	 * Read the files opened by loadFile() ahead of time in the background,
+	 * into 'bufferCount' buffers of 64 KiB. This helps when the video is
+	 * stored on slow media, like network filesystems or SD cards. Passing
+	 * 0, the default, disables reading ahead. Files inside archives are
+	 * not read ahead, since they share the file of the archive.
+	 *
+	 * Do not use it with decoders reading their stream from another thread
+	 * than the one calling decodeNextFrame().
+	 *
+	 * This must be set before calling loadFile().
+	 */
+	void setReadAhead(uint32 bufferCount) { _readAheadBuffers = bufferCount; }
+
+	/**
+	 * Decode up to 'frameCount' frames ahead of time on a worker thread, so
+	 * that decodeNextFrame() usually only has to hand out a frame which is
+	 * ready. Each frame keeps its own start time, frame number and palette.
+	 * Passing 0, the default, disables decoding ahead. Without a worker
+	 * thread, the frames are decoded when they are due, as usual.
+	 *
+	 * Decoding ahead starts with the next call to decodeNextFrame(), and is
+	 * only used for videos with a single video track played forward. It
+	 * stops on seek(), rewind() and close(), which drop the queued frames,
+	 * and such a video cannot be reversed.
+	 *
+	 * While decoding ahead, the decoder must only be used through the
+	 * methods of this class, since the worker thread reads the stream and
+	 * updates the tracks. For the same reason, decoders need to call
+	 * VideoDecoder::close() before releasing anything in their close().
+	 */
+	void setDecodeAhead(uint frameCount) { _decodeAheadFrames = frameCount; }
+
 	/**
 	 * Set the video to decode frames in reverse.
 	 *
@@ -959,6 +994,23 @@ private:
 	// Default PixelFormat settings
 	Graphics::PixelFormat _defaultHighColorFormat;
 
+	// Number of buffers to read the opened files ahead into
+	uint32 _readAheadBuffers;
+
+	// Number of frames to decode ahead, and the queue of those frames
+	// while decoding ahead
+	friend class DecodeAheadQueue;
+	uint _decodeAheadFrames;
+	DecodeAheadQueue *_decodeAhead;
+
+	void startDecodeAhead();
+	void stopDecodeAhead();
+
+	// These ask the decode-ahead queue instead of the track it decodes
+	int getTrackCurFrame(const VideoTrack *track) const;
+	uint32 getTrackNextFrameStartTime(const VideoTrack *track) const;
+	bool isTrackEnded(const Track *track) const;
+
 protected:
 	// Internal helper functions
 	void stopAudio();